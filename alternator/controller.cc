@@ -11,6 +11,7 @@
 #include "server.hh"
 #include "executor.hh"
 #include "rmw_operation.hh"
+#include "ttl.hh"
 #include "db/config.hh"
 #include "cdc/generation_service.hh"
 #include "service/memory_limiter.hh"
@@ -32,6 +33,7 @@ controller::controller(
         sharded<service::memory_limiter>& memory_limiter,
         sharded<auth::service>& auth_service,
         sharded<qos::service_level_controller>& sl_controller,
+        sharded<expiration_service>& expiration_service,
         const db::config& config,
         seastar::scheduling_group sg)
     : protocol_server(sg)
@@ -43,6 +45,7 @@ controller::controller(
     , _memory_limiter(memory_limiter)
     , _auth_service(auth_service)
     , _sl_controller(sl_controller)
+    , _expiration_service(expiration_service)
     , _config(config)
 {
 }
@@ -87,9 +90,14 @@ future<> controller::start_server() {
         auto get_timeout_in_ms = [] (const db::config& cfg) -> utils::updateable_value<uint32_t> {
             return cfg.alternator_timeout_in_ms;
         };
+        // The expiration service is only started when Alternator is enabled
+        auto get_expiration_service = [] (sharded<expiration_service>& es) -> expiration_service* {
+            return es.local_is_initialized() ? &es.local() : nullptr;
+        };
         _executor.start(std::ref(_gossiper), std::ref(_proxy), std::ref(_mm), std::ref(_sys_dist_ks),
                         sharded_parameter(get_cdc_metadata, std::ref(_cdc_gen_svc)), _ssg.value(),
-                        sharded_parameter(get_timeout_in_ms, std::ref(_config))).get();
+                        sharded_parameter(get_timeout_in_ms, std::ref(_config)),
+                        sharded_parameter(get_expiration_service, std::ref(_expiration_service))).get();
         _server.start(std::ref(_executor), std::ref(_proxy), std::ref(_gossiper), std::ref(_auth_service), std::ref(_sl_controller)).get();
         // Note: from this point on, if start_server() throws for any reason,
         // it must first call stop_server() to stop the executor and server
@@ -152,6 +160,9 @@ future<> controller::stop_server() {
         if (!_ssg) {
             return;
         }
+        // The server waits for the requests in progress, so wake those
+        // waiting for stream records first.
+        _executor.invoke_on_all(&executor::stop_stream_waiters).get();
         _server.stop().get();
         _executor.stop().get();
         _listen_addresses.clear();
@@ -53,6 +53,7 @@ using namespace seastar;
 
 class executor;
 class server;
+class expiration_service;
 
 class controller : public protocol_server {
     sharded<gms::gossiper>& _gossiper;
@@ -63,6 +64,7 @@ class controller : public protocol_server {
     sharded<service::memory_limiter>& _memory_limiter;
     sharded<auth::service>& _auth_service;
     sharded<qos::service_level_controller>& _sl_controller;
+    sharded<expiration_service>& _expiration_service;
     const db::config& _config;
 
     std::vector<socket_address> _listen_addresses;
@@ -80,6 +82,7 @@ class controller : public protocol_server {
         sharded<service::memory_limiter>& memory_limiter,
         sharded<auth::service>& auth_service,
         sharded<qos::service_level_controller>& sl_controller,
+        sharded<expiration_service>& expiration_service,
         const db::config& config,
         seastar::scheduling_group sg);
 
@@ -15,6 +15,7 @@
 #include "exceptions/exceptions.hh"
 #include "timestamp.hh"
 #include "types/map.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "schema/schema.hh"
 #include "query-request.hh"
 #include "query-result-reader.hh"
@@ -36,8 +37,10 @@
 #include "schema/schema.hh"
 #include "db/tags/extension.hh"
 #include "db/tags/utils.hh"
+#include "db/view/view.hh"
 #include "replica/database.hh"
 #include "alternator/rmw_operation.hh"
+#include "alternator/ttl.hh"
 #include <seastar/core/coroutine.hh>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/find_end.hpp>
@@ -82,6 +85,20 @@ static map_type attrs_type() {
     return t;
 }
 
+// Calls func(name, value) for each attribute stored in the serialized
+// attrs map, without deserializing the map as a whole. Only the values the
+// caller asks deserialize_item() for are decoded.
+template <typename Func>
+requires std::invocable<Func, std::string_view, bytes_view>
+static void for_each_serialized_attr(bytes_view map, Func&& func) {
+    auto n = read_collection_size(map);
+    for (int i = 0; i < n; ++i) {
+        auto name = read_collection_key(map);
+        auto value = read_collection_value_nonnull(map);
+        func(std::string_view(reinterpret_cast<const char*>(name.data()), name.size()), value);
+    }
+}
+
 static const column_definition& attrs_column(const schema& schema) {
     const column_definition* cdef = schema.get_column_definition(bytes(executor::ATTRS_COLUMN_NAME));
     assert(cdef);
@@ -489,10 +506,11 @@ static rjson::value fill_table_description(schema_ptr schema, table_status tbl_s
                 rjson::add(view_entry, "IndexArn", generate_arn_for_index(*schema, index_name));
                 // Add indexes's KeySchema and collect types for AttributeDefinitions:
                 executor::describe_key_schema(view_entry, *vptr, key_attribute_types);
-                // Add projection type
+                // Add projection type. KEYS_ONLY views don't copy the
+                // non-key attributes in ":attrs".
                 rjson::value projection = rjson::empty_object();
-                rjson::add(projection, "ProjectionType", "ALL");
-                // FIXME: we have to get ProjectionType from the schema when it is added
+                const column_definition* view_attrs = vptr->get_column_definition(bytes(executor::ATTRS_COLUMN_NAME));
+                rjson::add(projection, "ProjectionType", view_attrs && !view_attrs->is_view_virtual() ? "ALL" : "KEYS_ONLY");
                 rjson::add(view_entry, "Projection", std::move(projection));
                 // Local secondary indexes are marked by an extra '!' sign occurring before the ':' delimiter
                 rjson::value& index_array = (delim_it > 1 && cf_name[delim_it-1] == '!') ? lsi_array : gsi_array;
@@ -619,6 +637,49 @@ static void add_column(schema_builder& builder, const std::string& name, const r
             format("KeySchema key '{}' missing in AttributeDefinitions", name));
 }
 
+// Parse the Projection parameter of a GlobalSecondaryIndexes entry, and
+// return true if only the key attributes are to be projected into the index
+// (ProjectionType=KEYS_ONLY). Non-key attributes are all stored together
+// in the ":attrs" column, which a view can only copy whole, so INCLUDE is
+// validated but currently projects all attributes, like ALL.
+static bool parse_keys_only_projection(const rjson::value& index_info) {
+    const rjson::value* projection = rjson::find(index_info, "Projection");
+    if (!projection) {
+        return false;
+    }
+    if (!projection->IsObject()) {
+        throw api_error::validation("Projection must be an object.");
+    }
+    const rjson::value* projection_type = rjson::find(*projection, "ProjectionType");
+    if (!projection_type || !projection_type->IsString()) {
+        throw api_error::validation("Unknown ProjectionType: null");
+    }
+    std::string_view type = rjson::to_string_view(*projection_type);
+    if (type != "ALL" && type != "KEYS_ONLY" && type != "INCLUDE") {
+        throw api_error::validation(format("Unknown ProjectionType: {}", type));
+    }
+    const rjson::value* non_key_attributes = rjson::find(*projection, "NonKeyAttributes");
+    if (type != "INCLUDE") {
+        if (non_key_attributes) {
+            throw api_error::validation(format("NonKeyAttributes is only allowed with ProjectionType INCLUDE, not {}", type));
+        }
+        return type == "KEYS_ONLY";
+    }
+    if (!non_key_attributes || !non_key_attributes->IsArray() || non_key_attributes->Empty()) {
+        throw api_error::validation("ProjectionType INCLUDE requires a non-empty NonKeyAttributes list");
+    }
+    std::unordered_set<std::string_view> names;
+    for (const rjson::value& name : non_key_attributes->GetArray()) {
+        if (!name.IsString()) {
+            throw api_error::serialization("NonKeyAttributes must be a list of strings");
+        }
+        if (!names.insert(rjson::to_string_view(name)).second) {
+            throw api_error::validation(format("Duplicate attribute '{}' in NonKeyAttributes", rjson::to_string_view(name)));
+        }
+    }
+    return false;
+}
+
 // Parse the KeySchema request attribute, which specifies the column names
 // for a key. A KeySchema must include up to two elements, the first must be
 // the HASH key name, and the second one, if exists, must be a RANGE key name.
@@ -966,6 +1027,7 @@ static future<executor::request_return_type> create_table_on_shard0(tracing::tra
     const rjson::value* gsi = rjson::find(request, "GlobalSecondaryIndexes");
     std::vector<schema_builder> view_builders;
     std::vector<sstring> where_clauses;
+    std::vector<bool> keys_only_projections;
     std::unordered_set<std::string> index_names;
     if (gsi) {
         if (!gsi->IsArray()) {
@@ -983,8 +1045,7 @@ static future<executor::request_return_type> create_table_on_shard0(tracing::tra
             }
             std::string vname(view_name(table_name, index_name));
             elogger.trace("Adding GSI {}", index_name);
-            // FIXME: read and handle "Projection" parameter. This will
-            // require the MV code to copy just parts of the attrs map.
+            keys_only_projections.push_back(parse_keys_only_projection(g));
             schema_builder view_builder(keyspace_name, vname);
             auto [view_hash_key, view_range_key] = parse_key_schema(g);
             if (partial_schema->get_column_definition(to_bytes(view_hash_key)) == nullptr) {
@@ -1087,6 +1148,7 @@ static future<executor::request_return_type> create_table_on_shard0(tracing::tra
             std::map<sstring, sstring> tags_map = {{db::SYNCHRONOUS_VIEW_UPDATES_TAG_KEY, "true"}};
             view_builder.add_extension(db::tags_extension::NAME, ::make_shared<db::tags_extension>(tags_map));
             view_builders.emplace_back(std::move(view_builder));
+            keys_only_projections.push_back(false);
         }
     }
 
@@ -1121,16 +1183,27 @@ static future<executor::request_return_type> create_table_on_shard0(tracing::tra
 
     schema_ptr schema = builder.build();
     auto where_clause_it = where_clauses.begin();
+    auto keys_only_it = keys_only_projections.begin();
     for (auto& view_builder : view_builders) {
-        // Note below we don't need to add virtual columns, as all
-        // base columns were copied to view. TODO: reconsider the need
-        // for virtual columns when we support Projection.
+        const bool keys_only = *keys_only_it++;
+        // A view whose key has a regular base column (a non-key attribute
+        // of the base) takes the liveness of its rows from that column.
+        // Otherwise, a KEYS_ONLY view needs virtual columns for the base
+        // columns it doesn't copy, to keep its rows alive as long as the
+        // base rows are, as Scylla's materialized views do.
+        const bool key_has_regular_column = boost::algorithm::any_of(schema->regular_columns(), [&] (const column_definition& regular_cdef) {
+            return view_builder.has_column(*cql3::to_identifier(regular_cdef));
+        });
         for (const column_definition& regular_cdef : schema->regular_columns()) {
             if (!view_builder.has_column(*cql3::to_identifier(regular_cdef))) {
-                view_builder.with_column(regular_cdef.name(), regular_cdef.type, column_kind::regular_column);
+                if (!keys_only) {
+                    view_builder.with_column(regular_cdef.name(), regular_cdef.type, column_kind::regular_column);
+                } else if (!key_has_regular_column) {
+                    db::view::create_virtual_column(view_builder, regular_cdef.name(), regular_cdef.type);
+                }
             }
         }
-        const bool include_all_columns = true;
+        const bool include_all_columns = !keys_only;
         view_builder.with_view_info(*schema, include_all_columns, *where_clause_it);
         ++where_clause_it;
     }
@@ -1569,14 +1642,25 @@ rmw_operation::rmw_operation(service::storage_proxy& proxy, rjson::value&& reque
 }
 
 std::optional<mutation> rmw_operation::apply(foreign_ptr<lw_shared_ptr<query::result>> qr, const query::partition_slice& slice, api::timestamp_type ts) {
+    std::unique_ptr<rjson::value> previous_item;
     if (qr->row_count()) {
         auto selection = cql3::selection::selection::wildcard(_schema);
-        auto previous_item = executor::describe_single_item(_schema, slice, *selection, *qr, {});
-        if (previous_item) {
-            return apply(std::make_unique<rjson::value>(std::move(*previous_item)), ts);
+        auto item = executor::describe_single_item(_schema, slice, *selection, *qr, {});
+        if (item) {
+            previous_item = std::make_unique<rjson::value>(std::move(*item));
         }
     }
-    return apply(std::unique_ptr<rjson::value>(), ts);
+    std::optional<mutation> m = apply(std::move(previous_item), ts);
+    if (m) {
+        on_write(*m);
+    }
+    return m;
+}
+
+void rmw_operation::on_write(const mutation& m) const {
+    if (_expiration_service) {
+        _expiration_service->on_write(*_schema, m);
+    }
 }
 
 rmw_operation::write_isolation rmw_operation::get_write_isolation_for_schema(schema_ptr schema) {
@@ -1654,7 +1738,9 @@ future<executor::request_return_type> rmw_operation::execute(service::storage_pr
         tracing::trace_state_ptr trace_state,
         service_permit permit,
         bool needs_read_before_write,
-        stats& stats) {
+        stats& stats,
+        expiration_service* expiration_service) {
+    _expiration_service = expiration_service;
     if (needs_read_before_write) {
         if (_write_isolation == write_isolation::FORBID_RMW) {
             throw api_error::validation("Read-modify-write operations are disabled by 'forbid_rmw' write isolation policy. Refer to https://github.com/scylladb/scylla/blob/master/docs/alternator/alternator.md#write-isolation-policies for more information.");
@@ -1669,6 +1755,7 @@ future<executor::request_return_type> rmw_operation::execute(service::storage_pr
                 if (!m) {
                     return make_ready_future<executor::request_return_type>(api_error::conditional_check_failed("The conditional request failed", std::move(_return_attributes)));
                 }
+                on_write(*m);
                 return proxy.mutate(std::vector<mutation>{std::move(*m)}, db::consistency_level::LOCAL_QUORUM, executor::default_timeout(), trace_state, std::move(permit), db::allow_per_partition_rate_limit::yes).then([this] () mutable {
                     return rmw_operation_return(std::move(_return_attributes));
                 });
@@ -1677,6 +1764,7 @@ future<executor::request_return_type> rmw_operation::execute(service::storage_pr
     } else if (_write_isolation != write_isolation::LWT_ALWAYS) {
         std::optional<mutation> m = apply(nullptr, api::new_timestamp());
         assert(m); // !needs_read_before_write, so apply() did not check a condition
+        on_write(*m);
         return proxy.mutate(std::vector<mutation>{std::move(*m)}, db::consistency_level::LOCAL_QUORUM, executor::default_timeout(), trace_state, std::move(permit), db::allow_per_partition_rate_limit::yes).then([this] () mutable {
             return rmw_operation_return(std::move(_return_attributes));
         });
@@ -1824,7 +1912,7 @@ future<executor::request_return_type> executor::put_item(client_state& client_st
             });
         });
     }
-    return op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats).finally([op, start_time, this] {
+    return op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _expiration_service).finally([op, start_time, this] {
         _stats.api_operations.put_item_latency.mark(std::chrono::steady_clock::now() - start_time);
     });
 }
@@ -1913,7 +2001,7 @@ future<executor::request_return_type> executor::delete_item(client_state& client
             });
         });
     }
-    return op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats).finally([op, start_time, this] {
+    return op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _expiration_service).finally([op, start_time, this] {
         _stats.api_operations.delete_item_latency.mark(std::chrono::steady_clock::now() - start_time);
     });
 }
@@ -2005,7 +2093,8 @@ static future<> do_batch_write(service::storage_proxy& proxy,
         service::client_state& client_state,
         tracing::trace_state_ptr trace_state,
         service_permit permit,
-        stats& stats) {
+        stats& stats,
+        expiration_service* expiration_service) {
     if (mutation_builders.empty()) {
         return make_ready_future<>();
     }
@@ -2019,11 +2108,29 @@ static future<> do_batch_write(service::storage_proxy& proxy,
     });
     if (!needs_lwt) {
         // Do a normal write, without LWT:
+        // Items of the same partition are joined into one mutation, so the
+        // coordinator sends each partition to its replicas only once.
+        std::unordered_map<schema_decorated_key, size_t, schema_decorated_key_hash, schema_decorated_key_equal>
+            partition_index(mutation_builders.size(), schema_decorated_key_hash{}, schema_decorated_key_equal{});
         std::vector<mutation> mutations;
         mutations.reserve(mutation_builders.size());
         api::timestamp_type now = api::new_timestamp();
         for (auto& b : mutation_builders) {
-            mutations.push_back(b.second.build(b.first, now));
+            auto m = b.second.build(b.first, now);
+            auto [it, added] = partition_index.try_emplace(schema_decorated_key{b.first, m.decorated_key()}, mutations.size());
+            if (added) {
+                mutations.push_back(std::move(m));
+            } else {
+                mutations[it->second].apply(std::move(m));
+            }
+        }
+        if (mutations.size() < mutation_builders.size()) {
+            stats.batch_write_items_coalesced += mutation_builders.size() - mutations.size();
+        }
+        if (expiration_service) {
+            for (auto& m : mutations) {
+                expiration_service->on_write(*m.schema(), m);
+            }
         }
         return proxy.mutate(std::move(mutations),
                 db::consistency_level::LOCAL_QUORUM,
@@ -2039,6 +2146,11 @@ static future<> do_batch_write(service::storage_proxy& proxy,
         std::unordered_map<schema_decorated_key, std::vector<put_or_delete_item>, schema_decorated_key_hash, schema_decorated_key_equal>
             key_builders(1, schema_decorated_key_hash{}, schema_decorated_key_equal{});
         for (auto& b : mutation_builders) {
+            // The mutations are built on the shard running cas(), so
+            // build them here too if they need to be indexed.
+            if (expiration_service && expiration_service->index_enabled()) {
+                expiration_service->on_write(*b.first, b.second.build(b.first, api::new_timestamp()));
+            }
             auto dk = dht::decorate_key(*b.first, b.second.pk());
             auto [it, added] = key_builders.try_emplace(schema_decorated_key{b.first, dk});
             it->second.push_back(std::move(b.second));
@@ -2119,7 +2231,7 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
         }
     }
 
-    return do_batch_write(_proxy, _ssg, std::move(mutation_builders), client_state, trace_state, std::move(permit), _stats).then([] () {
+    return do_batch_write(_proxy, _ssg, std::move(mutation_builders), client_state, trace_state, std::move(permit), _stats, _expiration_service).then([] () {
         // FIXME: Issue #5650: If we failed writing some of the updates,
         // need to return a list of these failed updates in UnprocessedItems
         // rather than fail the whole write (issue #5650).
@@ -2446,12 +2558,10 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                 });
             }
         } else if (cell) {
-            auto deserialized = attrs_type()->deserialize(*cell);
-            auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
-            for (auto entry : keys_and_values) {
-                std::string attr_name = value_cast<sstring>(entry.first);
+            cell->with_linearized([&] (bytes_view linearized_cell) {
+              for_each_serialized_attr(linearized_cell, [&] (std::string_view name, bytes_view value) {
+                std::string attr_name(name);
                 if (include_all_embedded_attributes || !attrs_to_get || attrs_to_get->contains(attr_name)) {
-                    bytes value = value_cast<bytes>(entry.second);
                     rjson::value v = deserialize_item(value);
                     if (attrs_to_get) {
                         auto it = attrs_to_get->find(attr_name);
@@ -2460,7 +2570,7 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                             // this attribute. hierarchy_filter() modifies v,
                             // and returns false when nothing is to be kept.
                             if (!hierarchy_filter(v, it->second)) {
-                                continue;
+                                return;
                             }
                         }
                     }
@@ -2468,7 +2578,8 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                     // names are unique so add() makes sense
                     rjson::add_with_string_name(item, attr_name, std::move(v));
                 }
-            }
+              });
+            });
         }
         ++column_it;
     }
@@ -3177,7 +3288,7 @@ future<executor::request_return_type> executor::update_item(client_state& client
             });
         });
     }
-    return op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats).finally([op, start_time, this] {
+    return op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _expiration_service).finally([op, start_time, this] {
         _stats.api_operations.update_item_latency.mark(std::chrono::steady_clock::now() - start_time);
     });
 }
@@ -3615,17 +3726,27 @@ class describe_items_visitor {
     typename columns_t::const_iterator _column_it;
     rjson::value _item;
     rjson::value _items;
+    // Unless collecting, the item which passed the filter in the last row.
+    std::optional<rjson::value> _matched_item;
+    bool _collect;
     size_t _scanned_count;
+    size_t _matched_count;
 
 public:
-    describe_items_visitor(const columns_t& columns, const std::optional<attrs_to_get>& attrs_to_get, filter& filter)
+    using collect = bool_class<class collect_tag>;
+
+    // Unless collect is set, items are not accumulated, and each item which
+    // passed the filter must be retrieved with take_item() after end_row().
+    describe_items_visitor(const columns_t& columns, const std::optional<attrs_to_get>& attrs_to_get, filter& filter, collect c = collect::yes)
             : _columns(columns)
             , _attrs_to_get(attrs_to_get)
             , _filter(filter)
             , _column_it(columns.begin())
             , _item(rjson::empty_object())
             , _items(rjson::empty_array())
+            , _collect(bool(c))
             , _scanned_count(0)
+            , _matched_count(0)
     {
         // _filter.check() may need additional attributes not listed in
         // _attrs_to_get (i.e., not requested as part of the output).
@@ -3661,12 +3782,9 @@ class describe_items_visitor {
                     rjson::add_with_string_name(field, type_to_string((*_column_it)->type), json_key_column_value(bv, **_column_it));
                 }
             } else {
-                auto deserialized = attrs_type()->deserialize(bv);
-                auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
-                for (auto entry : keys_and_values) {
-                    std::string attr_name = value_cast<sstring>(entry.first);
+                for_each_serialized_attr(bv, [&] (std::string_view name, bytes_view value) {
+                    std::string attr_name(name);
                     if (!_attrs_to_get || _attrs_to_get->contains(attr_name) || _extra_filter_attrs.contains(attr_name)) {
-                        bytes value = value_cast<bytes>(entry.second);
                         // Even if _attrs_to_get asked to keep only a part of a
                         // top-level attribute, we keep the entire attribute
                         // at this stage, because the item filter might still
@@ -3675,7 +3793,7 @@ class describe_items_visitor {
                         // filter the unneeded parts after item filtering.
                         rjson::add_with_string_name(_item, attr_name, deserialize_item(value));
                     }
-                }
+                });
             }
         });
         ++_column_it;
@@ -3703,7 +3821,12 @@ class describe_items_visitor {
                 rjson::remove_member(_item, attr);
             }
 
-            rjson::push_back(_items, std::move(_item));
+            if (_collect) {
+                rjson::push_back(_items, std::move(_item));
+            } else {
+                _matched_item = std::move(_item);
+            }
+            ++_matched_count;
         }
         _item = rjson::empty_object();
         ++_scanned_count;
@@ -3713,9 +3836,17 @@ class describe_items_visitor {
         return std::move(_items);
     }
 
+    std::optional<rjson::value> take_item() {
+        return std::exchange(_matched_item, std::nullopt);
+    }
+
     size_t get_scanned_count() {
         return _scanned_count;
     }
+
+    size_t get_matched_count() {
+        return _matched_count;
+    }
 };
 
 static future<std::tuple<rjson::value, size_t>> describe_items(const cql3::selection::selection& selection, std::unique_ptr<cql3::result_set> result_set, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter) {
@@ -3740,6 +3871,84 @@ static future<std::tuple<rjson::value, size_t>> describe_items(const cql3::selec
     co_return std::tuple<rjson::value, size_t>{std::move(items_descr), size};
 }
 
+// Responses with more data than this are streamed item by item.
+static constexpr size_t streamed_items_threshold = 100'000;
+
+static size_t result_set_data_size(const cql3::result_set& result_set) {
+    size_t size = 0;
+    for (auto& row : result_set.rows()) {
+        for (auto& cell : row) {
+            size += cell ? cell->size() : 0;
+        }
+    }
+    return size;
+}
+
+struct streamed_items {
+    ::shared_ptr<cql3::selection::selection> selection;
+    std::unique_ptr<cql3::result_set> result_set;
+    std::optional<attrs_to_get> attrs;
+    filter item_filter;
+    std::optional<rjson::value> last_evaluated_key;
+    // Engaged if the query has a filter.
+    cql3::cql_stats* filter_stats;
+};
+
+// Like describe_items() followed by make_streamed(), except that the rows of
+// the result set are converted to JSON items one at a time, while writing the
+// response. So the response never exists as a whole JSON document, and the
+// memory it needs on top of the result set is bounded by the largest item.
+static json::json_return_type make_streamed_items(streamed_items&& items) {
+    // json::json_return_type uses std::function, so the state must be copyable.
+    auto state = make_lw_shared<streamed_items>(std::move(items));
+    std::function<future<>(output_stream<char>&&)> func = [state] (output_stream<char>&& os) mutable -> future<> {
+        // move objects to coroutine frame.
+        auto los = std::move(os);
+        auto ls = std::move(state);
+        std::exception_ptr ex;
+        try {
+            describe_items_visitor visitor(ls->selection->get_columns(), ls->attrs, ls->item_filter, describe_items_visitor::collect::no);
+            auto column_count = ls->result_set->get_metadata().column_count();
+            bool first = true;
+            co_await los.write("{\"Items\":[");
+            for (auto& row : ls->result_set->rows()) {
+                visitor.start_row();
+                for (auto i = 0u; i < column_count; i++) {
+                    auto& cell = row[i];
+                    visitor.accept_value(cell ? managed_bytes_view_opt(*cell) : managed_bytes_view_opt());
+                }
+                visitor.end_row();
+                if (auto item = visitor.take_item()) {
+                    if (!std::exchange(first, false)) {
+                        co_await los.write(",");
+                    }
+                    co_await los.write(rjson::print(*item));
+                }
+                co_await coroutine::maybe_yield();
+            }
+            co_await los.write(format("],\"Count\":{},\"ScannedCount\":{}", visitor.get_matched_count(), visitor.get_scanned_count()));
+            if (ls->last_evaluated_key) {
+                co_await los.write(",\"LastEvaluatedKey\":");
+                co_await los.write(rjson::print(*ls->last_evaluated_key));
+            }
+            co_await los.write("}");
+            co_await los.flush();
+            if (ls->filter_stats) {
+                ls->filter_stats->filtered_rows_matched_total += visitor.get_matched_count();
+            }
+        } catch (...) {
+            // See make_streamed(), the response is already partially written.
+            ex = std::current_exception();
+            elogger.error("Exception during streaming HTTP response: {}", ex);
+        }
+        co_await los.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+    };
+    return func;
+}
+
 static rjson::value encode_paging_state(const schema& schema, const service::pager::paging_state& paging_state) {
     rjson::value last_evaluated_key = rjson::empty_object();
     std::vector<bytes> exploded_pk = paging_state.get_partition_key().explode();
@@ -3775,6 +3984,48 @@ static rjson::value encode_paging_state(const schema& schema, const service::pag
     return last_evaluated_key;
 }
 
+// Most of an item is serialized into the ":attrs" column, which replicas
+// have to send in full. When a Query or Scan only projects and filters on
+// attributes stored in columns of their own (the key attributes of the
+// table and of its indexes), key_columns_to_read() returns the columns
+// to read instead, and ":attrs" isn't read at all. Returns a disengaged
+// optional when all columns have to be read.
+static std::optional<std::vector<const column_definition*>> key_columns_to_read(const schema& schema,
+        const std::optional<attrs_to_get>& attrs_to_get, const filter& filter) {
+    if (!attrs_to_get) {
+        return std::nullopt;
+    }
+    bool needs_attrs = false;
+    std::unordered_set<const column_definition*> needed;
+    auto add = [&] (std::string_view name) {
+        const column_definition* cdef = schema.get_column_definition(to_bytes(name));
+        if (!cdef || cdef->name_as_text() == executor::ATTRS_COLUMN_NAME) {
+            needs_attrs = true;
+        } else if (cdef->is_regular()) {
+            needed.insert(cdef);
+        }
+    };
+    for (const auto& attr : *attrs_to_get) {
+        add(attr.first);
+    }
+    filter.for_filters_on(add);
+    if (needs_attrs) {
+        return std::nullopt;
+    }
+    // Items always have a row marker, so they are returned even if none of
+    // their regular columns are read.
+    std::vector<const column_definition*> columns;
+    for (const column_definition& cdef : schema.all_columns_in_select_order()) {
+        if (cdef.is_hidden_from_cql()) {
+            continue;
+        }
+        if (!cdef.is_regular() || needed.contains(&cdef)) {
+            columns.push_back(&cdef);
+        }
+    }
+    return columns;
+}
+
 static future<executor::request_return_type> do_query(service::storage_proxy& proxy,
         schema_ptr schema,
         const rjson::value* exclusive_start_key,
@@ -3807,6 +4058,12 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     auto static_columns = boost::copy_range<query::column_id_vector>(
             schema->static_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
     auto selection = cql3::selection::selection::wildcard(schema);
+    if (auto columns = key_columns_to_read(*schema, attrs_to_get, filter)) {
+        regular_columns = boost::copy_range<query::column_id_vector>(*columns
+                | boost::adaptors::filtered([] (const column_definition* cdef) { return cdef->is_regular(); })
+                | boost::adaptors::transformed([] (const column_definition* cdef) { return cdef->id; }));
+        selection = cql3::selection::selection::for_columns(schema, std::move(*columns));
+    }
     query::partition_slice::option_set opts = selection->get_query_options();
     opts.add(custom_opts);
     auto partition_slice = query::partition_slice(std::move(ck_bounds), std::move(static_columns), std::move(regular_columns), opts);
@@ -3827,6 +4084,25 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     }
     auto paging_state = rs->get_metadata().paging_state();
     bool has_filter = filter;
+    // If attrs_to_get && attrs_to_get->empty(), the response has no items,
+    // see describe_items().
+    if ((!attrs_to_get || !attrs_to_get->empty()) && result_set_data_size(*rs) > streamed_items_threshold) {
+        if (has_filter) {
+            cql_stats.filtered_rows_read_total += p->stats().rows_read_total;
+        }
+        std::optional<rjson::value> last_evaluated_key;
+        if (paging_state) {
+            last_evaluated_key = encode_paging_state(*schema, *paging_state);
+        }
+        co_return executor::request_return_type(make_streamed_items(streamed_items{
+            .selection = std::move(selection),
+            .result_set = std::move(rs),
+            .attrs = std::move(attrs_to_get),
+            .item_filter = std::move(filter),
+            .last_evaluated_key = std::move(last_evaluated_key),
+            .filter_stats = has_filter ? &cql_stats : nullptr,
+        }));
+    }
     auto [items, size] = co_await describe_items(*selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
     if (paging_state) {
         rjson::add(items, "LastEvaluatedKey", encode_paging_state(*schema, *paging_state));
@@ -12,6 +12,7 @@
 #include "seastarx.hh"
 #include <seastar/json/json_elements.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/gate.hh>
 
 #include "service/migration_manager.hh"
 #include "service/client_state.hh"
@@ -53,6 +54,8 @@ class gossiper;
 namespace alternator {
 
 class rmw_operation;
+class stream_change_listener;
+class expiration_service;
 
 struct make_jsonable : public json::jsonable {
     rjson::value _value;
@@ -161,6 +164,13 @@ class executor : public peering_sharded_service<executor> {
     // An smp_service_group to be used for limiting the concurrency when
     // forwarding Alternator request between shards - if necessary for LWT.
     smp_service_group _ssg;
+    // Wakes GetRecords requests waiting on this shard for new stream records.
+    // Created when the first such request waits.
+    shared_ptr<stream_change_listener> _stream_listener;
+    // Held by the GetRecords requests waiting on this shard, see stop().
+    seastar::gate _stream_waiters;
+    // Notified of the items written through this shard, may be null
+    expiration_service* _expiration_service;
 
 public:
     using client_state = service::client_state;
@@ -176,8 +186,9 @@ class executor : public peering_sharded_service<executor> {
              db::system_distributed_keyspace& sdks,
              cdc::metadata& cdc_metadata,
              smp_service_group ssg,
-             utils::updateable_value<uint32_t> default_timeout_in_ms)
-        : _gossiper(gossiper), _proxy(proxy), _mm(mm), _sdks(sdks), _cdc_metadata(cdc_metadata), _ssg(ssg) {
+             utils::updateable_value<uint32_t> default_timeout_in_ms,
+             expiration_service* expiration_service = nullptr)
+        : _gossiper(gossiper), _proxy(proxy), _mm(mm), _sdks(sdks), _cdc_metadata(cdc_metadata), _ssg(ssg), _expiration_service(expiration_service) {
         s_default_timeout_in_ms = std::move(default_timeout_in_ms);
     }
 
@@ -210,9 +221,15 @@ class executor : public peering_sharded_service<executor> {
     future<> stop() {
         // disconnect from the value source, but keep the value unchanged.
         s_default_timeout_in_ms = utils::updateable_value<uint32_t>{s_default_timeout_in_ms()};
-        return make_ready_future<>();
+        stop_stream_waiters();
+        return _stream_waiters.close();
     }
 
+    // Wakes the GetRecords requests waiting for new stream records on this shard,
+    // which then return right away, as will those which would start waiting later.
+    // Called before the server waits for the requests in progress to finish.
+    void stop_stream_waiters();
+
     static sstring table_name(const schema&);
     static db::timeout_clock::time_point default_timeout();
 private:
@@ -223,6 +240,11 @@ class executor : public peering_sharded_service<executor> {
 private:
     friend class rmw_operation;
 
+    future<request_return_type> do_get_records(client_state& client_state, tracing::trace_state_ptr, service_permit permit, rjson::value request,
+            std::chrono::steady_clock::time_point start_time, bool may_wait);
+    future<bool> wait_for_stream_records(schema_ptr log_schema, const dht::token& token, db::timeout_clock::time_point deadline);
+    future<bool> wait_for_stream_write(table_id log_table, const dht::token& token, db::timeout_clock::time_point deadline, std::chrono::seconds confidence_interval);
+
     static void describe_key_schema(rjson::value& parent, const schema&, std::unordered_map<std::string,std::string> * = nullptr);
     
 public:
@@ -84,6 +84,9 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     // Additionally when _returnvalues_on_condition_check_failure is ALL_OLD
     // then condition check failure will also result in storing values here.
     mutable rjson::value _return_attributes;
+    // Notified of the written mutation, set by execute()
+    expiration_service* _expiration_service = nullptr;
+    void on_write(const mutation& m) const;
 public:
     // The constructor of a rmw_operation subclass should parse the request
     // and try to discover as many input errors as it can before really
@@ -113,7 +116,8 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
             tracing::trace_state_ptr trace_state,
             service_permit permit,
             bool needs_read_before_write,
-            stats& stats);
+            stats& stats,
+            expiration_service* expiration_service = nullptr);
     std::optional<shard_id> shard_for_execute(bool needs_read_before_write);
 };
 
@@ -237,6 +237,25 @@ class options_handler : public gated_handler {
     }
 };
 
+// Deriving the signing key from the secret takes four HMACs, while checking
+// the signature of a request with it takes one more, and the key of a user
+// only changes once a day. The secret is kept with the key, so a key derived
+// from an old secret isn't used once the key cache refreshes the secret.
+const utils::hmac_sha256_digest& server::get_signing_key(const std::string& user, const std::string& secret,
+        const std::string& datestamp, const std::string& region, const std::string& service) {
+    auto scope = fmt::format("{}/{}/{}/{}", user, datestamp, region, service);
+    auto it = _signing_keys.find(scope);
+    if (it == _signing_keys.end() || it->second.secret != secret) {
+        if (it == _signing_keys.end() && _signing_keys.size() >= max_signing_keys) {
+            // Most of them are keys of past days, not worth tracking their age
+            _signing_keys.clear();
+        }
+        auto key = utils::aws::get_signing_key(secret, datestamp, region, service);
+        it = _signing_keys.insert_or_assign(std::move(scope), signing_key_entry{secret, key}).first;
+    }
+    return it->second.key;
+}
+
 future<std::string> server::verify_signature(const request& req, const chunked_content& content) {
     if (!_enforce_authorization) {
         slogger.debug("Skipping authorization");
@@ -324,8 +343,9 @@ future<std::string> server::verify_signature(const request& req, const chunked_c
                                                     user_signature = std::move(user_signature)] (key_cache::value_ptr key_ptr) {
         std::string signature;
         try {
-            signature = utils::aws::get_signature(user, *key_ptr, std::string_view(host), "/", req._method,
-                datestamp, signed_headers_str, signed_headers_map, &content, region, service, "");
+            const auto& signing_key = get_signing_key(user, *key_ptr, datestamp, region, service);
+            signature = utils::aws::get_signature(signing_key, datestamp, std::string_view(host), "/", req._method,
+                signed_headers_str, signed_headers_map, &content, region, service, "");
         } catch (const std::exception& e) {
             throw api_error::invalid_signature(e.what());
         }
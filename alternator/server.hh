@@ -16,6 +16,7 @@
 #include <optional>
 #include "alternator/auth.hh"
 #include "service/qos/service_level_controller.hh"
+#include "utils/aws_sigv4.hh"
 #include "utils/small_vector.hh"
 #include "utils/updateable_value.hh"
 #include <seastar/core/units.hh>
@@ -39,6 +40,14 @@ class server {
     qos::service_level_controller& _sl_controller;
 
     key_cache _key_cache;
+    // Signing keys derived from users' secrets, by credential scope
+    // (user/date/region/service), see get_signing_key().
+    struct signing_key_entry {
+        std::string secret;
+        utils::hmac_sha256_digest key;
+    };
+    static constexpr size_t max_signing_keys = 1024;
+    std::unordered_map<std::string, signing_key_entry> _signing_keys;
     bool _enforce_authorization;
     utils::small_vector<std::reference_wrapper<seastar::httpd::http_server>, 2> _enabled_servers;
     gate _pending_requests;
@@ -77,6 +86,8 @@ class server {
     void set_routes(seastar::httpd::routes& r);
     // If verification succeeds, returns the authenticated user's username
     future<std::string> verify_signature(const seastar::http::request&, const chunked_content&);
+    const utils::hmac_sha256_digest& get_signing_key(const std::string& user, const std::string& secret,
+            const std::string& datestamp, const std::string& region, const std::string& service);
     future<executor::request_return_type> handle_api_request(std::unique_ptr<http::request> req);
 };
 
@@ -84,6 +84,12 @@ stats::stats() : api_operations{} {
                     seastar::metrics::description("number of writes that used LWT")),
             seastar::metrics::make_total_operations("shard_bounce_for_lwt", shard_bounce_for_lwt,
                     seastar::metrics::description("number writes that had to be bounced from this shard because of LWT requirements")),
+            seastar::metrics::make_total_operations("batch_write_items_coalesced", batch_write_items_coalesced,
+                    seastar::metrics::description("number of BatchWriteItem items written as part of the mutation of another item in the same partition")),
+            seastar::metrics::make_total_operations("get_records_waits", get_records_waits,
+                    seastar::metrics::description("number of GetRecords requests which found no records and waited on this shard for new ones")),
+            seastar::metrics::make_total_operations("get_records_woken", get_records_woken,
+                    seastar::metrics::description("number of waiting GetRecords requests woken by a write to their stream")),
             seastar::metrics::make_total_operations("requests_blocked_memory", requests_blocked_memory,
                     seastar::metrics::description("Counts a number of requests blocked due to memory pressure.")),
             seastar::metrics::make_total_operations("requests_shed", requests_shed,
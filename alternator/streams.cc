@@ -11,6 +11,10 @@
 #include <boost/io/ios_state.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/json/formatter.hh>
 
 #include "db/config.hh"
@@ -29,6 +33,9 @@
 #include "gms/feature.hh"
 #include "gms/feature_service.hh"
 
+#include "db/data_listeners.hh"
+#include "replica/database.hh"
+
 #include "executor.hh"
 #include "data_dictionary/data_dictionary.hh"
 
@@ -802,10 +809,148 @@ struct rapidjson::internal::TypeHelper<ValueType, alternator::event_id>
 
 namespace alternator {
     
+/**
+ * Consumers of a stream typically poll GetRecords for all its shards, and
+ * most of these polls find nothing. To save these reads, a GetRecords which
+ * finds no records may wait (see alternator_streams_get_records_max_wait_ms)
+ * for new ones, and only then read the log again. Writes to the CDC log are
+ * seen by the data listener below, on the shard of the replica which owns the
+ * stream's partition, so a request waits there. The listener is installed
+ * only while requests are waiting, so it costs nothing to writes otherwise.
+ */
+class stream_change_listener : public db::data_listener {
+    replica::database& _db;
+    // Streams, by the token of their partition in the log table, on which
+    // requests are waiting.
+    struct watch {
+        condition_variable cv;
+        size_t waiters = 0;
+    };
+    std::unordered_map<table_id, std::unordered_map<dht::token, watch>> _watches;
+    abort_source _as;
+public:
+    explicit stream_change_listener(replica::database& db) : _db(db) {}
+
+    // Returns the time at which the stream was written, or std::nullopt if
+    // it wasn't until the deadline.
+    future<std::optional<db::timeout_clock::time_point>> wait(table_id table, dht::token token, db::timeout_clock::time_point deadline) {
+        if (_as.abort_requested()) {
+            co_return std::nullopt;
+        }
+        if (_watches.empty()) {
+            _db.data_listeners().install(this);
+        }
+        auto& w = _watches[table][token];
+        ++w.waiters;
+        std::optional<db::timeout_clock::time_point> ret;
+        try {
+            co_await w.cv.wait(deadline);
+            ret = db::timeout_clock::now();
+        } catch (condition_variable_timed_out&) {
+        } catch (broken_condition_variable&) {
+        }
+        if (--w.waiters == 0) {
+            auto it = _watches.find(table);
+            it->second.erase(token);
+            if (it->second.empty()) {
+                _watches.erase(it);
+                if (_watches.empty()) {
+                    _db.data_listeners().uninstall(this);
+                }
+            }
+        }
+        co_return ret;
+    }
+
+    // Returns false if aborted.
+    future<bool> sleep_until(db::timeout_clock::time_point t) {
+        try {
+            co_await sleep_abortable<db::timeout_clock>(t - db::timeout_clock::now(), _as);
+            co_return true;
+        } catch (sleep_aborted&) {
+            co_return false;
+        }
+    }
+
+    void stop() {
+        if (!_as.abort_requested()) {
+            _as.request_abort();
+        }
+        for (auto& [_, streams] : _watches) {
+            for (auto& [_, w] : streams) {
+                w.cv.broken();
+            }
+        }
+    }
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override {
+        auto it = _watches.find(m.column_family_id());
+        if (it == _watches.end()) {
+            return;
+        }
+        auto w = it->second.find(m.decorated_key(*s).token());
+        if (w != it->second.end()) {
+            w->second.cv.broadcast();
+        }
+    }
+};
+
+future<bool> executor::wait_for_stream_write(table_id log_table, const dht::token& token, db::timeout_clock::time_point deadline, std::chrono::seconds confidence_interval) {
+    if (_stream_waiters.is_closed()) {
+        co_return false;
+    }
+    auto holder = _stream_waiters.hold();
+    if (!_stream_listener) {
+        _stream_listener = make_shared<stream_change_listener>(_proxy.local_db());
+    }
+    auto listener = _stream_listener;
+    _stats.get_records_waits++;
+    auto written = co_await listener->wait(log_table, token, deadline);
+    if (!written) {
+        co_return false;
+    }
+    _stats.get_records_woken++;
+    // The new record is only returned once it's older than the confidence
+    // interval, and its timestamp is no later than the time it was written.
+    // If that's past the deadline, return now, the next poll will get it.
+    auto readable = *written + confidence_interval;
+    if (readable > deadline) {
+        co_return false;
+    }
+    co_return co_await listener->sleep_until(readable);
+}
+
+// Waits until the stream whose partition in the log table has the given
+// token is written, and the written records can be read by GetRecords.
+// Returns false if it isn't written, or can't be read, before the deadline,
+// or if this node doesn't replicate the stream, and so cannot see it written.
+future<bool> executor::wait_for_stream_records(schema_ptr log_schema, const dht::token& token, db::timeout_clock::time_point deadline) {
+    auto erm = log_schema->table().get_effective_replication_map();
+    auto replicas = erm->get_natural_endpoints(token);
+    if (std::find(replicas.begin(), replicas.end(), erm->get_topology().my_address()) == replicas.end()) {
+        co_return false;
+    }
+    auto shard = erm->shard_for_reads(*log_schema, token);
+    auto ci = confidence_interval(_proxy.data_dictionary());
+    co_return co_await container().invoke_on(shard, _ssg, [table = log_schema->id(), token, deadline, ci] (executor& e) {
+        return e.wait_for_stream_write(table, token, deadline, ci);
+    });
+}
+
+void executor::stop_stream_waiters() {
+    if (!_stream_listener) {
+        _stream_listener = make_shared<stream_change_listener>(_proxy.local_db());
+    }
+    _stream_listener->stop();
+}
+
 future<executor::request_return_type> executor::get_records(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
     _stats.api_operations.get_records++;
-    auto start_time = std::chrono::steady_clock::now();
+    return do_get_records(client_state, std::move(trace_state), std::move(permit), std::move(request), std::chrono::steady_clock::now(), true);
+}
 
+future<executor::request_return_type> executor::do_get_records(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request,
+        std::chrono::steady_clock::time_point start_time, bool may_wait) {
     auto iter = rjson::get<shard_iterator>(request, "ShardIterator");
     auto limit = rjson::get_opt<size_t>(request, "Limit").value_or(1000);
 
@@ -831,7 +976,9 @@ future<executor::request_return_type> executor::get_records(client_state& client
     db::consistency_level cl = db::consistency_level::LOCAL_QUORUM;
     partition_key pk = iter.shard.id.to_partition_key(*schema);
 
-    dht::partition_range_vector partition_ranges{ dht::partition_range::make_singular(dht::decorate_key(*schema, pk)) };
+    auto dk = dht::decorate_key(*schema, pk);
+    auto token = dk.token();
+    dht::partition_range_vector partition_ranges{ dht::partition_range::make_singular(std::move(dk)) };
 
     auto high_ts = db_clock::now() - confidence_interval(db);
     auto high_uuid = utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch());
@@ -892,8 +1039,9 @@ future<executor::request_return_type> executor::get_records(client_state& client
     auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
             query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(limit * mul));
 
-    return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl, service::storage_proxy::coordinator_query_options(default_timeout(), std::move(permit), client_state)).then(
-            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {       
+    return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl, service::storage_proxy::coordinator_query_options(default_timeout(), permit, client_state)).then(
+            [this, &client_state, trace_state = std::move(trace_state), permit = std::move(permit), request = std::move(request), may_wait, token,
+             schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {       
         cql3::selection::result_set_builder builder(*selection, gc_clock::now());
         query::result_view::consume(*qr.query_result, partition_slice, cql3::selection::result_set_builder::visitor(builder, *schema, *selection));
 
@@ -1023,7 +1171,8 @@ future<executor::request_return_type> executor::get_records(client_state& client
         // ugh. figure out if we are and end-of-shard
         auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
 
-        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, start_time, ret = std::move(ret)](db_clock::time_point ts) mutable {
+        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, &client_state, trace_state = std::move(trace_state), permit = std::move(permit), request = std::move(request),
+                may_wait, token, schema, iter, high_ts, start_time, ret = std::move(ret)](db_clock::time_point ts) mutable -> future<executor::request_return_type> {
             auto& shard = iter.shard;            
 
             if (shard.time < ts && ts < high_ts) {
@@ -1032,6 +1181,21 @@ future<executor::request_return_type> executor::get_records(client_state& client
                 // "set to null". Our test test_streams_closed_read
                 // confirms that by "null" they meant not set at all.
             } else {
+                auto max_wait = std::chrono::milliseconds(_proxy.data_dictionary().get_config().alternator_streams_get_records_max_wait_ms());
+                if (may_wait && max_wait.count() > 0) {
+                    // Waiting doesn't take the request past its timeout.
+                    auto elapsed = std::chrono::duration_cast<db::timeout_clock::duration>(std::chrono::steady_clock::now() - start_time);
+                    auto deadline = std::min(db::timeout_clock::now() + max_wait, default_timeout() - elapsed);
+                    return wait_for_stream_records(schema, token, deadline).then([this, &client_state, trace_state = std::move(trace_state), permit = std::move(permit),
+                            request = std::move(request), start_time, iter, ret = std::move(ret)] (bool written) mutable -> future<executor::request_return_type> {
+                        if (written) {
+                            return do_get_records(client_state, std::move(trace_state), std::move(permit), std::move(request), start_time, false);
+                        }
+                        rjson::add(ret, "NextShardIterator", iter);
+                        _stats.api_operations.get_records_latency.mark(std::chrono::steady_clock::now() - start_time);
+                        return make_ready_future<executor::request_return_type>(make_jsonable(std::move(ret)));
+                    });
+                }
                 // We could have return the same iterator again, but we did
                 // a search from it until high_ts and found nothing, so we
                 // can also start the next search from high_ts.
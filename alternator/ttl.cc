@@ -33,6 +33,7 @@
 #include "service/pager/query_pagers.hh"
 #include "gms/feature_service.hh"
 #include "mutation/mutation.hh"
+#include "collection_mutation.hh"
 #include "types/types.hh"
 #include "types/map.hh"
 #include "utils/rjson.hh"
@@ -239,6 +240,105 @@ static bool is_expired(const rjson::value& expiration_time, gc_clock::time_point
     return n && is_expired(*n, now);
 }
 
+bool expiration_index::add(table_id table, const partition_key& pk, gc_clock::time_point expiration, size_t max_size) {
+    if (_size >= max_size) {
+        return false;
+    }
+    auto bucket_end = gc_clock::time_point((expiration.time_since_epoch() / bucket_duration + 1) * bucket_duration);
+    _buckets[bucket_end].push_back(entry{table, pk});
+    ++_size;
+    return true;
+}
+
+std::vector<expiration_index::entry> expiration_index::pop_due(gc_clock::time_point now) {
+    std::vector<entry> ret;
+    auto end = _buckets.upper_bound(now);
+    for (auto it = _buckets.begin(); it != end; ++it) {
+        std::move(it->second.begin(), it->second.end(), std::back_inserter(ret));
+    }
+    _buckets.erase(_buckets.begin(), end);
+    _size -= ret.size();
+    return ret;
+}
+
+std::vector<gc_clock::time_point> find_expiration_times(const schema& s, const mutation& m) {
+    std::vector<gc_clock::time_point> ret;
+    std::optional<std::string> attribute_name = db::find_tag(s, TTL_TAG_KEY);
+    if (!attribute_name) {
+        return ret;
+    }
+    // Resolve the attribute the same way scan_table() does. An attribute
+    // stored in a key column is not indexed, because such items can only
+    // be found by scanning.
+    const column_definition* cd = s.get_column_definition(to_bytes(*attribute_name));
+    std::optional<bytes> member;
+    if (!cd) {
+        member = to_bytes(*attribute_name);
+        cd = s.get_column_definition(bytes(executor::ATTRS_COLUMN_NAME));
+    }
+    if (!cd || !cd->is_regular()) {
+        return ret;
+    }
+    if ((member && (cd->type->get_kind() != abstract_type::kind::map || !cd->type->is_multi_cell())) ||
+        (!member && cd->type->get_kind() != abstract_type::kind::decimal)) {
+        return ret;
+    }
+    auto now = gc_clock::now();
+    auto add = [&] (const big_decimal& n) {
+        unsigned long t = bigdecimal_to_ul(n);
+        // Expiration times too far in the future are left to the scan
+        if (t > std::numeric_limits<uint32_t>::max()) {
+            return;
+        }
+        auto tp = gc_clock::time_point(gc_clock::duration(std::chrono::seconds(t)));
+        if (tp > now - std::chrono::years(5)) {
+            ret.push_back(tp);
+        }
+    };
+    for (const rows_entry& re : m.partition().clustered_rows()) {
+        const atomic_cell_or_collection* cell = re.row().cells().find_cell(cd->id);
+        if (!cell) {
+            continue;
+        }
+        if (member) {
+            cell->as_collection_mutation().with_deserialized(*cd->type, [&] (collection_mutation_view_description mv) {
+                for (auto&& [key, value] : mv.cells) {
+                    if (key == *member && value.is_live()) {
+                        std::optional<big_decimal> n = try_unwrap_number(deserialize_item(value.value().linearize()));
+                        if (n) {
+                            add(*n);
+                        }
+                    }
+                }
+            });
+        } else {
+            auto ac = cell->as_atomic_cell(*cd);
+            if (ac.is_live()) {
+                add(value_cast<big_decimal>(cd->type->deserialize(ac.value().linearize())));
+            }
+        }
+    }
+    return ret;
+}
+
+bool expiration_service::index_enabled() const {
+    return _db.get_config().alternator_ttl_index_max_items() > 0;
+}
+
+void expiration_service::on_write(const schema& s, const mutation& m) {
+    size_t max_size = _db.get_config().alternator_ttl_index_max_items();
+    if (!max_size) {
+        return;
+    }
+    for (auto expiration : find_expiration_times(s, m)) {
+        if (_index.add(s.id(), m.key(), expiration, max_size)) {
+            _expiration_stats.index_items_added++;
+        } else {
+            _expiration_stats.index_items_dropped++;
+        }
+    }
+}
+
 // expire_item() expires an item - i.e., deletes it as appropriate for
 // expiration - with CL=QUORUM and (FIXME!) in a way Alternator Streams
 // understands it is an expiration event - not a user-initiated deletion.
@@ -649,40 +749,19 @@ static future<> scan_table_ranges(
     }
 }
 
-// scan_table() scans, in one table, data "owned" by this shard, looking for
-// expired items and deleting them.
-// We consider each node to "own" its primary token ranges, i.e., the tokens
-// that this node is their first replica in the ring. Inside the node, each
-// shard "owns" subranges of the node's token ranges - according to the node's
-// sharding algorithm.
-// When a node goes down, the token ranges owned by it will not be scanned
-// and items in those token ranges will not expire, so in the future (FIXME)
-// this function should additionally work on token ranges whose primary owner
-// is down and this node is the range's secondary owner.
-// If the TTL (expiration-time scanning) feature is not enabled for this
-// table, scan_table() returns false without doing anything. Remember that the
-// TTL feature may be enabled later so this function will need to be called
-// again when the feature is enabled.
-// Currently this function scans the entire table (or, rather the parts owned
-// by this shard) at full rate, once. In the future (FIXME) we should consider
-// how to pace this scan, how and when to repeat it, how to interleave or
-// parallelize scanning of multiple tables, and how to continue scans after a
-// reboot.
-static future<bool> scan_table(
+// Prepares the context for a scan of table s looking for expired items.
+// Returns disengaged optional if expiration is not enabled for the table,
+// or the expiration-time attribute cannot hold expiration times.
+static std::optional<scan_ranges_context> make_scan_context(
     service::storage_proxy& proxy,
-    data_dictionary::database db,
-    gms::gossiper& gossiper,
     schema_ptr s,
-    abort_source& abort_source,
-    named_semaphore& page_sem,
-    expiration_service::stats& expiration_stats)
+    seastar::log_level level)
 {
     // Check if an expiration-time attribute is enabled for this table.
-    // If not, just return false immediately.
-    // FIXME: the setting of the TTL may change in the middle of a long scan!
+    // If not, just return immediately.
     std::optional<std::string> attribute_name = db::find_tag(*s, TTL_TAG_KEY);
     if (!attribute_name) {
-        co_return false;
+        return std::nullopt;
     }
     // attribute_name may be one of the schema's columns (in Alternator, this
     // means it's a key column), or an element in Alternator's attrs map
@@ -702,13 +781,13 @@ static future<bool> scan_table(
         member = std::move(attribute_name);
         column_name = bytes(executor::ATTRS_COLUMN_NAME);
         cd = s->get_column_definition(column_name);
-        tlogger.info("table {} TTL enabled with attribute {} in {}", s->cf_name(), *member, executor::ATTRS_COLUMN_NAME);
+        tlogger.log(level, "table {} TTL enabled with attribute {} in {}", s->cf_name(), *member, executor::ATTRS_COLUMN_NAME);
     } else {
-        tlogger.info("table {} TTL enabled with attribute {}", s->cf_name(), *attribute_name);
+        tlogger.log(level, "table {} TTL enabled with attribute {}", s->cf_name(), *attribute_name);
     }
     if (!cd) {
-        tlogger.info("table {} TTL column is missing, not scanning", s->cf_name());
-        co_return false;
+        tlogger.log(level, "table {} TTL column is missing, not scanning", s->cf_name());
+        return std::nullopt;
     }
     data_type column_type = cd->type;
     // Verify that the column has the right type: If "member" exists
@@ -718,12 +797,48 @@ static future<bool> scan_table(
     // scan it.
     if ((member && column_type->get_kind() != abstract_type::kind::map) ||
         (!member && column_type->get_kind() != abstract_type::kind::decimal)) {
-        tlogger.info("table {} TTL column has unsupported type, not scanning", s->cf_name());
+        tlogger.log(level, "table {} TTL column has unsupported type, not scanning", s->cf_name());
+        return std::nullopt;
+    }
+    return std::make_optional<scan_ranges_context>(s, proxy, std::move(column_name), std::move(member));
+}
+
+// scan_table() scans, in one table, data "owned" by this shard, looking for
+// expired items and deleting them.
+// We consider each node to "own" its primary token ranges, i.e., the tokens
+// that this node is their first replica in the ring. Inside the node, each
+// shard "owns" subranges of the node's token ranges - according to the node's
+// sharding algorithm.
+// When a node goes down, the token ranges owned by it will not be scanned
+// and items in those token ranges will not expire, so in the future (FIXME)
+// this function should additionally work on token ranges whose primary owner
+// is down and this node is the range's secondary owner.
+// If the TTL (expiration-time scanning) feature is not enabled for this
+// table, scan_table() returns false without doing anything. Remember that the
+// TTL feature may be enabled later so this function will need to be called
+// again when the feature is enabled.
+// Currently this function scans the entire table (or, rather the parts owned
+// by this shard) at full rate, once. In the future (FIXME) we should consider
+// how to pace this scan, how and when to repeat it, how to interleave or
+// parallelize scanning of multiple tables, and how to continue scans after a
+// reboot.
+static future<bool> scan_table(
+    service::storage_proxy& proxy,
+    data_dictionary::database db,
+    gms::gossiper& gossiper,
+    schema_ptr s,
+    abort_source& abort_source,
+    named_semaphore& page_sem,
+    expiration_service::stats& expiration_stats)
+{
+    // FIXME: the setting of the TTL may change in the middle of a long scan!
+    std::optional<scan_ranges_context> ctx = make_scan_context(proxy, s, seastar::log_level::info);
+    if (!ctx) {
         co_return false;
     }
     expiration_stats.scan_table++;
     // FIXME: need to pace the scan, not do it all at once.
-    scan_ranges_context scan_ctx{s, proxy, std::move(column_name), std::move(member)};
+    scan_ranges_context& scan_ctx = *ctx;
     token_ranges_owned_by_this_shard<primary> my_ranges(db.real_database(), gossiper, s);
     while (std::optional<dht::partition_range> range = my_ranges.next_partition_range()) {
         // Note that because of issue #9167 we need to run a separate
@@ -755,6 +870,51 @@ static future<bool> scan_table(
 }
 
 
+// Checks the partitions of the indexed items which are due by now, and
+// deletes their expired items. The items are read again before deciding,
+// exactly like in a scan, because they may have been modified or deleted
+// since they were indexed.
+future<> expiration_service::expire_indexed_items() {
+    auto due = _index.pop_due(gc_clock::now());
+    std::unordered_map<table_id, std::vector<partition_key>> keys_by_table;
+    for (auto& e : due) {
+        keys_by_table[e.table].push_back(std::move(e.pk));
+    }
+    for (auto& [id, keys] : keys_by_table) {
+        auto t = _db.try_find_table(id);
+        if (!t) {
+            continue;
+        }
+        schema_ptr s = t->schema();
+        try {
+            std::optional<scan_ranges_context> ctx = make_scan_context(_proxy, s, seastar::log_level::debug);
+            if (!ctx) {
+                continue;
+            }
+            auto dks = boost::copy_range<std::vector<dht::decorated_key>>(keys | boost::adaptors::transformed([&s] (const partition_key& pk) {
+                return dht::decorate_key(*s, pk);
+            }));
+            std::sort(dks.begin(), dks.end(), dht::ring_position_less_comparator(*s));
+            dks.erase(std::unique(dks.begin(), dks.end(), [&s] (const dht::decorated_key& a, const dht::decorated_key& b) {
+                return a.equal(*s, b);
+            }), dks.end());
+            for (auto& dk : dks) {
+                if (shutting_down()) {
+                    co_return;
+                }
+                _expiration_stats.index_partitions_checked++;
+                dht::partition_range_vector partition_ranges;
+                partition_ranges.push_back(dht::partition_range::make_singular(dk));
+                co_await scan_table_ranges(_proxy, *ctx, std::move(partition_ranges), _abort_source, _page_sem, _expiration_stats);
+            }
+        } catch (...) {
+            // The remaining items of the table will be found by the next scan
+            tlogger.warn("table {}.{} expiration of indexed items failed: {}",
+                s->ks_name(), s->cf_name(), std::current_exception());
+        }
+    }
+}
+
 future<> expiration_service::run() {
     // FIXME: don't just tight-loop, think about timing, pace, and
     // store position in durable storage, etc.
@@ -775,6 +935,8 @@ future<> expiration_service::run() {
             if (shutting_down()) {
                 co_return;
             }
+            // A full pass may take long, don't let indexed items wait for it
+            co_await expire_indexed_items();
             try {
                 co_await scan_table(_proxy, _db, _gossiper, s, _abort_source, _page_sem, _expiration_stats);
             } catch (...) {
@@ -802,13 +964,26 @@ future<> expiration_service::run() {
         // in the next iteration by reducing the scanner's scheduling-group
         // share (if using a separate scheduling group), or introduce
         // finer-grain sleeps into the scanning code.
+        // While sleeping, if the expiration index is enabled, we wake up
+        // every expiration_index::bucket_duration to expire the indexed
+        // items which became due.
         std::chrono::milliseconds scan_duration(std::chrono::duration_cast<std::chrono::milliseconds>(lowres_clock::now() - start));
         std::chrono::milliseconds period(long(_db.get_config().alternator_ttl_period_in_seconds() * 1000));
         if (scan_duration < period) {
-            try {
-                tlogger.info("sleeping {} seconds until next period", (period - scan_duration).count()/1000.0);
-                co_await seastar::sleep_abortable(period - scan_duration, _abort_source);
-            } catch(seastar::sleep_aborted&) {}
+            tlogger.info("sleeping {} seconds until next period", (period - scan_duration).count()/1000.0);
+            auto next_scan = start + period;
+            for (auto now = lowres_clock::now(); now < next_scan && !shutting_down(); now = lowres_clock::now()) {
+                bool use_index = index_enabled();
+                auto sleep_duration = use_index
+                        ? std::min<lowres_clock::duration>(next_scan - now, expiration_index::bucket_duration)
+                        : next_scan - now;
+                try {
+                    co_await seastar::sleep_abortable(sleep_duration, _abort_source);
+                } catch(seastar::sleep_aborted&) {}
+                if (use_index && !shutting_down()) {
+                    co_await expire_indexed_items();
+                }
+            }
         } else {
                 tlogger.warn("scan took {} seconds, longer than period - not sleeping", scan_duration.count()/1000.0);
         }
@@ -850,6 +1025,12 @@ expiration_service::stats::stats() {
             seastar::metrics::description("number of items deleted after expiration")),
         seastar::metrics::make_total_operations("secondary_ranges_scanned", secondary_ranges_scanned,
             seastar::metrics::description("number of token ranges scanned by this node while their primary owner was down")),
+        seastar::metrics::make_total_operations("index_items_added", index_items_added,
+            seastar::metrics::description("number of written items recorded in the expiration index")),
+        seastar::metrics::make_total_operations("index_items_dropped", index_items_dropped,
+            seastar::metrics::description("number of written items not recorded in the expiration index because it was full")),
+        seastar::metrics::make_total_operations("index_partitions_checked", index_partitions_checked,
+            seastar::metrics::description("number of partitions checked for expired items because of the expiration index")),
     });
 }
 
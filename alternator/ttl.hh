@@ -8,11 +8,19 @@
 
 #pragma once
 
+#include <map>
+#include <optional>
+#include <vector>
 #include "seastarx.hh"
 #include <seastar/core/sharded.hh>
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/semaphore.hh>
 #include "data_dictionary/data_dictionary.hh"
+#include "gc_clock.hh"
+#include "keys.hh"
+#include "schema/schema_fwd.hh"
+
+class mutation;
 
 namespace gms {
 class gossiper;
@@ -28,6 +36,41 @@ namespace service {
 
 namespace alternator {
 
+// expiration_index keeps, in memory, the partitions of items which were
+// written on this shard with an expiration time, bucketed by that time.
+// It lets the expiration service check exactly the partitions which have
+// items becoming due, instead of waiting for the next full scan to find their
+// items. The index is best-effort: it is not persistent, and items written
+// through other shards or nodes, or which didn't fit under the size limit,
+// are still found by the periodic full scan.
+class expiration_index {
+public:
+    static constexpr std::chrono::seconds bucket_duration{10};
+
+    struct entry {
+        table_id table;
+        partition_key pk;
+    };
+private:
+    // Keyed by the end of the bucket, i.e. all items in a bucket are due
+    // once its key has passed.
+    std::map<gc_clock::time_point, std::vector<entry>> _buckets;
+    size_t _size = 0;
+public:
+    // Adds the partition to the bucket of the given expiration time.
+    // Returns false if the index already holds max_size entries.
+    bool add(table_id table, const partition_key& pk, gc_clock::time_point expiration, size_t max_size);
+
+    // Removes and returns the entries of all buckets which are due at now.
+    std::vector<entry> pop_due(gc_clock::time_point now);
+
+    size_t size() const { return _size; }
+};
+
+// Returns the expiration times of the items written by the mutation,
+// according to the expiration-time attribute enabled on the table.
+std::vector<gc_clock::time_point> find_expiration_times(const schema& s, const mutation& m);
+
 // expiration_service is a sharded service responsible for cleaning up expired
 // items in all tables with per-item expiration enabled. Currently, this means
 // Alternator tables with TTL configured via a UpdateTimeToLeave request.
@@ -43,6 +86,9 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
         uint64_t scan_table = 0;
         uint64_t items_deleted = 0;
         uint64_t secondary_ranges_scanned = 0;
+        uint64_t index_items_added = 0;
+        uint64_t index_items_dropped = 0;
+        uint64_t index_partitions_checked = 0;
     private:
         // The metric_groups object holds this stat object's metrics registered
         // as long as the stats object is alive.
@@ -61,6 +107,8 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
     named_semaphore _page_sem{1, named_semaphore_exception_factory{"alternator_ttl"}};
     bool shutting_down() { return _abort_source.abort_requested(); }
     stats _expiration_stats;
+    expiration_index _index;
+    future<> expire_indexed_items();
 public:
     // sharded_service<expiration_service>::start() creates this object on
     // all shards, so calls this constructor on each shard. Later, the
@@ -68,6 +116,11 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
     expiration_service(data_dictionary::database, service::storage_proxy&, gms::gossiper&);
     future<> start();
     future<> run();
+    // Called on the shard which coordinated a write of items into a table
+    // with expiration enabled, with the mutation that was written. Records
+    // the items in the expiration index if it is enabled.
+    void on_write(const schema& s, const mutation& m);
+    bool index_enabled() const;
     // sharded_service<expiration_service>::stop() calls the following stop()
     // method on each shard. This stop() asks the service on this shard to
     // shut down as quickly as it can. The returned future indicates when the
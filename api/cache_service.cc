@@ -257,6 +257,14 @@ void set_cache_service(http_context& ctx, routes& r) {
         });
     });
 
+    cs::get_row_evictions_spared.set(r, [&ctx] (std::unique_ptr<http::request> req) {
+        return ctx.db.map_reduce0([](replica::database& db) -> uint64_t {
+            return db.row_cache_tracker().get_stats().row_evictions_spared;
+        }, uint64_t(0), std::plus<uint64_t>()).then([](const int64_t& res) {
+            return make_ready_future<json::json_return_type>(res);
+        });
+    });
+
     cs::get_counter_capacity.set(r, [] (std::unique_ptr<http::request> req) {
         // TBD
         // FIXME
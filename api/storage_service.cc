@@ -255,6 +255,7 @@ future<scrub_info> parse_scrub_options(const http_context& ctx, sharded<db::snap
     info.column_families = parse_tables(info.keyspace, ctx, *rp.get("cf"));
     auto scrub_mode_opt = rp.get("scrub_mode");
     auto scrub_mode = sstables::compaction_type_options::scrub::mode::abort;
+    auto checksums_only = sstables::compaction_type_options::scrub::checksums_only::no;
 
     if (!scrub_mode_opt) {
         const auto skip_corrupted = rp.get_as<bool>("skip_corrupted").value_or(false);
@@ -272,6 +273,9 @@ future<scrub_info> parse_scrub_options(const http_context& ctx, sharded<db::snap
             scrub_mode = sstables::compaction_type_options::scrub::mode::segregate;
         } else if (scrub_mode_str == "VALIDATE") {
             scrub_mode = sstables::compaction_type_options::scrub::mode::validate;
+        } else if (scrub_mode_str == "VALIDATE_CHECKSUMS") {
+            scrub_mode = sstables::compaction_type_options::scrub::mode::validate;
+            checksums_only = sstables::compaction_type_options::scrub::checksums_only::yes;
         } else {
             throw httpd::bad_param_exception(fmt::format("Unknown argument for 'scrub_mode' parameter: {}", scrub_mode_str));
         }
@@ -289,6 +293,7 @@ future<scrub_info> parse_scrub_options(const http_context& ctx, sharded<db::snap
 
     info.opts = {
         .operation_mode = scrub_mode,
+        .validate_checksums_only = checksums_only,
     };
     const sstring quarantine_mode_str = req_param<sstring>(*req, "quarantine_mode", "INCLUDE");
     if (quarantine_mode_str == "INCLUDE") {
@@ -1734,6 +1739,21 @@ void set_snapshot(http_context& ctx, routes& r, sharded<db::snapshot_ctl>& snap_
         }
     });
 
+    ss::start_backup.set(r, [&snap_ctl] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        apilog.info("start_backup: {}", req->query_parameters);
+        auto params = req_params({
+            std::pair("endpoint", mandatory::yes),
+            std::pair("bucket", mandatory::yes),
+            std::pair("prefix", mandatory::no),
+            std::pair("keyspace", mandatory::yes),
+            std::pair("snapshot", mandatory::yes),
+        });
+        params.process(*req);
+        auto task_id = co_await snap_ctl.local().start_backup(*params.get("endpoint"), *params.get("bucket"), params.get("prefix").value_or(""),
+                *params.get("keyspace"), *params.get("snapshot"));
+        co_return json::json_return_type(task_id.to_sstring());
+    });
+
     ss::true_snapshots_size.set(r, [&snap_ctl](std::unique_ptr<http::request> req) {
         return snap_ctl.local().true_snapshots_size().then([] (int64_t size) {
             return make_ready_future<json::json_return_type>(size);
@@ -1781,6 +1801,7 @@ void unset_snapshot(http_context& ctx, routes& r) {
     ss::get_snapshot_details.unset(r);
     ss::take_snapshot.unset(r);
     ss::del_snapshot.unset(r);
+    ss::start_backup.unset(r);
     ss::true_snapshots_size.unset(r);
     ss::scrub.unset(r);
     cf::get_true_snapshots_size.unset(r);
@@ -12,12 +12,18 @@
 #include "replica/database.hh"
 
 #include <rapidjson/document.h>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/internal/cpu_profiler.hh>
+#include <seastar/core/memory.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/metrics_api.hh>
 #include <seastar/core/relabel_config.hh>
 #include <seastar/http/exception.hh>
 #include <seastar/util/short_streams.hh>
 #include <seastar/http/short_streams.hh>
+#include <seastar/util/defer.hh>
+#include <boost/algorithm/string/join.hpp>
 
 #include "log.hh"
 
@@ -33,6 +39,79 @@ extern "C" void __attribute__((weak)) __llvm_profile_dump();
 extern "C" const char * __attribute__((weak)) __llvm_profile_get_filename();
 extern "C" void __attribute__((weak)) __llvm_profile_reset_counters();
 
+// Appends the frames of the backtrace, outermost first, in the collapsed
+// format of flame graph tools.
+static void append_collapsed_frames(sstring& stack, const simple_backtrace& bt) {
+    auto& frames = bt.frames();
+    for (auto f = frames.rbegin(); f != frames.rend(); ++f) {
+        stack += f->so->name.empty() ? format(";0x{:x}", f->addr) : format(";{}+0x{:x}", f->so->name, f->addr);
+    }
+}
+
+// Samples the stacks of this shard and returns them collapsed, see get_cpu_profile.
+static future<sstring> sample_cpu_profile(std::chrono::milliseconds duration, std::chrono::microseconds period) {
+    std::unordered_map<sstring, uint64_t> stacks;
+    std::vector<cpu_profiler_trace> traces;
+    auto collect = [&] {
+        traces.clear();
+        engine().profiler_results(traces);
+        for (auto& t : traces) {
+            auto stack = format("shard {};{}", this_shard_id(), t.sg.name());
+            append_collapsed_frames(stack, t.user_backtrace);
+            ++stacks[stack];
+        }
+    };
+
+    engine().set_cpu_profiler_period(period);
+    engine().set_cpu_profiler_enabled(true);
+    auto end = lowres_clock::now() + duration;
+    // The profiler keeps only the latest samples, so they are collected
+    // often enough not to lose any.
+    while (lowres_clock::now() < end) {
+        co_await sleep(std::min<lowres_clock::duration>(end - lowres_clock::now(), std::chrono::milliseconds(100)));
+        collect();
+    }
+    engine().set_cpu_profiler_enabled(false);
+    collect();
+
+    sstring res;
+    for (auto& [stack, count] : stacks) {
+        res += format("{} {}\n", stack, count);
+    }
+    co_return res;
+}
+
+static thread_local bool cpu_profile_in_progress = false;
+
+// Must be called on shard 0.
+static future<sstring> get_cpu_profile(std::chrono::milliseconds duration, std::chrono::microseconds period) {
+    if (cpu_profile_in_progress) {
+        throw bad_param_exception("A CPU profile is already being taken");
+    }
+    cpu_profile_in_progress = true;
+    auto reset_in_progress = defer([] () noexcept { cpu_profile_in_progress = false; });
+    apilog.info("Taking a CPU profile for {}ms, sampling every {}us", duration.count(), period.count());
+    std::vector<sstring> profiles(smp::count);
+    co_await smp::invoke_on_all([&profiles, duration, period] {
+        return sample_cpu_profile(duration, period).then([&profiles] (sstring profile) {
+            profiles[this_shard_id()] = std::move(profile);
+        });
+    });
+    co_return boost::algorithm::join(profiles, "");
+}
+
+// Returns the live memory of the allocation sites sampled on this shard,
+// collapsed, see get_heap_profile.
+static sstring get_shard_heap_profile() {
+    sstring res;
+    for (auto& site : memory::sampled_memory_profile()) {
+        auto stack = format("shard {}", this_shard_id());
+        append_collapsed_frames(stack, site.backtrace);
+        res += format("{} {}\n", stack, site.size);
+    }
+    return res;
+}
+
 void set_system(http_context& ctx, routes& r) {
     hm::get_metrics_config.set(r, [](const_req req) {
         std::vector<hm::metrics_config> res;
@@ -162,6 +241,48 @@ void set_system(http_context& ctx, routes& r) {
         });
     });
 
+    hs::get_cpu_profile.set(r, [](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        unsigned duration_ms;
+        unsigned period_us = 10000;
+        try {
+            duration_ms = boost::lexical_cast<unsigned>(std::string(req->get_query_param("duration_ms")));
+            if (auto p = req->get_query_param("period_us"); !p.empty()) {
+                period_us = boost::lexical_cast<unsigned>(std::string(p));
+            }
+        } catch (boost::bad_lexical_cast& e) {
+            throw bad_param_exception("duration_ms and period_us must be positive integers");
+        }
+        if (!period_us) {
+            throw bad_param_exception("period_us must be positive");
+        }
+        auto profile = co_await smp::submit_to(0, [duration_ms, period_us] {
+            return get_cpu_profile(std::chrono::milliseconds(duration_ms), std::chrono::microseconds(period_us));
+        });
+        co_return json::json_return_type(std::move(profile));
+    });
+
+    hs::set_heap_profiling_sampling_rate.set(r, [](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        size_t rate;
+        try {
+            rate = boost::lexical_cast<size_t>(std::string(req->get_query_param("rate")));
+        } catch (boost::bad_lexical_cast& e) {
+            throw bad_param_exception("rate must be a non-negative integer");
+        }
+        apilog.info("Setting the heap profiling sampling rate to {}", rate);
+        co_await smp::invoke_on_all([rate] {
+            memory::set_heap_profiling_sampling_rate(rate);
+        });
+        co_return json::json_return_type(json::json_void());
+    });
+
+    hs::get_heap_profile.set(r, [](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        std::vector<sstring> profiles(smp::count);
+        co_await smp::invoke_on_all([&profiles] {
+            profiles[this_shard_id()] = get_shard_heap_profile();
+        });
+        co_return json::json_return_type(boost::algorithm::join(profiles, ""));
+    });
+
     hs::dump_profile.set(r, [](std::unique_ptr<request> req) {
         if (!__llvm_profile_dump) {
             apilog.info("Profile will not be dumped, executable is not instrumented with profile dumping.");
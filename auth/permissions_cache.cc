@@ -15,17 +15,31 @@
 namespace auth {
 
 permissions_cache::permissions_cache(const utils::loading_cache_config& c, service& ser, logging::logger& log)
-        : _cache(c, log, [&ser, &log](const key_type& k) {
+        : _cache(c, log, [this, &ser, &log](const key_type& k) {
               log.debug("Refreshing permissions for {}", k.first);
-              return ser.get_uncached_permissions(k.first, k.second);
+              auto batch = get_load_batch();
+              return ser.get_uncached_permissions(k.first, k.second, batch.get()).finally([this, batch] () mutable {
+                  batch = {};
+                  if (_load_batch && _load_batch.owned()) {
+                      _load_batch = {};
+                  }
+              });
           }) {
 }
 
+lw_shared_ptr<permissions_load_batch> permissions_cache::get_load_batch() {
+    if (!_load_batch || _load_batch->started + load_batch_period < seastar::lowres_clock::now()) {
+        _load_batch = make_lw_shared<permissions_load_batch>();
+    }
+    return _load_batch;
+}
+
 bool permissions_cache::update_config(utils::loading_cache_config c) {
     return _cache.update_config(std::move(c));
 }
 
 void permissions_cache::reset() {
+    _load_batch = {};
     _cache.reset();
 }
 
@@ -9,15 +9,19 @@
 #pragma once
 
 #include <iostream>
+#include <unordered_map>
 #include <utility>
 
 #include <fmt/core.h>
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 
 #include "auth/permission.hh"
 #include "auth/resource.hh"
+#include "auth/role_manager.hh"
 #include "auth/role_or_anonymous.hh"
 #include "log.hh"
 #include "utils/hash.hh"
@@ -40,6 +44,19 @@ namespace auth {
 
 class service;
 
+///
+/// Role lookups shared by permission loads started together.
+///
+/// When the cache is refreshed, the permissions of all its entries are loaded at once.
+/// Most entries are for the same few roles, so without sharing the lookups, each role and
+/// the roles granted to it would be queried once per entry.
+///
+struct permissions_load_batch {
+    seastar::lowres_clock::time_point started = seastar::lowres_clock::now();
+    std::unordered_map<sstring, shared_future<role_set>> roles;
+    std::unordered_map<sstring, shared_future<bool>> superuser;
+};
+
 class permissions_cache final {
     using cache_type = utils::loading_cache<
             std::pair<role_or_anonymous, resource>,
@@ -51,8 +68,14 @@ class permissions_cache final {
 
     using key_type = typename cache_type::key_type;
 
+    // Loads started within this period share a batch.
+    static constexpr seastar::lowres_clock::duration load_batch_period = std::chrono::milliseconds(100);
+
+    lw_shared_ptr<permissions_load_batch> _load_batch;
     cache_type _cache;
 
+    lw_shared_ptr<permissions_load_batch> get_load_batch();
+
 public:
     explicit permissions_cache(const utils::loading_cache_config&, service&, logging::logger&);
 
@@ -276,12 +276,43 @@ void service::reset_authorization_cache() {
 
 future<permission_set>
 service::get_uncached_permissions(const role_or_anonymous& maybe_role, const resource& r) const {
+    return get_uncached_permissions(maybe_role, r, nullptr);
+}
+
+future<role_set> service::get_roles(std::string_view role_name, permissions_load_batch& batch) const {
+    auto it = batch.roles.find(sstring(role_name));
+    if (it == batch.roles.end()) {
+        it = batch.roles.emplace(sstring(role_name), get_roles(role_name)).first;
+    }
+    return it->second.get_future();
+}
+
+future<bool> service::is_superuser(std::string_view role_name, permissions_load_batch& batch) const {
+    auto it = batch.superuser.find(sstring(role_name));
+    if (it == batch.superuser.end()) {
+        it = batch.superuser.emplace(sstring(role_name), _role_manager->is_superuser(role_name)).first;
+    }
+    return it->second.get_future();
+}
+
+future<permission_set>
+service::get_uncached_permissions(const role_or_anonymous& maybe_role, const resource& r, permissions_load_batch* batch) const {
     if (is_anonymous(maybe_role)) {
         co_return co_await _authorizer->authorize(maybe_role, r);
     }
     const std::string_view role_name = *maybe_role.name;
-    auto all_roles = co_await get_roles(role_name);
-    auto superuser = co_await has_superuser(role_name, all_roles);
+    auto all_roles = batch ? co_await get_roles(role_name, *batch) : co_await get_roles(role_name);
+    bool superuser = false;
+    if (batch) {
+        for (const auto& role : all_roles) {
+            if (co_await is_superuser(role, *batch)) {
+                superuser = true;
+                break;
+            }
+        }
+    } else {
+        superuser = co_await has_superuser(role_name, all_roles);
+    }
     if (superuser) {
         co_return r.applicable_permissions();
     }
@@ -145,6 +145,11 @@ class service final : public seastar::peering_sharded_service<service> {
     ///
     future<permission_set> get_uncached_permissions(const role_or_anonymous&, const resource&) const;
 
+    ///
+    /// Like \ref get_uncached_permissions, but the lookups of roles are shared with the other loads of the batch.
+    ///
+    future<permission_set> get_uncached_permissions(const role_or_anonymous&, const resource&, permissions_load_batch*) const;
+
     ///
     /// Query whether the named role has been granted a role that is a superuser.
     ///
@@ -197,6 +202,8 @@ class service final : public seastar::peering_sharded_service<service> {
 private:
     future<> create_legacy_keyspace_if_missing(::service::migration_manager& mm) const;
     future<bool> has_superuser(std::string_view role_name, const role_set& roles) const;
+    future<role_set> get_roles(std::string_view role_name, permissions_load_batch&) const;
+    future<bool> is_superuser(std::string_view role_name, permissions_load_batch&) const;
 };
 
 future<bool> has_superuser(const service&, const authenticated_user&);
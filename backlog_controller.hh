@@ -13,8 +13,10 @@
 #include <seastar/core/file.hh>
 #include <chrono>
 #include <cmath>
+#include <optional>
 
 #include "seastarx.hh"
+#include "utils/updateable_value.hh"
 
 // Simple proportional controller to adjust shares for processes for which a backlog can be clearly
 // defined.
@@ -35,10 +37,29 @@
 // region, and aggressively in the third region.
 //
 // The constants q1 and q2 are used to determine the proportional factor at each stage.
+//
+// The curve alone settles wherever the backlog produced by the workload meets the shares it maps to,
+// and with mixed workloads that point keeps moving, so the shares swing along with it. When a
+// target backlog is configured, the controller instead closes the loop: the curve's output at the
+// target is used as a feed-forward term, and a PID loop on the distance of the backlog from the
+// target corrects it, holding the backlog around the target.
 class backlog_controller {
 public:
     using scheduling_group = seastar::scheduling_group;
 
+    // Parameters of the closed-loop mode, all live-updateable.
+    //
+    // The error fed to the PID loop is the distance of the backlog from the target relative to the
+    // target, and the correction is relative to the maximum output of the curve, so the gains are
+    // independent of the unit of the backlog. The integral and derivative are taken over seconds.
+    struct feedback_config {
+        // Backlog to hold. 0 disables the closed-loop mode.
+        utils::updateable_value<float> target_backlog = utils::updateable_value<float>(0);
+        utils::updateable_value<float> proportional_gain = utils::updateable_value<float>(0.2);
+        utils::updateable_value<float> integral_gain = utils::updateable_value<float>(0.1);
+        utils::updateable_value<float> derivative_gain = utils::updateable_value<float>(0);
+    };
+
     future<> shutdown() {
         _update_timer.cancel();
         return std::move(_inflight_update);
@@ -49,6 +70,18 @@ class backlog_controller {
         return make_ready_future<>();
     }
 
+    // State of the controller as of the last adjustment, for metrics.
+    float last_backlog() const noexcept {
+        return _last_backlog;
+    }
+    float last_shares() const noexcept {
+        return _last_shares;
+    }
+    // Accumulated error of the closed-loop mode, 0 when it's disabled.
+    float integral_error() const noexcept {
+        return _integral_error;
+    }
+
 protected:
     struct control_point {
         float input;
@@ -60,6 +93,12 @@ class backlog_controller {
     std::vector<control_point> _control_points;
 
     std::function<float()> _current_backlog;
+    std::chrono::milliseconds _interval;
+    feedback_config _feedback;
+    float _last_backlog = 0;
+    float _last_shares = 0;
+    float _integral_error = 0;
+    std::optional<float> _last_error;
     timer<> _update_timer;
     // updating shares for an I/O class may contact another shard and returns a future.
     future<> _inflight_update;
@@ -76,12 +115,19 @@ class backlog_controller {
 
     void adjust();
 
+    // The output of the curve for the given backlog.
+    float shares_of_backlog(float backlog) const;
+    // The output of the closed-loop mode for the given backlog. Updates the state of the loop.
+    float feedback_shares(float backlog, float target);
+
     backlog_controller(scheduling_group sg, std::chrono::milliseconds interval,
                        std::vector<control_point> control_points, std::function<float()> backlog,
-                       float static_shares = 0)
+                       float static_shares = 0, feedback_config feedback = {})
         : _scheduling_group(std::move(sg))
         , _control_points()
         , _current_backlog(std::move(backlog))
+        , _interval(interval)
+        , _feedback(std::move(feedback))
         , _update_timer([this] { adjust(); })
         , _inflight_update(make_ready_future<>())
         , _static_shares(static_shares)
@@ -114,11 +160,13 @@ class backlog_controller {
 class flush_controller : public backlog_controller {
     static constexpr float hard_dirty_limit = 1.0f;
 public:
-    flush_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, float soft_limit, std::function<float()> current_dirty)
+    flush_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, float soft_limit, std::function<float()> current_dirty,
+                     feedback_config feedback = {})
         : backlog_controller(std::move(sg), std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 0.0}, {soft_limit, 10}, {soft_limit + (hard_dirty_limit - soft_limit) / 2, 200} , {hard_dirty_limit, 1000}}),
           std::move(current_dirty),
-          static_shares
+          static_shares,
+          std::move(feedback)
         )
     {}
 };
@@ -128,11 +176,13 @@ class compaction_controller : public backlog_controller {
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
     static constexpr float backlog_disabled(float backlog) { return std::isinf(backlog); }
-    compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog)
+    compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog,
+                          feedback_config feedback = {})
         : backlog_controller(std::move(sg), std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 50}, {1.5, 100} , {normalization_factor, 1000}}),
           std::move(current_backlog),
-          static_shares
+          static_shares,
+          std::move(feedback)
         )
     {}
 };
@@ -175,6 +175,15 @@ class bytes_ostream {
 
     bytes_ostream() noexcept : bytes_ostream(default_chunk_size) {}
 
+    // Returns the initial chunk size which fits data_size bytes in a single
+    // chunk, or in as few maximum sized chunks as possible if it is too large.
+    static size_type initial_chunk_size_for(size_t data_size) noexcept {
+        if (data_size + sizeof(chunk) >= max_alloc_size()) {
+            return max_alloc_size();
+        }
+        return std::max<size_type>(default_chunk_size, std::bit_ceil(data_size + sizeof(chunk)));
+    }
+
     bytes_ostream(bytes_ostream&& o) noexcept
         : _begin(std::exchange(o._begin, {}))
         , _current(o._current)
@@ -130,6 +130,8 @@ class cache_flat_mutation_reader final : public flat_mutation_reader_v2::impl {
     void move_to_range(query::clustering_row_ranges::const_iterator);
     void move_to_next_entry();
     void maybe_drop_last_entry(tombstone) noexcept;
+    bool next_row_is_inside_range_tombstone() noexcept;
+    static bool is_shadowed(const schema&, const deletable_row&, tombstone);
     void add_to_buffer(const partition_snapshot_row_cursor&);
     void add_clustering_row_to_buffer(mutation_fragment_v2&&);
     void add_to_buffer(range_tombstone_change&&);
@@ -774,6 +776,7 @@ void cache_flat_mutation_reader::copy_from_cache_to_buffer() {
 
     if (_next_row_in_range) {
         bool remove_row = false;
+        bool collapse_row = false;
 
         if (_read_context.tombstone_gc_state() // do not compact rows when tombstone_gc_state is not set (used in some unit tests)
             && !_next_row.dummy()
@@ -814,6 +817,9 @@ void cache_flat_mutation_reader::copy_from_cache_to_buffer() {
                 if (tomb_expired(latests_range_tomb)) {
                     _next_row.get_iterator_in_latest_version()->set_range_tombstone({});
                 }
+            } else if (range_tomb && next_row_is_inside_range_tombstone()
+                    && is_shadowed(_next_row.latest_row_schema(), row, range_tomb)) {
+                collapse_row = true;
             }
         }
 
@@ -843,6 +849,31 @@ void cache_flat_mutation_reader::copy_from_cache_to_buffer() {
                 row_ref->on_evicted(tracker);
             });
 
+            _snp->region().allocator().invalidate_references();
+            _next_row.force_valid();
+        } else if (collapse_row) {
+            // The row carries no information the range tombstone around it doesn't,
+            // drop it so that the range reads as a single continuous tombstoned range
+            // instead of a sequence of dead rows, which later reads would have to walk.
+            _read_context.cache()._tracker.on_row_collapsed();
+
+            _lower_bound = position_in_partition::after_key(*_schema, _next_row.position());
+
+            partition_snapshot_row_weakref row_ref(_next_row);
+            move_to_next_entry();
+
+            with_allocator(_snp->region().allocator(), [&] {
+                cache_tracker& tracker = _read_context.cache()._tracker;
+                if (row_ref->is_linked()) {
+                    tracker.get_lru().remove(*row_ref);
+                }
+                // Unlike on_evicted(), keeps the continuity of the successor,
+                // the range tombstone of which covers the removed row.
+                mutation_partition_v2::rows_type::iterator it(&*row_ref);
+                mutation_partition_v2::rows_type::key_grabber kg(it);
+                kg.release(current_deleter<rows_entry>());
+            });
+
             _snp->region().allocator().invalidate_references();
             _next_row.force_valid();
         } else {
@@ -922,6 +953,31 @@ void cache_flat_mutation_reader::move_to_range(query::clustering_row_ranges::con
     }
 }
 
+// Returns true iff the row at _next_row is inside a continuous range covered by a single
+// range tombstone, so that it can be removed without losing continuity.
+// Call only when the snapshot has a single version and _next_row is at a non-dummy row.
+inline
+bool cache_flat_mutation_reader::next_row_is_inside_range_tombstone() noexcept {
+    if (_read_context.is_reversed() || !_next_row.continuous()) { // FIXME: reversed
+        return false;
+    }
+    auto it = _next_row.get_iterator_in_latest_version();
+    // There is always the last dummy after a non-dummy row
+    auto next = std::next(it);
+    return it->range_tombstone() && next->continuous() && next->range_tombstone() == it->range_tombstone();
+}
+
+// Returns true iff all the information in the row is shadowed by the tombstone.
+inline
+bool cache_flat_mutation_reader::is_shadowed(const schema& s, const deletable_row& row, tombstone t) {
+    return with_allocator(standard_allocator(), [&] {
+        can_gc_fn never_gc = [] (tombstone) { return false; };
+        deletable_row row_copy(s, row);
+        row_copy.compact_and_expire(s, t, gc_clock::time_point::min(), never_gc, gc_clock::time_point::min(), nullptr);
+        return row_copy.empty();
+    });
+}
+
 // Drops _last_row entry when possible without changing logical contents of the partition.
 // Call only when _last_row and _next_row are valid.
 // Calling after ensure_population_lower_bound() is ok.
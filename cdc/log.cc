@@ -1637,7 +1637,6 @@ class transformer final : public change_processor {
 
         query::column_id_vector static_columns, regular_columns;
 
-        // TODO: this assumes all mutations touch the same set of columns. This might not be true, and we may need to do more horrible set operation here.
         if (!p.static_row().empty()) {
             // for postimage we need everything...
             if (_schema->cdc_options().postimage() || _schema->cdc_options().full_preimage()) {
@@ -1664,11 +1663,19 @@ class transformer final : public change_processor {
                     columns.emplace_back(&c);
                 }
             } else {
-                p.clustered_rows().begin()->row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+                // The rows may touch different columns, e.g. if the mutation
+                // coalesces several mutations of the partition.
+                one_kind_column_set touched(_schema->regular_columns_count());
+                for (const rows_entry& r : p.clustered_rows()) {
+                    r.row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+                        touched.set(id);
+                    });
+                }
+                for (auto id = touched.find_first(); id != one_kind_column_set::npos; id = touched.find_next(id)) {
                     const auto& cdef =_schema->column_at(column_kind::regular_column, id);
                     regular_columns.emplace_back(id);
                     columns.emplace_back(&cdef);
-                });
+                }
             }
         }
         
@@ -1700,9 +1707,12 @@ class transformer final : public change_processor {
     }
 
     // Note: this assumes that the results are from one partition only
-    void load_preimage_results_into_state(lw_shared_ptr<cql3::untyped_result_set> preimage_set, bool static_only) {
+    // The results may cover more than the mutation's rows and columns if its
+    // preimage select was shared with other mutations of the partition, so
+    // the static row is only loaded if the mutation has one.
+    void load_preimage_results_into_state(lw_shared_ptr<cql3::untyped_result_set> preimage_set, bool static_only, bool has_static) {
         // static row
-        if (!preimage_set->empty()) {
+        if (has_static && !preimage_set->empty()) {
             // There may be some static row data
             const auto& row = preimage_set->front();
             for (auto& c : _schema->static_columns()) {
@@ -1761,6 +1771,64 @@ class transformer final : public change_processor {
     }
 };
 
+// Mutations of the same partition, e.g. from a batch, share a single preimage
+// select, made with a mutation coalescing all of them. All the selects are
+// done before any of the mutations is applied, so each of them still sees
+// the state of the partition from before the whole operation.
+class preimage_selects {
+    using select_future = shared_future<lw_shared_ptr<cql3::untyped_result_set>>;
+    struct group {
+        // Coalesced mutations of the group, engaged if there are several.
+        std::optional<mutation> coalesced;
+        std::optional<select_future> select;
+    };
+    std::vector<group> _groups;
+    // Index in _groups of the group of each mutation.
+    std::vector<size_t> _group_of;
+public:
+    void group(const std::vector<mutation>& mutations) {
+        std::unordered_map<dht::token, std::vector<size_t>> by_token;
+        _group_of.resize(mutations.size());
+        for (size_t i = 0; i < mutations.size(); ++i) {
+            auto& m = mutations[i];
+            auto& opts = m.schema()->cdc_options();
+            if (!opts.enabled() || !(opts.preimage() || opts.postimage())) {
+                continue;
+            }
+            auto& candidates = by_token[m.token()];
+            auto it = std::find_if(candidates.begin(), candidates.end(), [&] (size_t j) {
+                return mutations[j].schema() == m.schema() && mutations[j].decorated_key().equal(*m.schema(), m.decorated_key());
+            });
+            if (it == candidates.end()) {
+                candidates.push_back(i);
+                _group_of[i] = _groups.size();
+                _groups.emplace_back();
+                continue;
+            }
+            auto& g = _groups[_group_of[*it]];
+            if (!g.coalesced) {
+                g.coalesced = mutations[*it];
+            }
+            g.coalesced->apply(m);
+            _group_of[i] = _group_of[*it];
+        }
+    }
+
+    // Returns the result of the preimage select for mutation m of the given
+    // index, made with do_select() by the first mutation of its group to ask.
+    template <typename Func>
+    future<lw_shared_ptr<cql3::untyped_result_set>> get(size_t idx, const mutation& m, Func&& do_select) {
+        auto& g = _groups[_group_of[idx]];
+        if (!g.coalesced) {
+            return do_select(m);
+        }
+        if (!g.select) {
+            g.select.emplace(do_select(*g.coalesced));
+        }
+        return g.select->get_future();
+    }
+};
+
 template <typename Func>
 future<std::vector<mutation>>
 transform_mutations(std::vector<mutation>& muts, decltype(muts.size()) batch_size, Func&& f) {
@@ -1787,9 +1855,10 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
     tracing::trace(tr_state, "CDC: Started generating mutations for log rows");
     mutations.reserve(2 * mutations.size());
 
-    return do_with(std::move(mutations), service::query_state(service::client_state::for_internal_calls(), empty_service_permit()), operation_details{},
-            [this, tr_state = std::move(tr_state), write_cl] (std::vector<mutation>& mutations, service::query_state& qs, operation_details& details) {
-        return transform_mutations(mutations, 1, [this, &mutations, &qs, tr_state = tr_state, &details, write_cl] (int idx) mutable {
+    return do_with(std::move(mutations), service::query_state(service::client_state::for_internal_calls(), empty_service_permit()), operation_details{}, preimage_selects{},
+            [this, tr_state = std::move(tr_state), write_cl] (std::vector<mutation>& mutations, service::query_state& qs, operation_details& details, preimage_selects& selects) {
+        selects.group(mutations);
+        return transform_mutations(mutations, 1, [this, &mutations, &qs, tr_state = tr_state, &details, &selects, write_cl] (int idx) mutable {
             auto& m = mutations[idx];
             auto s = m.schema();
 
@@ -1801,17 +1870,16 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
 
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
             if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
-                // Note: further improvement here would be to coalesce the pre-image selects into one
-                // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
-                // so this is premature.
-                tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
-                f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
-                    auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
-                    cdc_stats.counters_total.preimage_selects++;
-                    if (f.failed()) {
-                        cdc_stats.counters_failed.preimage_selects++;
-                    }
-                    return f;
+                f = selects.get(idx, m, [&] (const mutation& select_m) {
+                    tracing::trace(tr_state, "CDC: Selecting preimage for {}", select_m.decorated_key());
+                    return trans.pre_image_select(qs.get_client_state(), write_cl, select_m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+                        auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
+                        cdc_stats.counters_total.preimage_selects++;
+                        if (f.failed()) {
+                            cdc_stats.counters_failed.preimage_selects++;
+                        }
+                        return f;
+                    });
                 });
             } else {
                 tracing::trace(tr_state, "CDC: Preimage not enabled for the table, not querying current value of {}", m.decorated_key());
@@ -1821,10 +1889,10 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 auto& m = mutations[idx];
                 auto& s = m.schema();
 
-                if (rs) {
-                    const auto& p = m.partition();
+                const auto& p = m.partition();
+                if (rs && (!p.static_row().empty() || !p.clustered_rows().empty())) {
                     const bool static_only = !p.static_row().empty() && p.clustered_rows().empty();
-                    trans.load_preimage_results_into_state(std::move(rs), static_only);
+                    trans.load_preimage_results_into_state(std::move(rs), static_only, !p.static_row().empty());
                 }
 
                 const bool preimage = s->cdc_options().preimage();
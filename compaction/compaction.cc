@@ -42,6 +42,7 @@
 #include "mutation/mutation_compactor.hh"
 #include "leveled_manifest.hh"
 #include "dht/partition_filter.hh"
+#include "cdc/cdc_partitioner.hh"
 #include "mutation_writer/shard_based_splitting_writer.hh"
 #include "mutation_writer/partition_based_splitting_writer.hh"
 #include "mutation/mutation_source_metadata.hh"
@@ -170,6 +171,18 @@ static api::timestamp_type get_max_purgeable_timestamp(const table_state& table_
     return timestamp;
 }
 
+// Returns true iff no partition of the sstable can be in the sorted owned ranges.
+static bool is_fully_disowned(const shared_sstable& sst, const dht::token_range_vector& sorted_owned_ranges) {
+    auto first_token = sst->get_first_decorated_key().token();
+    auto last_token = sst->get_last_decorated_key().token();
+    auto r = std::lower_bound(sorted_owned_ranges.begin(), sorted_owned_ranges.end(), first_token,
+            [] (const dht::token_range& a, const dht::token& b) {
+        return a.after(b, dht::token_comparator());
+    });
+    // r is the first owned range which doesn't end before the sstable starts
+    return r == sorted_owned_ranges.end() || r->before(last_token, dht::token_comparator());
+}
+
 static std::vector<shared_sstable> get_uncompacting_sstables(const table_state& table_s, std::vector<shared_sstable> sstables) {
     auto all_sstables = boost::copy_range<std::vector<shared_sstable>>(*table_s.main_sstable_set().all());
     auto& compacted_undeleted = table_s.compacted_undeleted_sstables();
@@ -574,9 +587,31 @@ class compaction {
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
         cfg.sstable_level = _sstable_level;
+        cfg.repaired_at = repaired_at();
+        if (is_cold()) {
+            cfg.compression = _schema->get_compressor_params().for_cold_data();
+        }
         return cfg;
     }
 
+    // Whether the output holds only data old enough to be written with the cold compressor.
+    bool is_cold() const {
+        const auto& cp = _schema->get_compressor_params();
+        if (!cp.get_cold_compressor() || _sstables.empty()) {
+            return false;
+        }
+        const auto cold_before = api::new_timestamp() - std::chrono::duration_cast<std::chrono::microseconds>(*cp.cold_after()).count();
+        return maximum_timestamp() < cold_before;
+    }
+
+    // The output is repaired only if all of the input is.
+    uint64_t repaired_at() const {
+        auto m = std::min_element(_sstables.begin(), _sstables.end(), [] (const shared_sstable& sst1, const shared_sstable& sst2) {
+            return sst1->get_repaired_at() < sst2->get_repaired_at();
+        });
+        return m != _sstables.end() ? (*m)->get_repaired_at() : 0;
+    }
+
     api::timestamp_type maximum_timestamp() const {
         auto m = std::max_element(_sstables.begin(), _sstables.end(), [] (const shared_sstable& sst1, const shared_sstable& sst2) {
             return sst1->get_stats_metadata().max_timestamp < sst2->get_stats_metadata().max_timestamp;
@@ -745,6 +780,11 @@ class compaction {
                 log_debug("Fully expired sstable {} will be dropped on compaction completion", sst->get_filename());
                 continue;
             }
+            // Cleanup doesn't need to read a sstable which holds only data it would drop.
+            if (_owned_ranges && is_fully_disowned(sst, *_owned_ranges)) {
+                log_debug("Fully disowned sstable {} will be dropped on compaction completion", sst->get_filename());
+                continue;
+            }
             _stats_collector.update(sst->get_encoding_stats_for_compaction());
 
             _cdata.compaction_size += sst->data_size();
@@ -763,7 +803,7 @@ class compaction {
         }
         log_info("{} [{}]", report_start_desc(), fmt::join(_sstables | boost::adaptors::transformed([] (auto sst) { return to_string(sst, true); }), ","));
         if (ssts->size() < _sstables.size()) {
-            log_debug("{} out of {} input sstables are fully expired sstables that will not be actually compacted",
+            log_debug("{} out of {} input sstables are fully expired or disowned sstables that will not be actually compacted",
                       _sstables.size() - ssts->size(), _sstables.size());
         }
         // _estimated_droppable_tombstone_ratio could exceed 1.0 in certain cases, so limit it to 1.0.
@@ -1797,15 +1837,26 @@ static future<compaction_result> scrub_sstables_validate_mode(sstables::compacti
     auto schema = table_s.schema();
     auto permit = table_s.make_compaction_reader_permit();
 
+    using scrub = sstables::compaction_type_options::scrub;
+    const auto checksums_only = descriptor.options.as<scrub>().validate_checksums_only;
+
     uint64_t validation_errors = 0;
     cdata.compaction_size = boost::accumulate(descriptor.sstables | boost::adaptors::transformed([] (auto& sst) { return sst->data_size(); }), int64_t(0));
 
     for (const auto& sst : descriptor.sstables) {
-        clogger.info("Scrubbing in validate mode {}", sst->get_filename());
+        clogger.info("Scrubbing in validate mode {}{}", sst->get_filename(), checksums_only ? " (checksums only)" : "");
 
-        validation_errors += co_await sst->validate(permit, cdata.abort, [&schema] (sstring what) {
-            scrub_compaction::report_validation_error(compaction_type::Scrub, *schema, what);
-        }, monitor_generator(sst));
+        if (checksums_only) {
+            // The mismatches themselves are logged by validate_checksums()
+            if (!co_await sstables::validate_checksums(sst, permit)) {
+                scrub_compaction::report_validation_error(compaction_type::Scrub, *schema, format("{}: checksum mismatch", sst->get_filename()));
+                ++validation_errors;
+            }
+        } else {
+            validation_errors += co_await sst->validate(permit, cdata.abort, [&schema] (sstring what) {
+                scrub_compaction::report_validation_error(compaction_type::Scrub, *schema, what);
+            }, monitor_generator(sst));
+        }
         // Did validation actually finish because aborted?
         if (cdata.is_stop_requested()) {
             // Compaction manager will catch this exception and re-schedule the compaction.
@@ -1815,7 +1866,6 @@ static future<compaction_result> scrub_sstables_validate_mode(sstables::compacti
         clogger.info("Finished scrubbing in validate mode {} - sstable is {}", sst->get_filename(), validation_errors == 0 ? "valid" : "invalid");
     }
 
-    using scrub = sstables::compaction_type_options::scrub;
     if (validation_errors != 0 && descriptor.options.as<scrub>().quarantine_sstables == scrub::quarantine_invalid_sstables::yes) {
         for (auto& sst : descriptor.sstables) {
             co_await sst->change_state(sstables::sstable_state::quarantine);
@@ -1861,7 +1911,17 @@ get_fully_expired_sstables(const table_state& table_s, const std::vector<sstable
     }
 
     std::unordered_set<sstables::shared_sstable> candidates;
-    auto uncompacting_sstables = get_uncompacting_sstables(table_s, compacting);
+    // CDC log tables are append-only: CDC writes each log row once, under a
+    // unique key, with the table's TTL, and never deletes it. An expired
+    // sstable of such a table cannot shadow data in other sstables, so it can
+    // be dropped without looking at them. Since the CDC partitioner spreads
+    // streams over the whole ring, every sstable of a log table overlaps all
+    // others, and a single non-expired sstable with old data, e.g. one
+    // received by repair, would otherwise hold back dropping all later windows.
+    // Manual deletions from the log are not protected, the deleted rows may
+    // reappear until they expire.
+    const bool append_only = table_s.schema()->get_partitioner().name() == cdc::cdc_partitioner::classname;
+    auto uncompacting_sstables = append_only ? std::vector<sstables::shared_sstable>() : get_uncompacting_sstables(table_s, compacting);
     // Get list of uncompacting sstables that overlap the ones being compacted.
     std::vector<sstables::shared_sstable> overlapping = leveled_manifest::overlapping(*table_s.schema(), compacting, uncompacting_sstables);
     int64_t min_timestamp = std::numeric_limits<int64_t>::max();
@@ -1895,7 +1955,7 @@ get_fully_expired_sstables(const table_state& table_s, const std::vector<sstable
         if (candidate->get_max_local_deletion_time() < gc_before && !has_undeleted_ancestor(candidate)) {
             clogger.debug("Adding candidate of generation {} to list of possibly expired sstables", candidate->generation());
             candidates.insert(candidate);
-        } else {
+        } else if (!append_only) {
             min_timestamp = std::min(min_timestamp, candidate->get_stats_metadata().min_timestamp);
         }
     }
@@ -76,6 +76,15 @@ class compaction_type_options {
         // Should invalid sstables be moved into quarantine.
         // Only applies to validate-mode.
         quarantine_invalid_sstables quarantine_sstables = quarantine_invalid_sstables::yes;
+
+        using checksums_only = bool_class<class checksums_only_tag>;
+
+        // Should only the checksums of the data file be validated: the per-chunk checksums
+        // and the full checksum in Digest.db. Reads the data file sequentially without
+        // parsing it, so it is much cheaper than the full validation, but it cannot
+        // detect invalid content which was written with valid checksums.
+        // Only applies to validate-mode.
+        checksums_only validate_checksums_only = checksums_only::no;
     };
     struct reshard {
     };
@@ -115,8 +124,9 @@ class compaction_type_options {
         return compaction_type_options(upgrade{});
     }
 
-    static compaction_type_options make_scrub(scrub::mode mode, scrub::quarantine_invalid_sstables quarantine_sstables = scrub::quarantine_invalid_sstables::yes) {
-        return compaction_type_options(scrub{.operation_mode = mode, .quarantine_sstables = quarantine_sstables});
+    static compaction_type_options make_scrub(scrub::mode mode, scrub::quarantine_invalid_sstables quarantine_sstables = scrub::quarantine_invalid_sstables::yes,
+            scrub::checksums_only validate_checksums_only = scrub::checksums_only::no) {
+        return compaction_type_options(scrub{.operation_mode = mode, .quarantine_sstables = quarantine_sstables, .validate_checksums_only = validate_checksums_only});
     }
 
     static compaction_type_options make_split(mutation_writer::classify_by_token_group classifier) {
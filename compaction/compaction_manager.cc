@@ -24,8 +24,10 @@
 #include "sstables/sstable_directory.hh"
 #include "utils/error_injection.hh"
 #include "utils/UUID_gen.hh"
+#include "utils/pretty_printers.hh"
 #include "db/system_keyspace.hh"
 #include <cmath>
+#include <ranges>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 
@@ -379,7 +381,10 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables_a
     }
 
     bool should_update_history = this->should_update_history(descriptor.options.type());
-    sstables::compaction_result res = co_await compact_sstables(std::move(descriptor), cdata, on_replace, std::move(can_purge));
+    auto subranges = compaction_subranges(descriptor);
+    sstables::compaction_result res = subranges > 1
+            ? co_await compact_sstables_in_subranges(std::move(descriptor), cdata, on_replace, std::move(can_purge), subranges)
+            : co_await compact_sstables(std::move(descriptor), cdata, on_replace, std::move(can_purge));
 
     if (should_update_history) {
         co_await update_history(*_compacting_table, res, cdata);
@@ -418,6 +423,12 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables(s
         on_replace.on_removal(old_sstables);
     };
 
+    maybe_set_owned_ranges(descriptor);
+
+    co_return co_await sstables::compact_sstables(std::move(descriptor), cdata, t, _progress_monitor);
+}
+
+void compaction_task_executor::maybe_set_owned_ranges(sstables::compaction_descriptor& descriptor) const {
     // retrieve owned_ranges if_required
     if (!descriptor.owned_ranges) {
         std::vector<sstables::shared_sstable> sstables_requiring_cleanup;
@@ -435,8 +446,169 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables(s
             descriptor.owned_ranges = cs.owned_ranges_ptr;
         }
     }
+}
 
-    co_return co_await sstables::compact_sstables(std::move(descriptor), cdata, t, _progress_monitor);
+unsigned compaction_task_executor::compaction_subranges(const sstables::compaction_descriptor& descriptor) const {
+    auto parallelism = _cm._cfg.subrange_parallelism.get();
+    auto type = descriptor.options.type();
+    if (parallelism <= 1 || descriptor.has_only_fully_expired || descriptor.sstables.size() < 2
+            || (type != sstables::compaction_type::Compaction && type != sstables::compaction_type::Cleanup && type != sstables::compaction_type::Reshape)) {
+        return 1;
+    }
+    auto min_subrange_size = std::max<uint64_t>(uint64_t(_cm._cfg.subrange_min_size_in_mb.get()) << 20, 1);
+    return std::clamp<uint64_t>(descriptor.sstables_size() / min_subrange_size, 1, parallelism);
+}
+
+// Splits the token span of the given sstables into count sub-ranges of about
+// the same width, which together cover the whole ring.
+static dht::token_range_vector make_compaction_subranges(const std::vector<sstables::shared_sstable>& sstables, unsigned count) {
+    auto first = std::ranges::min(sstables | std::views::transform([] (const sstables::shared_sstable& sst) {
+        return dht::unbias(sst->get_first_decorated_key().token());
+    }));
+    auto last = std::ranges::max(sstables | std::views::transform([] (const sstables::shared_sstable& sst) {
+        return dht::unbias(sst->get_last_decorated_key().token());
+    }));
+    if (last - first < count) {
+        return {};
+    }
+    dht::token_range_vector ranges;
+    ranges.reserve(count);
+    std::optional<dht::token> prev;
+    for (unsigned i = 1; i < count; i++) {
+        auto boundary = dht::bias(first + (last - first) / count * i);
+        ranges.push_back(prev ? dht::token_range::make({*prev, false}, {boundary, true}) : dht::token_range::make_ending_with({boundary, true}));
+        prev = boundary;
+    }
+    ranges.push_back(dht::token_range::make_starting_with({*prev, false}));
+    return ranges;
+}
+
+future<sstables::compaction_result> compaction_task_executor::compact_sstables_in_subranges(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, on_replacement& on_replace,
+        compaction_manager::can_purge_tombstones can_purge, unsigned count, sstables::offstrategy offstrategy) {
+    table_state& t = *_compacting_table;
+    auto subranges = make_compaction_subranges(descriptor.sstables, count);
+    if (subranges.empty()) {
+        co_return co_await compact_sstables(std::move(descriptor), cdata, on_replace, can_purge, offstrategy);
+    }
+    maybe_set_owned_ranges(descriptor);
+
+    struct subrange_compaction {
+        sstables::compaction_descriptor descriptor;
+        sstables::compaction_data cdata;
+        sstables::compaction_progress_monitor progress_monitor;
+        std::vector<sstables::shared_sstable> output;
+    };
+    std::list<subrange_compaction> subs;
+    for (auto& subrange : subranges) {
+        // Each sub-compaction reads only its sub-range of the input, which is
+        // enforced by restricting its owned ranges, so cleanup is still done
+        // when needed.
+        dht::token_range_vector ranges;
+        if (descriptor.owned_ranges) {
+            for (auto& r : *descriptor.owned_ranges) {
+                if (auto i = r.intersection(subrange, dht::token_comparator())) {
+                    ranges.push_back(std::move(*i));
+                }
+            }
+            if (ranges.empty()) {
+                continue;
+            }
+        } else {
+            ranges.push_back(subrange);
+        }
+        auto& sub = subs.emplace_back();
+        sub.cdata.compaction_uuid = cdata.compaction_uuid;
+        // All sub-compactions write to the same run, as their outputs are disjoint.
+        sub.descriptor = sstables::compaction_descriptor(descriptor.sstables, descriptor.level, descriptor.max_sstable_bytes,
+                descriptor.run_identifier, descriptor.options, make_lw_shared<const dht::token_range_vector>(std::move(ranges)));
+        sub.descriptor.can_split_large_partition = descriptor.can_split_large_partition;
+        if (can_purge) {
+            sub.descriptor.enable_garbage_collection(t.main_sstable_set());
+        }
+        sub.descriptor.creator = [&t] (shard_id dummy) {
+            return t.make_sstable();
+        };
+        // The input is still needed by the other sub-compactions, so it's replaced
+        // only once all of them are done. Until then, only collect the output.
+        sub.descriptor.replacer = [&sub] (sstables::compaction_completion_desc desc) {
+            for (auto& sst : desc.old_sstables) {
+                // Garbage collected sstables created by the sub-compaction itself
+                // were never added to the table, and are not needed anymore.
+                if (std::erase(sub.output, sst)) {
+                    sst->mark_for_deletion();
+                }
+            }
+            sub.output.insert(sub.output.end(), desc.new_sstables.begin(), desc.new_sstables.end());
+        };
+    }
+
+    auto stop_subcompactions = [&subs] (const sstring& reason) noexcept {
+        for (auto& sub : subs) {
+            try {
+                sub.cdata.stop(reason);
+            } catch (...) {
+                sub.cdata.abort.request_abort();
+            }
+        }
+    };
+    if (cdata.is_stop_requested()) {
+        throw make_compaction_stopped_exception();
+    }
+    auto stop_subscription = cdata.abort.subscribe([&] () noexcept {
+        stop_subcompactions(cdata.stop_requested);
+    });
+
+    cmlog.info("Splitting compaction of {} sstables ({}) on behalf of {} into {} concurrent sub-range compactions",
+            descriptor.sstables.size(), utils::pretty_printed_data_size(descriptor.sstables_size()), t, subs.size());
+
+    std::exception_ptr ex;
+    sstables::compaction_stats stats;
+    co_await coroutine::parallel_for_each(subs, [&] (subrange_compaction& sub) -> future<> {
+        try {
+            auto res = co_await sstables::compact_sstables(std::move(sub.descriptor), sub.cdata, t, sub.progress_monitor);
+            stats += res.stats;
+        } catch (...) {
+            if (!ex) {
+                ex = std::current_exception();
+                stop_subcompactions("sibling sub-range compaction failed");
+            }
+        }
+    });
+
+    std::vector<sstables::shared_sstable> new_sstables;
+    for (auto& sub : subs) {
+        cdata.compaction_size += sub.cdata.compaction_size;
+        cdata.total_partitions += sub.cdata.total_partitions;
+        cdata.total_keys_written += sub.cdata.total_keys_written;
+        new_sstables.insert(new_sstables.end(), sub.output.begin(), sub.output.end());
+    }
+    if (ex) {
+        for (auto& sst : new_sstables) {
+            sst->mark_for_deletion();
+        }
+        std::rethrow_exception(ex);
+    }
+
+    // Commit the output of all sub-compactions at once.
+    dht::partition_range_vector ranges_for_invalidation;
+    if (descriptor.owned_ranges) {
+        auto non_owned_ranges = boost::copy_range<dht::partition_range_vector>(descriptor.sstables
+                | boost::adaptors::transformed([] (const sstables::shared_sstable& sst) {
+            return dht::partition_range::make({sst->get_first_decorated_key(), true}, {sst->get_last_decorated_key(), true});
+        }));
+        ranges_for_invalidation = co_await dht::subtract_ranges(*t.schema(), non_owned_ranges, dht::to_partition_ranges(*descriptor.owned_ranges));
+    }
+    auto desc = sstables::compaction_completion_desc{descriptor.sstables, new_sstables, std::move(ranges_for_invalidation)};
+    t.get_compaction_strategy().notify_completion(t, desc.old_sstables, desc.new_sstables);
+    _cm.propagate_replacement(t, desc.old_sstables, desc.new_sstables);
+    on_replace.on_addition(desc.new_sstables);
+    co_await _cm.on_compaction_completion(t, std::move(desc), offstrategy);
+    on_replace.on_removal(descriptor.sstables);
+
+    co_return sstables::compaction_result{
+        .new_sstables = std::move(new_sstables),
+        .stats = stats,
+    };
 }
 future<> compaction_task_executor::update_history(table_state& t, const sstables::compaction_result& res, const sstables::compaction_data& cdata) {
     auto ended_at = std::chrono::duration_cast<std::chrono::milliseconds>(res.stats.ended_at.time_since_epoch());
@@ -754,8 +926,9 @@ auto fmt::formatter<compaction::compaction_task_executor>::format(const compacti
                           ex._description, fmt::ptr(&ex), *t, fmt::ptr(t));
 }
 
-inline compaction_controller make_compaction_controller(const compaction_manager::scheduling_group& csg, uint64_t static_shares, std::function<double()> fn) {
-    return compaction_controller(csg, static_shares, 250ms, std::move(fn));
+inline compaction_controller make_compaction_controller(const compaction_manager::scheduling_group& csg, uint64_t static_shares, std::function<double()> fn,
+        backlog_controller::feedback_config feedback = {}) {
+    return compaction_controller(csg, static_shares, 250ms, std::move(fn), std::move(feedback));
 }
 
 compaction::compaction_state::~compaction_state() {
@@ -887,7 +1060,7 @@ compaction_manager::compaction_manager(config cfg, abort_source& as, tasks::task
             return compaction_controller::normalization_factor;
         }
         return b;
-    }))
+    }, _cfg.controller_feedback))
     , _backlog_manager(_compaction_controller)
     , _early_abort_subscription(as.subscribe([this] () noexcept {
         do_stop();
@@ -965,6 +1138,10 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
+        sm::make_gauge("controller_shares", [this] { return _compaction_controller.last_shares(); },
+                       sm::description("Holds the shares set by the compaction controller on its last adjustment.")),
+        sm::make_gauge("controller_integral_error", [this] { return _compaction_controller.integral_error(); },
+                       sm::description("Holds the error accumulated by the compaction controller in closed-loop mode (see compaction_controller_target_backlog).")),
     });
 }
 
@@ -1390,9 +1567,16 @@ class offstrategy_compaction_task_executor : public compaction_task_executor, pu
             auto on_replace = compacting.update_on_sstable_replacement();
 
             try {
-                sstables::compaction_result _ = co_await compact_sstables(std::move(*desc), _compaction_data, on_replace,
-                                                                          compaction_manager::can_purge_tombstones::no,
-                                                                          sstables::offstrategy::yes);
+                // Repair-based node operations produce a lot of mostly disjoint input, which
+                // can be reshaped by several sub-range compactions running concurrently.
+                auto subranges = compaction_subranges(*desc);
+                sstables::compaction_result _ = subranges > 1
+                        ? co_await compact_sstables_in_subranges(std::move(*desc), _compaction_data, on_replace,
+                                                                 compaction_manager::can_purge_tombstones::no, subranges,
+                                                                 sstables::offstrategy::yes)
+                        : co_await compact_sstables(std::move(*desc), _compaction_data, on_replace,
+                                                    compaction_manager::can_purge_tombstones::no,
+                                                    sstables::offstrategy::yes);
             } catch (sstables::compaction_stopped_exception&) {
                 // If off-strategy compaction stopped on user request, let's not discard the partial work.
                 // Therefore, both un-reshaped and reshaped data will be integrated into main set, allowing
@@ -1647,9 +1831,12 @@ compaction_manager::rewrite_sstables(table_state& t, sstables::compaction_type_o
 namespace compaction {
 
 class validate_sstables_compaction_task_executor : public sstables_task_executor {
+    sstables::compaction_type_options::scrub::checksums_only _checksums_only;
 public:
-    validate_sstables_compaction_task_executor(compaction_manager& mgr, throw_if_stopping do_throw_if_stopping, table_state* t, tasks::task_id parent_id, std::vector<sstables::shared_sstable> sstables)
+    validate_sstables_compaction_task_executor(compaction_manager& mgr, throw_if_stopping do_throw_if_stopping, table_state* t, tasks::task_id parent_id, std::vector<sstables::shared_sstable> sstables,
+            sstables::compaction_type_options::scrub::checksums_only checksums_only)
         : sstables_task_executor(mgr, do_throw_if_stopping, t, sstables::compaction_type::Scrub, "Scrub compaction in validate mode", std::move(sstables), parent_id)
+        , _checksums_only(checksums_only)
     {}
 
 protected:
@@ -1678,7 +1865,8 @@ class validate_sstables_compaction_task_executor : public sstables_task_executor
                     sst->get_sstable_level(),
                     sstables::compaction_descriptor::default_max_sstable_bytes,
                     sst->run_identifier(),
-                    sstables::compaction_type_options::make_scrub(sstables::compaction_type_options::scrub::mode::validate));
+                    sstables::compaction_type_options::make_scrub(sstables::compaction_type_options::scrub::mode::validate,
+                            sstables::compaction_type_options::scrub::quarantine_invalid_sstables::yes, _checksums_only));
             co_return co_await sstables::compact_sstables(std::move(desc), _compaction_data, *_compacting_table, _progress_monitor);
         } catch (sstables::compaction_stopped_exception&) {
             // ignore, will be handled by can_proceed()
@@ -1708,14 +1896,14 @@ static std::vector<sstables::shared_sstable> get_all_sstables(table_state& t) {
     return s;
 }
 
-future<compaction_manager::compaction_stats_opt> compaction_manager::perform_sstable_scrub_validate_mode(table_state& t, std::optional<tasks::task_info> info) {
+future<compaction_manager::compaction_stats_opt> compaction_manager::perform_sstable_scrub_validate_mode(table_state& t, sstables::compaction_type_options::scrub::checksums_only checksums_only, std::optional<tasks::task_info> info) {
     auto gh = start_compaction(t);
     if (!gh) {
         co_return compaction_stats_opt{};
     }
     // All sstables must be included, even the ones being compacted, such that everything in table is validated.
     auto all_sstables = get_all_sstables(t);
-    co_return co_await perform_compaction<validate_sstables_compaction_task_executor>(throw_if_stopping::no, info, &t, info.value_or(tasks::task_info{}).id, std::move(all_sstables));
+    co_return co_await perform_compaction<validate_sstables_compaction_task_executor>(throw_if_stopping::no, info, &t, info.value_or(tasks::task_info{}).id, std::move(all_sstables), checksums_only);
 }
 
 namespace compaction {
@@ -2024,7 +2212,7 @@ future<compaction_manager::compaction_stats_opt> compaction_manager::perform_spl
 future<compaction_manager::compaction_stats_opt> compaction_manager::perform_sstable_scrub(table_state& t, sstables::compaction_type_options::scrub opts, std::optional<tasks::task_info> info) {
     auto scrub_mode = opts.operation_mode;
     if (scrub_mode == sstables::compaction_type_options::scrub::mode::validate) {
-        return perform_sstable_scrub_validate_mode(t, info);
+        return perform_sstable_scrub_validate_mode(t, opts.validate_checksums_only, info);
     }
     owned_ranges_ptr owned_ranges_ptr = {};
     sstring option_desc = fmt::format("mode: {};\nquarantine_mode: {}\n", opts.operation_mode, opts.quarantine_operation_mode);
@@ -88,6 +88,9 @@ class compaction_manager {
         size_t available_memory = 0;
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<uint32_t> subrange_parallelism = utils::updateable_value<uint32_t>(1);
+        utils::updateable_value<uint32_t> subrange_min_size_in_mb = utils::updateable_value<uint32_t>(1024);
+        backlog_controller::feedback_config controller_feedback;
     };
 
 public:
@@ -232,7 +235,7 @@ class compaction_manager {
     // similar-sized compaction.
     void postpone_compaction_for_table(compaction::table_state* t);
 
-    future<compaction_stats_opt> perform_sstable_scrub_validate_mode(compaction::table_state& t, std::optional<tasks::task_info> info);
+    future<compaction_stats_opt> perform_sstable_scrub_validate_mode(compaction::table_state& t, sstables::compaction_type_options::scrub::checksums_only checksums_only, std::optional<tasks::task_info> info);
     future<> update_static_shares(float shares);
 
     using get_candidates_func = std::function<future<std::vector<sstables::shared_sstable>>()>;
@@ -544,6 +547,16 @@ class compaction_task_executor : public enable_shared_from_this<compaction_task_
                                 compaction_manager::can_purge_tombstones can_purge = compaction_manager::can_purge_tombstones::yes,
                                 sstables::offstrategy offstrategy = sstables::offstrategy::no);
     future<> update_history(::compaction::table_state& t, const sstables::compaction_result& res, const sstables::compaction_data& cdata);
+    // Returns the number of token sub-ranges the job should be split into.
+    unsigned compaction_subranges(const sstables::compaction_descriptor& descriptor) const;
+    // Runs the job as concurrent compactions of disjoint token sub-ranges of the
+    // input, and replaces the input with the output of all of them at once.
+    future<sstables::compaction_result> compact_sstables_in_subranges(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, on_replacement&,
+                                compaction_manager::can_purge_tombstones can_purge, unsigned count,
+                                sstables::offstrategy offstrategy = sstables::offstrategy::no);
+private:
+    void maybe_set_owned_ranges(sstables::compaction_descriptor& descriptor) const;
+protected:
     bool should_update_history(sstables::compaction_type ct) {
         return ct == sstables::compaction_type::Compaction;
     }
@@ -28,6 +28,7 @@
 #include "size_tiered_compaction_strategy.hh"
 #include "leveled_compaction_strategy.hh"
 #include "time_window_compaction_strategy.hh"
+#include "incremental_compaction_strategy.hh"
 #include "backlog_controller.hh"
 #include "compaction_backlog_manager.hh"
 #include "size_tiered_backlog_tracker.hh"
@@ -176,6 +177,9 @@ void compaction_strategy_impl::validate_options_for_strategy_type(const std::map
         case compaction_strategy_type::time_window:
             time_window_compaction_strategy::validate_options(options, unchecked_options);
             break;
+        case compaction_strategy_type::incremental:
+            incremental_compaction_strategy::validate_options(options, unchecked_options);
+            break;
         default:
             break;
     }
@@ -760,6 +764,9 @@ compaction_strategy make_compaction_strategy(compaction_strategy_type strategy,
     case compaction_strategy_type::time_window:
         impl = ::make_shared<time_window_compaction_strategy>(options);
         break;
+    case compaction_strategy_type::incremental:
+        impl = ::make_shared<incremental_compaction_strategy>(options);
+        break;
     default:
         throw std::runtime_error("strategy not supported");
     }
@@ -775,6 +782,7 @@ compaction_strategy_state compaction_strategy_state::make(const compaction_strat
     switch (cs.type()) {
         case compaction_strategy_type::null:
         case compaction_strategy_type::size_tiered:
+        case compaction_strategy_type::incremental:
             return compaction_strategy_state(default_empty_state{});
         case compaction_strategy_type::leveled:
             return compaction_strategy_state(leveled_compaction_strategy_state{});
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "sstables/sstables.hh"
+#include "incremental_compaction_strategy.hh"
+#include "size_tiered_backlog_tracker.hh"
+#include "strategy_control.hh"
+#include "cql3/statements/property_definitions.hh"
+
+#include <ranges>
+#include <boost/range/adaptor/reversed.hpp>
+
+namespace sstables {
+
+static int32_t validate_fragment_size_in_mb(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, incremental_compaction_strategy::SSTABLE_SIZE_OPTION);
+    auto size_in_mb = cql3::statements::property_definitions::to_int(incremental_compaction_strategy::SSTABLE_SIZE_OPTION, tmp_value,
+            incremental_compaction_strategy::DEFAULT_MAX_SSTABLE_SIZE_IN_MB);
+    if (size_in_mb <= 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", incremental_compaction_strategy::SSTABLE_SIZE_OPTION, size_in_mb));
+    }
+    return size_in_mb;
+}
+
+incremental_compaction_strategy::incremental_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _fragment_size(uint64_t(validate_fragment_size_in_mb(options)) * 1024 * 1024)
+    , _stcs_options(options)
+{
+}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void incremental_compaction_strategy::validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    size_tiered_compaction_strategy_options::validate(options, unchecked_options);
+    validate_fragment_size_in_mb(options);
+    unchecked_options.erase(SSTABLE_SIZE_OPTION);
+}
+
+std::vector<frozen_sstable_run>
+incremental_compaction_strategy::make_runs(const std::vector<shared_sstable>& sstables) {
+    std::unordered_map<run_id, shared_sstable_run> runs_by_id;
+    std::vector<frozen_sstable_run> ret;
+    for (auto& sst : sstables) {
+        auto& run = runs_by_id[sst->run_identifier()];
+        if (!run) {
+            run = make_lw_shared<sstable_run>();
+        }
+        if (!run->insert(sst)) {
+            // An overlapping fragment cannot belong to the run, so it's
+            // treated as a run of its own.
+            ret.push_back(make_lw_shared<sstable_run>(sst));
+        }
+    }
+    ret.reserve(ret.size() + runs_by_id.size());
+    for (auto& [_, run] : runs_by_id) {
+        ret.push_back(std::move(run));
+    }
+    return ret;
+}
+
+std::vector<std::vector<frozen_sstable_run>>
+incremental_compaction_strategy::get_buckets(std::vector<frozen_sstable_run> runs) const {
+    // Same bucketing as size tiered, but applied to whole runs.
+    std::vector<std::pair<frozen_sstable_run, uint64_t>> sorted_runs;
+    sorted_runs.reserve(runs.size());
+    for (auto& run : runs) {
+        auto size = run->data_size();
+        sorted_runs.emplace_back(std::move(run), size);
+    }
+    std::sort(sorted_runs.begin(), sorted_runs.end(), [] (auto& i, auto& j) {
+        return i.second < j.second;
+    });
+
+    using bucket_type = std::vector<frozen_sstable_run>;
+    std::vector<bucket_type> bucket_list;
+    std::vector<double> bucket_average_size_list;
+    std::vector<uint64_t> bucket_smallest_size_list;
+
+    for (auto& [run, size] : sorted_runs) {
+        if (!bucket_list.empty()) {
+            auto& bucket_average_size = bucket_average_size_list.back();
+
+            if ((size > (bucket_average_size * _stcs_options.bucket_low) && size < (bucket_average_size * _stcs_options.bucket_high)) ||
+                    (size < _stcs_options.min_sstable_size && bucket_average_size < _stcs_options.min_sstable_size)) {
+                auto& bucket = bucket_list.back();
+                auto total_size = bucket.size() * bucket_average_size;
+                auto new_average_size = (total_size + size) / (bucket.size() + 1);
+
+                // Runs are added in increasing size order, so don't let the
+                // bucket's average drift to a point where the smallest run
+                // might fall out of range.
+                if (size < _stcs_options.min_sstable_size || bucket_smallest_size_list.back() > new_average_size * _stcs_options.bucket_low) {
+                    bucket.push_back(std::move(run));
+                    bucket_average_size = new_average_size;
+                    continue;
+                }
+            }
+        }
+
+        bucket_list.push_back(bucket_type{std::move(run)});
+        bucket_average_size_list.push_back(size);
+        bucket_smallest_size_list.push_back(size);
+    }
+
+    return bucket_list;
+}
+
+std::vector<frozen_sstable_run>
+incremental_compaction_strategy::most_interesting_bucket(std::vector<std::vector<frozen_sstable_run>> buckets,
+        size_t min_threshold, size_t max_threshold) {
+    std::vector<frozen_sstable_run> most_interesting;
+    for (auto& bucket : buckets) {
+        if (bucket.size() < min_threshold) {
+            continue;
+        }
+        bucket.resize(std::min(bucket.size(), max_threshold));
+        // Pick the bucket with more runs, as efficiency of same-tier compactions increases with fan-in.
+        if (bucket.size() > most_interesting.size()) {
+            most_interesting = std::move(bucket);
+        }
+    }
+    return most_interesting;
+}
+
+std::vector<shared_sstable>
+incremental_compaction_strategy::droppable_fragments(const sstable_run& run, gc_clock::time_point compaction_time, const table_state& t) {
+    std::vector<shared_sstable> fragments;
+    for (auto& sst : run.all()) {
+        if (worth_dropping_tombstones(sst, compaction_time, t)) {
+            fragments.push_back(sst);
+        }
+    }
+    return fragments;
+}
+
+compaction_descriptor incremental_compaction_strategy::make_descriptor(const std::vector<frozen_sstable_run>& runs) const {
+    std::vector<shared_sstable> sstables;
+    for (auto& run : runs) {
+        sstables.insert(sstables.end(), run->all().begin(), run->all().end());
+    }
+    // Output is written as a new run of fragments of at most _fragment_size,
+    // which allows compaction to release the input fragments incrementally.
+    return compaction_descriptor(std::move(sstables), compaction_descriptor::default_level, _fragment_size);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control) {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto compaction_time = gc_clock::now();
+
+    auto buckets = get_buckets(control.candidates_as_runs(table_s));
+
+    auto most_interesting = most_interesting_bucket(buckets, min_threshold, max_threshold);
+    if (most_interesting.empty() && !table_s.compaction_enforce_min_threshold()) {
+        // If we are not enforcing min_threshold explicitly, try any pair of runs in the same tier.
+        most_interesting = most_interesting_bucket(buckets, 2, max_threshold);
+    }
+    if (!most_interesting.empty()) {
+        return make_descriptor(most_interesting);
+    }
+
+    if (!table_s.tombstone_gc_enabled()) {
+        return compaction_descriptor();
+    }
+
+    // If there is no run to compact in standard way, purge tombstones from the
+    // fragments whose droppable tombstone ratio is greater than threshold,
+    // preferring the oldest ones from the biggest size tiers.
+    // Only those fragments are rewritten rather than the whole run, so the
+    // cost of garbage collection is proportional to the amount of data
+    // holding droppable tombstones, not to the size of the run.
+    auto min_timestamp = [] (const std::vector<shared_sstable>& fragments) {
+        return std::ranges::min(fragments | std::views::transform([] (const shared_sstable& sst) {
+            return sst->get_stats_metadata().min_timestamp;
+        }));
+    };
+    for (auto& bucket : buckets | boost::adaptors::reversed) {
+        std::vector<shared_sstable> oldest;
+        for (auto& run : bucket) {
+            auto fragments = droppable_fragments(*run, compaction_time, table_s);
+            if (!fragments.empty() && (oldest.empty() || min_timestamp(fragments) < min_timestamp(oldest))) {
+                oldest = std::move(fragments);
+            }
+        }
+        if (!oldest.empty()) {
+            return compaction_descriptor(std::move(oldest), compaction_descriptor::default_level, _fragment_size);
+        }
+    }
+    return compaction_descriptor();
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
+    return make_major_compaction_job(std::move(candidates), compaction_descriptor::default_level, _fragment_size);
+}
+
+std::vector<compaction_descriptor>
+incremental_compaction_strategy::get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const {
+    // Cleanup works on one run at a time, so the space overhead is bounded
+    // by the fragment size, just like in regular compaction.
+    std::vector<compaction_descriptor> ret;
+    for (auto& run : make_runs(candidates)) {
+        ret.push_back(make_descriptor({ run }));
+    }
+    return ret;
+}
+
+int64_t incremental_compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    int64_t n = 0;
+    for (auto& bucket : get_buckets(table_s.main_sstable_set().all_sstable_runs())) {
+        if (bucket.size() >= min_threshold) {
+            n += std::ceil(double(bucket.size()) / max_threshold);
+        }
+    }
+    return n;
+}
+
+std::unique_ptr<compaction_backlog_tracker::impl> incremental_compaction_strategy::make_backlog_tracker() const {
+    return std::make_unique<size_tiered_backlog_tracker>(_stcs_options);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_mode mode) const {
+    auto desc = size_tiered_compaction_strategy(_stcs_options).get_reshaping_job(std::move(input), std::move(schema), mode);
+    desc.max_sstable_bytes = _fragment_size;
+    return desc;
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "compaction_strategy_impl.hh"
+#include "size_tiered_compaction_strategy.hh"
+#include "sstables/sstable_set.hh"
+
+namespace sstables {
+
+// Incremental compaction strategy (ICS) tiers sstable runs by size, like
+// STCS does with sstables, but every run is written as a sequence of
+// disjoint fragments of at most sstable_size_in_mb each. Compaction then
+// releases input fragments as soon as their data is in sealed output
+// fragments, so the temporary space needed by a compaction is bounded by
+// a few fragments per input run rather than by the size of the whole tier.
+class incremental_compaction_strategy : public compaction_strategy_impl {
+public:
+    static constexpr int32_t DEFAULT_MAX_SSTABLE_SIZE_IN_MB = 1000;
+    static constexpr auto SSTABLE_SIZE_OPTION = "sstable_size_in_mb";
+private:
+    uint64_t _fragment_size;
+    size_tiered_compaction_strategy_options _stcs_options;
+private:
+    // Groups the given sstables into runs by their run identifier.
+    static std::vector<frozen_sstable_run> make_runs(const std::vector<shared_sstable>& sstables);
+
+    // Group runs of similar size into buckets.
+    std::vector<std::vector<frozen_sstable_run>> get_buckets(std::vector<frozen_sstable_run> runs) const;
+
+    static std::vector<frozen_sstable_run>
+    most_interesting_bucket(std::vector<std::vector<frozen_sstable_run>> buckets, size_t min_threshold, size_t max_threshold);
+
+    // Returns the fragments of the run which are entitled for tombstone compaction.
+    std::vector<shared_sstable> droppable_fragments(const sstable_run& run, gc_clock::time_point compaction_time, const table_state& t);
+
+    compaction_descriptor make_descriptor(const std::vector<frozen_sstable_run>& runs) const;
+public:
+    incremental_compaction_strategy(const std::map<sstring, sstring>& options);
+    static void validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    virtual compaction_descriptor get_sstables_for_compaction(table_state& table_s, strategy_control& control) override;
+
+    virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual std::vector<compaction_descriptor> get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const override;
+
+    virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::incremental;
+    }
+
+    virtual std::unique_ptr<sstable_set_impl> make_sstable_set(schema_ptr schema) const override;
+
+    virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_mode mode) const override;
+
+    uint64_t fragment_size() const noexcept {
+        return _fragment_size;
+    }
+};
+
+}
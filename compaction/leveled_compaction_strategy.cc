@@ -10,8 +10,10 @@
 #include "leveled_manifest.hh"
 #include "compaction_strategy_state.hh"
 #include <algorithm>
+#include <unordered_map>
 
 #include <boost/range/algorithm/remove_if.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 
 namespace sstables {
 
@@ -19,6 +21,64 @@ leveled_compaction_strategy_state& leveled_compaction_strategy::get_state(table_
     return table_s.get_compaction_strategy_state().get<leveled_compaction_strategy_state>();
 }
 
+// Returns the spans of levels which ongoing compactions may still write to.
+// Sstables which aren't candidates are being compacted. Once compaction of an
+// input is done it's released, and outputs past it are never written, so the
+// span of the remaining inputs bounds what a compaction may still write.
+static std::vector<leveled_manifest::claimed_span> get_claimed_spans(leveled_compaction_strategy_state& state, table_state& table_s,
+        const std::vector<shared_sstable>& candidates) {
+    auto available = boost::copy_range<std::unordered_set<shared_sstable>>(candidates);
+    std::unordered_map<generation_type, shared_sstable> compacting;
+    for (auto& sst : *table_s.main_sstable_set().all()) {
+        if (!available.contains(sst)) {
+            compacting.emplace(sst->generation(), sst);
+        }
+    }
+    std::erase_if(state.ongoing_compactions, [&compacting] (const leveled_compaction_strategy_state::ongoing_compaction& c) {
+        return std::ranges::none_of(c.inputs, [&compacting] (const generation_type& gen) { return compacting.contains(gen); });
+    });
+
+    std::vector<leveled_manifest::claimed_span> spans;
+    auto extend = [] (std::optional<leveled_manifest::claimed_span>& span, uint32_t level, const shared_sstable& sst) {
+        auto first = sst->get_first_decorated_key().token();
+        auto last = sst->get_last_decorated_key().token();
+        if (!span) {
+            span = leveled_manifest::claimed_span{level, first, last};
+        } else {
+            span->first = std::min(span->first, first);
+            span->last = std::max(span->last, last);
+        }
+    };
+    for (auto& c : state.ongoing_compactions) {
+        std::optional<leveled_manifest::claimed_span> span;
+        for (auto& gen : c.inputs) {
+            if (auto it = compacting.find(gen); it != compacting.end()) {
+                extend(span, c.level, it->second);
+                compacting.erase(it);
+            }
+        }
+        spans.push_back(*span);
+    }
+    // The rest is compacted by others, like cleanup or a partial run being
+    // written by us, which keep sstables in their level.
+    for (auto& [_, sst] : compacting) {
+        std::optional<leveled_manifest::claimed_span> span;
+        extend(span, sst->get_sstable_level(), sst);
+        spans.push_back(*span);
+    }
+    return spans;
+}
+
+static void add_ongoing_compaction(leveled_compaction_strategy_state& state, const compaction_descriptor& descriptor) {
+    if (descriptor.level == 0) {
+        return;
+    }
+    state.ongoing_compactions.push_back({
+        boost::copy_range<std::vector<generation_type>>(descriptor.sstables | boost::adaptors::transformed(std::mem_fn(&sstable::generation))),
+        uint32_t(descriptor.level),
+    });
+}
+
 compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control) {
     auto& state = get_state(table_s);
     auto candidates = control.candidates(table_s);
@@ -31,10 +91,12 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
     if (!state.last_compacted_keys) {
         generate_last_compacted_keys(state, manifest);
     }
+    manifest.set_claimed_spans(get_claimed_spans(state, table_s, candidates));
     auto candidate = manifest.get_compaction_candidates(*state.last_compacted_keys, state.compaction_counter);
 
     if (!candidate.sstables.empty()) {
         leveled_manifest::logger.debug("leveled: Compacting {} out of {} sstables", candidate.sstables.size(), table_s.main_sstable_set().all()->size());
+        add_ongoing_compaction(state, candidate);
         return candidate;
     }
 
@@ -50,8 +112,8 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
     for (auto level = int(manifest.get_level_count()); level >= 0; level--) {
         auto& sstables = manifest.get_level(level);
         // filter out sstables which droppable tombstone ratio isn't greater than the defined threshold.
-        auto e = boost::range::remove_if(sstables, [this, compaction_time, &table_s] (const sstables::shared_sstable& sst) -> bool {
-            return !worth_dropping_tombstones(sst, compaction_time, table_s);
+        auto e = boost::range::remove_if(sstables, [this, compaction_time, &table_s, &manifest] (const sstables::shared_sstable& sst) -> bool {
+            return !worth_dropping_tombstones(sst, compaction_time, table_s) || manifest.is_claimed(sst->get_sstable_level(), {sst});
         });
         sstables.erase(e, sstables.end());
         if (sstables.empty()) {
@@ -62,7 +124,9 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
             auto ratio_j = j->estimate_droppable_tombstone_ratio(compaction_time, table_s.get_tombstone_gc_state(), table_s.schema());
             return ratio_i < ratio_j;
         });
-        return sstables::compaction_descriptor({ sst }, sst->get_sstable_level());
+        auto descriptor = sstables::compaction_descriptor({ sst }, sst->get_sstable_level());
+        add_ongoing_compaction(state, descriptor);
+        return descriptor;
     }
     return {};
 }
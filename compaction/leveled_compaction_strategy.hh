@@ -20,6 +20,7 @@
 #include "compaction_strategy_impl.hh"
 #include "compaction_backlog_manager.hh"
 #include "sstables/shared_sstable.hh"
+#include "sstables/generation_type.hh"
 
 class leveled_manifest;
 
@@ -31,6 +32,14 @@ struct leveled_compaction_strategy_state {
     std::optional<std::vector<std::optional<dht::decorated_key>>> last_compacted_keys;
     std::vector<int> compaction_counter;
 
+    // Compactions picked by the strategy which may still be running.
+    // An entry is forgotten once none of its input sstables is being compacted.
+    struct ongoing_compaction {
+        std::vector<generation_type> inputs;
+        uint32_t level;
+    };
+    std::vector<ongoing_compaction> ongoing_compactions;
+
     leveled_compaction_strategy_state();
 };
 
@@ -63,8 +72,10 @@ class leveled_compaction_strategy : public compaction_strategy_impl {
 
     virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
 
+    // Compactions into the same level are allowed to run in parallel on
+    // disjoint spans, see leveled_manifest::is_claimed().
     virtual bool parallel_compaction() const override {
-        return false;
+        return true;
     }
 
     virtual compaction_strategy_type type() const override {
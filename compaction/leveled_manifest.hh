@@ -16,13 +16,26 @@
 #include "log.hh"
 #include <boost/range/algorithm/sort.hpp>
 #include <boost/range/algorithm/partial_sort.hpp>
+#include <algorithm>
+#include <ranges>
 
 class leveled_manifest {
+public:
+    // Token span which a running compaction may still write into a level.
+    struct claimed_span {
+        uint32_t level;
+        dht::token first;
+        dht::token last;
+    };
+private:
     table_state& _table_s;
     schema_ptr _schema;
     std::vector<std::vector<sstables::shared_sstable>> _generations;
     uint64_t _max_sstable_size_in_bytes;
     const sstables::size_tiered_compaction_strategy_options& _stcs_options;
+    // Compactions into a level may run in parallel only on disjoint spans,
+    // otherwise the level would end up with overlapping sstables.
+    std::vector<claimed_span> _claimed_spans;
 
     struct candidates_info {
         std::vector<sstables::shared_sstable> candidates;
@@ -50,6 +63,9 @@ class leveled_manifest {
     // Lowest score (score is about how much data a level contains vs its ideal amount) for a
     // level to be considered worth compacting.
     static constexpr float TARGET_SCORE = 1.001f;
+    // How many other sstables of a level to try when the one picked by the
+    // round-robin overlaps the span of a running compaction into the next level.
+    static constexpr size_t MAX_CLAIMED_RETRIES = 32;
 private:
     leveled_manifest(table_state& table_s, int max_sstable_size_in_MB, const sstables::size_tiered_compaction_strategy_options& stcs_options)
         : _table_s(table_s)
@@ -88,6 +104,24 @@ class leveled_manifest {
         return manifest;
     }
 
+    void set_claimed_spans(std::vector<claimed_span> spans) {
+        _claimed_spans = std::move(spans);
+    }
+
+    // Returns true iff compacting the sstables into the level would overlap
+    // the output of a running compaction.
+    bool is_claimed(uint32_t level, const std::vector<sstables::shared_sstable>& sstables) const {
+        if (level == 0 || sstables.empty() || _claimed_spans.empty()) {
+            return false;
+        }
+        auto first = std::ranges::min(sstables | std::views::transform([] (auto& sst) { return sst->get_first_decorated_key().token(); }));
+        auto last = std::ranges::max(sstables | std::views::transform([] (auto& sst) { return sst->get_last_decorated_key().token(); }));
+        auto range = ::wrapping_interval<dht::token>::make(first, last);
+        return std::ranges::any_of(_claimed_spans, [&] (const claimed_span& c) {
+            return c.level == level && range.overlaps(::wrapping_interval<dht::token>::make(c.first, c.last), dht::token_comparator());
+        });
+    }
+
     // Return first set of overlapping sstables for a given level.
     // Assumes _generations[level] is already sorted by first key.
     std::vector<sstables::shared_sstable> overlapping_sstables(int level) const {
@@ -285,11 +319,8 @@ class leveled_manifest {
                     max = candidate_last;
                 }
             }
-#if 0
-            // NOTE: We don't need to filter out compacting sstables by now because strategy only deals with
-            // uncompacting sstables and parallel compaction is also disabled for lcs.
-            Set<SSTableReader> compacting = cfs.getDataTracker().getCompacting();
-#endif
+            // NOTE: We don't need to filter out compacting sstables because strategy only deals with
+            // uncompacting sstables, and the added sstable is within the span of the candidates.
             auto boundaries = ::wrapping_interval<dht::decorated_key>::make(*min, *max);
             for (auto& sstable : get_level(i)) {
                 auto r = ::wrapping_interval<dht::decorated_key>::make(sstable->get_first_decorated_key(), sstable->get_last_decorated_key());
@@ -395,7 +426,14 @@ class leveled_manifest {
             auto l1overlapping = overlapping(*_schema, candidates, get_level(1));
             candidates.insert(candidates.end(), l1overlapping.begin(), l1overlapping.end());
             can_promote = true;
-        } else {
+        }
+        if (can_promote && is_claimed(1, candidates)) {
+            // A running compaction is writing into the same span of L1, so keep
+            // L0 in check with size-tiering until it's done.
+            logger.debug("L1 span of L0 candidates is being compacted, performing size-tiering in L0");
+            can_promote = false;
+        }
+        if (!can_promote) {
             // do STCS in L0 when max_sstable_size is high compared to size of new sstables, so we'll
             // avoid quadratic behavior until L0 is worth promoting.
             candidates = sstables::size_tiered_compaction_strategy::most_interesting_bucket(get_level(0),
@@ -439,6 +477,9 @@ class leveled_manifest {
         // invariant to be restored.
         auto overlapping_current_level = overlapping_sstables(level);
         if (!overlapping_current_level.empty()) {
+            if (is_claimed(level, overlapping_current_level)) {
+                return {};
+            }
             logger.info("Leveled compaction strategy is restoring invariant of level {} by compacting {} sstables on behalf of {}.{}",
                 level, overlapping_current_level.size(), s.ks_name(), s.cf_name());
             return { overlapping_current_level, false };
@@ -446,11 +487,17 @@ class leveled_manifest {
 
         int start = sstable_index_based_on_last_compacted_key(sstables, level, s, last_compacted_keys);
 
-        auto pos = start % sstables.size();
-        auto candidates = overlapping(*_schema, sstables.at(pos), get_level(level + 1));
-        candidates.push_back(sstables.at(pos));
-
-        return { candidates, true };
+        // Skip over sstables whose compaction would overlap one which is in progress
+        for (size_t i = 0; i < std::min(sstables.size(), MAX_CLAIMED_RETRIES); i++) {
+            auto pos = (start + i) % sstables.size();
+            auto candidates = overlapping(*_schema, sstables.at(pos), get_level(level + 1));
+            candidates.push_back(sstables.at(pos));
+            if (!is_claimed(level + 1, candidates)) {
+                return { candidates, true };
+            }
+        }
+        logger.debug("All candidates of L{} overlap ongoing compactions", level);
+        return {};
     }
 
     /**
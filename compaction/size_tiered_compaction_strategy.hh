@@ -44,6 +44,7 @@ class size_tiered_compaction_strategy_options {
     static void validate(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
 
     friend class size_tiered_compaction_strategy;
+    friend class incremental_compaction_strategy;
 };
 
 class size_tiered_compaction_strategy : public compaction_strategy_impl {
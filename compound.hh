@@ -15,6 +15,8 @@
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include "utils/serialization.hh"
+#include "utils/lexicographical_compare.hh"
+#include <seastar/core/byteorder.hh>
 #include <seastar/util/backtrace.hh>
 
 enum class allow_prefixes { no, yes };
@@ -26,6 +28,27 @@ class compound_type final {
     const bool _byte_order_equal;
     const bool _byte_order_comparable;
     const bool _is_reversed;
+    // When all components are of fixed-width signed integer types (tinyint,
+    // smallint, int, bigint, timestamp), holds the width of each, negated
+    // for reversed types. Empty otherwise.
+    const std::vector<int8_t> _fixed_integer_widths;
+
+    static std::vector<int8_t> fixed_integer_widths(const std::vector<data_type>& types) {
+        std::vector<int8_t> widths;
+        for (auto&& t : types) {
+            int8_t w;
+            switch (t->without_reversed().get_kind()) {
+            case abstract_type::kind::byte: w = 1; break;
+            case abstract_type::kind::short_kind: w = 2; break;
+            case abstract_type::kind::int32: w = 4; break;
+            case abstract_type::kind::long_kind:
+            case abstract_type::kind::timestamp: w = 8; break;
+            default: return {};
+            }
+            widths.push_back(t->is_reversed() ? -w : w);
+        }
+        return widths;
+    }
 public:
     static constexpr bool is_prefixable = AllowPrefixes == allow_prefixes::yes;
     using prefix_type = compound_type<allow_prefixes::yes>;
@@ -39,6 +62,7 @@ class compound_type final {
             }))
         , _byte_order_comparable(false)
         , _is_reversed(_types.size() == 1 && _types[0]->is_reversed())
+        , _fixed_integer_widths(fixed_integer_widths(_types))
     { }
 
     compound_type(compound_type&&) = default;
@@ -296,6 +320,58 @@ class compound_type final {
         // FIXME: call equal() on each component
         return compare(v1, v2) == 0;
     }
+    // Compares v1 and v2 with prefix equality, see prefix_equality_tri_compare().
+    // Keys made of fixed-width integers are compared without the per-component
+    // virtual calls into their types.
+    std::strong_ordering prefix_equality_compare(managed_bytes_view v1, managed_bytes_view v2) const {
+        if (!_fixed_integer_widths.empty()
+                && v1.current_fragment().size() == v1.size_bytes()
+                && v2.current_fragment().size() == v2.size_bytes()) [[likely]] {
+            return fixed_integer_prefix_equality_compare(v1.current_fragment(), v2.current_fragment());
+        }
+        return prefix_equality_tri_compare(_types.begin(), begin(v1), end(v1), begin(v2), end(v2), ::tri_compare);
+    }
+private:
+    static std::strong_ordering compare_integers(const signed char* p1, const signed char* p2, int8_t width) noexcept {
+        auto c1 = reinterpret_cast<const char*>(p1);
+        auto c2 = reinterpret_cast<const char*>(p2);
+        switch (width) {
+        case 1: return int8_t(*p1) <=> int8_t(*p2);
+        case 2: return seastar::read_be<int16_t>(c1) <=> seastar::read_be<int16_t>(c2);
+        case 4: return seastar::read_be<int32_t>(c1) <=> seastar::read_be<int32_t>(c2);
+        default: return seastar::read_be<int64_t>(c1) <=> seastar::read_be<int64_t>(c2);
+        }
+    }
+    std::strong_ordering fixed_integer_prefix_equality_compare(bytes_view v1, bytes_view v2) const {
+        auto type = _types.begin();
+        for (int8_t w : _fixed_integer_widths) {
+            if (v1.empty() || v2.empty()) {
+                break;
+            }
+            auto len1 = read_simple<size_type>(v1);
+            auto len2 = read_simple<size_type>(v2);
+            if (v1.size() < len1 || v2.size() < len2) {
+                throw_with_backtrace<marshal_exception>(format("compound_type - not enough bytes, expected {:d} and {:d}, got {:d} and {:d}",
+                        len1, len2, v1.size(), v2.size()));
+            }
+            size_t width = std::abs(w);
+            std::strong_ordering c = std::strong_ordering::equal;
+            if (len1 == width && len2 == width) [[likely]] {
+                c = w > 0 ? compare_integers(v1.data(), v2.data(), w) : compare_integers(v2.data(), v1.data(), -w);
+            } else {
+                // Empty values.
+                c = (*type)->compare(v1.substr(0, len1), v2.substr(0, len2));
+            }
+            if (c != 0) {
+                return c;
+            }
+            v1.remove_prefix(len1);
+            v2.remove_prefix(len2);
+            ++type;
+        }
+        return std::strong_ordering::equal;
+    }
+public:
 };
 
 using compound_prefix = compound_type<allow_prefixes::yes>;
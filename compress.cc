@@ -53,6 +53,14 @@ compressor::compressor(sstring name)
     : _name(std::move(name))
 {}
 
+size_t compressor::dictionary_size() const {
+    return 0;
+}
+
+future<compressor::ptr_type> compressor::with_trained_dictionary(const std::vector<temporary_buffer<char>>&) const {
+    return make_ready_future<ptr_type>();
+}
+
 std::set<sstring> compressor::option_names() const {
     return {};
 }
@@ -99,6 +107,10 @@ const sstring compression_parameters::SSTABLE_COMPRESSION = "sstable_compression
 const sstring compression_parameters::CHUNK_LENGTH_KB = "chunk_length_in_kb";
 const sstring compression_parameters::CHUNK_LENGTH_KB_ERR = "chunk_length_kb";
 const sstring compression_parameters::CRC_CHECK_CHANCE = "crc_check_chance";
+const sstring compression_parameters::MIN_COMPRESS_RATIO = "min_compress_ratio";
+const sstring compression_parameters::COLD_SSTABLE_COMPRESSION = "cold_sstable_compression";
+const sstring compression_parameters::COLD_AFTER_HOURS = "cold_after_hours";
+const sstring compression_parameters::COLD_PREFIX = "cold_";
 
 compression_parameters::compression_parameters()
     : compression_parameters(compressor::lz4)
@@ -114,6 +126,21 @@ compression_parameters::compression_parameters(compressor_ptr c)
 compression_parameters::compression_parameters(const std::map<sstring, sstring>& options) {
     _compressor = compressor::create(options);
 
+    auto cold = options.find(COLD_SSTABLE_COMPRESSION);
+    if (cold != options.end() && !cold->second.empty()) {
+        // The cold compressor shares the chunk length, its other options are prefixed.
+        _cold_compressor = compressor::create(cold->second, [&options] (const sstring& key) -> compressor::opt_string {
+            auto i = options.find(COLD_PREFIX + key);
+            if (i == options.end() && (key == CHUNK_LENGTH_KB || key == CHUNK_LENGTH_KB_ERR)) {
+                i = options.find(key);
+            }
+            if (i == options.end()) {
+                return std::nullopt;
+            }
+            return { i->second };
+        });
+    }
+
     validate_options(options);
 
     auto chunk_length = options.find(CHUNK_LENGTH_KB) != options.end() ?
@@ -134,6 +161,30 @@ compression_parameters::compression_parameters(const std::map<sstring, sstring>&
             throw exceptions::syntax_exception(sstring("Invalid double value ") + crc_chance->second + "for " + CRC_CHECK_CHANCE);
         }
     }
+    auto min_compress_ratio = options.find(MIN_COMPRESS_RATIO);
+    if (min_compress_ratio != options.end()) {
+        try {
+            _min_compress_ratio = std::stod(min_compress_ratio->second);
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(sstring("Invalid double value ") + min_compress_ratio->second + " for " + MIN_COMPRESS_RATIO);
+        }
+    }
+    auto cold_after = options.find(COLD_AFTER_HOURS);
+    if (cold_after != options.end()) {
+        try {
+            _cold_after = std::chrono::hours(std::stoi(cold_after->second));
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(sstring("Invalid integer value ") + cold_after->second + " for " + COLD_AFTER_HOURS);
+        }
+    }
+}
+
+compression_parameters compression_parameters::for_cold_data() const {
+    compression_parameters cp(_cold_compressor);
+    cp._chunk_length = _chunk_length;
+    cp._crc_check_chance = _crc_check_chance;
+    cp._min_compress_ratio = _min_compress_ratio;
+    return cp;
 }
 
 void compression_parameters::validate() {
@@ -158,6 +209,20 @@ void compression_parameters::validate() {
     if (_crc_check_chance && (_crc_check_chance.value() < 0.0 || _crc_check_chance.value() > 1.0)) {
         throw exceptions::configuration_exception(sstring(CRC_CHECK_CHANCE) + " must be between 0.0 and 1.0.");
     }
+    if (_min_compress_ratio && _min_compress_ratio.value() != 0.0 && !(_min_compress_ratio.value() >= 1.0)) {
+        throw exceptions::configuration_exception(sstring(MIN_COMPRESS_RATIO) + " must be 0 (disabled) or at least 1.0.");
+    }
+    if (bool(_cold_compressor) != bool(_cold_after)) {
+        throw exceptions::configuration_exception(
+            fmt::format("{} and {} must be given together.", COLD_SSTABLE_COMPRESSION, COLD_AFTER_HOURS));
+    }
+    if (_cold_compressor && !_compressor) {
+        throw exceptions::configuration_exception(
+            fmt::format("{} requires {} to be set.", COLD_SSTABLE_COMPRESSION, SSTABLE_COMPRESSION));
+    }
+    if (_cold_after && _cold_after->count() <= 0) {
+        throw exceptions::configuration_exception(sstring(COLD_AFTER_HOURS) + " must be positive.");
+    }
 }
 
 std::map<sstring, sstring> compression_parameters::get_options() const {
@@ -173,13 +238,28 @@ std::map<sstring, sstring> compression_parameters::get_options() const {
     if (_crc_check_chance) {
         opts.emplace(sstring(CRC_CHECK_CHANCE), std::to_string(_crc_check_chance.value()));
     }
+    if (_min_compress_ratio) {
+        opts.emplace(sstring(MIN_COMPRESS_RATIO), std::to_string(_min_compress_ratio.value()));
+    }
+    if (_cold_compressor) {
+        for (auto& [k, v] : _cold_compressor->options()) {
+            opts.emplace(COLD_PREFIX + k, v);
+        }
+        opts.emplace(COLD_SSTABLE_COMPRESSION, _cold_compressor->name());
+    }
+    if (_cold_after) {
+        opts.emplace(COLD_AFTER_HOURS, std::to_string(_cold_after->count()));
+    }
     return opts;
 }
 
 bool compression_parameters::operator==(const compression_parameters& other) const {
     return _compressor == other._compressor
            && _chunk_length == other._chunk_length
-           && _crc_check_chance == other._crc_check_chance;
+           && _crc_check_chance == other._crc_check_chance
+           && _min_compress_ratio == other._min_compress_ratio
+           && _cold_compressor == other._cold_compressor
+           && _cold_after == other._cold_after;
 }
 
 void compression_parameters::validate_options(const std::map<sstring, sstring>& options) {
@@ -189,11 +269,19 @@ void compression_parameters::validate_options(const std::map<sstring, sstring>&
         sstring(CHUNK_LENGTH_KB),
         sstring(CHUNK_LENGTH_KB_ERR),
         sstring(CRC_CHECK_CHANCE),
+        sstring(MIN_COMPRESS_RATIO),
+        sstring(COLD_SSTABLE_COMPRESSION),
+        sstring(COLD_AFTER_HOURS),
     });
     std::set<sstring> ckw;
     if (_compressor) {
         ckw = _compressor->option_names();
     }
+    if (_cold_compressor) {
+        for (auto& name : _cold_compressor->option_names()) {
+            ckw.insert(COLD_PREFIX + name);
+        }
+    }
     for (auto&& opt : options) {
         if (!keywords.contains(opt.first) && !ckw.contains(opt.first)) {
             throw exceptions::configuration_exception(format("Unknown compression option '{}'.", opt.first));
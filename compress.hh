@@ -8,13 +8,16 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
 #include "seastarx.hh"
 
 class compressor {
@@ -41,6 +44,26 @@ class compressor {
      */
     virtual size_t compress_max_size(size_t input_len) const = 0;
 
+    // to cheaply bridge sstable compression options / maps
+    using opt_string = std::optional<sstring>;
+    using opt_getter = std::function<opt_string(const sstring&)>;
+    using ptr_type = shared_ptr<compressor>;
+
+    /**
+     * Returns the maximum size of a dictionary which should be trained on
+     * the data before it is compressed, or 0 if this compressor doesn't
+     * want one.
+     */
+    virtual size_t dictionary_size() const;
+    /**
+     * Trains a dictionary on the given samples and returns a compressor
+     * which uses it for both compression and decompression. The dictionary
+     * is a part of the returned compressor's options(), so it is persisted
+     * along with them. Returns nullptr if no dictionary could be trained.
+     * The samples must be kept alive until the returned future resolves.
+     */
+    virtual future<ptr_type> with_trained_dictionary(const std::vector<temporary_buffer<char>>& samples) const;
+
     /**
      * Returns accepted option names for this compressor
      */
@@ -57,11 +80,6 @@ class compressor {
         return _name;
     }
 
-    // to cheaply bridge sstable compression options / maps
-    using opt_string = std::optional<sstring>;
-    using opt_getter = std::function<opt_string(const sstring&)>;
-    using ptr_type = shared_ptr<compressor>;
-
     static ptr_type create(const sstring& name, const opt_getter&);
     static ptr_type create(const std::map<sstring, sstring>&);
 
@@ -87,10 +105,19 @@ class compression_parameters {
     static const sstring CHUNK_LENGTH_KB;
     static const sstring CHUNK_LENGTH_KB_ERR;
     static const sstring CRC_CHECK_CHANCE;
+    static const sstring MIN_COMPRESS_RATIO;
+    // Compressor for sstables holding only data older than COLD_AFTER_HOURS,
+    // written by compaction. Options of the cold compressor are prefixed with COLD_PREFIX.
+    static const sstring COLD_SSTABLE_COMPRESSION;
+    static const sstring COLD_AFTER_HOURS;
+    static const sstring COLD_PREFIX;
 private:
     compressor_ptr _compressor;
     std::optional<int> _chunk_length;
     std::optional<double> _crc_check_chance;
+    std::optional<double> _min_compress_ratio;
+    compressor_ptr _cold_compressor;
+    std::optional<std::chrono::hours> _cold_after;
 public:
     compression_parameters();
     compression_parameters(compressor_ptr);
@@ -100,6 +127,15 @@ class compression_parameters {
     compressor_ptr get_compressor() const { return _compressor; }
     int32_t chunk_length() const { return _chunk_length.value_or(int(DEFAULT_CHUNK_LENGTH)); }
     double crc_check_chance() const { return _crc_check_chance.value_or(double(DEFAULT_CRC_CHECK_CHANCE)); }
+    // Chunks which don't compress at least this much are stored uncompressed. 0 disables.
+    double min_compress_ratio() const { return _min_compress_ratio.value_or(0.0); }
+
+    compressor_ptr get_cold_compressor() const { return _cold_compressor; }
+    // Data whose newest write is older than this is cold. Engaged iff get_cold_compressor() is not null.
+    std::optional<std::chrono::hours> cold_after() const { return _cold_after; }
+    // The parameters to write cold data with: the cold compressor, and the rest
+    // of the parameters of this object.
+    compression_parameters for_cold_data() const;
 
     void validate();
     std::map<sstring, sstring> get_options() const;
@@ -556,6 +556,7 @@ scylla_tests = set([
     'test/boost/sstable_partition_index_cache_test',
     'test/boost/schema_changes_test',
     'test/boost/sstable_conforms_to_mutation_source_test',
+    'test/boost/sstable_byte_comparable_test',
     'test/boost/sstable_compaction_test',
     'test/boost/sstable_resharding_test',
     'test/boost/sstable_directory_test',
@@ -598,6 +599,7 @@ scylla_tests = set([
     'test/boost/expr_test',
     'test/boost/exceptions_optimized_test',
     'test/boost/exceptions_fallback_test',
+    'test/boost/s3_disk_cache_test',
     'test/boost/s3_test',
     'test/boost/locator_topology_test',
     'test/boost/string_format_test',
@@ -616,6 +618,7 @@ scylla_tests = set([
     'test/manual/sstable_scan_footprint_test',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_cache_workloads',
     'test/perf/perf_commitlog',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
@@ -643,7 +646,9 @@ perf_tests = set([
     'test/perf/perf_mutation_fragment',
     'test/perf/perf_idl',
     'test/perf/perf_vint',
+    'test/perf/perf_utf8',
     'test/perf/perf_big_decimal',
+    'test/perf/perf_token_search',
 ])
 
 raft_tests = set([
@@ -788,6 +793,7 @@ scylla_core = (['message/messaging_service.cc',
                 'replica/exceptions.cc',
                 'replica/dirty_memory_manager.cc',
                 'replica/mutation_dump.cc',
+                'replica/query_result_cache.cc',
                 'mutation/atomic_cell.cc',
                 'mutation/canonical_mutation.cc',
                 'mutation/frozen_mutation.cc',
@@ -854,6 +860,7 @@ scylla_core = (['message/messaging_service.cc',
                 'compaction/compaction_strategy.cc',
                 'compaction/size_tiered_compaction_strategy.cc',
                 'compaction/leveled_compaction_strategy.cc',
+                'compaction/incremental_compaction_strategy.cc',
                 'compaction/task_manager_module.cc',
                 'compaction/time_window_compaction_strategy.cc',
                 'compaction/compaction_manager.cc',
@@ -1017,6 +1024,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/view/row_locking.cc',
                 'db/sstables-format-selector.cc',
                 'db/snapshot-ctl.cc',
+                'db/snapshot/backup_task.cc',
                 'db/rate_limiter.cc',
                 'db/per_partition_rate_limit_options.cc',
                 'index/secondary_index_manager.cc',
@@ -1035,6 +1043,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/gz/crc_combine.cc',
                 'utils/gz/crc_combine_table.cc',
                 'utils/s3/client.cc',
+                'utils/s3/disk_cache.cc',
                 'gms/version_generator.cc',
                 'gms/versioned_value.cc',
                 'gms/gossiper.cc',
@@ -1095,6 +1104,7 @@ scylla_core = (['message/messaging_service.cc',
                 'streaming/stream_result_future.cc',
                 'streaming/stream_session_state.cc',
                 'streaming/consumer.cc',
+                'streaming/stream_blob.cc',
                 'clocks-impl.cc',
                 'partition_slice_builder.cc',
                 'init.cc',
@@ -1388,6 +1398,7 @@ tests_not_using_seastar_test_framework = set([
     'test/manual/message',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_cache_workloads',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
     'test/perf/perf_mutation',
@@ -49,6 +49,10 @@ class cql_statement {
     // CQL statement text
     seastar::sstring raw_cql_statement;
 
+    // Keyspace of the client state the statement was prepared with.
+    // Together with the text, it allows preparing the statement again on another shard.
+    seastar::sstring raw_keyspace;
+
     // Returns true for statements that needs guard to be taken before the execution
     virtual bool needs_guard(query_processor& qp, service::query_state& state) const {
         return false;
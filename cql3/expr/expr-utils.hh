@@ -241,6 +241,11 @@ extern expression replace_partition_token(const expression&, const column_defini
 extern expression search_and_replace(const expression& e,
         const noncopyable_function<std::optional<expression> (const expression& candidate)>& replace_candidate);
 
+// Replaces the bind variables of e with constants holding their values in the given options.
+// Bind variables whose value is null, or fails to evaluate, are left in place,
+// so that evaluating the result fails (or not) just like evaluating e would.
+extern expression evaluate_bind_variables(const expression& e, const query_options& options);
+
 // Adjust an expression for rows that were fetched using query::partition_slice::options::collections_as_maps
 expression adjust_for_collection_as_maps(const expression& e);
 
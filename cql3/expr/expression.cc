@@ -29,6 +29,7 @@
 #include "types/list.hh"
 #include "types/map.hh"
 #include "types/set.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "utils/like_matcher.hh"
 #include "query-result-reader.hh"
 #include "types/user.hh"
@@ -147,7 +148,6 @@ get_value(const subscript& s, const evaluation_inputs& inputs) {
         return std::nullopt;
     }
     auto col_type = static_pointer_cast<const collection_type_impl>(type_of(s.val));
-    const auto deserialized = type_of(s.val)->deserialize(managed_bytes_view(*serialized));
     const auto key = evaluate(s.sub, inputs);
     auto&& key_type = col_type->is_map() ? col_type->name_comparator() : int32_type;
     if (key.is_null()) {
@@ -161,25 +161,35 @@ get_value(const subscript& s, const evaluation_inputs& inputs) {
         // not an error.
         return std::nullopt;
     }
+    // Look the element up in the serialized collection. Deserializing it
+    // would allocate every element of a possibly large collection.
+    managed_bytes_view in(*serialized);
     if (col_type->is_map()) {
-        const auto& data_map = value_cast<map_type_impl::native_type>(deserialized);
-        const auto found = key.view().with_linearized([&] (bytes_view key_bv) {
-            using entry = std::pair<data_value, data_value>;
-            return std::find_if(data_map.cbegin(), data_map.cend(), [&] (const entry& element) {
-                return key_type->compare(element.first.serialize_nonnull(), key_bv) == 0;
-            });
+        return key.view().with_linearized([&] (bytes_view key_bv) -> managed_bytes_opt {
+            auto size = read_collection_size(in);
+            for (int i = 0; i != size; ++i) {
+                auto element_key = read_collection_key(in);
+                auto element_value = read_collection_value_nonnull(in);
+                if (key_type->equal(element_key, key_bv)) {
+                    return managed_bytes(element_value);
+                }
+            }
+            return std::nullopt;
         });
-        return found == data_map.cend() ? std::nullopt : managed_bytes_opt(found->second.serialize_nonnull());
     } else if (col_type->is_list()) {
-        const auto& data_list = value_cast<list_type_impl::native_type>(deserialized);
         auto key_deserialized = key.view().with_linearized([&] (bytes_view key_bv) {
             return key_type->deserialize(key_bv);
         });
         auto key_int = value_cast<int32_t>(key_deserialized);
-        if (key_int < 0 || size_t(key_int) >= data_list.size()) {
+        auto size = read_collection_size(in);
+        if (key_int < 0 || key_int >= size) {
             return std::nullopt;
         }
-        return managed_bytes_opt(data_list[key_int].serialize_nonnull());
+        for (int i = 0; i != key_int; ++i) {
+            read_collection_value(in);
+        }
+        auto element = read_collection_value(in);
+        return element ? managed_bytes_opt(*element) : std::nullopt;
     } else {
         throw exceptions::invalid_request_exception(fmt::format("subscripting non-map, non-list column {:user}", s.val));
     }
@@ -1498,6 +1508,24 @@ expression search_and_replace(const expression& e,
     }
 }
 
+expression evaluate_bind_variables(const expression& e, const query_options& options) {
+    return search_and_replace(e, [&] (const expression& candidate) -> std::optional<expression> {
+        auto bind_var = as_if<bind_variable>(&candidate);
+        if (!bind_var) {
+            return std::nullopt;
+        }
+        try {
+            auto value = evaluate(candidate, options);
+            if (value.is_null()) {
+                return std::nullopt;
+            }
+            return constant(std::move(value), bind_var->receiver->type);
+        } catch (...) {
+            return std::nullopt;
+        }
+    });
+}
+
 std::vector<expression> extract_single_column_restrictions_for_column(const expression& expr,
                                                                       const column_definition& column) {
     struct visitor {
@@ -66,6 +66,39 @@ bytes_opt user_function::execute(std::span<const bytes_opt> parameters) {
         });
 }
 
+bytes_opt user_function::execute_fold(bytes_opt state, std::span<const std::vector<bytes_opt>> rows) {
+    const auto& types = arg_types();
+    if (types.empty() || std::ranges::any_of(rows, [&] (const std::vector<bytes_opt>& row) { return row.size() + 1 != types.size(); })) {
+        throw std::logic_error("Wrong number of parameters");
+    }
+
+    if (!seastar::thread::running_in_thread()) {
+        on_internal_error(log, "User function cannot be executed in this context");
+    }
+    return seastar::visit(_ctx,
+        [&] (lua_context& ctx) -> bytes_opt {
+            std::vector<std::vector<data_value>> values;
+            values.reserve(rows.size());
+            for (const auto& row : rows) {
+                auto& row_values = values.emplace_back();
+                row_values.reserve(row.size());
+                for (int i = 0, n = row.size(); i != n; ++i) {
+                    const data_type& type = types[i + 1];
+                    const bytes_opt& bytes = row[i];
+                    row_values.push_back(bytes ? type->deserialize(*bytes) : data_value::make_null(type));
+                }
+            }
+            return lua::run_script_fold(lua::bitcode_view{ctx.bitcode}, std::move(state), values, return_type(), _called_on_null_input, ctx.cfg).get();
+        },
+        [&] (wasm::context& ctx) -> bytes_opt {
+            try {
+                return wasm::run_script_fold(name(), ctx, arg_types(), std::move(state), rows, return_type(), _called_on_null_input).get();
+            } catch (const wasm::exception& e) {
+                throw exceptions::invalid_request_exception(format("UDF error: {}", e.what()));
+            }
+        });
+}
+
 std::ostream& user_function::describe(std::ostream& os) const {
     auto ks = cql3::util::maybe_quote(name().keyspace);
     auto na = cql3::util::maybe_quote(name().name);
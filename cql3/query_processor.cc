@@ -396,6 +396,11 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             _cql_stats.select_bypass_caches,
                             sm::description("Counts the number of SELECT query executions with BYPASS CACHE option.")),
 
+                    sm::make_counter(
+                            "select_coalesced_reads",
+                            _cql_stats.select_coalesced_reads,
+                            sm::description("Counts the number of SELECT query executions which shared the result of an identical read in progress, see coalesce_concurrent_reads.")),
+
                     sm::make_counter(
                             "select_allow_filtering",
                             _cql_stats.select_allow_filtering,
@@ -668,6 +673,32 @@ query_processor::prepare(sstring query_string, const service::client_state& clie
             prepared_cache_key_type::cql_id);
 }
 
+shard_id query_processor::home_shard_of(const prepared_cache_key_type& key) {
+    return std::hash<prepared_cache_key_type>()(key) % smp::count;
+}
+
+future<statements::prepared_statement::checked_weak_ptr>
+query_processor::prepare_from_home_shard(const prepared_cache_key_type& key, service::client_state& client_state) {
+    auto home = home_shard_of(key);
+    if (home == this_shard_id()) {
+        co_return statements::prepared_statement::checked_weak_ptr();
+    }
+    auto text_and_keyspace = co_await container().invoke_on(home, [&key] (query_processor& qp) -> std::optional<std::pair<sstring, sstring>> {
+        auto prepared = qp.get_prepared(key);
+        if (!prepared) {
+            return std::nullopt;
+        }
+        return std::make_pair(prepared->statement->raw_cql_statement, prepared->statement->raw_keyspace);
+    });
+    if (!text_and_keyspace) {
+        co_return statements::prepared_statement::checked_weak_ptr();
+    }
+    auto cs = client_state.move_to_other_shard().get();
+    cs.set_raw_keyspace(std::move(text_and_keyspace->second));
+    co_await prepare(std::move(text_and_keyspace->first), cs);
+    co_return get_prepared(key);
+}
+
 static std::string hash_target(std::string_view query_string, std::string_view keyspace) {
     std::string ret(keyspace);
     ret += query_string;
@@ -692,6 +723,7 @@ query_processor::get_statement(const sstring_view& query, const service::client_
     ++_stats.prepare_invocations;
     auto p = statement->prepare(_db, _cql_stats);
     p->statement->raw_cql_statement = sstring(query);
+    p->statement->raw_keyspace = client_state.get_raw_keyspace();
     return p;
 }
 
@@ -203,6 +203,16 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _prepared_cache.find(key);
     }
 
+    // A statement is prepared on the shard which received the PREPARE request and on
+    // its home shard only. The other shards prepare it when they first need it, from
+    // the text kept by the home shard, see prepare_from_home_shard().
+    static shard_id home_shard_of(const prepared_cache_key_type& key);
+
+    // Prepares the statement with the given key on this shard, if it is prepared on its home shard.
+    // Returns a disengaged pointer otherwise.
+    future<statements::prepared_statement::checked_weak_ptr>
+    prepare_from_home_shard(const prepared_cache_key_type& key, service::client_state& client_state);
+
     inline
     future<::shared_ptr<cql_transport::messages::result_message>>
     execute_prepared(
@@ -1067,8 +1067,18 @@ dht::partition_range_vector partition_ranges_from_singles(
         }
     }
     cartesian_product cp(column_values);
-    dht::partition_range_vector ranges(product_size);
-    std::transform(cp.begin(), cp.end(), ranges.begin(), std::bind_front(range_from_bytes, std::ref(schema)));
+    std::vector<partition_key> keys;
+    keys.reserve(product_size);
+    std::transform(cp.begin(), cp.end(), std::back_inserter(keys), [] (const std::vector<managed_bytes>& pk) {
+        return partition_key::from_exploded(pk);
+    });
+    // Compute the tokens of all keys of the IN list together, it's cheaper than one by one.
+    auto tokens = dht::get_tokens(schema, keys);
+    dht::partition_range_vector ranges;
+    ranges.reserve(product_size);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ranges.push_back(dht::partition_range::make_singular(query::ring_position(std::move(tokens[i]), std::move(keys[i]))));
+    }
     return ranges;
 }
 
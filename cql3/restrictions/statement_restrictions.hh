@@ -375,6 +375,11 @@ class statement_restrictions {
 
     sstring to_string() const;
 
+    /// The entire WHERE clause, if any.
+    const std::optional<expr::expression>& get_where_clause() const {
+        return _where;
+    }
+
     /// Checks that the primary key restrictions don't contain null values, throws invalid_request_exception otherwise.
     void validate_primary_key(const query_options& options) const;
 };
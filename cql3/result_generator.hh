@@ -26,8 +26,12 @@ class result_generator {
     template<typename Visitor>
     class query_result_visitor {
         const schema& _schema;
-        std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Components of the keys of the current partition and row.
+        // result_view::consume() keeps the keys alive while they are visited,
+        // so views are enough, and the vectors are reused, so visiting rows
+        // doesn't allocate.
+        std::vector<managed_bytes_view> _partition_key;
+        std::vector<managed_bytes_view> _clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
@@ -41,12 +45,19 @@ class result_generator {
                 _visitor.accept_value(cell ? utils::buffer_view_to_managed_bytes_view(cell->value()) : managed_bytes_view_opt());
             }
         }
+
+        static void explode(std::vector<managed_bytes_view>& components, const auto& key) {
+            components.clear();
+            for (managed_bytes_view c : key.components()) {
+                components.push_back(c);
+            }
+        }
     public:
         query_result_visitor(const schema& s, Visitor& visitor, const selection::selection& select)
             : _schema(s), _visitor(visitor), _selection(select) { }
 
         void accept_new_partition(const partition_key& key, uint64_t row_count) {
-            _partition_key = key.explode(_schema);
+            explode(_partition_key, key);
             accept_new_partition(row_count);
         }
         void accept_new_partition(uint64_t row_count) {
@@ -56,7 +67,7 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            explode(_clustering_key, key);
             accept_new_row(static_row, row);
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
@@ -66,11 +77,11 @@ class result_generator {
             for (auto&& def : _selection.get_columns()) {
                 switch (def->kind) {
                 case column_kind::partition_key:
-                    _visitor.accept_value(bytes_view(_partition_key[def->component_index()]));
+                    _visitor.accept_value(_partition_key[def->component_index()]);
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(bytes_view(_clustering_key[def->component_index()]));
+                        _visitor.accept_value(_clustering_key[def->component_index()]);
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
@@ -93,7 +104,7 @@ class result_generator {
                 auto static_row_iterator = static_row.iterator();
                 for (auto&& def : _selection.get_columns()) {
                     if (def->is_partition_key()) {
-                        _visitor.accept_value(bytes_view(_partition_key[def->component_index()]));
+                        _visitor.accept_value(_partition_key[def->component_index()]);
                     } else if (def->is_static()) {
                         accept_cell_value(*def, static_row_iterator);
                     } else {
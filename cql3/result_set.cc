@@ -33,6 +33,7 @@ void metadata::add_non_serialized_column(lw_shared_ptr<column_specification> nam
     // See comment above. Because columnCount doesn't account the newly added name, it
     // won't be serialized.
     _column_info->_names.emplace_back(std::move(name));
+    _column_info->_serialized.reset();
 }
 
 bool metadata::all_in_same_cf() const {
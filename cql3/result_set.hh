@@ -42,6 +42,14 @@ class metadata {
     // (CASSANDRA-4911). So the serialization code will exclude any columns in name whose index is >= columnCount.
         std::vector<lw_shared_ptr<column_specification>> _names;
         uint32_t _column_count;
+        // The column specifications as serialized in a RESULT message. The
+        // column_info of a prepared statement is shared by all of its results,
+        // so they are serialized once rather than on every execution.
+        struct serialized_specs {
+            bool global_tables_spec;
+            bytes serialized;
+        };
+        std::optional<serialized_specs> _serialized;
 
         column_info(std::vector<lw_shared_ptr<column_specification>> names, uint32_t column_count)
             : _names(std::move(names))
@@ -89,6 +97,17 @@ class metadata {
     const std::vector<lw_shared_ptr<column_specification>>& get_names() const {
         return _column_info->_names;
     }
+
+    // Returns the serialized column specifications, calling serialize() to
+    // produce them unless they were already cached by a copy of this metadata.
+    template<std::invocable<> Serialize>
+    const bytes& serialized_column_specs(bool global_tables_spec, Serialize&& serialize) const {
+        auto& cached = _column_info->_serialized;
+        if (!cached || cached->global_tables_spec != global_tables_spec) {
+            cached = column_info::serialized_specs{global_tables_spec, serialize()};
+        }
+        return cached->serialized;
+    }
 };
 
 ::shared_ptr<const cql3::metadata> make_empty_metadata();
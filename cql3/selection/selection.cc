@@ -23,6 +23,7 @@
 #include "cql3/expr/expr-utils.hh"
 #include "cql3/functions/first_function.hh"
 #include "cql3/functions/aggregate_fcts.hh"
+#include "cql3/functions/user_function.hh"
 
 namespace cql3 {
 
@@ -341,8 +342,20 @@ class selection_with_processing : public selection {
 protected:
     class selectors_with_processing : public selectors {
     private:
+        // Rows are passed to user-defined state functions in batches of that many, to pay
+        // the cost of setting up the function's runtime once per batch instead of once per row.
+        static constexpr size_t fold_batch_size = 128;
+
+        // A step of the inner loop computing temporary[i] = f(temporary[i], args...),
+        // where f is a user-defined function.
+        struct folded_function {
+            functions::user_function* func = nullptr;
+            std::vector<std::vector<bytes_opt>> pending_rows;
+        };
+
         const selection_with_processing& _sel;
         std::vector<raw_value> _temporaries;
+        std::vector<folded_function> _folded;
         bool _requires_thread;
     public:
         explicit selectors_with_processing(const selection_with_processing& sel)
@@ -353,13 +366,66 @@ class selection_with_processing : public selection {
                     return std::get<shared_ptr<functions::function>>(fc.func)->requires_thread();
                 });
              }))
-        { }
+        {
+            _folded.reserve(_sel._inner_loop.size());
+            for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
+                _folded.push_back(folded_function{.func = get_folded_function(_sel._inner_loop[i], i)});
+            }
+        }
+    private:
+        static functions::user_function* get_folded_function(const expr::expression& e, size_t index) {
+            auto fc = expr::as_if<expr::function_call>(&e);
+            if (!fc || fc->args.empty() || (fc->lwt_cache_id && fc->lwt_cache_id->has_value())) {
+                return nullptr;
+            }
+            auto func = dynamic_cast<functions::user_function*>(std::get<shared_ptr<functions::function>>(fc->func).get());
+            auto state = expr::as_if<expr::temporary>(&fc->args[0]);
+            if (!func || !state || state->index != index) {
+                return nullptr;
+            }
+            for (size_t i = 1; i != fc->args.size(); ++i) {
+                if (expr::find_in_expression<expr::temporary>(fc->args[i], [] (const expr::temporary&) { return true; })) {
+                    return nullptr;
+                }
+            }
+            return func;
+        }
+
+        void flush_folded(size_t index) {
+            auto& folded = _folded[index];
+            if (folded.pending_rows.empty()) {
+                return;
+            }
+            bytes_opt result = folded.func->execute_fold(to_bytes_opt(_temporaries[index]), folded.pending_rows);
+            folded.pending_rows.clear();
+            if (!result) {
+                _temporaries[index] = raw_value::make_null();
+                return;
+            }
+            try {
+                folded.func->return_type()->validate(*result);
+            } catch (marshal_exception&) {
+                throw exceptions::invalid_request_exception(format("Return of function {} ({}) is not a valid value for its declared return type {}",
+                        folded.func->name(), to_hex(result), folded.func->return_type()->as_cql3_type()));
+            }
+            _temporaries[index] = raw_value::make_value(std::move(*result));
+        }
+
+        void flush_folded() {
+            for (size_t i = 0; i != _folded.size(); ++i) {
+                flush_folded(i);
+            }
+        }
+    public:
 
         virtual bool requires_thread() const override {
             return _requires_thread;
         }
 
         virtual void reset() override {
+            for (auto& folded : _folded) {
+                folded.pending_rows.clear();
+            }
             _temporaries = _sel._initial_values_for_temporaries;
         }
 
@@ -388,6 +454,7 @@ class selection_with_processing : public selection {
         }
 
         virtual std::vector<managed_bytes_opt> get_output_row() override {
+            flush_folded();
             std::vector<managed_bytes_opt> output_row;
             output_row.reserve(_sel._outer_loop.size());
             auto inputs = expr::evaluation_inputs{
@@ -419,7 +486,20 @@ class selection_with_processing : public selection {
                     .temporaries = _temporaries,
             };
             for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
-                _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
+                auto& folded = _folded[i];
+                if (!folded.func) {
+                    _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
+                    continue;
+                }
+                auto& fc = expr::as<expr::function_call>(_sel._inner_loop[i]);
+                auto& row = folded.pending_rows.emplace_back();
+                row.reserve(fc.args.size() - 1);
+                for (size_t j = 1; j != fc.args.size(); ++j) {
+                    row.emplace_back(to_bytes_opt(expr::evaluate(fc.args[j], inputs)));
+                }
+                if (folded.pending_rows.size() >= fold_batch_size) {
+                    flush_folded(i);
+                }
             }
         }
 
@@ -608,6 +688,14 @@ std::unique_ptr<result_set> result_set_builder::build() {
     return std::move(_result_set);
 }
 
+static expr::single_column_restrictions_map bind_restrictions(const expr::single_column_restrictions_map& restrictions, const query_options& options) {
+    expr::single_column_restrictions_map ret;
+    for (auto& [cdef, restriction] : restrictions) {
+        ret.emplace(cdef, expr::evaluate_bind_variables(restriction, options));
+    }
+    return ret;
+}
+
 result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<const restrictions::statement_restrictions> restrictions,
         const query_options& options,
         uint64_t remaining,
@@ -619,6 +707,13 @@ result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<const
     , _options(options)
     , _skip_pk_restrictions(!_restrictions->pk_restrictions_need_filtering())
     , _skip_ck_restrictions(!_restrictions->ck_restrictions_need_filtering())
+    , _clustering_columns_restrictions(expr::evaluate_bind_variables(_restrictions->get_clustering_columns_restrictions(), options))
+    , _has_multi_column_clustering_restriction(expr::contains_multi_column_restriction(_clustering_columns_restrictions))
+    , _non_pk_restrictions(bind_restrictions(_restrictions->get_non_pk_restriction(), options))
+    , _partition_key_restrictions(_skip_pk_restrictions
+            ? expr::single_column_restrictions_map() : bind_restrictions(_restrictions->get_single_column_partition_key_restrictions(), options))
+    , _clustering_key_restrictions(_skip_ck_restrictions
+            ? expr::single_column_restrictions_map() : bind_restrictions(_restrictions->get_single_column_clustering_key_restrictions(), options))
     , _remaining(remaining)
     , _schema(schema)
     , _per_partition_limit(per_partition_limit)
@@ -638,17 +733,23 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         return false;
     }
 
-    const expr::expression& clustering_columns_restrictions = _restrictions->get_clustering_columns_restrictions();
-    if (expr::contains_multi_column_restriction(clustering_columns_restrictions)) {
-        clustering_key_prefix ckey = clustering_key_prefix::from_exploded(clustering_key);
-        // FIXME: push to upper layer so it happens once per row
-        auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
+    // The values of the static and regular columns are needed by every
+    // restriction on them, but extracted only once per row.
+    std::optional<std::vector<managed_bytes_opt>> static_and_regular_columns;
+    auto get_static_and_regular_columns = [&] () -> const std::vector<managed_bytes_opt>& {
+        if (!static_and_regular_columns) {
+            static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
+        }
+        return *static_and_regular_columns;
+    };
+
+    if (_has_multi_column_clustering_restriction) {
         bool multi_col_clustering_satisfied = expr::is_satisfied_by(
-                clustering_columns_restrictions,
+                _clustering_columns_restrictions,
                 expr::evaluation_inputs{
                     .partition_key = partition_key,
                     .clustering_key = clustering_key,
-                    .static_and_regular_columns = static_and_regular_columns,
+                    .static_and_regular_columns = get_static_and_regular_columns(),
                     .selection = &selection,
                     .options = &_options,
                 });
@@ -657,30 +758,25 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         }
     }
 
-    auto static_row_iterator = static_row.iterator();
-    auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
-    const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
     for (auto&& cdef : selection.get_columns()) {
         switch (cdef->kind) {
         case column_kind::static_column:
             // fallthrough
         case column_kind::regular_column: {
-            if (cdef->kind == column_kind::regular_column && !row_iterator) {
+            if (cdef->kind == column_kind::regular_column && !row) {
                 continue;
             }
-            auto restr_it = non_pk_restrictions_map.find(cdef);
-            if (restr_it == non_pk_restrictions_map.end()) {
+            auto restr_it = _non_pk_restrictions.find(cdef);
+            if (restr_it == _non_pk_restrictions.end()) {
                 continue;
             }
             const expr::expression& single_col_restriction = restr_it->second;
-            // FIXME: push to upper layer so it happens once per row
-            auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
             bool regular_restriction_matches = expr::is_satisfied_by(
                     single_col_restriction,
                     expr::evaluation_inputs{
                         .partition_key = partition_key,
                         .clustering_key = clustering_key,
-                        .static_and_regular_columns = static_and_regular_columns,
+                        .static_and_regular_columns = get_static_and_regular_columns(),
                         .selection = &selection,
                         .options = &_options,
                     });
@@ -694,9 +790,8 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_pk_restrictions) {
                 continue;
             }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
-            auto restr_it = partition_key_restrictions_map.find(cdef);
-            if (restr_it == partition_key_restrictions_map.end()) {
+            auto restr_it = _partition_key_restrictions.find(cdef);
+            if (restr_it == _partition_key_restrictions.end()) {
                 continue;
             }
             const expr::expression& single_col_restriction = restr_it->second;
@@ -718,10 +813,8 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_ck_restrictions) {
                 continue;
             }
-            const expr::single_column_restrictions_map& clustering_key_restrictions_map =
-                _restrictions->get_single_column_clustering_key_restrictions();
-            auto restr_it = clustering_key_restrictions_map.find(cdef);
-            if (restr_it == clustering_key_restrictions_map.end()) {
+            auto restr_it = _clustering_key_restrictions.find(cdef);
+            if (restr_it == _clustering_key_restrictions.end()) {
                 continue;
             }
             if (clustering_key.empty()) {
@@ -16,6 +16,7 @@
 #include "selector.hh"
 #include "cql3/column_specification.hh"
 #include "cql3/functions/function.hh"
+#include "cql3/expr/restrictions.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
 #include <seastar/core/thread.hh>
@@ -208,6 +209,14 @@ class result_set_builder {
         const query_options& _options;
         const bool _skip_pk_restrictions;
         const bool _skip_ck_restrictions;
+        // The restrictions checked by the filter, with their bind variables
+        // already evaluated, so they're bound and validated once per query
+        // rather than once per filtered row.
+        const expr::expression _clustering_columns_restrictions;
+        const bool _has_multi_column_clustering_restriction;
+        const expr::single_column_restrictions_map _non_pk_restrictions;
+        const expr::single_column_restrictions_map _partition_key_restrictions;
+        const expr::single_column_restrictions_map _clustering_key_restrictions;
         mutable bool _current_partition_key_does_not_match = false;
         mutable bool _current_static_row_does_not_match = false;
         mutable uint64_t _rows_dropped = 0;
@@ -20,6 +20,7 @@
 #include "tombstone_gc.hh"
 #include "db/per_partition_rate_limit_extension.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "db/bloom_filter_extension.hh"
 #include "utils/bloom_calculations.hh"
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -122,12 +123,26 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         }
         compression_parameters cp(*compression_options);
         cp.validate();
+        if ((cp.get_cold_compressor() || cp.cold_after()) && !db.features().cold_sstable_compression) {
+            throw exceptions::configuration_exception(format("The {} option is not supported yet by the whole cluster", compression_parameters::COLD_SSTABLE_COMPRESSION));
+        }
+        if (compression_options->contains(compression_parameters::MIN_COMPRESS_RATIO) && !db.features().min_compress_ratio) {
+            throw exceptions::configuration_exception(format("The {} option is not supported yet by the whole cluster", compression_parameters::MIN_COMPRESS_RATIO));
+        }
     }
 
     auto per_partition_rate_limit_options = get_per_partition_rate_limit_options(schema_extensions);
     if (per_partition_rate_limit_options && !db.features().typed_errors_in_read_rpc) {
         throw exceptions::configuration_exception("Per-partition rate limit is not supported yet by the whole cluster");
     }
+    if (per_partition_rate_limit_options && per_partition_rate_limit_options->get_counting_mode() != db::per_partition_rate_limit_options::counting_mode::hash_table
+            && !db.features().per_partition_rate_limit_sketch) {
+        throw exceptions::configuration_exception("The 'counting' option of per_partition_rate_limit is not supported yet by the whole cluster");
+    }
+
+    if (schema_extensions.contains(db::bloom_filter_extension::NAME) && !db.features().blocked_bloom_filters) {
+        throw exceptions::configuration_exception("The bloom_filter option is not supported yet by the whole cluster");
+    }
 
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
@@ -38,11 +38,13 @@ namespace statements {
 create_index_statement::create_index_statement(cf_name name,
                                                ::shared_ptr<index_name> index_name,
                                                std::vector<::shared_ptr<index_target::raw>> raw_targets,
+                                               std::vector<::shared_ptr<column_identifier::raw>> raw_included_columns,
                                                ::shared_ptr<index_prop_defs> properties,
                                                bool if_not_exists)
     : schema_altering_statement(name)
     , _index_name(index_name->get_idx())
     , _raw_targets(raw_targets)
+    , _raw_included_columns(std::move(raw_included_columns))
     , _properties(properties)
     , _if_not_exists(if_not_exists)
 {
@@ -70,6 +72,10 @@ create_index_statement::validate(query_processor& qp, const service::client_stat
         throw exceptions::invalid_request_exception("Only CUSTOM indexes can be created without specifying a target column");
     }
 
+    if (!_raw_included_columns.empty() && _properties->is_custom) {
+        throw exceptions::invalid_request_exception("INCLUDE is not supported for CUSTOM indexes");
+    }
+
     _properties->validate();
 }
 
@@ -310,6 +316,41 @@ void create_index_statement::validate_target_column_is_map_if_index_involves_key
     }
 }
 
+std::vector<::shared_ptr<column_identifier>> create_index_statement::validate_included_columns(const schema& schema,
+        const std::vector<::shared_ptr<index_target>>& targets) const {
+    std::vector<::shared_ptr<column_identifier>> included_columns;
+    if (_raw_included_columns.empty()) {
+        return included_columns;
+    }
+    for (auto& target : targets) {
+        auto* ident = std::get_if<index_target::single_column>(&target->value);
+        if (ident && !schema.get_column_definition((*ident)->name())->is_regular()) {
+            throw exceptions::invalid_request_exception("INCLUDE is only supported for indexes on regular columns");
+        }
+    }
+    std::unordered_set<sstring> names;
+    for (auto& raw_ident : _raw_included_columns) {
+        auto ident = raw_ident->prepare_column_identifier(schema);
+        auto cd = schema.get_column_definition(ident->name());
+        if (!cd) {
+            throw exceptions::invalid_request_exception(format("No column definition found for included column {}", ident->text()));
+        }
+        if (!cd->is_regular()) {
+            throw exceptions::invalid_request_exception(format("Cannot include column {} in index: only regular columns can be included", ident->text()));
+        }
+        for (auto& target : targets) {
+            if (target->column_name() == ident->text()) {
+                throw exceptions::invalid_request_exception(format("Cannot include indexed column {} in index", ident->text()));
+            }
+        }
+        if (!names.insert(ident->text()).second) {
+            throw exceptions::invalid_request_exception(format("Duplicate column {} in index INCLUDE list", ident->text()));
+        }
+        included_columns.push_back(std::move(ident));
+    }
+    return included_columns;
+}
+
 void create_index_statement::validate_targets_for_multi_column_index(std::vector<::shared_ptr<index_target>> targets) const
 {
     if (!_properties->is_custom) {
@@ -330,6 +371,7 @@ std::optional<create_index_statement::base_schema_with_new_index> create_index_s
     auto targets = validate_while_executing(db);
 
     auto schema = db.find_schema(keyspace(), column_family());
+    auto included_columns = validate_included_columns(*schema, targets);
 
     sstring accepted_name = _index_name;
     if (accepted_name.empty()) {
@@ -349,7 +391,7 @@ std::optional<create_index_statement::base_schema_with_new_index> create_index_s
     } else {
         kind = schema->is_compound() ? index_metadata_kind::composites : index_metadata_kind::keys;
     }
-    auto index = make_index_metadata(targets, accepted_name, kind, index_options);
+    auto index = make_index_metadata(targets, included_columns, accepted_name, kind, index_options);
     auto existing_index = schema->find_index_noname(index);
     if (existing_index) {
         if (_if_not_exists) {
@@ -401,6 +443,7 @@ create_index_statement::prepare(data_dictionary::database db, cql_stats& stats)
 }
 
 index_metadata create_index_statement::make_index_metadata(const std::vector<::shared_ptr<index_target>>& targets,
+                                                           const std::vector<::shared_ptr<column_identifier>>& included_columns,
                                                            const sstring& name,
                                                            index_metadata_kind kind,
                                                            const index_options_map& options)
@@ -408,6 +451,9 @@ index_metadata create_index_statement::make_index_metadata(const std::vector<::s
     index_options_map new_options = options;
     auto target_option = secondary_index::target_parser::serialize_targets(targets);
     new_options.emplace(index_target::target_option_name, target_option);
+    if (!included_columns.empty()) {
+        new_options.emplace(index_target::included_columns_option_name, secondary_index::target_parser::serialize_included_columns(included_columns));
+    }
 
     const auto& first_target = targets.front()->value;
     return index_metadata{name, new_options, kind, index_metadata::is_local_index(std::holds_alternative<index_target::multiple_columns>(first_target))};
@@ -22,6 +22,9 @@ namespace statements {
 struct index_target {
     static const sstring target_option_name;
     static const sstring custom_index_option_name;
+    // Regular columns stored in the index view in addition to the keys,
+    // so that queries selecting only them can be answered from the index.
+    static const sstring included_columns_option_name;
     static const boost::regex target_regex;
 
     enum class target_type {
@@ -831,6 +831,9 @@ select_statement::execute_without_checking_exception_message_non_aggregate_unpag
         }).then(wrap_result_to_error_message([this, &options, now, cmd] (auto result) {
             return this->process_results(std::move(result), cmd, options, now);
         }));
+    } else if (qp.db().get_config().coalesce_concurrent_reads() && is_coalescable_consistency(options.get_consistency())
+            && partition_ranges.size() == 1 && query::is_single_partition(partition_ranges.front())) {
+        return execute_coalesced(qp, std::move(cmd), std::move(partition_ranges), state, options, now, timeout);
     } else {
         return qp.proxy().query_result(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
             .then(wrap_result_to_error_message([this, &options, now, cmd] (service::storage_proxy::coordinator_query_result qr) {
@@ -839,6 +842,103 @@ select_statement::execute_without_checking_exception_message_non_aggregate_unpag
     }
 }
 
+// A read which is already in progress may have missed a write which completed
+// before an identical read was started, so sharing its result is only
+// acceptable if the consistency level doesn't promise to see such a write
+// anyway.
+static bool is_coalescable_consistency(db::consistency_level cl) {
+    return cl == db::consistency_level::ONE || cl == db::consistency_level::LOCAL_ONE;
+}
+
+// Executions of the same statement with the same bound values and
+// consistency level read the same data.
+static bytes make_coalesced_read_key(const query_options& options) {
+    bytes key;
+    auto append = [&key] (bytes_view v) {
+        key.append(v.data(), v.size());
+    };
+    auto append_int = [&append] (int32_t i) {
+        append(bytes_view(reinterpret_cast<const int8_t*>(&i), sizeof(i)));
+    };
+    append_int(int32_t(options.get_consistency()));
+    for (size_t i = 0; i < options.get_values_count(); ++i) {
+        auto v = options.get_value_at(i);
+        if (v.is_null()) {
+            append_int(-1);
+            continue;
+        }
+        append_int(v.size_bytes());
+        v.with_linearized(append);
+    }
+    return key;
+}
+
+future<shared_ptr<cql_transport::messages::result_message>>
+select_statement::execute_coalesced(query_processor& qp,
+                          lw_shared_ptr<query::read_command> cmd,
+                          dht::partition_range_vector&& partition_ranges,
+                          service::query_state& state,
+                          const query_options& options,
+                          gc_clock::time_point now,
+                          db::timeout_clock::time_point timeout) const
+{
+    auto key = make_coalesced_read_key(options);
+    if (auto it = _coalesced_reads.find(key); it != _coalesced_reads.end()) {
+        ++_stats.select_coalesced_reads;
+        tracing::trace(state.get_trace_state(), "Sharing the result of an identical read in progress");
+        lw_shared_ptr<query::result> result;
+        try {
+            // The shared read may have a later timeout than ours.
+            result = co_await it->second.get_shared_future(timeout);
+        } catch (const timed_out_error&) {
+            // ONE and LOCAL_ONE block for a single replica.
+            co_return ::make_shared<cql_transport::messages::result_message::exception>(exceptions::coordinator_exception_container(
+                    exceptions::read_timeout_exception(_schema->ks_name(), _schema->cf_name(), options.get_consistency(), 0, 1, false)));
+        }
+        if (result) {
+            co_return co_await process_results(make_foreign(std::move(result)), std::move(cmd), options, now);
+        }
+        // The shared read failed. Don't fail along with it, the error may
+        // be specific to the other read, e.g. a timeout which expired
+        // earlier than ours.
+        auto qr = co_await qp.proxy().query_result(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
+        if (!qr) {
+            co_return failed_result_to_result_message(std::move(qr));
+        }
+        co_return co_await process_results(std::move(qr.value().query_result), std::move(cmd), options, now);
+    }
+
+    _coalesced_reads.emplace(key, shared_promise<lw_shared_ptr<query::result>>());
+    std::optional<coordinator_result<service::storage_proxy::coordinator_query_result>> qr;
+    std::exception_ptr ex;
+    try {
+        qr.emplace(co_await qp.proxy().query_result(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()}));
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    // The waiters are on this shard, the result may be on another one.
+    lw_shared_ptr<query::result> result;
+    if (qr && *qr) {
+        auto& r = qr->value().query_result;
+        if (r.get_owner_shard() == this_shard_id()) {
+            result = r.release();
+        } else {
+            result = make_lw_shared<query::result>(bytes_ostream(r->buf()), r->digest(), r->last_modified(), r->is_short_read(),
+                    r->row_count_low_bits(), r->partition_count(), r->row_count_high_bits(), r->last_position());
+            r.reset();
+        }
+    }
+    auto waiters = _coalesced_reads.extract(key);
+    waiters.mapped().set_value(result);
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    if (!*qr) {
+        co_return failed_result_to_result_message(std::move(*qr));
+    }
+    co_return co_await process_results(make_foreign(std::move(result)), std::move(cmd), options, now);
+}
+
 future<shared_ptr<cql_transport::messages::result_message>>
 indexed_table_select_statement::process_base_query_results(
         foreign_ptr<lw_shared_ptr<query::result>> results,
@@ -1010,6 +1110,39 @@ indexed_table_select_statement::indexed_table_select_statement(schema_ptr schema
         _get_partition_ranges_for_posting_list = [this] (const query_options& options) { return get_partition_ranges_for_global_index_posting_list(options); };
         _get_partition_slice_for_posting_list = [this] (const query_options& options) { return get_partition_slice_for_global_index_posting_list(options); };
     }
+    _covering_selection = make_covering_selection();
+}
+
+::shared_ptr<selection::selection> indexed_table_select_statement::make_covering_selection() const {
+    // Only indexes created with INCLUDE are used this way, as a query reading
+    // just the index view doesn't see the base rows, so it trusts the view to
+    // be in sync with the base table.
+    if (!_index.metadata().options().contains(index_target::included_columns_option_name)) {
+        return nullptr;
+    }
+    // Results are returned in the index view's order, without post-processing.
+    if (!_selection->is_trivial() || _selection->is_aggregate() || has_group_by() || _parameters->is_distinct()
+            || _restrictions_need_filtering || _is_reversed || _ordering_comparator || _per_partition_limit) {
+        return nullptr;
+    }
+    // The posting list read doesn't apply these restrictions, the base table query does.
+    if (_restrictions->has_clustering_columns_restriction()) {
+        return nullptr;
+    }
+    if (!_index.metadata().local() && !_restrictions->has_partition_key_unrestricted_components()
+            && !_restrictions->has_token_restrictions() && !_restrictions->partition_key_restrictions_is_all_eq()) {
+        return nullptr;
+    }
+    std::vector<const column_definition*> columns;
+    columns.reserve(_selection->get_column_count());
+    for (auto* cdef : _selection->get_columns()) {
+        auto* view_cdef = _view_schema->get_column_definition(cdef->name());
+        if (!view_cdef || view_cdef->is_computed() || view_cdef->is_view_virtual() || view_cdef->is_static()) {
+            return nullptr;
+        }
+        columns.push_back(view_cdef);
+    }
+    return selection::selection::for_columns(_view_schema, std::move(columns));
 }
 
 template<typename KeyType>
@@ -1114,6 +1247,11 @@ indexed_table_select_statement::do_execute(query_processor& qp,
 
     _stats.unpaged_select_queries(_ks_sel) += options.get_page_size() <= 0;
 
+    if (_covering_selection) {
+        tracing::trace(state.get_trace_state(), "Index {} covers the query, reading only the index", _index.metadata().name());
+        co_return co_await execute_covered_query(qp, state, options, now);
+    }
+
     // Secondary index search has two steps: 1. use the index table to find a
     // list of primary keys matching the query. 2. read the rows matching
     // these primary keys from the base table and return the selected columns.
@@ -1296,6 +1434,70 @@ query::partition_slice indexed_table_select_statement::get_partition_slice_for_l
     return partition_slice_builder.build();
 }
 
+// Reads the selected columns directly from the index view. The view's
+// paging state is the same as used by the two-step search, which also pages
+// through the index view.
+future<shared_ptr<cql_transport::messages::result_message>>
+indexed_table_select_statement::execute_covered_query(query_processor& qp,
+        service::query_state& state,
+        const query_options& options,
+        gc_clock::time_point now) const
+{
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    dht::partition_range_vector partition_ranges = _get_partition_ranges_for_posting_list(options);
+    auto partition_slice = _get_partition_slice_for_posting_list(options);
+    partition_slice.regular_columns.clear();
+    for (auto* cdef : _covering_selection->get_columns()) {
+        if (cdef->is_regular()) {
+            partition_slice.regular_columns.push_back(cdef->id);
+        }
+    }
+    partition_slice.options.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
+
+    auto cmd = ::make_lw_shared<query::read_command>(
+            _view_schema->id(),
+            _view_schema->version(),
+            partition_slice,
+            qp.proxy().get_max_result_size(partition_slice),
+            query::tombstone_limit(qp.proxy().get_tombstone_limit()),
+            query::row_limit(get_limit(options)),
+            query::partition_limit(query::max_partitions),
+            now,
+            tracing::make_trace_info(state.get_trace_state()),
+            query_id::create_null_id(),
+            query::is_first_page(!options.get_paging_state()),
+            options.get_timestamp(state));
+
+    // The base selection builds the result, so its metadata refers to the base table.
+    cql3::selection::result_set_builder builder(*_selection, now);
+    lw_shared_ptr<const service::pager::paging_state> paging_state;
+    int32_t page_size = options.get_page_size();
+    if (page_size <= 0 || !service::pager::query_pagers::may_need_paging(*_view_schema, page_size, *cmd, partition_ranges)) {
+        auto result = co_await qp.proxy().query_result(_view_schema, cmd, std::move(partition_ranges), options.get_consistency(),
+                {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
+        if (!result) {
+            co_return failed_result_to_result_message(std::move(result));
+        }
+        query::result_view::consume(*result.value().query_result, cmd->slice,
+                cql3::selection::result_set_builder::visitor(builder, *_view_schema, *_covering_selection));
+    } else {
+        auto p = service::pager::query_pagers::pager(qp.proxy(), _view_schema, _covering_selection,
+                state, options, cmd, std::move(partition_ranges), nullptr);
+        auto result = co_await p->fetch_page_result(builder, page_size, now, timeout);
+        if (!result) {
+            co_return failed_result_to_result_message(std::move(result));
+        }
+        paging_state = p->state();
+    }
+
+    auto rs = builder.build();
+    update_stats_rows_read(rs->size());
+    if (paging_state) {
+        rs->get_metadata().set_paging_state(std::move(paging_state));
+    }
+    co_return ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+}
+
 // Utility function for reading from the index view (get_index_view()))
 // the posting-list for a particular value of the indexed column.
 // Remember a secondary index can only be created on a single column.
@@ -1514,6 +1716,10 @@ class parallelized_select_statement : public select_statement {
         service::query_state& state,
         const query_options& options
     ) const override;
+
+    // Returns the WHERE clause for the nodes executing the request to filter
+    // by, or std::nullopt if the query can't be filtered by them.
+    std::optional<sstring> make_forwarded_where_clause(query_processor& qp, const query_options& options) const;
 };
 
 ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::prepare(
@@ -1581,6 +1787,14 @@ parallelized_select_statement::do_execute(
     service::query_state& state,
     const query_options& options
 ) const {
+    std::optional<sstring> where_clause;
+    if (_restrictions->need_filtering()) {
+        where_clause = make_forwarded_where_clause(qp, options);
+        if (!where_clause) {
+            return select_statement::do_execute(qp, state, options);
+        }
+    }
+
     tracing::add_table_name(state.get_trace_state(), keyspace(), column_family());
 
     auto cl = options.get_consistency();
@@ -1633,6 +1847,7 @@ parallelized_select_statement::do_execute(
         .cl = options.get_consistency(),
         .timeout = timeout,
         .aggregation_infos = reductions.infos,
+        .where_clause = std::move(where_clause),
     };
 
     // dispatch execution of this statement to other nodes
@@ -1647,6 +1862,24 @@ parallelized_select_statement::do_execute(
     });
 }
 
+std::optional<sstring>
+parallelized_select_statement::make_forwarded_where_clause(query_processor& qp, const query_options& options) const {
+    // The bound values are inlined, the nodes executing the request have no query_options.
+    auto where = expr::evaluate_bind_variables(*_restrictions->get_where_clause(), options);
+    if (expr::find_in_expression<expr::bind_variable>(where, [] (const expr::bind_variable&) { return true; })) {
+        return std::nullopt;
+    }
+    auto where_clause = util::relations_to_where_clause(where);
+    try {
+        // Make sure the nodes executing the request will be able to prepare
+        // the clause, otherwise filter on the coordinator, as without forwarding.
+        util::prepare_where_clause(qp.db(), *_schema, where_clause);
+    } catch (...) {
+        return std::nullopt;
+    }
+    return where_clause;
+}
+
 mutation_fragments_select_statement::mutation_fragments_select_statement(
             schema_ptr output_schema,
             schema_ptr underlying_schema,
@@ -2029,7 +2262,7 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
                 (db.features().parallelized_aggregation && selection->is_count())
                 || (db.features().uda_native_parallelized_aggregation && selection->is_reducible())
             )
-            && !restrictions->need_filtering()  // No filtering
+            && (!restrictions->need_filtering() || db.features().parallelized_aggregation_with_filtering)
             && group_by_cell_indices->empty()   // No GROUP BY
             && db.get_config().enable_parallelized_aggregation()
             && !is_local_table();
@@ -2561,6 +2794,18 @@ std::unique_ptr<cql3::statements::raw::select_statement> build_select_statement(
     return do_with_parser(out.str(), std::mem_fn(&cql3_parser::CqlParser::selectStatement));
 }
 
+::shared_ptr<const restrictions::statement_restrictions> prepare_where_clause(
+        data_dictionary::database db,
+        const schema& s,
+        const sstring_view& where_clause) {
+    auto raw = build_select_statement(s.cf_name(), where_clause, true, {});
+    raw->prepare_keyspace(s.ks_name());
+    raw->set_bound_variables({});
+    cql3::cql_stats ignored;
+    auto prepared = raw->prepare(db, ignored, false);
+    return static_pointer_cast<cql3::statements::select_statement>(prepared->statement)->get_restrictions();
+}
+
 }
 
 }
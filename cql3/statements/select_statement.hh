@@ -15,9 +15,12 @@
 #include "cql3/cql_statement.hh"
 #include "cql3/stats.hh"
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/core/shared_future.hh>
 #include "transport/messages/result_message.hh"
 #include "index/secondary_index_manager.hh"
 #include "exceptions/coordinator_result.hh"
+#include "db/timeout_clock.hh"
+#include "query-result.hh"
 #include "locator/host_id.hh"
 
 namespace service {
@@ -86,7 +89,15 @@ class select_statement : public cql_statement {
     bool _range_scan = false;
     bool _range_scan_no_bypass_cache = false;
     std::unique_ptr<cql3::attributes> _attrs;
+    // Single-partition reads of this statement in progress, keyed by the
+    // bound values and consistency level, which identical concurrent
+    // executions wait for instead of reading the same data again.
+    // Only used with coalesce_concurrent_reads.
+    mutable std::unordered_map<bytes, shared_promise<lw_shared_ptr<query::result>>> _coalesced_reads;
 private:
+    future<shared_ptr<cql_transport::messages::result_message>> execute_coalesced(query_processor& qp,
+        lw_shared_ptr<query::read_command> cmd, dht::partition_range_vector&& partition_ranges, service::query_state& state,
+        const query_options& options, gc_clock::time_point now, db::timeout_clock::time_point timeout) const;
     future<shared_ptr<cql_transport::messages::result_message>> process_results_complex(foreign_ptr<lw_shared_ptr<query::result>> results,
         lw_shared_ptr<query::read_command> cmd, const query_options& options, gc_clock::time_point now) const;
 protected :
@@ -187,6 +198,10 @@ class indexed_table_select_statement : public select_statement {
     schema_ptr _view_schema;
     noncopyable_function<dht::partition_range_vector(const query_options&)> _get_partition_ranges_for_posting_list;
     noncopyable_function<query::partition_slice(const query_options&)> _get_partition_slice_for_posting_list;
+    // Selection of the index view's columns corresponding to the selected base
+    // columns, if the index includes all columns needed by the query.
+    // Such queries are answered from the index view alone.
+    ::shared_ptr<selection::selection> _covering_selection;
 public:
     static constexpr size_t max_base_table_query_concurrency = 4096;
 
@@ -291,6 +306,15 @@ class indexed_table_select_statement : public select_statement {
             gc_clock::time_point now,
             lw_shared_ptr<const service::pager::paging_state> paging_state) const;
 
+    ::shared_ptr<selection::selection> make_covering_selection() const;
+
+    future<shared_ptr<cql_transport::messages::result_message>>
+    execute_covered_query(
+            query_processor& qp,
+            service::query_state& state,
+            const query_options& options,
+            gc_clock::time_point now) const;
+
     virtual void update_stats_rows_read(int64_t rows_read) const override {
         _stats.rows_read += rows_read;
         _stats.secondary_index_rows_read += rows_read;
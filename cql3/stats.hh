@@ -75,6 +75,7 @@ struct cql_stats {
     int64_t filtered_rows_read_total = 0;
 
     int64_t select_bypass_caches = 0;
+    int64_t select_coalesced_reads = 0;
     int64_t select_allow_filtering = 0;
     int64_t select_partition_range_scan = 0;
     int64_t select_partition_range_scan_no_bypass_cache = 0;
@@ -27,52 +27,45 @@ static inline bool is_control_char(char c) {
     return c >= 0 && c <= 0x1F;
 }
 
-static inline bool needs_escaping(const sstring& s) {
-    return std::any_of(s.begin(), s.end(), [](char c) {return is_control_char(c) || c == '"' || c == '\\';});
-}
-
-
-static sstring quote_json_string(const sstring& value) {
-    if (!needs_escaping(value)) {
-        return format("\"{}\"", value);
-    }
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    oss.put('"');
-    for (char c : value) {
+static void write_quoted_json_string(bytes_ostream& out, std::string_view value) {
+    static constexpr char hex_digits[] = "0123456789ABCDEF";
+    out.write("\"", 1);
+    // Runs of characters which don't need escaping are copied at once
+    size_t unescaped = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        char c = value[i];
+        if (!is_control_char(c) && c != '"' && c != '\\') {
+            continue;
+        }
+        out.write(value.data() + unescaped, i - unescaped);
+        unescaped = i + 1;
+        char escaped[6] = {'\\', 0, 0, 0, 0, 0};
+        size_t len = 2;
         switch (c) {
-        case '"':
-            oss.put('\\').put('"');
-            break;
-        case '\\':
-            oss.put('\\').put('\\');
-            break;
-        case '\b':
-            oss.put('\\').put('b');
-            break;
-        case '\f':
-            oss.put('\\').put('f');
-            break;
-        case '\n':
-            oss.put('\\').put('n');
-            break;
-        case '\r':
-            oss.put('\\').put('r');
-            break;
-        case '\t':
-            oss.put('\\').put('t');
-            break;
+        case '"': escaped[1] = '"'; break;
+        case '\\': escaped[1] = '\\'; break;
+        case '\b': escaped[1] = 'b'; break;
+        case '\f': escaped[1] = 'f'; break;
+        case '\n': escaped[1] = 'n'; break;
+        case '\r': escaped[1] = 'r'; break;
+        case '\t': escaped[1] = 't'; break;
         default:
-            if (is_control_char(c)) {
-                oss.put('\\').put('u') << std::setw(4) << static_cast<int>(c);
-            } else {
-                oss.put(c);
-            }
+            escaped[1] = 'u';
+            escaped[2] = '0';
+            escaped[3] = '0';
+            escaped[4] = hex_digits[(c >> 4) & 0xF];
+            escaped[5] = hex_digits[c & 0xF];
+            len = 6;
             break;
         }
+        out.write(escaped, len);
     }
-    oss.put('"');
-    return std::move(oss).str();
+    out.write(value.data() + unescaped, value.size() - unescaped);
+    out.write("\"", 1);
+}
+
+static void write_quoted_json_string(bytes_ostream& out, bytes_view value) {
+    write_quoted_json_string(out, std::string_view(reinterpret_cast<const char*>(value.data()), value.size()));
 }
 
 
@@ -369,195 +362,229 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_raw(bytes_ostream& out, std::string_view s) {
+    out.write(s.data(), s.size());
+}
 
-    out << '{';
+namespace {
+// Tells whether the JSON representation of values of the type is a quoted string
+struct is_quoted_in_json_visitor {
+    bool operator()(const reversed_type_impl& t) { return visit(*t.underlying_type(), is_quoted_in_json_visitor{}); }
+    template <typename T> bool operator()(const integer_type_impl<T>& t) { return false; }
+    template <typename T> bool operator()(const floating_type_impl<T>& t) { return false; }
+    bool operator()(const uuid_type_impl& t) { return true; }
+    bool operator()(const inet_addr_type_impl& t) { return true; }
+    bool operator()(const string_type_impl& t) { return true; }
+    bool operator()(const bytes_type_impl& t) { return true; }
+    bool operator()(const boolean_type_impl& t) { return false; }
+    bool operator()(const timestamp_date_base_class& t) { return true; }
+    bool operator()(const timeuuid_type_impl& t) { return true; }
+    bool operator()(const map_type_impl& t) { return false; }
+    bool operator()(const set_type_impl& t) { return false; }
+    bool operator()(const list_type_impl& t) { return false; }
+    bool operator()(const tuple_type_impl& t) { return false; }
+    bool operator()(const user_type_impl& t) { return false; }
+    bool operator()(const simple_date_type_impl& t) { return true; }
+    bool operator()(const time_type_impl& t) { return true; }
+    bool operator()(const empty_type_impl& t) { return false; }
+    bool operator()(const duration_type_impl& t) { return true; }
+    bool operator()(const counter_type_impl& t) { return false; }
+    bool operator()(const decimal_type_impl& t) { return false; }
+    bool operator()(const varint_type_impl& t) { return false; }
+};
+}
+
+static void write_json_aux(bytes_ostream& out, const map_type_impl& t, bytes_view bv) {
+    // Valid keys in JSON map must be quoted strings
+    bool quote_keys = !visit(*t.get_keys_type(), is_quoted_in_json_visitor{});
+
+    out.write("{", 1);
     auto size = read_collection_size(bv);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_key(bv);
         auto vb = read_collection_value_nonnull(bv);
 
         if (i > 0) {
-            out << ", ";
+            out.write(", ", 2);
         }
-
-        // Valid keys in JSON map must be quoted strings
-        sstring string_key = to_json_string(*t.get_keys_type(), kb);
-        bool is_unquoted = string_key.empty() || string_key[0] != '"';
-        if (is_unquoted) {
-            out << '"';
+        if (quote_keys) {
+            out.write("\"", 1);
         }
-        out << string_key;
-        if (is_unquoted) {
-            out << '"';
+        write_json(out, *t.get_keys_type(), kb);
+        if (quote_keys) {
+            out.write("\"", 1);
         }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        out.write(": ", 2);
+        write_json(out, *t.get_values_type(), vb);
     }
-    out << '}';
-    return std::move(out).str();
+    out.write("}", 1);
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void write_json_aux(bytes_ostream& out, const listlike_collection_type_impl& t, bytes_view bv) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
-    out << '[';
+    out.write("[", 1);
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            out.write(", ", 2);
         }
         if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
+            write_json(out, *t.get_elements_type(), *e);
         } else {
             // Impossible in sets, but let's not insist here.
-            out << "null";
-        }
-    });
-    out << ']';
-    return std::move(out).str();
-}
-
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
-    using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
-    bool first = true;
-    out << '[';
-    managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
-        if (first) {
-            first = false;
-        } else {
-            out << ", ";
-        }
-        if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
-        } else {
-            out << "null";
+            out.write("null", 4);
         }
     });
-    out << ']';
-    return std::move(out).str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void write_json_aux(bytes_ostream& out, const tuple_type_impl& t, bytes_view bv) {
+    out.write("[", 1);
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.write(", ", 2);
         }
         if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
-            out << "null";
+            out.write("null", 4);
         }
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return std::move(out).str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void write_json_aux(bytes_ostream& out, const user_type_impl& t, bytes_view bv) {
+    out.write("{", 1);
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.write(", ", 2);
         }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
+        write_quoted_json_string(out, t.field_name(i));
+        out.write(": ", 2);
         if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
-            out << "null";
+            out.write("null", 4);
         }
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return std::move(out).str();
+    out.write("}", 1);
 }
 
 namespace {
-struct to_json_string_visitor {
+struct write_json_visitor {
+    bytes_ostream& out;
     bytes_view bv;
-    sstring operator()(const reversed_type_impl& t) { return to_json_string(*t.underlying_type(), bv); }
-    template <typename T> sstring operator()(const integer_type_impl<T>& t) { return to_sstring(compose_value(t, bv)); }
-    template <typename T> sstring operator()(const floating_type_impl<T>& t) {
+    void operator()(const reversed_type_impl& t) { write_json(out, *t.underlying_type(), bv); }
+    template <typename T> void operator()(const integer_type_impl<T>& t) {
+        char buf[24];
+        auto end = fmt::format_to(buf, "{}", compose_value(t, bv));
+        out.write(buf, end - buf);
+    }
+    template <typename T> void operator()(const floating_type_impl<T>& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
         T d = value_cast<T>(v);
         if (std::isnan(d) || std::isinf(d)) {
-            return "null";
-        }
-        return to_sstring(d);
-    }
-    sstring operator()(const uuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const inet_addr_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const string_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const bytes_type_impl& t) { return quote_json_string("0x" + t.to_string(bv)); }
-    sstring operator()(const boolean_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const timestamp_date_base_class& t) { return quote_json_string(timestamp_to_json_string(t, bv)); }
-    sstring operator()(const timeuuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const map_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const set_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const list_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const tuple_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const user_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const simple_date_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const time_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const empty_type_impl& t) { return "null"; }
-    sstring operator()(const duration_type_impl& t) {
+            out.write("null", 4);
+            return;
+        }
+        write_raw(out, to_sstring(d));
+    }
+    void operator()(const uuid_type_impl& t) { write_quoted_json_string(out, t.to_string(bv)); }
+    void operator()(const inet_addr_type_impl& t) { write_quoted_json_string(out, t.to_string(bv)); }
+    // The serialized form is the text itself, so it is escaped in place
+    void operator()(const string_type_impl& t) { write_quoted_json_string(out, bv); }
+    void operator()(const bytes_type_impl& t) {
+        // Hex digits never need escaping
+        out.write("\"0x", 3);
+        write_raw(out, to_hex(bv));
+        out.write("\"", 1);
+    }
+    void operator()(const boolean_type_impl& t) { write_raw(out, t.to_string(bv)); }
+    void operator()(const timestamp_date_base_class& t) { write_quoted_json_string(out, timestamp_to_json_string(t, bv)); }
+    void operator()(const timeuuid_type_impl& t) { write_quoted_json_string(out, t.to_string(bv)); }
+    void operator()(const map_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const set_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const list_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const tuple_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const user_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const simple_date_type_impl& t) { write_quoted_json_string(out, t.to_string(bv)); }
+    void operator()(const time_type_impl& t) { write_quoted_json_string(out, t.to_string(bv)); }
+    void operator()(const empty_type_impl& t) { out.write("null", 4); }
+    void operator()(const duration_type_impl& t) {
         auto v = t.deserialize(bv);
         if (v.is_null()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
-        return quote_json_string(t.to_string(bv));
+        write_quoted_json_string(out, t.to_string(bv));
     }
-    sstring operator()(const counter_type_impl& t) {
+    void operator()(const counter_type_impl& t) {
         // It will be called only from cql3 layer while processing query results.
-        return to_json_string(*counter_cell_view::total_value_type(), bv);
+        write_json(out, *counter_cell_view::total_value_type(), bv);
     }
-    sstring operator()(const decimal_type_impl& t) {
+    void operator()(const decimal_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<big_decimal>(v).to_string();
+        write_raw(out, value_cast<big_decimal>(v).to_string());
     }
-    sstring operator()(const varint_type_impl& t) {
+    void operator()(const varint_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<utils::multiprecision_int>(v).str();
+        write_raw(out, value_cast<utils::multiprecision_int>(v).str());
     }
 };
 }
 
+void write_json(bytes_ostream& out, const abstract_type& t, bytes_view bv) {
+    visit(t, write_json_visitor{out, bv});
+}
+
+void write_json(bytes_ostream& out, const abstract_type& t, const managed_bytes_view& mbv) {
+    ::with_linearized(mbv, [&] (bytes_view bv) {
+        write_json(out, t, bv);
+    });
+}
+
+static sstring as_sstring(const bytes_ostream& out) {
+    sstring ret = uninitialized_string(out.size());
+    auto dst = ret.data();
+    for (bytes_view frag : out.fragments()) {
+        dst = std::copy(frag.begin(), frag.end(), dst);
+    }
+    return ret;
+}
+
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
-    return visit(t, to_json_string_visitor{bv});
+    bytes_ostream out;
+    write_json(out, t, bv);
+    return as_sstring(out);
 }
 
 sstring to_json_string(const abstract_type& t, const managed_bytes_view& mbv) {
-    return visit(t, to_json_string_visitor{linearized(mbv)});
+    bytes_ostream out;
+    write_json(out, t, mbv);
+    return as_sstring(out);
 }
@@ -9,9 +9,24 @@
 #pragma once
 
 #include "types/types.hh"
+#include "bytes_ostream.hh"
 #include "utils/rjson.hh"
 
 bytes from_json_object(const abstract_type &t, const rjson::value& value);
+
+// Appends the JSON representation of the value to out, without building
+// intermediate strings for the elements of collections and tuples.
+void write_json(bytes_ostream& out, const abstract_type& t, bytes_view bv);
+void write_json(bytes_ostream& out, const abstract_type& t, const managed_bytes_view& bv);
+
+inline void write_json(bytes_ostream& out, const abstract_type& t, const bytes_opt& b) {
+    if (b) {
+        write_json(out, t, bytes_view(*b));
+    } else {
+        out.write("null", 4);
+    }
+}
+
 sstring to_json_string(const abstract_type &t, bytes_view bv);
 sstring to_json_string(const abstract_type &t, const managed_bytes_view& bv);
 
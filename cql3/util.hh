@@ -53,6 +53,14 @@ std::unique_ptr<cql3::statements::raw::select_statement> build_select_statement(
         bool select_all_columns,
         const std::vector<column_definition>& selected_columns);
 
+/// Prepares the restrictions of the statement
+/// "SELECT * FROM <table> WHERE <where_clause> ALLOW FILTERING",
+/// e.g. to filter with a WHERE clause received from another node.
+::shared_ptr<const restrictions::statement_restrictions> prepare_where_clause(
+        data_dictionary::database db,
+        const schema& s,
+        const sstring_view& where_clause);
+
 /// maybe_quote() takes an identifier - the name of a column, table or
 /// keyspace name - and transforms it to a string which can be used in CQL
 /// commands. Namely, if the identifier is not entirely lower-case (including
@@ -35,6 +35,7 @@
 #include "service_permit.hh"
 #include "cql3/query_processor.hh"
 #include "replica/database.hh"
+#include "cql3/selection/selection.hh"
 
 static logging::logger blogger("batchlog_manager");
 
@@ -63,29 +64,24 @@ future<> db::batchlog_manager::do_batch_log_replay() {
         auto gate_holder = bm._gate.hold();
         auto sem_units = co_await get_units(bm._sem, 1);
 
-        auto dest = bm._cpu++ % smp::count;
-        blogger.debug("Batchlog replay on shard {}: starts", dest);
-        if (dest == 0) {
-            co_await bm.replay_all_failed_batches();
-        } else {
-            co_await bm.container().invoke_on(dest, [] (auto& bm) {
-                return with_gate(bm._gate, [&bm] {
-                    return bm.replay_all_failed_batches();
-                });
+        // Every shard replays the batches stored on it, in parallel.
+        blogger.debug("Batchlog replay: starts");
+        co_await bm.container().invoke_on_all([] (auto& bm) {
+            return with_gate(bm._gate, [&bm] {
+                return bm.replay_all_failed_batches();
             });
-        }
-        blogger.debug("Batchlog replay on shard {}: done", dest);
+        });
+        blogger.debug("Batchlog replay: done");
     });
 }
 
 future<> db::batchlog_manager::batchlog_replay_loop() {
     if (this_shard_id() != 0) {
         // Since replay is a "node global" operation, we should not attempt to do
-        // it in parallel on each shard. It will just overlap/interfere.  To
+        // it from each shard. It will just overlap/interfere.  To
         // simplify syncing between batchlog_replay_loop and user initiated replay operations,
-        // we use the _sem on shard zero only. Replaying batchlog can
-        // generate a lot of work, so we distrute the real work on all cpus with
-        // round-robin scheduling.
+        // we use the _sem on shard zero only. Each replay runs on all shards,
+        // every shard replaying the batches it stores.
         co_return;
     }
 
@@ -150,7 +146,8 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
 
     // rate limit is in bytes per second. Uses Double.MAX_VALUE if disabled (set to 0 in cassandra.yaml).
     // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272).
-    auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners();
+    // All shards replay at the same time, so each gets its share of the rate.
+    auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners() / smp::count;
     auto limiter = make_lw_shared<utils::rate_limiter>(throttle);
 
     auto batch = [this, limiter](const cql3::untyped_result_set::row& row) {
@@ -257,48 +254,43 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
         });
     };
 
-    return seastar::with_gate(_gate, [this, batch = std::move(batch)] {
-        blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
-
-        typedef ::shared_ptr<cql3::untyped_result_set> page_ptr;
-        sstring query = format("SELECT id, data, written_at, version FROM {}.{} LIMIT {:d}", system_keyspace::NAME, system_keyspace::BATCHLOG, page_size);
-        return _qp.execute_internal(query, cql3::query_processor::cache_internal::yes).then([this, batch = std::move(batch)](page_ptr page) {
-            return do_with(std::move(page), [this, batch = std::move(batch)](page_ptr & page) mutable {
-                return repeat([this, &page, batch = std::move(batch)]() mutable {
-                    if (page->empty()) {
-                        return make_ready_future<stop_iteration>(stop_iteration::yes);
-                    }
-                    auto id = page->back().get_as<utils::UUID>("id");
-                    return parallel_for_each(*page, batch).then([this, &page, id]() {
-                        if (page->size() < page_size) {
-                            return make_ready_future<stop_iteration>(stop_iteration::yes); // we've exhausted the batchlog, next query would be empty.
-                        }
-                        sstring query = format("SELECT id, data, written_at, version FROM {}.{} WHERE token(id) > token(?) LIMIT {:d}",
-                                system_keyspace::NAME,
-                                system_keyspace::BATCHLOG,
-                                page_size);
-                        return _qp.execute_internal(query, {id}, cql3::query_processor::cache_internal::yes).then([&page](auto res) {
-                                    page = std::move(res);
-                                    return make_ready_future<stop_iteration>(stop_iteration::no);
-                                });
-                    });
-                });
-            });
-        }).then([] {
-        // TODO FIXME : cleanup()
+    auto gate_holder = _gate.hold();
+    blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
+
+    // Every shard replays the batches it stores, so read only the local data.
+    auto& db = _qp.proxy().local_db();
+    auto schema = db.find_schema(system_keyspace::NAME, system_keyspace::BATCHLOG);
+    auto selection = cql3::selection::selection::wildcard(schema);
+    const auto& slice = schema->full_slice();
+    auto range = query::full_partition_range;
+    while (true) {
+        auto cmd = query::read_command(schema->id(), schema->version(), slice, _qp.proxy().get_max_result_size(slice),
+                query::tombstone_limit(_qp.proxy().get_tombstone_limit()), query::row_limit(page_size));
+        auto [result, temperature] = co_await db.query(schema, cmd, query::result_options::only_result(), {range}, nullptr, db::no_timeout);
+        // The page may end early when it reached the size or tombstone limit.
+        auto short_read = bool(result->is_short_read());
+        auto page = cql3::untyped_result_set(*schema, make_foreign(std::move(result)), *selection, slice);
+        if (page.empty()) {
+            break;
+        }
+        auto id = page.back().get_as<utils::UUID>("id");
+        co_await parallel_for_each(page, batch);
+        if (page.size() < page_size && !short_read) {
+            break; // we've exhausted the batchlog, next query would be empty.
+        }
+        auto key = dht::decorate_key(*schema, partition_key::from_singular(*schema, id));
+        range = dht::partition_range::make_starting_with(dht::partition_range::bound(std::move(key), false));
+    }
+    // TODO FIXME : cleanup()
 #if 0
-            ColumnFamilyStore cfs = Keyspace.open(SystemKeyspace.NAME).getColumnFamilyStore(SystemKeyspace.BATCHLOG);
-            cfs.forceBlockingFlush();
-            Collection<Descriptor> descriptors = new ArrayList<>();
-            for (SSTableReader sstr : cfs.getSSTables())
-            descriptors.add(sstr.descriptor);
-            if (!descriptors.isEmpty()) // don't pollute the logs if there is nothing to compact.
-            CompactionManager.instance.submitUserDefined(cfs, descriptors, Integer.MAX_VALUE).get();
+        ColumnFamilyStore cfs = Keyspace.open(SystemKeyspace.NAME).getColumnFamilyStore(SystemKeyspace.BATCHLOG);
+        cfs.forceBlockingFlush();
+        Collection<Descriptor> descriptors = new ArrayList<>();
+        for (SSTableReader sstr : cfs.getSSTables())
+        descriptors.add(sstr.descriptor);
+        if (!descriptors.isEmpty()) // don't pollute the logs if there is nothing to compact.
+        CompactionManager.instance.submitUserDefined(cfs, descriptors, Integer.MAX_VALUE).get();
 
 #endif
-
-        }).then([] {
-            blogger.debug("Finished replayAllFailedBatches");
-        });
-    });
+    blogger.debug("Finished replayAllFailedBatches");
 }
@@ -60,7 +60,6 @@ class batchlog_manager : public peering_sharded_service<batchlog_manager> {
     std::chrono::milliseconds _delay;
     semaphore _sem{1};
     seastar::gate _gate;
-    unsigned _cpu = 0;
     seastar::abort_source _stop;
     future<> _loop_done;
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <map>
+
+#include <seastar/core/sstring.hh>
+
+#include "exceptions/exceptions.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+#include "utils/i_filter.hh"
+
+namespace db {
+
+// Per-table options of the bloom filters of the table's sstables, e.g.
+//
+//   ALTER TABLE ks.t WITH bloom_filter = {'layout': 'blocked'};
+//
+// Only affects newly written sstables, the layout of existing ones is
+// recorded in their Scylla component.
+class bloom_filter_extension : public schema_extension {
+    utils::filter_layout _layout = utils::filter_layout::classic;
+
+    static constexpr auto layout_key = "layout";
+
+    static utils::filter_layout parse_layout(const std::map<sstring, sstring>& map) {
+        for (auto& [k, v] : map) {
+            if (k != layout_key) {
+                throw exceptions::configuration_exception(format("Unknown key in map for bloom_filter extension: {}", k));
+            }
+        }
+        auto it = map.find(layout_key);
+        if (it == map.end() || it->second == "classic") {
+            return utils::filter_layout::classic;
+        }
+        if (it->second == "blocked") {
+            return utils::filter_layout::blocked;
+        }
+        throw exceptions::configuration_exception(format("Invalid bloom filter layout '{}': expected 'classic' or 'blocked'", it->second));
+    }
+public:
+    static constexpr auto NAME = "bloom_filter";
+
+    bloom_filter_extension() = default;
+    explicit bloom_filter_extension(utils::filter_layout layout) : _layout(layout) {}
+    explicit bloom_filter_extension(const std::map<sstring, sstring>& map) : _layout(parse_layout(map)) {}
+    explicit bloom_filter_extension(const bytes& b) : _layout(parse_layout(deserialize(b))) {}
+    explicit bloom_filter_extension(const sstring& s) {
+        throw std::logic_error("Cannot create bloom filter info from string");
+    }
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(to_map());
+    }
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<std::map<sstring, sstring>>());
+    }
+    std::map<sstring, sstring> to_map() const {
+        return {{layout_key, _layout == utils::filter_layout::blocked ? "blocked" : "classic"}};
+    }
+    utils::filter_layout get_layout() const {
+        return _layout;
+    }
+};
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <map>
+
+#include <boost/lexical_cast.hpp>
+#include <seastar/core/sstring.hh>
+
+#include "exceptions/exceptions.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+
+namespace db {
+
+// Per-table eviction weight of the table's data in the row cache, e.g.
+//
+//   ALTER TABLE ks.t WITH cache_eviction = {'weight': '8'};
+//
+// All tables share a single LRU. A row of a table with weight w is passed
+// over by eviction with probability 1 - 1/w, so under memory pressure it
+// stays in cache about w times as long as a row of an unweighted table.
+class cache_eviction_extension : public schema_extension {
+    uint32_t _weight = 1;
+
+    static constexpr auto weight_key = "weight";
+
+    static uint32_t parse_weight(const std::map<sstring, sstring>& map) {
+        for (auto& [k, v] : map) {
+            if (k != weight_key) {
+                throw exceptions::configuration_exception(format("Unknown key in map for cache_eviction extension: {}", k));
+            }
+        }
+        auto it = map.find(weight_key);
+        if (it == map.end()) {
+            return 1;
+        }
+        uint32_t weight;
+        try {
+            weight = boost::lexical_cast<uint32_t>(it->second);
+        } catch (boost::bad_lexical_cast&) {
+            throw exceptions::configuration_exception(format("Invalid cache eviction weight '{}': expected an integer", it->second));
+        }
+        if (weight < 1 || weight > max_weight) {
+            throw exceptions::configuration_exception(format("Invalid cache eviction weight {}: must be between 1 and {}", weight, max_weight));
+        }
+        return weight;
+    }
+public:
+    static constexpr auto NAME = "cache_eviction";
+    static constexpr uint32_t max_weight = 64;
+
+    cache_eviction_extension() = default;
+    explicit cache_eviction_extension(uint32_t weight) : _weight(weight) {}
+    explicit cache_eviction_extension(const std::map<sstring, sstring>& map) : _weight(parse_weight(map)) {}
+    explicit cache_eviction_extension(const bytes& b) : _weight(parse_weight(deserialize(b))) {}
+    explicit cache_eviction_extension(const sstring& s) {
+        throw std::logic_error("Cannot create cache eviction info from string");
+    }
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(to_map());
+    }
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<std::map<sstring, sstring>>());
+    }
+    std::map<sstring, sstring> to_map() const {
+        return {{weight_key, seastar::format("{}", _weight)}};
+    }
+    uint32_t get_weight() const {
+        return _weight;
+    }
+};
+
+}
@@ -14,13 +14,29 @@
 #include "mutation/partition_version.hh"
 #include "mutation/mutation_cleaner.hh"
 #include "utils/cached_file_stats.hh"
+#include "utils/frequency_sketch.hh"
+#include "utils/top_k.hh"
+#include "utils/estimated_histogram.hh"
+#include "dht/ring_position.hh"
 #include "sstables/partition_index_cache_stats.hh"
 
+#include <seastar/core/future.hh>
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+
+#include <boost/intrusive/list.hpp>
+#include <boost/intrusive/set.hpp>
 
 #include <stdint.h>
+#include <random>
+#include <unordered_map>
 
 class cache_entry;
+class cache_tracker;
+class row_cache;
+class frozen_mutation;
+class mutation;
 
 namespace cache {
 
@@ -30,6 +46,45 @@ class cache_flat_mutation_reader;
 class read_context;
 class lsa_manager;
 
+// A partition moved out of the row cache into its compressed tier: the frozen
+// mutation of the partition, compressed with LZ4. Allocated in the standard allocator.
+//
+// Linked in the compressed tier of its row_cache, ordered by key, and in the LRU
+// of compressed partitions of the cache_tracker. Destroying it unlinks it from both.
+class compressed_partition {
+    using link_mode = boost::intrusive::link_mode<boost::intrusive::auto_unlink>;
+public:
+    boost::intrusive::set_member_hook<link_mode> _set_link;
+    boost::intrusive::list_member_hook<link_mode> _lru_link;
+private:
+    cache_tracker& _tracker;
+    dht::decorated_key _key;
+    // The schema the mutation was frozen with.
+    schema_ptr _schema;
+    std::unique_ptr<char[]> _data;
+    uint32_t _compressed_size;
+    uint32_t _size;
+public:
+    // Orders compressed partitions by ring position.
+    struct less_comparator {
+        schema_ptr s;
+        bool operator()(const compressed_partition& a, const compressed_partition& b) const;
+        bool operator()(const compressed_partition& a, dht::ring_position_view b) const;
+        bool operator()(dht::ring_position_view a, const compressed_partition& b) const;
+    };
+
+    // The mutation must have been frozen with schema s.
+    compressed_partition(cache_tracker&, schema_ptr s, dht::decorated_key, frozen_mutation);
+    compressed_partition(compressed_partition&&) = delete;
+    ~compressed_partition();
+
+    const dht::decorated_key& key() const noexcept { return _key; }
+    const schema_ptr& schema() const noexcept { return _schema; }
+    size_t memory_usage() const noexcept;
+    // The uncompressed mutation, using schema().
+    mutation decompress() const;
+};
+
 }
 
 // Tracks accesses and performs eviction of cache entries.
@@ -39,6 +94,7 @@ class cache_tracker final {
     friend class cache::read_context;
     friend class cache::autoupdating_underlying_reader;
     friend class cache::cache_flat_mutation_reader;
+    friend class cache::compressed_partition;
     struct stats {
         uint64_t partition_hits;
         uint64_t partition_misses;
@@ -50,6 +106,7 @@ class cache_tracker final {
         uint64_t static_row_insertions;
         uint64_t concurrent_misses_same_key;
         uint64_t partition_merges;
+        uint64_t partition_merges_preempted;
         uint64_t rows_processed_from_memtable;
         uint64_t rows_dropped_from_memtable;
         uint64_t rows_merged_from_memtable;
@@ -73,15 +130,54 @@ class cache_tracker final {
         uint64_t row_tombstone_reads;
         uint64_t rows_compacted;
         uint64_t rows_compacted_away;
+        uint64_t rows_collapsed;
+        uint64_t partition_admission_rejections;
+        uint64_t row_evictions_spared;
+        uint64_t compressed_partitions;
+        uint64_t compressed_bytes;
+        uint64_t compressed_demotions;
+        uint64_t compressed_promotions;
+        uint64_t compressed_evictions;
+        uint64_t compressed_removals;
+        uint64_t pinned_hot_partitions;
 
         uint64_t active_reads() const {
             return reads - reads_done;
         }
     };
+    // A partition which took a large share of the recent reads, see set_hot_partitions().
+    struct hot_partition {
+        schema_ptr schema;
+        dht::decorated_key key;
+        // Estimated number of sampled reads, overestimated by at most error.
+        unsigned count;
+        unsigned error;
+        bool pinned;
+    };
+private:
+    struct hot_partition_key {
+        schema_ptr schema;
+        dht::decorated_key key;
+
+        struct hash {
+            size_t operator()(const hot_partition_key& k) const {
+                return std::hash<dht::token>()(k.key.token());
+            }
+        };
+        struct equal {
+            bool operator()(const hot_partition_key& k1, const hot_partition_key& k2) const {
+                return k1.schema->id() == k2.schema->id() && k1.key.equal(*k2.schema, k2.key);
+            }
+        };
+    };
+    using hot_partitions_top_k = utils::space_saving_top_k<hot_partition_key, hot_partition_key::hash, hot_partition_key::equal>;
 private:
     stats _stats{};
     cached_file_stats _index_cached_file_stats{};
     partition_index_cache_stats _partition_index_cache_stats{};
+    promoted_index_block_cache_stats _promoted_index_block_cache_stats{};
+    // How long cache updates from memtables ran without yielding.
+    utils::time_estimated_histogram _update_step_duration;
     seastar::metrics::metric_groups _metrics;
     logalloc::region _region;
     lru _lru;
@@ -89,8 +185,41 @@ class cache_tracker final {
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
     utils::updateable_value<double> _index_cache_fraction;
+    utils::updateable_value<bool> _admission_filter{false};
+    std::unique_ptr<utils::frequency_sketch> _admission_sketch;
+    // Estimated frequency of the most recently evicted partition.
+    unsigned _victim_frequency = 0;
+    // Number of caches of tables with a cache eviction weight above 1.
+    unsigned _weighted_caches = 0;
+    std::minstd_rand _spare_rng;
+    // The compressed tier, see set_compressed_tier().
+    using compressed_lru_type = boost::intrusive::list<cache::compressed_partition,
+        boost::intrusive::member_hook<cache::compressed_partition, boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>,
+            &cache::compressed_partition::_lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+    utils::updateable_value<double> _compressed_tier_fraction{0};
+    compressed_lru_type _compressed_lru;
+    std::unordered_multimap<table_id, row_cache*> _caches;
+    timer<lowres_clock> _demotion_timer;
+    // Value of _stats.row_evictions at the last demotion round.
+    uint64_t _row_evictions_at_demotion = 0;
+    // Hot partition detection, see set_hot_partitions().
+    utils::updateable_value<uint32_t> _hot_partitions_limit{0};
+    std::unique_ptr<hot_partitions_top_k> _hot_partitions_top_k;
+    unsigned _hot_partition_reads = 0;
+    unsigned _hot_partition_samples = 0;
+    std::vector<hot_partition> _hot_partitions;
 private:
+    void spare_weighted_rows() noexcept;
+    void refresh_hot_partitions();
+    void set_pinned(const hot_partition&, bool) noexcept;
+    void clear_hot_partitions() noexcept;
+    size_t compressed_tier_budget() const noexcept;
+    rows_entry* find_row(table_id, const dht::decorated_key&, position_in_partition_view) noexcept;
+    void trim_compressed_tier() noexcept;
     void setup_metrics();
+    utils::frequency_sketch* admission_sketch();
+    void record_access(utils::frequency_sketch&, uint64_t key_hash) noexcept;
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
     cache_tracker(utils::updateable_value<double> index_cache_fraction, mutation_application_stats&, register_metrics);
@@ -122,10 +251,13 @@ class cache_tracker final {
     void on_row_processed_from_memtable() noexcept { ++_stats.rows_processed_from_memtable; }
     void on_row_dropped_from_memtable() noexcept { ++_stats.rows_dropped_from_memtable; }
     void on_row_merged_from_memtable() noexcept { ++_stats.rows_merged_from_memtable; }
+    void on_partition_merge_preempted() noexcept { ++_stats.partition_merges_preempted; }
+    void on_update_step(utils::time_estimated_histogram::duration d) noexcept { _update_step_duration.add(d); }
     void on_range_tombstone_read() noexcept { ++_stats.range_tombstone_reads; }
     void on_row_tombstone_read() noexcept { ++_stats.row_tombstone_reads; }
     void on_row_compacted() noexcept { ++_stats.rows_compacted; }
     void on_row_compacted_away() noexcept { ++_stats.rows_compacted_away; }
+    void on_row_collapsed() noexcept { --_stats.rows; ++_stats.rows_collapsed; }
     void pinned_dirty_memory_overload(uint64_t bytes) noexcept;
     allocation_strategy& allocator() noexcept;
     logalloc::region& region() noexcept;
@@ -139,7 +271,78 @@ class cache_tracker final {
     lru& get_lru() { return _lru; }
     cached_file_stats& get_index_cached_file_stats() { return _index_cached_file_stats; }
     partition_index_cache_stats& get_partition_index_cache_stats() { return _partition_index_cache_stats; }
+    promoted_index_block_cache_stats& get_promoted_index_block_cache_stats() { return _promoted_index_block_cache_stats; }
     seastar::memory::reclaiming_result evict_from_lru_shallow() noexcept;
+
+    // TinyLFU admission of partitions populated by reads.
+    // When enabled, accesses to partitions are recorded in a frequency sketch,
+    // and a partition which missed in cache is only populated if it is estimated
+    // to be accessed more often than the most recently evicted partition.
+    void set_admission_filter(utils::updateable_value<bool> enabled);
+    // Records a read of a partition which was found in cache.
+    void on_partition_access(uint64_t key_hash);
+    // Records a read of a partition which missed in cache and returns
+    // whether it should be populated.
+    bool admit(uint64_t key_hash);
+    void on_partition_victim(uint64_t key_hash) noexcept;
+
+    // Compressed tier of the row cache.
+    // When enabled, partitions about to be evicted are periodically moved out
+    // of the row cache into a compressed form, which is kept in memory up to
+    // the given fraction of the shard's memory, and moved back into the row cache
+    // when read. Only complete partitions of caches not being updated are moved.
+    void set_compressed_tier(utils::updateable_value<double> memory_fraction);
+    // Moves partitions from the head of the LRU into the compressed tier,
+    // if there was eviction since the last call. Called periodically when
+    // the compressed tier is enabled.
+    void demote_cold_partitions() noexcept;
+    void register_cache(row_cache&);
+    void unregister_cache(row_cache&) noexcept;
+    // Returns the keys of up to max_keys_per_table of the most recently used
+    // partitions of each cache, most recently used first.
+    future<std::unordered_map<table_id, std::vector<dht::decorated_key>>> get_recent_partition_keys(size_t max_keys_per_table);
+    void on_partition_demotion() noexcept;
+
+    // Detection of hot partitions.
+    // When limit is above 0, a sample of the single-partition reads is fed
+    // into a space-saving top-k, and every so many samples, up to limit of
+    // the partitions which took the most reads are published. Those which took
+    // a large share of the reads are pinned: their rows are passed over by
+    // eviction, as long as they are cached, until they stop being hot.
+    void set_hot_partitions(utils::updateable_value<uint32_t> limit);
+    // Records a single-partition read, whether it hit in cache or not.
+    void on_single_partition_read(const schema_ptr&, const dht::ring_position&) noexcept;
+    // The hot partitions found in the last completed detection round, hottest first.
+    const std::vector<hot_partition>& hot_partitions() const noexcept { return _hot_partitions; }
+
+    // Row caches of tables with a cache eviction weight above 1 register here,
+    // so that eviction only pays for looking up weights when there are any.
+    class weighted_cache_registration {
+        cache_tracker* _tracker = nullptr;
+        void reset() noexcept {
+            if (_tracker) {
+                --_tracker->_weighted_caches;
+                _tracker = nullptr;
+            }
+        }
+    public:
+        weighted_cache_registration() = default;
+        explicit weighted_cache_registration(cache_tracker& t) noexcept : _tracker(&t) {
+            ++_tracker->_weighted_caches;
+        }
+        weighted_cache_registration(weighted_cache_registration&& o) noexcept : _tracker(std::exchange(o._tracker, nullptr)) {}
+        weighted_cache_registration& operator=(weighted_cache_registration&& o) noexcept {
+            if (this != &o) {
+                reset();
+                _tracker = std::exchange(o._tracker, nullptr);
+            }
+            return *this;
+        }
+        ~weighted_cache_registration() {
+            reset();
+        }
+        explicit operator bool() const noexcept { return _tracker; }
+    };
 };
 
 inline
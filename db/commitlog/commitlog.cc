@@ -106,9 +106,12 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
+    c.commitlog_sync_batch_window_in_us = cfg.commitlog_sync_batch_group_commit_window_in_us();
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.preallocated_segments = cfg.commitlog_preallocated_segments();
     c.allow_going_over_size_limit = !cfg.commitlog_use_hard_size_limit();
+    c.segment_groups = cfg.commitlog_segment_grouping() == "system" ? 2 : 1;
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
         c.commitlog_flush_threshold_in_mb = cfg.commitlog_flush_threshold_in_mb();
@@ -309,6 +312,9 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     };
 
     std::optional<shared_future<with_clock<db::timeout_clock>>> _segment_allocating;
+    // The segment currently allocated from, per segment group
+    std::vector<sseg_ptr> _active_segments;
+    std::unordered_map<cf_id_type, unsigned> _cf_segment_groups;
     std::vector<std::pair<named_file, dispose_mode>> _files_to_dispose;
 
     void account_memory_usage(size_t size) noexcept {
@@ -372,6 +378,8 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t requests_blocked_memory = 0;
         uint64_t blocked_on_new_segment = 0;
         uint64_t active_allocations = 0;
+        uint64_t batch_windows = 0;
+        uint64_t batch_window_writes = 0;
     };
 
     class scope_increment_counter {
@@ -428,8 +436,9 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     }
 
     future<> init();
-    future<sseg_ptr> new_segment();
-    future<sseg_ptr> active_segment(db::timeout_clock::time_point timeout);
+    unsigned segment_group(const cf_id_type&);
+    future<sseg_ptr> new_segment(unsigned group);
+    future<sseg_ptr> active_segment(unsigned group, db::timeout_clock::time_point timeout);
     future<sseg_ptr> allocate_segment();
     future<sseg_ptr> allocate_segment_ex(descriptor, named_file, open_flags);
 
@@ -454,12 +463,23 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     void discard_unused_segments() noexcept;
     void discard_completed_segments(const cf_id_type&) noexcept;
     void discard_completed_segments(const cf_id_type&, const rp_set&) noexcept;
+    void forget_table(const cf_id_type&) noexcept;
     
     future<> force_new_active_segment() noexcept;
     future<> wait_for_pending_deletes() noexcept;
 
     void on_timer();
     void sync();
+
+    /**
+     * Batch mode group commit. Writers that arrive within the same
+     * window share a single segment sync. Windows are aligned to the
+     * same boundaries (multiples of the window on the steady clock) on
+     * all shards, so that shards sharing a device issue their syncs
+     * together instead of trickling them in one by one.
+     */
+    future<> wait_for_batch_window(db::timeout_clock::time_point timeout);
+    void close_batch_window() noexcept;
     void arm(uint32_t extra = 0) {
         if (!_shutdown) {
             _timer.arm(std::chrono::milliseconds(cfg.commitlog_sync_period_in_ms + extra));
@@ -506,6 +526,9 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     flush_handler_id _flush_ids = 0;
     replay_position _flush_position;
     timer<clock_type> _timer;
+    std::optional<shared_promise<with_clock<db::timeout_clock>>> _batch_window;
+    uint64_t _batch_window_writers = 0;
+    timer<> _batch_window_timer;
     future<> replenish_reserve();
     future<> _reserve_replenisher;
     future<> _background_sync;
@@ -726,6 +749,11 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
     size_t _alignment;
 
+    // The segment group this segment was made active for
+    unsigned _group = 0;
+    // Set once the tables with data in this closed segment were asked to flush it
+    bool _flush_requested = false;
+
     bool _closed = false;
     bool _terminated = false;
 
@@ -876,7 +904,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     future<sseg_ptr> finish_and_get_new(db::timeout_clock::time_point timeout) {
         //FIXME: discarded future.
         (void)close();
-        return _segment_manager->active_segment(timeout);
+        return _segment_manager->active_segment(_group, timeout);
     }
     void reset_sync_time() {
         _sync_time = clock_type::now();
@@ -1444,10 +1472,12 @@ future<R> db::commitlog::segment_manager::allocate_when_possible(T writer, db::t
     auto permit = co_await std::move(fut);
     sseg_ptr s;
 
-    if (!_segments.empty() && _segments.back()->is_still_allocating()) {
-        s = _segments.back();
+    // All entries of the writer go to the group of the first one
+    auto group = segment_group(writer.id(0));
+    if (_active_segments[group] && _active_segments[group]->is_still_allocating()) {
+        s = _active_segments[group];
     } else {
-        s = co_await active_segment(timeout);
+        s = co_await active_segment(group, timeout);
     }
 
     for (;;) {
@@ -1463,6 +1493,9 @@ future<R> db::commitlog::segment_manager::allocate_when_possible(T writer, db::t
                 s = co_await s->finish_and_get_new(timeout);
                 continue;
             case write_result::ok_need_batch_sync:
+                if (cfg.commitlog_sync_batch_window_in_us != 0) {
+                    co_await wait_for_batch_window(timeout);
+                }
                 s = co_await s->batch_cycle(timeout);
                 co_return writer.result();
         }
@@ -1484,6 +1517,8 @@ db::commitlog::segment_manager::segment_manager(config c)
                             5 * smp::count;
         }
         cfg.max_active_flushes = std::max(uint64_t(1), cfg.max_active_flushes / smp::count);
+        cfg.max_reserve_segments = std::max(cfg.max_reserve_segments, cfg.preallocated_segments);
+        cfg.segment_groups = std::max(cfg.segment_groups, 1u);
 
         if (!cfg.base_segment_id) {
             cfg.base_segment_id = std::chrono::duration_cast<std::chrono::milliseconds>(runtime::get_boot_time().time_since_epoch()).count() + 1;
@@ -1512,14 +1547,29 @@ db::commitlog::segment_manager::segment_manager(config c)
     , _recycled_segments(std::numeric_limits<size_t>::max())
     , _reserve_replenisher(make_ready_future<>())
     , _background_sync(make_ready_future<>())
+    , _batch_window_timer([this] { close_batch_window(); })
 {
     assert(max_size > 0);
     assert(max_mutation_size < segment::multi_entry_size_magic);
 
+    _active_segments.resize(cfg.segment_groups);
+
     clogger.trace("Commitlog {} maximum disk size: {} MB / cpu ({} cpus)",
             cfg.commit_log_location, max_disk_size / (1024 * 1024),
             smp::count);
 
+    if (cfg.preallocated_segments != 0) {
+        // Fixed pool: let the replenisher create (and, with O_DSYNC, pre-write)
+        // the whole reserve up front, so that bursts take already prepared
+        // segments instead of growing the reserve after having stalled.
+        auto n = cfg.preallocated_segments;
+        if (max_disk_size != 0) {
+            n = std::min<uint64_t>(n, std::max<uint64_t>(max_disk_size / max_size, 1));
+        }
+        _reserve_segments.set_max_size(n);
+        clogger.debug("Commitlog {} preallocating {} reserve segments", cfg.commit_log_location, n);
+    }
+
     if (!cfg.metrics_category_name.empty()) {
         create_counters(cfg.metrics_category_name);
     }
@@ -1642,6 +1692,32 @@ future<> db::commitlog::segment_manager::init() {
     arm(delay);
 }
 
+future<> db::commitlog::segment_manager::wait_for_batch_window(db::timeout_clock::time_point timeout) {
+    if (!_batch_window) {
+        using batch_clock = timer<>::clock;
+        auto window = std::chrono::microseconds(cfg.commitlog_sync_batch_window_in_us);
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>(batch_clock::now().time_since_epoch());
+        auto deadline = batch_clock::time_point(std::chrono::duration_cast<batch_clock::duration>((now / window + 1) * window));
+        _batch_window.emplace();
+        _batch_window_timer.arm(deadline);
+    }
+    ++_batch_window_writers;
+    return _batch_window->get_shared_future(timeout);
+}
+
+void db::commitlog::segment_manager::close_batch_window() noexcept {
+    if (!_batch_window) {
+        return;
+    }
+    ++totals.batch_windows;
+    totals.batch_window_writes += _batch_window_writers;
+    clogger.trace("Closing batch window with {} writers", _batch_window_writers);
+    _batch_window_writers = 0;
+    auto p = std::move(*_batch_window);
+    _batch_window.reset();
+    p.set_value();
+}
+
 void db::commitlog::segment_manager::create_counters(const sstring& metrics_category_name) {
     namespace sm = seastar::metrics;
 
@@ -1667,6 +1743,13 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
         sm::make_counter("flush", totals.flush_count,
                        sm::description("Counts number of times the flush() method was called for a file.")),
 
+        sm::make_counter("batch_windows", totals.batch_windows,
+                       sm::description("Counts number of batch mode group commit windows closed. "
+                                       "Divide batch_window_writes by this value to get the average number of writes sharing a sync.")),
+
+        sm::make_counter("batch_window_writes", totals.batch_window_writes,
+                       sm::description("Counts number of batch mode writes that waited for a group commit window.")),
+
         sm::make_counter("bytes_written", totals.bytes_written,
                        sm::description("Counts number of bytes written to the disk. "
                                        "Divide this value by \"alloc\" to get the average number of bytes per mutation written to the disk.")),
@@ -1742,20 +1825,27 @@ void db::commitlog::segment_manager::flush_segments(uint64_t size_to_remove) {
 
     uint64_t n = size_to_remove;
     uint64_t flushing = 0;
+    // The oldest segment still allocating, i.e. the oldest one we may not skip later on
+    std::optional<replay_position> oldest_active;
 
     for (auto& s : _segments) {
-        // if a segment is allocating, it should be included in flush request,
-        // because we cannot free anything there anyway. If a segment is allocating,
-        // it is the last one, so just break.
+        // if a segment is allocating, we cannot free anything there anyway.
+        // With a single segment group it is the last one, but with more groups
+        // there may be closed segments of other groups after it, which we can
+        // still free by flushing their tables only.
         if (s->is_still_allocating()) {
-            break;
+            if (!oldest_active) {
+                oldest_active = replay_position(s->_desc.id, 0);
+            }
+            continue;
         }
 
         auto rp = replay_position(s->_desc.id, db::position_type(s->size_on_disk()));
-        if (rp <= _flush_position) {
+        if (rp <= _flush_position || s->_flush_requested) {
             // already requested.
             continue;
         }
+        s->_flush_requested = true;
 
         auto size = s->size_on_disk();
         auto waste = s->_waste;
@@ -1788,7 +1878,10 @@ void db::commitlog::segment_manager::flush_segments(uint64_t size_to_remove) {
         }
     }
 
-    _flush_position = high;
+    // Don't mark segments which are still allocating as requested, they
+    // need to be considered once they are closed. Closed segments past
+    // them are marked one by one, see segment::_flush_requested.
+    _flush_position = oldest_active ? std::min(high, *oldest_active) : high;
     totals.bytes_flush_requested += flushing;
 }
 
@@ -1951,7 +2044,19 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
     }
 }
 
-future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::new_segment() {
+unsigned db::commitlog::segment_manager::segment_group(const cf_id_type& id) {
+    if (cfg.segment_groups == 1) {
+        return 0;
+    }
+    auto i = _cf_segment_groups.find(id);
+    if (i == _cf_segment_groups.end()) {
+        auto group = cfg.segment_group_of ? std::min(cfg.segment_group_of(id), cfg.segment_groups - 1) : 0;
+        i = _cf_segment_groups.emplace(id, group).first;
+    }
+    return i->second;
+}
+
+future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::new_segment(unsigned group) {
     gate::holder g(_gate);
 
     if (_shutdown) {
@@ -1975,17 +2080,21 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
     }
 
     auto s = co_await _reserve_segments.pop_eventually();
+    s->_group = group;
     _segments.push_back(s);
     _segments.back()->reset_sync_time();
+    _active_segments[group] = s;
     co_return s;
 }
 
-future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::active_segment(db::timeout_clock::time_point timeout) {
+future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::active_segment(unsigned group, db::timeout_clock::time_point timeout) {
     // If there is no active segment, try to allocate one using new_segment(). If we time out,
     // make sure later invocations can still pick that segment up once it's ready.
+    // Segments are allocated one at a time, also for different groups, since they
+    // all come from the same reserve.
     for (;;) {
-        if (!_segments.empty() && _segments.back()->is_still_allocating()) {
-            co_return _segments.back();
+        if (_active_segments[group] && _active_segments[group]->is_still_allocating()) {
+            co_return _active_segments[group];
         }
 
         scope_increment_counter blocked_on_new(totals.blocked_on_new_segment);
@@ -1994,7 +2103,7 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
         // the old one has terminated with either result or exception.
         // Do all waiting through the shared_future
         if (!_segment_allocating) {
-            auto f = new_segment();
+            auto f = new_segment(group);
             // must check that we are not already done.
             if (f.available()) {
                 f.get(); // maybe force exception
@@ -2036,15 +2145,21 @@ void db::commitlog::segment_manager::discard_completed_segments(const cf_id_type
     discard_unused_segments();
 }
 
-future<> db::commitlog::segment_manager::force_new_active_segment() noexcept {
-    if (_segments.empty() || !_segments.back()->is_still_allocating()) {
-        co_return;
-    }
+void db::commitlog::segment_manager::forget_table(const cf_id_type& id) noexcept {
+    _cf_segment_groups.erase(id);
+}
 
-    auto& s = _segments.back();
-    if (s->position()) { // check used.
-        co_await s->close();
-        discard_unused_segments();
+future<> db::commitlog::segment_manager::force_new_active_segment() noexcept {
+    // #8952 - closing can end up altering _active_segments (end_flush()->discard_unused())
+    auto active = _active_segments;
+    for (auto& s : active) {
+        if (!s || !s->is_still_allocating()) {
+            continue;
+        }
+        if (s->position()) { // check used.
+            co_await s->close();
+            discard_unused_segments();
+        }
     }
 }
 
@@ -2087,9 +2202,12 @@ struct fmt::formatter<db::commitlog::segment::cf_mark> {
 void db::commitlog::segment_manager::discard_unused_segments() noexcept {
     clogger.trace("Checking for unused segments ({} active)", _segments.size());
 
-    std::erase_if(_segments, [=](sseg_ptr s) {
+    std::erase_if(_segments, [this](sseg_ptr s) {
         if (s->can_delete()) {
             clogger.debug("Segment {} is unused", fmt::streamed(*s));
+            if (_active_segments[s->_group] == s) {
+                _active_segments[s->_group] = nullptr;
+            }
             return true;
         }
         if (s->is_still_allocating()) {
@@ -2174,6 +2292,8 @@ future<> db::commitlog::segment_manager::shutdown() {
             co_await std::move(block_new_requests);
 
             _timer.cancel(); // no more timer calls
+            _batch_window_timer.cancel();
+            close_batch_window();
             _shutdown = true; // no re-arm, no create new segments.
 
             // do a discard + delete sweep to force 
@@ -2389,6 +2509,7 @@ future<> db::commitlog::segment_manager::do_pending_deletes() {
 
 future<> db::commitlog::segment_manager::orphan_all() {
     _segments.clear();
+    std::ranges::fill(_active_segments, nullptr);
     return clear_reserve_segments();
 }
 
@@ -2716,6 +2837,10 @@ void db::commitlog::discard_completed_segments(const cf_id_type& id) {
     _segment_manager->discard_completed_segments(id);
 }
 
+void db::commitlog::forget_table(const cf_id_type& id) noexcept {
+    _segment_manager->forget_table(id);
+}
+
 future<> db::commitlog::force_new_active_segment() noexcept {
     co_await _segment_manager->force_new_active_segment();
 }
@@ -3232,6 +3357,14 @@ uint64_t db::commitlog::get_flush_count() const {
     return _segment_manager->totals.flush_count;
 }
 
+uint64_t db::commitlog::get_num_batch_windows() const {
+    return _segment_manager->totals.batch_windows;
+}
+
+uint64_t db::commitlog::get_num_batch_window_writes() const {
+    return _segment_manager->totals.batch_window_writes;
+}
+
 uint64_t db::commitlog::get_pending_tasks() const {
     return _segment_manager->totals.pending_flushes;
 }
@@ -97,9 +97,16 @@ class commitlog {
         std::optional<uint64_t> commitlog_flush_threshold_in_mb = {};
         uint64_t commitlog_segment_size_in_mb = 32;
         uint64_t commitlog_sync_period_in_ms = 10 * 1000; //TODO: verify default!
+        // Group commit window for batch mode. Zero means every batch
+        // write syncs as soon as previous writes are done.
+        uint64_t commitlog_sync_batch_window_in_us = 0;
         // Max number of segments to keep in pre-alloc reserve.
         // Not (yet) configurable from scylla.conf.
         uint64_t max_reserve_segments = 12;
+        // Number of segments to preallocate and keep ready in reserve.
+        // Zero means the reserve starts at one segment and only grows
+        // once an allocation has found it empty.
+        uint64_t preallocated_segments = 0;
         // Max active flushes. Default value
         // zero means try to figure it out ourselves
         uint64_t max_active_flushes = 0;
@@ -111,6 +118,16 @@ class commitlog {
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = true;
 
+        // Number of segment groups. Each group has its own active segment
+        // and a table only writes to the segments of its group, so freeing
+        // segments of one group only requires flushing tables of that group.
+        // Every group beyond the first keeps one more segment open.
+        unsigned segment_groups = 1;
+        // Maps a table to its segment group, in [0, segment_groups).
+        // Called once per table, on its first write. All tables are in
+        // group 0 if not set.
+        std::function<unsigned(const cf_id_type&)> segment_group_of;
+
         // The base segment ID to use.
         // The segment IDs of newly allocated segments will be issued sequentially
         // and will start _right after_ this parameter.
@@ -231,6 +248,12 @@ class commitlog {
 
     void discard_completed_segments(const cf_id_type&);
 
+    /**
+     * Drops what the commitlog keeps about a table which was dropped, like its
+     * segment group. Must be called after the last write of the table.
+     */
+    void forget_table(const cf_id_type&) noexcept;
+
     /**
      * Forces active segment switch.
      * Called from API calls to help tests that need predictable
@@ -299,6 +322,8 @@ class commitlog {
     uint64_t get_total_size() const;
     uint64_t get_completed_tasks() const;
     uint64_t get_flush_count() const;
+    uint64_t get_num_batch_windows() const;
+    uint64_t get_num_batch_window_writes() const;
     uint64_t get_pending_tasks() const;
     uint64_t get_pending_flushes() const;
     uint64_t get_pending_allocations() const;
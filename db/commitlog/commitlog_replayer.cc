@@ -10,11 +10,17 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <unordered_map>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/seastar.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/coroutine/exception.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -25,6 +31,7 @@
 #include "commitlog_entry.hh"
 #include "validation.hh"
 #include "mutation/mutation_partition_view.hh"
+#include "tasks/task_manager.hh"
 
 static logging::logger rlogger("commitlog_replayer");
 
@@ -77,8 +84,27 @@ class db::commitlog_replayer::impl {
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    // Lives on shard 0
+    struct replay_progress {
+        uint64_t total_bytes = 0;
+        uint64_t replayed_bytes = 0;
+    };
+
+    // A decoded entry to be applied on its owning shard. The column mapping
+    // is owned by the _column_mappings of the shard which decoded it.
+    struct replay_entry {
+        frozen_mutation fm;
+        const column_mapping* cm;
+        replay_position rp;
+    };
+
+    class batcher;
+
+    future<> process(batcher&, stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    future<stats> apply(const std::vector<replay_entry>& entries) const;
     future<stats> recover(sstring file, const sstring& fname_prefix) const;
+    future<stats> recover_on_shard(const std::vector<std::pair<sstring, uint64_t>>& files, const sstring& fname_prefix, replay_progress& progress) const;
+    future<> replay(std::vector<sstring> files, sstring fname_prefix, replay_progress& progress);
 
     typedef std::unordered_map<table_id, replay_position> rp_map;
     typedef std::unordered_map<unsigned, rp_map> shard_rpm_map;
@@ -162,6 +188,75 @@ future<> db::commitlog_replayer::impl::init() {
     }
 }
 
+// Collects the entries decoded by a shard into per-shard batches, so that
+// they are sent to their owning shards with one cross-shard call per batch
+// instead of one per mutation. Decoding goes on while a batch is being
+// applied; batches sent to the same shard are applied in order.
+class db::commitlog_replayer::impl::batcher {
+    static constexpr size_t max_batch_bytes = 128 * 1024;
+    static constexpr size_t max_batch_mutations = 256;
+
+    struct shard_batch {
+        std::vector<replay_entry> entries;
+        size_t bytes = 0;
+        future<> in_flight = make_ready_future<>();
+    };
+
+    const impl& _impl;
+    stats& _stats;
+    std::vector<shard_batch> _batches;
+    std::exception_ptr _ex;
+
+    future<> send(seastar::shard_id shard) {
+        auto& b = _batches[shard];
+        co_await std::exchange(b.in_flight, make_ready_future<>());
+        b.bytes = 0;
+        b.in_flight = do_with(std::exchange(b.entries, {}), [this, shard] (const std::vector<replay_entry>& entries) {
+            return _impl._db.invoke_on(shard, [this, &entries] (replica::database&) {
+                return _impl.apply(entries);
+            });
+        }).then_wrapped([this] (future<stats> f) {
+            if (f.failed()) {
+                _ex = f.get_exception();
+            } else {
+                _stats += f.get();
+            }
+        });
+    }
+public:
+    batcher(const impl& i, stats& s)
+        : _impl(i)
+        , _stats(s)
+        , _batches(smp::count)
+    {}
+
+    future<> add(seastar::shard_id shard, replay_entry e) {
+        auto& b = _batches[shard];
+        b.bytes += e.fm.representation().size();
+        b.entries.push_back(std::move(e));
+        if (b.bytes >= max_batch_bytes || b.entries.size() >= max_batch_mutations) {
+            return send(shard);
+        }
+        return make_ready_future<>();
+    }
+
+    // Sends what's left and waits for all the batches to be applied.
+    // Must be called before the batcher is destroyed.
+    future<> flush() {
+        for (seastar::shard_id shard = 0; shard < _batches.size(); ++shard) {
+            if (!_batches[shard].entries.empty()) {
+                co_await send(shard);
+            }
+        }
+        for (auto& b : _batches) {
+            co_await std::exchange(b.in_flight, make_ready_future<>());
+        }
+        if (_ex) {
+            std::rethrow_exception(std::exchange(_ex, nullptr));
+        }
+    }
+};
+
 future<db::commitlog_replayer::impl::stats>
 db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix) const {
     assert(_column_mappings.local_is_initialized());
@@ -171,33 +266,45 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
 
     if (rp.id < gp.id) {
         rlogger.debug("skipping replay of fully-flushed {}", file);
-        return make_ready_future<stats>();
+        co_return stats();
     }
     position_type p = 0;
     if (rp.id == gp.id) {
         p = gp.pos;
     }
 
-    auto s = make_lw_shared<stats>();
+    stats s;
+    batcher b(*this, s);
     auto& exts = _db.local().extensions();
+    std::exception_ptr ex;
 
-    return db::commitlog::read_log_file(file, fname_prefix,
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (commitlog::segment_truncation& e) {
-            s->truncated_at = e.position();
-        } catch (...) {
-            throw;
+    try {
+        co_await db::commitlog::read_log_file(file, fname_prefix, [this, &b, &s] (commitlog::buffer_and_replay_position buf_rp) {
+            return process(b, &s, std::move(buf_rp));
+        }, p, &exts);
+    } catch (commitlog::segment_data_corruption_error& e) {
+        s.corrupt_bytes += e.bytes();
+    } catch (commitlog::segment_truncation& e) {
+        s.truncated_at = e.position();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+
+    // The entries decoded so far are still being applied
+    try {
+        co_await b.flush();
+    } catch (...) {
+        if (!ex) {
+            ex = std::current_exception();
         }
-        return make_ready_future<stats>(*s);
-    });
+    }
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    co_return s;
 }
 
-future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
+future<> db::commitlog_replayer::impl::process(batcher& b, stats* s, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -244,8 +351,41 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
             co_return;
         }
 
-      auto apply = [&] (seastar::shard_id shard) {
-        return _db.invoke_on(shard, [this, &fm, &src_cm, rp] (replica::database& db) mutable -> future<> {
+        auto shards = table.get_effective_replication_map()->shard_for_writes(schema, token);
+        if (shards.empty()) {
+            rlogger.debug("no shard for token {} in table {}", token, uuid);
+            s->skipped_mutations++;
+            co_return;
+        }
+        for (size_t i = 0; i < shards.size(); ++i) {
+            // Only copy the mutation if it goes to more than one shard
+            auto e = i + 1 < shards.size()
+                    ? replay_entry{fm, &src_cm, rp}
+                    : replay_entry{std::move(cer).mutation(), &src_cm, rp};
+            co_await b.add(shards[i], std::move(e));
+        }
+    } catch (replica::no_such_column_family&) {
+        // No such CF now? Origin just ignores this.
+    } catch (...) {
+        s->invalid_mutations++;
+        // TODO: write mutation to file like origin.
+        rlogger.warn("error replaying: {}", std::current_exception());
+    }
+}
+
+// Runs on the shard owning the entries.
+//
+// Unlike the regular write path, there's no commitlog, no rate limiting and
+// no schema synchronization to go through here: the mutations are applied
+// straight to the memtables.
+future<db::commitlog_replayer::impl::stats>
+db::commitlog_replayer::impl::apply(const std::vector<replay_entry>& entries) const {
+    auto& db = _db.local();
+    stats s;
+
+    for (const auto& e : entries) {
+        const auto& fm = e.fm;
+        try {
             // TODO: might need better verification that the deserialized mutation
             // is schema compatible. My guess is that just applying the mutation
             // will not do this.
@@ -253,11 +393,11 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
 
             if (rlogger.is_enabled(logging::log_level::debug)) {
                 rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                        cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
+                        cf.schema()->ks_name(), cf.schema()->cf_name(), e.rp);
             }
             if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
                 throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
+                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), e.rp, *err));
             }
             // Removed forwarding "new" RP. Instead give none/empty.
             // This is what origin does, and it should be fine.
@@ -266,42 +406,147 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
             // lower than anything the new session will produce.
             if (cf.schema()->version() != fm.schema_version()) {
                 auto& local_cm = _column_mappings.local().map;
-                auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
+                auto cm_it = local_cm.try_emplace(fm.schema_version(), *e.cm).first;
                 const column_mapping& cm = cm_it->second;
                 mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
                 converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
                 fm.partition().accept(cm, v);
-                return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                    return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                });
+                co_await db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
             } else {
-                return db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
-            }
-        }).then_wrapped([s] (future<> f) {
-            try {
-                f.get();
-                s->applied_mutations++;
-            } catch (...) {
-                s->invalid_mutations++;
-                // TODO: write mutation to file like origin.
-                rlogger.warn("error replaying: {}", std::current_exception());
+                co_await db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
             }
-        });
-      };
-        auto shards = table.get_effective_replication_map()->shard_for_writes(schema, token);
-        if (shards.empty()) {
-            rlogger.debug("no shard for token {} in table {}", token, uuid);
-            s->skipped_mutations++;
-        } else {
-            co_await seastar::parallel_for_each(shards, apply);
+            s.applied_mutations++;
+        } catch (...) {
+            s.invalid_mutations++;
+            // TODO: write mutation to file like origin.
+            rlogger.warn("error replaying: {}", std::current_exception());
         }
-    } catch (replica::no_such_column_family&) {
-        // No such CF now? Origin just ignores this.
+    }
+
+    co_return s;
+}
+
+future<db::commitlog_replayer::impl::stats>
+db::commitlog_replayer::impl::recover_on_shard(const std::vector<std::pair<sstring, uint64_t>>& files, const sstring& fname_prefix, replay_progress& progress) const {
+    stats total;
+
+    for (const auto& p : files) {
+        auto& f = p.first;
+        auto size = p.second;
+        rlogger.debug("Replaying {}", f);
+        auto stats = co_await recover(f, fname_prefix);
+        if (stats.corrupt_bytes != 0) {
+            rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
+        }
+        if (stats.truncated_at != 0) {
+            rlogger.warn("Truncated file: {} at position {}.", f, stats.truncated_at);
+        }
+        rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
+                        , f
+                        , stats.applied_mutations
+                        , stats.invalid_mutations
+                        , stats.skipped_mutations
+        );
+        total += stats;
+        co_await smp::submit_to(0, [&progress, size] {
+            progress.replayed_bytes += size;
+        });
+    }
+
+    co_return total;
+}
+
+future<> db::commitlog_replayer::impl::replay(std::vector<sstring> files, sstring fname_prefix, replay_progress& progress) {
+    rlogger.info("Replaying {}", fmt::join(files, ", "));
+
+    // Entries are forwarded to their owning shards, so a segment doesn't
+    // have to be replayed by the shard which wrote it. Spread the segments
+    // over all shards, largest first, to even out the amount of work.
+    std::vector<uint64_t> sizes(files.size());
+    co_await parallel_for_each(boost::irange(size_t(0), files.size()), [&files, &sizes] (size_t i) {
+        return file_size(files[i]).then([&sizes, i] (uint64_t size) {
+            sizes[i] = size;
+        });
+    });
+
+    std::vector<size_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&sizes] (size_t a, size_t b) {
+        return sizes[a] > sizes[b];
+    });
+
+    std::vector<std::vector<std::pair<sstring, uint64_t>>> work(smp::count);
+    std::vector<uint64_t> load(smp::count);
+    for (auto i : order) {
+        auto shard = std::min_element(load.begin(), load.end()) - load.begin();
+        load[shard] += sizes[i];
+        work[shard].emplace_back(std::move(files[i]), sizes[i]);
+        progress.total_bytes += sizes[i];
+    }
+
+    co_await start();
+    std::exception_ptr ex;
+
+    try {
+        auto totals = co_await map_reduce(smp::all_cpus(), [this, &work, &fname_prefix, &progress] (unsigned id) {
+            return smp::submit_to(id, [this, &files = work[id], &fname_prefix, &progress] {
+                return recover_on_shard(files, fname_prefix, progress);
+            });
+        }, stats(), std::plus<stats>());
+        rlogger.info("Log replay complete, {} replayed mutations ({} invalid, {} skipped)"
+                        , totals.applied_mutations
+                        , totals.invalid_mutations
+                        , totals.skipped_mutations
+        );
     } catch (...) {
-        s->invalid_mutations++;
-        // TODO: write mutation to file like origin.
-        rlogger.warn("error replaying: {}", std::current_exception());
+        ex = std::current_exception();
+    }
+
+    co_await stop();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+}
+
+namespace db {
+
+// Replays the commitlog as a task manager task, so that the progress of
+// a long replay on startup can be followed. The progress is reported in
+// bytes of the segments replayed so far.
+class commitlog_replay_task_impl : public tasks::task_manager::task::impl {
+    commitlog_replayer::impl& _replayer;
+    std::vector<sstring> _files;
+    sstring _fname_prefix;
+    commitlog_replayer::impl::replay_progress _progress;
+protected:
+    virtual future<> run() override {
+        return _replayer.replay(std::move(_files), std::move(_fname_prefix), _progress);
+    }
+public:
+    commitlog_replay_task_impl(tasks::task_manager::module_ptr module,
+                               commitlog_replayer::impl& replayer,
+                               std::vector<sstring> files,
+                               sstring fname_prefix) noexcept
+        : tasks::task_manager::task::impl(module, tasks::task_id::create_random_id(), module->new_sequence_number(), "node", "", "", fname_prefix, tasks::task_id::create_null_id())
+        , _replayer(replayer)
+        , _files(std::move(files))
+        , _fname_prefix(std::move(fname_prefix))
+    {
+        _status.progress_units = "bytes";
+    }
+
+    virtual std::string type() const override {
+        return "commitlog_replay";
+    }
+
+    virtual future<tasks::task_manager::task::progress> get_progress() const override {
+        return make_ready_future<tasks::task_manager::task::progress>(tasks::task_manager::task::progress{
+            .completed = double(_progress.replayed_bytes),
+            .total = double(_progress.total_bytes),
+        });
     }
+};
+
 }
 
 db::commitlog_replayer::commitlog_replayer(seastar::sharded<replica::database>& db, seastar::sharded<db::system_keyspace>& sys_ks)
@@ -324,64 +569,16 @@ future<db::commitlog_replayer> db::commitlog_replayer::create_replayer(seastar::
     });
 }
 
-future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fname_prefix) {
-    typedef std::unordered_multimap<unsigned, sstring> shard_file_map;
-
-    rlogger.info("Replaying {}", fmt::join(files, ", "));
-
-    // pre-compute work per shard already.
-    auto map = ::make_lw_shared<shard_file_map>();
-    for (auto& f : files) {
-        commitlog::descriptor d(f, fname_prefix);
-        replay_position p = d;
-        map->emplace(p.shard_id() % smp::count, std::move(f));
+future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fname_prefix, tasks::task_manager::module_ptr module) {
+    if (!module) {
+        impl::replay_progress progress;
+        co_await _impl->replay(std::move(files), std::move(fname_prefix), progress);
+        co_return;
     }
-
-    return do_with(std::move(fname_prefix), [this, map] (sstring& fname_prefix) {
-        return _impl->start().then([this, map, &fname_prefix] {
-            return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
-                return smp::submit_to(id, [this, id, map, &fname_prefix] () {
-                    auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
-                    auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
-                        auto&f = p.second;
-                        rlogger.debug("Replaying {}", f);
-                        return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
-                            if (stats.corrupt_bytes != 0) {
-                                rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
-                            }
-                            if (stats.truncated_at != 0) {
-                                rlogger.warn("Truncated file: {} at position {}.", f, stats.truncated_at);
-                            }
-                            rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
-                                            , f
-                                            , stats.applied_mutations
-                                            , stats.invalid_mutations
-                                            , stats.skipped_mutations
-                            );
-                            *total += stats;
-                        });
-                    }).then([total] {
-                        return make_ready_future<impl::stats>(*total);
-                    });
-                });
-            }, impl::stats(), std::plus<impl::stats>()).then([](impl::stats totals) {
-                rlogger.info("Log replay complete, {} replayed mutations ({} invalid, {} skipped)"
-                                , totals.applied_mutations
-                                , totals.invalid_mutations
-                                , totals.skipped_mutations
-                );
-            });
-        }).finally([this] {
-            return _impl->stop();
-        });
-    });
+    auto task = co_await module->make_and_start_task<commitlog_replay_task_impl>({}, *_impl, std::move(files), std::move(fname_prefix));
+    co_await task->done();
 }
 
 future<> db::commitlog_replayer::recover(sstring f, sstring fname_prefix) {
     return recover(std::vector<sstring>{ f }, std::move(fname_prefix));
 }
-
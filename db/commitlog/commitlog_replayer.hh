@@ -14,6 +14,7 @@
 #include <seastar/core/sharded.hh>
 
 #include "seastarx.hh"
+#include "tasks/task_manager.hh"
 
 namespace replica {
 class database;
@@ -31,7 +32,8 @@ class commitlog_replayer {
 
     static future<commitlog_replayer> create_replayer(seastar::sharded<replica::database>&, seastar::sharded<db::system_keyspace>&);
 
-    future<> recover(std::vector<sstring> files, sstring fname_prefix);
+    // If the module is given, the replay runs as a task of it.
+    future<> recover(std::vector<sstring> files, sstring fname_prefix, tasks::task_manager::module_ptr module = nullptr);
     future<> recover(sstring file, sstring fname_prefix);
 
 private:
@@ -39,6 +41,8 @@ class commitlog_replayer {
 
     class impl;
     std::unique_ptr<impl> _impl;
+
+    friend class commitlog_replay_task_impl;
 };
 
 }
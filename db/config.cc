@@ -27,6 +27,8 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/bloom_filter_extension.hh"
+#include "db/cache_eviction_extension.hh"
 #include "db/tags/extension.hh"
 #include "config.hh"
 #include "extensions.hh"
@@ -365,6 +367,17 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
+    , memtable_flush_controller_target_backlog(this, "memtable_flush_controller_target_backlog", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the memtable flush controller adjusts the shares in a feedback loop to hold unspooled dirty memory at this fraction of the dirty memory threshold, instead of deriving them from the current amount alone.")
+    , compaction_controller_target_backlog(this, "compaction_controller_target_backlog", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller adjusts the shares in a feedback loop to hold the normalized compaction backlog (see the compaction_manager_normalized_backlog metric) at this value, instead of deriving them from the current backlog alone.")
+    , backlog_controller_proportional_gain(this, "backlog_controller_proportional_gain", liveness::LiveUpdate, value_status::Used, 0.2,
+        "Proportional gain of the feedback loop of the compaction and memtable flush controllers, see compaction_controller_target_backlog and memtable_flush_controller_target_backlog. "
+        "The gains relate the distance of the backlog from the target, relative to the target, to a correction of the shares, relative to the maximum shares of the controller.")
+    , backlog_controller_integral_gain(this, "backlog_controller_integral_gain", liveness::LiveUpdate, value_status::Used, 0.1,
+        "Integral gain (per second) of the feedback loop of the compaction and memtable flush controllers, see backlog_controller_proportional_gain.")
+    , backlog_controller_derivative_gain(this, "backlog_controller_derivative_gain", liveness::LiveUpdate, value_status::Used, 0,
+        "Derivative gain (in seconds) of the feedback loop of the compaction and memtable flush controllers, see backlog_controller_proportional_gain.")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold.")
     , compaction_flush_all_tables_before_major_seconds(this, "compaction_flush_all_tables_before_major_seconds", value_status::Used, 86400,
@@ -403,8 +416,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The directory where hints files are stored if hinted handoff is enabled.")
     , view_hints_directory(this, "view_hints_directory", value_status::Used, "",
         "The directory where materialized-view updates are stored while a view replica is unreachable.")
-    , saved_caches_directory(this, "saved_caches_directory", value_status::Unused, "",
-        "The directory location where table key and row caches are stored.")
+    , saved_caches_directory(this, "saved_caches_directory", value_status::Used, "",
+        "The directory location where the keys of cached partitions are saved on shutdown (see cache_keys_to_save), and where WebAssembly user-defined functions are kept precompiled across restarts.")
     /**
     * @Group Commonly used properties
     * @GroupDescription Properties most frequently used when configuring Scylla.
@@ -472,6 +485,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Throttles compaction to the specified total throughput across the entire system. The faster you insert data, the faster you need to compact in order to keep the SSTable count down. The recommended Value is 16 to 32 times the rate of write throughput (in MBs/second). Setting the value to 0 disables compaction throttling.\n"
         "\n"
         "Related information: Configuring compaction")
+    , compaction_subrange_parallelism(this, "compaction_subrange_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of token sub-ranges a single large major, cleanup, regular or off-strategy compaction job is split into. The sub-ranges are compacted concurrently, and their output replaces the input at once when all of them are done, so exhausted input sstables are not released early. Setting the value to 1 disables splitting.")
+    , compaction_subrange_min_size_in_mb(this, "compaction_subrange_min_size_in_mb", liveness::LiveUpdate, value_status::Used, 1024,
+        "Minimum amount of input data per sub-range when a compaction job is split into token sub-ranges.")
     , compaction_large_partition_warning_threshold_mb(this, "compaction_large_partition_warning_threshold_mb", liveness::LiveUpdate, value_status::Used, 1000,
         "Log a warning when writing partitions larger than this value.")
     , compaction_large_row_warning_threshold_mb(this, "compaction_large_row_warning_threshold_mb", liveness::LiveUpdate, value_status::Used, 10,
@@ -517,6 +534,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , failure_detector_timeout_in_ms(this, "failure_detector_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 20 * 1000, "Maximum time between two successful echo message before gossip mark a node down in milliseconds.\n")
     , direct_failure_detector_ping_timeout_in_ms(this, "direct_failure_detector_ping_timeout_in_ms", value_status::Used, 600, "Duration after which the direct failure detector aborts a ping message, so the next ping can start.\n"
         "Note: this failure detector is used by Raft, and is different from gossiper's failure detector (configured by `failure_detector_timeout_in_ms`).\n")
+    , direct_failure_detector_suspicion_threshold(this, "direct_failure_detector_suspicion_threshold", liveness::LiveUpdate, value_status::Used, 5,
+        "Suspicion level (phi) of a node, as computed by the direct failure detector from the intervals between its ping responses, "
+        "above which coordinators prefer other replicas for reads. The node is used only when there are not enough other replicas. "
+        "The level grows by 1 every ~2.3 mean response intervals without a response. Set to 0 to disable.\n")
     /**
     * @Group Performance tuning properties
     * @GroupDescription Tuning performance and system resource utilization, including commit log, compaction, memory, disk I/O, CPU, reads, and writes.
@@ -544,6 +565,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in ``batch`` mode.")
+    , commitlog_sync_batch_group_commit_window_in_us(this, "commitlog_sync_batch_group_commit_window_in_us", liveness::MustRestart, value_status::Used, 0,
+        "Group commit window, in microseconds, for ``batch`` mode. Writes arriving within the same window share a single sync, and windows are aligned across shards so that shards sharing a device sync together. 0 disables group commit and every write syncs as soon as the previous ones are done.")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
         "Total space used for commitlogs. If the used space goes above this value, Scylla rounds up to the next nearest segment multiple and flushes memtables to disk for the oldest commitlog segments, removing those log segments. This reduces the amount of data to replay on startup, and prevents infrequently-updated tables from indefinitely keeping commitlog segments. A small total commitlog space tends to cause more flush activity on less-active tables.\n"
         "\n"
@@ -555,8 +578,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Threshold for commitlog disk usage. When used disk space goes above this value, Scylla initiates flushes of memtables to disk for the oldest commitlog segments, removing those log segments. Adjusting this affects disk usage vs. write latency. Default is (approximately) commitlog_total_space_in_mb - <num shards>*commitlog_segment_size_in_mb.")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_preallocated_segments(this, "commitlog_preallocated_segments", liveness::MustRestart, value_status::Used, 0,
+        "Number of commitlog segments per shard to preallocate and keep ready in reserve. Segments are created (and, with commitlog_use_o_dsync, pre-written) in the background ahead of use, keeping file allocation off the write path during sustained bursts. Bounded by commitlog_total_space_in_mb. 0 (default) grows the reserve on demand.")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Used, true,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
+    , commitlog_segment_grouping(this, "commitlog_segment_grouping", liveness::MustRestart, value_status::Used, "none",
+        "How to group tables into separate commitlog segments. Segments of a group only hold data of the tables in the group, so they can be freed by flushing those tables only, without flushing the memtables of unrelated tables. Each extra group keeps one more segment per shard open.\n"
+        "* none: all tables write to the same segments.\n"
+        "* system: the tables of the system keyspaces write to segments of their own, apart from the user tables.")
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
@@ -587,8 +616,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , memtable_flush_queue_size(this, "memtable_flush_queue_size", value_status::Unused, 4,
         "The number of full memtables to allow pending flush (memtables waiting for a write thread). At a minimum, set to the maximum number of indexes created on a single table.\n"
         "Related information: Flushing data from the memtable")
-    , memtable_flush_writers(this, "memtable_flush_writers", value_status::Invalid, 1,
-        "Sets the number of memtable flush writer threads. These threads are blocked by disk I/O, and each one holds a memtable in memory while blocked. If you have a large Java heap size and many data directories, you can increase the value for better flush performance.")
+    , memtable_flush_writers(this, "memtable_flush_writers", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of token-range-disjoint sstables a memtable flush is split into, written concurrently so that the writers overlap each other's I/O waits. Only memtables large enough to give each writer a fair share of data are split. Each flush then produces more, smaller sstables for compaction to merge.")
     , memtable_heap_space_in_mb(this, "memtable_heap_space_in_mb", value_status::Unused, 0,
         "Total permitted memory to use for memtables. Triggers a flush based on memtable_cleanup_threshold. Cassandra stops accepting writes when the limit is exceeded until a flush completes. If unset, sets to default.")
     , memtable_offheap_space_in_mb(this, "memtable_offheap_space_in_mb", value_status::Unused, 0,
@@ -722,6 +751,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The time that the coordinator waits for read operations to complete")
     , counter_write_request_timeout_in_ms(this, "counter_write_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 5000,
         "The time that the coordinator waits for counter writes to complete.")
+    , counter_write_combining_window_in_ms(this, "counter_write_combining_window_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "The time in milliseconds that the leader replica of a counter partition collects increments of it, to apply them together with a single read-before-write. "
+        "Raises the throughput of hot counters, at the cost of adding up to this much latency to counter writes. 0 disables combining.")
     , cas_contention_timeout_in_ms(this, "cas_contention_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 1000,
         "The time that the coordinator continues to retry a CAS (compare and set) operation that contends with other proposals for the same row.")
     , truncate_request_timeout_in_ms(this, "truncate_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
@@ -755,6 +787,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "* all: All traffic is compressed.\n"
         "* dc: Traffic between data centers is compressed.\n"
         "* none: No compression.")
+    , internode_compression_bulk_data(this, "internode_compression_bulk_data", value_status::Used, false,
+        "Compress the traffic of streaming, repair and hints between all nodes, regardless of internode_compression. Useful when node operations are bound by network bandwidth. Only takes effect with peers which accept compression, i.e. have either option enabled.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
@@ -807,12 +841,20 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Enable or disable keepalive on client connections (CQL native, Redis and the maintenance socket).")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be chosen based on cache hit ratio.")
+    , adaptive_replica_selection(this, "adaptive_replica_selection", liveness::LiveUpdate, value_status::Used, true,
+        "When enabled, the coordinator tracks the latency and the number of outstanding reads of every replica, and sends reads to the replicas of a datacenter which are much slower than the fastest one (see dynamic_snitch_badness_threshold) only if the other replicas are not enough.")
     /**
     * @Group Advanced fault detection settings
     * @GroupDescription Settings to handle poorly performing or failing nodes.
     */
-    , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", value_status::Unused, 0,
-        "Sets the performance threshold for dynamically routing requests away from a poorly performing node. A value of 0.2 means Cassandra continues to prefer the static snitch values until the node response time is 20% worse than the best performing node. Until the threshold is reached, incoming client requests are statically routed to the closest replica (as determined by the snitch). Having requests consistently routed to a given replica can help keep a working set of data hot when read repair is less than 1.")
+    , speculative_retry_per_replica(this, "speculative_retry_per_replica", liveness::LiveUpdate, value_status::Used, true,
+        "When enabled, a read of a table with a PERCENTILE speculative_retry speculates when the replicas it waits for didn't answer by that percentile of their own latency over the last few seconds, as observed by the coordinator. The percentile of the table's coordinator read latency is used for replicas without enough recent reads.")
+    , speculative_retry_budget(this, "speculative_retry_budget", liveness::LiveUpdate, value_status::Used, 0.1,
+        "The fraction, between 0 and 1, of the reads that may send a speculative request, so that speculative retries cannot amplify the load when all replicas are slow. 1 means every read may speculate.")
+    , coalesce_concurrent_reads(this, "coalesce_concurrent_reads", liveness::LiveUpdate, value_status::Used, false,
+        "When enabled, a single-partition SELECT of a prepared statement which is executed while an identical one, with the same bound values and consistency level, is in progress on the same shard shares the result of that read instead of reading the same data again. Protects replicas from a thundering herd of clients reading a hot partition. Only reads with consistency level ONE or LOCAL_ONE are coalesced, as the shared read may have started before a write which the other read is expected to see.")
+    , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", liveness::LiveUpdate, value_status::Used, 0.5,
+        "Sets the performance threshold for dynamically routing reads away from a poorly performing node, when adaptive_replica_selection is enabled. A value of 0.2 means Scylla continues to prefer the static snitch values until the node's score, its read latency weighted by the number of reads it has outstanding, is 20% worse than the best performing node of the datacenter. Until the threshold is reached, reads are statically routed to the closest replica (as determined by the snitch). Having requests consistently routed to a given replica can help keep a working set of data hot in its cache.")
     , dynamic_snitch_reset_interval_in_ms(this, "dynamic_snitch_reset_interval_in_ms", value_status::Unused, 60000,
         "Time interval in milliseconds to reset all node scores, which allows a bad node to recover.")
     , dynamic_snitch_update_interval_in_ms(this, "dynamic_snitch_update_interval_in_ms", value_status::Unused, 100,
@@ -916,6 +958,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\n"
         "* priority_string: (Default: not set, use default) GnuTLS priority string controlling TLS algorithms used/allowed.\n"
         "* require_client_auth: (Default: false) Enables or disables certificate authentication.\n"
+        "* enable_session_tickets: (Default: false) Enables or disables TLS 1.3 session tickets, which let reconnecting clients resume their session without a full handshake.\n"
         "\n"
         "Related information: Client-to-node encryption")
     , alternator_encryption_options(this, "alternator_encryption_options", value_status::Used, {/*none*/},
@@ -948,8 +991,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , enable_repair_based_node_ops(this, "enable_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, true, "Set true to use enable repair based node operations instead of streaming based.")
     , allowed_repair_based_node_ops(this, "allowed_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, "replace,removenode,rebuild,bootstrap,decommission", "A comma separated list of node operations which are allowed to enable repair based node operations. The operations can be bootstrap, replace, removenode, decommission and rebuild.")
     , enable_compacting_data_for_streaming_and_repair(this, "enable_compacting_data_for_streaming_and_repair", liveness::LiveUpdate, value_status::Used, true, "Enable the compacting reader, which compacts the data for streaming and repair (load'n'stream included) before sending it to, or synchronizing it with peers. Can reduce the amount of data to be processed by removing dead data, but adds CPU overhead.")
+    , enable_file_stream(this, "enable_file_stream", liveness::LiveUpdate, value_status::Used, true, "Set true to stream tablets by sending the files of their sstables as-is, instead of reading and rewriting their data, when the sstables are fully contained in the tablet.")
     , repair_partition_count_estimation_ratio(this, "repair_partition_count_estimation_ratio", liveness::LiveUpdate, value_status::Used, 0.1,
         "Specify the fraction of partitions written by repair out of the total partitions. The value is currently only used for bloom filter estimation. Value is between 0 and 1.")
+    , enable_incremental_repair(this, "enable_incremental_repair", liveness::LiveUpdate, value_status::Used, false,
+        "Set true to mark the sstables whose data was synchronized by a repair of all the replicas as repaired, and to have the following repairs read only the sstables that are not repaired yet. Whether a repair is incremental is decided by the repair master, once all the nodes support it. Repair-based node operations always read all the sstables.")
+    , tablet_repair_max_sessions_per_node(this, "tablet_repair_max_sessions_per_node", value_status::Used, 0,
+        "The maximum number of tablet repairs started by this node that a single node takes part in at the same time. Every shard of this node repairs its tablets one at a time, so without a limit all of them may repair tablets with replicas on the same node while other nodes are idle. 0 means no limit.")
     , ring_delay_ms(this, "ring_delay_ms", value_status::Used, 30 * 1000, "Time a node waits to hear from other nodes before joining the ring in milliseconds. Same as -Dcassandra.ring_delay_ms in cassandra.")
     , shadow_round_ms(this, "shadow_round_ms", value_status::Used, 300 * 1000, "The maximum gossip shadow round time. Can be used to reduce the gossip feature check time during node boot up.")
     , fd_max_interval_ms(this, "fd_max_interval_ms", value_status::Used, 2 * 1000, "The maximum failure_detector interval time in milliseconds. Interval larger than the maximum will be ignored. Larger cluster may need to increase the default.")
@@ -960,6 +1008,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , force_gossip_generation(this, "force_gossip_generation", liveness::LiveUpdate, value_status::Used, -1 , "Force gossip to use the generation number provided by user.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step.")
+    , lsa_background_reserve_segments(this, "lsa_background_reserve_segments", value_status::Used, 0, "Number of free LSA segments the background reclaimer keeps in reserve by compacting in advance, so that allocations don't have to compact once new segments can't be allocated from system memory. The background reclaimer already keeps enough system memory free for new segments, unless allocation outpaces it, so the reserve is disabled by default (0).")
+    , lsa_transparent_huge_pages(this, "lsa_transparent_huge_pages", value_status::Used, false, "Advise the kernel to back the memory of LSA segments (row cache and memtables) with transparent huge pages, to reduce TLB misses. For explicitly reserved 2 MiB or 1 GiB pages, start with --hugepages instead; shard memory is NUMA-local unless --mbind is disabled.")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable.")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set.")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
@@ -974,12 +1024,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting.")
     , enable_node_aggregated_table_metrics(this, "enable_node_aggregated_table_metrics", value_status::Used, true, "Enable aggregated per node, per keyspace and per table metrics reporting, applicable if enable_keyspace_column_family_metrics is false.")
+    , detailed_table_metrics(this, "detailed_table_metrics", value_status::Used, {}, "Tables, given as keyspace.table, or keyspaces, given by name, which report per keyspace and per column family metrics, as with enable_keyspace_column_family_metrics, while the other tables only report the aggregated metrics. Applies to tables created or loaded after it is set.")
     , enable_sstable_data_integrity_check(this, "enable_sstable_data_integrity_check", value_status::Used, false, "Enable interposer which checks for integrity of every sstable write."
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , sstable_column_value_ranges(this, "sstable_column_value_ranges", liveness::LiveUpdate, value_status::Used, false,
+        "Record the smallest and the largest values of the fixed-size regular and static columns in the Scylla component of new sstables."
+        " They can be seen with scylla sstable dump-scylla-metadata.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling.")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building.")
+    , view_update_coalescing_window_in_us(this, "view_update_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "Writes to a base partition with materialized views which arrive within this window of each other are coalesced, so the view updates of all of them are generated with a single read of the base partition. "
+        "Each such write is delayed by up to the window. 0 disables coalescing.")
+    , view_building_concurrency(this, "view_building_concurrency", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of batches of base rows per shard whose view updates are generated and sent concurrently while building a view. "
+        "Build progress is saved once all the batches of a build step are done, and a step covers this many batches.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"md", "me"})
@@ -1009,12 +1069,18 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Start serializing reads after their collective memory consumption goes above $normal_limit * $multiplier.")
     , reader_concurrency_semaphore_kill_limit_multiplier(this, "reader_concurrency_semaphore_kill_limit_multiplier", liveness::LiveUpdate, value_status::Used, 4,
             "Start killing reads after their collective memory consumption goes above $normal_limit * $multiplier.")
+    , reader_concurrency_semaphore_shed_reads_past_deadline(this, "reader_concurrency_semaphore_shed_reads_past_deadline", liveness::LiveUpdate, value_status::Used, true,
+            "Reject user reads which have to queue for admission and, judging by the queue length and the recent admission wait, would be admitted only after their timeout. "
+            "The coordinator sees such reads failing with an overloaded replica error instead of timing out.")
     , maintenance_reader_concurrency_semaphore_count_limit(this, "maintenance_reader_concurrency_semaphore_count_limit", liveness::LiveUpdate, value_status::Used, 10,
             "Allow up to this many maintenance (e.g. streaming and repair) reads per shard to progress at the same time.")
     , twcs_max_window_count(this, "twcs_max_window_count", liveness::LiveUpdate, value_status::Used, 50,
             "The maximum number of compaction windows allowed when making use of TimeWindowCompactionStrategy. A setting of 0 effectively disables the restriction.")
     , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
             "Maximum amount of sstables to load in parallel during initialization. A higher number can lead to more memory consumption. You should not need to touch this.")
+    , defer_bloom_filter_loading_on_boot(this, "defer_bloom_filter_loading_on_boot", value_status::Used, false,
+            "Don't read the bloom filters of the sstables found during initialization, load them in the background once the sstables are opened instead. "
+            "This shortens the startup of nodes with many sstables, at the cost of single-partition reads touching more sstables until the filters are loaded.")
     , enable_3_1_0_compatibility_mode(this, "enable_3_1_0_compatibility_mode", value_status::Used, false,
         "Set to true if the cluster was initially installed from 3.1.0. If it was upgraded from an earlier version,"
         " or installed from a later version, leave this set to false. This adjusts the communication protocol to"
@@ -1027,6 +1093,21 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard", liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , batch_mutations_per_replica(this, "batch_mutations_per_replica", liveness::LiveUpdate, value_status::Used, true,
+        "Send the mutations of a multi-partition write (e.g. an unlogged batch) which go to the same replica in a single message, "
+        "instead of one message per mutation. Traced writes and writes forwarded through another datacenter are always sent one by one.")
+    , max_concurrent_partition_reads_per_query(this, "max_concurrent_partition_reads_per_query", liveness::LiveUpdate, value_status::Used, 64,
+        "Maximum number of partitions a coordinator reads at the same time for a query restricting the partition key with IN. "
+        "The partitions are read in order, and no more of them are read once the page or the LIMIT is filled.")
+    , read_repair_in_background(this, "read_repair_in_background", liveness::LiveUpdate, value_status::Used, false,
+        "On a digest mismatch, return the reconciled result without waiting for the repair writes, which are queued and written in the background. "
+        "This saves reads a write round trip, but a read at QUORUM may then be followed by another one at QUORUM returning the older value.")
+    , read_repair_in_background_queue_size_in_kb(this, "read_repair_in_background_queue_size_in_kb", liveness::LiveUpdate, value_status::Used, 8192,
+        "Maximum memory, in kilobytes, used by the repairs waiting in the background read repair queue of a shard, see read_repair_in_background. "
+        "Repairs of further partitions are dropped until the queue drains.")
+    , cql_slow_request_threshold_in_ms(this, "cql_slow_request_threshold_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "QUERY, EXECUTE and BATCH requests taking longer than this many milliseconds are logged by the cql_slow_request logger, with the statement, "
+        "the time spent waiting for admission and processing. Unlike the slow query log, this doesn't need tracing to be enabled. 0 disables it.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
             "Disable rewriting streams from cdc_streams_descriptions to cdc_streams_descriptions_v2. Should not be necessary, but the procedure is expensive and prone to failures; this config option is left as a backdoor in case some user requires manual intervention.")
     , strict_allow_filtering(this, "strict_allow_filtering", liveness::LiveUpdate, value_status::Used, strict_allow_filtering_default(), "Match Cassandra in requiring ALLOW FILTERING on slow queries. Can be true, false, or warn. When false, Scylla accepts some slow queries even without ALLOW FILTERING that Cassandra rejects. Warn is same as false, but with warning.")
@@ -1058,11 +1139,20 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , alternator_enforce_authorization(this, "alternator_enforce_authorization", value_status::Used, false, "Enforce checking the authorization header for every request in Alternator.")
     , alternator_write_isolation(this, "alternator_write_isolation", value_status::Used, "", "Default write isolation policy for Alternator.")
     , alternator_streams_time_window_s(this, "alternator_streams_time_window_s", value_status::Used, 10, "CDC query confidence window for alternator streams.")
+    , alternator_streams_get_records_max_wait_ms(this, "alternator_streams_get_records_max_wait_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "How long a GetRecords request which finds no new records may wait on a replica of the stream for new ones to be written, before returning "
+        "an empty response. Once a record is written, the request waits for it to leave the alternator_streams_time_window_s confidence window. "
+        "0 disables waiting.")
     , alternator_timeout_in_ms(this, "alternator_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
         "The server-side timeout for completing Alternator API requests.")
     , alternator_ttl_period_in_seconds(this, "alternator_ttl_period_in_seconds", value_status::Used,
         60*60*24,
         "The default period for Alternator's expiration scan. Alternator attempts to scan every table within that period.")
+    , alternator_ttl_index_max_items(this, "alternator_ttl_index_max_items", liveness::LiveUpdate, value_status::Used,
+        0,
+        "Maximum number of items per shard kept in Alternator's in-memory expiration index. Items written with an expiration time "
+        "are recorded in the index by the shard coordinating the write, and are deleted soon after they expire instead of waiting for the "
+        "next expiration scan. The scan is still needed for items which are not in the index, but its period can be made longer. 0 disables the index.")
     , alternator_describe_endpoints(this, "alternator_describe_endpoints", liveness::LiveUpdate, value_status::Used,
         "",
         "Overrides the behavior of Alternator's DescribeEndpoints operation. "
@@ -1105,6 +1195,18 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions. The amount of memory usable by index cache is limited with ``index_cache_fraction``.")
     , index_cache_fraction(this, "index_cache_fraction", liveness::LiveUpdate, value_status::Used, 0.2,
         "The maximum fraction of cache memory permitted for use by index cache. Clamped to the [0.0; 1.0] range. Must be small enough to not deprive the row cache of memory, but should be big enough to fit a large fraction of the index. The default value 0.2 means that at least 80\% of cache memory is reserved for the row cache, while at most 20\% is usable by the index cache.")
+    , cache_admission_filter(this, "cache_admission_filter", liveness::LiveUpdate, value_status::Used, false,
+        "Only populate the row cache with partitions read from SSTables if they are estimated to be read more often than the partitions recently evicted from it (TinyLFU admission). Protects the hot set of the cache from scans and other one-off reads that do not use BYPASS CACHE.")
+    , cache_compressed_tier_memory_fraction(this, "cache_compressed_tier_memory_fraction", liveness::LiveUpdate, value_status::Used, 0.0,
+        "The maximum fraction of shard memory used by the compressed tier of the row cache. When above 0, complete partitions which are about to be evicted from the row cache are kept in memory in LZ4-compressed form instead, and moved back into the row cache when read. Best suited for read-mostly tables, as partitions which are written to are dropped from the compressed tier. 0 disables the compressed tier.")
+    , cache_hot_partitions(this, "cache_hot_partitions", liveness::LiveUpdate, value_status::Used, 16,
+        "The maximum number of hot partitions tracked per shard. A sample of single-partition reads is used to find the partitions taking the most reads, which are listed in system.hot_partitions. Those taking at least one percent of the reads of the shard are pinned in the row cache, so that they are not evicted while they stay hot. 0 disables the detection.")
+    , query_result_cache_memory_fraction(this, "query_result_cache_memory_fraction", liveness::LiveUpdate, value_status::Used, 0.0,
+        "The fraction of the shard's memory used to cache the results of single-partition data queries, so that repeated queries of a partition which didn't change are answered without reading it again. Results are dropped on writes to their partition and on flushes, compactions and other changes of the table's sstables. 0 disables the cache.")
+    , cache_keys_to_save(this, "cache_keys_to_save", value_status::Used, 0,
+        "The maximum number of keys of the most recently used cached partitions saved per table and shard to saved_caches_directory on shutdown. On the next startup, the saved partitions are read in the background, which warms up the row cache and the sstable index caches, so that a restarted node serves reads with lower latency sooner. Only the keys are saved, not the data. 0 disables saving and warming up the cache.")
+    , cache_prewarm_partitions_per_second(this, "cache_prewarm_partitions_per_second", liveness::LiveUpdate, value_status::Used, 1000,
+        "The maximum number of saved partitions read per second and shard while warming up the cache on startup. See cache_keys_to_save. 0 means unthrottled.")
     , consistent_cluster_management(this, "consistent_cluster_management", value_status::Deprecated, true, "Use RAFT for cluster management and DDL.")
     , force_gossip_topology_changes(this, "force_gossip_topology_changes", value_status::Used, false, "Force gossip-based topology operations in a fresh cluster. Only the first node in the cluster must use it. The rest will fall back to gossip-based operations anyway. This option should be used only for testing.")
     , wasm_cache_memory_fraction(this, "wasm_cache_memory_fraction", value_status::Used, 0.01, "Maximum total size of all WASM instances stored in the cache as fraction of total shard memory.")
@@ -1115,6 +1217,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , wasm_udf_memory_limit(this, "wasm_udf_memory_limit", value_status::Used, 2*1024*1024, "How much memory each WASM UDF can allocate at most.")
     , relabel_config_file(this, "relabel_config_file", value_status::Used, "", "Optionally, read relabel config from file.")
     , object_storage_config_file(this, "object_storage_config_file", value_status::Used, "", "Optionally, read object-storage endpoints config from file.")
+    , object_storage_cache_directory(this, "object_storage_cache_directory", value_status::Used, "",
+        "The directory where blocks of sstables stored on object storage are cached. Should be on a fast local disk.")
+    , object_storage_cache_size_in_mb(this, "object_storage_cache_size_in_mb", value_status::Used, 0,
+        "The maximum size of the local disk cache of blocks of sstables stored on object storage, split evenly between shards. The least recently used blocks are evicted first, the cache is kept across restarts. 0 disables the cache, so every read of such sstables is a read from the object store.")
     , live_updatable_config_params_changeable_via_cql(this, "live_updatable_config_params_changeable_via_cql", liveness::MustRestart, value_status::Used, true, "If set to true, configuration parameters defined with LiveUpdate can be updated in runtime via CQL (by updating system.config virtual table), otherwise they can't.")
     , auth_superuser_name(this, "auth_superuser_name", value_status::Used, "",
         "Initial authentication super username. Ignored if authentication tables already contain a super user.")
@@ -1132,6 +1238,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
          "Allows target tablet size to be configured. Defaults to 5G (in bytes). Maintaining tablets at reasonable sizes is important to be able to " \
          "redistribute load. A higher value means tablet migration throughput can be reduced. A lower value may cause number of tablets to increase significantly, " \
          "potentially resulting in performance drawbacks.")
+    , target_tablet_ops_per_second(this, "target_tablet_ops_per_second", liveness::LiveUpdate, value_status::Used, 0,
+         "Allows tablets to be split when they are hot, not only when they are big. A table is split when the average rate of reads and writes served by " \
+         "a replica of its tablets exceeds this value, until its tablets have a replica on every shard, and merged only when the rate drops below a quarter " \
+         "of it. 0 (the default) disables load-based resizing.")
     , replication_strategy_warn_list(this, "replication_strategy_warn_list", liveness::LiveUpdate, value_status::Used, {locator::replication_strategy_type::simple}, "Controls which replication strategies to warn about when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , replication_strategy_fail_list(this, "replication_strategy_fail_list", liveness::LiveUpdate, value_status::Used, {}, "Controls which replication strategies are disallowed to be used when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , service_levels_interval(this, "service_levels_interval_ms", liveness::LiveUpdate, value_status::Used, 10000, "Controls how often service levels module polls configuration table")
@@ -1154,6 +1264,14 @@ db::config::config()
 db::config::~config()
 {}
 
+void db::config::add_bloom_filter_extension() {
+    _extensions->add_schema_extension<db::bloom_filter_extension>(db::bloom_filter_extension::NAME);
+}
+
+void db::config::add_cache_eviction_extension() {
+    _extensions->add_schema_extension<db::cache_eviction_extension>(db::cache_eviction_extension::NAME);
+}
+
 void db::config::add_cdc_extension() {
     _extensions->add_schema_extension<cdc::cdc_extension>(cdc::cdc_extension::NAME);
 }
@@ -1180,6 +1298,7 @@ void db::config::setup_directories() {
     maybe_in_workdir(hints_directory, "hints");
     maybe_in_workdir(view_hints_directory, "view_hints");
     maybe_in_workdir(saved_caches_directory, "saved_caches");
+    maybe_in_workdir(object_storage_cache_directory, "object_storage_cache");
 }
 
 void db::config::maybe_in_workdir(named_value<sstring>& to, const char* sub) {
@@ -1385,6 +1504,11 @@ future<> configure_tls_creds_builder(seastar::tls::credentials_builder& creds, d
     if (is_true(get_or_default(options, "require_client_auth", "false"))) {
         creds.set_client_auth(seastar::tls::client_auth::REQUIRE);
     }
+    // The ticket key is generated by the builder, so the credentials built
+    // from it on all shards accept each other's tickets.
+    if (is_true(get_or_default(options, "enable_session_tickets", "false"))) {
+        creds.set_session_resume_mode(seastar::tls::session_resume_mode::TLS13_SESSION_TICKET);
+    }
 
     auto cert = get_or_default(options, "certificate", db::config::get_conf_sub("scylla.crt").string());
     auto key = get_or_default(options, "keyfile", db::config::get_conf_sub("scylla.key").string());
@@ -136,6 +136,8 @@ class config final : public utils::config_file {
     ~config();
 
     // For testing only
+    void add_bloom_filter_extension();
+    void add_cache_eviction_extension();
     void add_cdc_extension();
     void add_per_partition_rate_limit_extension();
     void add_tags_extension();
@@ -172,6 +174,11 @@ class config final : public utils::config_file {
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
     named_value<float> compaction_static_shares;
+    named_value<float> memtable_flush_controller_target_backlog;
+    named_value<float> compaction_controller_target_backlog;
+    named_value<float> backlog_controller_proportional_gain;
+    named_value<float> backlog_controller_integral_gain;
+    named_value<float> backlog_controller_derivative_gain;
     named_value<bool> compaction_enforce_min_threshold;
     named_value<uint32_t> compaction_flush_all_tables_before_major_seconds;
     named_value<sstring> cluster_name;
@@ -193,6 +200,8 @@ class config final : public utils::config_file {
     named_value<bool> rpc_interface_prefer_ipv6;
     named_value<seed_provider_type> seed_provider;
     named_value<uint32_t> compaction_throughput_mb_per_sec;
+    named_value<uint32_t> compaction_subrange_parallelism;
+    named_value<uint32_t> compaction_subrange_min_size_in_mb;
     named_value<uint32_t> compaction_large_partition_warning_threshold_mb;
     named_value<uint32_t> compaction_large_row_warning_threshold_mb;
     named_value<uint32_t> compaction_large_cell_warning_threshold_mb;
@@ -207,16 +216,20 @@ class config final : public utils::config_file {
     named_value<uint32_t> phi_convict_threshold;
     named_value<uint32_t> failure_detector_timeout_in_ms;
     named_value<uint32_t> direct_failure_detector_ping_timeout_in_ms;
+    named_value<uint32_t> direct_failure_detector_suspicion_threshold;
     named_value<sstring> commitlog_sync;
     named_value<uint32_t> commitlog_segment_size_in_mb;
     named_value<uint32_t> schema_commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_sync_batch_group_commit_window_in_us;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
     named_value<int64_t> commitlog_flush_threshold_in_mb;
     named_value<bool> commitlog_use_o_dsync;
+    named_value<uint32_t> commitlog_preallocated_segments;
     named_value<bool> commitlog_use_hard_size_limit;
+    named_value<sstring> commitlog_segment_grouping;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -269,6 +282,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> range_request_timeout_in_ms;
     named_value<uint32_t> read_request_timeout_in_ms;
     named_value<uint32_t> counter_write_request_timeout_in_ms;
+    named_value<uint32_t> counter_write_combining_window_in_ms;
     named_value<uint32_t> cas_contention_timeout_in_ms;
     named_value<uint32_t> truncate_request_timeout_in_ms;
     named_value<uint32_t> write_request_timeout_in_ms;
@@ -277,6 +291,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
     named_value<sstring> internode_compression;
+    named_value<bool> internode_compression_bulk_data;
     named_value<bool> inter_dc_tcp_nodelay;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
@@ -294,6 +309,10 @@ class config final : public utils::config_file {
     named_value<bool> start_rpc;
     named_value<bool> rpc_keepalive;
     named_value<bool> cache_hit_rate_read_balancing;
+    named_value<bool> adaptive_replica_selection;
+    named_value<bool> speculative_retry_per_replica;
+    named_value<double> speculative_retry_budget;
+    named_value<bool> coalesce_concurrent_reads;
     named_value<double> dynamic_snitch_badness_threshold;
     named_value<uint32_t> dynamic_snitch_reset_interval_in_ms;
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
@@ -337,7 +356,10 @@ class config final : public utils::config_file {
     named_value<bool> enable_repair_based_node_ops;
     named_value<sstring> allowed_repair_based_node_ops;
     named_value<bool> enable_compacting_data_for_streaming_and_repair;
+    named_value<bool> enable_file_stream;
     named_value<double> repair_partition_count_estimation_ratio;
+    named_value<bool> enable_incremental_repair;
+    named_value<uint32_t> tablet_repair_max_sessions_per_node;
     named_value<uint32_t> ring_delay_ms;
     named_value<uint32_t> shadow_round_ms;
     named_value<uint32_t> fd_max_interval_ms;
@@ -348,6 +370,8 @@ class config final : public utils::config_file {
     named_value<int32_t> force_gossip_generation;
     named_value<std::vector<enum_option<experimental_features_t>>> experimental_features;
     named_value<size_t> lsa_reclamation_step;
+    named_value<size_t> lsa_background_reserve_segments;
+    named_value<bool> lsa_transparent_huge_pages;
     named_value<uint16_t> prometheus_port;
     named_value<sstring> prometheus_address;
     named_value<sstring> prometheus_prefix;
@@ -361,10 +385,14 @@ class config final : public utils::config_file {
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
     named_value<bool> enable_node_aggregated_table_metrics;
+    named_value<string_list> detailed_table_metrics;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
+    named_value<bool> sstable_column_value_ranges;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
+    named_value<uint32_t> view_update_coalescing_window_in_us;
+    named_value<uint32_t> view_building_concurrency;
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
@@ -380,9 +408,11 @@ class config final : public utils::config_file {
     named_value<uint64_t> max_memory_for_unlimited_query_hard_limit;
     named_value<uint32_t> reader_concurrency_semaphore_serialize_limit_multiplier;
     named_value<uint32_t> reader_concurrency_semaphore_kill_limit_multiplier;
+    named_value<bool> reader_concurrency_semaphore_shed_reads_past_deadline;
     named_value<int> maintenance_reader_concurrency_semaphore_count_limit;
     named_value<uint32_t> twcs_max_window_count;
     named_value<unsigned> initial_sstable_loading_concurrency;
+    named_value<bool> defer_bloom_filter_loading_on_boot;
     named_value<bool> enable_3_1_0_compatibility_mode;
     named_value<bool> enable_user_defined_functions;
     named_value<unsigned> user_defined_function_time_limit_ms;
@@ -390,6 +420,11 @@ class config final : public utils::config_file {
     named_value<unsigned> user_defined_function_contiguous_allocation_limit_bytes;
     named_value<uint32_t> schema_registry_grace_period;
     named_value<uint32_t> max_concurrent_requests_per_shard;
+    named_value<bool> batch_mutations_per_replica;
+    named_value<uint32_t> max_concurrent_partition_reads_per_query;
+    named_value<bool> read_repair_in_background;
+    named_value<uint32_t> read_repair_in_background_queue_size_in_kb;
+    named_value<uint32_t> cql_slow_request_threshold_in_ms;
     named_value<bool> cdc_dont_rewrite_streams;
     named_value<tri_mode_restriction> strict_allow_filtering;
     named_value<tri_mode_restriction> strict_is_not_null_in_views;
@@ -404,8 +439,10 @@ class config final : public utils::config_file {
     named_value<bool> alternator_enforce_authorization;
     named_value<sstring> alternator_write_isolation;
     named_value<uint32_t> alternator_streams_time_window_s;
+    named_value<uint32_t> alternator_streams_get_records_max_wait_ms;
     named_value<uint32_t> alternator_timeout_in_ms;
     named_value<double> alternator_ttl_period_in_seconds;
+    named_value<uint32_t> alternator_ttl_index_max_items;
     named_value<sstring> alternator_describe_endpoints;
 
     named_value<bool> abort_on_ebadf;
@@ -437,6 +474,12 @@ class config final : public utils::config_file {
 
     named_value<bool> cache_index_pages;
     named_value<double> index_cache_fraction;
+    named_value<bool> cache_admission_filter;
+    named_value<double> cache_compressed_tier_memory_fraction;
+    named_value<uint32_t> cache_hot_partitions;
+    named_value<double> query_result_cache_memory_fraction;
+    named_value<uint32_t> cache_keys_to_save;
+    named_value<uint32_t> cache_prewarm_partitions_per_second;
 
     named_value<bool> consistent_cluster_management;
     named_value<bool> force_gossip_topology_changes;
@@ -449,6 +492,8 @@ class config final : public utils::config_file {
     named_value<size_t> wasm_udf_memory_limit;
     named_value<sstring> relabel_config_file;
     named_value<sstring> object_storage_config_file;
+    named_value<sstring> object_storage_cache_directory;
+    named_value<uint64_t> object_storage_cache_size_in_mb;
     // wasm_udf_reserved_memory is static because the options in db::config
     // are parsed using seastar::app_template, while this option is used for
     // configuring the Seastar memory subsystem.
@@ -472,6 +517,7 @@ class config final : public utils::config_file {
 
     named_value<int> tablets_initial_scale_factor;
     named_value<uint64_t> target_tablet_size_in_bytes;
+    named_value<uint64_t> target_tablet_ops_per_second;
 
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_warn_list;
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_fail_list;
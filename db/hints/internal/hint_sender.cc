@@ -10,7 +10,9 @@
 #include "db/hints/internal/hint_sender.hh"
 
 // Seastar features.
+#include <algorithm>
 #include <exception>
+#include <utility>
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/file.hh>
@@ -281,76 +283,132 @@ future<> hint_sender::send_one_mutation(frozen_mutation_and_schema m) {
     return do_send_one_mutation(std::move(m), std::move(erm), std::move(natural_endpoints));
 }
 
-future<> hint_sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
-    return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
-        ctx_ptr->mark_hint_as_in_progress(rp);
+future<> hint_sender::add_hint_to_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    const size_t size = buf.size_bytes();
+    ctx_ptr->mark_hint_as_in_progress(rp);
 
-        // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
-        auto h = ctx_ptr->file_send_gate.hold();
-        (void)std::invoke([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
-            try {
-                auto m = this->get_mutation(ctx_ptr, buf);
-                gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
-
-                // The hint is too old - drop it.
-                //
-                // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
-                // (last_modification - manager::hints_timer_period) old.
-                if (const auto now = gc_clock::now().time_since_epoch(); now - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
-                    manager_logger.debug("send_hints(): the hint is too old, skipping it, "
-                        "secs since file last modification {}, gc_grace_sec {}, hints_flush_period {}",
-                        now - secs_since_file_mod, gc_grace_sec, manager::hints_flush_period);
-                    return make_ready_future<>();
-                }
+    std::optional<frozen_mutation_and_schema> m;
+    try {
+        m = get_mutation(ctx_ptr, buf);
+        gc_clock::duration gc_grace_sec = m->s->gc_grace_seconds();
+
+        // The hint is too old - drop it.
+        //
+        // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
+        // (last_modification - manager::hints_timer_period) old.
+        if (const auto now = gc_clock::now().time_since_epoch(); now - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+            manager_logger.debug("send_hints(): the hint is too old, skipping it, "
+                "secs since file last modification {}, gc_grace_sec {}, hints_flush_period {}",
+                now - secs_since_file_mod, gc_grace_sec, manager::hints_flush_period);
+            m.reset();
+        }
 
-                return this->send_one_mutation(std::move(m)).then([this, ctx_ptr] {
-                    ++this->shard_stats().sent;
-                }).handle_exception([this, ctx_ptr] (auto eptr) {
-                    manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
-                    ++this->shard_stats().send_errors;
-                    return make_exception_future<>(std::move(eptr));
-                });
-
-            // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
-            } catch (replica::no_such_column_family& e) {
-                manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (replica::no_such_keyspace& e) {
-                manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (no_column_mapping& e) {
-                manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
-                ++this->shard_stats().discarded;
-            } catch (...) {
-                auto eptr = std::current_exception();
-                manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
-                ++this->shard_stats().send_errors;
-                return make_exception_future<>(std::move(eptr));
+    // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
+    } catch (replica::no_such_column_family& e) {
+        manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
+        ++this->shard_stats().discarded;
+    } catch (replica::no_such_keyspace& e) {
+        manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
+        ++this->shard_stats().discarded;
+    } catch (no_column_mapping& e) {
+        manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
+        ++this->shard_stats().discarded;
+    } catch (...) {
+        manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, std::current_exception());
+        ++this->shard_stats().send_errors;
+        ctx_ptr->on_hint_send_failure(rp);
+        co_return;
+    }
+    if (!m) {
+        on_hint_sent(*ctx_ptr, rp);
+        co_return;
+    }
+
+    auto& batch = ctx_ptr->batch;
+    auto it = std::find_if(batch.begin(), batch.end(), [&m] (const send_one_file_ctx::batched_hint& h) {
+        return h.m.s->version() == m->s->version() && h.m.fm.key().equal(*m->s, m->fm.key());
+    });
+    if (it != batch.end()) {
+        if (!it->merged) {
+            it->merged = it->m.fm.unfreeze(it->m.s);
+        }
+        it->merged->apply(m->fm.unfreeze(m->s));
+        it->rps.push_back(rp);
+        it->size += size;
+    } else {
+        batch.push_back(send_one_file_ctx::batched_hint{
+            .m = std::move(*m),
+            .rps = {rp},
+            .size = size,
+        });
+    }
+    ++ctx_ptr->batch_hints;
+    ctx_ptr->batch_size += size;
+    if (ctx_ptr->batch_hints >= max_hints_per_replay_batch || ctx_ptr->batch_size >= max_replay_batch_size) {
+        co_await send_hint_batch(ctx_ptr);
+    }
+}
+
+future<> hint_sender::send_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr) {
+    auto batch = std::exchange(ctx_ptr->batch, {});
+    ctx_ptr->batch_hints = 0;
+    ctx_ptr->batch_size = 0;
+    for (auto& h : batch) {
+        if ((!draining() && ctx_ptr->segment_replay_failed) || !can_send()) {
+            for (auto rp : h.rps) {
+                ctx_ptr->on_hint_send_failure(rp);
             }
-            return make_ready_future<>();
-        }).then_wrapped([this, units = std::move(units), rp, ctx_ptr, h = std::move(h)] (future<>&& f) {
-            // Information about the error was already printed somewhere higher.
-            // We just need to account in the ctx that sending of this hint has failed.
+            continue;
+        }
+        co_await send_batched_hint(ctx_ptr, std::move(h));
+    }
+}
+
+future<> hint_sender::send_batched_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, send_one_file_ctx::batched_hint h) {
+    auto rps = std::move(h.rps);
+    if (h.merged) {
+        h.m.fm = freeze(*h.merged);
+        h.merged.reset();
+    }
+    return _resource_manager.get_send_units_for(h.size).then([this, ctx_ptr, m = std::move(h.m), rps] (auto units) mutable {
+        // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
+        auto gh = ctx_ptr->file_send_gate.hold();
+        (void)futurize_invoke([this, m = std::move(m)] () mutable {
+            return this->send_one_mutation(std::move(m));
+        }).then_wrapped([this, units = std::move(units), rps = std::move(rps), ctx_ptr, gh = std::move(gh)] (future<>&& f) {
+            // A hint counts as sent, or failed, together with all the hints merged into it.
             if (!f.failed()) {
-                ctx_ptr->on_hint_send_success(rp);
-                auto new_bound = ctx_ptr->get_replayed_bound();
-                // Segments from other shards are replayed first and are considered to be "before" replay position 0.
-                // Update the sent upper bound only if it is a local segment.
-                if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
-                    _sent_upper_bound_rp = new_bound;
-                    notify_replay_waiters();
+                this->shard_stats().sent += rps.size();
+                for (auto rp : rps) {
+                    on_hint_sent(*ctx_ptr, rp);
                 }
             } else {
-                ctx_ptr->on_hint_send_failure(rp);
+                manager_logger.trace("send_batched_hint(): failed to send to {}: {}", end_point_key(), f.get_exception());
+                ++this->shard_stats().send_errors;
+                for (auto rp : rps) {
+                    ctx_ptr->on_hint_send_failure(rp);
+                }
             }
-            f.ignore_ready_future();
         });
-    }).handle_exception([ctx_ptr, rp] (auto eptr) {
+    }).handle_exception([ctx_ptr, rps] (auto eptr) {
         manager_logger.trace("send_one_file(): Hmmm. Something bad had happened: {}", eptr);
-        ctx_ptr->on_hint_send_failure(rp);
+        for (auto rp : rps) {
+            ctx_ptr->on_hint_send_failure(rp);
+        }
     });
 }
 
+void hint_sender::on_hint_sent(send_one_file_ctx& ctx, db::replay_position rp) noexcept {
+    ctx.on_hint_send_success(rp);
+    auto new_bound = ctx.get_replayed_bound();
+    // Segments from other shards are replayed first and are considered to be "before" replay position 0.
+    // Update the sent upper bound only if it is a local segment.
+    if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
+        _sent_upper_bound_rp = new_bound;
+        notify_replay_waiters();
+    }
+}
+
 void hint_sender::notify_replay_waiters() noexcept {
     if (!_foreign_segments_to_replay.empty()) {
         manager_logger.trace("[{}] notify_replay_waiters(): not notifying because there are still {} foreign segments to replay", end_point_key(), _foreign_segments_to_replay.size());
@@ -495,7 +553,7 @@ bool hint_sender::send_one_file(const sstring& fname) {
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
                 } else {
-                    co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
+                    co_await add_hint_to_batch(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
                     break;
                 }
             };
@@ -509,6 +567,9 @@ bool hint_sender::send_one_file(const sstring& fname) {
         ctx_ptr->segment_replay_failed = true;
     }
 
+    // send what's left in the last batch, or fail it if the segment replay already failed
+    send_hint_batch(ctx_ptr).get();
+
     // wait till all background hints sending is complete
     ctx_ptr->file_send_gate.close().get();
 
@@ -25,6 +25,7 @@
 #include "gms/inet_address.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
 #include "schema/schema.hh"
 #include "utils/fragmented_temporary_buffer.hh"
 #include "enum_set.hh"
@@ -36,6 +37,7 @@
 #include <optional>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace service {
 class storage_proxy;
@@ -85,6 +87,19 @@ class hint_sender {
         std::set<db::replay_position> in_progress_rps;
         bool segment_replay_failed = false;
 
+        // Hints of the current replay batch with the same target partition, merged.
+        struct batched_hint {
+            frozen_mutation_and_schema m;
+            // Once another hint is merged, the hints are accumulated here, and
+            // m is only frozen again when the batch is sent.
+            std::optional<mutation> merged;
+            std::vector<db::replay_position> rps;
+            size_t size;
+        };
+        std::vector<batched_hint> batch;
+        size_t batch_hints = 0;
+        size_t batch_size = 0;
+
         void mark_hint_as_in_progress(db::replay_position rp);
         void on_hint_send_success(db::replay_position rp) noexcept;
         void on_hint_send_failure(db::replay_position rp) noexcept;
@@ -94,6 +109,12 @@ class hint_sender {
     };
 
 private:
+    // Hints read from a segment are replayed in batches of at most that many
+    // hints or bytes. The hints of a batch that target the same partition are
+    // merged and sent as a single mutation.
+    static constexpr size_t max_hints_per_replay_batch = 128;
+    static constexpr size_t max_replay_batch_size = 1024 * 1024;
+
     std::list<sstring> _segments_to_replay;
     // Segments to replay which were not created on this shard but were moved during rebalancing
     std::list<sstring> _foreign_segments_to_replay;
@@ -194,19 +215,37 @@ class hint_sender {
 
     bool replay_allowed() const noexcept;
 
-    /// \brief Try to send one hint read from the file.
-    ///  - Limit the maximum memory size of hints "in the air" and the maximum total number of hints "in the air".
+    /// \brief Add one hint read from the file to the replay batch, and send the batch once it is full.
     ///  - Discard the hints that are older than the grace seconds value of the corresponding table.
-    ///
-    /// If sending fails we are going to set the state::segment_replay_failed in the _state and _first_failed_rp will be updated to min(_first_failed_rp, \ref rp).
+    ///  - Merge the hint into the batched hint for the same partition, if there is one.
     ///
     /// \param ctx_ptr shared pointer to the file sending context
     /// \param buf buffer representing the hint
     /// \param rp replay position of this hint in the file (see commitlog for more details on "replay position")
     /// \param secs_since_file_mod last modification time stamp (in seconds since Epoch) of the current hints file
     /// \param fname name of the hints file this hint was read from
+    /// \return future that resolves when next hint may be read
+    future<> add_hint_to_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+    /// \brief Send the hints of the replay batch, and empty it.
+    ///
+    /// If the segment replay already failed, or the destination can no longer
+    /// be sent to, the hints of the batch are failed instead.
+    future<> send_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr);
+
+    /// \brief Try to send one batched hint.
+    ///  - Limit the maximum memory size of hints "in the air" and the maximum total number of hints "in the air".
+    ///
+    /// If sending fails we are going to set the state::segment_replay_failed in the _state and _first_failed_rp will be updated
+    /// to min(_first_failed_rp, the replay positions of the merged hints).
+    ///
+    /// \param ctx_ptr shared pointer to the file sending context
+    /// \param h the batched hint
     /// \return future that resolves when next hint may be sent
-    future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+    future<> send_batched_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, send_one_file_ctx::batched_hint h);
+
+    /// \brief Account for a hint which was sent, or doesn't have to be.
+    void on_hint_sent(send_one_file_ctx& ctx, db::replay_position rp) noexcept;
 
     /// \brief Send all hint from a single file and delete it after it has been successfully sent.
     /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
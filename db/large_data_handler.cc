@@ -41,6 +41,7 @@ future<large_data_handler::partition_above_threshold> large_data_handler::maybe_
     static_assert(std::is_same_v<decltype(above_threshold.size), bool>);
     _stats.partitions_bigger_than_threshold += above_threshold.size; // increment if true
     if (above_threshold.size || above_threshold.rows) [[unlikely]] {
+        note_large_partition(sst, key, partition_size, rows);
         return with_sem([&sst, &key, partition_size, rows, range_tombstones, dead_rows, this] {
             return record_large_partitions(sst, key, partition_size, rows, range_tombstones, dead_rows);
         }).then([above_threshold] {
@@ -74,6 +75,36 @@ template <typename T> static std::string key_to_str(const T& key, const schema&
     return fmt::to_string(key.with_schema(s));
 }
 
+void large_data_handler::note_large_partition(const sstables::sstable& sst, const sstables::key& key, uint64_t partition_size, uint64_t rows) noexcept {
+    try {
+        const schema& s = *sst.get_schema();
+        auto key_str = key_to_str(key.to_partition_key(s), s);
+        auto it = std::ranges::find_if(_large_partitions, [&] (const large_partition& lp) {
+            return lp.table == s.id() && lp.key == key_str;
+        });
+        if (it == _large_partitions.end()) {
+            auto lp = large_partition{
+                .table = s.id(),
+                .keyspace_name = s.ks_name(),
+                .table_name = s.cf_name(),
+                .key = std::move(key_str),
+            };
+            if (_large_partitions.size() < max_large_partitions) {
+                it = _large_partitions.insert(it, std::move(lp));
+            } else {
+                it = std::ranges::min_element(_large_partitions, std::less<>(), &large_partition::written_bytes);
+                *it = std::move(lp);
+            }
+        }
+        it->size = partition_size;
+        it->rows = rows;
+        it->writes++;
+        it->written_bytes += partition_size;
+    } catch (...) {
+        large_data_logger.warn("Failed to remember large partition of {}.{}: {}", sst.get_schema()->ks_name(), sst.get_schema()->cf_name(), std::current_exception());
+    }
+}
+
 sstring large_data_handler::sst_filename(const sstables::sstable& sst) {
     return sst.component_basename(sstables::component_type::Data);
 }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 #include "schema/schema_fwd.hh"
 #include "system_keyspace.hh"
 #include "sstables/shared_sstable.hh"
@@ -29,6 +30,20 @@ class large_data_handler {
         int64_t partitions_bigger_than_threshold = 0; // number of large partition updates exceeding threshold_bytes
     };
 
+    // A partition which was written to sstables above the partition size or rows count threshold, see large_partitions().
+    struct large_partition {
+        table_id table;
+        sstring keyspace_name;
+        sstring table_name;
+        sstring key;
+        uint64_t size = 0; // In the sstable it was last written to
+        uint64_t rows = 0; // In the sstable it was last written to
+        uint64_t writes = 0; // Number of sstables it was written to, by memtable flushes and compactions
+        uint64_t written_bytes = 0; // Sum of its sizes in those sstables
+    };
+
+    static constexpr size_t max_large_partitions = 256;
+
 private:
     // Assuming:
     // * there is at most one log entry every 1MB
@@ -54,6 +69,10 @@ class large_data_handler {
 
     bool _running = false;
 
+    std::vector<large_partition> _large_partitions;
+
+    void note_large_partition(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) noexcept;
+
 protected:
     uint64_t _partition_threshold_bytes;
     uint64_t _row_threshold_bytes;
@@ -111,6 +130,12 @@ class large_data_handler {
 
     future<> maybe_delete_large_data_entries(sstables::shared_sstable sst);
 
+    // The large partitions written on this shard since it started, at most max_large_partitions of them.
+    // When full, the partition with the least written bytes is forgotten to make room for a new one.
+    // Unlike system.large_partitions, entries are not removed when the sstables are deleted:
+    // the number of times a partition is rewritten is what makes it expensive to keep.
+    const std::vector<large_partition>& large_partitions() const noexcept { return _large_partitions; }
+
     const large_data_handler::stats& stats() const { return _stats; }
 
     uint64_t get_partition_threshold_bytes() const noexcept {
@@ -17,6 +17,7 @@ namespace db {
 
 const char* per_partition_rate_limit_options::max_writes_per_second_key = "max_writes_per_second";
 const char* per_partition_rate_limit_options::max_reads_per_second_key = "max_reads_per_second";
+const char* per_partition_rate_limit_options::counting_key = "counting";
 
 per_partition_rate_limit_options::per_partition_rate_limit_options(std::map<sstring, sstring> map) {
     auto handle_uint32_arg = [&] (const char* key) -> std::optional<uint32_t> {
@@ -42,6 +43,19 @@ per_partition_rate_limit_options::per_partition_rate_limit_options(std::map<sstr
     _max_writes_per_second = handle_uint32_arg(max_writes_per_second_key);
     _max_reads_per_second = handle_uint32_arg(max_reads_per_second_key);
 
+    if (auto it = map.find(counting_key); it != map.end()) {
+        if (it->second == "hash_table") {
+            _counting = counting_mode::hash_table;
+        } else if (it->second == "sketch") {
+            _counting = counting_mode::sketch;
+        } else {
+            throw exceptions::configuration_exception(format(
+                    "Invalid value for {} option: expected 'hash_table' or 'sketch'",
+                    counting_key));
+        }
+        map.erase(it);
+    }
+
     if (!map.empty()) {
         throw exceptions::configuration_exception(format(
                 "Unknown keys in map for per_partition_rate_limit extension: {}",
@@ -57,6 +71,10 @@ std::map<sstring, sstring> per_partition_rate_limit_options::to_map() const {
     if (_max_reads_per_second) {
         ret.insert_or_assign(max_reads_per_second_key, std::to_string(*_max_reads_per_second));
     }
+    // Only stored when it differs from the default, so that the map of existing tables stays the same
+    if (_counting == counting_mode::sketch) {
+        ret.insert_or_assign(counting_key, "sketch");
+    }
     return ret;
 }
 
@@ -20,13 +20,27 @@ using namespace seastar;
 namespace db {
 
 class per_partition_rate_limit_options final {
+public:
+    // How the rate limiter counts the operations on the partitions of the table.
+    enum class counting_mode {
+        // Exact counters for the hottest partitions, kept in a shared hash table.
+        // Partitions which don't fit into the table are not limited.
+        hash_table,
+        // Approximate counters kept in a fixed-size count-min sketch. Every
+        // partition is accounted, at the cost of occasionally overestimating
+        // the rate of a cold partition.
+        sketch,
+    };
+
 private:
     static const char* max_writes_per_second_key;
     static const char* max_reads_per_second_key;
+    static const char* counting_key;
 
 private:
     std::optional<uint32_t> _max_writes_per_second;
     std::optional<uint32_t> _max_reads_per_second;
+    counting_mode _counting = counting_mode::hash_table;
 
 public:
     per_partition_rate_limit_options() = default;
@@ -59,6 +73,14 @@ class per_partition_rate_limit_options final {
     inline std::optional<uint32_t> get_max_reads_per_second() const {
         return _max_reads_per_second;
     }
+
+    inline void set_counting_mode(counting_mode v) {
+        _counting = v;
+    }
+
+    inline counting_mode get_counting_mode() const {
+        return _counting;
+    }
 };
 
 }
@@ -39,6 +39,12 @@
 // time window. This strategy is also known as "lossy counting".
 //
 // Both mechanisms 1) and 2) are implemented in a lazy manner.
+//
+// Tables can choose to be counted in a count-min sketch instead. The sketch
+// has a fixed size and never fails to account an operation, so it can't be
+// flooded by operations on many distinct partitions, but it may overestimate
+// the counters due to collisions. It is halved on time window change, just
+// like the hashmap, and doesn't need lossy counting.
 
 namespace db {
 
@@ -46,6 +52,10 @@ static constexpr size_t hash_bits = 16;
 static constexpr size_t entry_count = 1 << hash_bits;
 static constexpr size_t bucket_size = 10000;
 
+static constexpr size_t sketch_width_bits = 14;
+static constexpr size_t sketch_width = 1 << sketch_width_bits;
+static constexpr size_t sketch_depth = 4;
+
 
 void rate_limiter_base::on_timer() noexcept {
     _time_window_history.pop_back();
@@ -60,6 +70,10 @@ void rate_limiter_base::on_timer() noexcept {
 
     _current_time_window = (_current_time_window + 1) % (1 << time_window_bits);
 
+    for (auto& c : _sketch) {
+        c /= 2;
+    }
+
     // Because time window ids are 12 bit numbers and we increase the current
     // time window number by 1 every second, it wraps around every 4096
     // seconds (more than an hour). Because of this, some very old entry
@@ -192,6 +206,32 @@ bool rate_limiter_base::entry_is_empty(const rate_limiter_base::entry& b) noexce
     return b.op_count <= _current_bucket;
 }
 
+uint64_t rate_limiter_base::sketch_increase_and_get_counter(uint32_t label, uint64_t token) noexcept {
+    ++_metrics.sketch_lookups;
+
+    // Derive the index in each row from the two halves of a single hash
+    // (Kirsch-Mitzenmacher). The label is mixed into the hash in the same
+    // way as for the hashmap.
+    const size_t hash = compute_hash(label, token);
+    const uint32_t h1 = hash;
+    const uint32_t h2 = (hash >> 32) | 1;
+
+    std::array<uint32_t*, sketch_depth> counters;
+    uint32_t min = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < sketch_depth; i++) {
+        counters[i] = &_sketch[i * sketch_width + (h1 + i * h2) % sketch_width];
+        min = std::min(min, *counters[i]);
+    }
+
+    // Conservative update: only the counters which hold the estimate are
+    // increased, which reduces the overestimation caused by collisions.
+    const uint32_t count = std::min<uint32_t>((1 << op_count_bits) - 1, min + 1);
+    for (auto* c : counters) {
+        *c = std::max(*c, count);
+    }
+    return count;
+}
+
 void rate_limiter_base::register_metrics() {
     namespace sm = seastar::metrics;
 
@@ -211,6 +251,9 @@ void rate_limiter_base::register_metrics() {
         sm::make_counter("probe_count", _metrics.probe_count,
                 sm::description("Number of probes made during lookups.")),
 
+        sm::make_counter("sketch_lookups", _metrics.sketch_lookups,
+                sm::description("Number of operations accounted in the count-min sketch.")),
+
         sm::make_gauge("load_factor", [&] {
                     uint32_t occupied_entry_count = _current_entries_in_time_window;
                     for (const auto& twe : _time_window_history) {
@@ -225,17 +268,22 @@ void rate_limiter_base::register_metrics() {
 rate_limiter_base::rate_limiter_base()
         : _salt(std::random_device{}())
         , _entries(entry_count)
-        , _time_window_history(op_count_bits - 1) {
-    
+        , _time_window_history(op_count_bits - 1)
+        , _sketch(sketch_depth * sketch_width) {
+
     register_metrics();
 }
 
-uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) noexcept {
+uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token, counting_mode mode) noexcept {
     // Assign a label if not done yet
     if (l._label == 0) {
         l._label = _next_label++;
     }
 
+    if (mode == counting_mode::sketch) {
+        return sketch_increase_and_get_counter(l._label, token);
+    }
+
     entry* b = get_entry(l._label, token);
     if (!b) {
         // We failed to allocate a entry for this partition. This means that
@@ -261,14 +309,15 @@ uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) n
 
 rate_limiter_base::can_proceed rate_limiter_base::account_operation(
         label& l, uint64_t token, uint64_t limit,
-        const db::per_partition_rate_limit::info& rate_limit_info) noexcept {
+        const db::per_partition_rate_limit::info& rate_limit_info,
+        counting_mode mode) noexcept {
 
     if (std::holds_alternative<std::monostate>(rate_limit_info)) {
         // Rate limiting turned off
         return can_proceed::yes;
     }
 
-    const uint64_t count = increase_and_get_counter(l, token);
+    const uint64_t count = increase_and_get_counter(l, token, mode);
 
     if (auto* info = std::get_if<db::per_partition_rate_limit::account_and_enforce>(&rate_limit_info)) {
         // On each time window change we halve the entry counts, therefore
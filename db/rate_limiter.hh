@@ -25,6 +25,7 @@
 
 #include "utils/chunked_vector.hh"
 #include "db/per_partition_rate_limit_info.hh"
+#include "db/per_partition_rate_limit_options.hh"
 
 // A data structure used to implement per-partition rate limiting. It accounts
 // operations and enforces limits when it is detected that the operation rate
@@ -43,6 +44,7 @@ class rate_limiter_base {
         uint64_t successful_lookups = 0;
         uint64_t failed_allocations = 0;
         uint64_t probe_count = 0;
+        uint64_t sketch_lookups = 0;
     };
 
     // Represents a piece of the hashmap storage.
@@ -81,6 +83,8 @@ class rate_limiter_base {
     struct can_proceed_tag{};
     using can_proceed = seastar::bool_class<can_proceed_tag>;
 
+    using counting_mode = per_partition_rate_limit_options::counting_mode;
+
     // Identifies a type of operation which is counted separately from other
     // operations. For example, reads and writes for given table should have
     // separate labels.
@@ -106,6 +110,10 @@ class rate_limiter_base {
     utils::chunked_vector<entry> _entries;
     std::vector<time_window_entry> _time_window_history;
 
+    // Count-min sketch used by counting_mode::sketch, `sketch_depth` rows
+    // of counters stored one after another.
+    utils::chunked_vector<uint32_t> _sketch;
+
     metrics _metrics;
     seastar::metrics::metric_groups _metric_group;
 
@@ -116,6 +124,8 @@ class rate_limiter_base {
     void entry_refresh(entry& b) noexcept;
     bool entry_is_empty(const entry& b) noexcept;
 
+    uint64_t sketch_increase_and_get_counter(uint32_t label, uint64_t token) noexcept;
+
     void register_metrics();
 
 protected:
@@ -133,7 +143,7 @@ class rate_limiter_base {
     // (For testing purposes only)
     // Increments the counter for given (label, token) and returns
     // the new value of the counter.
-    uint64_t increase_and_get_counter(label& l, uint64_t token) noexcept;
+    uint64_t increase_and_get_counter(label& l, uint64_t token, counting_mode mode = counting_mode::hash_table) noexcept;
 
     // Increments the counter for given (label, token).
     // If the counter indicates that the partition is over the limit,
@@ -146,7 +156,8 @@ class rate_limiter_base {
     // The probability is calculated in such a way that statistically
     // only `limit` operations per second are admitted.
     can_proceed account_operation(label& l, uint64_t token, uint64_t limit,
-            const db::per_partition_rate_limit::info& rate_limit_info) noexcept;
+            const db::per_partition_rate_limit::info& rate_limit_info,
+            counting_mode mode = counting_mode::hash_table) noexcept;
 };
 
 template<typename ClockType>
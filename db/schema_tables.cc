@@ -836,6 +836,101 @@ future<table_schema_version> calculate_schema_digest(distributed<service::storag
     return calculate_schema_digest(proxy, features, std::not_fn(&is_system_keyspace));
 }
 
+namespace {
+
+// Records the input of the digest instead of hashing it.
+class schema_digest_recorder : public hasher {
+    bytes_ostream& _out;
+    bool _failed = false;
+public:
+    explicit schema_digest_recorder(bytes_ostream& out) : _out(out) {}
+
+    virtual void update(const char* ptr, size_t size) noexcept override {
+        try {
+            _out.write(ptr, size);
+        } catch (...) {
+            _failed = true;
+        }
+    }
+
+    void check() const {
+        if (_failed) {
+            throw std::bad_alloc();
+        }
+    }
+};
+
+}
+
+static void record_schema_digest_input(schema_digest_cache::partitions_type& partitions, const mutation& m, schema_features features) {
+    if (diff_logger.is_enabled(logging::log_level::trace)) {
+        md5_hasher h;
+        feed_hash_for_schema_digest(h, m, features);
+        diff_logger.trace("Digest {} for {}, compacted={}", h.finalize(), m, compact_for_schema_digest(m));
+    }
+    bytes_ostream input;
+    schema_digest_recorder recorder(input);
+    feed_hash_for_schema_digest(recorder, m, features);
+    recorder.check();
+    partitions.insert_or_assign(m.decorated_key(), std::move(input));
+}
+
+// Same as calculate_schema_digest(proxy, features), but reuses the digest input of partitions
+// cached by the previous call, except for those of changed_keyspaces, which are re-read.
+// All partitions are re-read when the cache is empty or was filled with different features.
+static future<table_schema_version> calculate_schema_digest(distributed<service::storage_proxy>& proxy, schema_features features,
+        schema_digest_cache& cache, const std::set<sstring>& changed_keyspaces) {
+    if (cache.features && cache.features->mask() != features.mask()) {
+        cache.invalidate();
+    }
+    auto& db = proxy.local().get_db();
+    auto hash = md5_hasher();
+    try {
+        for (auto& table : all_table_names(features)) {
+            auto s = db.local().find_schema(NAME, table);
+            auto [it, inserted] = cache.tables.try_emplace(table, dht::decorated_key::less_comparator(s));
+            auto& partitions = it->second;
+            if (inserted) {
+                auto rs = co_await db::system_keyspace::query_mutations(db, NAME, table);
+                for (auto&& p : rs->partitions()) {
+                    auto mut = co_await unfreeze_gently(p.mut(), s);
+                    auto partition_key = value_cast<sstring>(utf8_type->deserialize(mut.key().get_component(*s, 0)));
+                    if (is_system_keyspace(partition_key)) {
+                        continue;
+                    }
+                    record_schema_digest_input(partitions, redact_columns_for_missing_features(std::move(mut), features), features);
+                }
+            } else {
+                for (auto& keyspace_name : changed_keyspaces) {
+                    if (is_system_keyspace(keyspace_name)) {
+                        continue;
+                    }
+                    auto dk = dht::decorate_key(*s, partition_key::from_singular(*s, keyspace_name));
+                    partitions.erase(dk);
+                    auto range = dht::partition_range::make_singular(dk);
+                    auto rs = co_await db::system_keyspace::query_mutations(db, NAME, table, range);
+                    for (auto&& p : rs->partitions()) {
+                        auto mut = co_await unfreeze_gently(p.mut(), s);
+                        record_schema_digest_input(partitions, redact_columns_for_missing_features(std::move(mut), features), features);
+                    }
+                }
+            }
+            for (auto& [dk, input] : partitions) {
+                for (bytes_view fragment : input) {
+                    hash.update(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+                }
+                co_await coroutine::maybe_yield();
+            }
+        }
+    } catch (...) {
+        // The cache may be left partially updated
+        cache.invalidate();
+        throw;
+    }
+    cache.features = features;
+    co_return utils::UUID_gen::get_name_UUID(hash.finalize());
+}
+
 future<std::vector<canonical_mutation>> convert_schema_to_mutations(distributed<service::storage_proxy>& proxy, schema_features features)
 {
     auto map = [&proxy, features] (sstring table) -> future<std::vector<canonical_mutation>> {
@@ -977,9 +1072,17 @@ static future<> with_merge_lock(noncopyable_function<future<> ()> func) {
     }
 }
 
+// changed_keyspaces are the keyspaces whose schema may have changed since the previous call,
+// the schema digest is calculated from scratch if it is not given.
 static
-future<> update_schema_version_and_announce(sharded<db::system_keyspace>& sys_ks, distributed<service::storage_proxy>& proxy, schema_features features, std::optional<table_schema_version> version_from_group0) {
-    auto uuid = version_from_group0 ? *version_from_group0 : co_await calculate_schema_digest(proxy, features);
+future<> update_schema_version_and_announce(sharded<db::system_keyspace>& sys_ks, distributed<service::storage_proxy>& proxy, schema_features features,
+        std::optional<table_schema_version> version_from_group0, const std::set<sstring>* changed_keyspaces = nullptr) {
+    auto& digest_cache = sys_ks.local().get_schema_digest_cache();
+    if (version_from_group0 || !changed_keyspaces) {
+        // Schema changes are not tracked while the version comes from group 0
+        digest_cache.invalidate();
+    }
+    auto uuid = version_from_group0 ? *version_from_group0 : co_await calculate_schema_digest(proxy, features, digest_cache, changed_keyspaces ? *changed_keyspaces : std::set<sstring>{});
     co_await sys_ks.local().update_schema_version(uuid);
     co_await proxy.local().get_db().invoke_on_all([uuid] (replica::database& db) {
         db.update_version(uuid);
@@ -1015,9 +1118,16 @@ future<> merge_schema(sharded<db::system_keyspace>& sys_ks, distributed<service:
     }
     co_await with_merge_lock([&] () mutable -> future<> {
         bool flush_schema = proxy.local().get_db().local().get_config().flush_schema_tables_after_modification();
+        std::set<sstring> changed_keyspaces;
+        for (auto&& m : mutations) {
+            if (m.schema()->ks_name() != NAME) {
+                continue;
+            }
+            changed_keyspaces.emplace(value_cast<sstring>(utf8_type->deserialize(m.key().get_component(*m.schema(), 0))));
+        }
         co_await do_merge_schema(proxy, sys_ks, std::move(mutations), flush_schema, reload);
         auto version_from_group0 = co_await get_group0_schema_version(sys_ks.local());
-        co_await update_schema_version_and_announce(sys_ks, proxy, feat.cluster_schema_features(), version_from_group0);
+        co_await update_schema_version_and_announce(sys_ks, proxy, feat.cluster_schema_features(), version_from_group0, reload ? nullptr : &changed_keyspaces);
     });
 }
 
@@ -16,11 +16,13 @@
 #include "schema_mutations.hh"
 #include "types/map.hh"
 #include "query-result-set.hh"
+#include "bytes_ostream.hh"
 
 #include <seastar/core/distributed.hh>
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace data_dictionary {
 class keyspace_metadata;
@@ -182,6 +184,23 @@ future<table_schema_version> calculate_schema_digest(distributed<service::storag
 // Calculates schema digest for all non-system keyspaces
 future<table_schema_version> calculate_schema_digest(distributed<service::storage_proxy>& proxy, schema_features);
 
+// Input of the schema digest for each partition (keyspace) of each schema table, kept so that
+// the digest can be recalculated after a schema change by re-reading only the partitions
+// of the keyspaces the change touched, instead of all of the schema tables.
+// Used on shard 0 only, under the merge lock.
+struct schema_digest_cache {
+    using partitions_type = std::map<dht::decorated_key, bytes_ostream, dht::decorated_key::less_comparator>;
+
+    // Features the cached input was calculated with, disengaged when the cache is empty.
+    std::optional<schema_features> features;
+    std::unordered_map<sstring, partitions_type> tables;
+
+    void invalidate() noexcept {
+        features.reset();
+        tables.clear();
+    }
+};
+
 future<std::vector<canonical_mutation>> convert_schema_to_mutations(distributed<service::storage_proxy>& proxy, schema_features);
 std::vector<mutation> adjust_schema_for_schema_features(std::vector<mutation> schema, schema_features features);
 
@@ -15,10 +15,25 @@
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include "db/snapshot-ctl.hh"
+#include "db/snapshot/backup_task.hh"
 #include "replica/database.hh"
+#include "sstables/sstables_manager.hh"
 
 namespace db {
 
+snapshot_ctl::snapshot_ctl(sharded<replica::database>& db, tasks::task_manager& tm, sstables::storage_manager& sstm)
+    : _db(db)
+    , _storage_manager(sstm)
+    , _task_manager_module(make_shared<snapshot::task_manager_module>(tm))
+{
+    tm.register_module(_task_manager_module->get_name(), _task_manager_module);
+}
+
+future<> snapshot_ctl::stop() {
+    co_await _ops.close();
+    co_await _task_manager_module->stop();
+}
+
 future<> snapshot_ctl::check_snapshot_not_exist(sstring ks_name, sstring name, std::optional<std::vector<sstring>> filter) {
     auto& ks = _db.local().find_keyspace(ks_name);
     return parallel_for_each(ks.metadata()->cf_meta_data(), [this, ks_name = std::move(ks_name), name = std::move(name), filter = std::move(filter)] (auto& pair) {
@@ -136,4 +151,53 @@ future<int64_t> snapshot_ctl::true_snapshots_size(sstring ks, sstring cf) {
     }));
 }
 
+future<tasks::task_id> snapshot_ctl::start_backup(sstring endpoint, sstring bucket, sstring prefix, sstring keyspace, sstring snapshot_name) {
+    if (this_shard_id() != 0) {
+        co_return co_await container().invoke_on(0, [&] (auto& local) {
+            return local.start_backup(endpoint, bucket, prefix, keyspace, snapshot_name);
+        });
+    }
+    if (bucket.empty()) {
+        throw std::invalid_argument("You must supply a bucket name");
+    }
+    if (snapshot_name.empty()) {
+        throw std::invalid_argument("You must supply a snapshot name");
+    }
+    if (!_storage_manager.is_known_endpoint(endpoint)) {
+        throw std::invalid_argument(format("Unknown endpoint {}", endpoint));
+    }
+    auto prefix_start = prefix.find_first_not_of('/');
+    prefix = prefix_start == sstring::npos ? "" : prefix.substr(prefix_start);
+    while (prefix.ends_with("/")) {
+        prefix.resize(prefix.size() - 1);
+    }
+
+    auto gh = _ops.hold();
+    auto lock = co_await _lock.hold_read_lock();
+
+    std::vector<snapshot::backup_table> tables;
+    auto& ks = _db.local().find_keyspace(keyspace);
+    for (auto& [cf_name, schema] : ks.metadata()->cf_meta_data()) {
+        auto& cf = _db.local().find_column_family(schema);
+        snapshot::backup_table table{ .name = cf_name };
+        for (auto& datadir : cf.get_config().all_datadirs) {
+            auto dir = std::filesystem::path(datadir) / sstables::snapshots_dir / std::string_view(snapshot_name);
+            if (co_await file_exists(dir.native())) {
+                table.dirs.push_back(std::move(dir));
+            }
+        }
+        if (!table.dirs.empty()) {
+            tables.push_back(std::move(table));
+        }
+    }
+    if (tables.empty()) {
+        throw std::invalid_argument(format("Keyspace {}: snapshot {} doesn't exist", keyspace, snapshot_name));
+    }
+
+    auto client = _storage_manager.get_endpoint_client(endpoint);
+    auto task = co_await _task_manager_module->make_and_start_task<snapshot::backup_task_impl>({}, std::move(client),
+            std::move(bucket), std::move(prefix), std::move(keyspace), std::move(snapshot_name), std::move(tables));
+    co_return task->id();
+}
+
 }
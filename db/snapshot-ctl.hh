@@ -17,13 +17,18 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/future.hh>
 #include "replica/database_fwd.hh"
+#include "tasks/task_manager.hh"
 #include <seastar/core/gate.hh>
 #include <seastar/core/rwlock.hh>
 
+namespace sstables { class storage_manager; }
+
 using namespace seastar;
 
 namespace db {
 
+namespace snapshot { class task_manager_module; }
+
 class snapshot_ctl : public peering_sharded_service<snapshot_ctl> {
 public:
     using skip_flush = bool_class<class skip_flush_tag>;
@@ -42,11 +47,9 @@ class snapshot_ctl : public peering_sharded_service<snapshot_ctl> {
 
     using db_snapshot_details = std::vector<table_snapshot_details_ext>;
 
-    explicit snapshot_ctl(sharded<replica::database>& db) : _db(db) {}
+    snapshot_ctl(sharded<replica::database>& db, tasks::task_manager& tm, sstables::storage_manager& sstm);
 
-    future<> stop() {
-        return _ops.close();
-    }
+    future<> stop();
 
     /**
      * Takes the snapshot for all keyspaces. A snapshot name must be specified.
@@ -94,8 +97,19 @@ class snapshot_ctl : public peering_sharded_service<snapshot_ctl> {
 
     future<int64_t> true_snapshots_size();
     future<int64_t> true_snapshots_size(sstring ks, sstring cf);
+
+    /**
+     * Starts uploading the snapshot of the keyspace to the bucket on the given
+     * object storage endpoint, under the prefix, see db::snapshot::backup_task_impl.
+     * Removing the snapshot while it's being uploaded fails the backup.
+     *
+     * @return the id of the backup task
+     */
+    future<tasks::task_id> start_backup(sstring endpoint, sstring bucket, sstring prefix, sstring keyspace, sstring snapshot_name);
 private:
     sharded<replica::database>& _db;
+    sstables::storage_manager& _storage_manager;
+    shared_ptr<snapshot::task_manager_module> _task_manager_module;
     seastar::rwlock _lock;
     seastar::gate _ops;
 
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "db/snapshot/backup_task.hh"
+#include "utils/hashers.hh"
+#include "utils/exceptions.hh"
+#include "utils/lister.hh"
+#include "utils/s3/client.hh"
+#include "log.hh"
+
+namespace db::snapshot {
+
+static logging::logger bklog("backup");
+
+struct backup_task_impl::file_entry {
+    size_t table;
+    sstring name;
+    std::filesystem::path path;
+    uint64_t size;
+    sstring digest;
+};
+
+backup_task_impl::backup_task_impl(tasks::task_manager::module_ptr module,
+                                   shared_ptr<s3::client> client,
+                                   sstring bucket,
+                                   sstring prefix,
+                                   sstring keyspace,
+                                   sstring snapshot_name,
+                                   std::vector<backup_table> tables) noexcept
+    : tasks::task_manager::task::impl(module, tasks::task_id::create_random_id(), 0, "keyspace", std::move(keyspace), "", snapshot_name, tasks::task_id::create_null_id())
+    , _client(std::move(client))
+    , _bucket(std::move(bucket))
+    , _prefix(std::move(prefix))
+    , _snapshot_name(std::move(snapshot_name))
+    , _tables(std::move(tables))
+{
+    _status.progress_units = "bytes";
+}
+
+sstring backup_task_impl::object_name(std::string_view key) const {
+    if (_prefix.empty()) {
+        return format("/{}/{}", _bucket, key);
+    }
+    return format("/{}/{}/{}", _bucket, _prefix, key);
+}
+
+static future<sstring> digest_file(const std::filesystem::path& path) {
+    auto f = co_await open_file_dma(path.native(), open_flags::ro);
+    auto in = make_file_input_stream(std::move(f));
+    sha256_hasher h;
+    std::exception_ptr ex;
+    try {
+        co_await in.consume([&h] (temporary_buffer<char> buf) {
+            if (buf.empty()) {
+                return make_ready_future<consumption_result<char>>(stop_consuming(std::move(buf)));
+            }
+            h.update(buf.get(), buf.size());
+            return make_ready_future<consumption_result<char>>(continue_consuming());
+        });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    co_return to_hex(h.finalize());
+}
+
+future<> backup_task_impl::upload_file(const file_entry& e, sstring name) {
+    auto f = co_await open_file_dma(e.path.native(), open_flags::ro);
+    auto in = make_file_input_stream(std::move(f));
+    // Big files are uploaded in parts, several of them in parallel
+    auto sink = e.size <= s3::client::upload_sink_max_object_size / 2
+            ? _client->make_upload_sink(name, e.size)
+            : _client->make_upload_jumbo_sink(name);
+    auto out = output_stream<char>(std::move(sink));
+    std::exception_ptr ex;
+    try {
+        co_await copy(in, out);
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    co_await in.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+}
+
+future<> backup_task_impl::backup_file(file_entry& e) {
+    _as.check();
+    e.digest = co_await digest_file(e.path);
+    auto name = object_name(format("blobs/{}", e.digest));
+
+    std::optional<uint64_t> remote_size;
+    try {
+        remote_size = co_await _client->get_object_size(name);
+    } catch (const storage_io_error& ex) {
+        if (ex.code().value() != ENOENT) {
+            throw;
+        }
+    }
+
+    if (remote_size == e.size) {
+        bklog.debug("{} is already backed up as {}", e.path, name);
+    } else {
+        _as.check();
+        bklog.debug("Uploading {} as {}", e.path, name);
+        co_await upload_file(e, std::move(name));
+        _uploaded_bytes += e.size;
+    }
+    _processed_bytes += e.size;
+}
+
+future<> backup_task_impl::upload_manifest(const std::vector<file_entry>& files) {
+    std::ostringstream ss;
+    ss << "{" << std::endl;
+    ss << "\t\"keyspace\" : \"" << _status.keyspace << "\"," << std::endl;
+    ss << "\t\"snapshot\" : \"" << _snapshot_name << "\"," << std::endl;
+    ss << "\t\"tables\" : [";
+    for (size_t t = 0; t < _tables.size(); t++) {
+        ss << (t > 0 ? "," : "") << std::endl << "\t\t{ \"table\" : \"" << _tables[t].name << "\", \"files\" : [ ";
+        int n = 0;
+        for (const auto& e : files) {
+            if (e.table != t) {
+                continue;
+            }
+            if (n++ > 0) {
+                ss << ", ";
+            }
+            ss << "{ \"name\" : \"" << e.name << "\", \"size\" : " << e.size << ", \"sha256\" : \"" << e.digest << "\" }";
+            co_await coroutine::maybe_yield();
+        }
+        ss << " ] }";
+    }
+    ss << std::endl << "\t]" << std::endl << "}" << std::endl;
+
+    auto json = ss.str();
+    auto name = object_name(format("manifests/{}/{}.json", _status.keyspace, _snapshot_name));
+    bklog.debug("Uploading manifest {}", name);
+    co_await _client->put_object(std::move(name), temporary_buffer<char>(json.data(), json.size()));
+}
+
+future<> backup_task_impl::run() {
+    std::vector<file_entry> files;
+    for (size_t t = 0; t < _tables.size(); t++) {
+        for (const auto& dir : _tables[t].dirs) {
+            co_await lister::scan_dir(dir, lister::dir_entry_types::of<directory_entry_type::regular>(), [&files, t] (std::filesystem::path dir, directory_entry de) -> future<> {
+                auto path = dir / de.name;
+                auto size = co_await file_size(path.native());
+                files.emplace_back(file_entry{ t, de.name, std::move(path), size, "" });
+            });
+        }
+    }
+    for (const auto& e : files) {
+        _total_bytes += e.size;
+    }
+    _files_listed = true;
+    bklog.info("Backing up snapshot {} of keyspace {}: {} files, {} bytes", _snapshot_name, _status.keyspace, files.size(), _total_bytes);
+
+    co_await max_concurrent_for_each(files, upload_concurrency, [this] (file_entry& e) {
+        return backup_file(e);
+    });
+    _as.check();
+    co_await upload_manifest(files);
+
+    bklog.info("Backed up snapshot {} of keyspace {}: uploaded {} of {} bytes", _snapshot_name, _status.keyspace, _uploaded_bytes, _total_bytes);
+}
+
+future<tasks::task_manager::task::progress> backup_task_impl::get_progress() const {
+    if (!_files_listed) {
+        co_return get_binary_progress();
+    }
+    co_return tasks::task_manager::task::progress{
+        .completed = double(_processed_bytes),
+        .total = double(_total_bytes),
+    };
+}
+
+} // db::snapshot namespace
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+
+#include "tasks/task_manager.hh"
+
+namespace s3 { class client; }
+
+namespace db::snapshot {
+
+class task_manager_module : public tasks::task_manager::module {
+public:
+    task_manager_module(tasks::task_manager& tm) noexcept : tasks::task_manager::module(tm, "snapshot") {}
+};
+
+struct backup_table {
+    sstring name;
+    // The directories of the snapshot, one per data directory of the table
+    std::vector<std::filesystem::path> dirs;
+};
+
+// Uploads the files of a snapshot of a keyspace to a bucket.
+//
+// The backup is content-addressed: every file is kept in the
+// <prefix>/blobs/<sha256 of the content> object, so files that are already
+// there, e.g. sstables that were in a previous backup, are not uploaded again
+// and consecutive backups only upload the delta. Which blobs make up the
+// snapshot is recorded in the <prefix>/manifests/<keyspace>/<snapshot>.json
+// object, listing the name, the size and the digest of the files of every
+// table. The manifest is uploaded last, so the backup is complete once it
+// exists.
+class backup_task_impl : public tasks::task_manager::task::impl {
+    static constexpr size_t upload_concurrency = 4;
+
+    struct file_entry;
+
+    shared_ptr<s3::client> _client;
+    sstring _bucket;
+    sstring _prefix;
+    sstring _snapshot_name;
+    std::vector<backup_table> _tables;
+
+    uint64_t _total_bytes = 0;
+    uint64_t _processed_bytes = 0;
+    uint64_t _uploaded_bytes = 0;
+    bool _files_listed = false;
+
+    sstring object_name(std::string_view key) const;
+    future<> backup_file(file_entry& e);
+    future<> upload_file(const file_entry& e, sstring name);
+    future<> upload_manifest(const std::vector<file_entry>& files);
+protected:
+    virtual future<> run() override;
+public:
+    backup_task_impl(tasks::task_manager::module_ptr module,
+                     shared_ptr<s3::client> client,
+                     sstring bucket,
+                     sstring prefix,
+                     sstring keyspace,
+                     sstring snapshot_name,
+                     std::vector<backup_table> tables) noexcept;
+
+    virtual std::string type() const override {
+        return "backup";
+    }
+
+    virtual tasks::is_abortable is_abortable() const noexcept override {
+        return tasks::is_abortable::yes;
+    }
+
+    virtual future<tasks::task_manager::task::progress> get_progress() const override;
+};
+
+} // db::snapshot namespace
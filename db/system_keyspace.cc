@@ -3284,6 +3284,7 @@ system_keyspace::system_keyspace(
     : _qp(qp)
     , _db(db)
     , _cache(std::make_unique<local_cache>())
+    , _schema_digest_cache(std::make_unique<schema_tables::schema_digest_cache>())
 {
     _db.plug_system_keyspace(*this);
 }
@@ -90,6 +90,7 @@ namespace schema_tables {
 future<column_mapping> get_column_mapping(db::system_keyspace& sys_ks, ::table_id table_id, table_schema_version version);
 future<bool> column_mapping_exists(db::system_keyspace& sys_ks, table_id table_id, table_schema_version version);
 future<> drop_column_mapping(db::system_keyspace& sys_ks, table_id table_id, table_schema_version version);
+struct schema_digest_cache;
 }
 
 class config;
@@ -118,6 +119,7 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     cql3::query_processor& _qp;
     replica::database& _db;
     std::unique_ptr<local_cache> _cache;
+    std::unique_ptr<schema_tables::schema_digest_cache> _schema_digest_cache;
     virtual_tables_registry _virtual_tables_registry;
     bool _peers_table_read_fixup_done = false;
 
@@ -632,6 +634,7 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     future<> shutdown();
 
     virtual_tables_registry& get_virtual_tables_registry() { return _virtual_tables_registry; }
+    schema_tables::schema_digest_cache& get_schema_digest_cache() { return *_schema_digest_cache; }
 private:
     future<::shared_ptr<cql3::untyped_result_set>> execute_cql(const sstring& query_string, const data_value_list& values);
     template <typename... Args>
@@ -117,6 +117,7 @@ row_locker::lock_holder::lock_holder(row_locker::lock_holder&& old) noexcept
         , _partition_exclusive(old._partition_exclusive)
         , _row(old._row)
         , _row_exclusive(old._row_exclusive)
+        , _shared(std::move(old._shared))
 {
     // We also need to zero old's _partition and _row, so when destructed
     // the destructor will do nothing and further moves will not create
@@ -127,7 +128,10 @@ row_locker::lock_holder::lock_holder(row_locker::lock_holder&& old) noexcept
 
 row_locker::lock_holder& row_locker::lock_holder::operator=(row_locker::lock_holder&& old) noexcept {
     if (this != &old) {
-        this->~lock_holder();
+        if (_locker) {
+            _locker->unlock(_partition,  _partition_exclusive, _row, _row_exclusive);
+        }
+        _shared = std::move(old._shared);
         _locker = old._locker;
         _partition = old._partition;
         _partition_exclusive = old._partition_exclusive;
@@ -186,6 +190,17 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
      }
 }
 
+std::vector<row_locker::lock_holder> row_locker::lock_holder::share(lock_holder&& holder, size_t n) {
+    auto shared = make_shared<lock_holder>(std::move(holder));
+    std::vector<lock_holder> ret;
+    ret.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        ret.emplace_back(lock_holder());
+        ret.back()._shared = shared;
+    }
+    return ret;
+}
+
 row_locker::lock_holder::~lock_holder() {
     if (_locker) {
         _locker->unlock(_partition,  _partition_exclusive, _row, _row_exclusive);
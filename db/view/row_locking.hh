@@ -20,9 +20,11 @@
 // the new.
 
 #include <unordered_map>
+#include <vector>
 
 #include <seastar/core/rwlock.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/shared_ptr.hh>
 
 #include "db/timeout_clock.hh"
 #include "schema/schema_fwd.hh"
@@ -68,6 +70,9 @@ class row_locker {
         bool _partition_exclusive;
         const clustering_key_prefix* _row;
         bool _row_exclusive;
+        // Set in holders returned by share(), which hold the lock
+        // through the original holder.
+        shared_ptr<lock_holder> _shared;
     public:
         lock_holder();
         lock_holder(row_locker* locker, const dht::decorated_key* pk, bool exclusive);
@@ -76,6 +81,9 @@ class row_locker {
         // Allow move (noexcept) but disallow copy
         lock_holder(lock_holder&&) noexcept;
         lock_holder& operator=(lock_holder&&) noexcept;
+        // Returns n holders sharing the lock of the given holder, which is
+        // released when all of them are destroyed.
+        static std::vector<lock_holder> share(lock_holder&& holder, size_t n);
     };
 private:
     schema_ptr _schema;
@@ -36,6 +36,7 @@
 #include "cql3/restrictions/statement_restrictions.hh"
 #include "cql3/expr/expr-utils.hh"
 #include "cql3/expr/evaluate.hh"
+#include "db/config.hh"
 #include "db/view/view.hh"
 #include "db/view/view_builder.hh"
 #include "db/view/view_updating_consumer.hh"
@@ -271,6 +272,8 @@ void stats::register_stats() {
                     {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_failed_local", view_updates_failed_local, ms::description("Number of updates (mutations) that failed to be pushed to local view replicas"),
                     {_cf_label, _ks_label}),
+            ms::make_total_operations("view_update_writes_coalesced", view_update_writes_coalesced, ms::description("Number of base writes whose view updates were generated together with those of an earlier write to the same partition"),
+                    {_cf_label, _ks_label}),
             ms::make_gauge("view_updates_pending", ms::description("Number of updates pushed to view and are still to be completed"),
                     {_cf_label, _ks_label}, writes),
     });
@@ -1015,6 +1018,12 @@ bool view_updates::can_skip_view_updates(const clustering_or_static_row& update,
         const auto view_it = _view->columns_by_name().find(cdef.name());
         const bool column_is_selected = view_it != _view->columns_by_name().end();
 
+        // With a non-expiring row marker, changes to an unselected column
+        // can't change the liveness of the view row, whatever its type.
+        if (!column_is_selected && base_has_nonexpiring_marker) {
+            return true;
+        }
+
         //TODO(sarna): Optimize collections case - currently they do not go under optimization
         if (!cdef.is_atomic()) {
             return false;
@@ -2293,7 +2302,11 @@ void view_builder::on_drop_view(const sstring& ks_name, const sstring& view_name
 }
 
 future<> view_builder::do_build_step() {
-    return seastar::async([this] {
+    // Building competes with the workload like streaming does, so it runs in
+    // the same group, whatever triggered it.
+    seastar::thread_attributes attr;
+    attr.sched_group = _db.get_streaming_scheduling_group();
+    return seastar::async(std::move(attr), [this] {
         exponential_backoff_retry r(1s, 1min);
         while (!_base_to_build_step.empty() && !_as.abort_requested()) {
             auto units = get_units(_sem, 1).get();
@@ -2374,13 +2387,22 @@ class view_builder::consumer {
     // used to build it, and we cannot allow its serialized size to grow
     // beyond our limit on mutation size (by default 32 MB).
     size_t _fragments_memory_usage = 0;
+    size_t _fragments_rows = 0;
+    // View updates of flushed fragments are generated and pushed in the
+    // background, by up to view_building_concurrency flushes at a time.
+    // They are waited for before the step's progress is saved.
+    semaphore& _flush_units;
+    std::vector<future<>>& _flushes;
 public:
-    consumer(view_builder& builder, shared_ptr<view_update_generator> gen, build_step& step, gc_clock::time_point now)
+    consumer(view_builder& builder, shared_ptr<view_update_generator> gen, build_step& step, gc_clock::time_point now,
+            semaphore& flush_units, std::vector<future<>>& flushes)
             : _builder(builder)
             , _gen(std::move(gen))
             , _step(step)
             , _built_views{step}
-            , _now(now) {
+            , _now(now)
+            , _flush_units(flush_units)
+            , _flushes(flushes) {
         if (!step.current_key.key().is_empty(*_step.reader.schema())) {
             load_views_to_build();
         }
@@ -2462,11 +2484,13 @@ class view_builder::consumer {
     void add_fragment(auto&& fragment) {
         _fragments_memory_usage += fragment.memory_usage(*_step.reader.schema());
         _fragments.emplace_back(*_step.reader.schema(), _builder._permit, std::move(fragment));
-        if (_fragments_memory_usage > batch_memory_max) {
+        if (_fragments_memory_usage > batch_memory_max || ++_fragments_rows >= batch_size) {
             // Although we have not yet completed the batch of base rows that
             // compact_for_query<> planned for us (view_builder::batchsize),
             // we've still collected enough rows to reach sizeable memory use,
-            // so let's flush these rows now.
+            // so let's flush these rows now. With view_building_concurrency
+            // above 1, a step covers several batches, so they are flushed
+            // as soon as they are complete, too.
             flush_fragments();
         }
     }
@@ -2486,15 +2510,17 @@ class view_builder::consumer {
             auto reader = make_flat_mutation_reader_from_fragments(_step.reader.schema(), _builder._permit, std::move(_fragments));
             auto close_reader = defer([&reader] { reader.close().get(); });
             reader.upgrade_schema(base_schema);
-            _gen->populate_views(
+            auto units = get_units(_flush_units, 1).get();
+            _flushes.push_back(_gen->populate_views(
                     *_step.base,
                     std::move(views),
                     _step.current_token(),
                     std::move(reader),
-                    _now).get();
+                    _now).finally([units = std::move(units)] {}));
             close_reader.cancel();
             _fragments.clear();
             _fragments_memory_usage = 0;
+            _fragments_rows = 0;
         }
     }
 
@@ -2538,14 +2564,45 @@ class view_builder::consumer {
 // Called in the context of a seastar::thread.
 void view_builder::execute(build_step& step, exponential_backoff_retry r) {
     gc_clock::time_point now = gc_clock::now();
+    const size_t concurrency = std::max(_db.get_config().view_building_concurrency(), 1u);
     auto compaction_state = make_lw_shared<compact_for_query_state_v2>(
             *step.reader.schema(),
             now,
             step.pslice,
-            batch_size,
+            batch_size * concurrency,
             query::max_partitions);
-    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, now});
-    auto built = step.reader.consume_in_thread(std::move(consumer));
+    semaphore flush_units(concurrency);
+    std::vector<future<>> flushes;
+    auto wait_for_flushes = [&] {
+        return when_all_succeed(flushes.begin(), flushes.end()).discard_result();
+    };
+    // A failed flush may be older than the current key, so on failure the
+    // step is retried from where it started.
+    auto start_key = step.current_key;
+    auto start_status = step.build_status;
+    auto restart_step = [&] {
+        step.current_key = std::move(start_key);
+        step.build_status = std::move(start_status);
+    };
+    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, now, flush_units, flushes});
+    std::optional<view_builder::consumer::built_views> built;
+    try {
+        built.emplace(step.reader.consume_in_thread(std::move(consumer)));
+    } catch (...) {
+        auto ex = std::current_exception();
+        wait_for_flushes().handle_exception([] (std::exception_ptr) {}).get();
+        restart_step();
+        std::rethrow_exception(std::move(ex));
+    }
+    // The progress saved below must only cover rows whose view updates
+    // were pushed.
+    try {
+        wait_for_flushes().get();
+    } catch (...) {
+        built->release();
+        restart_step();
+        throw;
+    }
     if (auto ds = std::move(*compaction_state).detach_state()) {
         if (ds->current_tombstone) {
             step.reader.unpop_mutation_fragment(mutation_fragment_v2(*step.reader.schema(), step.reader.permit(), std::move(*ds->current_tombstone)));
@@ -2556,11 +2613,11 @@ void view_builder::execute(build_step& step, exponential_backoff_retry r) {
     _as.check();
 
     std::vector<future<>> bookkeeping_ops;
-    bookkeeping_ops.reserve(built.views.size() + step.build_status.size());
-    for (auto& [view, first_token, _] : built.views) {
+    bookkeeping_ops.reserve(built->views.size() + step.build_status.size());
+    for (auto& [view, first_token, _] : built->views) {
         bookkeeping_ops.push_back(maybe_mark_view_as_built(view, first_token));
     }
-    built.release();
+    built->release();
     for (auto& [view, _, next_token] : step.build_status) {
         if (next_token) {
             bookkeeping_ops.push_back(
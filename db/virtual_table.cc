@@ -7,6 +7,8 @@
  * SPDX-License-Identifier: (AGPL-3.0-or-later and Apache-2.0)
  */
 
+#include <seastar/core/coroutine.hh>
+
 #include "db/virtual_table.hh"
 #include "db/chained_delegating_reader.hh"
 #include "readers/queue.hh"
@@ -80,88 +82,156 @@ mutation_source memtable_filling_virtual_table::as_mutation_source() {
     });
 }
 
-mutation_source streaming_virtual_table::as_mutation_source() {
-    return mutation_source([this] (schema_ptr s,
+// Reads a single partition range at a time, starting a new read
+// on each fast_forward_to(const dht::partition_range&).
+class range_restarting_reader : public flat_mutation_reader_v2::impl {
+public:
+    using reader_factory = std::function<flat_mutation_reader_v2(const dht::partition_range&)>;
+private:
+    reader_factory _make_reader;
+    flat_mutation_reader_v2 _underlying;
+public:
+    range_restarting_reader(schema_ptr s, reader_permit permit, const dht::partition_range& pr, reader_factory make_reader)
+        : impl(std::move(s), std::move(permit))
+        , _make_reader(std::move(make_reader))
+        , _underlying(_make_reader(pr))
+    { }
+
+    virtual future<> fill_buffer() override {
+        if (is_buffer_full()) {
+            return make_ready_future<>();
+        }
+        return _underlying.fill_buffer().then([this] {
+            _end_of_stream = _underlying.is_end_of_stream();
+            _underlying.move_buffer_content_to(*this);
+        });
+    }
+
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        auto f = make_ready_future<>();
+        if (is_buffer_empty()) {
+            f = _underlying.next_partition();
+        }
+        return f.then([this] {
+            _end_of_stream = _underlying.is_end_of_stream() && _underlying.is_buffer_empty();
+        });
+    }
+
+    virtual future<> fast_forward_to(position_range pr) override {
+        _end_of_stream = false;
+        clear_buffer();
+        return _underlying.fast_forward_to(std::move(pr));
+    }
+
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        _end_of_stream = false;
+        clear_buffer();
+        auto rd = _make_reader(pr);
+        co_await _underlying.close();
+        _underlying = std::move(rd);
+    }
+
+    virtual future<> close() noexcept override {
+        return _underlying.close();
+    }
+};
+
+flat_mutation_reader_v2 streaming_virtual_table::make_reader(schema_ptr s,
         reader_permit permit,
         const dht::partition_range& pr,
         const query::partition_slice& query_slice,
-        tracing::trace_state_ptr trace_state,
-        streamed_mutation::forwarding fwd,
-        mutation_reader::forwarding fwd_mr) {
-
-        std::unique_ptr<query::partition_slice> unreversed_slice;
-        bool reversed = query_slice.is_reversed();
-        if (reversed) {
-            s = s->make_reversed();
-            unreversed_slice = std::make_unique<query::partition_slice>(query::half_reverse_slice(*s, query_slice));
+        streamed_mutation::forwarding fwd) {
+    std::unique_ptr<query::partition_slice> unreversed_slice;
+    bool reversed = query_slice.is_reversed();
+    if (reversed) {
+        s = s->make_reversed();
+        unreversed_slice = std::make_unique<query::partition_slice>(query::half_reverse_slice(*s, query_slice));
+    }
+    const auto& slice = reversed ? *unreversed_slice : query_slice;
+
+    // We cannot pass the partition_range directly to execute()
+    // because it is not guaranteed to be alive until execute() resolves.
+    // It is only guaranteed to be alive as long as the returned reader is alive.
+    // We achieve safety by mediating access through query_restrictions. When the reader
+    // dies, pr is cleared and execute() will get an exception.
+    struct my_result_collector : public result_collector, public query_restrictions {
+        queue_reader_handle_v2 handle;
+
+        // Valid until handle.is_terminated(), which is set to true when the
+        // queue_reader dies.
+        const dht::partition_range* pr;
+
+        my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, queue_reader_handle_v2&& handle)
+            : result_collector(s, p)
+            , handle(std::move(handle))
+            , pr(pr)
+        { }
+
+        // result_collector
+        future<> take(mutation_fragment_v2 fragment) override {
+            return handle.push(std::move(fragment));
         }
-        const auto& slice = reversed ? *unreversed_slice : query_slice;
-
-        // We cannot pass the partition_range directly to execute()
-        // because it is not guaranteed to be alive until execute() resolves.
-        // It is only guaranteed to be alive as long as the returned reader is alive.
-        // We achieve safety by mediating access through query_restrictions. When the reader
-        // dies, pr is cleared and execute() will get an exception.
-        struct my_result_collector : public result_collector, public query_restrictions {
-            queue_reader_handle_v2 handle;
-
-            // Valid until handle.is_terminated(), which is set to true when the
-            // queue_reader dies.
-            const dht::partition_range* pr;
-            mutation_reader::forwarding fwd_mr;
-
-            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, queue_reader_handle_v2&& handle)
-                : result_collector(s, p)
-                , handle(std::move(handle))
-                , pr(pr)
-            { }
-
-            // result_collector
-            future<> take(mutation_fragment_v2 fragment) override {
-                return handle.push(std::move(fragment));
-            }
 
-            // query_restrictions
-            const dht::partition_range& partition_range() const override {
-                if (handle.is_terminated()) {
-                    throw std::runtime_error("read abandoned");
-                }
-                return *pr;
+        // query_restrictions
+        const dht::partition_range& partition_range() const override {
+            if (handle.is_terminated()) {
+                throw std::runtime_error("read abandoned");
             }
-        };
+            return *pr;
+        }
+    };
+
+    auto reader_and_handle = make_queue_reader_v2(s, permit);
+    auto consumer = std::make_unique<my_result_collector>(s, permit, &pr, std::move(reader_and_handle.second));
+    auto f = execute(permit, *consumer, *consumer);
+
+    // It is safe to discard this future because:
+    // - after calling `handle.push_end_of_stream()` the reader can be discarded;
+    // - if the reader dies first, `execute()` will get an exception on attempt to push fragments.
+    (void)f.then_wrapped([c = std::move(consumer)] (auto&& f) {
+        if (f.failed()) {
+            c->handle.abort(f.get_exception());
+        } else if (!c->handle.is_terminated()) {
+            c->handle.push_end_of_stream();
+        }
+    });
 
-        auto reader_and_handle = make_queue_reader_v2(s, permit);
-        auto consumer = std::make_unique<my_result_collector>(s, permit, &pr, std::move(reader_and_handle.second));
-        auto f = execute(permit, *consumer, *consumer);
-
-        // It is safe to discard this future because:
-        // - after calling `handle.push_end_of_stream()` the reader can be discarded;
-        // - if the reader dies first, `execute()` will get an exception on attempt to push fragments.
-        (void)f.then_wrapped([c = std::move(consumer)] (auto&& f) {
-            if (f.failed()) {
-                c->handle.abort(f.get_exception());
-            } else if (!c->handle.is_terminated()) {
-                c->handle.push_end_of_stream();
-            }
+    auto rd = make_slicing_filtering_reader(std::move(reader_and_handle.first), pr, slice);
+
+    if (!_shard_aware) {
+        rd = make_filtering_reader(std::move(rd), [this] (const dht::decorated_key& dk) -> bool {
+            return this_shard_owns(dk);
         });
+    }
 
-        auto rd = make_slicing_filtering_reader(std::move(reader_and_handle.first), pr, slice);
+    if (reversed) {
+        rd = make_reversing_reader(std::move(rd), permit.max_result_size(), std::move(unreversed_slice));
+    }
 
-        if (!_shard_aware) {
-            rd = make_filtering_reader(std::move(rd), [this] (const dht::decorated_key& dk) -> bool {
-                return this_shard_owns(dk);
-            });
-        }
+    if (fwd == streamed_mutation::forwarding::yes) {
+        rd = make_forwardable(std::move(rd));
+    }
 
-        if (reversed) {
-            rd = make_reversing_reader(std::move(rd), permit.max_result_size(), std::move(unreversed_slice));
-        }
+    return rd;
+}
 
-        if (fwd == streamed_mutation::forwarding::yes) {
-            rd = make_forwardable(std::move(rd));
+mutation_source streaming_virtual_table::as_mutation_source() {
+    return mutation_source([this] (schema_ptr s,
+        reader_permit permit,
+        const dht::partition_range& pr,
+        const query::partition_slice& slice,
+        tracing::trace_state_ptr trace_state,
+        streamed_mutation::forwarding fwd,
+        mutation_reader::forwarding fwd_mr) {
+        if (fwd_mr == mutation_reader::forwarding::no) {
+            return make_reader(std::move(s), std::move(permit), pr, slice, fwd);
         }
-
-        return rd;
+        // execute() produces the data of a single partition range, so each
+        // range forwarded to is read by a new execute().
+        return make_flat_mutation_reader_v2<range_restarting_reader>(s, permit, pr, [this, s, permit, &slice, fwd] (const dht::partition_range& pr) {
+            return make_reader(s, permit, pr, slice, fwd);
+        });
     });
 }
 
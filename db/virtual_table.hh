@@ -101,7 +101,12 @@ class result_collector {
 //
 //  - avoid emitting partitions which fall outside result_collector::partition_range().
 //
+// Readers which are fast-forwarded to another partition range abandon the execute()
+// of the previous range and start a new one, so execute() only ever has to produce
+// a single range.
+//
 class streaming_virtual_table : public virtual_table {
+    flat_mutation_reader_v2 make_reader(schema_ptr, reader_permit, const dht::partition_range&, const query::partition_slice&, streamed_mutation::forwarding);
 public:
     using virtual_table::virtual_table;
 
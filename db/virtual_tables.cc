@@ -15,6 +15,7 @@
 #include <seastar/core/reactor.hh>
 
 #include "db/config.hh"
+#include "db/large_data_handler.hh"
 #include "db/system_keyspace.hh"
 #include "db/virtual_table.hh"
 #include "db/virtual_tables.hh"
@@ -32,6 +33,7 @@
 #include "types/list.hh"
 #include "types/types.hh"
 #include "utils/build_id.hh"
+#include "utils/hash.hh"
 #include "log.hh"
 
 namespace db {
@@ -338,6 +340,248 @@ class snapshots_table : public streaming_virtual_table {
     }
 };
 
+class hot_partitions_table : public streaming_virtual_table {
+    distributed<replica::database>& _db;
+public:
+    explicit hot_partitions_table(distributed<replica::database>& db)
+            : streaming_virtual_table(build_schema())
+            , _db(db)
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "hot_partitions");
+        return schema_builder(system_keyspace::NAME, "hot_partitions", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::clustering_key)
+            .with_column("shard", int32_type, column_kind::clustering_key)
+            .with_column("partition_key", utf8_type, column_kind::clustering_key)
+            .with_column("reads", long_type)
+            .with_column("error", long_type)
+            .with_column("pinned", boolean_type)
+            .set_comment("Lists the partitions which took the most single-partition reads of each shard recently, and whether they are pinned in the row cache. "
+                    "The number of reads is estimated from a sample, and overestimated by at most error.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    dht::decorated_key make_partition_key(const sstring& name) {
+        return dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(name).serialize_nonnull()));
+    }
+
+    clustering_key make_clustering_key(sstring table_name, int32_t shard, sstring key) {
+        return clustering_key::from_exploded(*_s, {
+            data_value(std::move(table_name)).serialize_nonnull(),
+            data_value(shard).serialize_nonnull(),
+            data_value(std::move(key)).serialize_nonnull()
+        });
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        struct hot_partition_info {
+            sstring keyspace_name;
+            sstring table_name;
+            int32_t shard;
+            sstring key;
+            int64_t reads;
+            int64_t error;
+            bool pinned;
+        };
+        using hot_partitions_by_keyspace = std::map<sstring, std::vector<hot_partition_info>>;
+
+        auto hot_partitions = co_await _db.map_reduce0([] (replica::database& db) {
+            std::vector<hot_partition_info> ret;
+            for (auto& hp : db.row_cache_tracker().hot_partitions()) {
+                ret.push_back(hot_partition_info{
+                    .keyspace_name = hp.schema->ks_name(),
+                    .table_name = hp.schema->cf_name(),
+                    .shard = int32_t(this_shard_id()),
+                    .key = fmt::to_string(hp.key.key().with_schema(*hp.schema)),
+                    .reads = hp.count,
+                    .error = hp.error,
+                    .pinned = hp.pinned,
+                });
+            }
+            return ret;
+        }, hot_partitions_by_keyspace(), [] (hot_partitions_by_keyspace map, std::vector<hot_partition_info> infos) {
+            for (auto& info : infos) {
+                map[info.keyspace_name].push_back(std::move(info));
+            }
+            return map;
+        });
+
+        struct decorated_keyspace_name {
+            sstring name;
+            dht::decorated_key key;
+        };
+        std::vector<decorated_keyspace_name> keyspace_names;
+        for (auto& [name, _] : hot_partitions) {
+            auto dk = make_partition_key(name);
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+            keyspace_names.push_back({name, std::move(dk)});
+        }
+
+        boost::sort(keyspace_names, [less = dht::ring_position_less_comparator(*_s)]
+                (const decorated_keyspace_name& l, const decorated_keyspace_name& r) {
+            return less(l.key, r.key);
+        });
+
+        for (auto& ks : keyspace_names) {
+            auto& infos = hot_partitions[ks.name];
+            boost::sort(infos, [] (const hot_partition_info& l, const hot_partition_info& r) {
+                return std::tie(l.table_name, l.shard, l.key) < std::tie(r.table_name, r.shard, r.key);
+            });
+
+            co_await result.emit_partition_start(ks.key);
+            for (auto& info : infos) {
+                clustering_row cr(make_clustering_key(info.table_name, info.shard, info.key));
+                set_cell(cr.cells(), "reads", info.reads);
+                set_cell(cr.cells(), "error", info.error);
+                set_cell(cr.cells(), "pinned", info.pinned);
+                co_await result.emit_row(std::move(cr));
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
+class large_partitions_ranking_table : public streaming_virtual_table {
+    distributed<replica::database>& _db;
+public:
+    explicit large_partitions_ranking_table(distributed<replica::database>& db)
+            : streaming_virtual_table(build_schema())
+            , _db(db)
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "large_partitions_ranking");
+        return schema_builder(system_keyspace::NAME, "large_partitions_ranking", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::clustering_key)
+            .with_column("rank", int32_type, column_kind::clustering_key)
+            .with_column("partition_key", utf8_type)
+            .with_column("shard", int32_type)
+            .with_column("partition_size", long_type)
+            .with_column("rows", long_type)
+            .with_column("writes", long_type)
+            .with_column("written_bytes", long_type)
+            .with_column("reads", long_type)
+            .with_column("cost", long_type)
+            .set_comment("Ranks the large partitions written since the node started by how many bytes processing them costs. "
+                    "The cost is the bytes written to sstables by flushes and compactions of the partition, plus the bytes "
+                    "read by the recent single-partition reads of it listed in system.hot_partitions.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    dht::decorated_key make_partition_key(const sstring& name) {
+        return dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(name).serialize_nonnull()));
+    }
+
+    clustering_key make_clustering_key(sstring table_name, int32_t rank) {
+        return clustering_key::from_exploded(*_s, {
+            data_value(std::move(table_name)).serialize_nonnull(),
+            data_value(rank).serialize_nonnull()
+        });
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        struct large_partition_info {
+            sstring table_name;
+            sstring key;
+            int32_t shard;
+            int64_t size;
+            int64_t rows;
+            int64_t writes;
+            int64_t written_bytes;
+            int64_t reads;
+            int64_t cost;
+        };
+        using large_partitions_by_keyspace = std::map<sstring, std::vector<large_partition_info>>;
+
+        auto large_partitions = co_await _db.map_reduce0([] (replica::database& db) {
+            std::unordered_map<std::pair<table_id, sstring>, int64_t, utils::tuple_hash> reads;
+            for (auto& hp : db.row_cache_tracker().hot_partitions()) {
+                reads.emplace(std::make_pair(hp.schema->id(), fmt::to_string(hp.key.key().with_schema(*hp.schema))), hp.count);
+            }
+            large_partitions_by_keyspace ret;
+            for (auto& lp : db.get_user_sstables_manager().get_large_data_handler().large_partitions()) {
+                if (!db.column_family_exists(lp.table)) {
+                    continue;
+                }
+                auto it = reads.find(std::make_pair(lp.table, lp.key));
+                int64_t nr_reads = it == reads.end() ? 0 : it->second;
+                ret[lp.keyspace_name].push_back(large_partition_info{
+                    .table_name = lp.table_name,
+                    .key = lp.key,
+                    .shard = int32_t(this_shard_id()),
+                    .size = int64_t(lp.size),
+                    .rows = int64_t(lp.rows),
+                    .writes = int64_t(lp.writes),
+                    .written_bytes = int64_t(lp.written_bytes),
+                    .reads = nr_reads,
+                    .cost = int64_t(lp.written_bytes + nr_reads * lp.size),
+                });
+            }
+            return ret;
+        }, large_partitions_by_keyspace(), [] (large_partitions_by_keyspace map, large_partitions_by_keyspace shard_map) {
+            for (auto& [ks, infos] : shard_map) {
+                auto& v = map[ks];
+                std::move(infos.begin(), infos.end(), std::back_inserter(v));
+            }
+            return map;
+        });
+
+        struct decorated_keyspace_name {
+            sstring name;
+            dht::decorated_key key;
+        };
+        std::vector<decorated_keyspace_name> keyspace_names;
+        for (auto& [name, _] : large_partitions) {
+            auto dk = make_partition_key(name);
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+            keyspace_names.push_back({name, std::move(dk)});
+        }
+
+        boost::sort(keyspace_names, [less = dht::ring_position_less_comparator(*_s)]
+                (const decorated_keyspace_name& l, const decorated_keyspace_name& r) {
+            return less(l.key, r.key);
+        });
+
+        for (auto& ks : keyspace_names) {
+            auto& infos = large_partitions[ks.name];
+            boost::sort(infos, [] (const large_partition_info& l, const large_partition_info& r) {
+                return std::tie(l.table_name, r.cost, l.key) < std::tie(r.table_name, l.cost, r.key);
+            });
+
+            co_await result.emit_partition_start(ks.key);
+            int32_t rank = 0;
+            for (size_t i = 0; i < infos.size(); ++i) {
+                auto& info = infos[i];
+                rank = i > 0 && infos[i - 1].table_name == info.table_name ? rank + 1 : 1;
+                clustering_row cr(make_clustering_key(info.table_name, rank));
+                set_cell(cr.cells(), "partition_key", info.key);
+                set_cell(cr.cells(), "shard", info.shard);
+                set_cell(cr.cells(), "partition_size", info.size);
+                set_cell(cr.cells(), "rows", info.rows);
+                set_cell(cr.cells(), "writes", info.writes);
+                set_cell(cr.cells(), "written_bytes", info.written_bytes);
+                set_cell(cr.cells(), "reads", info.reads);
+                set_cell(cr.cells(), "cost", info.cost);
+                co_await result.emit_row(std::move(cr));
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
 class protocol_servers_table : public memtable_filling_virtual_table {
 private:
     service::storage_service& _ss;
@@ -1039,6 +1283,8 @@ future<> initialize_virtual_tables(
     co_await add_table(std::make_unique<cluster_status_table>(dist_ss, dist_gossiper));
     co_await add_table(std::make_unique<token_ring_table>(db, ss));
     co_await add_table(std::make_unique<snapshots_table>(dist_db));
+    co_await add_table(std::make_unique<hot_partitions_table>(dist_db));
+    co_await add_table(std::make_unique<large_partitions_ranking_table>(dist_db));
     co_await add_table(std::make_unique<protocol_servers_table>(ss));
     co_await add_table(std::make_unique<runtime_info_table>(dist_db, ss));
     co_await add_table(std::make_unique<versions_table>());
@@ -14,7 +14,9 @@
 #include <seastar/util/optimized_optional.hh>
 #include "keys.hh"
 #include <memory>
+#include <span>
 #include <utility>
+#include <vector>
 #include <byteswap.h>
 #include "dht/token.hh"
 #include "dht/token-sharding.hh"
@@ -60,6 +62,18 @@ class i_partitioner {
     virtual token get_token(const schema& s, partition_key_view key) const = 0;
     virtual token get_token(const sstables::key_view& key) const = 0;
 
+    /**
+     * Computes the tokens of all given keys at once, setting tokens[i] to
+     * the token of keys[i]. The implementation is free to overlap the work
+     * for the individual keys, so this is cheaper than calling get_token()
+     * for each key when there are many keys.
+     */
+    virtual void get_tokens(const schema& s, std::span<const partition_key> keys, std::span<token> tokens) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            tokens[i] = get_token(s, keys[i]);
+        }
+    }
+
     // FIXME: token.tokenFactory
     //virtual token.tokenFactory gettokenFactory() = 0;
 
@@ -93,6 +107,12 @@ inline token get_token(const schema& s, partition_key_view key) {
     return s.get_partitioner().get_token(s, key);
 }
 
+inline std::vector<token> get_tokens(const schema& s, std::span<const partition_key> keys) {
+    std::vector<token> tokens(keys.size());
+    s.get_partitioner().get_tokens(s, keys, tokens);
+    return tokens;
+}
+
 dht::partition_range to_partition_range(dht::token_range);
 dht::partition_range_vector to_partition_ranges(const dht::token_range_vector& ranges, utils::can_yield can_yield = utils::can_yield::no);
 
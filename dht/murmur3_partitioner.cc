@@ -52,6 +52,31 @@ murmur3_partitioner::get_token(const schema& s, partition_key_view key) const {
     return get_token(hash[0]);
 }
 
+void
+murmur3_partitioner::get_tokens(const schema& s, std::span<const partition_key> keys, std::span<token> tokens) const {
+    // Linearize the legacy forms of all keys into a single buffer, so they can be hashed together.
+    size_t total_size = 0;
+    for (const auto& key : keys) {
+        total_size += key.legacy_form(s).size();
+    }
+    bytes buf(bytes::initialized_later(), total_size);
+    std::vector<bytes_view> legacy_keys;
+    legacy_keys.reserve(keys.size());
+    size_t offset = 0;
+    for (const auto& key : keys) {
+        auto&& legacy = key.legacy_form(s);
+        std::copy(legacy.begin(), legacy.end(), buf.begin() + offset);
+        legacy_keys.emplace_back(buf.data() + offset, legacy.size());
+        offset += legacy.size();
+    }
+
+    std::vector<std::array<uint64_t, 2>> hashes(keys.size());
+    utils::murmur_hash::hash3_x64_128(legacy_keys, 0, hashes);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        tokens[i] = get_token(hashes[i][0]);
+    }
+}
+
 using registry = class_registrator<i_partitioner, murmur3_partitioner>;
 static registry registrator("org.apache.cassandra.dht.Murmur3Partitioner");
 static registry registrator_short_name("Murmur3Partitioner");
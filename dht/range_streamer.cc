@@ -32,10 +32,23 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                                     const sstring& keyspace) {
     std::unordered_map<inet_address, dht::token_range_vector> range_fetch_map_map;
     const auto& topo = _token_metadata_ptr->get_topology();
+    // Sources are sorted by proximity, but many ranges share the same set of
+    // closest replicas. Always picking the first of them would funnel all those
+    // ranges through a single node, so among the equally close ones pick
+    // the one with the fewest ranges assigned so far.
+    auto proximity = [&] (inet_address ep) {
+        const auto& loc = topo.get_location(ep);
+        return loc.dc != _dr.dc ? 2 : loc.rack != _dr.rack ? 1 : 0;
+    };
+    auto nr_assigned = [&] (inet_address ep) -> size_t {
+        auto it = range_fetch_map_map.find(ep);
+        return it != range_fetch_map_map.end() ? it->second.size() : 0;
+    };
     for (const auto& x : ranges_with_sources) {
         const dht::token_range& range_ = x.first;
         const std::vector<inet_address>& addresses = x.second;
         bool found_source = false;
+        std::optional<inet_address> selected;
         for (const auto& address : addresses) {
             if (topo.is_me(address)) {
                 // If localhost is a source, we have found one, but we don't add it to the map to avoid streaming locally
@@ -56,9 +69,19 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                 continue;
             }
 
-            range_fetch_map_map[address].push_back(range_);
+            if (!selected) {
+                selected = address;
+            } else if (proximity(address) != proximity(*selected)) {
+                break; // ensure we only stream from the closest nodes
+            } else if (nr_assigned(address) < nr_assigned(*selected)) {
+                selected = address;
+            }
+        }
+
+        // ensure we only stream from one other node for each range
+        if (selected) {
+            range_fetch_map_map[*selected].push_back(range_);
             found_source = true;
-            break; // ensure we only stream from one other node for each range
         }
 
         if (!found_source) {
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <cmath>
+#include <deque>
 #include <unordered_set>
 
 #include <seastar/core/abort_source.hh>
@@ -14,6 +16,7 @@
 #include <seastar/core/sleep.hh>
 #include <seastar/core/on_internal_error.hh>
 #include <seastar/core/condition-variable.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/util/defer.hh>
 
@@ -51,6 +54,14 @@ struct listeners_liveness {
     std::unordered_map<pinger::endpoint_id, direct_failure_detector::endpoint_liveness> endpoint_liveness;
 };
 
+// Statistics of ping responses from an endpoint, used to compute its suspicion level.
+// See `failure_detector::suspicion()`.
+struct arrival_stats {
+    clock::timepoint_t last_response;
+    // Mean interval between consecutive responses.
+    clock::interval_t mean_interval;
+};
+
 enum class endpoint_update {
     added,
     removed
@@ -76,6 +87,17 @@ struct endpoint_worker {
     future<> ping_fiber() noexcept;
     future<> _ping_fiber = make_ready_future<>();
 
+    // Intervals between the most recent consecutive ping responses (at most `arrival_window_size` of them)
+    // and their sum, from which `arrival_stats::mean_interval` is computed.
+    static constexpr size_t arrival_window_size = 100;
+    std::deque<clock::interval_t> _arrival_intervals;
+    clock::interval_t _arrival_intervals_sum = 0;
+
+    // Updates the arrival statistics of the endpoint on this shard after a ping response received at `now`.
+    void record_response(clock::timepoint_t now);
+
+    seastar::metrics::metric_groups _metrics;
+
     // Waits for `endpoint_liveness::alive` to change and notifies listeners.
     // Updates `endpoint_liveness:marked_alive` to remember that a notification was sent.
     // The returned future is never exceptional.
@@ -135,6 +157,24 @@ struct failure_detector::impl {
     // The listeners registered on this shard.
     std::unordered_set<listener*> _registered;
 
+    // Arrival statistics of every endpoint in the detected set which responded to a ping at least once.
+    // Updated by the workers running on this shard for their endpoints and by `publish_arrivals_fiber()`
+    // running on other shards for the rest, so `failure_detector::suspicion()` can be answered on any shard.
+    std::unordered_map<pinger::endpoint_id, arrival_stats> _arrivals;
+
+    // Set when a worker running on this shard updates `_arrivals`.
+    bool _arrivals_changed = false;
+
+    // Once every `_ping_period`, sends the arrival statistics of endpoints pinged by this shard to other shards
+    // (if they changed), so the cross-shard traffic doesn't grow with the number of pings.
+    // The only exception possibly returned from the future is `sleep_aborted` when stopping the service.
+    future<> publish_arrivals_fiber();
+    future<> _publish_arrivals_fiber = make_ready_future<>();
+    abort_source _publish_arrivals_as;
+
+    // Whether workers created on this shard export metrics, see `failure_detector::register_metrics()`.
+    bool _metrics_enabled = false;
+
     // Listeners are unregistered by destroying their `subscription` objects.
     // The unregistering process requires cross-shard operations which we perform on this fiber.
     future<> _destroy_subscriptions = make_ready_future<>();
@@ -183,6 +223,10 @@ failure_detector::failure_detector(
 failure_detector::impl::impl(
     failure_detector& parent, pinger& pinger, clock& clock, clock::interval_t ping_period, clock::interval_t ping_timeout)
         : _parent(parent), _pinger(pinger), _clock(clock), _ping_period(ping_period), _ping_timeout(ping_timeout) {
+    if (smp::count > 1) {
+        _publish_arrivals_fiber = publish_arrivals_fiber();
+    }
+
     if (this_shard_id() != 0) {
         return;
     }
@@ -315,6 +359,16 @@ void failure_detector::impl::create_worker(pinger::endpoint_id ep) {
         }
     }
 
+    if (_metrics_enabled) {
+        namespace sm = seastar::metrics;
+        worker_it->second._metrics.add_group("direct_failure_detector", {
+            sm::make_gauge("phi", [this, ep] { return _parent.suspicion(ep); },
+                    sm::description("Suspicion level (phi) of the endpoint, grows with the time elapsed since its last ping response "
+                                    "relative to the mean interval between its responses"),
+                    {sm::label("endpoint")(fmt::to_string(ep))}),
+        });
+    }
+
     for (auto& g: guards) {
         g.cancel();
     }
@@ -366,13 +420,74 @@ future<> failure_detector::impl::destroy_worker(workers_map_t::iterator it) noex
     for (auto& [_, l]: _listeners_liveness) {
         l.endpoint_liveness.erase(it->first);
     }
+    auto ep = it->first;
     _shard_workers.erase(it);
+
+    // The worker is gone, so `publish_arrivals_fiber()` won't send its statistics anymore.
+    // Statistics it already sent reach other shards before this update, since cross-shard messages are delivered in order.
+    try {
+        co_await _parent.container().invoke_on_all([ep] (failure_detector& fd) {
+            fd._impl->_arrivals.erase(ep);
+        });
+    } catch (...) {
+        logger.error("unexpected exception when removing arrival statistics of endpoint {}: {}", ep, std::current_exception());
+    }
+}
+
+future<> failure_detector::impl::publish_arrivals_fiber() {
+    while (true) {
+        co_await _clock.sleep_until(_clock.now() + _ping_period, _publish_arrivals_as);
+        if (!std::exchange(_arrivals_changed, false)) {
+            continue;
+        }
+
+        std::vector<std::pair<pinger::endpoint_id, arrival_stats>> arrivals;
+        arrivals.reserve(_shard_workers.size());
+        for (auto& [ep, _]: _shard_workers) {
+            if (auto it = _arrivals.find(ep); it != _arrivals.end()) {
+                arrivals.emplace_back(ep, it->second);
+            }
+        }
+
+        try {
+            co_await _parent.container().invoke_on_others([&arrivals] (failure_detector& fd) {
+                for (auto& [ep, stats]: arrivals) {
+                    fd._impl->_arrivals[ep] = stats;
+                }
+            });
+        } catch (...) {
+            // Probably OOM. The statistics will be sent again after the next ping response.
+            logger.warn("failed to publish arrival statistics: {}", std::current_exception());
+        }
+    }
 }
 
 endpoint_worker::endpoint_worker(failure_detector::impl& fd, pinger::endpoint_id id)
         : _fd(fd), _id(id) {
 }
 
+void endpoint_worker::record_response(clock::timepoint_t now) {
+    auto [it, inserted] = _fd._arrivals.try_emplace(_id, arrival_stats{now, _fd._ping_period});
+    if (!inserted) {
+        auto interval = now - it->second.last_response;
+        // Longer intervals span failed pings; counting them would make the mean, and so the suspicion level,
+        // insensitive for a long time after the endpoint recovers.
+        if (interval <= _fd._ping_period + _fd._ping_timeout) {
+            _arrival_intervals.push_back(interval);
+            _arrival_intervals_sum += interval;
+            if (_arrival_intervals.size() > arrival_window_size) {
+                _arrival_intervals_sum -= _arrival_intervals.front();
+                _arrival_intervals.pop_front();
+            }
+        }
+        it->second.last_response = now;
+        if (!_arrival_intervals.empty()) {
+            it->second.mean_interval = _arrival_intervals_sum / clock::interval_t(_arrival_intervals.size());
+        }
+    }
+    _fd._arrivals_changed = true;
+}
+
 endpoint_worker::~endpoint_worker() {
     assert(_ping_fiber.available());
     assert(_notify_fiber.available());
@@ -457,6 +572,29 @@ void failure_detector::impl::remove_listener(listener_id id) {
     }
 }
 
+float failure_detector::suspicion(pinger::endpoint_id ep) const noexcept {
+    if (!_impl) {
+        return 0;
+    }
+
+    auto it = _impl->_arrivals.find(ep);
+    if (it == _impl->_arrivals.end() || it->second.mean_interval <= 0) {
+        return 0;
+    }
+
+    // For exponentially distributed intervals with mean `m`, the probability of no response
+    // for time `t` is `e^(-t/m)`, so `phi = -log10(e^(-t/m)) = t / (m * ln(10))`.
+    auto elapsed = std::max(_impl->_clock.now() - it->second.last_response, clock::interval_t(0));
+    return float(elapsed) / (float(it->second.mean_interval) * std::log(10.0f));
+}
+
+void failure_detector::register_metrics() {
+    if (!_impl->_shard_workers.empty()) {
+        throw std::runtime_error{"direct_failure_detector: trying to register metrics after endpoints were added"};
+    }
+    _impl->_metrics_enabled = true;
+}
+
 void failure_detector::add_endpoint(pinger::endpoint_id ep) {
     if (_impl) {
         _impl->send_update_endpoint(ep, endpoint_update::added);
@@ -572,6 +710,7 @@ future<> endpoint_worker::ping_fiber() noexcept {
         bool alive_changed = false;
         if (success) {
             last_response = clock.now();
+            record_response(last_response);
 
             for (auto& [_, l]: _fd._listeners_liveness) {
                 bool& alive = l.endpoint_liveness[_id].alive;
@@ -682,6 +821,16 @@ future<> failure_detector::stop() {
         // All subscriptions must be destroyed before stopping the fd.
         assert(fd._impl->_registered.empty());
 
+        fd._impl->_publish_arrivals_as.request_abort();
+        try {
+            co_await std::exchange(fd._impl->_publish_arrivals_fiber, make_ready_future<>());
+        } catch (sleep_aborted&) {
+            // Expected.
+        } catch (...) {
+            // Unexpected exception, log and continue.
+            logger.error("unexpected exception when stopping publish_arrivals_fiber: {}", std::current_exception());
+        }
+
         // There are no concurrent `{create,destroy}_worker` calls running since we waited for `update_endpoint_fiber` to finish.
         while (!fd._impl->_shard_workers.empty()) {
             co_await fd._impl->destroy_worker(fd._impl->_shard_workers.begin());
@@ -700,6 +849,7 @@ failure_detector::impl::~impl() {
     assert(_shard_workers.empty());
     assert(_destroy_subscriptions.available());
     assert(_update_endpoint_fiber.available());
+    assert(_publish_arrivals_fiber.available());
 }
 
 failure_detector::~failure_detector() {
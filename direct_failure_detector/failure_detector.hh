@@ -171,6 +171,22 @@ class failure_detector : public seastar::peering_sharded_service<failure_detecto
     // If the endpoint is considered alive when removed, a final mark_dead notification is sent to all listeners.
     // Run only on shard 0.
     void remove_endpoint(pinger::endpoint_id);
+
+    // The suspicion level (phi) of an endpoint in the detected set.
+    //
+    // Computed from the distribution of intervals between consecutive ping responses from the endpoint,
+    // approximated with an exponential distribution: phi = -log10(P(no response for the time elapsed since the last one)).
+    // Grows linearly with the time elapsed since the last response, so it can be used to avoid
+    // an endpoint that is becoming unresponsive well before any listener's threshold is crossed.
+    //
+    // Returns 0 for endpoints which are not in the detected set or never responded.
+    // Can be called on any shard. Arrival statistics are published to other shards once every `ping_period`,
+    // so the result may lag behind the shard pinging the endpoint by that much.
+    float suspicion(pinger::endpoint_id) const noexcept;
+
+    // Export the suspicion level of every endpoint pinged by this shard as a metric.
+    // Must be called before any endpoints are added to the detected set.
+    void register_metrics();
 };
 
 } // namespace direct_failure_detector
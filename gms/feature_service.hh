@@ -126,6 +126,25 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature group0_schema_versioning { *this, "GROUP0_SCHEMA_VERSIONING"sv };
     gms::feature supports_consistent_topology_changes { *this, "SUPPORTS_CONSISTENT_TOPOLOGY_CHANGES"sv };
     gms::feature host_id_based_hinted_handoff { *this, "HOST_ID_BASED_HINTED_HANDOFF"sv };
+    gms::feature file_stream { *this, "FILE_STREAM"sv };
+    // Nodes can execute a forward_request with a WHERE clause to filter by.
+    gms::feature parallelized_aggregation_with_filtering { *this, "PARALLELIZED_AGGREGATION_WITH_FILTERING"sv };
+    // Nodes report the rates of requests to tablet-based tables through the table_ops_rates verb.
+    gms::feature table_ops_rates { *this, "TABLE_OPS_RATES"sv };
+    // Coordinators can send several mutations to a replica in one mutation_batch verb.
+    gms::feature mutation_batch { *this, "MUTATION_BATCH"sv };
+    // Nodes can read sstables compressed with a zstd dictionary stored in CompressionInfo.
+    gms::feature zstd_compression_dictionaries { *this, "ZSTD_COMPRESSION_DICTIONARIES"sv };
+    // Nodes can read sstables with the blocked bloom filter layout, and know the bloom_filter schema extension.
+    gms::feature blocked_bloom_filters { *this, "BLOCKED_BLOOM_FILTERS"sv };
+    // Repair masters tell the followers whether to read only the unrepaired sstables.
+    gms::feature incremental_repair { *this, "INCREMENTAL_REPAIR"sv };
+    // Nodes know the 'counting' option of per_partition_rate_limit.
+    gms::feature per_partition_rate_limit_sketch { *this, "PER_PARTITION_RATE_LIMIT_SKETCH"sv };
+    // Nodes know the cold_* compression options.
+    gms::feature cold_sstable_compression { *this, "COLD_SSTABLE_COMPRESSION"sv };
+    // Nodes know the min_compress_ratio compression option, and can read sstables with uncompressed chunks.
+    gms::feature min_compress_ratio { *this, "MIN_COMPRESS_RATIO"sv };
 
     // A feature just for use in tests. It must not be advertised unless
     // the "features_enable_test_feature" injection is enabled.
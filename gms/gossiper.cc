@@ -123,41 +123,34 @@ gossiper::gossiper(abort_source& as, const locator::shared_token_metadata& stm,
 }
 
 /*
- * First construct a map whose key is the endpoint in the GossipDigest and the value is the
- * GossipDigest itself. Then build a list of version differences i.e difference between the
- * version in the GossipDigest and the version in the local state for a given InetAddress.
- * Sort this list. Now loop through the sorted list and retrieve the GossipDigest corresponding
- * to the endpoint from the map that was initially constructed.
+ * Drops the digests of endpoints whose state we have in the same generation and version,
+ * since there is nothing to exchange for them, and sorts the rest in descending order of the
+ * difference between the version in the digest and the version of the local state. That takes
+ * care of the endpoints which are far behind w.r.t this local endpoint first.
+ *
+ * In a stable cluster, most digests are dropped, so the cost of handling a syn message
+ * scales with the number of endpoints which changed rather than with the cluster size.
 */
 void gossiper::do_sort(utils::chunked_vector<gossip_digest>& g_digest_list) const {
-    /* Construct a map of endpoint to GossipDigest. */
-    std::map<inet_address, gossip_digest> ep_to_digest_map;
-    for (auto g_digest : g_digest_list) {
-        ep_to_digest_map.emplace(g_digest.get_endpoint(), g_digest);
-    }
-
-    /*
-     * These digests have their maxVersion set to the difference of the version
-     * of the local EndpointState and the version found in the GossipDigest.
-    */
-    utils::chunked_vector<gossip_digest> diff_digests;
-    for (auto g_digest : g_digest_list) {
-        auto ep = g_digest.get_endpoint();
-        auto ep_state = this->get_endpoint_state_ptr(ep);
+    utils::chunked_vector<std::pair<int32_t, gossip_digest>> diff_digests;
+    for (const auto& g_digest : g_digest_list) {
+        auto ep_state = this->get_endpoint_state_ptr(g_digest.get_endpoint());
         version_type version = ep_state ? this->get_max_endpoint_state_version(*ep_state) : version_type();
+        if (ep_state && ep_state->get_heart_beat_state().get_generation() == g_digest.get_generation()
+                && version == g_digest.get_max_version()) {
+            continue;
+        }
         int32_t diff_version = ::abs(version - g_digest.get_max_version());
-        diff_digests.emplace_back(gossip_digest(ep, g_digest.get_generation(), version_type(diff_version)));
+        diff_digests.emplace_back(diff_version, g_digest);
     }
 
+    std::stable_sort(diff_digests.begin(), diff_digests.end(), [] (const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
     g_digest_list.clear();
-    std::sort(diff_digests.begin(), diff_digests.end());
-    int size = diff_digests.size();
-    /*
-     * Report the digests in descending order. This takes care of the endpoints
-     * that are far behind w.r.t this local endpoint
-    */
-    for (int i = size - 1; i >= 0; --i) {
-        g_digest_list.emplace_back(ep_to_digest_map[diff_digests[i].get_endpoint()]);
+    for (auto& [diff_version, g_digest] : diff_digests) {
+        g_digest_list.emplace_back(std::move(g_digest));
     }
 }
 
@@ -237,10 +230,14 @@ future<> gossiper::handle_syn_msg(msg_addr from, gossip_digest_syn syn_msg) {
 future<> gossiper::do_send_ack_msg(msg_addr from, gossip_digest_syn syn_msg) {
     return futurize_invoke([this, from, syn_msg = std::move(syn_msg)] () mutable {
         auto g_digest_list = syn_msg.get_gossip_digests();
+        // An empty syn is a shadow request, see examine_gossiper().
+        bool shadow_request = g_digest_list.empty();
         do_sort(g_digest_list);
         utils::chunked_vector<gossip_digest> delta_gossip_digest_list;
         std::map<inet_address, endpoint_state> delta_ep_state_map;
-        this->examine_gossiper(g_digest_list, delta_gossip_digest_list, delta_ep_state_map);
+        if (shadow_request || !g_digest_list.empty()) {
+            this->examine_gossiper(g_digest_list, delta_gossip_digest_list, delta_ep_state_map);
+        }
         gms::gossip_digest_ack ack_msg(std::move(delta_gossip_digest_list), std::move(delta_ep_state_map));
         logger.debug("Calling do_send_ack_msg to node {}, syn_msg={}, ack_msg={}", from, syn_msg, ack_msg);
         return _messaging.send_gossip_digest_ack(from, std::move(ack_msg));
@@ -1291,9 +1288,6 @@ void gossiper::quarantine_endpoint(inet_address endpoint, clk::time_point quaran
 }
 
 void gossiper::make_random_gossip_digest(utils::chunked_vector<gossip_digest>& g_digests) const {
-    generation_type generation;
-    version_type max_version;
-
     // local epstate will be part of _endpoint_state_map
     utils::chunked_vector<inet_address> endpoints;
     for (auto&& x : _endpoint_state_map) {
@@ -1301,6 +1295,8 @@ void gossiper::make_random_gossip_digest(utils::chunked_vector<gossip_digest>& g
     }
     std::shuffle(endpoints.begin(), endpoints.end(), _random_engine);
     for (auto& endpoint : endpoints) {
+        generation_type generation;
+        version_type max_version;
         auto es = get_endpoint_state_ptr(endpoint);
         if (es) {
             auto& eps = *es;
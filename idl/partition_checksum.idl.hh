@@ -41,6 +41,7 @@ struct get_sync_boundary_response {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_bucketed_set_rpc_stream,
 };
 
 enum class repair_stream_cmd : uint8_t {
@@ -147,5 +148,18 @@ struct repair_flush_hints_batchlog_request {
 struct repair_flush_hints_batchlog_response {
 };
 
+struct repair_get_bucket_row_hashes_request {
+    uint32_t repair_meta_id;
+    uint32_t dst_cpu_id;
+    std::vector<repair_sync_boundary> bucket_boundaries;
+    std::vector<repair_hash> bucket_hashes;
+};
+
+struct repair_get_bucket_row_hashes_response {
+    std::vector<uint32_t> mismatched_buckets;
+    std::vector<repair_hash> row_hashes;
+};
+
 verb [[with_client_info]] repair_update_system_table (repair_update_system_table_request req [[ref]]) -> repair_update_system_table_response;
 verb [[with_client_info]] repair_flush_hints_batchlog (repair_flush_hints_batchlog_request req [[ref]]) -> repair_flush_hints_batchlog_response;
+verb [[with_client_info]] repair_get_bucket_row_hashes (repair_get_bucket_row_hashes_request req [[ref]]) -> repair_get_bucket_row_hashes_response;
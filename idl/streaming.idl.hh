@@ -55,4 +55,12 @@ enum class stream_mutation_fragments_cmd : uint8_t {
     end_of_stream,
 };
 
+enum class stream_blob_cmd : uint8_t {
+    error,
+    data,
+    end_of_file,
+    end_of_stream,
+    not_eligible,
+};
+
 }
@@ -295,6 +295,11 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
         }
     }
 
+    // Included columns are copied to the index view, so that queries which
+    // select only them can be answered without reading the base table.
+    for (auto* def : target_parser::parse_included_columns(*schema, im)) {
+        builder.with_column(def->name(), def->type, column_kind::regular_column);
+    }
     if (index_target->is_primary_key()) {
         for (auto& def : schema->regular_columns()) {
             db::view::create_virtual_column(builder, def.name(), def.type);
@@ -30,6 +30,11 @@ struct target_parser {
     static sstring get_target_column_name_from_string(const sstring& targets);
 
     static sstring serialize_targets(const std::vector<::shared_ptr<cql3::statements::index_target>>& targets);
+
+    // Columns of the index_target::included_columns_option_name option, empty if the index has none.
+    static std::vector<const column_definition*> parse_included_columns(const schema& schema, const index_metadata& im);
+
+    static sstring serialize_included_columns(const std::vector<::shared_ptr<cql3::column_identifier>>& columns);
 };
 
 }
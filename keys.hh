@@ -611,10 +611,7 @@ class prefix_compound_wrapper : public compound_wrapper<TopLevel, TopLevelView>
         { }
 
         bool operator()(const TopLevel& k1, const TopLevel& k2) const {
-            return prefix_equality_tri_compare(prefix_type->types().begin(),
-                prefix_type->begin(k1.representation()), prefix_type->end(k1.representation()),
-                prefix_type->begin(k2.representation()), prefix_type->end(k2.representation()),
-                tri_compare) < 0;
+            return prefix_type->prefix_equality_compare(k1.representation(), k2.representation()) < 0;
         }
     };
 
@@ -627,10 +624,7 @@ class prefix_compound_wrapper : public compound_wrapper<TopLevel, TopLevelView>
         { }
 
         std::strong_ordering operator()(const TopLevel& k1, const TopLevel& k2) const {
-            return prefix_equality_tri_compare(prefix_type->types().begin(),
-                prefix_type->begin(k1.representation()), prefix_type->end(k1.representation()),
-                prefix_type->begin(k2.representation()), prefix_type->end(k2.representation()),
-                tri_compare);
+            return prefix_type->prefix_equality_compare(k1.representation(), k2.representation());
         }
     };
 };
@@ -16,6 +16,7 @@
 #include "utils/ascii.hh"
 #include "utils/date.h"
 #include <seastar/core/align.hh>
+#include <seastar/core/coroutine.hh>
 #include <lua.hpp>
 #include "db/config.hh"
 
@@ -884,8 +885,9 @@ static data_value convert_from_lua(lua_State* l, const data_type& type) {
     return ::visit(*type, from_lua_visitor{l});
 }
 
-static bytes_opt convert_return(lua_slice_state &l, const data_type& return_type) {
-    int num_return_vals = lua_gettop(l);
+// Values below base on the stack are not part of the return values
+static bytes_opt convert_return(lua_slice_state &l, const data_type& return_type, int base = 0) {
+    int num_return_vals = lua_gettop(l) - base;
     if (num_return_vals != 1) {
         throw exceptions::invalid_request_exception(
             format("{} values returned, expected {}", num_return_vals, 1));
@@ -1049,23 +1051,13 @@ static void push_argument(lua_State* l, const data_value& arg) {
     ::visit(arg, to_lua_visitor{l});
 }
 
-// run the script for at most max_instructions
-future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg) {
-    lua_slice_state l = load_script(cfg, bitcode);
-    unsigned nargs = values.size();
-    if (!lua_checkstack(l, nargs)) {
-        throw std::runtime_error("could push args to the stack");
-    }
-    for (const data_value& arg : values) {
-        push_argument(l, arg);
-    }
+using duration = std::chrono::system_clock::duration;
 
-    // We don't update the timeout once we start executing the function
-    using millisecond = std::chrono::duration<double, std::milli>;
-    using duration = std::chrono::system_clock::duration;
+// Resumes the function pushed below its nargs arguments on the top of the stack until it returns
+// or the timeout expires. The stack holds base values below the function.
+static future<bytes_opt> resume_script(lua_slice_state& l, unsigned nargs, int base, data_type return_type, duration timeout) {
     duration elapsed{0};
-    duration timeout = std::chrono::duration_cast<duration>(millisecond(cfg.timeout_in_ms));
-    return repeat_until_value([l = std::move(l), elapsed, return_type, nargs, timeout = std::move(timeout)] () mutable {
+    return repeat_until_value([&l, elapsed, return_type = std::move(return_type), nargs, base, timeout] () mutable {
         // Set the hook before resuming. We have to do it here since the hook can reset itself
         // if it detects we are spending too much time in C.
         // The hook will be called after 1000 instructions.
@@ -1074,7 +1066,7 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
         LUA_504_PLUS(int nresults;)
         switch (lua_resume(l, nullptr, nargs LUA_504_PLUS(, &nresults))) {
         case LUA_OK:
-            return make_ready_future<std::optional<bytes_opt>>(convert_return(l, return_type));
+            return make_ready_future<std::optional<bytes_opt>>(convert_return(l, return_type, base));
         case LUA_YIELD: {
             nargs = 0;
             elapsed += ::now() - start;
@@ -1091,6 +1083,53 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
     });
 }
 
+// We don't update the timeout once we start executing the function
+static duration get_timeout(const lua::runtime_config& cfg) {
+    return std::chrono::duration_cast<duration>(millisecond(cfg.timeout_in_ms));
+}
+
+// run the script for at most max_instructions
+future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg) {
+    lua_slice_state l = load_script(cfg, bitcode);
+    unsigned nargs = values.size();
+    if (!lua_checkstack(l, nargs)) {
+        throw std::runtime_error("could push args to the stack");
+    }
+    for (const data_value& arg : values) {
+        push_argument(l, arg);
+    }
+
+    return do_with(std::move(l), [nargs, return_type = std::move(return_type), timeout = get_timeout(cfg)] (lua_slice_state& l) mutable {
+        return resume_script(l, nargs, 0, std::move(return_type), timeout);
+    });
+}
+
+future<bytes_opt> lua::run_script_fold(lua::bitcode_view bitcode, bytes_opt state, std::span<const std::vector<data_value>> rows,
+        data_type return_type, bool called_on_null_input, const lua::runtime_config& cfg) {
+    // The state is loaded once for the whole batch. The loaded function stays at the
+    // bottom of the stack and a copy of it is called for each row.
+    lua_slice_state l = load_script(cfg, bitcode);
+    auto timeout = get_timeout(cfg);
+    for (const auto& values : rows) {
+        if (!called_on_null_input && (!state || std::ranges::any_of(values, [] (const data_value& v) { return v.is_null(); }))) {
+            // The state stays null for all the remaining rows
+            co_return std::nullopt;
+        }
+        lua_settop(l, 1);
+        unsigned nargs = values.size() + 1;
+        if (!lua_checkstack(l, nargs + 1)) {
+            throw std::runtime_error("could push args to the stack");
+        }
+        lua_pushvalue(l, 1);
+        push_argument(l, state ? return_type->deserialize(*state) : data_value::make_null(return_type));
+        for (const data_value& arg : values) {
+            push_argument(l, arg);
+        }
+        state = co_await resume_script(l, nargs, 1, return_type, timeout);
+    }
+    co_return state;
+}
+
 namespace lua {
 
 void register_metatables(lua_State* l) {
@@ -11,6 +11,7 @@
 #include "types/types.hh"
 #include "utils/updateable_value.hh"
 #include <seastar/core/future.hh>
+#include <span>
 
 namespace db {
 class config;
@@ -31,4 +32,9 @@ struct runtime_config {
 sstring compile(const runtime_config& cfg, const std::vector<sstring>& arg_names, sstring script);
 seastar::future<bytes_opt> run_script(bitcode_view bitcode, const std::vector<data_value>& values,
                                       data_type return_type, const runtime_config& cfg);
+// Runs the script once for each of the rows, passing the result of the previous call (or the
+// initial state for the first one) as the first argument, and returns the result of the last call.
+// Equivalent to calling run_script for each row, but the lua state is set up only once.
+seastar::future<bytes_opt> run_script_fold(bitcode_view bitcode, bytes_opt state, std::span<const std::vector<data_value>> rows,
+                                           data_type return_type, bool called_on_null_input, const runtime_config& cfg);
 }
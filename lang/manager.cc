@@ -26,6 +26,7 @@ manager::manager(config cfg)
             _alien_runner = std::make_shared<wasm::alien_thread_runner>();
         }
         _instance_cache.emplace(cfg.wasm->cache_size, cfg.wasm->cache_instance_size, cfg.wasm->cache_timer_period);
+        _wasm_precompiled_cache_dir = cfg.wasm->precompiled_cache_dir;
     }
 }
 
@@ -59,7 +60,7 @@ future<manager::context> manager::create(sstring language, sstring name, const s
         ctx = std::move(lua_ctx);
     } else if (language == "wasm") {
        // FIXME: need better way to test wasm compilation without real_database()
-       auto wasm_ctx = wasm::context(**_engine, std::move(name), *_instance_cache, wasm_yield_fuel, wasm_total_fuel);
+       auto wasm_ctx = wasm::context(**_engine, std::move(name), *_instance_cache, wasm_yield_fuel, wasm_total_fuel, _wasm_precompiled_cache_dir);
        try {
             co_await ::wasm::precompile(*_alien_runner, wasm_ctx, arg_names, std::move(script));
        } catch (const wasm::exception& we) {
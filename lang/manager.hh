@@ -24,6 +24,7 @@ class manager : public seastar::peering_sharded_service<manager> {
     std::shared_ptr<rust::Box<wasmtime::Engine>> _engine;
     std::optional<wasm::instance_cache> _instance_cache;
     std::shared_ptr<wasm::alien_thread_runner> _alien_runner;
+    std::filesystem::path _wasm_precompiled_cache_dir;
 
 public:
     const uint64_t wasm_yield_fuel;
@@ -41,6 +42,8 @@ class manager : public seastar::peering_sharded_service<manager> {
         std::chrono::milliseconds cache_timer_period;
         uint64_t yield_fuel;
         uint64_t total_fuel;
+        // Where precompiled modules are kept across restarts, not kept if empty.
+        std::filesystem::path precompiled_cache_dir;
     };
     struct lua_config {
         unsigned max_bytes;
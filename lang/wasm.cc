@@ -19,17 +19,21 @@
 #include <seastar/coroutine/exception.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include "lang/wasm_alien_thread_runner.hh"
+#include "utils/hashers.hh"
+#include <fstream>
 
 logging::logger wasm_logger("wasm");
 
 namespace wasm {
 
-context::context(wasmtime::Engine& engine_ptr, std::string name, instance_cache& cache, uint64_t yield_fuel, uint64_t total_fuel)
+context::context(wasmtime::Engine& engine_ptr, std::string name, instance_cache& cache, uint64_t yield_fuel, uint64_t total_fuel,
+        std::filesystem::path precompiled_cache_dir)
     : engine_ptr(engine_ptr)
     , function_name(name)
     , cache(cache)
     , yield_fuel(yield_fuel)
-    , total_fuel(total_fuel) {
+    , total_fuel(total_fuel)
+    , precompiled_cache_dir(std::move(precompiled_cache_dir)) {
 }
 
 static constexpr size_t WASM_PAGE_SIZE = 64 * 1024;
@@ -216,10 +220,59 @@ struct from_val_visitor {
     }
 };
 
+// Runs in the alien thread, so it uses blocking I/O.
+//
+// A precompiled module file starts with the SHA-256 digest of the rest of the file,
+// which wasmtime requires to be an unmodified result of a previous compilation.
+static rust::Box<wasmtime::Module> create_module(wasmtime::Engine& engine, const std::string& script, const std::filesystem::path& cache_dir) {
+    if (cache_dir.empty()) {
+        return wasmtime::create_module(engine, rust::Str(script.data(), script.size()));
+    }
+    auto path = cache_dir / fmt::format("{}.cwasm", to_hex(sha256_hasher::calculate(script)));
+    if (std::ifstream in(path, std::ios::binary); in) {
+        std::string data(std::istreambuf_iterator<char>(in), {});
+        constexpr size_t digest_size = 32;
+        auto precompiled = std::string_view(data).substr(std::min(data.size(), digest_size));
+        auto digest = sha256_hasher::calculate(precompiled);
+        if (data.size() > digest_size && std::equal(digest.begin(), digest.end(), reinterpret_cast<const int8_t*>(data.data()))) {
+            try {
+                return wasmtime::create_module_from_precompiled(engine,
+                        rust::Slice<const uint8_t>(reinterpret_cast<const uint8_t*>(precompiled.data()), precompiled.size()));
+            } catch (const rust::Error& e) {
+                wasm_logger.info("Discarding precompiled module {}: {}", path.native(), e.what());
+            }
+        } else {
+            wasm_logger.warn("Discarding corrupted precompiled module {}", path.native());
+        }
+    }
+
+    auto module = wasmtime::create_module(engine, rust::Str(script.data(), script.size()));
+    try {
+        auto precompiled = module->precompiled();
+        auto digest = sha256_hasher::calculate(std::string_view(reinterpret_cast<const char*>(precompiled.data()), precompiled.size()));
+        auto tmp_path = path;
+        tmp_path += ".tmp";
+        std::filesystem::create_directories(cache_dir);
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(digest.data()), digest.size());
+            out.write(reinterpret_cast<const char*>(precompiled.data()), precompiled.size());
+            out.close();
+            if (!out) {
+                throw std::runtime_error(fmt::format("failed to write {}", tmp_path.native()));
+            }
+        }
+        std::filesystem::rename(tmp_path, path);
+    } catch (...) {
+        wasm_logger.warn("Failed to save precompiled module {}: {}", path.native(), std::current_exception());
+    }
+    return module;
+}
+
 seastar::future<> precompile(alien_thread_runner& alien_runner, context& ctx, const std::vector<sstring>& arg_names, std::string script) {
     seastar::promise<rust::Box<wasmtime::Module>> done;
-    alien_runner.submit(done, [&engine_ptr = ctx.engine_ptr, script = std::move(script)] {
-        return wasmtime::create_module(engine_ptr, rust::Str(script.data(), script.size()));
+    alien_runner.submit(done, [&engine_ptr = ctx.engine_ptr, script = std::move(script), cache_dir = ctx.precompiled_cache_dir] {
+        return create_module(engine_ptr, script, cache_dir);
     });
 
     ctx.module = co_await done.get_future();
@@ -319,4 +372,37 @@ seastar::future<bytes_opt> run_script(const db::functions::function_name& name,
     }
     return make_ready_future<bytes_opt>(ret);
 }
+
+seastar::future<bytes_opt> run_script_fold(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, bytes_opt state, std::span<const std::vector<bytes_opt>> rows, data_type return_type, bool allow_null_input) {
+    wasm::instance_cache::value_type func_inst;
+    std::exception_ptr ex;
+    std::vector<bytes_opt> params;
+    try {
+        // The instance is taken from the cache once for the whole batch
+        func_inst = ctx.cache.get(name, arg_types, ctx).get();
+        for (const auto& row : rows) {
+            if (!allow_null_input && (!state || std::ranges::any_of(row, [] (const bytes_opt& b) { return !b; }))) {
+                // The state stays null for all the remaining rows
+                state = std::nullopt;
+                break;
+            }
+            params.clear();
+            params.push_back(std::move(state));
+            params.insert(params.end(), row.begin(), row.end());
+            state = wasm::run_script(ctx, *func_inst->instance->store, *func_inst->instance->instance, *func_inst->instance->func, arg_types, params, return_type, allow_null_input).get();
+        }
+    } catch (const wasm::instance_corrupting_exception& e) {
+        func_inst->instance = std::nullopt;
+        ex = std::current_exception();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (func_inst) {
+        ctx.cache.recycle(func_inst);
+    }
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    return make_ready_future<bytes_opt>(std::move(state));
+}
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <filesystem>
 #include <span>
 #include "types/types.hh"
 #include <seastar/core/future.hh>
@@ -41,12 +42,20 @@ struct context {
     instance_cache& cache;
     uint64_t yield_fuel;
     uint64_t total_fuel;
+    // Where precompiled modules are kept across restarts, keyed by the hash of their source.
+    // Empty if they are not kept.
+    std::filesystem::path precompiled_cache_dir;
 
-    context(wasmtime::Engine& engine_ptr, std::string name, instance_cache& cache, uint64_t yield_fuel, uint64_t total_fuel);
+    context(wasmtime::Engine& engine_ptr, std::string name, instance_cache& cache, uint64_t yield_fuel, uint64_t total_fuel,
+            std::filesystem::path precompiled_cache_dir = {});
 };
 
 seastar::future<> precompile(alien_thread_runner& alien_runner, context& ctx, const std::vector<sstring>& arg_names, std::string script);
 
 seastar::future<bytes_opt> run_script(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, std::span<const bytes_opt> params, data_type return_type, bool allow_null_input);
 
+// Calls the function for each of the rows with the result of the previous call (or the initial
+// state) as the first argument and returns the result of the last call, using a single instance.
+seastar::future<bytes_opt> run_script_fold(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, bytes_opt state, std::span<const std::vector<bytes_opt>> rows, data_type return_type, bool allow_null_input);
+
 }
@@ -97,7 +97,7 @@ class load_sketch {
             co_await populate_table(tmap, host);
         } else {
             for (auto&& [table, tmap]: _tm->tablets().all_tables()) {
-                co_await populate_table(tmap, host);
+                co_await populate_table(*tmap, host);
             }
         }
 
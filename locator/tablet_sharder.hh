@@ -8,19 +8,30 @@
 
 #pragma once
 
+#include <limits>
+
 #include "dht/token-sharding.hh"
 #include "locator/tablets.hh"
 #include "locator/token_metadata.hh"
 #include "utils/to_string.hh"
+#include "utils/chunked_vector.hh"
 
 namespace locator {
 
 /// Implements sharder object which reflects assignment of tablets of a given table to local shards.
 /// Token ranges which don't have local tablets are reported to belong to shard 0.
+///
+/// Read routing is memoized per tablet, which is valid because token_metadata is immutable.
 class tablet_sharder : public dht::sharder {
+    // Compact cache of shard_for_reads() results on _host, indexed by tablet_id.
+    using read_shard_cache = utils::chunked_vector<uint16_t>;
+    static constexpr uint16_t not_cached = std::numeric_limits<uint16_t>::max();
+    static constexpr uint16_t no_shard = not_cached - 1;
+
     const token_metadata& _tm;
     table_id _table;
     mutable const tablet_map* _tmap = nullptr;
+    mutable read_shard_cache _read_shards;
     host_id _host;
 private:
     // Tablet map is lazily initialized to avoid exceptions during effective_replication_map construction
@@ -28,7 +39,23 @@ class tablet_sharder : public dht::sharder {
     void ensure_tablet_map() const {
         if (!_tmap) {
             _tmap = &_tm.tablets().get_tablet_map(_table);
+            _read_shards = read_shard_cache(_tmap->tablet_count(), not_cached);
+        }
+    }
+
+    std::optional<shard_id> cached_shard_for_reads(tablet_id tid) const {
+        auto& cached = _read_shards[size_t(tid)];
+        if (cached == not_cached) {
+            auto shard = shard_for_reads(tid, _host);
+            if (shard && *shard >= no_shard) [[unlikely]] {
+                return shard;
+            }
+            cached = shard ? uint16_t(*shard) : no_shard;
+        }
+        if (cached == no_shard) {
+            return std::nullopt;
         }
+        return cached;
     }
 
     std::optional<unsigned> get_shard(const tablet_replica_set& replicas, host_id host) const {
@@ -113,7 +140,7 @@ class tablet_sharder : public dht::sharder {
         // FIXME: Consider throwing when there is no owning shard on the current host rather than returning 0.
         // It's a coordination mistake to route requests to non-owners. Topology coordinator should synchronize
         // with request coordinators before moving the shard away.
-        auto shard = shard_for_reads(tid, _host).value_or(0);
+        auto shard = cached_shard_for_reads(tid).value_or(0);
         tablet_logger.trace("[{}] shard_of({}) = {}, tablet={}", _table, t, shard, tid);
         return shard;
     }
@@ -130,7 +157,7 @@ class tablet_sharder : public dht::sharder {
         ensure_tablet_map();
         std::optional<tablet_id> tb = _tmap->get_tablet_id(t);
         while ((tb = _tmap->next_tablet(*tb))) {
-            auto r = shard_for_reads(*tb, _host);
+            auto r = cached_shard_for_reads(*tb);
             auto next = _tmap->get_first_token(*tb);
             tablet_logger.trace("[{}] token_for_next_shard({}) = {{{}, {}}}, tablet={}", _table, t, next, r, *tb);
             return dht::shard_and_token{r.value_or(0), next};
@@ -173,28 +173,56 @@ tablet_transition_info migration_to_transition_info(const tablet_info& ti, const
 
 const tablet_map& tablet_metadata::get_tablet_map(table_id id) const {
     try {
-        return _tablets.at(id);
+        return *_tablets.at(id);
     } catch (const std::out_of_range&) {
         throw_with_backtrace<std::runtime_error>(format("Tablet map not found for table {}", id));
     }
 }
 
-tablet_map& tablet_metadata::get_tablet_map(table_id id) {
-    return const_cast<tablet_map&>(
-        const_cast<const tablet_metadata*>(this)->get_tablet_map(id));
+void tablet_metadata::set_tablet_map(table_id id, tablet_map map) {
+    _tablets.insert_or_assign(id, make_foreign(make_lw_shared<const tablet_map>(std::move(map))));
 }
 
-void tablet_metadata::set_tablet_map(table_id id, tablet_map map) {
-    _tablets.insert_or_assign(id, std::move(map));
+future<tablet_metadata> tablet_metadata::copy() const {
+    tablet_metadata copy;
+    copy._balancing_enabled = _balancing_enabled;
+    copy._tablets.reserve(_tablets.size());
+    for (const auto& [id, map] : _tablets) {
+        copy._tablets.emplace(id, co_await map.copy());
+        co_await coroutine::maybe_yield();
+    }
+    co_return copy;
 }
 
 future<> tablet_metadata::clear_gently() {
     for (auto&& [id, map] : _tablets) {
-        co_await map.clear_gently();
+        // Maps shared with other instances, or owned by other shards,
+        // are destroyed with the last reference.
+        if (map.get_owner_shard() == this_shard_id()) {
+            auto ptr = map.release();
+            if (ptr.use_count() == 1) {
+                co_await const_cast<tablet_map&>(*ptr).clear_gently();
+            }
+        }
+        co_await coroutine::maybe_yield();
     }
+    _tablets.clear();
     co_return;
 }
 
+bool tablet_metadata::operator==(const tablet_metadata& o) const {
+    if (_balancing_enabled != o._balancing_enabled || _tablets.size() != o._tablets.size()) {
+        return false;
+    }
+    for (const auto& [id, map] : _tablets) {
+        auto it = o._tablets.find(id);
+        if (it == o._tablets.end() || (map.get() != it->second.get() && *map != *it->second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 tablet_map::tablet_map(size_t tablet_count)
         : _log2_tablets(log2ceil(tablet_count)) {
     if (tablet_count != 1ul << _log2_tablets) {
@@ -435,6 +463,7 @@ resize_decision::seq_number_t resize_decision::next_sequence_number() const {
 table_load_stats& table_load_stats::operator+=(const table_load_stats& s) noexcept {
     size_in_bytes = size_in_bytes + s.size_in_bytes;
     split_ready_seq_number = std::min(split_ready_seq_number, s.split_ready_seq_number);
+    ops_per_second = ops_per_second + s.ops_per_second;
     return *this;
 }
 
@@ -507,13 +536,14 @@ static size_t estimate_external_memory_usage(const std::unordered_map<K, V>& map
 size_t tablet_metadata::external_memory_usage() const {
     size_t result = estimate_external_memory_usage(_tablets);
     for (auto&& [id, map] : _tablets) {
-        result += map.external_memory_usage();
+        result += sizeof(tablet_map) + map->external_memory_usage();
     }
     return result;
 }
 
 bool tablet_metadata::has_replica_on(host_id host) const {
-    for (auto&& [id, map] : _tablets) {
+    for (auto&& [id, map_ptr] : _tablets) {
+        auto& map = *map_ptr;
         for (auto&& tablet : map.tablet_ids()) {
             auto& tinfo = map.get_tablet_info(tablet);
             for (auto&& r : tinfo.replicas) {
@@ -533,7 +563,7 @@ bool tablet_metadata::has_replica_on(host_id host) const {
 future<bool> check_tablet_replica_shards(const tablet_metadata& tm, host_id this_host) {
     bool valid = true;
     for (const auto& [table_id, tmap] : tm.all_tables()) {
-        co_await tmap.for_each_tablet([this_host, &valid] (locator::tablet_id tid, const tablet_info& tinfo) -> future<> {
+        co_await tmap->for_each_tablet([this_host, &valid] (locator::tablet_id tid, const tablet_info& tinfo) -> future<> {
             for (const auto& replica : tinfo.replicas) {
                 if (replica.host == this_host) {
                     valid &= replica.shard < smp::count;
@@ -879,7 +909,7 @@ auto fmt::formatter<locator::tablet_metadata>::format(const locator::tablet_meta
         if (!first) {
             out = fmt::format_to(out, ",");
         }
-        out = fmt::format_to(out, "\n  {}: {}", id, map);
+        out = fmt::format_to(out, "\n  {}: {}", id, *map);
         first = false;
     }
     return fmt::format_to(out, "\n}}");
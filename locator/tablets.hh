@@ -23,6 +23,7 @@
 #include <seastar/core/reactor.hh>
 #include <seastar/util/log.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/sharded.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
@@ -281,6 +282,9 @@ struct table_load_stats {
     // all replicas have completed splitting, which happens when they all store the
     // seq number of the current split decision.
     resize_decision::seq_number_t split_ready_seq_number = std::numeric_limits<resize_decision::seq_number_t>::max();
+    // Rate of reads and writes served by replicas of the table, per second.
+    // Not carried by the table_load_stats verb, see the table_ops_rates verb.
+    double ops_per_second = 0;
 
     table_load_stats& operator+=(const table_load_stats& s) noexcept;
     friend table_load_stats operator+(table_load_stats a, const table_load_stats& b) {
@@ -447,38 +451,52 @@ class tablet_map {
 /// (represents a snapshot) and references obtained through this are guaranteed
 /// to remain valid as long as the containing token_metadata_ptr is held.
 ///
-/// Copy constructor can be invoked across shards.
+/// Tablet maps are immutable once inserted and are shared between copies,
+/// also across shards, so copying is proportional to the number of tables,
+/// not tablets. Updating a table's tablet map replaces only that map.
+/// Use copy() to make a copy, which can be invoked across shards.
 class tablet_metadata {
 public:
-    // FIXME: Make cheap to copy.
-    // We want both immutability and cheap updates, so we should use
-    // hierarchical data structure with shared pointers and copy-on-write.
-    // Currently we have immutability but updates require full copy.
-    //
-    // Also, currently the copy constructor is invoked across shards, which precludes
-    // using shared pointers. We should change that and use a foreign_ptr<> to
-    // hold immutable tablet_metadata which lives on shard 0 only.
-    // See storage_service::replicate_to_all_cores().
-    using table_to_tablet_map = std::unordered_map<table_id, tablet_map>;
+    // A tablet map lives on the shard where it was created, and is shared by
+    // instances on all shards which refer to the same version of it.
+    using tablet_map_ptr = foreign_ptr<lw_shared_ptr<const tablet_map>>;
+    using table_to_tablet_map = std::unordered_map<table_id, tablet_map_ptr>;
 private:
     table_to_tablet_map _tablets;
 
     // When false, tablet load balancer will not try to rebalance tablets.
     bool _balancing_enabled = true;
 public:
+    tablet_metadata() = default;
+    tablet_metadata(tablet_metadata&&) = default;
+    tablet_metadata& operator=(tablet_metadata&&) = default;
+    tablet_metadata(const tablet_metadata&) = delete; // use copy()
+    tablet_metadata& operator=(const tablet_metadata&) = delete;
+
     bool balancing_enabled() const { return _balancing_enabled; }
     const tablet_map& get_tablet_map(table_id id) const;
     const table_to_tablet_map& all_tables() const { return _tablets; }
-    table_to_tablet_map& all_tables() { return _tablets; }
     size_t external_memory_usage() const;
     bool has_replica_on(host_id) const;
+
+    // Returns a copy which shares tablet maps with this instance.
+    // Can be invoked on any shard, the copy belongs to the current shard.
+    future<tablet_metadata> copy() const;
 public:
     void set_balancing_enabled(bool value) { _balancing_enabled = value; }
     void set_tablet_map(table_id, tablet_map);
-    tablet_map& get_tablet_map(table_id id);
+    // Replaces the tablet map of the table with a modified copy of it.
+    // Instances which share the current map are not affected.
+    template <typename Func>
+    requires std::invocable<Func, tablet_map&>
+    void mutate_tablet_map(table_id id, Func&& func) {
+        auto map = get_tablet_map(id);
+        func(map);
+        set_tablet_map(id, std::move(map));
+    }
     future<> clear_gently();
 public:
-    bool operator==(const tablet_metadata&) const = default;
+    bool operator==(const tablet_metadata&) const;
     friend fmt::formatter<tablet_metadata>;
 };
 
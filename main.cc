@@ -102,6 +102,8 @@
 #include "tools/entry_point.hh"
 #include "test/perf/entry_point.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/bloom_filter_extension.hh"
+#include "db/cache_eviction_extension.hh"
 #include "lang/manager.hh"
 #include "sstables/sstables_manager.hh"
 #include "db/virtual_tables.hh"
@@ -171,6 +173,9 @@ struct convert<::object_storage_endpoint_param> {
         ep.endpoint = node["name"].as<std::string>();
         ep.config.port = node["port"].as<unsigned>();
         ep.config.use_https = node["https"].as<bool>(false);
+        if (node["max_connections"]) {
+            ep.config.max_connections = node["max_connections"].as<unsigned>();
+        }
         if (node["aws_region"] || std::getenv("AWS_DEFAULT_REGION")) {
             ep.config.aws.emplace();
 
@@ -638,6 +643,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
     ext->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
     ext->add_schema_extension<tombstone_gc_extension>(tombstone_gc_extension::NAME);
     ext->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
+    ext->add_schema_extension<db::bloom_filter_extension>(db::bloom_filter_extension::NAME);
+    ext->add_schema_extension<db::cache_eviction_extension>(db::cache_eviction_extension::NAME);
 
     auto cfg = make_lw_shared<db::config>(ext);
     auto init = app.get_options_description().add_options();
@@ -834,6 +841,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 st_cfg.defragment_on_idle = cfg->defragment_memory_on_idle();
                 st_cfg.abort_on_lsa_bad_alloc = cfg->abort_on_lsa_bad_alloc();
                 st_cfg.lsa_reclamation_step = cfg->lsa_reclamation_step();
+                st_cfg.background_reserve_segments = cfg->lsa_background_reserve_segments();
+                st_cfg.transparent_huge_pages = cfg->lsa_transparent_huge_pages();
                 st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
                 st_cfg.sanitizer_report_backtrace = cfg->sanitizer_report_backtrace();
                 logalloc::shard_tracker().configure(st_cfg);
@@ -1048,6 +1057,20 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             });
 #endif
 
+            // Commitlog replay runs on shard 0 as a task of this module. The module
+            // exists on every shard, as the task manager API lists tasks of a module
+            // from all shards.
+            task_manager.invoke_on_all([] (tasks::task_manager& tm) {
+                tm.make_module("commitlog_replay");
+            }).get();
+            auto commitlog_replay_module = task_manager.local().find_module("commitlog_replay");
+            auto stop_commitlog_replay_module = defer_verbose_shutdown("commitlog replay task manager module", [&task_manager] {
+                task_manager.invoke_on_all([] (tasks::task_manager& tm) {
+                    auto module = tm.find_module("commitlog_replay");
+                    return module->stop().finally([module] {});
+                }).get();
+            });
+
             // Note: changed from using a move here, because we want the config object intact.
             replica::database_config dbcfg;
             dbcfg.compaction_scheduling_group = make_sched_group("compaction", "comp", 1000);
@@ -1081,6 +1104,14 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .subrange_parallelism = cfg->compaction_subrange_parallelism,
+                    .subrange_min_size_in_mb = cfg->compaction_subrange_min_size_in_mb,
+                    .controller_feedback = {
+                        .target_backlog = cfg->compaction_controller_target_backlog,
+                        .proportional_gain = cfg->backlog_controller_proportional_gain,
+                        .integral_gain = cfg->backlog_controller_integral_gain,
+                        .derivative_gain = cfg->backlog_controller_derivative_gain,
+                    },
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(stop_signal.as_sharded_abort_source()), std::ref(task_manager)).get();
@@ -1094,6 +1125,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             auto stop_sstm = defer_verbose_shutdown("sstables storage manager", [&sstm] {
                 sstm.stop().get();
             });
+            sstm.invoke_on_all(&sstables::storage_manager::start).get();
 
             lang::manager::config lang_config;
             lang_config.lua.max_bytes = cfg->user_defined_function_allocation_limit_bytes();
@@ -1107,6 +1139,11 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .cache_timer_period = std::chrono::milliseconds(cfg->wasm_cache_timeout_in_ms()),
                     .yield_fuel = cfg->wasm_udf_yield_fuel(),
                     .total_fuel = cfg->wasm_udf_total_fuel(),
+                    // setup_directories() places saved_caches_directory in the work directory unless it's
+                    // set explicitly. If it's set to empty, don't cache in the current directory, disable the cache.
+                    .precompiled_cache_dir = cfg->saved_caches_directory().empty()
+                            ? std::filesystem::path()
+                            : std::filesystem::path(cfg->saved_caches_directory()) / "wasm",
                 };
             }
 
@@ -1284,7 +1321,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
               if (!paths.empty()) {
                   supervisor::notify("replaying schema commit log");
                   auto rp = db::commitlog_replayer::create_replayer(db, sys_ks).get();
-                  rp.recover(paths, db::schema_tables::COMMITLOG_FILENAME_PREFIX).get();
+                  rp.recover(paths, db::schema_tables::COMMITLOG_FILENAME_PREFIX, commitlog_replay_module).get();
                   supervisor::notify("replaying schema commit log - flushing memtables");
                   // The schema commitlog lives only on the null shard.
                   // This is enforced when the table is marked to use
@@ -1344,6 +1381,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             } else if (compress_what == "dc") {
                 mscfg.compress = netw::messaging_service::compress_what::dc;
             }
+            mscfg.compress_bulk_data = cfg->internode_compression_bulk_data();
 
             if (encrypt == "all") {
                 mscfg.encrypt = netw::messaging_service::encrypt_what::all;
@@ -1450,6 +1488,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             auto stop_fd = defer_verbose_shutdown("direct_failure_detector", [] {
                 fd.stop().get();
             });
+            fd.invoke_on_all(&direct_failure_detector::failure_detector::register_metrics).get();
 
             raft_gr.start(raft::server_id{host_id.id}, std::ref(raft_address_map),
                     std::ref(messaging), std::ref(fd)).get();
@@ -1627,7 +1666,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 if (!paths.empty()) {
                     supervisor::notify("replaying commit log");
                     auto rp = db::commitlog_replayer::create_replayer(db, sys_ks).get();
-                    rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX).get();
+                    rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX, commitlog_replay_module).get();
                     supervisor::notify("replaying commit log - flushing memtables");
                     db.invoke_on_all(&replica::database::flush_all_memtables).get();
                     supervisor::notify("replaying commit log - removing old commitlog segments");
@@ -1649,6 +1688,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 });
             }).get();
 
+            // Warm up the caches with the partitions which were cached at the last shutdown
+            db.invoke_on_all(&replica::database::start_cache_prewarm).get();
+
             api::set_server_gossip(ctx, gossiper).get();
             api::set_server_snitch(ctx, snitch).get();
             auto stop_snitch_api = defer_verbose_shutdown("snitch API", [&ctx] {
@@ -1661,7 +1703,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             static seastar::sharded<memory_threshold_guard> mtg;
             mtg.start(cfg->large_memory_allocation_warning_threshold()).get();
             supervisor::notify("initializing storage proxy RPC verbs");
-            proxy.invoke_on_all(&service::storage_proxy::start_remote, std::ref(messaging), std::ref(gossiper), std::ref(mm), std::ref(sys_ks)).get();
+            proxy.invoke_on_all(&service::storage_proxy::start_remote, std::ref(messaging), std::ref(gossiper), std::ref(mm), std::ref(sys_ks), std::ref(fd)).get();
             auto stop_proxy_handlers = defer_verbose_shutdown("storage proxy RPC verbs", [&proxy] {
                 proxy.invoke_on_all(&service::storage_proxy::stop_remote).get();
             });
@@ -1800,7 +1842,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 start_cql(cql_maintenance_server_ctl, stop_maintenance_cql, "maintenance native server");
             }
 
-            snapshot_ctl.start(std::ref(db)).get();
+            snapshot_ctl.start(std::ref(db), std::ref(task_manager), std::ref(sstm)).get();
             auto stop_snapshot_ctl = defer_verbose_shutdown("snapshots", [&snapshot_ctl] {
                 snapshot_ctl.stop().get();
             });
@@ -2046,7 +2088,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             // Register controllers after drain_on_shutdown() below, so that even on start
             // failure drain is called and stops controllers
             cql_transport::controller cql_server_ctl(auth_service, mm_notifier, gossiper, qp, service_memory_limiter, sl_controller, lifecycle_notifier, *cfg, cql_sg_stats_key, maintenance_socket_enabled::no, dbcfg.statement_scheduling_group);
-            alternator::controller alternator_ctl(gossiper, proxy, mm, sys_dist_ks, cdc_generation_service, service_memory_limiter, auth_service, sl_controller, *cfg, dbcfg.statement_scheduling_group);
+            alternator::controller alternator_ctl(gossiper, proxy, mm, sys_dist_ks, cdc_generation_service, service_memory_limiter, auth_service, sl_controller, es, *cfg, dbcfg.statement_scheduling_group);
             redis::controller redis_ctl(proxy, auth_service, mm, *cfg, gossiper, dbcfg.statement_scheduling_group);
 
             // Register at_exit last, so that storage_service::drain_on_shutdown will be called first
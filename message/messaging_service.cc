@@ -36,6 +36,7 @@
 #include "repair/repair.hh"
 #include "streaming/stream_reason.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
+#include "streaming/stream_blob.hh"
 #include "cache_temperature.hh"
 #include "raft/raft.hh"
 #include "service/raft/group0_fwd.hh"
@@ -152,7 +153,7 @@ struct messaging_service::connection_ref {
 constexpr int32_t messaging_service::current_version;
 
 // Count of connection types that are not associated with any tenant
-const size_t PER_SHARD_CONNECTION_COUNT = 2;
+const size_t PER_SHARD_CONNECTION_COUNT = 3;
 // Counts per tenant connection types
 const size_t PER_TENANT_CONNECTION_COUNT = 3;
 
@@ -329,7 +330,7 @@ void messaging_service::do_start_listen() {
     auto broadcast_address = this->broadcast_address();
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != broadcast_address;
     rpc::server_options so;
-    if (_cfg.compress != compress_what::none) {
+    if (_cfg.compress != compress_what::none || _cfg.compress_bulk_data) {
         so.compressor_factory = &compressor_factory;
     }
     so.load_balancing_algorithm = server_socket::load_balancing_algorithm::port;
@@ -553,6 +554,9 @@ rpc::no_wait_type messaging_service::no_wait() {
 // when we first start gossiping).
 static constexpr unsigned TOPOLOGY_INDEPENDENT_IDX = 0;
 
+// The verbs using this RPC client move bulk data, see do_get_rpc_client_idx().
+static constexpr unsigned BULK_DATA_IDX = 1;
+
 static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     // *_CONNECTION_COUNT constants needs to be updated after allocating a new index.
     switch (verb) {
@@ -582,39 +586,47 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
         // DO NOT move GOSSIP_ verbs outside this group.
         static_assert(TOPOLOGY_INDEPENDENT_IDX == 0);
         return 0;
+    // Verbs which move bulk data. They get a connection of their own, so
+    // that the requests and replies of the control verbs below are not
+    // queued behind megabytes of row diffs or mutation fragments.
+    case messaging_verb::UNUSED__STREAM_MUTATION:
+    case messaging_verb::STREAM_MUTATION_FRAGMENTS:
+    case messaging_verb::STREAM_BLOB:
+    case messaging_verb::REPAIR_GET_FULL_ROW_HASHES:
+    case messaging_verb::REPAIR_GET_BUCKET_ROW_HASHES:
+    case messaging_verb::REPAIR_GET_ROW_DIFF:
+    case messaging_verb::REPAIR_PUT_ROW_DIFF:
+    case messaging_verb::REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM:
+    case messaging_verb::REPAIR_PUT_ROW_DIFF_WITH_RPC_STREAM:
+    case messaging_verb::REPAIR_GET_FULL_ROW_HASHES_WITH_RPC_STREAM:
+    case messaging_verb::HINT_MUTATION:
+        static_assert(BULK_DATA_IDX == 1);
+        return 1;
     case messaging_verb::PREPARE_MESSAGE:
     case messaging_verb::PREPARE_DONE_MESSAGE:
-    case messaging_verb::UNUSED__STREAM_MUTATION:
     case messaging_verb::STREAM_MUTATION_DONE:
     case messaging_verb::COMPLETE_MESSAGE:
     case messaging_verb::UNUSED__REPLICATION_FINISHED:
     case messaging_verb::UNUSED__REPAIR_CHECKSUM_RANGE:
-    case messaging_verb::STREAM_MUTATION_FRAGMENTS:
-    case messaging_verb::STREAM_BLOB:
     case messaging_verb::REPAIR_ROW_LEVEL_START:
     case messaging_verb::REPAIR_ROW_LEVEL_STOP:
-    case messaging_verb::REPAIR_GET_FULL_ROW_HASHES:
     case messaging_verb::REPAIR_GET_COMBINED_ROW_HASH:
     case messaging_verb::REPAIR_GET_SYNC_BOUNDARY:
-    case messaging_verb::REPAIR_GET_ROW_DIFF:
-    case messaging_verb::REPAIR_PUT_ROW_DIFF:
     case messaging_verb::REPAIR_GET_ESTIMATED_PARTITIONS:
     case messaging_verb::REPAIR_SET_ESTIMATED_PARTITIONS:
     case messaging_verb::REPAIR_GET_DIFF_ALGORITHMS:
-    case messaging_verb::REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM:
-    case messaging_verb::REPAIR_PUT_ROW_DIFF_WITH_RPC_STREAM:
-    case messaging_verb::REPAIR_GET_FULL_ROW_HASHES_WITH_RPC_STREAM:
     case messaging_verb::REPAIR_UPDATE_SYSTEM_TABLE:
     case messaging_verb::REPAIR_FLUSH_HINTS_BATCHLOG:
     case messaging_verb::NODE_OPS_CMD:
-    case messaging_verb::HINT_MUTATION:
     case messaging_verb::TABLET_STREAM_FILES:
     case messaging_verb::TABLET_STREAM_DATA:
     case messaging_verb::TABLET_CLEANUP:
     case messaging_verb::TABLE_LOAD_STATS:
-        return 1;
+    case messaging_verb::TABLE_OPS_RATES:
+        return 2;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
@@ -642,12 +654,12 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::RAFT_MODIFY_CONFIG:
     case messaging_verb::DIRECT_FD_PING:
     case messaging_verb::RAFT_PULL_SNAPSHOT:
-        return 2;
+        return 3;
     case messaging_verb::MUTATION_DONE:
     case messaging_verb::MUTATION_FAILED:
-        return 3;
-    case messaging_verb::FORWARD_REQUEST:
         return 4;
+    case messaging_verb::FORWARD_REQUEST:
+        return 5;
     case messaging_verb::LAST:
         return -1; // should never happen
     }
@@ -696,6 +708,7 @@ messaging_service::initial_scheduling_info() const {
     auto sched_infos = std::vector<scheduling_info_for_connection_index>({
         { _scheduling_config.gossip, "gossip" },
         { _scheduling_config.streaming, "streaming", },
+        { _scheduling_config.streaming, "streaming-control", },
     });
 
     sched_infos.reserve(sched_infos.size() +
@@ -862,6 +875,9 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     }();
 
     auto must_compress = [&] {
+        if (_cfg.compress_bulk_data && idx == BULK_DATA_IDX) {
+            return true;
+        }
         if (_cfg.compress == compress_what::none) {
             return false;
         }
@@ -1008,6 +1024,40 @@ future<> messaging_service::unregister_stream_mutation_fragments() {
     return unregister_handler(messaging_verb::STREAM_MUTATION_FRAGMENTS);
 }
 
+rpc::sink<streaming::stream_blob_cmd, sstring, temporary_buffer<char>> messaging_service::make_sink_for_stream_blob(rpc::source<int32_t>& source) {
+    return source.make_sink<netw::serializer, streaming::stream_blob_cmd, sstring, temporary_buffer<char>>();
+}
+
+future<std::tuple<rpc::sink<int32_t>, rpc::source<streaming::stream_blob_cmd, sstring, temporary_buffer<char>>>>
+messaging_service::make_sink_and_source_for_stream_blob(locator::global_tablet_id tablet, service::session_id session, msg_addr id) {
+    using value_type = std::tuple<rpc::sink<int32_t>, rpc::source<streaming::stream_blob_cmd, sstring, temporary_buffer<char>>>;
+    if (is_shutting_down()) {
+        co_await coroutine::return_exception(rpc::closed_error());
+    }
+    auto rpc_client = get_rpc_client(messaging_verb::STREAM_BLOB, id);
+    auto sink = co_await rpc_client->make_stream_sink<netw::serializer, int32_t>();
+    auto rpc_handler = rpc()->make_client<rpc::source<streaming::stream_blob_cmd, sstring, temporary_buffer<char>> (locator::global_tablet_id, service::session_id, rpc::sink<int32_t>)>(messaging_verb::STREAM_BLOB);
+    auto source_fut = co_await coroutine::as_future(rpc_handler(*rpc_client, tablet, session, sink));
+    if (source_fut.failed()) {
+        auto ex = source_fut.get_exception();
+        try {
+            co_await sink.close();
+        } catch (...) {
+            std::throw_with_nested(std::move(ex));
+        }
+        co_return coroutine::exception(std::move(ex));
+    }
+    co_return value_type(std::move(sink), std::move(source_fut.get()));
+}
+
+void messaging_service::register_stream_blob(std::function<future<rpc::sink<streaming::stream_blob_cmd, sstring, temporary_buffer<char>>> (const rpc::client_info& cinfo, locator::global_tablet_id tablet, service::session_id session, rpc::source<int32_t> source)>&& func) {
+    register_handler(this, messaging_verb::STREAM_BLOB, std::move(func));
+}
+
+future<> messaging_service::unregister_stream_blob() {
+    return unregister_handler(messaging_verb::STREAM_BLOB);
+}
+
 template<class SinkType, class SourceType>
 future<std::tuple<rpc::sink<SinkType>, rpc::source<SourceType>>>
 do_make_sink_source(messaging_verb verb, uint32_t repair_meta_id, shard_id dst_shard_id, shared_ptr<messaging_service::rpc_protocol_client_wrapper> rpc_client, std::unique_ptr<messaging_service::rpc_protocol_wrapper>& rpc) {
@@ -1327,14 +1377,14 @@ future<> messaging_service::send_repair_put_row_diff(msg_addr id, uint32_t repai
 }
 
 // Wrapper for REPAIR_ROW_LEVEL_START
-void messaging_service::register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason, rpc::optional<gc_clock::time_point> compaction_time, rpc::optional<shard_id> dst_shard_id)>&& func) {
+void messaging_service::register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason, rpc::optional<gc_clock::time_point> compaction_time, rpc::optional<shard_id> dst_shard_id, rpc::optional<bool> incremental)>&& func) {
     register_handler(this, messaging_verb::REPAIR_ROW_LEVEL_START, std::move(func));
 }
 future<> messaging_service::unregister_repair_row_level_start() {
     return unregister_handler(messaging_verb::REPAIR_ROW_LEVEL_START);
 }
-future<rpc::optional<repair_row_level_start_response>> messaging_service::send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason, gc_clock::time_point compaction_time, shard_id dst_shard_id) {
-    return send_message<rpc::optional<repair_row_level_start_response>>(this, messaging_verb::REPAIR_ROW_LEVEL_START, std::move(id), repair_meta_id, std::move(keyspace_name), std::move(cf_name), std::move(range), algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, std::move(remote_partitioner_name), std::move(schema_version), reason, compaction_time, dst_shard_id);
+future<rpc::optional<repair_row_level_start_response>> messaging_service::send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason, gc_clock::time_point compaction_time, shard_id dst_shard_id, bool incremental) {
+    return send_message<rpc::optional<repair_row_level_start_response>>(this, messaging_verb::REPAIR_ROW_LEVEL_START, std::move(id), repair_meta_id, std::move(keyspace_name), std::move(cf_name), std::move(range), algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, std::move(remote_partitioner_name), std::move(schema_version), reason, compaction_time, dst_shard_id, incremental);
 }
 
 // Wrapper for REPAIR_ROW_LEVEL_STOP
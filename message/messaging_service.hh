@@ -36,6 +36,7 @@
 namespace streaming {
     class prepare_message;
     enum class stream_mutation_fragments_cmd : uint8_t;
+    enum class stream_blob_cmd : uint8_t;
 }
 
 namespace gms {
@@ -57,6 +58,7 @@ class update_backlog;
 
 namespace locator {
 class shared_token_metadata;
+struct global_tablet_id;
 }
 
 class frozen_mutation;
@@ -194,7 +196,10 @@ enum class messaging_verb : int32_t {
     STREAM_BLOB = 71,
     TABLE_LOAD_STATS = 72,
     JOIN_NODE_QUERY = 73,
-    LAST = 74,
+    TABLE_OPS_RATES = 74,
+    REPAIR_GET_BUCKET_ROW_HASHES = 75,
+    MUTATION_BATCH = 76,
+    LAST = 77,
 };
 
 } // namespace netw
@@ -281,6 +286,8 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
         uint16_t ssl_port = 0;
         encrypt_what encrypt = encrypt_what::none;
         compress_what compress = compress_what::none;
+        // Compress the connection carrying bulk data (streaming, repair, hints) regardless of `compress`
+        bool compress_bulk_data = false;
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
@@ -388,6 +395,16 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     rpc::sink<int32_t> make_sink_for_stream_mutation_fragments(rpc::source<frozen_mutation_fragment, rpc::optional<streaming::stream_mutation_fragments_cmd>>& source);
     future<std::tuple<rpc::sink<frozen_mutation_fragment, streaming::stream_mutation_fragments_cmd>, rpc::source<int32_t>>> make_sink_and_source_for_stream_mutation_fragments(table_schema_version schema_id, streaming::plan_id plan_id, table_id cf_id, uint64_t estimated_partitions, streaming::stream_reason reason, service::session_id session, msg_addr id);
 
+    // Wrapper for STREAM_BLOB
+    // The pending replica of a tablet pulls the sstable files of the tablet from the source replica. The source sends the files
+    // as a sequence of stream_blob_cmd::data chunks, each file terminated by stream_blob_cmd::end_of_file, and the whole stream
+    // by stream_blob_cmd::end_of_stream. The receiver sends back a status code once the files are loaded. 0 means successful,
+    // -1 means error.
+    void register_stream_blob(std::function<future<rpc::sink<streaming::stream_blob_cmd, sstring, temporary_buffer<char>>> (const rpc::client_info& cinfo, locator::global_tablet_id tablet, service::session_id session, rpc::source<int32_t> source)>&& func);
+    future<> unregister_stream_blob();
+    rpc::sink<streaming::stream_blob_cmd, sstring, temporary_buffer<char>> make_sink_for_stream_blob(rpc::source<int32_t>& source);
+    future<std::tuple<rpc::sink<int32_t>, rpc::source<streaming::stream_blob_cmd, sstring, temporary_buffer<char>>>> make_sink_and_source_for_stream_blob(locator::global_tablet_id tablet, service::session_id session, msg_addr id);
+
     // Wrapper for REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM
     future<std::tuple<rpc::sink<repair_hash_with_cmd>, rpc::source<repair_row_on_wire_with_cmd>>> make_sink_and_source_for_repair_get_row_diff_with_rpc_stream(uint32_t repair_meta_id, shard_id dst_cpu_id, msg_addr id);
     rpc::sink<repair_row_on_wire_with_cmd> make_sink_for_repair_get_row_diff_with_rpc_stream(rpc::source<repair_hash_with_cmd>& source);
@@ -440,9 +457,9 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     future<> send_repair_put_row_diff(msg_addr id, uint32_t repair_meta_id, repair_rows_on_wire row_diff, shard_id dst_cpu_id);
 
     // Wrapper for REPAIR_ROW_LEVEL_START
-    void register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason, rpc::optional<gc_clock::time_point> compaction_time, rpc::optional<shard_id> dst_cpu_id)>&& func);
+    void register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason, rpc::optional<gc_clock::time_point> compaction_time, rpc::optional<shard_id> dst_cpu_id, rpc::optional<bool> incremental)>&& func);
     future<> unregister_repair_row_level_start();
-    future<rpc::optional<repair_row_level_start_response>> send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason, gc_clock::time_point compaction_time, shard_id dst_cpu_id);
+    future<rpc::optional<repair_row_level_start_response>> send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason, gc_clock::time_point compaction_time, shard_id dst_cpu_id, bool incremental);
 
     // Wrapper for REPAIR_ROW_LEVEL_STOP
     void register_repair_row_level_stop(std::function<future<> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, rpc::optional<shard_id> dst_cpu_id)>&& func);
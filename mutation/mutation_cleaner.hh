@@ -64,6 +64,7 @@ class mutation_cleaner_impl final {
     bool empty() const noexcept { return _versions.empty(); }
     future<> drain();
     void merge_and_destroy(partition_snapshot&) noexcept;
+    mutation_application_stats& app_stats() noexcept { return _app_stats; }
     void set_scheduling_group(seastar::scheduling_group sg) {
         _scheduling_group = sg;
         _worker_state->cv.broadcast();
@@ -190,6 +191,11 @@ class mutation_cleaner final {
         return _impl->empty();
     }
 
+    // Statistics of the versions managed by this cleaner.
+    mutation_application_stats& app_stats() noexcept {
+        return _impl->app_stats();
+    }
+
     // Forces cleaning and returns a future which resolves when there is nothing to clean.
     future<> drain() {
         return _impl->drain();
@@ -2518,6 +2518,20 @@ future<mutation_opt> counter_write_query(schema_ptr s, const mutation_source& so
     });
 }
 
+seastar::metrics::histogram to_metrics_histogram(const version_chain_histogram& h) {
+    seastar::metrics::histogram res;
+    res.sample_count = h.count;
+    res.sample_sum = h.sum;
+    res.buckets.resize(h.buckets);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < h.buckets; ++i) {
+        cumulative += h.counts[i];
+        res.buckets[i].count = cumulative;
+        res.buckets[i].upper_bound = size_t(1) << i;
+    }
+    return res;
+}
+
 mutation_cleaner_impl::~mutation_cleaner_impl() {
     _worker_state->done = true;
     _worker_state->cv.signal();
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <array>
+#include <bit>
 #include <iosfwd>
 #include <boost/intrusive/set.hpp>
 #include <boost/range/iterator_range.hpp>
@@ -15,6 +17,7 @@
 #include <boost/intrusive/parent_from_member.hpp>
 
 #include <seastar/core/bitset-iter.hh>
+#include <seastar/core/metrics_types.hh>
 #include <seastar/util/optimized_optional.hh>
 
 #include "schema/schema_fwd.hh"
@@ -1085,17 +1088,52 @@ class rows_entry final : public evictable {
     using container_type = intrusive_b::tree<rows_entry, &rows_entry::_link, rows_entry::tri_compare, 12, 20, intrusive_b::key_search::linear>;
 };
 
+// Distribution of the lengths of partition_version chains seen by reads.
+// Lengths are counted in power-of-two buckets: 1, 2, 3-4, 5-8, anything longer
+// is only accounted for in the total count.
+struct version_chain_histogram {
+    static constexpr size_t buckets = 4;
+    static constexpr size_t max_counted_length = size_t(1) << (buckets - 1);
+
+    std::array<uint64_t, buckets> counts{};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+
+    void add(size_t length) noexcept {
+        ++count;
+        sum += length;
+        if (length <= max_counted_length) {
+            ++counts[length > 1 ? std::bit_width(length - 1) : 0];
+        }
+    }
+
+    version_chain_histogram& operator+=(const version_chain_histogram& other) noexcept {
+        for (size_t i = 0; i < buckets; ++i) {
+            counts[i] += other.counts[i];
+        }
+        count += other.count;
+        sum += other.sum;
+        return *this;
+    }
+};
+
+seastar::metrics::histogram to_metrics_histogram(const version_chain_histogram&);
+
 struct mutation_application_stats {
     uint64_t row_hits = 0;
     uint64_t row_writes = 0;
     uint64_t rows_compacted_with_tombstones = 0;
     uint64_t rows_dropped_by_tombstones = 0;
+    uint64_t version_merges = 0; // Number of partition versions merged into older ones and destroyed
+    version_chain_histogram version_chain_lengths; // Lengths of version chains of partitions when snapshots are taken
 
     mutation_application_stats& operator+=(const mutation_application_stats& other) {
         row_hits += other.row_hits;
         row_writes += other.row_writes;
         rows_compacted_with_tombstones += other.rows_compacted_with_tombstones;
         rows_dropped_by_tombstones += other.rows_dropped_by_tombstones;
+        version_merges += other.version_merges;
+        version_chain_lengths += other.version_chain_lengths;
         return *this;
     }
 };
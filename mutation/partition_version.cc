@@ -277,9 +277,11 @@ stop_iteration partition_snapshot::merge_partition_versions(mutation_application
                 _version.release();
                 prev->back_reference() = partition_version_ref(*current, prev->back_reference().is_unique_owner());
                 current_allocator().destroy(prev);
+                ++app_stats.version_merges;
                 return stop_iteration::yes;
             }
             current_allocator().destroy(prev);
+            ++app_stats.version_merges;
         }
     }
     return stop_iteration::yes;
@@ -677,6 +679,14 @@ partition_snapshot_ptr partition_entry::read(logalloc::region& r,
         }
     }
 
+    // Readers pay for every version in the chain, so keep track of how long the chains get.
+    // Lengths above the ones accounted in buckets are not interesting, don't walk further.
+    size_t chain_length = 0;
+    for (auto v = &*_version; v && chain_length <= version_chain_histogram::max_counted_length; v = v->next()) {
+        ++chain_length;
+    }
+    cleaner.app_stats().version_chain_lengths.add(chain_length);
+
     auto snp = make_lw_shared<partition_snapshot>(r, cleaner, this, tracker, phase);
     _snapshot = snp.get();
     return partition_snapshot_ptr(std::move(snp));
@@ -431,11 +431,22 @@ bool range_tombstone_list::equal(const schema& s, const range_tombstone_list& ot
 
 stop_iteration range_tombstone_list::apply_monotonically(const schema& s, range_tombstone_list&& list, is_preemptible preemptible) {
     auto del = current_deleter<range_tombstone_entry>();
+    position_in_partition::less_compare less(s);
     auto it = list.begin();
     while (it != list.end()) {
-        // FIXME: Optimize by stealing the entry
-        apply_monotonically(s, it->tombstone());
-        it = list._tombstones.erase_and_dispose(it, del);
+        if (_tombstones.empty() || less(_tombstones.rbegin()->end_position(), it->position())) {
+            // Entries which start after all of ours cannot overlap with nor be
+            // merged into them, so they can be stolen as-is. This is the common
+            // case for queue-like workloads which keep deleting ever newer ranges,
+            // it avoids an allocation and a lookup per entry.
+            auto& rt = *it;
+            it = list._tombstones.erase(it);
+            _tombstones.insert_before(_tombstones.end(), rt);
+        } else {
+            // FIXME: Optimize by stealing the entry
+            apply_monotonically(s, it->tombstone());
+            it = list._tombstones.erase_and_dispose(it, del);
+        }
         if (preemptible && need_preempt()) {
             return stop_iteration::no;
         }
@@ -35,7 +35,7 @@ class shard_based_splitting_mutation_writer {
         : _schema(std::move(schema))
         , _permit(std::move(permit))
         , _consumer(std::move(consumer))
-        , _shards(smp::count)
+        , _shards(_schema->get_sharder().shard_count())
     {}
 
     future<> consume(partition_start&& ps) {
@@ -16,7 +16,8 @@ namespace mutation_writer {
 // Given a producer that may contain data for all shards, consume it in a per-shard
 // manner. This is useful, for instance, in the resharding process where a user changes
 // the amount of CPU assigned to Scylla and we have to rewrite the SSTables to their new
-// owners.
+// owners. Shards are those of the static sharder of the producer's schema, which might
+// have a different shard count than the local node.
 future<> segregate_by_shard(flat_mutation_reader_v2 producer, reader_consumer_v2 consumer);
 
 } // namespace mutation_writer
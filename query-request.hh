@@ -183,6 +183,13 @@ class partition_slice {
         // is a lot of dead rows. This flag is needed during rolling upgrades to support
         // old coordinators which do not tolerate pages with no live rows.
         allow_mutation_read_page_without_live_row,
+        // Set by the replica for reads building a query::result with data only
+        // (no digest). Allows sstable readers to drop the values of cells of
+        // columns not selected by the slice, as nothing looks at them. Must
+        // never be set for mutation, digest or repair reads, where the cells
+        // are reconciled or written elsewhere. Local to the replica, never
+        // sent over the wire.
+        skip_unselected_column_values,
     };
     using option_set = enum_set<super_enum<option,
         option::send_clustering_key,
@@ -198,7 +205,8 @@ class partition_slice {
         option::bypass_cache,
         option::always_return_static_content,
         option::range_scan_data_variant,
-        option::allow_mutation_read_page_without_live_row>>;
+        option::allow_mutation_read_page_without_live_row,
+        option::skip_unselected_column_values>>;
     clustering_row_ranges _row_ranges;
 public:
     column_id_vector static_columns; // TODO: consider using bitmap
@@ -498,6 +506,9 @@ struct forward_request {
     db::consistency_level cl;
     lowres_system_clock::time_point timeout;
     std::optional<std::vector<aggregation_info>> aggregation_infos;
+    // The restrictions to filter the rows by, as the text of a WHERE clause
+    // with every bound value inlined. Set only if the query needs filtering.
+    std::optional<sstring> where_clause;
 };
 
 std::ostream& operator<<(std::ostream& out, const forward_request& r);
@@ -87,6 +87,9 @@ std::ostream& operator<<(std::ostream& out, const forward_request& r) {
         fmt::print(out, ", aggregation_infos=[{}]",
                    fmt::join(r.aggregation_infos.value(), ","));
     }
+    if (r.where_clause) {
+        fmt::print(out, ", where_clause={}", *r.where_clause);
+    }
     fmt::print(out, "cmd={}, pr={}, cl={}, timeout(ms)={}}}",
                r.cmd, r.pr, r.cl, ms);
     return out;
@@ -355,6 +358,20 @@ static void write_partial_partition(ser::writer_of_qr_partition<bytes_ostream>&&
     std::move(rows_wr).end_rows().end_qr_partition();
 }
 
+void result_merger::operator()(foreign_ptr<lw_shared_ptr<query::result>> r) {
+    if (full()) {
+        return;
+    }
+    result_view::do_with(*r, [&] (result_view rv) {
+        for (auto&& pv : rv._v.partitions()) {
+            auto rows = pv.rows();
+            _row_count += rows.size() ? : 1;
+            ++_partition_count;
+        }
+    });
+    _partial.emplace_back(std::move(r));
+}
+
 foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
     if (_partial.size() == 1) {
         return std::move(_partial[0]);
@@ -19,6 +19,9 @@ class result_merger {
     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> _partial;
     const uint64_t _max_rows;
     const uint32_t _max_partitions;
+    // Counted the same way get() does
+    uint64_t _row_count = 0;
+    uint32_t _partition_count = 0;
 public:
     explicit result_merger(uint64_t max_rows, uint32_t max_partitions)
             : _max_rows(max_rows)
@@ -29,11 +32,13 @@ class result_merger {
         _partial.reserve(size);
     }
 
-    void operator()(foreign_ptr<lw_shared_ptr<query::result>> r) {
-        if (!_partial.empty() && _partial.back()->is_short_read()) {
-            return;
-        }
-        _partial.emplace_back(std::move(r));
+    // Results passed after full() would not contribute to get(), so they are dropped
+    void operator()(foreign_ptr<lw_shared_ptr<query::result>> r);
+
+    // True when the results merged so far reach the limits or end with a short read.
+    bool full() const {
+        return _row_count >= _max_rows || _partition_count >= _max_partitions
+                || (!_partial.empty() && _partial.back()->is_short_read());
     }
 
     // FIXME: Eventually we should return a composite_query_result here
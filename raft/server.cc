@@ -46,6 +46,15 @@ struct awaited_index {
     optimized_optional<abort_source::subscription> abort;
 };
 
+// Read barriers of a follower which are sent to the same leader.
+struct read_idx_batch {
+    // Resolved when the request currently sent to the leader gets its reply.
+    std::optional<shared_future<>> in_flight;
+    // Reply of the request which will be sent once the one in flight is done,
+    // shared by all read barriers which are waiting for it.
+    std::optional<shared_future<read_barrier_reply>> next;
+};
+
 struct awaited_conf_change {
     seastar::promise<> promise;
     optimized_optional<abort_source::subscription> abort;
@@ -126,6 +135,7 @@ class server_impl : public rpc_server, public server {
     index_t _snapshot_desc_idx;
     std::list<active_read> _reads;
     std::multimap<index_t, awaited_index> _awaited_indexes;
+    std::unordered_map<server_id, read_idx_batch> _read_idx_batches;
 
     // Set to abort reason when abort() is called
     std::optional<sstring> _aborted;
@@ -183,6 +193,7 @@ class server_impl : public rpc_server, public server {
         uint64_t read_quorum_received = 0;
         uint64_t read_quorum_reply_sent = 0;
         uint64_t read_quorum_reply_received = 0;
+        uint64_t read_barriers_batched = 0;
     } _stats;
 
     struct op_status {
@@ -308,6 +319,9 @@ class server_impl : public rpc_server, public server {
 
     // Get "safe to read" index from a leader
     future<read_barrier_reply> get_read_idx(server_id leader, seastar::abort_source* as);
+    // Get "safe to read" index from a remote leader. Concurrent callers share
+    // a single request to the leader.
+    future<read_barrier_reply> get_read_idx_from_leader(server_id leader);
     // Wait for an entry with a specific term to get committed or
     // applied locally.
     future<> wait_for_entry(entry_id eid, wait_type type, seastar::abort_source* as);
@@ -1485,8 +1499,45 @@ future<read_barrier_reply> server_impl::get_read_idx(server_id leader, seastar::
     if (_id == leader) {
         return execute_read_barrier(_id, as);
     } else {
-        return _rpc->execute_read_barrier_on_leader(leader);
+        return get_read_idx_from_leader(leader);
+    }
+}
+
+future<read_barrier_reply> server_impl::get_read_idx_from_leader(server_id leader) {
+    if (auto& batch = _read_idx_batches[leader]; batch.next) {
+        // The request is not sent yet, so its read index is safe for us too.
+        _stats.read_barriers_batched++;
+        co_return co_await batch.next->get_future();
+    }
+    shared_promise<read_barrier_reply> reply;
+    if (auto& batch = _read_idx_batches[leader]; batch.in_flight) {
+        // The leader may have already determined the read index of the request
+        // in flight before our read barrier started, so we cannot join it.
+        // Wait for it and send the next one on behalf of everyone who comes meanwhile.
+        batch.next = reply.get_shared_future();
+        auto in_flight = batch.in_flight->get_future();
+        co_await std::move(in_flight);
+    }
+    shared_promise<> done;
+    {
+        auto& batch = _read_idx_batches[leader];
+        batch.next.reset();
+        batch.in_flight = done.get_shared_future();
+    }
+    auto f = reply.get_shared_future().get_future();
+    try {
+        reply.set_value(co_await _rpc->execute_read_barrier_on_leader(leader));
+    } catch (...) {
+        reply.set_exception(std::current_exception());
     }
+    if (auto it = _read_idx_batches.find(leader); it != _read_idx_batches.end()) {
+        it->second.in_flight.reset();
+        if (!it->second.next) {
+            _read_idx_batches.erase(it);
+        }
+    }
+    done.set_value();
+    co_return co_await std::move(f);
 }
 
 future<> server_impl::read_barrier(seastar::abort_source* as) {
@@ -1748,6 +1799,9 @@ void server_impl::register_metrics() {
         sm::make_total_operations("messages_sent", _stats.read_quorum_reply_sent,
              sm::description("Number of read_quorum_reply messages sent"), {server_id_label(_id), message_type("read_quorum_reply")}),
 
+        sm::make_total_operations("read_barriers_batched", _stats.read_barriers_batched,
+             sm::description("Number of read barriers which shared a read_barrier request to the leader with another one"), {server_id_label(_id)}),
+
         sm::make_total_operations("waiter_awoken", _stats.waiters_awoken,
              sm::description("Number of waiters that got result back"), {server_id_label(_id)}),
         sm::make_total_operations("waiter_dropped", _stats.waiters_dropped,
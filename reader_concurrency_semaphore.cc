@@ -17,12 +17,14 @@
 #include <utility>
 
 #include "reader_concurrency_semaphore.hh"
+#include "replica/exceptions.hh"
 #include "query-result.hh"
 #include "readers/flat_mutation_reader_v2.hh"
 #include "utils/exceptions.hh"
 #include "schema/schema.hh"
 #include "utils/human_readable.hh"
 #include "utils/memory_limit_reached.hh"
+#include "utils/histogram_metrics_helper.hh"
 
 logger rcslog("reader_concurrency_semaphore");
 
@@ -149,6 +151,11 @@ class reader_permit::impl
         // Must be cleared on all code-paths, otherwise it will keep the permit alive in perpetuity.
         reader_permit_opt permit_keepalive;
         std::optional<reader_concurrency_semaphore::inactive_read> ir;
+        // When the permit was queued for admission.
+        utils::time_estimated_histogram::clock::time_point queued_at;
+        // The number of permits waiting for admission when the permit was queued.
+        uint64_t queued_behind = 0;
+        reader_concurrency_semaphore::cost_class cost = reader_concurrency_semaphore::cost_class::regular;
     };
 
 private:
@@ -889,7 +896,11 @@ reader_concurrency_semaphore::inactive_read_handle::operator=(inactive_read_hand
 
 void reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
     p.unlink();
-    _admission_queue.push_back(p);
+    if (p.aux_data().cost == cost_class::cheap) {
+        _cheap_admission_queue.push_back(p);
+    } else {
+        _admission_queue.push_back(p);
+    }
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permit::impl& p) {
@@ -898,17 +909,27 @@ void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permi
 }
 
 reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() {
-    if (_memory_queue.empty()) {
-        return _admission_queue.front();
-    } else {
+    if (!_memory_queue.empty()) {
         return _memory_queue.front();
     }
+    if (!_cheap_admission_queue.empty() && (_admission_queue.empty() || _cheap_admissions_in_a_row < max_cheap_admissions_in_a_row)) {
+        return _cheap_admission_queue.front();
+    }
+    return _admission_queue.front();
 }
 
 const reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() const {
     return const_cast<wait_queue&>(*this).front();
 }
 
+void reader_concurrency_semaphore::wait_queue::on_admitted(reader_permit::impl& p) noexcept {
+    if (p.aux_data().cost == cost_class::cheap) {
+        ++_cheap_admissions_in_a_row;
+    } else {
+        _cheap_admissions_in_a_row = 0;
+    }
+}
+
 namespace {
 
 struct stop_execution_loop {
@@ -1013,6 +1034,10 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(utils::updateable_val
                                sm::description("Holds the number of currently queued read operations."),
                                {class_label(_name)}),
 
+                sm::make_histogram("reads_admission_wait_latency", [this] { return to_metrics_histogram(_admission_wait_histogram); },
+                               sm::description("Histogram of the time reads which could not be admitted immediately waited in the admission queue."),
+                               {class_label(_name)}).set_skip_when_empty(),
+
                 sm::make_gauge("paused_reads", _stats.inactive_reads,
                                sm::description("The number of currently active reads that are temporarily paused."),
                                {class_label(_name)}),
@@ -1028,6 +1053,10 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(utils::updateable_val
                                                " When the queue is full, excessive reads are shed to avoid overload."),
                                {class_label(_name)}),
 
+                sm::make_counter("reads_shed_due_to_deadline", _stats.total_reads_shed_due_to_deadline,
+                               sm::description("The number of reads shed because they were expected to wait for admission past their timeout."),
+                               {class_label(_name)}),
+
                 sm::make_gauge("disk_reads", _stats.disk_reads,
                                sm::description("Holds the number of currently active disk read operations. "),
                                {class_label(_name)}),
@@ -1278,17 +1307,42 @@ std::exception_ptr reader_concurrency_semaphore::check_queue_size(std::string_vi
     return {};
 }
 
+std::exception_ptr reader_concurrency_semaphore::check_admission_deadline(const reader_permit::impl& permit) {
+    const auto timeout = permit.timeout();
+    // Only reads queued behind others are shed, so the prediction keeps being
+    // refreshed by the reads admitted from the queue.
+    if (!_shed_reads_past_deadline() || timeout == db::no_timeout || !_stats.admission_waiters) {
+        return {};
+    }
+    const auto expected_wait = _admission_wait_per_queued_read * _stats.admission_waiters;
+    if (db::timeout_clock::now() + std::chrono::duration_cast<db::timeout_clock::duration>(expected_wait) < timeout) {
+        return {};
+    }
+    ++_stats.total_reads_shed_due_to_deadline;
+    tracing::trace(permit.trace_state(), "[reader concurrency semaphore {}] rejected, expected to wait for admission for {}ms behind {} reads, past the timeout",
+            _name, std::chrono::duration_cast<std::chrono::milliseconds>(expected_wait).count(), _stats.admission_waiters);
+    return std::make_exception_ptr(replica::overloaded_exception());
+}
+
 future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit::impl& permit, wait_on wait) {
     if (auto ex = check_queue_size("wait")) {
         return make_exception_future<>(std::move(ex));
     }
+    if (wait == wait_on::admission) {
+        if (auto ex = check_admission_deadline(permit)) {
+            return make_exception_future<>(std::move(ex));
+        }
+    }
     auto& ad = permit.aux_data();
     ad.pr = {};
     auto fut = ad.pr.get_future();
     if (wait == wait_on::admission) {
+        ad.queued_at = utils::time_estimated_histogram::clock::now();
+        ad.queued_behind = _stats.admission_waiters;
         permit.on_waiting_for_admission();
         _wait_list.push_to_admission_queue(permit);
         ++_stats.reads_enqueued_for_admission;
+        ++_stats.admission_waiters;
     } else {
         permit.on_waiting_for_memory();
         ad.fut.emplace(std::move(fut));
@@ -1313,7 +1367,7 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
                 _evicting = false;
                 return make_ready_future<stop_iteration>(stop_iteration::yes);
             }
-            return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close().then([] {
+            return detach_inactive_reader(inactive_read_to_evict(), evict_reason::permit).close().then([] {
                 return stop_iteration::no;
             });
         });
@@ -1376,6 +1430,22 @@ bool reader_concurrency_semaphore::should_evict_inactive_read() const noexcept {
     return r == reason::memory_resources || r == reason::count_resources;
 }
 
+reader_permit::impl& reader_concurrency_semaphore::inactive_read_to_evict() noexcept {
+    auto short_on_memory = _resources.memory < 0
+            || (!_wait_list.empty() && can_admit_read(_wait_list.front()).why == reason::memory_resources);
+    if (!short_on_memory) {
+        return _inactive_reads.front();
+    }
+    auto it = _inactive_reads.begin();
+    auto victim = it;
+    for (size_t i = 0; i < inactive_read_eviction_window && it != _inactive_reads.end(); ++i, ++it) {
+        if (it->resources().memory > victim->resources().memory) {
+            victim = it;
+        }
+    }
+    return *victim;
+}
+
 future<> reader_concurrency_semaphore::do_wait_admission(reader_permit::impl& permit) {
     if (!_execution_loop_future) {
         _execution_loop_future.emplace(execution_loop());
@@ -1435,8 +1505,17 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
                 _blessed_permit = &permit;
                 permit.on_granted_memory();
             } else {
+                _wait_list.on_admitted(permit);
                 permit.on_admission();
                 ++_stats.reads_admitted;
+                const auto waited = utils::time_estimated_histogram::clock::now() - permit.aux_data().queued_at;
+                _admission_wait_histogram.add(waited);
+                const auto waited_per_queued_read = waited / (permit.aux_data().queued_behind + 1);
+                if (_admission_wait_per_queued_read.count()) {
+                    _admission_wait_per_queued_read = (_admission_wait_per_queued_read * 7 + waited_per_queued_read) / 8;
+                } else {
+                    _admission_wait_per_queued_read = waited_per_queued_read;
+                }
             }
             if (permit.aux_data().func) {
                 permit.unlink();
@@ -1483,6 +1562,9 @@ future<> reader_concurrency_semaphore::request_memory(reader_permit::impl& permi
 void reader_concurrency_semaphore::dequeue_permit(reader_permit::impl& permit) {
     switch (permit.get_state()) {
         case reader_permit::state::waiting_for_admission:
+            --_stats.admission_waiters;
+            --_stats.waiters;
+            break;
         case reader_permit::state::waiting_for_memory:
         case reader_permit::state::waiting_for_execution:
             --_stats.waiters;
@@ -1566,9 +1648,10 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(schema_ptr
 }
 
 future<> reader_concurrency_semaphore::with_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func, cost_class cost) {
     auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
     permit->aux_data().func = std::move(func);
+    permit->aux_data().cost = cost;
     permit->aux_data().permit_keepalive = permit;
     return do_wait_admission(*permit);
 }
@@ -1620,6 +1703,7 @@ std::string reader_concurrency_semaphore::dump_diagnostics(unsigned max_lines) c
 void reader_concurrency_semaphore::foreach_permit(noncopyable_function<void(const reader_permit::impl&)> func) const {
     boost::for_each(_permit_list, std::ref(func));
     boost::for_each(_wait_list._admission_queue, std::ref(func));
+    boost::for_each(_wait_list._cheap_admission_queue, std::ref(func));
     boost::for_each(_wait_list._memory_queue, std::ref(func));
     boost::for_each(_ready_list, std::ref(func));
 }
@@ -15,6 +15,7 @@
 #include <seastar/core/metrics_registration.hh>
 #include "reader_permit.hh"
 #include "utils/updateable_value.hh"
+#include "utils/estimated_histogram.hh"
 #include "dht/i_partitioner_fwd.hh"
 
 namespace bi = boost::intrusive;
@@ -90,6 +91,8 @@ class reader_concurrency_semaphore {
         uint64_t total_failed_reads = 0;
         // Total number of reads rejected because the admission queue reached its max capacity
         uint64_t total_reads_shed_due_to_overload = 0;
+        // Total number of reads rejected because they were predicted to wait for admission past their timeout
+        uint64_t total_reads_shed_due_to_deadline = 0;
         // Total number of reads killed due to the memory consumption reaching the kill limit.
         uint64_t total_reads_killed_due_to_kill_limit = 0;
         // Total number of reads admitted, via all admission paths.
@@ -124,6 +127,8 @@ class reader_concurrency_semaphore {
         uint64_t sstables_read = 0;
         // Permits waiting on something: admission, memory or execution
         uint64_t waiters = 0;
+        // Permits waiting for admission
+        uint64_t admission_waiters = 0;
     };
 
     using permit_list_type = bi::list<
@@ -133,6 +138,19 @@ class reader_concurrency_semaphore {
 
     using read_func = noncopyable_function<future<>(reader_permit)>;
 
+    /// The expected cost of a read, used to order reads waiting for admission.
+    ///
+    /// Cheap reads (e.g. reads of a single row) waiting for admission are
+    /// admitted before regular ones, so they don't have to wait for the
+    /// admission of expensive scans queued before them. To avoid starving
+    /// regular reads, at most `max_cheap_admissions_in_a_row` cheap reads are
+    /// admitted in a row while regular reads are waiting.
+    enum class cost_class {
+        regular,
+        cheap,
+    };
+    static constexpr unsigned max_cheap_admissions_in_a_row = 4;
+
 private:
     struct inactive_read;
 
@@ -166,16 +184,22 @@ class reader_concurrency_semaphore {
     struct wait_queue {
         // Stores entries for permits waiting to be admitted.
         permit_list_type _admission_queue;
+        // Stores entries for cheap permits waiting to be admitted.
+        permit_list_type _cheap_admission_queue;
         // Stores entries for serialized permits waiting to obtain memory.
         permit_list_type _memory_queue;
+        // Number of cheap permits admitted since the last regular one.
+        unsigned _cheap_admissions_in_a_row = 0;
     public:
         bool empty() const {
-            return _admission_queue.empty() && _memory_queue.empty();
+            return _admission_queue.empty() && _cheap_admission_queue.empty() && _memory_queue.empty();
         }
         void push_to_admission_queue(reader_permit::impl& p);
         void push_to_memory_queue(reader_permit::impl& p);
         reader_permit::impl& front();
         const reader_permit::impl& front() const;
+        // Called when the permit at the front of the admission queues is admitted.
+        void on_admitted(reader_permit::impl& p) noexcept;
     };
 
     wait_queue _wait_list;
@@ -190,6 +214,12 @@ class reader_concurrency_semaphore {
     utils::updateable_value<uint32_t> _serialize_limit_multiplier;
     utils::updateable_value<uint32_t> _kill_limit_multiplier;
     stats _stats;
+    // How long the reads which had to queue for admission waited.
+    utils::time_estimated_histogram _admission_wait_histogram;
+    // Moving average of the admission wait of queued reads, divided by the number
+    // of reads queued before them. Used to predict the admission wait of new reads.
+    utils::time_estimated_histogram::clock::duration _admission_wait_per_queued_read{};
+    utils::updateable_value<bool> _shed_reads_past_deadline{false};
     std::optional<seastar::metrics::metric_groups> _metrics;
     bool _stopped = false;
     bool _evicting = false;
@@ -208,6 +238,8 @@ class reader_concurrency_semaphore {
     bool all_need_cpu_permits_are_awaiting() const;
 
     [[nodiscard]] std::exception_ptr check_queue_size(std::string_view queue_name);
+    // Rejects the permit if it is predicted to be admitted only after its timeout.
+    [[nodiscard]] std::exception_ptr check_admission_deadline(const reader_permit::impl& permit);
 
     // Add the permit to the wait queue and return the future which resolves when
     // the permit is admitted (popped from the queue).
@@ -228,6 +260,15 @@ class reader_concurrency_semaphore {
 
     bool should_evict_inactive_read() const noexcept;
 
+    // The number of the oldest inactive reads considered by inactive_read_to_evict().
+    static constexpr size_t inactive_read_eviction_window = 16;
+
+    // Picks the inactive read to evict to free up resources for admission.
+    // This is the oldest one, except when admission is blocked on memory: then it is
+    // the one holding the most memory among the oldest few, so that fewer paused reads,
+    // which would have to be recreated by their owners, are evicted to free the memory.
+    reader_permit::impl& inactive_read_to_evict() noexcept;
+
     void maybe_admit_waiters() noexcept;
 
     // Request more memory for the permit.
@@ -403,6 +444,10 @@ class reader_concurrency_semaphore {
         return _stats;
     }
 
+    const utils::time_estimated_histogram& admission_wait_histogram() const {
+        return _admission_wait_histogram;
+    }
+
     /// Make an admitted permit
     ///
     /// The permit is already in an admitted state after being created, this
@@ -453,7 +498,10 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func);
+    ///
+    /// See \ref cost_class for the meaning of the cost parameter.
+    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func,
+            cost_class cost = cost_class::regular);
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -498,6 +546,17 @@ class reader_concurrency_semaphore {
         _max_queue_length = size;
     }
 
+    /// Reject reads which have to queue for admission and are predicted to be
+    /// admitted only after their timeout, with replica::overloaded_exception.
+    ///
+    /// The admission wait is predicted from the number of reads already queued
+    /// and from how long recently admitted reads waited. Such reads would time out
+    /// anyway, rejecting them early saves the work they would consume on the way
+    /// and lets the coordinator fail (or retry) them sooner.
+    void set_shed_reads_past_deadline(utils::updateable_value<bool> enabled) {
+        _shed_reads_past_deadline = std::move(enabled);
+    }
+
     uint64_t active_reads() const noexcept {
         return _stats.current_permits - _stats.inactive_reads - _stats.waiters;
     }
@@ -126,6 +126,28 @@ class mutation_fragment_merger {
         });
     }
 
+    // Passes fragments which need no merging straight to the consumer, if the
+    // producer can tell which ones these are without deferring.
+    // The consumer returns stop_iteration::yes when it doesn't want more fragments.
+    template <typename Consumer>
+    void consume_unmerged(Consumer&& consumer) {
+        // The rest of the partition may go through operator(), so range
+        // tombstone changes still have to be tracked by the tombstone merger.
+        auto consume = [&] (mutation_fragment_v2&& mf, stream_id_t stream_id) {
+            if (!mf.is_range_tombstone_change()) {
+                return consumer(std::move(mf));
+            }
+            _tombstone_merger.apply(stream_id, mf.as_range_tombstone_change().tombstone());
+            if (auto tomb_opt = _tombstone_merger.get()) {
+                return consumer(mutation_fragment_v2(*_schema, _permit, range_tombstone_change(mf.position(), *tomb_opt)));
+            }
+            return stop_iteration::no;
+        };
+        if constexpr (requires { _producer.consume_single_reader_buffer(consume); }) {
+            _producer.consume_single_reader_buffer(consume);
+        }
+    }
+
     future<> next_partition() {
         _tombstone_merger.clear();
         return _producer.next_partition();
@@ -246,6 +268,12 @@ class mutation_reader_merger {
     // Produces the next batch of mutation-fragments of the same
     // position.
     future<mutation_fragment_batch> operator()();
+    // If only a single reader has the current partition, moves the fragments
+    // it has buffered to the consumer, up to and including the partition end,
+    // bypassing batching and merging. Does nothing otherwise.
+    // The consumer is called with each fragment and the id of its stream.
+    template <typename Consumer>
+    void consume_single_reader_buffer(Consumer& consumer);
     future<> next_partition();
     future<> fast_forward_to(const dht::partition_range& pr);
     future<> fast_forward_to(position_range pr);
@@ -569,6 +597,21 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
     return make_ready_future<mutation_fragment_batch_opt>(_current);
 }
 
+template <typename Consumer>
+void mutation_reader_merger::consume_single_reader_buffer(Consumer& consumer) {
+    while (_single_reader.reader != reader_iterator{} && !_single_reader.reader->is_buffer_empty()) {
+        const stream_id_t stream_id = &*_single_reader.reader;
+        auto mf = _single_reader.reader->pop_mutation_fragment();
+        _single_reader.last_kind = mf.mutation_fragment_kind();
+        if (mf.is_end_of_partition()) {
+            _next.emplace_back(std::exchange(_single_reader.reader, {}), mutation_fragment_v2::kind::partition_end);
+        }
+        if (consumer(std::move(mf), stream_id) == stop_iteration::yes) {
+            return;
+        }
+    }
+}
+
 future<> mutation_reader_merger::next_partition() {
     // If the last batch of fragments returned by operator() came from partition P,
     // we must forward to the partition immediately following P (as per the `next_partition`
@@ -625,6 +668,14 @@ future<> mutation_reader_merger::close() noexcept {
 template <FragmentProducer P>
 future<> merging_reader<P>::fill_buffer() {
     return repeat([this] {
+        // Partitions only one of the readers has are copied over a buffer at a time.
+        _merger.consume_unmerged([this] (mutation_fragment_v2&& mf) {
+            push_mutation_fragment(std::move(mf));
+            return stop_iteration(is_buffer_full());
+        });
+        if (is_buffer_full()) {
+            return make_ready_future<stop_iteration>(stop_iteration::yes);
+        }
         return _merger().then([this] (mutation_fragment_v2_opt mfo) {
             if (!mfo) {
                 _end_of_stream = true;
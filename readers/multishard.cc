@@ -716,6 +716,8 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     const mutation_reader::forwarding _fwd_mr;
     std::optional<future<>> _read_ahead;
     foreign_ptr<std::unique_ptr<evictable_reader_v2>> _reader;
+    // How long the last completed buffer fill took, until taken.
+    std::optional<std::chrono::steady_clock::duration> _fill_latency;
 
 private:
     future<> do_fill_buffer();
@@ -760,6 +762,9 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     bool is_read_ahead_in_progress() const {
         return _read_ahead.has_value();
     }
+    std::optional<std::chrono::steady_clock::duration> take_fill_latency() {
+        return std::exchange(_fill_latency, std::nullopt);
+    }
 };
 
 future<> shard_reader_v2::close() noexcept {
@@ -808,6 +813,7 @@ future<> shard_reader_v2::do_fill_buffer() {
         remote_fill_buffer_result_v2 result;
     };
 
+    const auto fill_start = std::chrono::steady_clock::now();
     auto res = co_await std::invoke([&] () -> future<remote_fill_buffer_result_v2> {
         if (!_reader) {
             reader_and_buffer_fill_result res = co_await smp::submit_to(_shard, coroutine::lambda([this, gs = global_schema_ptr(_schema)] () -> future<reader_and_buffer_fill_result> {
@@ -880,6 +886,7 @@ future<> shard_reader_v2::do_fill_buffer() {
         co_await coroutine::maybe_yield();
     }
     _end_of_stream = res.end_of_stream;
+    _fill_latency = std::chrono::steady_clock::now() - fill_start;
 }
 
 future<> shard_reader_v2::fill_buffer() {
@@ -976,8 +983,22 @@ class multishard_combining_reader_v2 : public flat_mutation_reader_v2::impl {
     bool _crossed_shards;
     unsigned _concurrency = 1;
 
+    // Read-ahead should complete by the time the consumer gets to the shard,
+    // so the concurrency is the number of shards the consumer gets through while
+    // a shard fills a buffer. Both are tracked as moving averages: the latency of
+    // shard fills and the time the consumer spends on a shard, not counting
+    // waiting for the shard.
+    using clock = std::chrono::steady_clock;
+    std::optional<clock::duration> _avg_fill_latency;
+    std::optional<clock::duration> _avg_consume_time;
+    clock::time_point _shard_entered_at = clock::now();
+    clock::duration _waited_on_current_shard{};
+
     void on_partition_range_change(const dht::partition_range& pr);
     bool maybe_move_to_next_shard(const dht::token* const t = nullptr);
+    void on_shard_left();
+    unsigned adapted_concurrency() const;
+    future<> fill_current_reader_buffer();
     future<> handle_empty_reader_buffer();
 
 public:
@@ -1039,11 +1060,42 @@ bool multishard_combining_reader_v2::maybe_move_to_next_shard(const dht::token*
         boost::push_heap(_shard_selection_min_heap);
     }
 
+    on_shard_left();
     _crossed_shards = true;
     _current_shard = next_shard;
     return true;
 }
 
+static void update_average(std::optional<std::chrono::steady_clock::duration>& avg, std::chrono::steady_clock::duration sample) {
+    avg = avg ? (*avg * 3 + sample) / 4 : sample;
+}
+
+void multishard_combining_reader_v2::on_shard_left() {
+    const auto now = clock::now();
+    if (auto latency = _shard_readers[_current_shard]->take_fill_latency()) {
+        update_average(_avg_fill_latency, *latency);
+    }
+    update_average(_avg_consume_time, std::max(now - _shard_entered_at - _waited_on_current_shard, clock::duration::zero()));
+    _shard_entered_at = now;
+    _waited_on_current_shard = {};
+}
+
+unsigned multishard_combining_reader_v2::adapted_concurrency() const {
+    const auto shard_count = _sharder.shard_count();
+    if (!_avg_fill_latency || !_avg_consume_time) {
+        return std::min(_concurrency * 2, shard_count);
+    }
+    const auto consume_time = std::max(*_avg_consume_time, clock::duration(1));
+    const auto shards_per_fill = (*_avg_fill_latency + consume_time - clock::duration(1)) / consume_time;
+    return 1 + std::min<uint64_t>(shards_per_fill, shard_count - 1);
+}
+
+future<> multishard_combining_reader_v2::fill_current_reader_buffer() {
+    const auto wait_start = clock::now();
+    co_await _shard_readers[_current_shard]->fill_buffer();
+    _waited_on_current_shard += clock::now() - wait_start;
+}
+
 future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
     auto& reader = *_shard_readers[_current_shard];
 
@@ -1055,13 +1107,14 @@ future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
         }
         return make_ready_future<>();
     } else if (reader.is_read_ahead_in_progress()) {
-        return reader.fill_buffer();
+        return fill_current_reader_buffer();
     } else {
         // If we crossed shards and the next reader has an empty buffer we
-        // double concurrency so the next time we cross shards we will have
-        // more chances of hitting the reader's buffer.
+        // adjust concurrency so the next time we cross shards we will have
+        // more chances of hitting the reader's buffer. Until there are
+        // measurements to go by, concurrency is doubled.
         if (_crossed_shards) {
-            _concurrency = std::min(_concurrency * 2, _sharder.shard_count());
+            _concurrency = adapted_concurrency();
 
             // Read ahead shouldn't change the min selection heap so we work on a local copy.
             auto shard_selection_min_heap_copy = _shard_selection_min_heap;
@@ -1076,7 +1129,7 @@ future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
                 _shard_readers[next_shard]->read_ahead();
             }
         }
-        return reader.fill_buffer();
+        return fill_current_reader_buffer();
     }
 }
 
@@ -27,6 +27,8 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "strlen", commands::strlen },
         { "set", commands::set },
         { "setex", commands::setex },
+        { "mset", commands::mset },
+        { "mget", commands::mget },
         { "del", commands::del },
         { "echo", commands::echo },
         { "lolwut", commands::lolwut },
@@ -35,6 +37,8 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "hgetall", commands::hgetall },
         { "hdel", commands::hdel },
         { "hexists", commands::hexists },
+        { "lpush", commands::lpush },
+        { "lrange", commands::lrange },
     };
     auto&& command = _commands.find(req._command);
     if (command != _commands.end()) {
@@ -8,6 +8,7 @@
 
 #include "redis/commands.hh"
 #include <seastar/core/shared_ptr.hh>
+#include <boost/range/irange.hpp>
 #include "redis/request.hh"
 #include "redis/reply.hh"
 #include "service_permit.hh"
@@ -170,6 +171,38 @@ future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::
     });
 }
 
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() == 0 || req.arguments_size() % 2 != 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    std::vector<std::pair<bytes, bytes>> kvs;
+    kvs.reserve(req.arguments_size() / 2);
+    for (size_t i = 0; i < req.arguments_size(); i += 2) {
+        kvs.emplace_back(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    return redis::write_strings(proxy, options, std::move(kvs), permit).then([] {
+        return redis_message::ok();
+    });
+}
+
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() == 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    return do_with(std::vector<bytes_opt>(req.arguments_size()), [&proxy, &options, permit, &req] (std::vector<bytes_opt>& results) {
+        // The keys live in different partitions, read them in parallel
+        return parallel_for_each(boost::irange<size_t>(0, req.arguments_size()), [&proxy, &options, permit, &req, &results] (size_t i) {
+            return redis::read_strings(proxy, options, req._args[i], permit).then([&results, i] (lw_shared_ptr<strings_result> result) {
+                if (result->has_result()) {
+                    results[i] = std::move(result->result());
+                }
+            });
+        }).then([&results] {
+            return redis_message::make_strings_results(results);
+        });
+    });
+}
+
 future<redis_message> del(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() == 0) {
         throw wrong_number_of_arguments_exception(req._command);
@@ -182,6 +215,49 @@ future<redis_message> del(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto values = std::vector<bytes>(std::make_move_iterator(req._args.begin() + 1), std::make_move_iterator(req._args.end()));
+    return redis::write_list_head(proxy, options, bytes(req._args[0]), std::move(values), permit).then([&proxy, &options, &req, permit] {
+        return redis::count_list(proxy, options, req._args[0], permit);
+    }).then([] (uint64_t count) {
+        return redis_message::number(count);
+    });
+}
+
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3) {
+        throw wrong_arguments_exception(3, req.arguments_size(), req._command);
+    }
+    long start, stop;
+    try {
+        start = std::stol(std::string(reinterpret_cast<const char*>(req._args[1].data()), req._args[1].size()));
+        stop = std::stol(std::string(reinterpret_cast<const char*>(req._args[2].data()), req._args[2].size()));
+    } catch (...) {
+        throw invalid_arguments_exception(req._command);
+    }
+    // Offsets counted from the tail of the list need the whole list, otherwise
+    // only the elements up to stop are read.
+    auto row_limit = start >= 0 && stop >= 0 && uint64_t(stop) < query::max_rows ? query::row_limit(stop + 1) : query::row_limit::max;
+    return redis::read_list(proxy, options, req._args[0], row_limit, permit).then([start, stop] (lw_shared_ptr<std::vector<bytes>> list) mutable {
+        long size = list->size();
+        if (start < 0) {
+            start = std::max(start + size, 0L);
+        }
+        if (stop < 0) {
+            stop = stop + size;
+        }
+        stop = std::min(stop, size - 1);
+        std::vector<bytes_opt> result;
+        for (long i = start; i <= stop; ++i) {
+            result.emplace_back(std::move((*list)[i]));
+        }
+        return redis_message::make_strings_results(result);
+    });
+}
+
 future<redis_message> select(service::storage_proxy&, request& req, redis::redis_options& options, service_permit) {
     if (req.arguments_size() != 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
@@ -15,6 +15,8 @@
 #include "redis/options.hh"
 #include "mutation/mutation.hh"
 #include "service_permit.hh"
+#include "utils/UUID_gen.hh"
+#include <seastar/core/byteorder.hh>
 
 using namespace seastar;
 
@@ -71,6 +73,49 @@ future<> write_strings(service::storage_proxy& proxy, redis::redis_options& opti
     return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
 }
 
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& kvs, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    std::vector<mutation> mutations;
+    mutations.reserve(kvs.size());
+    for (auto& [key, data] : kvs) {
+        mutations.push_back(make_mutation(proxy, options, std::move(key), std::move(data), 0));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::move(mutations), write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+
+// The clustering key of a list element orders it among the other elements. Elements
+// pushed later to the head get smaller keys: the key starts with the complement of
+// the write timestamp, followed by the complement of the position of the element
+// among those pushed together. A random suffix keeps elements pushed concurrently
+// by different coordinators apart.
+static bytes make_list_head_ckey(api::timestamp_type ts, uint32_t position, uint64_t suffix) {
+    bytes b(bytes::initialized_later(), sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t));
+    auto out = reinterpret_cast<char*>(b.data());
+    write_be(out, ~uint64_t(ts));
+    write_be(out + sizeof(uint64_t), ~position);
+    write_be(out + sizeof(uint64_t) + sizeof(uint32_t), suffix);
+    return b;
+}
+
+future<> write_list_head(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& values, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto m = mutation(schema, std::move(pkey));
+    auto ts = api::new_timestamp();
+    auto suffix = utils::UUID_gen::get_time_UUID().get_least_significant_bits();
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        auto ckey = clustering_key::from_single_value(*schema, make_list_head_ckey(ts, i, suffix));
+        m.set_clustered_cell(ckey, column, make_cell(schema, *(column.type.get()), values[i]));
+    }
+
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
 
 mutation make_tombstone(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
@@ -25,6 +25,10 @@ class redis_options;
 
 future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& field, bytes&& data, long ttl, service_permit permit);
 future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& data, long ttl, service_permit permit);
+// Writes all the key/value pairs with a single call to storage_proxy::mutate()
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& kvs, service_permit permit);
+// Inserts the values at the head of the list, the last one becoming the first element of the list
+future<> write_list_head(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& values, service_permit permit);
 future<> delete_objects(service::storage_proxy& proxy, redis::redis_options& options, std::vector<bytes>&& keys, service_permit permit);
 future<> delete_fields(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& fields, service_permit permit);
 
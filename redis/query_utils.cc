@@ -162,4 +162,79 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_prox
     });
 }
 
+
+class list_result_builder {
+    lw_shared_ptr<std::vector<bytes>> _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+    uint64_t _row_count = 0;
+public:
+    list_result_builder(lw_shared_ptr<std::vector<bytes>> data, const schema_ptr schema, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        ++_row_count;
+        if (!_data) {
+            return;
+        }
+        auto row_iterator = row.iterator();
+        for (auto&& id : _partition_slice.regular_columns) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell) {
+                cell->value().with_linearized([this, &col = _schema->regular_column_at(id)] (bytes_view cell_view) {
+                    _data->push_back(col.type->deserialize_value(cell_view).serialize_nonnull());
+                });
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+    uint64_t row_count() const { return _row_count; }
+};
+
+// Elements are clustered by their position in the list, so the query reads
+// only the rows needed, in order.
+static future<uint64_t> query_list(service::storage_proxy& proxy, const redis_options& options, const bytes& key, query::row_limit row_limit, service_permit permit,
+        schema_ptr schema, query::partition_slice ps, lw_shared_ptr<std::vector<bytes>> data) {
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, row_limit, query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema, data] (auto qr) {
+        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
+            list_result_builder builder(data, schema, ps);
+            v.consume(ps, builder);
+            return builder.row_count();
+        });
+    });
+}
+
+future<lw_shared_ptr<std::vector<bytes>>> read_list(service::storage_proxy& proxy, const redis_options& options, const bytes& key, query::row_limit row_limit, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    auto ps = partition_slice_builder(*schema).build();
+    auto data = make_lw_shared<std::vector<bytes>>();
+    return query_list(proxy, options, key, row_limit, permit, schema, std::move(ps), data).then([data] (uint64_t) {
+        return data;
+    });
+}
+
+future<uint64_t> count_list(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    // The data column has to be selected, compact storage rows have no row marker
+    // and are only present in the result when one of their cells is.
+    auto ps = partition_slice_builder(*schema).build();
+    return query_list(proxy, options, key, query::row_limit::max, permit, schema, std::move(ps), nullptr);
+}
+
 }
@@ -42,4 +42,9 @@ seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(serv
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
+// Returns the first elements of the list, up to row_limit
+seastar::future<seastar::lw_shared_ptr<std::vector<bytes>>> read_list(service::storage_proxy&, const redis_options&, const bytes&, query::row_limit, service_permit);
+// Returns the number of elements of the list
+seastar::future<uint64_t> count_list(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+
 }
@@ -73,6 +73,18 @@ class redis_message final {
         write_bytes(m, result);
         return make_ready_future<redis_message>(m);
     }
+    static seastar::future<redis_message> make_strings_results(std::vector<bytes_opt>& results) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", results.size()));
+        for (auto& r : results) {
+            if (r) {
+                write_bytes(m, *r);
+            } else {
+                m->append_static("$-1\r\n");
+            }
+        }
+        return make_ready_future<redis_message>(m);
+    }
     static seastar::future<redis_message> unknown(const bytes& name) {
         return from_exception(make_message("-ERR unknown command '{}'\r\n", to_sstring(name)));
     }
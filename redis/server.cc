@@ -88,14 +88,22 @@ void redis_server::connection::write_reply(const redis_exception& e)
     });
 }
 
-void redis_server::connection::write_reply(redis_server::result result)
-{
-    _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
-        auto m = result.make_message();
-        return _write_buf.write(std::move(*m)).then([this] {
-            return _write_buf.flush();
+future<lw_shared_ptr<scattered_message<char>>> redis_server::connection::make_reply(future<redis_server::result> f) {
+    auto error = [] (sstring message) {
+        return redis_message::exception(message).then([] (auto&& result) {
+            return result.message();
         });
-    });
+    };
+    try {
+        auto result = f.get();
+        return make_ready_future<lw_shared_ptr<scattered_message<char>>>(result.make_message());
+    } catch (redis_exception& e) {
+        return error(e.what_message());
+    } catch (std::exception& e) {
+        return error(e.what());
+    } catch (...) {
+        return error("Unknown exception");
+    }
 }
 
 future<> redis_server::connection::process_request() {
@@ -109,22 +117,32 @@ future<> redis_server::connection::process_request() {
         utils::latency_counter lc;
         lc.start();
         auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
-            --_server._stats._requests_serving;
-            try {
-                if (_parser.failed()) {
-                    logging.error("request parse failed");
-                    const auto e = redis_exception("unknown command ''");
-                    write_reply(std::move(e));
-                }else{
-                    write_reply(std::move(result));
-                }
-                ++_server._stats._requests_served;
-                _server._stats._requests.mark(lc.stop().latency());
-                _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
-            } catch (...) {
-                logging.error("request processing failed: {}", std::current_exception());
+        auto f = [this] {
+            if (_parser.failed()) {
+                logging.error("request parse failed");
+                return make_exception_future<redis_server::result>(redis_exception("unknown command ''"));
             }
+            return process_request_internal();
+        }();
+        // Requests of a pipeline are executed one after another, in the order in
+        // which they were received, so that each one sees the effects of the previous
+        // ones. Only writing the reply overlaps with executing the next request.
+        return f.then_wrapped([this, leave = std::move(leave), lc = std::move(lc)] (future<redis_server::result> f) mutable {
+            --_server._stats._requests_serving;
+            ++_replies_ready;
+            ++_server._stats._requests_served;
+            _server._stats._requests.mark(lc.stop().latency());
+            _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
+            _ready_to_respond = _ready_to_respond.then([this, reply = make_reply(std::move(f))] () mutable {
+                return std::move(reply).then([this] (lw_shared_ptr<scattered_message<char>> m) {
+                    --_replies_ready;
+                    return _write_buf.write(std::move(*m)).then([this] {
+                        // Replies to the following requests which are already processed
+                        // are flushed together with this one.
+                        return _replies_ready ? make_ready_future<>() : _write_buf.flush();
+                    });
+                });
+            });
         });
     });
 }
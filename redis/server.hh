@@ -78,6 +78,8 @@ class redis_server : public generic_server::server {
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // Number of processed requests whose reply is not written yet
+        size_t _replies_ready = 0;
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -93,8 +95,9 @@ class redis_server : public generic_server::server {
         future<> process_request() override;
         void handle_error(future<>&& f) override;
         void write_reply(const redis_exception&);
-        void write_reply(redis_server::result result);
     private:
+        // Turns the result of a request, or its failure, into the reply to the client
+        static future<lw_shared_ptr<scattered_message<char>>> make_reply(future<redis_server::result> f);
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
         future<result> process_request_internal();
     };
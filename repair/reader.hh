@@ -15,6 +15,9 @@ class repair_reader {
         multishard_split,
         multishard_filter
     };
+    // Read only the sstables which are not repaired yet, see sstable::is_repaired().
+    // Only applies to the local read strategy.
+    using unrepaired_only = bool_class<class unrepaired_only_tag>;
 
 private:
     schema_ptr _schema;
@@ -42,7 +45,8 @@ class repair_reader {
         read_strategy strategy,
         const dht::sharder& remote_sharder,
         unsigned remote_shard,
-        gc_clock::time_point compaction_time);
+        gc_clock::time_point compaction_time,
+        unrepaired_only unrepaired);
 
 public:
     repair_reader(
@@ -55,7 +59,8 @@ class repair_reader {
         unsigned remote_shard,
         uint64_t seed,
         read_strategy strategy,
-        gc_clock::time_point compaction_time);
+        gc_clock::time_point compaction_time,
+        unrepaired_only unrepaired = unrepaired_only::no);
 
     future<mutation_fragment_opt>
     read_mutation_fragment();
@@ -8,6 +8,7 @@
 
 #include "repair.hh"
 #include "repair/row_level.hh"
+#include "db/config.hh"
 
 #include "locator/network_topology_strategy.hh"
 #include "streaming/stream_reason.hh"
@@ -131,6 +132,8 @@ std::string_view format_as(row_level_diff_detect_algorithm algo) {
         return "send_full_set";
     case send_full_set_rpc_stream:
         return "send_full_set_rpc_stream";
+    case send_bucketed_set_rpc_stream:
+        return "send_bucketed_set_rpc_stream";
     };
     return "unknown";
 }
@@ -2085,6 +2088,38 @@ static std::unordered_set<gms::inet_address> get_nodes_in_dcs(std::vector<sstrin
     return dc_endpoints;
 }
 
+future<> repair_service::acquire_tablet_repair_sessions(std::vector<gms::inet_address> nodes) {
+    auto max_sessions = _db.local().get_config().tablet_repair_max_sessions_per_node();
+    if (!max_sessions) {
+        co_return;
+    }
+    // Always taken in the same order, so that repairs waiting for
+    // overlapping sets of nodes do not deadlock.
+    std::sort(nodes.begin(), nodes.end());
+    size_t acquired = 0;
+    try {
+        for (auto& node : nodes) {
+            auto [it, _] = _tablet_repair_sessions.try_emplace(node, max_sessions);
+            // Repairs waiting here must not hold up the shutdown.
+            co_await it->second.wait(_repair_module->abort_source(), 1);
+            ++acquired;
+        }
+    } catch (...) {
+        nodes.resize(acquired);
+        release_tablet_repair_sessions(nodes);
+        throw;
+    }
+}
+
+void repair_service::release_tablet_repair_sessions(const std::vector<gms::inet_address>& nodes) noexcept {
+    for (auto& node : nodes) {
+        auto it = _tablet_repair_sessions.find(node);
+        if (it != _tablet_repair_sessions.end()) {
+            it->second.signal();
+        }
+    }
+}
+
 // Repair all tablets belong to this node for the given table
 future<> repair_service::repair_tablets(repair_uniq_id rid, sstring keyspace_name, std::vector<sstring> table_names, host2ip_t host2ip, bool primary_replica_only, dht::token_range_vector ranges_specified, std::vector<sstring> data_centers, std::unordered_set<gms::inet_address> hosts, std::unordered_set<gms::inet_address> ignore_nodes, std::optional<int> ranges_parallelism) {
     std::vector<tablet_repair_task_meta> task_metas;
@@ -2347,16 +2382,33 @@ future<> repair::tablet_repair_task_impl::run() {
                 auto my_address = erm->get_topology().my_address();
                 auto participants = std::list<gms::inet_address>(m.neighbors.all.begin(), m.neighbors.all.end());
                 participants.push_front(my_address);
-                bool hints_batchlog_flushed = co_await flush_hints(rs, id, rs._db.local(), m.keyspace_name, tables, ignore_nodes, participants);
-                bool small_table_optimization = false;
 
-                auto task_impl_ptr = seastar::make_shared<repair::shard_repair_task_impl>(rs._repair_module, tasks::task_id::create_random_id(),
-                        m.keyspace_name, rs, erm, std::move(ranges), std::move(table_ids), id, std::move(data_centers), std::move(hosts),
-                        std::move(ignore_nodes), reason, hints_batchlog_flushed, small_table_optimization, ranges_parallelism);
-                task_impl_ptr->neighbors = std::move(neighbors);
-                auto task = co_await rs._repair_module->make_task(std::move(task_impl_ptr), parent_data);
-                task->start();
-                auto res = co_await coroutine::as_future(task->done());
+                auto peers = m.neighbors.all;
+                co_await rs.container().invoke_on(0, [peers] (repair_service& shard0_rs) {
+                    return shard0_rs.acquire_tablet_repair_sessions(peers);
+                });
+                future<> res = make_ready_future<>();
+                std::exception_ptr ex;
+                try {
+                    bool hints_batchlog_flushed = co_await flush_hints(rs, id, rs._db.local(), m.keyspace_name, tables, ignore_nodes, participants);
+                    bool small_table_optimization = false;
+
+                    auto task_impl_ptr = seastar::make_shared<repair::shard_repair_task_impl>(rs._repair_module, tasks::task_id::create_random_id(),
+                            m.keyspace_name, rs, erm, std::move(ranges), std::move(table_ids), id, std::move(data_centers), std::move(hosts),
+                            std::move(ignore_nodes), reason, hints_batchlog_flushed, small_table_optimization, ranges_parallelism);
+                    task_impl_ptr->neighbors = std::move(neighbors);
+                    auto task = co_await rs._repair_module->make_task(std::move(task_impl_ptr), parent_data);
+                    task->start();
+                    res = co_await coroutine::as_future(task->done());
+                } catch (...) {
+                    ex = std::current_exception();
+                }
+                co_await rs.container().invoke_on(0, [peers = std::move(peers)] (repair_service& shard0_rs) {
+                    shard0_rs.release_tablet_repair_sessions(peers);
+                });
+                if (ex) {
+                    co_await coroutine::return_exception_ptr(std::move(ex));
+                }
                 if (res.failed()) {
                     auto ep = res.get_exception();
                     sstring ignore_msg;
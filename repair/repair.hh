@@ -234,6 +234,7 @@ struct repair_row_on_wire_with_cmd {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_bucketed_set_rpc_stream,
 };
 
 std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo);
@@ -261,6 +262,26 @@ struct repair_flush_hints_batchlog_request {
 struct repair_flush_hints_batchlog_response {
 };
 
+// Request of the REPAIR_GET_BUCKET_ROW_HASHES RPC verb
+struct repair_get_bucket_row_hashes_request {
+    uint32_t repair_meta_id;
+    uint32_t dst_cpu_id;
+    // Split the working row buf into bucket_boundaries.size() + 1 buckets,
+    // bucket i holds the rows within (bucket_boundaries[i - 1], bucket_boundaries[i]]
+    // and the last one the rows after bucket_boundaries.back().
+    std::vector<repair_sync_boundary> bucket_boundaries;
+    // The combined hashes of the buckets on the repair master
+    std::vector<repair_hash> bucket_hashes;
+};
+
+// Return value of the REPAIR_GET_BUCKET_ROW_HASHES RPC verb
+struct repair_get_bucket_row_hashes_response {
+    // The buckets whose combined hash differs from the one on the repair master
+    std::vector<uint32_t> mismatched_buckets;
+    // The hashes of the rows in the mismatched buckets
+    std::vector<repair_hash> row_hashes;
+};
+
 struct tablet_repair_task_meta {
     sstring keyspace_name;
     sstring table_name;
@@ -22,6 +22,7 @@
 #include "dht/sharder.hh"
 #include "utils/xx_hasher.hh"
 #include "utils/UUID.hh"
+#include "utils/UUID_gen.hh"
 #include "replica/database.hh"
 #include <seastar/util/bool_class.hh>
 #include <seastar/core/metrics_registration.hh>
@@ -224,6 +225,7 @@ static const std::vector<row_level_diff_detect_algorithm>& suportted_diff_detect
     static std::vector<row_level_diff_detect_algorithm> _algorithms = {
         row_level_diff_detect_algorithm::send_full_set,
         row_level_diff_detect_algorithm::send_full_set_rpc_stream,
+        row_level_diff_detect_algorithm::send_bucketed_set_rpc_stream,
     };
     return _algorithms;
 };
@@ -280,10 +282,15 @@ flat_mutation_reader_v2 repair_reader::make_reader(
     read_strategy strategy,
     const dht::sharder& remote_sharder,
     unsigned remote_shard,
-    gc_clock::time_point compaction_time) {
+    gc_clock::time_point compaction_time,
+    unrepaired_only unrepaired) {
     switch (strategy) {
         case read_strategy::local: {
-            auto ms = mutation_source([&cf, compaction_time] (
+            static const sstables::sstable_predicate unrepaired_predicate = [] (const sstables::sstable& sst) {
+                return !sst.is_repaired();
+            };
+            const auto& predicate = unrepaired ? unrepaired_predicate : sstables::default_sstable_predicate();
+            auto ms = mutation_source([&cf, compaction_time, &predicate] (
                 schema_ptr s,
                 reader_permit permit,
                 const dht::partition_range& pr,
@@ -291,7 +298,7 @@ flat_mutation_reader_v2 repair_reader::make_reader(
                 tracing::trace_state_ptr,
                 streamed_mutation::forwarding,
                 mutation_reader::forwarding fwd_mr) {
-                return cf.make_streaming_reader(std::move(s), std::move(permit), pr, ps, fwd_mr, compaction_time);
+                return cf.make_streaming_reader(std::move(s), std::move(permit), pr, ps, fwd_mr, compaction_time, predicate);
             });
             flat_mutation_reader_v2 rd(nullptr);
             std::tie(rd, _reader_handle) = make_manually_paused_evictable_reader_v2(
@@ -343,14 +350,15 @@ repair_reader::repair_reader(
     unsigned remote_shard,
     uint64_t seed,
     read_strategy strategy,
-    gc_clock::time_point compaction_time)
+    gc_clock::time_point compaction_time,
+    unrepaired_only unrepaired)
     : _schema(s)
     , _permit(std::move(permit))
     , _range(dht::to_partition_range(range))
     , _sharder(remote_sharder, range, remote_shard)
     , _seed(seed)
     , _local_read_op(strategy == read_strategy::local ? std::optional(cf.read_in_progress()) : std::nullopt)
-    , _reader(make_reader(db, cf, strategy, remote_sharder, remote_shard, compaction_time))
+    , _reader(make_reader(db, cf, strategy, remote_sharder, remote_shard, compaction_time, unrepaired))
 { }
 
 future<mutation_fragment_opt>
@@ -784,6 +792,7 @@ class repair_meta {
     std::optional<shared_future<>> _stopped;
     repair_hasher _repair_hasher;
     gc_clock::time_point _compaction_time;
+    bool _incremental;
     bool _is_tablet;
     reader_concurrency_semaphore::inactive_read_handle _fake_inactive_read_handle;
 public:
@@ -822,6 +831,14 @@ class repair_meta {
     bool use_rpc_stream() const {
         return is_rpc_stream_supported(_algo);
     }
+    // Incremental repair reads only the sstables which are not repaired yet.
+    // Decided by the master, so that all the replicas read the same data.
+    bool incremental() const {
+        return _incremental;
+    }
+    bool use_bucket_row_hashes() const {
+        return _algo == row_level_diff_detect_algorithm::send_bucketed_set_rpc_stream;
+    }
 
 public:
     // master constructor
@@ -842,7 +859,8 @@ class repair_meta {
             size_t nr_peer_nodes,
             std::vector<std::optional<shard_id>> all_live_peer_shards,
             row_level_repair* row_level_repair_ptr,
-            gc_clock::time_point compaction_time)
+            gc_clock::time_point compaction_time,
+            bool incremental)
             : _rs(rs)
             , _db(rs.get_db())
             , _messaging(rs.get_messaging())
@@ -882,6 +900,7 @@ class repair_meta {
             , _row_level_repair_ptr(row_level_repair_ptr)
             , _repair_hasher(_seed, _schema)
             , _compaction_time(compaction_time)
+            , _incremental(incremental)
             , _is_tablet(cf.uses_tablets())
             {
             if (master) {
@@ -918,9 +937,10 @@ class repair_meta {
             streaming::stream_reason reason,
             shard_config master_node_shard_config,
             inet_address_vector_replica_set all_live_peer_nodes,
-            gc_clock::time_point compaction_time)
+            gc_clock::time_point compaction_time,
+            bool incremental)
         : repair_meta(rs, cf, std::move(s), std::move(permit), std::move(range), algo, max_row_buf_size, seed, master, repair_meta_id, reason,
-                std::move(master_node_shard_config), std::move(all_live_peer_nodes), 1, {std::nullopt}, nullptr, compaction_time)
+                std::move(master_node_shard_config), std::move(all_live_peer_nodes), 1, {std::nullopt}, nullptr, compaction_time, incremental)
     {
     }
 
@@ -975,6 +995,52 @@ class repair_meta {
         return _peer_row_hash_sets[node_idx];
     }
 
+    // Number of rows of the working row buf of the repair master per bucket
+    // of get_bucket_row_hashes()
+    static constexpr size_t rows_per_hash_bucket = 128;
+
+    // Bucket i holds the rows within (boundaries[i - 1], boundaries[i]],
+    // the last one the rows after boundaries.back().
+    size_t bucket_of(const std::vector<repair_sync_boundary>& boundaries, const repair_row& r) const {
+        auto it = std::lower_bound(boundaries.begin(), boundaries.end(), r.boundary(), [this] (const repair_sync_boundary& b, const repair_sync_boundary& rb) {
+            return _cmp(b, rb) < 0;
+        });
+        return it - boundaries.begin();
+    }
+
+    // Split the rows in _working_row_buf into buckets of about rows_per_hash_bucket rows
+    future<std::vector<repair_sync_boundary>>
+    working_row_buf_bucket_boundaries() const {
+        std::vector<repair_sync_boundary> boundaries;
+        size_t nr = 0;
+        for (const auto& r : _working_row_buf) {
+            if (++nr % rows_per_hash_bucket == 0) {
+                boundaries.push_back(r.boundary());
+            }
+            co_await coroutine::maybe_yield();
+        }
+        // Rows which the master got from other peers are not necessarily in order
+        std::sort(boundaries.begin(), boundaries.end(), [this] (const repair_sync_boundary& a, const repair_sync_boundary& b) {
+            return _cmp(a, b) < 0;
+        });
+        auto last = std::unique(boundaries.begin(), boundaries.end(), [this] (const repair_sync_boundary& a, const repair_sync_boundary& b) {
+            return _cmp(a, b) == 0;
+        });
+        boundaries.erase(last, boundaries.end());
+        co_return boundaries;
+    }
+
+    // Get the combined hashes of the rows in _working_row_buf within each bucket
+    future<std::vector<repair_hash>>
+    working_row_buf_bucket_hashes(const std::vector<repair_sync_boundary>& boundaries) const {
+        std::vector<repair_hash> hashes(boundaries.size() + 1);
+        for (const auto& r : _working_row_buf) {
+            hashes[bucket_of(boundaries, r)].add(r.hash());
+            co_await coroutine::maybe_yield();
+        }
+        co_return hashes;
+    }
+
     // Get a list of row hashes in _working_row_buf
     future<repair_hash_set>
     working_row_hashes() {
@@ -1198,7 +1264,8 @@ class repair_meta {
                         read_strategy);
                     return read_strategy;
                 }),
-                _compaction_time);
+                _compaction_time,
+                repair_reader::unrepaired_only(incremental()));
         }
         try {
             while (cur_size < _max_row_buf_size) {
@@ -1554,6 +1621,71 @@ class repair_meta {
         });
     }
 
+    // RPC API
+    // Return the hashes of the rows in the _working_row_buf of the peer.
+    //
+    // Unlike get_full_row_hashes(), only the hashes of the rows within the
+    // buckets whose combined hash differs between the peer and the local
+    // node are sent on wire. The rows of the other buckets in the
+    // working row buf of the peer are the same as the local ones, so their
+    // hashes are taken from the local working row buf.
+    future<repair_hash_set>
+    get_bucket_row_hashes(gms::inet_address remote_node, shard_id dst_cpu_id) {
+        auto boundaries = co_await working_row_buf_bucket_boundaries();
+        auto bucket_hashes = co_await working_row_buf_bucket_hashes(boundaries);
+        repair_get_bucket_row_hashes_request req{_repair_meta_id, dst_cpu_id, std::move(boundaries), std::move(bucket_hashes)};
+        auto resp = co_await ser::partition_checksum_rpc_verbs::send_repair_get_bucket_row_hashes(&_messaging, msg_addr(remote_node), req);
+        stats().rpc_call_nr++;
+        stats().rx_hashes_nr += resp.row_hashes.size();
+        _metrics.rx_hashes_nr += resp.row_hashes.size();
+
+        std::vector<bool> mismatched(req.bucket_hashes.size());
+        for (auto bucket : resp.mismatched_buckets) {
+            if (bucket >= mismatched.size()) {
+                throw std::runtime_error(format("get_bucket_row_hashes: Got invalid bucket {} from peer={}, buckets={}", bucket, remote_node, mismatched.size()));
+            }
+            mismatched[bucket] = true;
+        }
+        repair_hash_set hashes(resp.row_hashes.begin(), resp.row_hashes.end());
+        for (const auto& r : _working_row_buf) {
+            if (!mismatched[bucket_of(req.bucket_boundaries, r)]) {
+                hashes.emplace(r.hash());
+            }
+            co_await coroutine::maybe_yield();
+        }
+        rlogger.debug("get_bucket_row_hashes: peer={}, buckets={}, mismatched_buckets={}, rx_hashes={}, hashes={}",
+                remote_node, mismatched.size(), resp.mismatched_buckets.size(), resp.row_hashes.size(), hashes.size());
+        co_return hashes;
+    }
+
+    // RPC handler
+    future<repair_get_bucket_row_hashes_response>
+    get_bucket_row_hashes_handler(repair_get_bucket_row_hashes_request req) {
+        auto holder = _gate.hold();
+        if (req.bucket_hashes.size() != req.bucket_boundaries.size() + 1) {
+            throw std::runtime_error(format("get_bucket_row_hashes_handler: Got {} bucket hashes for {} bucket boundaries",
+                    req.bucket_hashes.size(), req.bucket_boundaries.size()));
+        }
+        auto bucket_hashes = co_await working_row_buf_bucket_hashes(req.bucket_boundaries);
+        repair_get_bucket_row_hashes_response resp;
+        std::vector<bool> mismatched(bucket_hashes.size());
+        for (size_t bucket = 0; bucket < bucket_hashes.size(); bucket++) {
+            if (bucket_hashes[bucket] != req.bucket_hashes[bucket]) {
+                mismatched[bucket] = true;
+                resp.mismatched_buckets.push_back(bucket);
+            }
+        }
+        if (!resp.mismatched_buckets.empty()) {
+            for (const auto& r : _working_row_buf) {
+                if (mismatched[bucket_of(req.bucket_boundaries, r)]) {
+                    resp.row_hashes.push_back(r.hash());
+                }
+                co_await coroutine::maybe_yield();
+            }
+        }
+        co_return resp;
+    }
+
     // RPC API
     // Return the combined hashes of the current working row buf
     future<get_combined_row_hash_response>
@@ -1585,7 +1717,7 @@ class repair_meta {
 
     // RPC API
     future<>
-    repair_row_level_start(gms::inet_address remote_node, sstring ks_name, sstring cf_name, dht::token_range range, table_schema_version schema_version, streaming::stream_reason reason, gc_clock::time_point compaction_time, shard_id dst_cpu_id) {
+    repair_row_level_start(gms::inet_address remote_node, sstring ks_name, sstring cf_name, dht::token_range range, table_schema_version schema_version, streaming::stream_reason reason, gc_clock::time_point compaction_time, shard_id dst_cpu_id, bool incremental) {
         if (remote_node == myip()) {
             return make_ready_future<>();
         }
@@ -1599,7 +1731,7 @@ class repair_meta {
         return _messaging.send_repair_row_level_start(msg_addr(remote_node),
                 _repair_meta_id, ks_name, cf_name, std::move(range), _algo, _max_row_buf_size, _seed,
                 _master_node_shard_config.shard, _master_node_shard_config.shard_count, _master_node_shard_config.ignore_msb,
-                remote_partitioner_name, std::move(schema_version), reason, compaction_time, dst_cpu_id).then([ks_name, cf_name] (rpc::optional<repair_row_level_start_response> resp) {
+                remote_partitioner_name, std::move(schema_version), reason, compaction_time, dst_cpu_id, incremental).then([ks_name, cf_name] (rpc::optional<repair_row_level_start_response> resp) {
             if (resp && resp->status == repair_row_level_start_status::no_such_column_family) {
                 return make_exception_future<>(replica::no_such_column_family(ks_name, cf_name));
             } else {
@@ -1613,10 +1745,10 @@ class repair_meta {
     repair_row_level_start_handler(repair_service& repair, gms::inet_address from, uint32_t src_cpu_id, uint32_t repair_meta_id, sstring ks_name, sstring cf_name,
             dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size,
             uint64_t seed, shard_config master_node_shard_config, table_schema_version schema_version, streaming::stream_reason reason,
-            gc_clock::time_point compaction_time, abort_source& as) {
+            gc_clock::time_point compaction_time, bool incremental, abort_source& as) {
         rlogger.debug(">>> Started Row Level Repair (Follower): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, schema_version={}, range={}, seed={}, max_row_buf_siz={}",
                 repair.my_address(), from, repair_meta_id, ks_name, cf_name, schema_version, range, seed, max_row_buf_size);
-        return repair.insert_repair_meta(from, src_cpu_id, repair_meta_id, std::move(range), algo, max_row_buf_size, seed, std::move(master_node_shard_config), std::move(schema_version), reason, compaction_time, as).then([] {
+        return repair.insert_repair_meta(from, src_cpu_id, repair_meta_id, std::move(range), algo, max_row_buf_size, seed, std::move(master_node_shard_config), std::move(schema_version), reason, compaction_time, incremental, as).then([] {
             return repair_row_level_start_response{repair_row_level_start_status::ok};
         }).handle_exception_type([] (replica::no_such_column_family&) {
             return repair_row_level_start_response{repair_row_level_start_status::no_such_column_family};
@@ -2254,6 +2386,40 @@ static future<> repair_get_full_row_hashes_with_rpc_stream_handler(
     });
 }
 
+// Marks the sstables of the range which were written before the repair
+// started as repaired: the repair read all of them, and every replica now has
+// their data, so incremental repairs no longer need to read them.
+static future<> mark_sstables_repaired(replica::database& db, const repair_update_system_table_request& req) {
+    // Leaves room for the clock skew between the repair master and this node.
+    static constexpr auto clock_skew_margin = std::chrono::minutes(1);
+    auto repaired_at = std::chrono::duration_cast<std::chrono::milliseconds>(req.repair_time.time_since_epoch());
+    auto created_before = repaired_at - clock_skew_margin;
+    std::vector<sstables::shared_sstable> sstables;
+    try {
+        sstables = db.find_column_family(req.table_uuid).select_sstables(dht::to_partition_range(req.range));
+    } catch (replica::no_such_column_family&) {
+        co_return;
+    }
+    auto contained = [&req] (const dht::decorated_key& dk) {
+        return req.range.contains(dk.token(), dht::token_comparator());
+    };
+    for (auto& sst : sstables) {
+        // Sstables which were not fully read by the repair, e.g. because they
+        // are also owned by other ranges, or which may have been written after
+        // it started, stay unrepaired.
+        if (sst->is_repaired() || sst->requires_view_building() || !sst->generation().is_uuid_based() ||
+                utils::UUID_gen::unix_timestamp(sst->generation().as_uuid()) >= created_before ||
+                !contained(sst->get_first_decorated_key()) || !contained(sst->get_last_decorated_key())) {
+            continue;
+        }
+        try {
+            co_await sst->mutate_repaired_at(repaired_at.count());
+        } catch (...) {
+            rlogger.warn("repair[{}]: Failed to mark sstable {} as repaired: {}", req.repair_uuid, sst->get_filename(), std::current_exception());
+        }
+    }
+}
+
 future<repair_update_system_table_response> repair_service::repair_update_system_table_handler(gms::inet_address from, repair_update_system_table_request req) {
     rlogger.debug("repair[{}]: Got repair_update_system_table_request from node={}, range={}, repair_time={}", req.repair_uuid, from, req.range, req.repair_time);
     auto& db = this->get_db();
@@ -2275,6 +2441,11 @@ future<repair_update_system_table_response> repair_service::repair_update_system
         auto& gc_state = local_db.get_compaction_manager().get_tombstone_gc_state();
         return gc_state.update_repair_time(req.table_uuid, req.range, req.repair_time);
     });
+    if (db.local().get_config().enable_incremental_repair()) {
+        co_await db.invoke_on_all([&req] (replica::database& local_db) {
+            return mark_sstables_repaired(local_db, req);
+        });
+    }
     db::system_keyspace::repair_history_entry ent;
     ent.id = req.repair_uuid;
     ent.table_uuid = req.table_uuid;
@@ -2448,12 +2619,13 @@ future<> repair_service::init_ms_handlers() {
     ms.register_repair_row_level_start([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring ks_name,
             sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed,
             unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version,
-            rpc::optional<streaming::stream_reason> reason, rpc::optional<gc_clock::time_point> compaction_time, rpc::optional<shard_id> dst_cpu_id_opt) {
+            rpc::optional<streaming::stream_reason> reason, rpc::optional<gc_clock::time_point> compaction_time, rpc::optional<shard_id> dst_cpu_id_opt,
+            rpc::optional<bool> incremental) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
         auto shard = get_dst_shard_id(src_cpu_id, dst_cpu_id_opt);
         auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         return container().invoke_on(shard, [from, src_cpu_id, repair_meta_id, ks_name, cf_name,
-                range, algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, schema_version, reason, compaction_time, this] (repair_service& local_repair) mutable {
+                range, algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, schema_version, reason, compaction_time, incremental, this] (repair_service& local_repair) mutable {
             if (!local_repair._view_builder.local_is_initialized()) {
                 return make_exception_future<repair_row_level_start_response>(std::runtime_error(format("Node {} is not fully initialized for repair, try again later",
                         local_repair.my_address())));
@@ -2463,7 +2635,7 @@ future<> repair_service::init_ms_handlers() {
             return repair_meta::repair_row_level_start_handler(local_repair, from, src_cpu_id, repair_meta_id, std::move(ks_name),
                     std::move(cf_name), std::move(range), algo, max_row_buf_size, seed,
                     shard_config{remote_shard, remote_shard_count, remote_ignore_msb},
-                    schema_version, r, ct, _repair_module->abort_source());
+                    schema_version, r, ct, incremental.value_or(false), _repair_module->abort_source());
         });
     });
     ms.register_repair_row_level_stop([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
@@ -2504,6 +2676,20 @@ future<> repair_service::init_ms_handlers() {
         auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         return repair_flush_hints_batchlog_handler(from, std::move(req));
     });
+    ser::partition_checksum_rpc_verbs::register_repair_get_bucket_row_hashes(&ms, [this] (const rpc::client_info& cinfo, repair_get_bucket_row_hashes_request req) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
+        auto shard = get_dst_shard_id(src_cpu_id, rpc::optional<shard_id>(req.dst_cpu_id));
+        return container().invoke_on(shard, [from, req = std::move(req)] (repair_service& local_repair) mutable {
+            auto rm = local_repair.get_repair_meta(from, req.repair_meta_id);
+            rm->set_repair_state_for_local_node(repair_state::get_full_row_hashes_started);
+            return rm->get_bucket_row_hashes_handler(std::move(req)).then([rm] (repair_get_bucket_row_hashes_response resp) {
+                rm->set_repair_state_for_local_node(repair_state::get_full_row_hashes_finished);
+                _metrics.tx_hashes_nr += resp.row_hashes.size();
+                return resp;
+            });
+        });
+    });
 
     return make_ready_future<>();
 }
@@ -2526,7 +2712,8 @@ future<> repair_service::uninit_ms_handlers() {
         ms.unregister_repair_set_estimated_partitions(),
         ms.unregister_repair_get_diff_algorithms(),
         ser::partition_checksum_rpc_verbs::unregister_repair_update_system_table(&ms),
-        ser::partition_checksum_rpc_verbs::unregister_repair_flush_hints_batchlog(&ms)
+        ser::partition_checksum_rpc_verbs::unregister_repair_flush_hints_batchlog(&ms),
+        ser::partition_checksum_rpc_verbs::unregister_repair_get_bucket_row_hashes(&ms)
         ).discard_result();
 }
 
@@ -2817,7 +3004,13 @@ class row_level_repair {
             rlogger.debug("Before master.get_full_row_hashes for node {}, hash_sets={}",
                 node, master.peer_row_hash_sets(node_idx).size());
             // Ask the peer to send the full list hashes in the working row buf.
-            if (master.use_rpc_stream()) {
+            if (master.use_bucket_row_hashes()) {
+                // Only the hashes of the rows in the buckets which differ
+                // between the peer and the local node are sent on wire.
+                ns.state = repair_state::get_full_row_hashes_started;
+                master.peer_row_hash_sets(node_idx) = master.get_bucket_row_hashes(node, dst_cpu_id).get();
+                ns.state = repair_state::get_full_row_hashes_finished;
+            } else if (master.use_rpc_stream()) {
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_started;
                 master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_with_rpc_stream(node, node_idx, dst_cpu_id).get();
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_finished;
@@ -2982,6 +3175,10 @@ class row_level_repair {
             auto permit = _shard_task.db.local().obtain_reader_permit(_shard_task.db.local().find_column_family(_table_id), "repair-meta", db::no_timeout, {}).get();
 
             auto compaction_time = gc_clock::now();
+            // Repair-based node operations have to read all the data.
+            bool incremental = _shard_task.reason() == streaming::stream_reason::repair
+                    && _shard_task.db.local().get_config().enable_incremental_repair()
+                    && _shard_task.db.local().features().incremental_repair;
 
             repair_meta master(_shard_task.rs,
                     _shard_task.db.local().find_column_family(_table_id),
@@ -2999,7 +3196,8 @@ class row_level_repair {
                     _all_live_peer_nodes.size(),
                     _all_live_peer_shards,
                     this,
-                    compaction_time);
+                    compaction_time,
+                    incremental);
             auto auto_stop_master = defer([&master] {
                 master.stop().handle_exception([] (std::exception_ptr ep) {
                     rlogger.warn("Failed auto-stopping Row Level Repair (Master): {}. Ignored.", ep);
@@ -3016,7 +3214,7 @@ class row_level_repair {
                 parallel_for_each(master.all_nodes(), [&, this] (repair_node_state& ns) {
                     const auto& node = ns.node;
                     ns.state = repair_state::row_level_start_started;
-                    return master.repair_row_level_start(node, _shard_task.get_keyspace(), _cf_name, _range, schema_version, _shard_task.reason(), compaction_time, ns.shard).then([&] () {
+                    return master.repair_row_level_start(node, _shard_task.get_keyspace(), _cf_name, _range, schema_version, _shard_task.reason(), compaction_time, ns.shard, incremental).then([&] () {
                         ns.state = repair_state::row_level_start_finished;
                         nodes_to_stop.push_back(ns);
                         ns.state = repair_state::get_estimated_partitions_started;
@@ -3327,6 +3525,7 @@ repair_service::insert_repair_meta(
         table_schema_version schema_version,
         streaming::stream_reason reason,
         gc_clock::time_point compaction_time,
+        bool incremental,
         abort_source& as) {
     return get_migration_manager().get_schema_for_write(schema_version, {from, src_cpu_id}, get_messaging(), as).then([this,
             from,
@@ -3337,7 +3536,8 @@ repair_service::insert_repair_meta(
             seed,
             master_node_shard_config,
             reason,
-            compaction_time] (schema_ptr s) {
+            compaction_time,
+            incremental] (schema_ptr s) {
         auto& db = get_db();
         auto& cf = db.local().find_column_family(s->id());
         return db.local().obtain_reader_permit(cf, "repair-meta", db::no_timeout, {}).then([s = std::move(s),
@@ -3351,7 +3551,8 @@ repair_service::insert_repair_meta(
                 seed,
                 master_node_shard_config,
                 reason,
-                compaction_time] (reader_permit permit) mutable {
+                compaction_time,
+                incremental] (reader_permit permit) mutable {
         node_repair_meta_id id{from, repair_meta_id};
         auto rm = seastar::make_shared<repair_meta>(*this,
                 cf,
@@ -3366,7 +3567,8 @@ repair_service::insert_repair_meta(
                 reason,
                 std::move(master_node_shard_config),
                 inet_address_vector_replica_set{from},
-                compaction_time);
+                compaction_time,
+                incremental);
         rm->set_repair_state_for_local_node(repair_state::row_level_start_started);
         bool insertion = repair_meta_map().emplace(id, rm).second;
         if (!insertion) {
@@ -110,6 +110,11 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     seastar::semaphore _memory_sem;
     seastar::named_semaphore _load_parallelism_semaphore = {16, named_semaphore_exception_factory{"Load repair history parallelism"}};
 
+    // The number of tablet repairs started by this node which every other
+    // node may still join, see tablet_repair_max_sessions_per_node.
+    // Used only on shard 0.
+    std::unordered_map<gms::inet_address, seastar::semaphore> _tablet_repair_sessions;
+
     future<> _load_history_done = make_ready_future<>();
 
     future<> init_ms_handlers();
@@ -164,6 +169,12 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
             shared_ptr<node_ops_info> ops_info);
 
 public:
+    // Waits until each of the nodes takes part in fewer than
+    // tablet_repair_max_sessions_per_node tablet repairs started by this node,
+    // and accounts for one more. Must be called on shard 0.
+    future<> acquire_tablet_repair_sessions(std::vector<gms::inet_address> nodes);
+    void release_tablet_repair_sessions(const std::vector<gms::inet_address>& nodes) noexcept;
+
     future<> repair_tablets(repair_uniq_id id, sstring keyspace_name, std::vector<sstring> table_names, host2ip_t host2ip, bool primary_replica_only = true, dht::token_range_vector ranges_specified = {}, std::vector<sstring> dcs = {}, std::unordered_set<gms::inet_address> hosts = {}, std::unordered_set<gms::inet_address> ignore_nodes = {}, std::optional<int> ranges_parallelism = std::nullopt);
 
 private:
@@ -229,6 +240,7 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
             table_schema_version schema_version,
             streaming::stream_reason reason,
             gc_clock::time_point compaction_time,
+            bool incremental,
             abort_source& as);
 
     future<>
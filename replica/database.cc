@@ -26,6 +26,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/metrics.hh>
 #include <boost/algorithm/string/erase.hpp>
@@ -40,6 +41,8 @@
 #include "mutation/frozen_mutation.hh"
 #include "mutation/async_utils.hh"
 #include <seastar/core/do_with.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/fstream.hh>
 #include "service/migration_listener.hh"
 #include "cell_locking.hh"
 #include "view_info.hh"
@@ -73,6 +76,7 @@
 #include "replica/data_dictionary_impl.hh"
 #include "replica/global_table_ptr.hh"
 #include "replica/exceptions.hh"
+#include "replica/query_result_cache.hh"
 #include "readers/multi_range.hh"
 #include "readers/multishard.hh"
 
@@ -92,7 +96,12 @@ thread_local dirty_memory_manager default_dirty_memory_manager;
 inline
 flush_controller
 make_flush_controller(const db::config& cfg, backlog_controller::scheduling_group& sg, std::function<double()> fn) {
-    return flush_controller(sg, cfg.memtable_flush_static_shares(), 50ms, cfg.unspooled_dirty_soft_limit(), std::move(fn));
+    return flush_controller(sg, cfg.memtable_flush_static_shares(), 50ms, cfg.unspooled_dirty_soft_limit(), std::move(fn), backlog_controller::feedback_config{
+        .target_backlog = cfg.memtable_flush_controller_target_backlog,
+        .proportional_gain = cfg.backlog_controller_proportional_gain,
+        .integral_gain = cfg.backlog_controller_integral_gain,
+        .derivative_gain = cfg.backlog_controller_derivative_gain,
+    });
 }
 
 keyspace::keyspace(lw_shared_ptr<keyspace_metadata> metadata, config cfg, locator::effective_replication_map_factory& erm_factory)
@@ -377,6 +386,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>("system", *_nop_large_data_handler, _cfg, feat, _row_cache_tracker, dbcfg.available_memory, sst_dir_sem, [&stm]{ return stm.get()->get_my_id(); }, dbcfg.streaming_scheduling_group))
     , _result_memory_limiter(dbcfg.available_memory / 10)
     , _data_listeners(std::make_unique<db::data_listeners>())
+    , _query_result_cache(std::make_unique<query_result_cache>(_cfg.query_result_cache_memory_fraction.operator utils::updateable_value<double>()))
     , _mnotifier(mn)
     , _feat(feat)
     , _shared_token_metadata(stm)
@@ -391,6 +401,10 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.set_admission_filter(_cfg.cache_admission_filter.operator utils::updateable_value<bool>());
+    _row_cache_tracker.set_compressed_tier(_cfg.cache_compressed_tier_memory_fraction.operator utils::updateable_value<double>());
+    _row_cache_tracker.set_hot_partitions(_cfg.cache_hot_partitions.operator utils::updateable_value<uint32_t>());
+    _read_concurrency_sem.set_shed_reads_past_deadline(_cfg.reader_concurrency_semaphore_shed_reads_past_deadline.operator utils::updateable_value<bool>());
 
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
@@ -422,15 +436,30 @@ locator::vnode_effective_replication_map_ptr keyspace::get_vnode_effective_repli
 
 void backlog_controller::adjust() {
     if (controller_disabled()) {
+        _integral_error = 0;
+        _last_error.reset();
+        _last_shares = _static_shares;
         update_controller(_static_shares);
         return;
     }
 
     auto backlog = _current_backlog();
+    auto target = _feedback.target_backlog();
+    _last_backlog = backlog;
+
+    if (target > 0) {
+        _last_shares = feedback_shares(backlog, target);
+    } else {
+        _integral_error = 0;
+        _last_error.reset();
+        _last_shares = shares_of_backlog(backlog);
+    }
+    update_controller(_last_shares);
+}
 
+float backlog_controller::shares_of_backlog(float backlog) const {
     if (backlog >= _control_points.back().input) {
-        update_controller(_control_points.back().output);
-        return;
+        return _control_points.back().output;
     }
 
     // interpolate to find out which region we are. This run infrequently and there are a fixed
@@ -440,10 +469,35 @@ void backlog_controller::adjust() {
         idx++;
     }
 
-    control_point& cp = _control_points[idx];
-    control_point& last = _control_points[idx - 1];
-    float result = last.output + (backlog - last.input) * (cp.output - last.output)/(cp.input - last.input);
-    update_controller(result);
+    const control_point& cp = _control_points[idx];
+    const control_point& last = _control_points[idx - 1];
+    return last.output + (backlog - last.input) * (cp.output - last.output)/(cp.input - last.input);
+}
+
+float backlog_controller::feedback_shares(float backlog, float target) {
+    const float dt = std::chrono::duration<float>(_interval).count();
+    const float max_shares = _control_points.back().output;
+    // Shares can't go to 0, or the process would stop.
+    const float min_shares = std::max(_control_points.front().output, 1.0f);
+
+    auto error = (backlog - target) / target;
+    auto derivative = _last_error ? (error - *_last_error) / dt : 0.0f;
+    _last_error = error;
+
+    auto integral = _integral_error + error * dt;
+    auto correction = _feedback.proportional_gain() * error + _feedback.integral_gain() * integral + _feedback.derivative_gain() * derivative;
+    auto shares = shares_of_backlog(target) + correction * max_shares;
+
+    // Stop accumulating the error while the output is saturated, otherwise the loop keeps
+    // pushing in the same direction long after the backlog crosses the target.
+    if (shares > max_shares) {
+        return max_shares;
+    }
+    if (shares < min_shares) {
+        return min_shares;
+    }
+    _integral_error = integral;
+    return shares;
 }
 
 float backlog_controller::backlog_of_shares(float shares) const {
@@ -502,6 +556,12 @@ database::setup_metrics() {
         sm::make_gauge("failed_flushes", _cf_stats.failed_memtables_flushes_count,
                        sm::description("Holds the number of failed memtable flushes. "
                                        "High value in this metric may indicate a permanent failure to flush a memtable.")),
+        sm::make_gauge("controller_backlog", [this] { return _memtable_controller.last_backlog(); },
+                       sm::description("Holds the backlog seen by the memtable flush controller on its last adjustment, as a fraction of the dirty memory threshold.")),
+        sm::make_gauge("controller_shares", [this] { return _memtable_controller.last_shares(); },
+                       sm::description("Holds the shares set by the memtable flush controller on its last adjustment.")),
+        sm::make_gauge("controller_integral_error", [this] { return _memtable_controller.integral_error(); },
+                       sm::description("Holds the error accumulated by the memtable flush controller in closed-loop mode (see memtable_flush_controller_target_backlog).")),
     });
 
     _metrics.add_group("database", {
@@ -586,6 +646,30 @@ database::setup_metrics() {
         sm::make_counter("short_data_queries", _stats->short_data_queries,
                        sm::description("The rate of data queries (data or digest reads) that returned less rows than requested due to result size limiting.")),
 
+        sm::make_counter("inline_data_queries", _stats->inline_data_queries,
+                       sm::description("The rate of single-partition data queries served inline from the row cache, without creating a reader.")),
+
+        sm::make_counter("query_result_cache_hits", _query_result_cache->get_stats().hits,
+                       sm::description("The rate of single-partition data queries answered from the query result cache.")),
+
+        sm::make_counter("query_result_cache_misses", _query_result_cache->get_stats().misses,
+                       sm::description("The rate of cacheable single-partition data queries whose result was not in the query result cache.")),
+
+        sm::make_counter("query_result_cache_insertions", _query_result_cache->get_stats().insertions,
+                       sm::description("The rate of results added to the query result cache.")),
+
+        sm::make_counter("query_result_cache_invalidations", _query_result_cache->get_stats().invalidations,
+                       sm::description("The rate of query result cache entries dropped because the data they were computed from changed.")),
+
+        sm::make_counter("query_result_cache_evictions", _query_result_cache->get_stats().evictions,
+                       sm::description("The rate of query result cache entries evicted to stay within the memory limit.")),
+
+        sm::make_gauge("query_result_cache_entries", _query_result_cache->get_stats().entries,
+                       sm::description("The number of results in the query result cache.")),
+
+        sm::make_gauge("query_result_cache_bytes", _query_result_cache->get_stats().memory_usage,
+                       sm::description("The memory used by the query result cache.")),
+
         sm::make_counter("short_mutation_queries", _stats->short_mutation_queries,
                        sm::description("The rate of mutation queries that returned less rows than requested due to result size limiting.")),
 
@@ -601,6 +685,9 @@ database::setup_metrics() {
         sm::make_counter("multishard_query_failed_reader_saves", _stats->multishard_query_failed_reader_saves,
                        sm::description("The number of times the saving of a shard reader failed.")),
 
+        sm::make_counter("combined_counter_updates", _stats->combined_counter_updates,
+                       sm::description("The number of counter updates applied together with an earlier update of the same partition, see counter_write_combining_window_in_ms.")),
+
         sm::make_total_operations("counter_cell_lock_acquisition", _cl_stats->lock_acquisitions,
                                  sm::description("The number of acquired counter cell locks.")),
 
@@ -741,6 +828,15 @@ database::init_commitlog() {
     if (utils::get_local_injector().enter("decrease_commitlog_base_segment_id")) {
         config.base_segment_id = 0;
     }
+    if (config.segment_groups > 1) {
+        // Keep the system tables apart from the user ones, so that
+        // segments pinned by a slowly flushing user table don't force
+        // flushes of the system tables and vice versa.
+        config.segment_group_of = [this] (const db::cf_id_type& id) -> unsigned {
+            auto t = _tables_metadata.get_table_if_exists(id);
+            return t && is_system_keyspace(t->schema()->ks_name()) ? 1 : 0;
+        };
+    }
     return db::commitlog::create_commitlog(std::move(config)).then([this](db::commitlog&& log) {
         _commitlog = std::make_unique<db::commitlog>(std::move(log));
         _commitlog->add_flush_handler([this](db::cf_id_type id, db::replay_position pos) {
@@ -976,8 +1072,12 @@ future<> database::remove(table& cf) noexcept {
 future<> database::detach_column_family(table& cf) {
     auto uuid = cf.schema()->id();
     co_await remove(cf);
+    _query_result_cache->invalidate(uuid);
     cf.clear_views();
     co_await cf.await_pending_ops();
+    if (auto cl = cf.commitlog()) {
+        cl->forget_table(uuid);
+    }
     co_await foreach_reader_concurrency_semaphore([uuid] (reader_concurrency_semaphore& sem) -> future<> {
         co_await sem.evict_inactive_reads_for_table(uuid);
     });
@@ -1214,6 +1314,13 @@ future<> keyspace::update_from(const locator::shared_token_metadata& stm, ::lw_s
    return create_replication_strategy(stm);
 }
 
+static bool has_detailed_table_metrics(const db::config& db_config, const schema& s) {
+    auto table_name = format("{}.{}", s.ks_name(), s.cf_name());
+    return std::ranges::any_of(db_config.detailed_table_metrics(), [&] (const sstring& name) {
+        return name == s.ks_name() || name == table_name;
+    });
+}
+
 column_family::config
 keyspace::make_column_family_config(const schema& s, const database& db) const {
     column_family::config cfg;
@@ -1242,14 +1349,17 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.memtable_to_cache_scheduling_group = _config.memtable_to_cache_scheduling_group;
     cfg.streaming_scheduling_group = _config.streaming_scheduling_group;
     cfg.statement_scheduling_group = _config.statement_scheduling_group;
-    cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
+    cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics() || has_detailed_table_metrics(db_config, s);
     cfg.enable_node_aggregated_table_metrics = db_config.enable_node_aggregated_table_metrics();
     cfg.reversed_reads_auto_bypass_cache = db_config.reversed_reads_auto_bypass_cache;
     cfg.enable_optimized_reversed_reads = db_config.enable_optimized_reversed_reads;
     cfg.tombstone_warn_threshold = db_config.tombstone_warn_threshold();
     cfg.view_update_concurrency_semaphore_limit = _config.view_update_concurrency_semaphore_limit;
     cfg.data_listeners = &db.data_listeners();
+    cfg.query_result_cache = &db.get_query_result_cache();
     cfg.enable_compacting_data_for_streaming_and_repair = db_config.enable_compacting_data_for_streaming_and_repair;
+    cfg.memtable_flush_writers = db_config.memtable_flush_writers;
+    cfg.view_update_coalescing_window_in_us = db_config.view_update_coalescing_window_in_us;
 
     return cfg;
 }
@@ -1488,9 +1598,11 @@ std::optional<db::rate_limiter::can_proceed> database::account_coordinator_opera
         db::per_partition_rate_limit::account_and_enforce account_and_enforce_info,
         db::operation_type op_type) {
 
-    std::optional<uint32_t> table_limit = tbl.schema()->per_partition_rate_limit_options().get_max_ops_per_second(op_type);
+    const auto& options = tbl.schema()->per_partition_rate_limit_options();
+    std::optional<uint32_t> table_limit = options.get_max_ops_per_second(op_type);
     db::rate_limiter::label& lbl = tbl.get_rate_limiter_label_for_op_type(op_type);
-    return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info);
+    return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info,
+            options.get_counting_mode());
 }
 
 static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
@@ -1505,7 +1617,8 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
         return can_proceed::yes;
     }
 
-    auto table_limit = *cf.schema()->per_partition_rate_limit_options().get_max_reads_per_second();
+    const auto& options = cf.schema()->per_partition_rate_limit_options();
+    auto table_limit = *options.get_max_reads_per_second();
     can_proceed ret = can_proceed::yes;
 
     auto& read_label = cf.get_rate_limiter_label_for_reads();
@@ -1514,7 +1627,7 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
             continue;
         }
         auto token = dht::token::to_int64(ranges.front().start()->value().token());
-        if (limiter.account_operation(read_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+        if (limiter.account_operation(read_label, token, table_limit, rate_limit_info, options.get_counting_mode()) == db::rate_limiter::can_proceed::no) {
             // Don't return immediately - account all ranges first
             ret = can_proceed::no;
         }
@@ -1523,21 +1636,91 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
     return ret;
 }
 
+// Point reads (a single row or a partition without clustering rows) are
+// admitted ahead of range scans and reads of whole partitions.
+static reader_concurrency_semaphore::cost_class estimate_read_cost(const schema& s, const query::read_command& cmd,
+        std::span<const dht::partition_range> ranges) {
+    using cost_class = reader_concurrency_semaphore::cost_class;
+    if (ranges.size() != 1 || !ranges.front().is_singular()) {
+        return cost_class::regular;
+    }
+    if (s.clustering_key_size() == 0) {
+        return cost_class::cheap;
+    }
+    if (cmd.slice.get_specific_ranges()) {
+        return cost_class::regular;
+    }
+    const auto& row_ranges = cmd.slice.default_row_ranges();
+    const bool point = std::ranges::all_of(row_ranges, [&] (const query::clustering_range& r) {
+        return r.is_singular() && r.start()->value().is_full(s);
+    });
+    return point && row_ranges.size() <= cmd.get_row_limit() ? cost_class::cheap : cost_class::regular;
+}
+
 future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
 database::query(schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
-    const auto reversed = cmd.slice.is_reversed();
-    if (reversed) {
-        s = s->make_reversed();
-    }
+    using result_type = std::tuple<lw_shared_ptr<query::result>, cache_temperature>;
+    try {
+        const auto reversed = cmd.slice.is_reversed();
+        if (reversed) {
+            s = s->make_reversed();
+        }
 
-    column_family& cf = find_column_family(cmd.cf_id);
+        column_family& cf = find_column_family(cmd.cf_id);
+
+        if (account_singular_ranges_to_rate_limit(_rate_limiter, cf, ranges, _dbcfg, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+            ++_stats->total_reads_rate_limited;
+            return make_exception_future<result_type>(replica::rate_limit_exception());
+        }
 
-    if (account_singular_ranges_to_rate_limit(_rate_limiter, cf, ranges, _dbcfg, rate_limit_info) == db::rate_limiter::can_proceed::no) {
-        ++_stats->total_reads_rate_limited;
-        co_await coroutine::return_exception(replica::rate_limit_exception());
+        // Hot queries are answered from the query result cache, if their
+        // partition didn't change since the cached result was computed.
+        std::optional<query_result_cache::read_snapshot> result_cache_snapshot;
+        if (_query_result_cache->enabled() && cf.can_cache_query_results() && query_result_cache::is_cacheable(cmd, ranges)) {
+            const dht::ring_position& pos = ranges.front().start()->value();
+            auto phase = cf.get_row_cache().underlying_phase();
+            if (auto result = _query_result_cache->lookup(*s, dht::decorated_key(pos.token(), *pos.key()), cmd, opts, phase)) {
+                tracing::trace(trace_state, "Query result found in cache");
+                ++get_reader_concurrency_semaphore().get_stats().total_successful_reads;
+                return make_ready_future<result_type>(std::tuple(std::move(result), cf.get_global_cache_hit_rate()));
+            }
+            result_cache_snapshot = _query_result_cache->snapshot(phase);
+        }
+        auto cache_result = [this, t = cf.shared_from_this(), &cmd, &ranges, opts, result_cache_snapshot] (const schema& s, const query::result& result) {
+            // Results which may expire are not cached, so entries don't
+            // depend on the query time.
+            if (result_cache_snapshot && !t->may_have_expiring_data()) {
+                const dht::ring_position& pos = ranges.front().start()->value();
+                _query_result_cache->insert(s, dht::decorated_key(pos.token(), *pos.key()), cmd, opts, result,
+                        *result_cache_snapshot, t->get_row_cache().underlying_phase());
+            }
+        };
+
+        // Reads of partitions which can be served inline from cache complete
+        // here, without admission and without deferring.
+        if (auto result = cf.query_inline(s, cmd, opts, ranges, trace_state)) {
+            ++get_reader_concurrency_semaphore().get_stats().total_successful_reads;
+            ++_stats->inline_data_queries;
+            cache_result(*s, *result);
+            return make_ready_future<result_type>(std::tuple(std::move(result), cf.get_global_cache_hit_rate()));
+        }
+
+        if (!result_cache_snapshot) {
+            return do_query(cf, std::move(s), cmd, opts, ranges, std::move(trace_state), timeout);
+        }
+        return do_query(cf, s, cmd, opts, ranges, std::move(trace_state), timeout).then([s, cache_result = std::move(cache_result)] (result_type r) {
+            cache_result(*s, *std::get<0>(r));
+            return r;
+        });
+    } catch (...) {
+        return current_exception_as_future<result_type>();
     }
+}
 
+future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
+database::do_query(column_family& cf, schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
+                tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
     auto& semaphore = get_reader_concurrency_semaphore();
     auto max_result_size = cmd.max_result_size ? *cmd.max_result_size : get_query_max_result_size();
 
@@ -1566,7 +1749,8 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(s, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(s, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func,
+                    estimate_read_cost(*s, cmd, ranges)));
         }
 
         if (!f.failed()) {
@@ -1633,7 +1817,8 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(s, "mutation-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(s, "mutation-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func,
+                    estimate_read_cost(*s, cmd, std::span(&range, 1))));
         }
 
         if (!f.failed()) {
@@ -1726,11 +1911,8 @@ std::ostream& operator<<(std::ostream& out, const database& db) {
     return out;
 }
 
-future<mutation> database::do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema,
+future<mutation> database::do_apply_counter_update(column_family& cf, mutation m,
                                                    db::timeout_clock::time_point timeout,tracing::trace_state_ptr trace_state) {
-    auto m = fm.unfreeze(m_schema);
-    m.upgrade(cf.schema());
-
     // prepare partition slice
     query::column_id_vector static_columns;
     static_columns.reserve(m.partition().static_row().size());
@@ -1784,6 +1966,46 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     });
 }
 
+future<mutation> database::combine_counter_update(column_family& cf, mutation m,
+                                                  db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state) {
+    auto key = pending_counter_updates_key(m.schema()->id(), m.token());
+    auto& pending = _pending_counter_updates[key];
+    auto it = std::ranges::find_if(pending, [&m] (const lw_shared_ptr<pending_counter_update>& p) {
+        return p->m.schema() == m.schema() && p->m.decorated_key().equal(*m.schema(), m.decorated_key());
+    });
+    if (it != pending.end()) {
+        // Deltas of counter updates add up when applied to each other.
+        tracing::trace(trace_state, "Combining counter update with a pending update of the partition");
+        auto& p = **it;
+        p.m.apply(std::move(m));
+        p.timeout = std::min(p.timeout, timeout);
+        ++_stats->combined_counter_updates;
+        return p.applied.get_shared_future();
+    }
+
+    auto p = make_lw_shared<pending_counter_update>(std::move(m), timeout, std::move(trace_state));
+    pending.push_back(p);
+    auto window = std::chrono::milliseconds(_cfg.counter_write_combining_window_in_ms());
+    // The table waits for the update to be applied before it stops.
+    (void)with_gate(cf.async_gate(), [this, &cf, key, p, window] {
+        return sleep(window).then([this, &cf, key, p] {
+            auto i = _pending_counter_updates.find(key);
+            std::erase(i->second, p);
+            if (i->second.empty()) {
+                _pending_counter_updates.erase(i);
+            }
+            return do_apply_counter_update(cf, std::move(p->m), p->timeout, p->trace_state);
+        }).then_wrapped([p] (future<mutation> f) {
+            if (f.failed()) {
+                p->applied.set_exception(f.get_exception());
+            } else {
+                p->applied.set_value(f.get());
+            }
+        });
+    });
+    return p->applied.get_shared_future();
+}
+
 future<> memtable_list::flush() {
     if (!may_flush()) {
         return make_ready_future<>();
@@ -1850,7 +2072,12 @@ future<mutation> database::apply_counter_update(schema_ptr s, const frozen_mutat
     }
     try {
         auto& cf = find_column_family(m.column_family_id());
-        return do_apply_counter_update(cf, m, s, timeout, std::move(trace_state));
+        auto mut = m.unfreeze(s);
+        mut.upgrade(cf.schema());
+        if (_cfg.counter_write_combining_window_in_ms() && !cf.async_gate().is_closed()) {
+            return combine_counter_update(cf, std::move(mut), timeout, std::move(trace_state));
+        }
+        return do_apply_counter_update(cf, std::move(mut), timeout, std::move(trace_state));
     } catch (no_such_column_family&) {
         dblog.error("Attempting to mutate non-existent table {}", m.column_family_id());
         throw;
@@ -1986,10 +2213,11 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
     auto& cf = find_column_family(uuid);
 
     if (!std::holds_alternative<std::monostate>(rate_limit_info) && can_apply_per_partition_rate_limit(*s, db::operation_type::write)) {
-        auto table_limit = *s->per_partition_rate_limit_options().get_max_writes_per_second();
+        const auto& options = s->per_partition_rate_limit_options();
+        auto table_limit = *options.get_max_writes_per_second();
         auto& write_label = cf.get_rate_limiter_label_for_writes();
         auto token = dht::token::to_int64(dht::get_token(*s, m.key()));
-        if (_rate_limiter.account_operation(write_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+        if (_rate_limiter.account_operation(write_label, token, table_limit, rate_limit_info, options.get_counting_mode()) == db::rate_limiter::can_proceed::no) {
             ++_stats->total_writes_rate_limited;
             co_await coroutine::return_exception(replica::rate_limit_exception());
         }
@@ -2269,6 +2497,10 @@ future<> database::shutdown() {
     co_await _stop_barrier.arrive_and_wait();
     b.cancel();
 
+    _cache_prewarm_as.request_abort();
+    co_await std::exchange(_cache_prewarm, make_ready_future<>());
+    co_await save_cache_keys();
+
     // stop compaction across all shards before closing tables
     co_await _compaction_manager.drain();
     co_await _stop_barrier.arrive_and_wait();
@@ -2824,6 +3056,137 @@ future<> database::drain() {
     b.cancel();
 }
 
+static sstring cache_keys_file_name(std::string_view dir, shard_id shard) {
+    return format("{}/cache_keys-{}.txt", dir, shard);
+}
+
+// The file has one line per partition: the id of the table and the hex-encoded partition key.
+future<> database::save_cache_keys() {
+    auto max_keys = _cfg.cache_keys_to_save();
+    sstring dir = _cfg.saved_caches_directory();
+    if (!max_keys || dir.empty()) {
+        co_return;
+    }
+    auto file_name = cache_keys_file_name(dir, this_shard_id());
+    auto tmp_file_name = file_name + ".tmp";
+    try {
+        co_await recursive_touch_directory(dir);
+        auto f = co_await open_file_dma(tmp_file_name, open_flags::wo | open_flags::create | open_flags::truncate);
+        auto out = co_await make_file_output_stream(std::move(f));
+        size_t count = 0;
+        std::exception_ptr ex;
+        try {
+            auto keys = co_await _row_cache_tracker.get_recent_partition_keys(max_keys);
+            for (const auto& [id, table_keys] : keys) {
+                auto t = get_tables_metadata().get_table_if_exists(id);
+                if (!t) {
+                    continue;
+                }
+                auto& ks = t->schema()->ks_name();
+                if (is_system_keyspace(ks) || _cfg.extensions().is_extension_internal_keyspace(ks)) {
+                    continue;
+                }
+                for (const auto& dk : table_keys) {
+                    co_await out.write(format("{} {}\n", id, to_hex(dk.key().representation())));
+                    ++count;
+                }
+            }
+            co_await out.flush();
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+        co_await rename_file(tmp_file_name, file_name);
+        co_await sync_directory(dir);
+        dblog.info("Saved the keys of {} cached partitions to {}", count, file_name);
+
+        // Files left by a previous run with more shards would be read on the next startup.
+        if (this_shard_id() == 0) {
+            for (auto shard = smp::count; co_await file_exists(cache_keys_file_name(dir, shard)); ++shard) {
+                co_await remove_file(cache_keys_file_name(dir, shard));
+            }
+        }
+    } catch (...) {
+        dblog.warn("Failed to save the keys of cached partitions to {}: {}", file_name, std::current_exception());
+    }
+}
+
+void database::start_cache_prewarm() {
+    if (!_cfg.cache_keys_to_save() || _cfg.saved_caches_directory().empty()) {
+        return;
+    }
+    _cache_prewarm = with_scheduling_group(_dbcfg.streaming_scheduling_group, [this] {
+        return prewarm_cache();
+    });
+}
+
+// Reading the partitions populates the row cache, as well as the partition index
+// cache and the cached index file pages of the sstables they are read from.
+future<> database::prewarm_cache() {
+    sstring dir = _cfg.saved_caches_directory();
+    auto start = db_clock::now();
+    size_t count = 0;
+    try {
+        // The keys of this shard may have been saved by any shard if the shard count changed.
+        for (shard_id shard = 0; co_await file_exists(cache_keys_file_name(dir, shard)); ++shard) {
+            auto text = co_await seastar::util::read_entire_file_contiguous(std::filesystem::path(cache_keys_file_name(dir, shard)));
+            std::string_view lines = text;
+            while (!lines.empty()) {
+                co_await coroutine::maybe_yield();
+                auto line = lines.substr(0, lines.find('\n'));
+                lines.remove_prefix(std::min(line.size() + 1, lines.size()));
+                auto sep = line.find(' ');
+                if (sep == std::string_view::npos) {
+                    continue;
+                }
+                auto t = get_tables_metadata().get_table_if_exists(table_id(utils::UUID(line.substr(0, sep))));
+                if (!t) {
+                    continue;
+                }
+                auto s = t->schema();
+                auto dk = dht::decorate_key(*s, partition_key::from_bytes(from_hex(line.substr(sep + 1))));
+                if (t->shard_for_reads(dk.token()) != this_shard_id()) {
+                    continue;
+                }
+
+                auto range = dht::partition_range::make_singular(dk);
+                auto permit = co_await obtain_reader_permit(*t, "cache-prewarm", db::no_timeout, {});
+                auto reader = t->make_reader_v2(s, std::move(permit), range, s->full_slice());
+                std::exception_ptr ex;
+                try {
+                    co_await reader.consume_pausable([] (mutation_fragment_v2) {
+                        return stop_iteration::no;
+                    });
+                } catch (...) {
+                    ex = std::current_exception();
+                }
+                co_await reader.close();
+                if (ex) {
+                    co_await coroutine::return_exception_ptr(std::move(ex));
+                }
+                ++count;
+
+                if (auto rate = _cfg.cache_prewarm_partitions_per_second()) {
+                    co_await sleep_abortable(std::chrono::microseconds(1000000 / rate), _cache_prewarm_as);
+                } else {
+                    _cache_prewarm_as.check();
+                }
+            }
+        }
+        dblog.info("Warmed up the cache with {} saved partitions in {}s", count,
+                std::chrono::duration_cast<std::chrono::seconds>(db_clock::now() - start).count());
+    } catch (const abort_requested_exception&) {
+        dblog.info("Stopped warming up the cache after {} saved partitions", count);
+    } catch (const sleep_aborted&) {
+        dblog.info("Stopped warming up the cache after {} saved partitions", count);
+    } catch (...) {
+        dblog.warn("Failed to warm up the cache after {} saved partitions: {}", count, std::current_exception());
+    }
+}
+
 size_t database::tables_metadata::size() const noexcept {
     return _column_families.size();
 }
@@ -29,6 +29,7 @@
 #include "types/types.hh"
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
 #include "db/commitlog/replay_position.hh"
 #include "db/commitlog/commitlog_types.hh"
 #include "schema/schema_fwd.hh"
@@ -153,6 +154,7 @@ namespace replica {
 
 using shared_memtable = lw_shared_ptr<memtable>;
 class global_table_ptr;
+class query_result_cache;
 
 // We could just add all memtables, regardless of types, to a single list, and
 // then filter them out when we read them. Here's why I have chosen not to do
@@ -360,6 +362,12 @@ struct table_stats {
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
     utils::estimated_histogram estimated_coordinator_read;
+    // Writes which had to wait for dirty memory to be freed, and how long they waited.
+    int64_t dirty_memory_throttled_writes = 0;
+    utils::time_estimated_histogram dirty_memory_throttle_wait;
+    // Size of the sstables consumed and produced by compactions of this table.
+    int64_t compaction_bytes_read = 0;
+    int64_t compaction_bytes_written = 0;
 };
 
 using storage_options = data_dictionary::storage_options;
@@ -416,6 +424,7 @@ class table : public enable_lw_shared_from_this<table>
         bool enable_node_aggregated_table_metrics = true;
         size_t view_update_concurrency_semaphore_limit;
         db::data_listeners* data_listeners = nullptr;
+        replica::query_result_cache* query_result_cache = nullptr;
         // Not really table-specific (it's a global configuration parameter), but stored here
         // for easy access from `table` member functions:
         utils::updateable_value<bool> reversed_reads_auto_bypass_cache{false};
@@ -423,6 +432,8 @@ class table : public enable_lw_shared_from_this<table>
         uint32_t tombstone_warn_threshold{0};
         unsigned x_log2_compaction_groups{0};
         utils::updateable_value<bool> enable_compacting_data_for_streaming_and_repair;
+        utils::updateable_value<uint32_t> memtable_flush_writers{1};
+        utils::updateable_value<uint32_t> view_update_coalescing_window_in_us{0};
     };
 
     using snapshot_details = db::snapshot_ctl::table_snapshot_details;
@@ -517,6 +528,11 @@ class table : public enable_lw_shared_from_this<table>
     lowres_clock::time_point _percentile_cache_timestamp;
     std::chrono::milliseconds _percentile_cache_value;
 
+    // Latencies of the reads of this table this shard coordinated, per
+    // replica, over the last few seconds.
+    using replica_read_latency_histogram = utils::windowed_histogram<utils::time_estimated_histogram, lowres_clock>;
+    std::unordered_map<gms::inet_address, replica_read_latency_histogram> _replica_read_latencies;
+
     // Phaser used to synchronize with in-progress writes. This is useful for code that,
     // after some modification, needs to ensure that news writes will see it before
     // it can proceed, such as the view building code.
@@ -657,6 +673,14 @@ class table : public enable_lw_shared_from_this<table>
                                         mutation_reader::forwarding fwd_mr,
                                         const sstables::sstable_predicate& = sstables::default_sstable_predicate()) const;
 
+    // Looks up the partitions of the singular ranges in the indexes of the sstables which may
+    // contain them, several partitions at a time, so that the partition index pages are in the
+    // index cache by the time the query reads the partitions one after another. Sstables whose
+    // index page for the partition is already cached are skipped.
+    // Stops early when *stop is set. Runs in the background of the query, under _async_gate.
+    future<> prefetch_partition_indexes(schema_ptr s, reader_permit permit, dht::partition_range_vector ranges,
+            tracing::trace_state_ptr trace_state, lw_shared_ptr<bool> stop) const;
+
     lw_shared_ptr<sstables::sstable_set> make_maintenance_sstable_set() const;
     lw_shared_ptr<const sstables::sstable_set> make_compound_sstable_set() const;
     // Compound sstable set must be refreshed whenever any of its managed sets are changed
@@ -750,10 +774,12 @@ class table : public enable_lw_shared_from_this<table>
             const dht::partition_range_vector& ranges, gc_clock::time_point compaction_time) const;
 
     // Single range overload.
+    // Only the sstables matching the predicate are read, memtables are always read.
     flat_mutation_reader_v2 make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range,
             const query::partition_slice& slice,
             mutation_reader::forwarding fwd_mr,
-            gc_clock::time_point compaction_time) const;
+            gc_clock::time_point compaction_time,
+            const sstables::sstable_predicate& predicate = sstables::default_sstable_predicate()) const;
 
     flat_mutation_reader_v2 make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range, gc_clock::time_point compaction_time) {
         return make_streaming_reader(schema, std::move(permit), range, schema->full_slice(), mutation_reader::forwarding::no, compaction_time);
@@ -868,6 +894,10 @@ class table : public enable_lw_shared_from_this<table>
 
     future<> apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&& h, db::timeout_clock::time_point tmo);
     future<> apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::time_point tmo);
+private:
+    // Accounts the write in the throttling stats if it was blocked by dirty memory pressure.
+    future<> account_dirty_memory_throttling(future<> write);
+public:
 
     // Returns at most "cmd.limit" rows
     // The saved_querier parameter is an input-output parameter which contains
@@ -885,6 +915,26 @@ class table : public enable_lw_shared_from_this<table>
         db::timeout_clock::time_point timeout,
         std::optional<query::querier>* saved_querier = { });
 
+    // Serves a single-partition query straight from the row cache, without
+    // a permit, a querier or a reader, and without deferring, if the partition
+    // is absent from memtables and can be read inline from cache, see
+    // row_cache::read_inline(). Returns nullptr otherwise.
+    lw_shared_ptr<query::result> query_inline(const schema_ptr& s,
+        const query::read_command& cmd,
+        query::result_options opts,
+        const dht::partition_range_vector& ranges,
+        const tracing::trace_state_ptr& trace_state);
+
+    // Whether results of queries of this table can be served from the
+    // database's query_result_cache. Reads of virtual tables and reads
+    // observed by data listeners always have to be executed.
+    bool can_cache_query_results() const noexcept;
+
+    // Whether any memtable or sstable of the table may contain cells or row
+    // markers with a TTL, so that the results of queries of the table may
+    // change as time passes. Conservative, false positives are possible.
+    bool may_have_expiring_data() const;
+
     // Performs a query on given data source returning data in reconcilable form.
     //
     // Reads at most row_limit rows. If less rows are returned, the data source
@@ -1138,6 +1188,9 @@ class table : public enable_lw_shared_from_this<table>
 
     void add_coordinator_read_latency(utils::estimated_histogram::duration latency);
     std::chrono::milliseconds get_coordinator_read_latency_percentile(double percentile);
+    void add_replica_read_latency(gms::inet_address addr, utils::estimated_histogram::duration latency);
+    // Disengaged if there are too few recent reads from the replica to tell.
+    std::optional<std::chrono::milliseconds> get_replica_read_latency_percentile(gms::inet_address addr, double percentile);
 
     secondary_index::secondary_index_manager& get_index_manager() {
         return _index_manager;
@@ -1169,6 +1222,19 @@ class table : public enable_lw_shared_from_this<table>
     future<row_locker::lock_holder> do_push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
             tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts) const;
     std::vector<view_ptr> affected_views(shared_ptr<db::view::view_update_generator> gen, const schema_ptr& base, const mutation& update) const;
+    future<row_locker::lock_holder> coalesce_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, mutation m, std::chrono::microseconds window,
+            db::timeout_clock::time_point timeout, tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem) const;
+
+    // Writes to a base partition whose view updates are generated together,
+    // see view_update_coalescing_window_in_us. The first write generates
+    // them for all writes which joined it by the end of the window, and
+    // shares the base-table lock with them.
+    struct coalesced_view_update {
+        mutation m;
+        std::vector<promise<row_locker::lock_holder>> followers;
+    };
+    // Coalesced writes whose window is still open, by token.
+    mutable std::unordered_multimap<dht::token, lw_shared_ptr<coalesced_view_update>> _coalesced_view_updates;
 
     mutable row_locker _row_locker;
     future<row_locker::lock_holder> local_base_lock(
@@ -1443,18 +1509,34 @@ class database : public peering_sharded_service<database> {
         uint64_t total_reads_rate_limited = 0;
 
         uint64_t short_data_queries = 0;
+        uint64_t inline_data_queries = 0;
         uint64_t short_mutation_queries = 0;
 
         uint64_t multishard_query_unpopped_fragments = 0;
         uint64_t multishard_query_unpopped_bytes = 0;
         uint64_t multishard_query_failed_reader_stops = 0;
         uint64_t multishard_query_failed_reader_saves = 0;
+
+        uint64_t combined_counter_updates = 0;
     };
 
     lw_shared_ptr<db_stats> _stats;
     std::shared_ptr<db_user_types_storage> _user_types;
     std::unique_ptr<cell_locker_stats> _cl_stats;
 
+    // Counter updates of a partition collected to be applied together.
+    struct pending_counter_update {
+        mutation m;
+        db::timeout_clock::time_point timeout;
+        tracing::trace_state_ptr trace_state;
+        shared_promise<mutation> applied;
+
+        pending_counter_update(mutation m, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state)
+            : m(std::move(m)), timeout(timeout), trace_state(std::move(trace_state)) {}
+    };
+    using pending_counter_updates_key = std::pair<table_id, dht::token>;
+    std::unordered_map<pending_counter_updates_key, std::vector<lw_shared_ptr<pending_counter_update>>, utils::tuple_hash> _pending_counter_updates;
+
     const db::config& _cfg;
 
     dirty_memory_manager _system_dirty_memory_manager;
@@ -1496,6 +1578,8 @@ class database : public peering_sharded_service<database> {
     seastar::metrics::metric_groups _metrics;
     bool _enable_incremental_backups = false;
     bool _shutdown = false;
+    seastar::abort_source _cache_prewarm_as;
+    future<> _cache_prewarm = make_ready_future<>();
     bool _enable_autocompaction_toggle = false;
     query::querier_cache _querier_cache;
 
@@ -1509,6 +1593,7 @@ class database : public peering_sharded_service<database> {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    std::unique_ptr<query_result_cache> _query_result_cache;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1541,6 +1626,16 @@ class database : public peering_sharded_service<database> {
 
     future<> drain();
 
+    // Saves the keys of the partitions cached on this shard to saved_caches_directory.
+    // Does nothing unless cache_keys_to_save is set, errors are logged and ignored.
+    future<> save_cache_keys();
+    // Starts reading the partitions saved by save_cache_keys() on the previous shutdown
+    // in the background, in the streaming scheduling group. Stopped by shutdown().
+    void start_cache_prewarm();
+private:
+    future<> prewarm_cache();
+public:
+
     void plug_system_keyspace(db::system_keyspace& sys_ks) noexcept;
     void unplug_system_keyspace() noexcept;
 
@@ -1558,10 +1653,16 @@ class database : public peering_sharded_service<database> {
 
     future<> do_apply(schema_ptr, const frozen_mutation&, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout, db::commitlog_force_sync sync, db::per_partition_rate_limit::info rate_limit_info);
     future<> do_apply_many(const std::vector<frozen_mutation>&, db::timeout_clock::time_point timeout);
+    future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>> do_query(column_family& cf, schema_ptr, const query::read_command& cmd, query::result_options opts,
+            const dht::partition_range_vector& ranges, tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout);
     future<> apply_with_commitlog(column_family& cf, const mutation& m, db::timeout_clock::time_point timeout);
 
-    future<mutation> do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema, db::timeout_clock::time_point timeout,
+    future<mutation> do_apply_counter_update(column_family& cf, mutation m, db::timeout_clock::time_point timeout,
                                              tracing::trace_state_ptr trace_state);
+    // Applies the counter update together with the other updates of the partition
+    // received within counter_write_combining_window_in_ms.
+    future<mutation> combine_counter_update(column_family& cf, mutation m, db::timeout_clock::time_point timeout,
+                                            tracing::trace_state_ptr trace_state);
 
     template<typename Future>
     Future update_write_metrics(Future&& f);
@@ -1857,6 +1958,10 @@ class database : public peering_sharded_service<database> {
         return *_data_listeners;
     }
 
+    query_result_cache& get_query_result_cache() const {
+        return *_query_result_cache;
+    }
+
     // Get the maximum result size for a query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_query_max_result_size() const;
@@ -336,6 +336,9 @@ future<> table_populator::start_subdir(sstables::sstable_state state) {
         .enable_dangerous_direct_import_of_cassandra_counters = _db.local().get_config().enable_dangerous_direct_import_of_cassandra_counters(),
         .allow_loading_materialized_view = true,
         .garbage_collect = true,
+        .sstable_open_config = {
+            .defer_bloom_filter_loading = _db.local().get_config().defer_bloom_filter_loading_on_boot(),
+        },
     };
     co_await distributed_loader::process_sstable_dir(directory, flags);
 
@@ -66,12 +66,24 @@ class stale_topology_exception final : public replica_exception {
 
 using abort_requested_exception = seastar::abort_requested_exception;
 
+// The replica rejected the request because it predicts it can't complete it
+// before its timeout.
+class overloaded_exception final : public replica_exception {
+public:
+    overloaded_exception() noexcept
+            : replica_exception()
+    { }
+
+    virtual const char* what() const noexcept override { return "replica overloaded, request can't complete before its timeout"; }
+};
+
 struct exception_variant {
     std::variant<unknown_exception,
             no_exception,
             rate_limit_exception,
             stale_topology_exception,
-            abort_requested_exception
+            abort_requested_exception,
+            overloaded_exception
     > reason;
 
     exception_variant()
@@ -627,9 +627,9 @@ class flush_reader final : public flat_mutation_reader_v2::impl, private iterato
     flat_mutation_reader_v2_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
-    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m)
+    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m, const dht::partition_range& range)
         : impl(s, std::move(permit))
-        , iterator_reader(std::move(s), m, query::full_partition_range)
+        , iterator_reader(std::move(s), m, range)
         , _flushed_memory(*m)
     {}
     flush_reader(const flush_reader&) = delete;
@@ -750,13 +750,13 @@ memtable::make_flat_reader_opt(schema_ptr s,
 }
 
 flat_mutation_reader_v2
-memtable::make_flush_reader(schema_ptr s, reader_permit permit) {
+memtable::make_flush_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range) {
     if (!_merged_into_cache) {
-        return make_flat_mutation_reader_v2<flush_reader>(std::move(s), std::move(permit), shared_from_this());
+        return make_flat_mutation_reader_v2<flush_reader>(std::move(s), std::move(permit), shared_from_this(), range);
     } else {
         auto& full_slice = s->full_slice();
         return make_flat_mutation_reader_v2<scanning_reader>(std::move(s), shared_from_this(), std::move(permit),
-                      query::full_partition_range, full_slice, mutation_reader::forwarding::no);
+                      range, full_slice, mutation_reader::forwarding::no);
     }
 }
 
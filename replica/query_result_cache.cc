@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/memory.hh>
+
+#include "replica/query_result_cache.hh"
+#include "schema/schema.hh"
+#include "utils/hash.hh"
+
+namespace replica {
+
+static bool bounds_equal(const schema& s, const std::optional<query::clustering_range::bound>& a, const std::optional<query::clustering_range::bound>& b) {
+    if (!a || !b) {
+        return !a && !b;
+    }
+    return a->is_inclusive() == b->is_inclusive() && a->value().equal(s, b->value());
+}
+
+static bool slices_equal(const schema& s, const query::partition_slice& a, const query::partition_slice& b) {
+    if (a.options.mask() != b.options.mask()
+            || a.partition_row_limit() != b.partition_row_limit()
+            || a.static_columns != b.static_columns
+            || a.regular_columns != b.regular_columns
+            || a.get_specific_ranges() || b.get_specific_ranges()) {
+        return false;
+    }
+    auto& ar = a.default_row_ranges();
+    auto& br = b.default_row_ranges();
+    return std::ranges::equal(ar, br, [&s] (const query::clustering_range& x, const query::clustering_range& y) {
+        return x.is_singular() == y.is_singular() && bounds_equal(s, x.start(), y.start()) && bounds_equal(s, x.end(), y.end());
+    });
+}
+
+bool query_result_cache::entry::matches(const schema& s, const dht::decorated_key& dk, const query::read_command& cmd, query::result_options o) const {
+    return schema_version == cmd.schema_version
+        && row_limit == cmd.get_row_limit()
+        && partition_limit == cmd.partition_limit
+        && max_result_size == cmd.max_result_size
+        && opts.request == o.request
+        && opts.digest_algo == o.digest_algo
+        && key.equal(s, dk)
+        && slices_equal(s, slice, cmd.slice);
+}
+
+size_t query_result_cache::index_key_hash::operator()(const index_key& k) const noexcept {
+    return utils::tuple_hash()(k);
+}
+
+query_result_cache::query_result_cache(utils::updateable_value<double> memory_fraction)
+    : _memory_fraction(std::move(memory_fraction))
+{ }
+
+query_result_cache::~query_result_cache() {
+    clear();
+}
+
+size_t query_result_cache::max_memory() const {
+    return std::max(_memory_fraction(), 0.0) * memory::stats().total_memory();
+}
+
+query_result_cache::index_type::iterator query_result_cache::erase(index_type::iterator it) noexcept {
+    auto& e = *it->second;
+    _lru.erase(_lru.iterator_to(e));
+    _stats.memory_usage -= e.memory_usage;
+    --_stats.entries;
+    return _index.erase(it);
+}
+
+void query_result_cache::evict() noexcept {
+    auto budget = max_memory();
+    while (!_lru.empty() && _stats.memory_usage > budget) {
+        auto& e = _lru.front();
+        auto [it, end] = _index.equal_range(index_key(e.table, e.key.token()));
+        while (it->second.get() != &e) {
+            ++it;
+        }
+        erase(it);
+        ++_stats.evictions;
+    }
+}
+
+bool query_result_cache::is_cacheable(const query::read_command& cmd, const dht::partition_range_vector& ranges) {
+    if (ranges.size() != 1 || !query::is_single_partition(ranges.front())) {
+        return false;
+    }
+    if (cmd.slice.options.contains(query::partition_slice::option::bypass_cache) || cmd.slice.get_specific_ranges()) {
+        return false;
+    }
+    // A saved querier, if any, has to be resumed.
+    return !cmd.query_uuid || cmd.is_first_page;
+}
+
+lw_shared_ptr<query::result> query_result_cache::lookup(const schema& s, const dht::decorated_key& dk, const query::read_command& cmd,
+        query::result_options opts, phase_type phase) {
+    auto [it, end] = _index.equal_range(index_key(s.id(), dk.token()));
+    while (it != end) {
+        auto& e = *it->second;
+        if (e.phase != phase) {
+            // Cached under a row_cache snapshot which is gone.
+            it = erase(it);
+            ++_stats.invalidations;
+            continue;
+        }
+        if (e.matches(s, dk, cmd, opts)) {
+            _lru.erase(_lru.iterator_to(e));
+            _lru.push_back(e);
+            ++_stats.hits;
+            auto& r = e.result;
+            return make_lw_shared<query::result>(bytes_ostream(r.buf()), r.digest(), r.last_modified(), r.is_short_read(),
+                    r.row_count_low_bits(), r.partition_count(), r.row_count_high_bits(), r.last_position());
+        }
+        ++it;
+    }
+    ++_stats.misses;
+    return {};
+}
+
+void query_result_cache::insert(const schema& s, const dht::decorated_key& dk, const query::read_command& cmd, query::result_options opts,
+        const query::result& r, read_snapshot rs, phase_type phase) {
+    if (!enabled() || r.is_short_read() || rs.generation != _generation || rs.phase != phase) {
+        return;
+    }
+    auto memory_usage = sizeof(entry) + r.buf().size() + dk.external_memory_usage();
+    if (memory_usage > max_memory()) {
+        return;
+    }
+    auto [it, end] = _index.equal_range(index_key(s.id(), dk.token()));
+    for (; it != end; ++it) {
+        if (it->second->phase == phase && it->second->matches(s, dk, cmd, opts)) {
+            return;
+        }
+    }
+    // The memory tracker of the result isn't copied, the cached result
+    // must not hold on to the memory of the result memory limiter.
+    auto e = std::make_unique<entry>(entry{
+        .table = s.id(),
+        .key = dk,
+        .schema_version = cmd.schema_version,
+        .slice = cmd.slice,
+        .row_limit = cmd.get_row_limit(),
+        .partition_limit = cmd.partition_limit,
+        .max_result_size = cmd.max_result_size,
+        .opts = opts,
+        .phase = phase,
+        .result = query::result(bytes_ostream(r.buf()), r.digest(), r.last_modified(), r.is_short_read(),
+                r.row_count_low_bits(), r.partition_count(), r.row_count_high_bits(), r.last_position()),
+        .memory_usage = memory_usage,
+    });
+    _lru.push_back(*e);
+    _index.emplace(index_key(s.id(), dk.token()), std::move(e));
+    _stats.memory_usage += memory_usage;
+    ++_stats.entries;
+    ++_stats.insertions;
+    evict();
+}
+
+void query_result_cache::invalidate(table_id table, dht::token token) noexcept {
+    ++_generation;
+    auto [it, end] = _index.equal_range(index_key(table, token));
+    while (it != end) {
+        it = erase(it);
+        ++_stats.invalidations;
+    }
+}
+
+void query_result_cache::invalidate(table_id table) noexcept {
+    ++_generation;
+    for (auto it = _index.begin(); it != _index.end();) {
+        if (it->first.first == table) {
+            it = erase(it);
+            ++_stats.invalidations;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void query_result_cache::clear() noexcept {
+    ++_generation;
+    _lru.clear();
+    _index.clear();
+    _stats.memory_usage = 0;
+    _stats.entries = 0;
+}
+
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include <boost/intrusive/list.hpp>
+
+#include "dht/decorated_key.hh"
+#include "query-request.hh"
+#include "query-result.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/phased_barrier.hh"
+#include "utils/updateable_value.hh"
+
+namespace replica {
+
+// Cache of the results of single-partition data queries, keyed by the table,
+// the partition key and the read command, so that hot queries such as
+// "the latest 20 rows of partition X" are answered without reading and
+// merging memtables and cache again.
+//
+// An entry is valid as long as neither the partition nor the table's row
+// cache snapshot changed. Writes drop the entries of the written token, see
+// invalidate(), and entries cached under an older population phase of the
+// table's row_cache are dropped on lookup, which covers flushes, streaming,
+// compaction and truncation. Results of tables which may contain expiring
+// data are not cached, so that the query time is not part of the key.
+//
+// The memory used by the cache is bounded by a fraction of the shard's memory,
+// least recently used entries are evicted first. A fraction of 0 disables it.
+class query_result_cache {
+public:
+    using phase_type = utils::phased_barrier::phase_type;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t insertions = 0;
+        uint64_t invalidations = 0;
+        uint64_t evictions = 0;
+        uint64_t entries = 0;
+        uint64_t memory_usage = 0;
+    };
+
+    // The state of the cache at the start of a read, the result of the read
+    // is inserted only if no write to the table happened meanwhile.
+    struct read_snapshot {
+        uint64_t generation;
+        phase_type phase;
+    };
+private:
+    struct entry {
+        table_id table;
+        dht::decorated_key key;
+        table_schema_version schema_version;
+        query::partition_slice slice;
+        uint64_t row_limit;
+        uint32_t partition_limit;
+        std::optional<query::max_result_size> max_result_size;
+        query::result_options opts;
+        phase_type phase;
+        query::result result;
+        size_t memory_usage;
+        boost::intrusive::list_member_hook<> lru_link;
+
+        bool matches(const schema& s, const dht::decorated_key& dk, const query::read_command& cmd, query::result_options o) const;
+    };
+    using lru_type = boost::intrusive::list<entry,
+        boost::intrusive::member_hook<entry, boost::intrusive::list_member_hook<>, &entry::lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+    using index_key = std::pair<table_id, dht::token>;
+    struct index_key_hash {
+        size_t operator()(const index_key& k) const noexcept;
+    };
+
+    using index_type = std::unordered_multimap<index_key, std::unique_ptr<entry>, index_key_hash>;
+
+    utils::updateable_value<double> _memory_fraction;
+    index_type _index;
+    // Least recently used first.
+    lru_type _lru;
+    // Incremented on every write and invalidation.
+    uint64_t _generation = 0;
+    stats _stats;
+private:
+    size_t max_memory() const;
+    index_type::iterator erase(index_type::iterator it) noexcept;
+    void evict() noexcept;
+public:
+    explicit query_result_cache(utils::updateable_value<double> memory_fraction);
+    ~query_result_cache();
+
+    bool enabled() const {
+        return _memory_fraction() > 0;
+    }
+
+    // Returns true if the result of the query can be cached. Only first pages
+    // of single-partition queries which don't bypass the cache qualify.
+    static bool is_cacheable(const query::read_command& cmd, const dht::partition_range_vector& ranges);
+
+    // Returns a copy of the cached result of the query, or nullptr.
+    // phase is the current population phase of the table's row_cache.
+    lw_shared_ptr<query::result> lookup(const schema& s, const dht::decorated_key& dk, const query::read_command& cmd,
+            query::result_options opts, phase_type phase);
+
+    read_snapshot snapshot(phase_type phase) const noexcept {
+        return {_generation, phase};
+    }
+
+    // Caches a copy of the result, unless it's a short read or the table was
+    // written to or changed its row_cache snapshot since rs was taken.
+    // The result must not contain expiring data, see table::may_have_expiring_data().
+    void insert(const schema& s, const dht::decorated_key& dk, const query::read_command& cmd, query::result_options opts,
+            const query::result& result, read_snapshot rs, phase_type phase);
+
+    // Drops the cached results of the partitions of the table with the given token.
+    void invalidate(table_id table, dht::token token) noexcept;
+
+    // Drops all cached results of the table.
+    void invalidate(table_id table) noexcept;
+
+    void clear() noexcept;
+
+    const stats& get_stats() const {
+        return _stats;
+    }
+};
+
+}
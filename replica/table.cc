@@ -12,10 +12,12 @@
 #include <seastar/coroutine/exception.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/util/closeable.hh>
 #include <seastar/util/defer.hh>
 
 #include "replica/database.hh"
+#include "replica/query_result_cache.hh"
 #include "replica/data_dictionary_impl.hh"
 #include "replica/compaction_group.hh"
 #include "replica/query_state.hh"
@@ -23,6 +25,7 @@
 #include "sstables/sstable_set.hh"
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/index_reader.hh"
 #include "db/schema_tables.hh"
 #include "cell_locking.hh"
 #include "utils/logalloc.hh"
@@ -35,6 +38,7 @@
 #include "sstables/sstable_directory.hh"
 #include "db/system_keyspace.hh"
 #include "query-result-writer.hh"
+#include "mutation_query.hh"
 #include "db/view/view_update_generator.hh"
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -91,6 +95,34 @@ sstables::generation_type table::calculate_generation_for_new_table() {
     return ret;
 }
 
+// Number of partitions whose indexes prefetch_partition_indexes() looks up at a time.
+static constexpr size_t index_prefetch_concurrency = 16;
+
+future<> table::prefetch_partition_indexes(schema_ptr s, reader_permit permit, dht::partition_range_vector ranges,
+        tracing::trace_state_ptr trace_state, lw_shared_ptr<bool> stop) const {
+    auto sstables = _sstables;
+    co_await max_concurrent_for_each(ranges, index_prefetch_concurrency, [&] (const dht::partition_range& range) -> future<> {
+        const auto& pos = range.start()->value();
+        auto key = sstables::key::from_partition_key(*s, *pos.key());
+        for (const auto& sst : sstables->select(range)) {
+            if (*stop) {
+                co_return;
+            }
+            if (!sst->filter_has_key(key) || sst->has_cached_index_page(pos)) {
+                continue;
+            }
+            sstables::index_reader ir(sst, permit, trace_state, sstables::use_caching::yes, true);
+            try {
+                co_await ir.advance_lower_and_check_if_present(pos);
+            } catch (...) {
+                // The read will look the partition up again and handle the error.
+                tlogger.debug("Failed to prefetch the index of {} for {}: {}", sst->get_filename(), pos, std::current_exception());
+            }
+            co_await ir.close();
+        }
+    });
+}
+
 flat_mutation_reader_v2
 table::make_sstable_reader(schema_ptr s,
                                    reader_permit permit,
@@ -110,7 +142,8 @@ table::make_sstable_reader(schema_ptr s,
                 _stats.estimated_sstable_per_read, pr, slice, std::move(trace_state), fwd, fwd_mr, predicate);
     } else {
         return sstables->make_local_shard_sstable_reader(std::move(s), std::move(permit), pr, slice,
-                std::move(trace_state), fwd, fwd_mr, sstables::default_read_monitor_generator(), predicate);
+                std::move(trace_state), fwd, fwd_mr, sstables::default_read_monitor_generator(), predicate,
+                const_cast<column_family*>(this));
     }
 }
 
@@ -324,7 +357,8 @@ table::make_streaming_reader(schema_ptr s, reader_permit permit,
 }
 
 flat_mutation_reader_v2 table::make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range,
-        const query::partition_slice& slice, mutation_reader::forwarding fwd_mr, gc_clock::time_point compaction_time) const {
+        const query::partition_slice& slice, mutation_reader::forwarding fwd_mr, gc_clock::time_point compaction_time,
+        const sstables::sstable_predicate& predicate) const {
     auto trace_state = tracing::trace_state_ptr();
     const auto fwd = streamed_mutation::forwarding::no;
 
@@ -332,7 +366,7 @@ flat_mutation_reader_v2 table::make_streaming_reader(schema_ptr schema, reader_p
     add_memtables_to_reader_list(readers, schema, permit, range, slice, trace_state, fwd, fwd_mr, [&] (size_t memtable_count) {
         readers.reserve(memtable_count + 1);
     });
-    readers.emplace_back(make_sstable_reader(schema, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr));
+    readers.emplace_back(make_sstable_reader(schema, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr, predicate));
     return maybe_compact_for_streaming(
             make_combined_reader(std::move(schema), std::move(permit), std::move(readers), fwd, fwd_mr),
             get_compaction_manager(),
@@ -1320,6 +1354,32 @@ table::seal_active_memtable(compaction_group& cg, flush_permit&& flush_permit) n
     // FIXME: provide back-pressure to upper layers
 }
 
+// Minimal amount of memtable data worth a flush writer of its own.
+static constexpr size_t min_memtable_flush_writer_size = 16 * 1024 * 1024;
+
+// Splits the token range of a compaction group into up to max_writers ranges
+// of equal token span, one per flush writer. Keys are assumed to be evenly
+// distributed over the token space.
+static dht::partition_range_vector split_memtable_for_flush(const dht::token_range& tr, const memtable& mt, size_t max_writers) {
+    auto writers = std::clamp<size_t>(mt.occupancy().used_space() / min_memtable_flush_writer_size, 1, std::max<size_t>(max_writers, 1));
+    if (writers == 1) {
+        return { query::full_partition_range };
+    }
+    auto lo = uint64_t(tr.start() ? tr.start()->value().raw() : std::numeric_limits<int64_t>::min());
+    auto hi = uint64_t(tr.end() ? tr.end()->value().raw() : std::numeric_limits<int64_t>::max());
+    auto step = (hi - lo) / writers;
+    dht::partition_range_vector ranges;
+    ranges.reserve(writers);
+    std::optional<dht::partition_range::bound> start;
+    for (size_t i = 1; i < writers; ++i) {
+        auto boundary = dht::ring_position::ending_at(dht::token(dht::token_kind::key, int64_t(lo + step * i)));
+        ranges.emplace_back(std::move(start), dht::partition_range::bound(boundary, true));
+        start = dht::partition_range::bound(std::move(boundary), false);
+    }
+    ranges.emplace_back(std::move(start), std::nullopt);
+    return ranges;
+}
+
 future<>
 table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtable> old, sstable_write_permit&& permit) {
     auto try_flush = [this, old = std::move(old), permit = make_lw_shared(std::move(permit)), &cg] () mutable -> future<> {
@@ -1345,7 +1405,16 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
             co_await _compaction_manager.maybe_wait_for_sstable_count_reduction(cg.as_table_state());
         }
 
-        auto consumer = _compaction_strategy.make_interposer_consumer(metadata, [this, old, permit, &newtabs, estimated_partitions, &cg] (flat_mutation_reader_v2 reader) mutable -> future<> {
+        // A large enough memtable is split into token-range-disjoint writers
+        // running concurrently, so that they overlap each other's I/O waits.
+        auto ranges = split_memtable_for_flush(cg.token_range(), *old, _config.memtable_flush_writers());
+        if (ranges.size() > 1) {
+            tlogger.debug("Flushing memtable of {}.{} with {} writers", _schema->ks_name(), _schema->cf_name(), ranges.size());
+        }
+        estimated_partitions /= ranges.size();
+
+        auto make_consumer = [this, old, permit, &newtabs, &metadata, estimated_partitions, &cg] {
+          return _compaction_strategy.make_interposer_consumer(metadata, [this, old, permit, &newtabs, estimated_partitions, &cg] (flat_mutation_reader_v2 reader) mutable -> future<> {
           std::exception_ptr ex;
           try {
             sstables::sstable_writer_config cfg = get_sstables_manager().configure_writer("memtable");
@@ -1364,12 +1433,22 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
           }
           co_await reader.close();
           co_await coroutine::return_exception_ptr(std::move(ex));
+          });
+        };
+        // The consumers must outlive the flush.
+        std::vector<reader_consumer_v2> consumers;
+        consumers.reserve(ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            consumers.push_back(make_consumer());
+        }
+
+        auto f = parallel_for_each(boost::irange<size_t>(0, ranges.size()), [&] (size_t i) {
+            return consumers[i](old->make_flush_reader(
+                old->schema(),
+                compaction_concurrency_semaphore().make_tracking_only_permit(old->schema(), "try_flush_memtable_to_sstable()", db::no_timeout, {}),
+                ranges[i]));
         });
 
-        auto f = consumer(old->make_flush_reader(
-            old->schema(),
-            compaction_concurrency_semaphore().make_tracking_only_permit(old->schema(), "try_flush_memtable_to_sstable()", db::no_timeout, {})));
-
         // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
         // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
         // priority inversion.
@@ -1443,6 +1522,9 @@ void table::set_metrics() {
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_compacted_with_tombstones", _stats.memtable_app_stats.rows_compacted_with_tombstones, ms::description("Number of rows scanned during write of a tombstone for the purpose of compaction in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_version_merges", _stats.memtable_app_stats.version_merges, ms::description("Number of partition versions in memtables merged after they stopped being referenced by reads"))(cf)(ks).set_skip_when_empty(),
+                ms::make_histogram("memtable_version_chain_length", ms::description("Histogram of the number of partition versions in memtables seen by reads"),
+                        [this] {return to_metrics_histogram(_stats.memtable_app_stats.version_chain_lengths);})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
                 ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
@@ -1452,7 +1534,12 @@ void table::set_metrics() {
                 ms::make_gauge("pending_compaction", ms::description("Estimated number of compactions pending for this column family"), _stats.pending_compactions)(cf)(ks),
                 ms::make_gauge("pending_sstable_deletions",
                         ms::description("Number of tasks waiting to delete sstables from a table"),
-                        [this] { return _sstable_deletion_sem.waiters(); })(cf)(ks)
+                        [this] { return _sstable_deletion_sem.waiters(); })(cf)(ks),
+                ms::make_counter("dirty_memory_throttled_writes", ms::description("Number of writes which had to wait for dirty memory to be freed"), _stats.dirty_memory_throttled_writes)(cf)(ks).set_skip_when_empty(),
+                ms::make_histogram("dirty_memory_throttle_wait", ms::description("Histogram of the time writes waited for dirty memory to be freed"),
+                        [this] {return to_metrics_histogram(_stats.dirty_memory_throttle_wait);})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                ms::make_counter("compaction_bytes_read", ms::description("Size of the sstables consumed by compactions of this table"), _stats.compaction_bytes_read)(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("compaction_bytes_written", ms::description("Size of the sstables produced by compactions of this table"), _stats.compaction_bytes_written)(cf)(ks).set_skip_when_empty()
         });
 
         // Metrics related to row locking
@@ -1508,7 +1595,10 @@ void table::set_metrics() {
                 ms::make_gauge("live_sstable", ms::description("Live sstable count"), _stats.live_sstable_count)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}),
                 ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}),
                 ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return to_metrics_histogram(_stats.reads.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
-                ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.writes.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty()
+                ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.writes.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                ms::make_counter("dirty_memory_throttled_writes", ms::description("Number of writes which had to wait for dirty memory to be freed"), _stats.dirty_memory_throttled_writes)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                ms::make_counter("compaction_bytes_read", ms::description("Size of the sstables consumed by compactions of this table"), _stats.compaction_bytes_read)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                ms::make_counter("compaction_bytes_written", ms::description("Size of the sstables produced by compactions of this table"), _stats.compaction_bytes_written)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty()
             });
             if (uses_tablets()) {
                 _metrics.add_group("column_family", {
@@ -2382,10 +2472,12 @@ future<table::snapshot_file_set> table::take_snapshot(database& db, sstring json
     auto table_names = std::make_unique<std::unordered_set<sstring>>();
 
     co_await io_check([&jsondir] { return recursive_touch_directory(jsondir); });
+    // The snapshot is sealed by the manifest written after all shards are done, so the
+    // directory needs to be synced only once.
     co_await _sstables_manager.dir_semaphore().parallel_for_each(tables, [&jsondir, &table_names] (sstables::shared_sstable sstable) {
         table_names->insert(sstable->component_basename(sstables::component_type::Data));
         return io_check([sstable, &dir = jsondir] {
-            return sstable->snapshot(dir);
+            return sstable->snapshot(dir, sstables::storage::sync_dir::no);
         });
     });
     co_await io_check(sync_directory, jsondir);
@@ -2872,12 +2964,25 @@ void table::do_apply(compaction_group& cg, db::rp_handle&& h, Args&&... args) {
     _stats.writes.mark(lc);
 }
 
+future<> table::account_dirty_memory_throttling(future<> write) {
+    if (write.available()) {
+        return write;
+    }
+    ++_stats.dirty_memory_throttled_writes;
+    return write.finally([this, started_at = utils::time_estimated_histogram::clock::now()] {
+        _stats.dirty_memory_throttle_wait.add(utils::time_estimated_histogram::clock::now() - started_at);
+    });
+}
+
 future<> table::apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
     auto& cg = compaction_group_for_token(m.token());
     auto holder = cg.async_gate().hold();
-    return dirty_memory_region_group().run_when_memory_available([this, &m, h = std::move(h), &cg, holder = std::move(holder)] () mutable {
+    return account_dirty_memory_throttling(dirty_memory_region_group().run_when_memory_available([this, &m, h = std::move(h), &cg, holder = std::move(holder)] () mutable {
         do_apply(cg, std::move(h), m);
-    }, timeout);
+        if (_config.query_result_cache && _config.query_result_cache->enabled()) {
+            _config.query_result_cache->invalidate(_schema->id(), m.token());
+        }
+    }, timeout));
 }
 
 template void table::do_apply(compaction_group& cg, db::rp_handle&&, const mutation&);
@@ -2890,9 +2995,12 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
     auto& cg = compaction_group_for_key(m.key(), m_schema);
     auto holder = cg.async_gate().hold();
 
-    return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cg, holder = std::move(holder)]() mutable {
+    return account_dirty_memory_throttling(dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cg, holder = std::move(holder)]() mutable {
         do_apply(cg, std::move(h), m, m_schema);
-    }, timeout);
+        if (_config.query_result_cache && _config.query_result_cache->enabled()) {
+            _config.query_result_cache->invalidate(_schema->id(), dht::get_token(*m_schema, m.key()));
+        }
+    }, timeout));
 }
 
 template void table::do_apply(compaction_group& cg, db::rp_handle&&, const frozen_mutation&, const schema_ptr&);
@@ -2961,17 +3069,52 @@ table::query(schema_ptr s,
 
     query_state qs(s, cmd, opts, partition_ranges, std::move(accounter));
 
+    // Partitions of a multi-partition query are read one after another, so without
+    // prefetching every index lookup would wait for the previous partition to be read.
+    auto stop_prefetch = make_lw_shared<bool>(false);
+    auto stop_prefetch_on_exit = defer([stop_prefetch] () noexcept { *stop_prefetch = true; });
+    if (partition_ranges.size() > 1) {
+        // Partitions which are in cache are read from it, without looking at the sstable indexes.
+        const bool reads_cache = cache_enabled() && !cmd.slice.options.contains(query::partition_slice::option::bypass_cache)
+                && !(cmd.slice.is_reversed() && _config.reversed_reads_auto_bypass_cache());
+        dht::partition_range_vector singular_ranges;
+        // Skips the first partition, which the query reads right away.
+        for (const auto& range : std::span(partition_ranges).subspan(1)) {
+            if (!range.is_singular() || !range.start()->value().has_key()) {
+                continue;
+            }
+            const auto& pos = range.start()->value();
+            if (!reads_cache || !_cache.contains(dht::decorated_key(pos.token(), *pos.key()))) {
+                singular_ranges.push_back(range);
+            }
+        }
+        if (!singular_ranges.empty() && !_async_gate.is_closed()) {
+            (void)with_gate(_async_gate, [&] {
+                return prefetch_partition_indexes(s, permit, std::move(singular_ranges), trace_state, stop_prefetch);
+            }).handle_exception([] (std::exception_ptr ep) {
+                tlogger.debug("Failed to prefetch partition indexes: {}", ep);
+            });
+        }
+    }
+
     std::optional<query::querier> querier_opt;
     if (saved_querier) {
         querier_opt = std::move(*saved_querier);
     }
 
+    // Only the selected columns make it into a data-only result, so readers
+    // don't need the values of the others.
+    auto slice = qs.cmd.slice;
+    if (opts.request == query::result_request::only_result) {
+        slice.options.set<query::partition_slice::option::skip_unselected_column_values>();
+    }
+
     while (!qs.done()) {
         auto&& range = *qs.current_partition_range++;
 
         if (!querier_opt) {
             query::querier_base::querier_config conf(_config.tombstone_warn_threshold);
-            querier_opt = query::querier(as_mutation_source(), s, permit, range, qs.cmd.slice, trace_state, conf);
+            querier_opt = query::querier(as_mutation_source(), s, permit, range, slice, trace_state, conf);
         }
         auto& q = *querier_opt;
 
@@ -3006,6 +3149,71 @@ table::query(schema_ptr s,
     co_return make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
 }
 
+lw_shared_ptr<query::result>
+table::query_inline(const schema_ptr& s,
+        const query::read_command& cmd,
+        query::result_options opts,
+        const dht::partition_range_vector& partition_ranges,
+        const tracing::trace_state_ptr& trace_state) {
+    if (partition_ranges.size() != 1 || !query::is_single_partition(partition_ranges.front())) {
+        return {};
+    }
+    if (_virtual_reader || !cache_enabled() || (_config.data_listeners && !_config.data_listeners->empty())) {
+        return {};
+    }
+    if (cmd.slice.is_reversed() || cmd.slice.options.contains(query::partition_slice::option::bypass_cache)) {
+        return {};
+    }
+    // A saved querier, if any, has to be resumed.
+    if (cmd.query_uuid && !cmd.is_first_page) {
+        return {};
+    }
+    if (cmd.get_row_limit() == 0 || cmd.slice.partition_row_limit() == 0 || cmd.partition_limit == 0) {
+        return {};
+    }
+
+    utils::latency_counter lc;
+    const dht::ring_position& pos = partition_ranges.front().start()->value();
+    dht::decorated_key dk(pos.token(), *pos.key());
+    for (auto& cg : storage_group_for_token(pos.token()).compaction_groups()) {
+        for (auto& mt : *cg->memtables()) {
+            if (mt->contains_partition(dk)) {
+                return {};
+            }
+        }
+    }
+    auto m = _cache.read_inline(s, dk);
+    if (!m) {
+        return {};
+    }
+    _stats.reads.set_latency(lc);
+    tracing::trace(trace_state, "Querying partition {} inline from cache", dk);
+    auto result = make_lw_shared<query::result>(query_mutation(std::move(*m), cmd.slice, cmd.get_row_limit(), cmd.timestamp, opts));
+    _stats.reads.mark(lc);
+    return result;
+}
+
+bool table::can_cache_query_results() const noexcept {
+    return !_virtual_reader && !(_config.data_listeners && !_config.data_listeners->empty());
+}
+
+bool table::may_have_expiring_data() const {
+    if (_schema->default_time_to_live() != gc_clock::duration::zero()) {
+        return true;
+    }
+    for (compaction_group& cg : compaction_groups()) {
+        for (auto& mt : *cg.memtables()) {
+            if (mt->get_encoding_stats().min_ttl != gc_clock::duration::max()) {
+                return true;
+            }
+        }
+    }
+    // TTLs are only recorded in the statistics of sstables of the mx format.
+    return std::ranges::any_of(*get_sstables(), [] (const sstables::shared_sstable& sst) {
+        return sst->get_version() < sstables::sstable_version_types::mc || sst->get_stats_metadata().max_ttl != 0;
+    });
+}
+
 future<reconcilable_result>
 table::mutation_query(schema_ptr s,
         reader_permit permit,
@@ -3080,6 +3288,29 @@ std::chrono::milliseconds table::get_coordinator_read_latency_percentile(double
     return _percentile_cache_value;
 }
 
+static constexpr auto replica_read_latency_window = 5s;
+
+void table::add_replica_read_latency(gms::inet_address addr, utils::estimated_histogram::duration latency) {
+    auto now = lowres_clock::now();
+    auto it = _replica_read_latencies.try_emplace(addr, replica_read_latency_window, now).first;
+    it->second.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count(), now);
+}
+
+std::optional<std::chrono::milliseconds> table::get_replica_read_latency_percentile(gms::inet_address addr, double percentile) {
+    auto it = _replica_read_latencies.find(addr);
+    if (it == _replica_read_latencies.end()) {
+        return std::nullopt;
+    }
+    auto now = lowres_clock::now();
+    // Expect a couple of reads above the percentile in the window,
+    // otherwise the estimate is just noise.
+    auto min_count = std::min(2 / std::max(1 - percentile, 0.001), 2000.0);
+    if (it->second.count(now) < min_count) {
+        return std::nullopt;
+    }
+    return std::max(it->second.quantile(percentile, now) / 1000, uint64_t(1)) * 1ms;
+}
+
 void
 table::enable_auto_compaction() {
     // FIXME: unmute backlog. turn table backlog back on.
@@ -3267,8 +3498,52 @@ future<row_locker::lock_holder> table::do_push_view_replica_updates(shared_ptr<d
 
 }
 
+future<row_locker::lock_holder> table::coalesce_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, mutation m, std::chrono::microseconds window,
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem) const {
+    schema_ptr base = schema();
+    m.upgrade(base);
+    auto [begin, end] = _coalesced_view_updates.equal_range(m.token());
+    auto it = std::find_if(begin, end, [&] (const auto& e) {
+        return e.second->m.schema() == base && e.second->m.decorated_key().equal(*base, m.decorated_key());
+    });
+    if (it != end) {
+        auto& batch = *it->second;
+        batch.m.apply(std::move(m));
+        batch.followers.emplace_back();
+        auto f = batch.followers.back().get_future();
+        ++_view_stats.view_update_writes_coalesced;
+        tracing::trace(tr_state, "View updates coalesced with those of a concurrent write to the partition");
+        co_return co_await std::move(f);
+    }
+
+    auto batch = make_lw_shared<coalesced_view_update>(std::move(m));
+    _coalesced_view_updates.emplace(batch->m.token(), batch);
+    co_await seastar::sleep(window);
+    std::tie(begin, end) = _coalesced_view_updates.equal_range(batch->m.token());
+    _coalesced_view_updates.erase(std::find_if(begin, end, [&] (const auto& e) { return e.second == batch; }));
+
+    auto lockf = co_await coroutine::as_future(do_push_view_replica_updates(std::move(gen), base, std::move(batch->m), timeout, as_mutation_source(),
+            std::move(tr_state), sem, {}));
+    if (lockf.failed()) {
+        auto ex = lockf.get_exception();
+        for (auto& p : batch->followers) {
+            p.set_exception(ex);
+        }
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    auto holders = row_locker::lock_holder::share(lockf.get(), batch->followers.size() + 1);
+    for (size_t i = 0; i < batch->followers.size(); ++i) {
+        batch->followers[i].set_value(std::move(holders[i + 1]));
+    }
+    co_return std::move(holders[0]);
+}
+
 future<row_locker::lock_holder> table::push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, const schema_ptr& s, mutation&& m, db::timeout_clock::time_point timeout,
         tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem) const {
+    auto window = std::chrono::microseconds(_config.view_update_coalescing_window_in_us());
+    if (window.count() > 0) {
+        return coalesce_view_replica_updates(std::move(gen), std::move(m), window, timeout, std::move(tr_state), sem);
+    }
     return do_push_view_replica_updates(std::move(gen), s, std::move(m), timeout, as_mutation_source(),
             std::move(tr_state), sem, {});
 }
@@ -3374,6 +3649,12 @@ class compaction_group::table_state : public compaction::table_state {
         return _cg.memtable_has_key(key);
     }
     future<> on_compaction_completion(sstables::compaction_completion_desc desc, sstables::offstrategy offstrategy) override {
+        for (const auto& sst : desc.old_sstables) {
+            _t._stats.compaction_bytes_read += sst->bytes_on_disk();
+        }
+        for (const auto& sst : desc.new_sstables) {
+            _t._stats.compaction_bytes_written += sst->bytes_on_disk();
+        }
         if (offstrategy) {
             co_await _cg.update_sstable_lists_on_off_strategy_completion(std::move(desc));
             _cg.trigger_compaction();
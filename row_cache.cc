@@ -14,9 +14,11 @@
 #include <seastar/core/metrics.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/defer.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "replica/memtable.hh"
 #include <boost/version.hpp>
 #include <sys/sdt.h>
+#include <set>
 #include "read_context.hh"
 #include "real_dirty_memory_accounter.hh"
 #include "readers/delegating_v2.hh"
@@ -26,11 +28,18 @@
 #include "partition_snapshot_reader.hh"
 #include "clustering_key_filter.hh"
 #include "utils/updateable_value.hh"
+#include "utils/histogram_metrics_helper.hh"
+#include "mutation/frozen_mutation.hh"
+#include <lz4.h>
 
 namespace cache {
 
 logging::logger clogger("cache");
 
+// Steps of the cache update on memtable flush running longer than this are logged,
+// with the position they stopped at, to help attribute reactor stalls.
+static constexpr auto long_update_step = std::chrono::milliseconds(10);
+
 }
 
 using namespace std::chrono_literals;
@@ -69,6 +78,7 @@ cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fractio
     , _memtable_cleaner(_region, nullptr, app_stats)
     , _app_stats(app_stats)
     , _index_cache_fraction(std::move(index_cache_fraction))
+    , _demotion_timer([this] { demote_cold_partitions(); })
 {
     if (with_metrics) {
         setup_metrics();
@@ -110,9 +120,13 @@ cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fractio
             //
             // Perhaps this logic should be encapsulated somewhere else, maybe in `class lru` itself.
             size_t total_cache_space = _region.occupancy().total_space();
-            size_t index_cache_space = _partition_index_cache_stats.used_bytes + _index_cached_file_stats.cached_bytes;
+            size_t index_cache_space = _partition_index_cache_stats.used_bytes + _index_cached_file_stats.cached_bytes
+                    + _promoted_index_block_cache_stats.used_bytes;
             bool should_evict_index = index_cache_space > total_cache_space * _index_cache_fraction.get();
 
+            if ((_weighted_caches || _stats.pinned_hot_partitions) && !should_evict_index) {
+                spare_weighted_rows();
+            }
             return _lru.evict(should_evict_index);
         });
     });
@@ -137,6 +151,7 @@ void cache_tracker::set_compaction_scheduling_group(seastar::scheduling_group sg
 namespace sstables {
 void register_index_page_cache_metrics(seastar::metrics::metric_groups&, cached_file_stats&);
 void register_index_page_metrics(seastar::metrics::metric_groups&, partition_index_cache_stats&);
+void register_promoted_index_block_cache_metrics(seastar::metrics::metric_groups&, promoted_index_block_cache_stats&);
 };
 
 void
@@ -156,12 +171,27 @@ cache_tracker::setup_metrics() {
         sm::make_counter("row_removals", sm::description("total number of invalidated rows"), _stats.row_removals),
         sm::make_counter("rows_dropped_by_tombstones", _app_stats.rows_dropped_by_tombstones, sm::description("Number of rows dropped in cache by a tombstone write")),
         sm::make_counter("rows_compacted_with_tombstones", _app_stats.rows_compacted_with_tombstones, sm::description("Number of rows scanned during write of a tombstone for the purpose of compaction in cache")),
+        sm::make_counter("version_merges", _app_stats.version_merges, sm::description("total number of partition versions in cache merged after they stopped being referenced by reads")),
+        sm::make_histogram("version_chain_length", sm::description("histogram of the number of partition versions in cache seen by reads"),
+            [this] { return to_metrics_histogram(_app_stats.version_chain_lengths); }),
         sm::make_counter("static_row_insertions", sm::description("total number of static rows added to cache"), _stats.static_row_insertions),
         sm::make_counter("concurrent_misses_same_key", sm::description("total number of operation with misses same key"), _stats.concurrent_misses_same_key),
         sm::make_counter("partition_merges", sm::description("total number of partitions merged"), _stats.partition_merges),
+        sm::make_counter("partition_merges_preempted", sm::description("number of times the merge of a memtable partition into cache was preempted, to be resumed from the row it stopped at"), _stats.partition_merges_preempted),
+        sm::make_histogram("update_step_latency", sm::description("histogram of the time the cache update on memtable flush ran without yielding"),
+            [this] { return to_metrics_histogram(_update_step_duration); }).set_skip_when_empty(),
         sm::make_counter("partition_evictions", sm::description("total number of evicted partitions"), _stats.partition_evictions),
         sm::make_counter("partition_removals", sm::description("total number of invalidated partitions"), _stats.partition_removals),
         sm::make_counter("mispopulations", sm::description("number of entries not inserted by reads"), _stats.mispopulations),
+        sm::make_counter("row_evictions_spared", sm::description("number of times a row of a table with a cache eviction weight was moved to the back of the LRU instead of being evicted"), _stats.row_evictions_spared),
+        sm::make_gauge("pinned_hot_partitions", sm::description("number of hot partitions whose rows are passed over by eviction while they are cached"), _stats.pinned_hot_partitions),
+        sm::make_gauge("compressed_partitions", sm::description("total number of partitions in the compressed tier of the cache"), _stats.compressed_partitions),
+        sm::make_gauge("compressed_bytes", sm::description("current bytes used by the compressed tier of the cache"), _stats.compressed_bytes),
+        sm::make_counter("compressed_demotions", sm::description("total number of partitions moved from the cache into its compressed tier"), _stats.compressed_demotions),
+        sm::make_counter("compressed_promotions", sm::description("total number of partitions moved from the compressed tier back into the cache by reads"), _stats.compressed_promotions),
+        sm::make_counter("compressed_evictions", sm::description("total number of partitions evicted from the compressed tier to keep it within its memory budget"), _stats.compressed_evictions),
+        sm::make_counter("compressed_removals", sm::description("total number of partitions invalidated in the compressed tier"), _stats.compressed_removals),
+        sm::make_counter("partition_admission_rejections", sm::description("number of partitions missing in cache which were not inserted by reads because the admission filter estimated them colder than evicted partitions"), _stats.partition_admission_rejections),
         sm::make_gauge("partitions", sm::description("total number of cached partitions"), _stats.partitions),
         sm::make_gauge("rows", sm::description("total number of cached rows"), _stats.rows),
         sm::make_counter("reads", sm::description("number of started reads"), _stats.reads),
@@ -185,9 +215,12 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of attempts to compact expired rows during read")),
         sm::make_counter("rows_compacted_away", _stats.rows_compacted_away,
             sm::description("total amount of compacted and removed rows during read")),
+        sm::make_counter("rows_collapsed", _stats.rows_collapsed,
+            sm::description("total amount of rows shadowed by a range tombstone which were removed during read, leaving just the range tombstone")),
     });
     sstables::register_index_page_cache_metrics(_metrics, _index_cached_file_stats);
     sstables::register_index_page_metrics(_metrics, _partition_index_cache_stats);
+    sstables::register_promoted_index_block_cache_metrics(_metrics, _promoted_index_block_cache_stats);
 }
 
 void cache_tracker::clear() {
@@ -195,6 +228,7 @@ void cache_tracker::clear() {
     auto rows_before = _stats.rows;
     // We need to clear garbage first because garbage versions cannot be evicted from,
     // mutation_partition::clear_gently() destroys intrusive tree invariants.
+    _compressed_lru.clear_and_dispose([] (compressed_partition* p) { delete p; });
     with_allocator(_region.allocator(), [this] {
         _garbage.clear();
         _memtable_cleaner.clear();
@@ -273,6 +307,374 @@ void cache_tracker::on_miss_already_populated() noexcept {
     ++_stats.concurrent_misses_same_key;
 }
 
+void cache_tracker::set_admission_filter(utils::updateable_value<bool> enabled) {
+    _admission_filter = std::move(enabled);
+}
+
+// Enough to tell hot partitions from one-off ones among the roughly
+// million of most recent accesses, at 128 KiB per shard.
+static constexpr size_t admission_sketch_width = 32 * 1024;
+
+utils::frequency_sketch* cache_tracker::admission_sketch() {
+    if (!_admission_filter()) {
+        return nullptr;
+    }
+    if (!_admission_sketch) {
+        _admission_sketch = std::make_unique<utils::frequency_sketch>(admission_sketch_width);
+    }
+    return _admission_sketch.get();
+}
+
+void cache_tracker::record_access(utils::frequency_sketch& sketch, uint64_t key_hash) noexcept {
+    if (sketch.record(key_hash)) {
+        _victim_frequency /= 2;
+    }
+}
+
+void cache_tracker::on_partition_access(uint64_t key_hash) {
+    if (auto* sketch = admission_sketch()) {
+        record_access(*sketch, key_hash);
+    }
+}
+
+bool cache_tracker::admit(uint64_t key_hash) {
+    auto* sketch = admission_sketch();
+    if (!sketch) {
+        return true;
+    }
+    record_access(*sketch, key_hash);
+    if (sketch->estimate(key_hash) > _victim_frequency) {
+        return true;
+    }
+    ++_stats.partition_admission_rejections;
+    return false;
+}
+
+void cache_tracker::on_partition_victim(uint64_t key_hash) noexcept {
+    if (_admission_sketch && _admission_filter()) {
+        _victim_frequency = _admission_sketch->estimate(key_hash);
+    }
+}
+
+// The eviction weight of the rows of pinned partitions. No value of _spare_rng
+// is a multiple of it, so they are always passed over.
+static constexpr uint32_t pinned_eviction_weight = std::numeric_limits<uint32_t>::max();
+
+// Returns the cache eviction weight of the table owning the row,
+// or pinned_eviction_weight if the row's partition is pinned.
+//
+// Rows of partitions with more than one version, or belonging to snapshots,
+// are treated as unweighted, so that sparing them cannot reorder them with
+// respect to rows of the other versions.
+static uint32_t cache_eviction_weight_of(rows_entry& e) noexcept {
+    mutation_partition_v2::rows_type::iterator it(&e);
+    partition_version& pv = partition_version::container_of(mutation_partition_v2::container_of(*it.tree_of()));
+    if (!pv.is_referenced_from_entry() || pv.next()) {
+        return 1;
+    }
+    partition_entry& pe = partition_entry::container_of(pv);
+    if (pe.is_locked()) {
+        return 1;
+    }
+    cache_entry& ce = cache_entry::container_of(pe);
+    if (ce.pinned()) {
+        return pinned_eviction_weight;
+    }
+    return ce.schema()->cache_eviction_weight();
+}
+
+// How many rows of weighted tables can be passed over per evicted element.
+// Bounds the work done by a single eviction.
+static constexpr unsigned max_spared_rows_per_eviction = 32;
+
+// Moves rows of weighted tables from the head of the LRU to its tail instead
+// of letting them be evicted. A row of a table with weight w is passed over
+// with probability 1 - 1/w.
+void cache_tracker::spare_weighted_rows() noexcept {
+    for (unsigned i = 0; i < max_spared_rows_per_eviction; ++i) {
+        evictable* e = _lru.least_recently_used();
+        if (!e || e->is_index()) {
+            return;
+        }
+        auto weight = cache_eviction_weight_of(static_cast<rows_entry&>(*e));
+        if (weight <= 1 || _spare_rng() % weight == 0) {
+            return;
+        }
+        _lru.touch(*e);
+        ++_stats.row_evictions_spared;
+    }
+}
+
+// One in so many single-partition reads is sampled.
+static constexpr unsigned hot_partition_sample_period = 16;
+// Number of samples per detection round.
+static constexpr unsigned hot_partition_round_samples = 1024;
+// A hot partition is pinned if it took at least 1/hot_partition_min_share of the samples.
+static constexpr unsigned hot_partition_min_share = 100;
+// With more counters than 1/the minimum share of samples, the space-saving
+// top-k is guaranteed to track all partitions above the minimum share.
+static constexpr size_t hot_partition_top_k_capacity = 256;
+
+void cache_tracker::set_hot_partitions(utils::updateable_value<uint32_t> limit) {
+    _hot_partitions_limit = std::move(limit);
+}
+
+void cache_tracker::on_single_partition_read(const schema_ptr& s, const dht::ring_position& pos) noexcept {
+    if (++_hot_partition_reads % hot_partition_sample_period) {
+        return;
+    }
+    if (!_hot_partitions_limit()) {
+        clear_hot_partitions();
+        return;
+    }
+    try {
+        if (!_hot_partitions_top_k) {
+            _hot_partitions_top_k = std::make_unique<hot_partitions_top_k>(hot_partition_top_k_capacity);
+        }
+        _hot_partitions_top_k->append(hot_partition_key{s, dht::decorated_key(pos.token(), *pos.key())});
+        if (++_hot_partition_samples == hot_partition_round_samples) {
+            refresh_hot_partitions();
+        }
+    } catch (...) {
+        // The round is restarted, the partitions found in the previous one stay pinned.
+        _hot_partitions_top_k.reset();
+        _hot_partition_samples = 0;
+    }
+}
+
+void cache_tracker::refresh_hot_partitions() {
+    std::vector<hot_partition> hot;
+    for (auto& r : _hot_partitions_top_k->top(_hot_partitions_limit())) {
+        bool pinned = (r.count - r.error) * hot_partition_min_share >= _hot_partition_samples;
+        hot.push_back(hot_partition{std::move(r.item.schema), std::move(r.item.key), r.count, r.error, pinned});
+    }
+    auto top_k = std::make_unique<hot_partitions_top_k>(hot_partition_top_k_capacity);
+    clear_hot_partitions();
+    _hot_partitions = std::move(hot);
+    _hot_partitions_top_k = std::move(top_k);
+    for (auto& hp : _hot_partitions) {
+        if (hp.pinned) {
+            set_pinned(hp, true);
+            ++_stats.pinned_hot_partitions;
+        }
+    }
+}
+
+void cache_tracker::set_pinned(const hot_partition& hp, bool pinned) noexcept {
+    auto [begin, end] = _caches.equal_range(hp.schema->id());
+    for (auto it = begin; it != end; ++it) {
+        it->second->set_pinned(hp.key, pinned);
+    }
+}
+
+void cache_tracker::clear_hot_partitions() noexcept {
+    for (auto& hp : _hot_partitions) {
+        if (hp.pinned) {
+            set_pinned(hp, false);
+        }
+    }
+    _hot_partitions.clear();
+    _hot_partitions_top_k.reset();
+    _hot_partition_samples = 0;
+    _stats.pinned_hot_partitions = 0;
+}
+
+compressed_partition::compressed_partition(cache_tracker& tracker, schema_ptr s, dht::decorated_key key, frozen_mutation fm)
+    : _tracker(tracker)
+    , _key(std::move(key))
+    , _schema(std::move(s))
+{
+    bytes_view in = fm.representation().linearize();
+    if (in.size() > LZ4_MAX_INPUT_SIZE) {
+        throw std::runtime_error(seastar::format("partition too large to compress: {} bytes", in.size()));
+    }
+    auto out = std::make_unique<char[]>(LZ4_compressBound(in.size()));
+    auto n = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), out.get(), in.size(), LZ4_compressBound(in.size()));
+    if (n <= 0) {
+        throw std::runtime_error("LZ4 compression of a partition failed");
+    }
+    _data = std::make_unique<char[]>(n);
+    std::copy_n(out.get(), n, _data.get());
+    _compressed_size = n;
+    _size = in.size();
+    ++_tracker._stats.compressed_partitions;
+    _tracker._stats.compressed_bytes += memory_usage();
+}
+
+compressed_partition::~compressed_partition() {
+    --_tracker._stats.compressed_partitions;
+    _tracker._stats.compressed_bytes -= memory_usage();
+}
+
+size_t compressed_partition::memory_usage() const noexcept {
+    return sizeof(*this) + _compressed_size + _key.key().external_memory_usage();
+}
+
+mutation compressed_partition::decompress() const {
+    bytes_ostream out;
+    auto dst = out.write_place_holder(_size);
+    auto n = LZ4_decompress_safe(_data.get(), reinterpret_cast<char*>(dst), _compressed_size, _size);
+    if (n < 0 || uint32_t(n) != _size) {
+        throw std::runtime_error(seastar::format("LZ4 decompression of partition {} failed", _key));
+    }
+    return frozen_mutation(std::move(out)).unfreeze(_schema);
+}
+
+bool compressed_partition::less_comparator::operator()(const compressed_partition& a, const compressed_partition& b) const {
+    return dht::ring_position_comparator(*s)(dht::ring_position_view(a._key), dht::ring_position_view(b._key)) < 0;
+}
+
+bool compressed_partition::less_comparator::operator()(const compressed_partition& a, dht::ring_position_view b) const {
+    return dht::ring_position_comparator(*s)(dht::ring_position_view(a._key), b) < 0;
+}
+
+bool compressed_partition::less_comparator::operator()(dht::ring_position_view a, const compressed_partition& b) const {
+    return dht::ring_position_comparator(*s)(a, dht::ring_position_view(b._key)) < 0;
+}
+
+static constexpr auto demotion_period = 100ms;
+
+// Bounds the work done by a single round of demotion.
+static constexpr unsigned max_demotions_per_round = 256;
+
+void cache_tracker::set_compressed_tier(utils::updateable_value<double> memory_fraction) {
+    _compressed_tier_fraction = std::move(memory_fraction);
+    _row_evictions_at_demotion = _stats.row_evictions;
+    _demotion_timer.rearm_periodic(demotion_period);
+}
+
+size_t cache_tracker::compressed_tier_budget() const noexcept {
+    return std::max(_compressed_tier_fraction(), 0.0) * memory::stats().total_memory();
+}
+
+void cache_tracker::trim_compressed_tier() noexcept {
+    auto budget = compressed_tier_budget();
+    while (!_compressed_lru.empty() && _stats.compressed_bytes > budget) {
+        ++_stats.compressed_evictions;
+        delete &_compressed_lru.front();
+    }
+}
+
+// Returns the cache entry owning the row, if the row belongs to its latest version.
+static cache_entry* demotion_candidate(rows_entry& e) noexcept {
+    mutation_partition_v2::rows_type::iterator it(&e);
+    partition_version& pv = partition_version::container_of(mutation_partition_v2::container_of(*it.tree_of()));
+    if (!pv.is_referenced_from_entry()) {
+        return nullptr;
+    }
+    return &cache_entry::container_of(partition_entry::container_of(pv));
+}
+
+// Demotion only takes place when the cache is full, as indicated by eviction,
+// and takes what eviction would take next, so the compressed tier holds the
+// partitions most recently pushed out of the cache. Elements at the head of
+// the LRU which cannot be demoted are evicted, as the reclaimer would do next.
+void cache_tracker::demote_cold_partitions() noexcept {
+    if (_compressed_tier_fraction() > 0 && _stats.row_evictions != _row_evictions_at_demotion) {
+        for (unsigned i = 0; i < max_demotions_per_round && !need_preempt(); ++i) {
+            evictable* e = _lru.least_recently_used();
+            if (!e) {
+                break;
+            }
+            cache_entry* ce = e->is_index() ? nullptr : demotion_candidate(static_cast<rows_entry&>(*e));
+            bool demoted = false;
+            if (ce) {
+                auto [begin, end] = _caches.equal_range(ce->schema()->id());
+                for (auto it = begin; it != end && !demoted; ++it) {
+                    demoted = it->second->demote(*ce);
+                }
+            }
+            if (!demoted) {
+                with_allocator(_region.allocator(), [this] {
+                    current_tracker = this;
+                    _lru.evict();
+                });
+            }
+        }
+    }
+    _row_evictions_at_demotion = _stats.row_evictions;
+    trim_compressed_tier();
+}
+
+void cache_tracker::register_cache(row_cache& c) {
+    _caches.emplace(c.schema()->id(), &c);
+}
+
+void cache_tracker::unregister_cache(row_cache& c) noexcept {
+    auto [begin, end] = _caches.equal_range(c.schema()->id());
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == &c) {
+            _caches.erase(it);
+            return;
+        }
+    }
+}
+
+rows_entry* cache_tracker::find_row(table_id id, const dht::decorated_key& dk, position_in_partition_view pos) noexcept {
+    auto [begin, end] = _caches.equal_range(id);
+    for (auto it = begin; it != end; ++it) {
+        row_cache& c = *it->second;
+        auto i = c._partitions.find(dk, dht::ring_position_comparator(*c._schema));
+        if (i == c._partitions.end() || i->is_dummy_entry()) {
+            continue;
+        }
+        auto& rows = i->partition().version()->partition().mutable_clustered_rows();
+        auto r = rows.find(pos, rows_entry::tri_compare(*i->schema()));
+        if (r != rows.end() && r->is_linked()) {
+            return &*r;
+        }
+    }
+    return nullptr;
+}
+
+future<std::unordered_map<table_id, std::vector<dht::decorated_key>>> cache_tracker::get_recent_partition_keys(size_t max_keys_per_table) {
+    struct table_keys {
+        std::vector<dht::decorated_key> keys;
+        std::set<dht::decorated_key, dht::decorated_key::less_comparator> seen;
+        explicit table_keys(schema_ptr s) : seen(dht::decorated_key::less_comparator(std::move(s))) {}
+    };
+    std::unordered_map<table_id, table_keys> tables;
+    std::optional<logalloc::reclaim_lock> lock(_region);
+    evictable* e = _lru.most_recently_used();
+    while (e) {
+        // Index entries and rows of older versions of partitions are passed over.
+        cache_entry* ce = e->is_index() ? nullptr : demotion_candidate(static_cast<rows_entry&>(*e));
+        if (ce && !ce->is_dummy_entry()) {
+            auto id = ce->schema()->id();
+            auto& t = tables.try_emplace(id, ce->schema()).first->second;
+            if (t.keys.size() < max_keys_per_table && t.seen.insert(ce->key()).second) {
+                t.keys.push_back(ce->key());
+            }
+            if (need_preempt()) {
+                // The walk resumes from the same row, found again by its key and position,
+                // as the row may have been moved or freed in the meantime. If it is gone,
+                // the walk ends early, with the keys collected so far.
+                auto key = ce->key();
+                auto pos = position_in_partition(static_cast<rows_entry&>(*e).position());
+                lock.reset();
+                co_await coroutine::maybe_yield();
+                lock.emplace(_region);
+                e = find_row(id, key, pos);
+                if (!e) {
+                    break;
+                }
+            }
+        }
+        e = _lru.less_recently_used(*e);
+    }
+    std::unordered_map<table_id, std::vector<dht::decorated_key>> keys;
+    for (auto& [id, t] : tables) {
+        keys.emplace(id, std::move(t.keys));
+    }
+    co_return keys;
+}
+
+void cache_tracker::on_partition_demotion() noexcept {
+    --_stats.partitions;
+    ++_stats.compressed_demotions;
+    allocator().invalidate_references();
+}
+
 void cache_tracker::pinned_dirty_memory_overload(uint64_t bytes) noexcept {
     _stats.pinned_dirty_memory_overload += bytes;
 }
@@ -421,14 +823,16 @@ class single_partition_populating_reader final : public flat_mutation_reader_v2:
         return _read_context->create_underlying().then([this, phase] {
           return _read_context->underlying().underlying()().then([this, phase] (auto&& mfopt) {
             if (!mfopt) {
-                if (phase == _cache.phase_of(_read_context->range().start()->value())) {
+                if (phase != _cache.phase_of(_read_context->range().start()->value())) {
+                    _cache._tracker.on_mispopulate();
+                } else if (_cache.admit(_read_context->key())) {
                     _cache._read_section(_cache._tracker.region(), [this] {
                         _cache.find_or_create_missing(_read_context->key());
                     });
-                } else {
-                    _cache._tracker.on_mispopulate();
                 }
                 _end_of_stream = true;
+            } else if (!_cache.admit(_read_context->key())) {
+                _reader = read_directly_from_underlying(*_read_context, std::move(*mfopt));
             } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                 _reader = _cache._read_section(_cache._tracker.region(), [&] {
                     cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase);
@@ -509,6 +913,19 @@ void row_cache::on_mispopulate() {
     _tracker.on_mispopulate();
 }
 
+static uint64_t admission_hash(const schema& s, const dht::decorated_key& dk) noexcept {
+    // The tracker is shared by all tables, so tell apart equal tokens of different ones.
+    return uint64_t(dk.token().raw()) ^ uint64_t(s.id().uuid().get_least_significant_bits());
+}
+
+bool row_cache::admit(const dht::decorated_key& dk) {
+    if (_tracker.admit(admission_hash(*_schema, dk))) {
+        return true;
+    }
+    _stats.admission_rejections.mark();
+    return false;
+}
+
 void row_cache::on_row_miss() {
     _stats.misses.mark();
     _tracker.on_row_miss();
@@ -573,7 +990,10 @@ class range_populating_reader {
                 _cache.on_partition_miss();
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
-                if (_reader.creation_phase() == _cache.phase_of(key)) {
+                if (!_cache.admit(key)) {
+                    _last_key = row_cache::previous_entry_pointer(key);
+                    return make_ready_future<flat_mutation_reader_v2_opt>(read_directly_from_underlying(_read_context, std::move(*mfopt)));
+                } else if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
                                                                this->can_set_continuity() ? &*_last_key : nullptr);
@@ -793,9 +1213,15 @@ row_cache::make_reader_opt(schema_ptr s,
                 cache_entry& e = *i;
                 upgrade_entry(e);
                 on_partition_hit();
+                _tracker.on_partition_access(admission_hash(*_schema, e.key()));
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
                 return {};
+            } else if (cache_entry* e = promote(pos, i, hint)) {
+                tracing::trace(trace_state, "Range {} found in the compressed tier of cache", range);
+                on_partition_hit();
+                _tracker.on_partition_access(admission_hash(*_schema, e->key()));
+                return e->read(*this, make_context());
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
                 on_partition_miss();
@@ -803,6 +1229,8 @@ row_cache::make_reader_opt(schema_ptr s,
             }
         });
 
+        _tracker.on_single_partition_read(_schema, range.start()->value());
+
         if (mr && fwd == streamed_mutation::forwarding::yes) {
             return make_forwardable(std::move(*mr));
         } else {
@@ -871,10 +1299,13 @@ void row_cache::clear_on_destruction() noexcept {
 }
 
 row_cache::~row_cache() {
+    clear_compressed();
+    _tracker.unregister_cache(*this);
     clear_on_destruction();
 }
 
 void row_cache::clear_now() noexcept {
+    clear_compressed();
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
             _tracker.on_partition_erase();
@@ -1024,6 +1455,13 @@ thread_local preemption_source row_cache::default_preemption_source;
 template <typename Updater>
 future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater updater, preemption_source& preempt_src) {
   return do_update(std::move(eu), [this, &m, &preempt_src, updater = std::move(updater)] {
+    // Must happen before the first deferring point of the update, so that
+    // no read can bring back the old contents of the partitions.
+    if (!_compressed.empty()) {
+        for (replica::memtable_entry& e : m.partitions) {
+            remove_compressed(e.key());
+        }
+    }
     real_dirty_memory_accounter real_dirty_acc(m, _tracker);
     m.on_detach_from_region_group();
     _tracker.region().merge(m); // Now all data in memtable belongs to cache
@@ -1050,6 +1488,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
         });
         partition_presence_checker is_present = _prev_snapshot->make_partition_presence_checker();
         while (!m.partitions.empty()) {
+            const auto step_start = utils::time_estimated_histogram::clock::now();
             with_allocator(_tracker.allocator(), [&] () {
                 auto cmp = dht::ring_position_comparator(*_schema);
                 {
@@ -1072,6 +1511,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                             // this layer has a chance to restore invariants before deferring,
                             // in particular set _prev_snapshot_pos to the correct value.
                             if (update.run() == stop_iteration::no) {
+                                _tracker.on_partition_merge_preempted();
                                 break;
                             }
                             update = {};
@@ -1100,6 +1540,13 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                 }
             });
             real_dirty_acc.commit();
+            const auto step_duration = utils::time_estimated_histogram::clock::now() - step_start;
+            _tracker.on_update_step(step_duration);
+            if (step_duration >= long_update_step) [[unlikely]] {
+                clogger.debug("Cache update of {}.{} ran for {}us without yielding, stopped before {}", _schema->ks_name(), _schema->cf_name(),
+                        std::chrono::duration_cast<std::chrono::microseconds>(step_duration).count(),
+                        _prev_snapshot_pos ? fmt::to_string(*_prev_snapshot_pos) : std::string("the end"));
+            }
             preempt_src.thread_yield();
         }
     }).finally([cleanup = std::move(cleanup)] {});
@@ -1192,6 +1639,7 @@ void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
 }
 
 void row_cache::invalidate_locked(const dht::decorated_key& dk) {
+    remove_compressed(dk);
     auto pos = _partitions.lower_bound(dk, dht::ring_position_comparator(*_schema));
     if (pos == partitions_end() || !pos->key().equal(*_schema, dk)) {
         _tracker.clear_continuity(*pos);
@@ -1215,6 +1663,9 @@ future<> row_cache::invalidate(external_updater eu, const dht::partition_range&
 
 future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&& ranges) {
     return do_update(std::move(eu), [this, ranges = std::move(ranges)] {
+        for (auto&& range : ranges) {
+            remove_compressed(range);
+        }
         return seastar::async([this, ranges = std::move(ranges)] {
             auto on_failure = defer([this] () noexcept {
                 this->clear_now();
@@ -1267,6 +1718,7 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
 }
 
 void row_cache::evict() {
+    clear_compressed();
     while (_tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something) {}
 }
 
@@ -1274,9 +1726,11 @@ row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker,
     : _tracker(tracker)
     , _schema(std::move(s))
     , _partitions(dht::raw_token_less_comparator{})
+    , _compressed(compressed_partition::less_comparator{_schema})
     , _underlying(src())
     , _snapshot_source(std::move(src))
 {
+  update_eviction_weight();
   try {
     with_allocator(_tracker.allocator(), [this, cont] {
         cache_entry entry(cache_entry::dummy_entry_tag{});
@@ -1291,6 +1745,7 @@ row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker,
     clear_on_destruction();
     throw;
   }
+  _tracker.register_cache(*this);
 }
 
 cache_entry::cache_entry(cache_entry&& o) noexcept
@@ -1309,11 +1764,181 @@ void cache_entry::evict(cache_tracker& tracker) noexcept {
 
 void row_cache::set_schema(schema_ptr new_schema) noexcept {
     _schema = std::move(new_schema);
+    update_eviction_weight();
+}
+
+void row_cache::update_eviction_weight() noexcept {
+    if (_schema->cache_eviction_weight() > 1) {
+        if (!_weighted) {
+            _weighted = cache_tracker::weighted_cache_registration(_tracker);
+        }
+    } else {
+        _weighted = {};
+    }
+}
+
+bool row_cache::contains(const dht::decorated_key& key) const {
+    auto i = _partitions.find(key, dht::ring_position_comparator(*_schema));
+    return i != _partitions.end() && !i->is_dummy_entry();
+}
+
+void row_cache::set_pinned(const dht::decorated_key& key, bool pinned) noexcept {
+    auto i = _partitions.find(key, dht::ring_position_comparator(*_schema));
+    if (i != _partitions.end()) {
+        i->set_pinned(pinned);
+    }
+}
+
+// Bounds the stall of freezing a partition on demotion.
+static constexpr size_t max_demoted_partition_rows = 1024;
+
+bool cache_entry::is_complete(size_t max_rows) noexcept {
+    if (_flags._dummy_entry) {
+        return false;
+    }
+    partition_version& pv = *_pe.version();
+    if (pv.next() || !pv.partition().static_row_continuous()) {
+        return false;
+    }
+    size_t rows = 0;
+    for (const rows_entry& row : pv.partition().clustered_rows()) {
+        if (!row.continuous() || ++rows > max_rows) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool cache_entry::is_demotable() noexcept {
+    if (_flags._pinned || _pe._snapshot) {
+        return false;
+    }
+    return is_complete(max_demoted_partition_rows);
+}
+
+// Bounds the work done by a read served inline, without deferring.
+static constexpr size_t max_inline_read_partition_rows = 64;
+
+mutation_opt row_cache::read_inline(const schema_ptr& s, const dht::decorated_key& dk) {
+    auto m = _read_section(_tracker.region(), [&] () -> mutation_opt {
+        partitions_type::bound_hint hint;
+        auto i = _partitions.lower_bound(dk, dht::ring_position_comparator(*_schema), hint);
+        if (!hint.match) {
+            return {};
+        }
+        cache_entry& e = *i;
+        if (e.schema()->version() != s->version() || !e.is_complete(max_inline_read_partition_rows)) {
+            return {};
+        }
+        auto m = with_allocator(standard_allocator(), [&] {
+            return mutation(s, dk, e.partition().squashed(*s, is_evictable::yes));
+        });
+        for (rows_entry& row : e.partition().version()->partition().mutable_clustered_rows()) {
+            _tracker.touch(row);
+        }
+        on_partition_hit();
+        _tracker.on_partition_access(admission_hash(*_schema, e.key()));
+        return m;
+    });
+    if (m) {
+        _tracker.on_single_partition_read(_schema, dht::ring_position(dk));
+    }
+    return m;
+}
+
+bool row_cache::demote(cache_entry& e) noexcept {
+    if (_update_sem.available_units() <= 0 || !e.is_demotable()) {
+        return false;
+    }
+    auto i = _partitions.find(e.key(), dht::ring_position_comparator(*_schema));
+    if (i == _partitions.end() || &*i != &e) {
+        return false;
+    }
+    try {
+        logalloc::reclaim_lock _(_tracker.region());
+        auto p = with_allocator(standard_allocator(), [&] {
+            schema_ptr s = e.schema();
+            auto m = mutation(s, e.key(), e.partition().squashed(*s, is_evictable::yes));
+            return std::make_unique<compressed_partition>(_tracker, std::move(s), e.key(), freeze(m));
+        });
+        remove_compressed(e.key());
+        _compressed.insert(*p);
+        _tracker._compressed_lru.push_back(*p.release());
+    } catch (...) {
+        clogger.debug("Failed to demote partition: {}", std::current_exception());
+        return false;
+    }
+    with_allocator(_tracker.allocator(), [&] {
+        std::next(i)->set_continuous(false);
+        e.evict(_tracker);
+        _tracker.on_partition_demotion();
+        i.erase(dht::raw_token_less_comparator{});
+    });
+    return true;
+}
+
+cache_entry* row_cache::promote(const dht::ring_position& pos, partitions_type::iterator i, const partitions_type::bound_hint& hint) {
+    if (_compressed.empty()) {
+        return nullptr;
+    }
+    auto it = _compressed.find(dht::ring_position_view(pos), _compressed.key_comp());
+    if (it == _compressed.end()) {
+        return nullptr;
+    }
+    compressed_partition& cp = *it;
+    mutation m = with_allocator(standard_allocator(), [&] {
+        return cp.decompress();
+    });
+    cache_entry& e = with_allocator(_tracker.allocator(), [&] () -> cache_entry& {
+        partitions_type::iterator entry = _partitions.emplace_before(i, cp.key().token().raw(), hint,
+                m.schema(), cp.key(), m.partition());
+        _tracker.insert(*entry);
+        entry->set_continuous(i->continuous());
+        return *entry;
+    });
+    ++_tracker._stats.compressed_promotions;
+    with_allocator(standard_allocator(), [&] {
+        delete &cp;
+    });
+    upgrade_entry(e);
+    return &e;
+}
+
+void row_cache::remove_compressed(const dht::decorated_key& dk) noexcept {
+    auto it = _compressed.find(dht::ring_position_view(dk), _compressed.key_comp());
+    if (it != _compressed.end()) {
+        ++_tracker._stats.compressed_removals;
+        with_allocator(standard_allocator(), [&] {
+            delete &*it;
+        });
+    }
+}
+
+void row_cache::remove_compressed(const dht::partition_range& range) noexcept {
+    auto cmp = _compressed.key_comp();
+    auto it = _compressed.lower_bound(dht::ring_position_view::for_range_start(range), cmp);
+    auto end = _compressed.lower_bound(dht::ring_position_view::for_range_end(range), cmp);
+    with_allocator(standard_allocator(), [&] {
+        while (it != end) {
+            ++_tracker._stats.compressed_removals;
+            delete &*it++;
+        }
+    });
+}
+
+void row_cache::clear_compressed() noexcept {
+    with_allocator(standard_allocator(), [&] {
+        _compressed.clear_and_dispose([this] (compressed_partition* p) {
+            ++_tracker._stats.compressed_removals;
+            delete p;
+        });
+    });
 }
 
 void cache_entry::on_evicted(cache_tracker& tracker) noexcept {
     row_cache::partitions_type::iterator it(this);
     std::next(it)->set_continuous(false);
+    tracker.on_partition_victim(admission_hash(*schema(), _key));
     evict(tracker);
     tracker.on_partition_eviction();
     it.erase(dht::raw_token_less_comparator{});
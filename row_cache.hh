@@ -15,6 +15,7 @@
 #include <seastar/core/memory.hh>
 #include <seastar/util/noncopyable_function.hh>
 
+#include "mutation/mutation.hh"
 #include "mutation/mutation_partition.hh"
 #include "utils/phased_barrier.hh"
 #include "utils/histogram.hh"
@@ -59,6 +60,8 @@ class cache_entry {
         bool _head : 1;
         bool _tail : 1;
         bool _train : 1;
+        // Hot partition, see cache_tracker::set_hot_partitions().
+        bool _pinned : 1;
     } _flags{};
     friend class size_calculator;
 
@@ -74,6 +77,8 @@ class cache_entry {
     void set_tail(bool v) noexcept { _flags._tail = v; }
     bool with_train() const noexcept { return _flags._train; }
     void set_train(bool v) noexcept { _flags._train = v; }
+    bool pinned() const noexcept { return _flags._pinned; }
+    void set_pinned(bool v) noexcept { _flags._pinned = v; }
 
     struct dummy_entry_tag{};
     struct evictable_tag{};
@@ -136,6 +141,14 @@ class cache_entry {
     void set_continuous(bool value) noexcept { _flags._continuous = value; }
 
     bool is_dummy_entry() const noexcept { return _flags._dummy_entry; }
+
+    // True iff the partition is fully continuous, has a single version and
+    // at most max_rows rows.
+    bool is_complete(size_t max_rows) noexcept;
+
+    // True iff the partition is complete, isn't pinned and isn't being read,
+    // so that it can be moved into the compressed tier.
+    bool is_demotable() noexcept;
 };
 
 //
@@ -157,6 +170,11 @@ class row_cache final {
                             dht::raw_token_less_comparator, dht::ring_position_comparator,
                             16, bplus::key_search::linear>;
     static_assert(bplus::SimpleLessCompare<int64_t, dht::raw_token_less_comparator>);
+    using compressed_partitions_type = bi::set<cache::compressed_partition,
+        bi::member_hook<cache::compressed_partition, bi::set_member_hook<bi::link_mode<bi::auto_unlink>>,
+            &cache::compressed_partition::_set_link>,
+        bi::constant_time_size<false>,
+        bi::compare<cache::compressed_partition::less_comparator>>;
     friend class cache::autoupdating_underlying_reader;
     friend class single_partition_populating_reader;
     friend class cache_entry;
@@ -213,12 +231,18 @@ class row_cache final {
         utils::timed_rate_moving_average misses;
         utils::timed_rate_moving_average reads_with_misses;
         utils::timed_rate_moving_average reads_with_no_misses;
+        utils::timed_rate_moving_average admission_rejections;
     };
 private:
     cache_tracker& _tracker;
     stats _stats{};
     schema_ptr _schema;
+    cache_tracker::weighted_cache_registration _weighted;
     partitions_type _partitions; // Cached partitions are complete.
+    // Partitions moved out of _partitions by the tracker, see cache_tracker::set_compressed_tier().
+    // Each reflects the current snapshot of the underlying source: partitions
+    // which are written to are removed before the update of the cache starts.
+    compressed_partitions_type _compressed;
 
     // The snapshots used by cache are versioned. The version number of a snapshot is
     // called the "population phase", or simply "phase". Between updates, cache
@@ -269,11 +293,27 @@ class row_cache final {
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
+    void update_eviction_weight() noexcept;
+    // Sets whether the entry of the partition is pinned, if it's cached.
+    void set_pinned(const dht::decorated_key&, bool) noexcept;
+    // Consults the tracker's admission filter about populating a partition which missed in cache.
+    bool admit(const dht::decorated_key&);
     void upgrade_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
     void clear_on_destruction() noexcept;
 
+    // Moves the entry, which must belong to this cache, into the compressed tier.
+    // Returns false if the entry was left in cache.
+    bool demote(cache_entry&) noexcept;
+    // Moves the partition from the compressed tier back into cache, if it's there.
+    // i and hint are the result of the lookup of the key in _partitions, which missed.
+    // Must be run under reclaim lock.
+    cache_entry* promote(const dht::ring_position&, partitions_type::iterator i, const partitions_type::bound_hint& hint);
+    void remove_compressed(const dht::decorated_key&) noexcept;
+    void remove_compressed(const dht::partition_range&) noexcept;
+    void clear_compressed() noexcept;
+
     struct previous_entry_pointer {
         std::optional<dht::decorated_key> _key;
 
@@ -408,6 +448,12 @@ class row_cache final {
     flat_mutation_reader_v2 make_nonpopulating_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range,
             const query::partition_slice& slice, tracing::trace_state_ptr ts);
 
+    // Returns a copy of the partition if it can be read without a reader and
+    // without deferring, i.e. it's cached, complete, small and of schema s.
+    // Returns a disengaged optional otherwise, the partition should be read
+    // with make_reader() then. Like reads, promotes the partition in the LRU.
+    mutation_opt read_inline(const schema_ptr& s, const dht::decorated_key& dk);
+
     const stats& stats() const { return _stats; }
 public:
     // Populate cache from given mutation, which must be fully continuous.
@@ -442,6 +488,9 @@ class row_cache final {
     // that they are not evicted by memory reclaimer.
     void unlink_from_lru(const dht::decorated_key&);
 
+    // Returns true if the partition has an entry in cache, so that reads of it start from the cache.
+    bool contains(const dht::decorated_key&) const;
+
     // Synchronizes cache with the underlying mutation source
     // by invalidating ranges which were modified. This will force
     // them to be re-read from the underlying mutation source
@@ -466,6 +515,12 @@ class row_cache final {
     // If it did, use invalidate() instead.
     void evict();
 
+    // The phase of the current snapshot of the underlying source.
+    // Changes with every update() and invalidate().
+    phase_type underlying_phase() const noexcept {
+        return _underlying_phase;
+    }
+
     const cache_tracker& get_cache_tracker() const {
         return _tracker;
     }
@@ -39,6 +39,11 @@ mod ffi {
 
         type Module;
         fn create_module(engine: &mut Engine, script: &str) -> Result<Box<Module>>;
+        fn create_module_from_precompiled(
+            engine: &mut Engine,
+            precompiled: &[u8],
+        ) -> Result<Box<Module>>;
+        fn precompiled(self: &Module) -> &[u8];
         fn raw_size(self: &Module) -> usize;
         fn is_compiled(self: &Module) -> bool;
         fn compile(self: &mut Module, engine: &mut Engine) -> Result<()>;
@@ -152,10 +157,30 @@ fn create_module(engine: &mut Engine, script: &str) -> Result<Box<Module>> {
     Ok(module)
 }
 
+// The module is deserialized right away, so that modules precompiled by a different
+// version or configuration of the engine are rejected here rather than on first use.
+fn create_module_from_precompiled(engine: &mut Engine, precompiled: &[u8]) -> Result<Box<Module>> {
+    // `deserialize` requires its input to be the result of `precompile_module`,
+    // the caller is responsible for checking the integrity of the precompiled module.
+    let wasmtime_module = unsafe {
+        wasmtime::Module::deserialize(&engine.wasmtime_engine, precompiled)
+            .map_err(|e| anyhow!("Deserialization failed: {:?}", e))?
+    };
+    let module = Box::new(Module {
+        serialized_module: precompiled.to_vec(),
+        wasmtime_module: Some(wasmtime_module),
+        references: 0,
+    });
+    Ok(module)
+}
+
 impl Module {
     fn raw_size(&self) -> usize {
         self.serialized_module.len()
     }
+    fn precompiled(&self) -> &[u8] {
+        &self.serialized_module
+    }
     fn is_compiled(&self) -> bool {
         self.wasmtime_module.is_some()
     }
@@ -33,6 +33,8 @@
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/bloom_filter_extension.hh"
+#include "db/cache_eviction_extension.hh"
 #include "db/tags/utils.hh"
 #include "db/tags/extension.hh"
 
@@ -212,11 +214,39 @@ schema::make_column_specification(const column_definition& def) const {
 v3_columns::v3_columns(std::vector<column_definition> cols, bool is_dense, bool is_compound)
     : _is_dense(is_dense)
     , _is_compound(is_compound)
-    , _columns(std::move(cols))
+    , _owned_columns(std::move(cols))
 {
-    for (column_definition& def : _columns) {
-        _columns_by_name[def.name()] = &def;
+    for (column_definition& def : _owned_columns) {
+        _owned_columns_by_name[def.name()] = &def;
+    }
+}
+
+v3_columns::v3_columns(const std::vector<column_definition>& columns, const std::unordered_map<bytes, const column_definition*>& columns_by_name,
+        bool is_dense, bool is_compound) noexcept
+    : _is_dense(is_dense)
+    , _is_compound(is_compound)
+    , _columns(&columns)
+    , _columns_by_name(&columns_by_name)
+{ }
+
+v3_columns::v3_columns(v3_columns&& o) noexcept
+    : _is_dense(o._is_dense)
+    , _is_compound(o._is_compound)
+    , _owned_columns(std::move(o._owned_columns))
+    , _owned_columns_by_name(std::move(o._owned_columns_by_name))
+    , _columns(o.owns_columns() ? &_owned_columns : o._columns)
+    , _columns_by_name(o.owns_columns() ? &_owned_columns_by_name : o._columns_by_name)
+{
+    o._columns = &o._owned_columns;
+    o._columns_by_name = &o._owned_columns_by_name;
+}
+
+v3_columns& v3_columns::operator=(v3_columns&& o) noexcept {
+    if (this != &o) {
+        this->~v3_columns();
+        new (this) v3_columns(std::move(o));
     }
+    return *this;
 }
 
 v3_columns v3_columns::from_v2_schema(const schema& s) {
@@ -246,6 +276,9 @@ v3_columns v3_columns::from_v2_schema(const schema& s) {
         schema_builder::default_names names(s._raw);
         cols.emplace_back(to_bytes(names.clustering_name()), static_column_name_type, column_kind::clustering_key, 0);
         cols.emplace_back(to_bytes(names.compact_value_name()), s.make_legacy_default_validator(), column_kind::regular_column, 0);
+    } else if (s.regular_column_name_type() == utf8_type) {
+        // Same columns and column specifications as in the schema
+        return v3_columns(s.all_columns(), s._columns_by_name, s.is_dense(), s.is_compound());
     } else {
         cols = s.all_columns();
     }
@@ -261,7 +294,7 @@ v3_columns v3_columns::from_v2_schema(const schema& s) {
 
 void v3_columns::apply_to(schema_builder& builder) const {
     if (is_static_compact()) {
-        for (auto& c : _columns) {
+        for (auto& c : *_columns) {
             if (c.kind == column_kind::regular_column) {
                 builder.set_default_validation_class(c.type);
             } else if (c.kind == column_kind::static_column) {
@@ -275,7 +308,7 @@ void v3_columns::apply_to(schema_builder& builder) const {
             }
         }
     } else {
-        for (auto& c : _columns) {
+        for (auto& c : *_columns) {
             if (is_compact() && c.kind == column_kind::regular_column) {
                 builder.set_default_validation_class(c.type);
             }
@@ -293,11 +326,11 @@ bool v3_columns::is_compact() const {
 }
 
 const std::unordered_map<bytes, const column_definition*>& v3_columns::columns_by_name() const {
-    return _columns_by_name;
+    return *_columns_by_name;
 }
 
 const std::vector<column_definition>& v3_columns::all_columns() const {
-    return _columns;
+    return *_columns;
 }
 
 void schema::rebuild() {
@@ -846,7 +879,18 @@ std::ostream& schema::describe(replica::database& db, std::ostream& os, bool wit
                     os << ", " << clustering_key_columns().front().name_as_cql_string();
                 }
             }
-            os <<");\n";
+            os << ")";
+            n = 0;
+            for (auto& cdef : regular_columns()) {
+                if (cdef.is_view_virtual()) {
+                    continue;
+                }
+                os << (n++ == 0 ? " INCLUDE (" : ", ") << cdef.name_as_cql_string();
+            }
+            if (n != 0) {
+                os << ")";
+            }
+            os << ";\n";
             return os;
         } else {
             os << "MATERIALIZED VIEW " << cql3::util::maybe_quote(ks_name()) << "." << cql3::util::maybe_quote(cf_name()) << " AS\n";
@@ -1411,6 +1455,12 @@ schema_ptr schema_builder::build(schema::raw_schema& new_raw) {
             dynamic_pointer_cast<db::per_partition_rate_limit_extension>(it->second)->get_options();
     }
 
+    // cache the `cache_eviction` weight, it is looked up by the row cache on eviction.
+    if (auto it = new_raw._extensions.find(db::cache_eviction_extension::NAME); it != new_raw._extensions.end()) {
+        new_raw._cache_eviction_weight =
+            dynamic_pointer_cast<db::cache_eviction_extension>(it->second)->get_weight();
+    }
+
     if (static_props.use_null_sharder) {
         new_raw._sharder = get_sharder(1, 0);
     }
@@ -1448,6 +1498,15 @@ const ::tombstone_gc_options& schema::tombstone_gc_options() const {
     return default_tombstone_gc_options;
 }
 
+utils::filter_layout schema::bloom_filter_layout() const {
+    const auto& schema_extensions = _raw._extensions;
+
+    if (auto it = schema_extensions.find(db::bloom_filter_extension::NAME); it != schema_extensions.end()) {
+        return dynamic_pointer_cast<db::bloom_filter_extension>(it->second)->get_layout();
+    }
+    return utils::filter_layout::classic;
+}
+
 schema_builder& schema_builder::with_cdc_options(const cdc::options& opts) {
     add_extension(cdc::cdc_extension::NAME, ::make_shared<cdc::cdc_extension>(opts));
     return *this;
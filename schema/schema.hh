@@ -30,6 +30,7 @@
 #include "timestamp.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "utils/i_filter.hh"
 #include "schema_fwd.hh"
 #include "data_dictionary/keyspace_element.hh"
 
@@ -473,16 +474,27 @@ class view_info;
 // whereas in v3 those columns are static and there is a clustering column with type matching the
 // cell name comparator and a regular column with type matching the default validator.
 // See issues #2555 and #1474.
+//
+// For most tables the v3 layout is the same as the one of the schema, in which case the columns
+// of the schema are referred to instead of being copied.
 class v3_columns {
     bool _is_dense = false;
     bool _is_compound = false;
-    std::vector<column_definition> _columns;
-    std::unordered_map<bytes, const column_definition*> _columns_by_name;
+    // Empty when the columns are shared with the schema.
+    std::vector<column_definition> _owned_columns;
+    std::unordered_map<bytes, const column_definition*> _owned_columns_by_name;
+    const std::vector<column_definition>* _columns = &_owned_columns;
+    const std::unordered_map<bytes, const column_definition*>* _columns_by_name = &_owned_columns_by_name;
+private:
+    bool owns_columns() const noexcept { return _columns == &_owned_columns; }
 public:
     v3_columns(std::vector<column_definition> columns, bool is_dense, bool is_compound);
+    // Refers to the columns of a schema, which must outlive this object.
+    v3_columns(const std::vector<column_definition>& columns, const std::unordered_map<bytes, const column_definition*>& columns_by_name,
+            bool is_dense, bool is_compound) noexcept;
     v3_columns() = default;
-    v3_columns(v3_columns&&) = default;
-    v3_columns& operator=(v3_columns&&) = default;
+    v3_columns(v3_columns&&) noexcept;
+    v3_columns& operator=(v3_columns&&) noexcept;
     v3_columns(const v3_columns&) = delete;
     static v3_columns from_v2_schema(const schema&);
 public:
@@ -579,6 +591,7 @@ class schema final : public enable_lw_shared_from_this<schema>, public data_dict
         std::optional<int32_t> _paxos_grace_seconds;
         double _crc_check_chance = 1;
         db::per_partition_rate_limit_options _per_partition_rate_limit_options;
+        uint32_t _cache_eviction_weight = 1;
         int32_t _min_compaction_threshold = DEFAULT_MIN_COMPACTION_THRESHOLD;
         int32_t _max_compaction_threshold = DEFAULT_MAX_COMPACTION_THRESHOLD;
         int32_t _min_index_interval = DEFAULT_MIN_INDEX_INTERVAL;
@@ -756,11 +769,18 @@ class schema final : public enable_lw_shared_from_this<schema>, public data_dict
     const cdc::options& cdc_options() const;
 
     const ::tombstone_gc_options& tombstone_gc_options() const;
+    // Layout of the bloom filters of newly written sstables.
+    utils::filter_layout bloom_filter_layout() const;
 
     const db::per_partition_rate_limit_options& per_partition_rate_limit_options() const {
         return _raw._per_partition_rate_limit_options;
     }
 
+    // See db::cache_eviction_extension.
+    uint32_t cache_eviction_weight() const {
+        return _raw._cache_eviction_weight;
+    }
+
     const ::speculative_retry& speculative_retry() const {
         return _raw._speculative_retry;
     }
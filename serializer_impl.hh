@@ -509,7 +509,9 @@ class deserialized_bytes_proxy {
 
     [[gnu::always_inline]]
     operator bytes_ostream() && {
-        bytes_ostream v;
+        // The size is known up front, so allocate the copy in as few chunks as possible
+        // instead of growing it from the default chunk size.
+        bytes_ostream v(bytes_ostream::initial_chunk_size_for(_stream.size()));
         _stream.copy_to(v);
         return v;
     }
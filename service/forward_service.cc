@@ -46,6 +46,8 @@
 #include "cql3/functions/functions.hh"
 #include "cql3/functions/aggregate_fcts.hh"
 #include "cql3/expr/expr-utils.hh"
+#include "cql3/restrictions/statement_restrictions.hh"
+#include "cql3/util.hh"
 
 namespace service {
 
@@ -428,6 +430,17 @@ future<query::forward_result> forward_service::execute_on_this_shard(
     auto now = gc_clock::now();
 
     auto selection = mock_selection(req, schema, _db.local());
+    ::shared_ptr<const cql3::restrictions::statement_restrictions> filtering_restrictions;
+    if (req.where_clause) {
+        auto db = _db.local().as_data_dictionary();
+        filtering_restrictions = cql3::util::prepare_where_clause(db, *schema, *req.where_clause);
+        // Same as the coordinator's selection, so the columns are in the order of the slice.
+        for (auto&& cdef : filtering_restrictions->get_column_defs_for_filtering(db)) {
+            if (!selection->has_column(*cdef)) {
+                selection->add_column_for_post_processing(*cdef);
+            }
+        }
+    }
     auto query_state = make_lw_shared<service::query_state>(
         client_state::for_internal_calls(),
         tr_state,
@@ -475,7 +488,7 @@ future<query::forward_result> forward_service::execute_on_this_shard(
             *query_options,
             make_lw_shared<query::read_command>(req.cmd),
             std::move(ranges_owned_by_this_shard),
-            nullptr // No filtering restrictions
+            filtering_restrictions
         );
 
         // Execute query.
@@ -274,51 +274,62 @@ future<> group0_state_machine::transfer_snapshot(raft::server_id from_id, raft::
         on_internal_error(slogger, "Expected MIGRATION_REQUEST to return canonical mutations");
     }
 
-    std::optional<service::raft_snapshot> topology_snp;
-    std::optional<service::raft_snapshot> raft_snp;
-
-    if (_topology_change_enabled) {
-        auto auth_tables = db::system_keyspace::auth_tables();
-        std::vector<table_id> tables;
-        tables.reserve(3);
-        tables.push_back(db::system_keyspace::topology()->id());
-        tables.push_back(db::system_keyspace::topology_requests()->id());
-        tables.push_back(db::system_keyspace::cdc_generations_v3()->id());
-
-        topology_snp = co_await ser::storage_service_rpc_verbs::send_raft_pull_snapshot(
-            &_mm._messaging, addr, as, from_id, service::raft_snapshot_pull_params{std::move(tables)});
-
-        tables = std::vector<table_id>();
-        tables.reserve(auth_tables.size());
-
-        for (const auto& schema : auth_tables) {
-            tables.push_back(schema->id());
-        }
-        tables.push_back(db::system_keyspace::service_levels_v2()->id());
-
-        raft_snp = co_await ser::storage_service_rpc_verbs::send_raft_pull_snapshot(
-            &_mm._messaging, addr, as, from_id, service::raft_snapshot_pull_params{std::move(tables)});
-    }
-
     auto history_mut = extract_history_mutation(*cm, _sp.data_dictionary());
 
     // TODO ensure atomicity of snapshot application in presence of crashes (see TODO in `apply`)
 
-    auto read_apply_mutex_holder = co_await _client.hold_read_apply_mutex(as);
+    // The read-apply mutex is only held while a part is applied, not while the
+    // next one is pulled from the remote node, so that group0 reads and
+    // applies aren't blocked for the duration of the remote calls.
+    auto apply_locked = [&] (auto apply) -> future<> {
+        auto read_apply_mutex_holder = co_await _client.hold_read_apply_mutex(as);
+        co_await apply();
+    };
 
-    co_await _mm.merge_schema_from(addr, std::move(*cm));
+    co_await apply_locked([&] {
+        return _mm.merge_schema_from(addr, std::move(*cm));
+    });
 
-    if (topology_snp && !topology_snp->mutations.empty()) {
-        co_await _ss.merge_topology_snapshot(std::move(*topology_snp));
-        // Flush so that current supported and enabled features are readable before commitlog replay
-        co_await _sp.get_db().local().flush(db::system_keyspace::NAME, db::system_keyspace::TOPOLOGY);
-    }
+    if (_topology_change_enabled) {
+        // The rest of the state is pulled in parts, each applied before the next one is pulled,
+        // so that only one part is held in memory at a time. Parts are only as big as required
+        // for atomicity of the state they carry.
+        auto pull = [&] (std::vector<table_id> tables) {
+            return ser::storage_service_rpc_verbs::send_raft_pull_snapshot(
+                &_mm._messaging, addr, as, from_id, service::raft_snapshot_pull_params{std::move(tables)});
+        };
+
+        // CDC generations can be big. They are applied non-atomically anyway, and before
+        // the topology which refers to them.
+        auto cdc_generations_snp = co_await pull({db::system_keyspace::cdc_generations_v3()->id()});
+        co_await apply_locked([&] {
+            return _ss.merge_topology_snapshot(std::move(cdc_generations_snp));
+        });
+
+        auto topology_snp = co_await pull({db::system_keyspace::topology()->id(), db::system_keyspace::topology_requests()->id()});
+        if (!topology_snp.mutations.empty()) {
+            co_await apply_locked([&] () -> future<> {
+                co_await _ss.merge_topology_snapshot(std::move(topology_snp));
+                // Flush so that current supported and enabled features are readable before commitlog replay
+                co_await _sp.get_db().local().flush(db::system_keyspace::NAME, db::system_keyspace::TOPOLOGY);
+            });
+        }
 
-    if (raft_snp) {
-        co_await mutate_locally(std::move(raft_snp->mutations), _sp);
+        auto tables = db::system_keyspace::auth_tables();
+        tables.push_back(db::system_keyspace::service_levels_v2());
+        for (const auto& schema : tables) {
+            auto raft_snp = co_await pull({schema->id()});
+            co_await apply_locked([&] {
+                return mutate_locally(std::move(raft_snp.mutations), _sp);
+            });
+        }
     }
 
-    co_await _sp.mutate_locally({std::move(history_mut)}, nullptr);
+    // The history is applied last, so that the state id of the snapshot is only
+    // observed once all of its state is.
+    co_await apply_locked([&] {
+        return _sp.mutate_locally({std::move(history_mut)}, nullptr);
+    });
   } catch (const abort_requested_exception&) {
     throw raft::request_aborted();
   }
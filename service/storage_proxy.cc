@@ -33,6 +33,7 @@
 #include "exceptions/exceptions.hh"
 #include <boost/range/algorithm_ext/push_back.hpp>
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/range/irange.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/cxx11/none_of.hpp>
@@ -66,6 +67,7 @@
 #include "cdc/log.hh"
 #include "cdc/stats.hh"
 #include "cdc/cdc_options.hh"
+#include "direct_failure_detector/failure_detector.hh"
 #include "utils/histogram_metrics_helper.hh"
 #include "service/paxos/prepare_summary.hh"
 #include "service/migration_manager.hh"
@@ -73,6 +75,7 @@
 #include "service/paxos/proposal.hh"
 #include "locator/token_metadata.hh"
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/condition-variable.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
 #include <seastar/coroutine/all.hh>
@@ -199,25 +202,205 @@ namespace service {
 // The presence of this object indicates that `storage_proxy` is able to perform remote queries.
 // Without it only local queries are available.
 class storage_proxy::remote {
+    using repair_diffs = std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>>;
+
+    // Writes the repairs of reads which don't wait for them (read_repair_in_background).
+    //
+    // Queued repairs of a partition are merged, so a partition read repeatedly
+    // before its repair is written is repaired once. The repairs are written one
+    // table at a time, in batches of up to max_partitions_per_batch partitions,
+    // one batch at a time, which bounds the load they put on the replicas.
+    // Repairs which don't fit in the queue, whose size is bounded in bytes, are
+    // dropped, the partitions are left to later reads or to repair.
+    class background_read_repair_writer {
+        static constexpr size_t max_partitions_per_batch = 128;
+
+        using endpoint_diffs = std::unordered_map<gms::inet_address, std::optional<mutation>>;
+
+        struct partition_repair {
+            endpoint_diffs diffs;
+            size_t memory_usage = 0;
+        };
+
+        struct table_repairs {
+            locator::effective_replication_map_ptr ermp;
+            db::consistency_level cl;
+            std::map<dht::decorated_key, partition_repair, dht::decorated_key::less_comparator> partitions;
+
+            explicit table_repairs(schema_ptr s) : partitions(dht::decorated_key::less_comparator(std::move(s))) {}
+        };
+
+        storage_proxy& _sp;
+        std::unordered_map<table_id, table_repairs> _pending;
+        size_t _pending_bytes = 0;
+        condition_variable _cv;
+        bool _stopped = false;
+        future<> _writer;
+
+        static size_t memory_usage(const endpoint_diffs& diffs) {
+            size_t size = 0;
+            for (const auto& [ep, mdiff] : diffs) {
+                if (mdiff) {
+                    size += mdiff->memory_usage(*mdiff->schema());
+                }
+            }
+            return size;
+        }
+
+        // Takes up to max_partitions_per_batch partitions of the table out of the queue.
+        // Partitions whose token is already in the batch are left for the next one,
+        // since the repair write path identifies partitions by their token.
+        repair_diffs next_batch(table_repairs& t) {
+            repair_diffs batch;
+            for (auto it = t.partitions.begin(); it != t.partitions.end() && batch.size() < max_partitions_per_batch;) {
+                if (batch.contains(it->first.token())) {
+                    ++it;
+                    continue;
+                }
+                _pending_bytes -= it->second.memory_usage;
+                batch.emplace(it->first.token(), std::move(it->second.diffs));
+                it = t.partitions.erase(it);
+            }
+            return batch;
+        }
+
+        future<> run() {
+            while (!_stopped) {
+                if (_pending.empty()) {
+                    try {
+                        co_await _cv.wait();
+                    } catch (const broken_condition_variable&) {
+                        // stopped
+                    }
+                    continue;
+                }
+                auto it = _pending.begin();
+                auto ermp = it->second.ermp;
+                auto cl = it->second.cl;
+                auto batch = next_batch(it->second);
+                if (it->second.partitions.empty()) {
+                    _pending.erase(it);
+                }
+                auto f = co_await coroutine::as_future(_sp.schedule_repair(std::move(ermp), std::move(batch), cl,
+                        nullptr, empty_service_permit()));
+                if (f.failed()) {
+                    slogger.debug("Background read repair failed: {}", f.get_exception());
+                } else if (auto r = f.get(); !r) {
+                    slogger.debug("Background read repair failed: {}", r.error().get_exception());
+                }
+            }
+        }
+    public:
+        explicit background_read_repair_writer(storage_proxy& sp)
+            : _sp(sp)
+            , _writer(run())
+        { }
+
+        bool queue(schema_ptr s, locator::effective_replication_map_ptr ermp, repair_diffs& diffs, db::consistency_level cl) {
+            if (_stopped) {
+                return false;
+            }
+            const size_t max_bytes = size_t(_sp._db.local().get_config().read_repair_in_background_queue_size_in_kb()) * 1024;
+            auto& stats = _sp.get_stats();
+            auto& t = _pending.try_emplace(s->id(), s).first->second;
+            // Written with the topology of the latest read
+            t.ermp = std::move(ermp);
+            t.cl = cl;
+            for (auto& [token, partition_diffs] : diffs) {
+                auto m = std::ranges::find_if(partition_diffs, [] (const auto& d) { return bool(d.second); });
+                if (m == partition_diffs.end()) {
+                    continue;
+                }
+                auto dk = m->second->decorated_key();
+                auto it = t.partitions.find(dk);
+                if (it == t.partitions.end()) {
+                    auto size = memory_usage(partition_diffs);
+                    if (_pending_bytes + size > max_bytes) {
+                        ++stats.read_repair_dropped_partitions;
+                        continue;
+                    }
+                    t.partitions.emplace(std::move(dk), partition_repair{std::move(partition_diffs), size});
+                    _pending_bytes += size;
+                    ++stats.read_repair_queued_partitions;
+                    continue;
+                }
+                ++stats.read_repair_merged_partitions;
+                auto& p = it->second;
+                for (auto& [ep, mdiff] : partition_diffs) {
+                    if (auto [i, added] = p.diffs.try_emplace(ep, std::move(mdiff)); !added && mdiff) {
+                        if (i->second) {
+                            i->second->apply(std::move(*mdiff));
+                        } else {
+                            i->second = std::move(mdiff);
+                        }
+                    }
+                }
+                auto size = memory_usage(p.diffs);
+                _pending_bytes = _pending_bytes - p.memory_usage + size;
+                p.memory_usage = size;
+            }
+            if (t.partitions.empty()) {
+                _pending.erase(s->id());
+            } else {
+                _cv.signal();
+            }
+            return true;
+        }
+
+        future<> stop() {
+            _stopped = true;
+            _cv.broken();
+            co_await std::move(_writer);
+            _pending.clear();
+            _pending_bytes = 0;
+        }
+    };
+
     storage_proxy& _sp;
     netw::messaging_service& _ms;
     const gms::gossiper& _gossiper;
     migration_manager& _mm;
     sharded<db::system_keyspace>& _sys_ks;
+    const direct_failure_detector::failure_detector& _direct_fd;
 
     netw::connection_drop_slot_t _connection_dropped;
     netw::connection_drop_registration_t _condrop_registration;
 
+    struct pending_mutation {
+        const frozen_mutation* m;
+        storage_proxy::response_id_type response_id;
+        db::per_partition_rate_limit::info rate_limit_info;
+        promise<> sent;
+    };
+
+    // Mutations which go to the same replica and share the parameters of the mutation_batch verb
+    struct mutation_batch {
+        netw::msg_addr addr;
+        storage_proxy::clock_type::time_point timeout;
+        gms::inet_address reply_to;
+        unsigned shard;
+        fencing_token fence;
+        std::vector<pending_mutation> mutations;
+    };
+
+    // Set while batch_mutations() runs its function
+    std::vector<mutation_batch>* _mutation_batches = nullptr;
+
+    background_read_repair_writer _background_read_repairs;
+
     bool _stopped{false};
 
 public:
-    remote(storage_proxy& sp, netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, sharded<db::system_keyspace>& sys_ks)
-        : _sp(sp), _ms(ms), _gossiper(g), _mm(mm), _sys_ks(sys_ks)
+    remote(storage_proxy& sp, netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, sharded<db::system_keyspace>& sys_ks,
+            const direct_failure_detector::failure_detector& direct_fd)
+        : _sp(sp), _ms(ms), _gossiper(g), _mm(mm), _sys_ks(sys_ks), _direct_fd(direct_fd)
         , _connection_dropped(std::bind_front(&remote::connection_dropped, this))
         , _condrop_registration(_ms.when_connection_drops(_connection_dropped))
+        , _background_read_repairs(sp)
     {
         ser::storage_proxy_rpc_verbs::register_counter_mutation(&_ms, std::bind_front(&remote::handle_counter_mutation, this));
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, _sp._write_smp_service_group));
+        ser::storage_proxy_rpc_verbs::register_mutation_batch(&_ms, std::bind_front(&remote::receive_mutation_batch_handler, this));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, std::bind_front(&remote::receive_hint_mutation_handler, this));
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
@@ -238,10 +421,15 @@ class storage_proxy::remote {
 
     // Must call before destroying the `remote` object.
     future<> stop() {
+        co_await _background_read_repairs.stop();
         co_await ser::storage_proxy_rpc_verbs::unregister(&_ms);
         _stopped = true;
     }
 
+    bool queue_background_repair(schema_ptr s, locator::effective_replication_map_ptr ermp, repair_diffs& diffs, db::consistency_level cl) {
+        return _background_read_repairs.queue(std::move(s), std::move(ermp), diffs, cl);
+    }
+
     const gms::gossiper& gossiper() const {
         return _gossiper;
     }
@@ -250,6 +438,11 @@ class storage_proxy::remote {
         return _gossiper.is_alive(ep);
     }
 
+    // Suspicion level (phi) of the node according to the direct failure detector.
+    float suspicion(locator::host_id id) const {
+        return _direct_fd.suspicion(id.uuid());
+    }
+
     db::system_keyspace& system_keyspace() {
         return _sys_ks.local();
     }
@@ -266,12 +459,94 @@ class storage_proxy::remote {
             const frozen_mutation& m, const inet_address_vector_replica_set& forward, gms::inet_address reply_to, unsigned shard,
             storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
+        if (_mutation_batches && forward.empty() && !trace_info) {
+            return add_to_mutation_batch(std::move(addr), timeout, m, reply_to, shard, response_id, rate_limit_info, fence);
+        }
         return ser::storage_proxy_rpc_verbs::send_mutation(
                 &_ms, std::move(addr), timeout,
                 m, forward, std::move(reply_to), shard,
                 response_id, trace_info, rate_limit_info, fence);
     }
 
+    // Mutations which func() passes to send_mutation() are sent after func() returns,
+    // those going to the same replica in a single mutation_batch message.
+    // func() must call send_mutation() before deferring, and the mutations must stay
+    // alive until the futures returned by send_mutation() resolve, as usual.
+    // Forwarded and traced mutations are sent right away.
+    template <std::invocable Func>
+    futurize_t<std::invoke_result_t<Func>> batch_mutations(Func&& func) {
+        if (_mutation_batches || !_sp.features().mutation_batch || !_sp._db.local().get_config().batch_mutations_per_replica()) {
+            return futurize_invoke(func);
+        }
+        std::vector<mutation_batch> batches;
+        _mutation_batches = &batches;
+        auto f = futurize_invoke(func);
+        _mutation_batches = nullptr;
+        send_mutation_batches(std::move(batches));
+        return f;
+    }
+
+private:
+    future<> add_to_mutation_batch(netw::msg_addr addr, storage_proxy::clock_type::time_point timeout,
+            const frozen_mutation& m, gms::inet_address reply_to, unsigned shard,
+            storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
+            fencing_token fence) {
+        auto it = std::ranges::find_if(*_mutation_batches, [&] (const mutation_batch& b) {
+            return b.addr == addr && b.timeout == timeout && b.reply_to == reply_to && b.shard == shard
+                    && b.fence.topology_version == fence.topology_version;
+        });
+        if (it == _mutation_batches->end()) {
+            it = _mutation_batches->insert(it, mutation_batch{std::move(addr), timeout, reply_to, shard, fence, {}});
+        }
+        auto& pm = it->mutations.emplace_back(pending_mutation{&m, response_id, rate_limit_info, promise<>()});
+        return pm.sent.get_future();
+    }
+
+    void send_mutation_batches(std::vector<mutation_batch> batches) noexcept {
+        for (auto& b : batches) {
+            if (b.mutations.size() == 1) {
+                auto& pm = b.mutations.front();
+                futurize_invoke([&] {
+                    return send_mutation(std::move(b.addr), b.timeout, std::nullopt, *pm.m, {}, b.reply_to, b.shard,
+                            pm.response_id, pm.rate_limit_info, b.fence);
+                }).forward_to(std::move(pm.sent));
+                continue;
+            }
+            auto f = futurize_invoke([&] {
+                std::vector<frozen_mutation> fms;
+                std::vector<storage_proxy::response_id_type> response_ids;
+                std::vector<db::per_partition_rate_limit::info> rate_limit_infos;
+                fms.reserve(b.mutations.size());
+                response_ids.reserve(b.mutations.size());
+                rate_limit_infos.reserve(b.mutations.size());
+                for (auto& pm : b.mutations) {
+                    fms.push_back(*pm.m);
+                    response_ids.push_back(pm.response_id);
+                    rate_limit_infos.push_back(pm.rate_limit_info);
+                }
+                ++_sp.get_stats().sent_mutation_batches;
+                _sp.get_stats().mutations_in_sent_batches += b.mutations.size();
+                return ser::storage_proxy_rpc_verbs::send_mutation_batch(&_ms, std::move(b.addr), b.timeout,
+                        fms, b.reply_to, b.shard, response_ids, rate_limit_infos, b.fence);
+            });
+            // Waited on through the futures returned by send_mutation()
+            (void)f.then_wrapped([mutations = std::move(b.mutations)] (future<> f) mutable {
+                if (f.failed()) {
+                    auto ex = f.get_exception();
+                    for (auto& pm : mutations) {
+                        pm.sent.set_exception(ex);
+                    }
+                } else {
+                    for (auto& pm : mutations) {
+                        pm.sent.set_value();
+                    }
+                }
+            });
+        }
+    }
+
+public:
+
     future<> send_hint_mutation(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             const frozen_mutation& m, const inet_address_vector_replica_set& forward, gms::inet_address reply_to, unsigned shard,
@@ -621,6 +896,96 @@ class storage_proxy::remote {
                 });
     }
 
+    // The mutations are applied concurrently, so that the commitlog writes and syncs
+    // them together, and each is answered with mutation_done or mutation_failed.
+    // Each shard is handed the mutations it owns at once, instead of mutate_locally()
+    // hopping to it for each of them.
+    future<rpc::no_wait_type> receive_mutation_batch_handler(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            std::vector<frozen_mutation> fms, gms::inet_address reply_to, unsigned shard,
+            std::vector<storage_proxy::response_id_type> response_ids,
+            std::vector<db::per_partition_rate_limit::info> rate_limit_infos,
+            fencing_token fence) {
+        if (response_ids.size() != fms.size() || rate_limit_infos.size() != fms.size()) {
+            on_internal_error(slogger, format("mutation_batch from {}#{}: {} mutations, {} response ids, {} rate limit infos",
+                    reply_to, shard, fms.size(), response_ids.size(), rate_limit_infos.size()));
+        }
+        ++_sp.get_stats().received_mutation_batches;
+        auto src_addr = netw::messaging_service::get_source(cinfo);
+        auto timeout = t ? *t : clock_type::now() + std::chrono::milliseconds(_sp._db.local().get_config().write_request_timeout_in_ms());
+
+        std::vector<std::vector<size_t>> by_shard(smp::count);
+        // Set for the mutations which are being answered by apply_mutation_batch().
+        // Not a vector<bool>, since the shards set their flags concurrently.
+        std::vector<char> handled(fms.size(), false);
+        co_await coroutine::parallel_for_each(boost::irange(size_t(0), fms.size()), [&] (size_t i) -> future<> {
+            auto owner = this_shard_id();
+            try {
+                // Note: get_schema_for_write() rarely blocks, the schema is looked up again when applying
+                schema_ptr s = co_await get_schema_for_write(fms[i].schema_version(), netw::messaging_service::msg_addr{reply_to, shard}, timeout);
+                auto shards = _sp._db.local().find_column_family(s).shard_for_writes(fms[i].token(*s));
+                if (shards.size() == 1) {
+                    owner = shards[0];
+                }
+            } catch (...) {
+                // Applied on this shard, so that the error is reported by the regular write path
+            }
+            by_shard[owner].push_back(i);
+        });
+
+        co_await coroutine::parallel_for_each(boost::irange(0u, smp::count), [&] (unsigned owner) -> future<> {
+            auto& indexes = by_shard[owner];
+            if (indexes.empty()) {
+                co_return;
+            }
+            if (owner != this_shard_id()) {
+                _sp.get_stats().replica_cross_shard_ops += 1;
+                auto f = co_await coroutine::as_future(_sp.container().invoke_on(owner, {_sp._write_smp_service_group, timeout},
+                        [&] (storage_proxy& sp) {
+                    return sp.remote().apply_mutation_batch(src_addr, t, fms, indexes, reply_to, shard, response_ids, rate_limit_infos, fence, handled);
+                }));
+                if (!f.failed()) {
+                    co_return;
+                }
+                f.ignore_ready_future();
+                // Let mutate_locally() fail the mutations which weren't answered yet the usual way.
+                // Those which were are already applied, or failed, and mustn't be applied again.
+                std::erase_if(indexes, [&] (size_t i) { return handled[i]; });
+            }
+            co_await apply_mutation_batch(src_addr, t, fms, indexes, reply_to, shard, response_ids, rate_limit_infos, fence, handled);
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
+    // Applies the mutations of a mutation_batch message with the given indexes.
+    // Runs on the shard which owns them. Sets handled[i] once the i-th mutation
+    // is certain to be answered with mutation_done or mutation_failed.
+    future<> apply_mutation_batch(netw::msg_addr src_addr, rpc::opt_time_point t,
+            const std::vector<frozen_mutation>& fms, const std::vector<size_t>& indexes,
+            gms::inet_address reply_to, unsigned shard,
+            const std::vector<storage_proxy::response_id_type>& response_ids,
+            const std::vector<db::per_partition_rate_limit::info>& rate_limit_infos,
+            fencing_token fence, std::vector<char>& handled) {
+        const inet_address_vector_replica_set forward;
+        const std::optional<tracing::trace_info> trace_info;
+        co_await coroutine::parallel_for_each(indexes, [&] (size_t i) {
+            auto f = handle_write(src_addr, t, fms[i].schema_version(), std::cref(fms[i]), forward, reply_to, shard, response_ids[i],
+                    trace_info, fence,
+                    /* apply_fn */ [smp_grp = _sp._write_smp_service_group, rate_limit_info = rate_limit_infos[i], src_ip = src_addr.addr] (shared_ptr<storage_proxy>& p,
+                            tracing::trace_state_ptr tr_state, schema_ptr s, const frozen_mutation& m, clock_type::time_point timeout, fencing_token fence) {
+                        return p->apply_fence(p->mutate_locally(std::move(s), m, std::move(tr_state), db::commitlog::force_sync::no, timeout, smp_grp, rate_limit_info), fence, src_ip);
+                    },
+                    /* forward_fn */ [] (shared_ptr<storage_proxy>&, netw::messaging_service::msg_addr, clock_type::time_point, const frozen_mutation&,
+                            gms::inet_address, unsigned, response_id_type, const std::optional<tracing::trace_info>&, fencing_token) {
+                        // Batched mutations are never forwarded
+                        return make_ready_future<>();
+                    }).discard_result();
+            // Once handle_write() is started, it answers the mutation even if it fails
+            handled[i] = true;
+            return f;
+        });
+    }
+
     future<rpc::no_wait_type> receive_hint_mutation_handler(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             frozen_mutation in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
@@ -688,6 +1053,9 @@ class storage_proxy::remote {
                     } else if constexpr (std::is_same_v<Ex, replica::abort_requested_exception>) {
                         msg = e.what();
                         return error::FAILURE;
+                    } else if constexpr (std::is_same_v<Ex, replica::overloaded_exception>) {
+                        msg = e.what();
+                        return error::FAILURE;
                     }
                 }, exception->reason);
             }
@@ -1545,10 +1913,21 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
                     return std::max(lhs, rhs);
                 });
     }
+    // Only writes which generate view updates, and the view updates
+    // themselves, add to the view update backlog. Writes to other tables
+    // aren't slowed down by it, so slow views don't delay unrelated writes.
+    bool throttled_by_view_backlog() const {
+        auto& s = get_schema();
+        if (s->is_view()) {
+            return true;
+        }
+        auto& db = _proxy->get_db().local();
+        return !db.column_family_exists(s->id()) || !db.find_column_family(s->id()).views().empty();
+    }
     // Calculates how much to delay completing the request. The delay adds to the request's inherent latency.
     template<typename Func>
     void delay(tracing::trace_state_ptr trace, Func&& on_resume) {
-        auto backlog = max_backlog();
+        auto backlog = throttled_by_view_backlog() ? max_backlog() : db::view::update_backlog::no_backlog();
         auto delay = db::view::calculate_view_update_throttling_delay(backlog, _expire_timer.get_timeout());
         stats().last_mv_flow_control_delay = delay;
         stats().mv_flow_control_delay += delay.count();
@@ -2538,6 +2917,19 @@ void storage_proxy_stats::write_stats::register_stats() {
             sm::make_histogram("write_latency", sm::description("The general write latency histogram"),
                     {storage_proxy_stats::current_scheduling_group_label()},
                     [this]{return to_metrics_histogram(write.histogram());}).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+            sm::make_summary("unlogged_batch_write_latency_summary", sm::description("Latency summary of writes of several mutations, such as unlogged batches"),
+                    [this] {return to_metrics_summary(unlogged_batch_write.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
+            sm::make_histogram("unlogged_batch_write_latency", sm::description("Latency histogram of writes of several mutations, such as unlogged batches"),
+                    {storage_proxy_stats::current_scheduling_group_label()},
+                    [this]{return to_metrics_histogram(unlogged_batch_write.histogram());}).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+
+            sm::make_total_operations("sent_mutation_batches", sent_mutation_batches,
+                           sm::description("number of messages with several mutations sent to replicas"),
+                           {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+            sm::make_total_operations("mutations_in_sent_batches", mutations_in_sent_batches,
+                           sm::description("number of mutations sent to replicas in messages with several mutations"),
+                           {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
             sm::make_queue_length("foreground_writes", [this] { return writes - background_writes; },
                            sm::description("number of currently pending foreground write requests"),
@@ -2662,6 +3054,18 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of background read repairs"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("queued_read_repair_partitions", read_repair_queued_partitions,
+                       sm::description("number of partitions whose read repair was queued to be written in the background"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("merged_read_repair_partitions", read_repair_merged_partitions,
+                       sm::description("number of partition read repairs merged with a repair of the same partition waiting in the background queue"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("dropped_read_repair_partitions", read_repair_dropped_partitions,
+                       sm::description("number of partition read repairs dropped because the background queue was full"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("read_timeouts", [this]{return read_timeouts.count(); },
                        sm::description("number of read request failed due to a timeout"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2694,6 +3098,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of speculative data read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("speculative_reads_over_budget", speculative_reads_over_budget,
+                       sm::description("number of speculative read requests that were not sent because the speculative retry budget was exhausted"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_summary("cas_read_latency_summary", sm::description("CAS read latency summary"), [this] {return to_metrics_summary(cas_read.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
         sm::make_summary("cas_write_latency_summary", sm::description("CAS write latency summary"), [this] {return to_metrics_summary(cas_write.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
 
@@ -2780,6 +3188,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of mutations received by a replica Node"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("received_mutation_batches", received_mutation_batches,
+                       sm::description("number of messages with several mutations received by a replica Node"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("forwarded_mutations", forwarded_mutations,
                        sm::description("number of mutations forwarded to other replica Nodes"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -3006,25 +3418,11 @@ future<> apply_on_shards(const locator::effective_replication_map_ptr& erm, cons
 
 future<>
 storage_proxy::mutate_locally(const mutation& m, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync, clock_type::time_point timeout, smp_service_group smp_grp, db::per_partition_rate_limit::info rate_limit_info) {
-    auto erm = _db.local().find_column_family(m.schema()).get_effective_replication_map();
-    auto apply = [this, erm, &m, tr_state, sync, timeout, smp_grp, rate_limit_info] (shard_id shard) {
-        get_stats().replica_cross_shard_ops += shard != this_shard_id();
-        auto shard_rate_limit = rate_limit_info;
-        if (shard == this_shard_id()) {
-            shard_rate_limit = adjust_rate_limit_for_local_operation(shard_rate_limit);
-        }
-        return _db.invoke_on(shard, {smp_grp, timeout},
-                [s = global_schema_ptr(m.schema()),
-                 m = freeze(m),
-                 gtr = tracing::global_trace_state_ptr(std::move(tr_state)),
-                 erm,
-                 timeout,
-                 sync,
-                 shard_rate_limit] (replica::database& db) mutable -> future<> {
-            return db.apply(s, m, gtr.get(), sync, timeout, shard_rate_limit);
-        });
-    };
-    return apply_on_shards(erm, *m.schema(), m.token(), std::move(apply));
+    // Freeze once, here. The shards owning the token, usually one but two
+    // during intra-node tablet migration, read the frozen mutation in place
+    // and append it to the commitlog as is.
+    auto fm = freeze(m);
+    co_await mutate_locally(m.schema(), fm, std::move(tr_state), sync, timeout, smp_grp, rate_limit_info);
 }
 
 future<>
@@ -3343,37 +3741,44 @@ future<result<storage_proxy::unique_response_handler_vector>> storage_proxy::mut
 
 future<result<>> storage_proxy::mutate_begin(unique_response_handler_vector ids, db::consistency_level cl,
                                      tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt) {
-    return utils::result_parallel_for_each<result<>>(ids, [this, cl, timeout_opt] (unique_response_handler& protected_response) {
-        auto response_id = protected_response.id;
-        // This function, mutate_begin(), is called after a preemption point
-        // so it's possible that other code besides our caller just ran. In
-        // particular, Scylla may have noticed that a remote node went down,
-        // called storage_proxy::on_down(), and removed some of the ongoing
-        // handlers, including this id. If this happens, we need to ignore
-        // this id - not try to look it up or start a send.
-        if (!_response_handlers.contains(response_id)) {
-            protected_response.release(); // Don't try to remove this id again
-            // Requests that time-out normally below after response_wait()
-            // result in an exception (see ~abstract_write_response_handler())
-            // However, here we no longer have the handler or its information
-            // to put in the exception. The exception is not needed for
-            // correctness (e.g., hints are written by timeout_cb(), not
-            // because of an exception here).
-            slogger.debug("unstarted write cancelled for id {}", response_id);
-            return make_ready_future<result<>>(bo::success());
-        }
-        // it is better to send first and hint afterwards to reduce latency
-        // but request may complete before hint_to_dead_endpoints() is called and
-        // response_id handler will be removed, so we will have to do hint with separate
-        // frozen_mutation copy, or manage handler live time differently.
-        hint_to_dead_endpoints(response_id, cl);
-
-        auto timeout = timeout_opt.value_or(clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms()));
-        // call before send_to_live_endpoints() for the same reason as above
-        auto f = response_wait(response_id, timeout);
-        send_to_live_endpoints(protected_response.release(), timeout); // response is now running and it will either complete or timeout
-        return f;
-    });
+    // All mutations of the request share the timeout, so that those going to the same replica can be batched
+    auto timeout = timeout_opt.value_or(clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms()));
+    auto begin = [&] {
+        return utils::result_parallel_for_each<result<>>(ids, [this, cl, timeout] (unique_response_handler& protected_response) {
+            auto response_id = protected_response.id;
+            // This function, mutate_begin(), is called after a preemption point
+            // so it's possible that other code besides our caller just ran. In
+            // particular, Scylla may have noticed that a remote node went down,
+            // called storage_proxy::on_down(), and removed some of the ongoing
+            // handlers, including this id. If this happens, we need to ignore
+            // this id - not try to look it up or start a send.
+            if (!_response_handlers.contains(response_id)) {
+                protected_response.release(); // Don't try to remove this id again
+                // Requests that time-out normally below after response_wait()
+                // result in an exception (see ~abstract_write_response_handler())
+                // However, here we no longer have the handler or its information
+                // to put in the exception. The exception is not needed for
+                // correctness (e.g., hints are written by timeout_cb(), not
+                // because of an exception here).
+                slogger.debug("unstarted write cancelled for id {}", response_id);
+                return make_ready_future<result<>>(bo::success());
+            }
+            // it is better to send first and hint afterwards to reduce latency
+            // but request may complete before hint_to_dead_endpoints() is called and
+            // response_id handler will be removed, so we will have to do hint with separate
+            // frozen_mutation copy, or manage handler live time differently.
+            hint_to_dead_endpoints(response_id, cl);
+
+            // call before send_to_live_endpoints() for the same reason as above
+            auto f = response_wait(response_id, timeout);
+            send_to_live_endpoints(protected_response.release(), timeout); // response is now running and it will either complete or timeout
+            return f;
+        });
+    };
+    if (ids.size() < 2 || !_remote) {
+        return begin();
+    }
+    return _remote->batch_mutations(begin);
 }
 
 // this function should be called with a future that holds result of mutation attempt (usually
@@ -3667,7 +4072,10 @@ storage_proxy::mutate_internal(Range mutations, db::consistency_level cl, bool c
             tr_state] (storage_proxy::unique_response_handler_vector ids) mutable {
         register_cdc_operation_result_tracker(ids, tracker);
         return mutate_begin(std::move(ids), cl, tr_state, timeout_opt);
-    })).then_wrapped([this, p = shared_from_this(), lc, tr_state] (future<result<>> f) mutable {
+    })).then_wrapped([this, p = shared_from_this(), lc, tr_state, type] (future<result<>> f) mutable {
+        if (type == db::write_type::UNLOGGED_BATCH) {
+            get_stats().unlogged_batch_write.mark(lc.stop().latency());
+        }
         return p->mutate_end(std::move(f), lc, get_stats(), std::move(tr_state));
     });
 }
@@ -4196,6 +4604,11 @@ size_t storage_proxy::hint_to_dead_endpoints(std::unique_ptr<mutation_holder>& m
     }
 }
 
+bool storage_proxy::queue_background_repair(schema_ptr s, locator::effective_replication_map_ptr ermp,
+        std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>>& diffs, db::consistency_level cl) {
+    return _remote && _remote->queue_background_repair(std::move(s), std::move(ermp), diffs, cl);
+}
+
 future<result<>> storage_proxy::schedule_repair(locator::effective_replication_map_ptr ermp, std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state,
                                         service_permit permit) {
     if (diffs.empty()) {
@@ -4266,6 +4679,9 @@ class abstract_read_resolver {
             return; // also do not report timeout as replica failure for the same reason
         } else if (try_catch<abort_requested_exception>(eptr)) {
             // do not report aborts, they are triggered by shutdown or timeouts
+        } else if (try_catch<replica::overloaded_exception>(eptr)) {
+            // There might be a lot of those, so ignore
+            // replica's reads_shed_due_to_deadline counter was incremented.
         } else if (try_catch<gate_closed_exception>(eptr)) {
             // do not report gate_closed errors, they are triggered by shutdown (See #8995)
         } else if (auto ex = try_catch<rpc::remote_verb_error>(eptr)) {
@@ -5029,13 +5445,16 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void make_mutation_data_requests(lw_shared_ptr<query::read_command> cmd, data_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
+            _proxy->on_replica_read_sent(ep);
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_mutation_data_request(cmd, ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> f) {
+                _proxy->on_replica_read_done(ep, std::chrono::duration_cast<std::chrono::microseconds>(latency_clock::now() - start), f.failed());
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
                     auto v = f.get();
                     _cf->set_hit_rate(ep, std::get<1>(v));
+                    _cf->add_replica_read_latency(ep, latency_clock::now() - start);
                     resolver->add_mutate_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().mutation_data_read_completed.get_ep_stat(get_topology(), ep);
                     register_request_latency(latency_clock::now() - start);
@@ -5055,13 +5474,16 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void make_data_requests(digest_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout, bool want_digest) {
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
+            _proxy->on_replica_read_sent(ep);
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
+                _proxy->on_replica_read_done(ep, std::chrono::duration_cast<std::chrono::microseconds>(latency_clock::now() - start), f.failed());
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
                     auto v = f.get();
                     _cf->set_hit_rate(ep, std::get<1>(v));
+                    _cf->add_replica_read_latency(ep, latency_clock::now() - start);
                     resolver->add_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
@@ -5082,13 +5504,16 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void make_digest_requests(digest_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
+            _proxy->on_replica_read_sent(ep);
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> f) {
+                _proxy->on_replica_read_done(ep, std::chrono::duration_cast<std::chrono::microseconds>(latency_clock::now() - start), f.failed());
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
                     auto v = f.get();
                     _cf->set_hit_rate(ep, std::get<2>(v));
+                    _cf->add_replica_read_latency(ep, latency_clock::now() - start);
                     resolver->add_digest(ep, std::get<0>(v), std::get<1>(v), std::get<3>(std::move(v)));
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
@@ -5167,11 +5592,20 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     auto result = ::make_foreign(::make_lw_shared<query::result>(
                             co_await to_data_query_result(std::move(*rr_opt), _schema, _cmd->slice, _cmd->get_row_limit(), cmd->partition_limit)));
                     qlogger.trace("reconciled: {}", result->pretty_printer(_schema, _cmd->slice));
+                    auto diffs = data_resolver->get_diffs_for_repair();
+                    // Unless configured otherwise, which gives up monotonic quorum reads:
+                    if (_proxy->_db.local().get_config().read_repair_in_background()
+                            && _proxy->queue_background_repair(_schema, _effective_replication_map_ptr, diffs, _cl)) {
+                        tracing::trace(_trace_state, "Queued read repair to be written in the background");
+                        _result_promise.set_value(std::move(result));
+                        on_read_resolved();
+                        co_return;
+                    }
                     // wait for write to complete before returning result to prevent multiple concurrent read requests to
                     // trigger repair multiple times and to prevent quorum read to return an old value, even after a quorum
                     // another read had returned a newer value (but the newer value had not yet been sent to the other replicas)
                     // Waited on indirectly.
-                    (void)_proxy->schedule_repair(_effective_replication_map_ptr, data_resolver->get_diffs_for_repair(), _cl, _trace_state, _permit).then(utils::result_wrap([this, result = std::move(result)] () mutable {
+                    (void)_proxy->schedule_repair(_effective_replication_map_ptr, std::move(diffs), _cl, _trace_state, _permit).then(utils::result_wrap([this, result = std::move(result)] () mutable {
                         _result_promise.set_value(std::move(result));
                         return make_ready_future<::result<>>(bo::success());
                     })).then_wrapped([this, exec] (future<::result<>>&& f) {
@@ -5378,8 +5812,14 @@ class speculating_read_executor : public abstract_read_executor {
 public:
     using abstract_read_executor::abstract_read_executor;
     virtual void make_requests(digest_resolver_ptr resolver, storage_proxy::clock_type::time_point timeout) override {
+        _proxy->credit_speculative_retry_budget();
         _speculate_timer.set_callback([this, resolver, timeout] {
             if (!resolver->is_completed()) { // at the time the callback runs request may be completed already
+                if (!_proxy->consume_speculative_retry_budget()) {
+                    _proxy->get_stats().speculative_reads_over_budget++;
+                    tracing::trace(_trace_state, "Not sending a speculative read - speculative retry budget exhausted");
+                    return;
+                }
                 resolver->add_wait_targets(1); // we send one more request so wait for it too
                 // FIXME: consider disabling for CL=*ONE
                 auto send_request = [&] (bool has_data) {
@@ -5396,7 +5836,7 @@ class speculating_read_executor : public abstract_read_executor {
         });
         auto& sr = _schema->speculative_retry();
         auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
-            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
+            std::min(speculation_threshold(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
         _speculate_timer.arm(t);
 
@@ -5421,6 +5861,26 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void got_cl() override {
         _speculate_timer.cancel();
     }
+private:
+    // The time after which the read is late. That's when the slowest of the
+    // replicas we wait for didn't answer by its recent percentile latency,
+    // or, when there are too few recent reads from some of them to tell, by
+    // the percentile latency of the table.
+    std::chrono::milliseconds speculation_threshold(double percentile) {
+        if (_proxy->get_db().local().get_config().speculative_retry_per_replica()) {
+            std::chrono::milliseconds t{0};
+            bool known = true;
+            for (auto it = _targets.begin(); known && it != _targets.end() - 1; ++it) {
+                auto replica_t = _cf->get_replica_read_latency_percentile(*it, percentile);
+                known = bool(replica_t);
+                t = std::max(t, replica_t.value_or(t));
+            }
+            if (known) {
+                return t;
+            }
+        }
+        return _cf->get_coordinator_read_latency_percentile(percentile);
+    }
     virtual void adjust_targets_for_reconciliation() override {
         _targets = used_targets();
     }
@@ -5446,6 +5906,9 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
     // present, is always first in the list, as get_endpoints_for_reading()
     // orders the list by proximity to the local endpoint.
     is_read_non_local |= !all_replicas.empty() && all_replicas.front() != erm->get_topology().my_address();
+    if (_db.local().get_config().adaptive_replica_selection()) {
+        sort_endpoints_by_read_load(erm->get_topology(), all_replicas);
+    }
 
     auto cf = _db.local().find_column_family(schema).shared_from_this();
     inet_address_vector_replica_set target_replicas = filter_replicas_for_read(cl, *erm, all_replicas, preferred_endpoints, repair_decision,
@@ -5671,9 +6134,47 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
                 }
                 co_return std::move(result);
             };
+            // The partitions are read in the order of the ranges, at most
+            // max_concurrent_partition_reads_per_query at a time, and merged in that order.
+            // No more reads are started once the merged results are full, their results
+            // would be dropped anyway. This bounds the memory taken by queries with large
+            // IN lists, especially paged ones, whose page is often filled by the first few
+            // partitions.
             query::result_merger merger(cmd->get_row_limit(), cmd->partition_limit);
             merger.reserve(exec.size());
-            result = co_await utils::result_map_reduce(exec.begin(), exec.end(), std::move(mapper), std::move(merger));
+            const size_t concurrency = std::max<size_t>(1, _db.local().get_config().max_concurrent_partition_reads_per_query());
+            circular_buffer<future<::result<foreign_ptr<lw_shared_ptr<query::result>>>>> in_flight;
+            auto next = exec.begin();
+            std::exception_ptr ex;
+            bool failed = false;
+            while (next != exec.end() || !in_flight.empty()) {
+                while (!failed && !merger.full() && next != exec.end() && in_flight.size() < concurrency) {
+                    in_flight.push_back(mapper(*next++));
+                }
+                if (in_flight.empty()) {
+                    break;
+                }
+                auto f = co_await coroutine::as_future(std::move(in_flight.front()));
+                in_flight.pop_front();
+                if (failed) {
+                    // Only the first error is reported
+                    f.ignore_ready_future();
+                } else if (f.failed()) {
+                    ex = f.get_exception();
+                    failed = true;
+                } else if (auto r = f.get(); !r) {
+                    result = std::move(r);
+                    failed = true;
+                } else {
+                    merger(std::move(r).value());
+                }
+            }
+            if (ex) {
+                std::rethrow_exception(std::move(ex));
+            }
+            if (!failed) {
+                result = merger.get();
+            }
         }
     } catch(...) {
         handle_read_error(std::current_exception(), false);
@@ -6246,6 +6747,12 @@ future<bool> storage_proxy::cas(schema_ptr schema, shared_ptr<cas_request> reque
 
         paxos::paxos_state::guard l = co_await paxos::paxos_state::get_cas_lock(token, write_timeout);
 
+        // An uncontended round takes three round trips: prepare, which also
+        // reads the current values, accept and learn. Learn only waits for the
+        // commit consistency level of the request, so with ANY it completes as
+        // soon as a single replica has the decision. Prepare can't be skipped even if
+        // this coordinator proposed the previous ballot: without a lease a
+        // concurrent coordinator could have been promised a higher one meanwhile.
         while (true) {
             // Finish the previous PAXOS round, if any, and, as a side effect, compute
             // a ballot (round identifier) which is a) unique b) has good chances of being
@@ -6363,6 +6870,7 @@ inet_address_vector_replica_set storage_proxy::get_live_endpoints(const locator:
 
 void storage_proxy::sort_endpoints_by_proximity(const locator::topology& topo, inet_address_vector_replica_set& eps) const {
     topo.sort_by_proximity(my_address(), eps);
+    deprioritize_suspected_endpoints(topo, eps);
     // FIXME: before dynamic snitch is implement put local address (if present) at the beginning
     auto it = boost::range::find(eps, my_address());
     if (it != eps.end() && it != eps.begin()) {
@@ -6370,6 +6878,21 @@ void storage_proxy::sort_endpoints_by_proximity(const locator::topology& topo, i
     }
 }
 
+// Gossip takes a long time to mark an unresponsive node down, and until then requests sent to it
+// are only answered by timeouts. Move the replicas which the direct failure detector already suspects
+// to the back of the list, keeping the relative order of the others, so they are only used when there's
+// no choice left.
+void storage_proxy::deprioritize_suspected_endpoints(const locator::topology& topo, inet_address_vector_replica_set& eps) const {
+    auto threshold = _db.local().get_config().direct_failure_detector_suspicion_threshold();
+    if (!threshold || !_remote || eps.size() < 2) {
+        return;
+    }
+    std::stable_partition(eps.begin(), eps.end(), [&] (const gms::inet_address& ep) {
+        auto node = topo.find_node(ep);
+        return !node || node->is_this_node() || _remote->suspicion(node->host_id()) < threshold;
+    });
+}
+
 inet_address_vector_replica_set storage_proxy::get_endpoints_for_reading(const sstring& ks_name, const locator::effective_replication_map& erm, const dht::token& token) const {
     auto endpoints = erm.get_endpoints_for_reading(token);
     auto it = boost::range::remove_if(endpoints, std::not_fn(std::bind_front(&storage_proxy::is_alive, this)));
@@ -6378,6 +6901,96 @@ inet_address_vector_replica_set storage_proxy::get_endpoints_for_reading(const s
     return endpoints;
 }
 
+void storage_proxy::credit_speculative_retry_budget() {
+    // The budget of reads that didn't need to speculate is kept for bursts of
+    // slow reads, but only up to a limit, so that hedging can't double the load
+    // on the cluster when all replicas become slow.
+    constexpr double max_tokens = 100;
+    auto budget = std::clamp(_db.local().get_config().speculative_retry_budget(), 0.0, 1.0);
+    _speculative_retry_tokens = std::min(_speculative_retry_tokens + budget, max_tokens);
+}
+
+bool storage_proxy::consume_speculative_retry_budget() {
+    if (_db.local().get_config().speculative_retry_budget() >= 1) {
+        return true;
+    }
+    if (_speculative_retry_tokens < 1) {
+        return false;
+    }
+    _speculative_retry_tokens -= 1;
+    return true;
+}
+
+void storage_proxy::on_replica_read_sent(gms::inet_address ep) {
+    ++_replica_read_loads[ep].outstanding;
+}
+
+void storage_proxy::on_replica_read_done(gms::inet_address ep, std::chrono::microseconds latency, bool failed) {
+    // Weight of a new sample in the moving average.
+    constexpr double alpha = 0.25;
+    auto& load = _replica_read_loads[ep];
+    if (load.outstanding) {
+        --load.outstanding;
+    }
+    auto sample = double(latency.count());
+    if (failed) {
+        // A replica which fails quickly mustn't look fast, but one which
+        // times out should look as slow as it is.
+        sample = std::max(sample, load.latency_us);
+    }
+    load.latency_us = load.latency_us ? alpha * sample + (1 - alpha) * load.latency_us : sample;
+    load.last_updated = lowres_clock::now();
+}
+
+std::optional<double> storage_proxy::replica_read_score(gms::inet_address ep) const {
+    auto it = _replica_read_loads.find(ep);
+    if (it == _replica_read_loads.end()) {
+        return std::nullopt;
+    }
+    auto& load = it->second;
+    // Forget about a replica that didn't answer for a while, e.g. because
+    // it was ranked low, so that it gets a chance to prove it got better.
+    if (!load.outstanding && lowres_clock::now() - load.last_updated > std::chrono::seconds(1)) {
+        return std::nullopt;
+    }
+    // As in C3, penalize the queue built up at the replica super-linearly,
+    // so that a replica which is falling behind sheds load before its
+    // latency shows it.
+    auto queue = 1.0 + load.outstanding;
+    return load.latency_us * queue * queue * queue;
+}
+
+void storage_proxy::sort_endpoints_by_read_load(const locator::topology& topo, inet_address_vector_replica_set& eps) const {
+    if (eps.size() < 2) {
+        return;
+    }
+    auto badness = 1 + std::max(_db.local().get_config().dynamic_snitch_badness_threshold(), 0.0);
+    // Replicas are sorted by proximity, so replicas of a DC are adjacent.
+    // Never reorder across DCs, the proximity order wins.
+    auto dc_begin = eps.begin();
+    while (dc_begin != eps.end()) {
+        auto& dc = topo.get_datacenter(*dc_begin);
+        auto dc_end = std::find_if(dc_begin, eps.end(), [&] (gms::inet_address ep) {
+            return topo.get_datacenter(ep) != dc;
+        });
+        // Replicas we know nothing about recently keep their place.
+        std::optional<double> best;
+        for (auto it = dc_begin; it != dc_end; ++it) {
+            auto score = replica_read_score(*it);
+            if (score && (!best || *score < *best)) {
+                best = score;
+            }
+        }
+        if (best) {
+            std::stable_partition(dc_begin, dc_end, [&] (gms::inet_address ep) {
+                auto score = replica_read_score(ep);
+                return !score || *score <= *best * badness;
+            });
+        }
+        dc_begin = dc_end;
+    }
+}
+
 // `live_endpoints` must already contain only replicas for this query; the function only filters out some of them.
 inet_address_vector_replica_set
 storage_proxy::filter_replicas_for_read(
@@ -6435,8 +7048,9 @@ future<> storage_proxy::truncate_blocking(sstring keyspace, sstring cfname, std:
     return remote().send_truncate_blocking(std::move(keyspace), std::move(cfname), timeout_in_ms);
 }
 
-void storage_proxy::start_remote(netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, sharded<db::system_keyspace>& sys_ks) {
-    _remote = std::make_unique<struct remote>(*this, ms, g, mm, sys_ks);
+void storage_proxy::start_remote(netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, sharded<db::system_keyspace>& sys_ks,
+        sharded<direct_failure_detector::failure_detector>& direct_fd) {
+    _remote = std::make_unique<struct remote>(*this, ms, g, mm, sys_ks, direct_fd.local());
 }
 
 future<> storage_proxy::stop_remote() {
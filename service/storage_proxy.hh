@@ -70,6 +70,10 @@ namespace db {
 class system_keyspace;
 }
 
+namespace direct_failure_detector {
+class failure_detector;
+}
+
 namespace service {
 
 namespace paxos {
@@ -100,6 +104,17 @@ struct view_update_backlog_timestamped {
     api::timestamp_type ts;
 };
 
+// How fast a replica serves the reads this shard coordinates, as observed
+// by the coordinator. Used to route reads away from replicas which are slow
+// right now, e.g. because of compaction or a reactor stall.
+struct replica_read_load {
+    // Exponentially weighted moving average of the response latency.
+    double latency_us = 0;
+    // Reads sent to the replica that didn't complete yet.
+    uint32_t outstanding = 0;
+    lowres_clock::time_point last_updated;
+};
+
 struct allow_hints_tag {};
 using allow_hints = bool_class<allow_hints_tag>;
 
@@ -292,6 +307,9 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             lw_shared_ptr<cdc::operation_result_tracker>> _mutate_stage;
     db::view::node_update_backlog& _max_view_update_backlog;
     std::unordered_map<gms::inet_address, view_update_backlog_timestamped> _view_update_backlogs;
+    std::unordered_map<gms::inet_address, replica_read_load> _replica_read_loads;
+    // Speculative reads this shard may send, see speculative_retry_budget.
+    double _speculative_retry_tokens = 0;
 
     //NOTICE(sarna): This opaque pointer is here just to avoid moving write handler class definitions from .cc to .hh. It's slow path.
     class cancellable_write_handlers_list;
@@ -352,7 +370,19 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     bool hints_enabled(db::write_type type) const noexcept;
     db::hints::manager& hints_manager_for(db::write_type type);
     void sort_endpoints_by_proximity(const locator::topology& topo, inet_address_vector_replica_set& eps) const;
+    void deprioritize_suspected_endpoints(const locator::topology& topo, inet_address_vector_replica_set& eps) const;
     inet_address_vector_replica_set get_endpoints_for_reading(const sstring& ks_name, const locator::effective_replication_map& erm, const dht::token& token) const;
+    // Every speculating read earns a fraction of a speculative read, and
+    // every speculative read sent costs a whole one.
+    void credit_speculative_retry_budget();
+    bool consume_speculative_retry_budget();
+    void on_replica_read_sent(gms::inet_address ep);
+    void on_replica_read_done(gms::inet_address ep, std::chrono::microseconds latency, bool failed);
+    // Disengaged if the replica served no reads recently.
+    std::optional<double> replica_read_score(gms::inet_address ep) const;
+    // Moves replicas which are much slower than the fastest one of their DC
+    // behind the other replicas of the DC, keeping the order otherwise.
+    void sort_endpoints_by_read_load(const locator::topology& topo, inet_address_vector_replica_set& eps) const;
     inet_address_vector_replica_set filter_replicas_for_read(db::consistency_level, const locator::effective_replication_map&, inet_address_vector_replica_set live_endpoints, const inet_address_vector_replica_set& preferred_endpoints, db::read_repair_decision, std::optional<gms::inet_address>* extra, replica::column_family*) const;
     // As above with read_repair_decision=NONE, extra=nullptr.
     inet_address_vector_replica_set filter_replicas_for_read(db::consistency_level, const locator::effective_replication_map&, const inet_address_vector_replica_set& live_endpoints, const inet_address_vector_replica_set& preferred_endpoints, replica::column_family*) const;
@@ -418,6 +448,9 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<result<>> mutate_begin(unique_response_handler_vector ids, db::consistency_level cl, tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt = { });
     future<result<>> mutate_end(future<result<>> mutate_result, utils::latency_counter, write_stats& stats, tracing::trace_state_ptr trace_state);
     future<result<>> schedule_repair(locator::effective_replication_map_ptr ermp, std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state, service_permit permit);
+    // Queues the repair to be written in the background, without waiting for it.
+    // Returns false, leaving diffs untouched, if it can't be queued.
+    bool queue_background_repair(schema_ptr s, locator::effective_replication_map_ptr ermp, std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>>& diffs, db::consistency_level cl);
     bool need_throttle_writes() const;
     void unthrottle();
     void handle_read_error(std::variant<exceptions::coordinator_exception_container, std::exception_ptr> failure, bool range);
@@ -506,7 +539,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     }
 
     // Start/stop the remote part of `storage_proxy` that is required for performing distributed queries.
-    void start_remote(netw::messaging_service&, gms::gossiper&, migration_manager&, sharded<db::system_keyspace>& sys_ks);
+    void start_remote(netw::messaging_service&, gms::gossiper&, migration_manager&, sharded<db::system_keyspace>& sys_ks,
+            sharded<direct_failure_detector::failure_detector>& direct_fd);
     future<> stop_remote();
 
     gms::inet_address my_address() const noexcept;
@@ -82,6 +82,8 @@ struct write_stats {
     utils::timed_rate_moving_average write_rate_limited_by_coordinator;
 
     utils::timed_rate_moving_average_summary_and_histogram write;
+    // Writes of several mutations, such as unlogged batches, as a whole
+    utils::timed_rate_moving_average_summary_and_histogram unlogged_batch_write;
 
     utils::timed_rate_moving_average cas_write_unavailables;
     utils::timed_rate_moving_average cas_write_timeouts;
@@ -91,6 +93,9 @@ struct write_stats {
     utils::estimated_histogram cas_write_contention;
 
     uint64_t writes = 0;
+    // mutation_batch messages sent, and the mutations sent in them
+    uint64_t sent_mutation_batches = 0;
+    uint64_t mutations_in_sent_batches = 0;
     // A CQL write query arrived to a non-replica node and was
     // forwarded by a coordinator to a replica
     uint64_t writes_coordinator_outside_replica_set = 0;
@@ -143,9 +148,16 @@ struct stats : public write_stats {
     uint64_t read_repair_repaired_blocking = 0;
     uint64_t read_repair_repaired_background = 0;
     uint64_t global_read_repairs_canceled_due_to_concurrent_write = 0;
+    // partitions whose read repair was queued to be written in the background,
+    // merged with a repair already in the queue, or dropped because the queue was full
+    uint64_t read_repair_queued_partitions = 0;
+    uint64_t read_repair_merged_partitions = 0;
+    uint64_t read_repair_dropped_partitions = 0;
 
     // number of mutations received as a coordinator
     uint64_t received_mutations = 0;
+    // number of mutation_batch messages received, their mutations are also counted in received_mutations
+    uint64_t received_mutation_batches = 0;
 
     // number of counter updates received as a leader
     uint64_t received_counter_updates = 0;
@@ -170,6 +182,7 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    uint64_t speculative_reads_over_budget = 0; // speculative request not sent to stay within speculative_retry_budget
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
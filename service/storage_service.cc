@@ -2964,7 +2964,7 @@ future<> storage_service::replicate_to_all_cores(mutable_token_metadata_ptr tmpt
         }
 
         for (auto&& [table_id, tmap]: tmptr->tablets().all_tables()) {
-            for (auto&& [tid, trinfo]: tmap.transitions()) {
+            for (auto&& [tid, trinfo]: tmap->transitions()) {
                 if (trinfo.session_id) {
                     auto id = session_id(trinfo.session_id);
                     open_sessions.insert(id);
@@ -5722,6 +5722,11 @@ future<> storage_service::clone_locally_tablet_storage(locator::global_tablet_id
     });
     rtlogger.debug("Cloned storage of tablet {} from leaving replica {}, {} sstables were found", tablet, leaving, d.size());
 
+    co_await load_tablet_sstables(tablet, pending.shard, std::move(d));
+    rtlogger.debug("Successfully loaded storage of tablet {} into pending replica {}", tablet, pending);
+}
+
+future<> storage_service::load_tablet_sstables(locator::global_tablet_id tablet, shard_id shard, utils::chunked_vector<sstables::entry_descriptor> d) {
     auto load_sstable = [] (const dht::sharder& sharder, replica::table& t, sstables::entry_descriptor d) -> future<sstables::shared_sstable> {
         auto& mng = t.get_sstables_manager();
         auto sst = mng.make_sstable(t.schema(), t.dir(), t.get_storage_options(), d.generation, d.state.value_or(sstables::sstable_state::normal),
@@ -5735,8 +5740,8 @@ future<> storage_service::clone_locally_tablet_storage(locator::global_tablet_id
         co_return sst;
     };
 
-    co_await smp::submit_to(pending.shard, [this, tablet, load_sstable, d = std::move(d)] () mutable -> future<> {
-        // Loads cloned sstables from leaving replica into pending one.
+    co_await smp::submit_to(shard, [this, tablet, load_sstable, d = std::move(d)] () mutable -> future<> {
+        // Loads sstables of the leaving replica into pending one.
         auto& table = _db.local().find_column_family(tablet.table);
         auto op = table.stream_in_progress();
         dht::auto_refreshing_sharder sharder(table.shared_from_this());
@@ -5748,7 +5753,84 @@ future<> storage_service::clone_locally_tablet_storage(locator::global_tablet_id
         }
         co_await table.add_sstables_and_update_cache(ssts);
     });
-    rtlogger.debug("Successfully loaded storage of tablet {} into pending replica {}", tablet, pending);
+}
+
+future<bool> storage_service::stream_tablet_files(locator::global_tablet_id tablet, inet_address source, service::session_id session, shard_id pending_shard) {
+    auto [sink, src] = co_await _messaging.local().make_sink_and_source_for_stream_blob(tablet, session, netw::msg_addr(source));
+    int32_t status = -1;
+    bool streamed = false;
+    std::exception_ptr ex;
+    try {
+        auto& table = _db.local().find_column_family(tablet.table);
+        auto op = table.stream_in_progress();
+        auto d = co_await streaming::receive_files(table, src);
+        if (d) {
+            rtlogger.debug("Received {} sstables of tablet {} from {} as files", d->size(), tablet, source);
+            co_await load_tablet_sstables(tablet, pending_shard, std::move(*d));
+            streamed = true;
+        }
+        status = 0;
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    try {
+        co_await sink(status);
+        co_await sink.flush();
+    } catch (...) {
+        rtlogger.debug("Failed to send status of file streaming of tablet {} to {}: {}", tablet, source, std::current_exception());
+    }
+    co_await sink.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return streamed;
+}
+
+future<> storage_service::send_tablet_files(locator::global_tablet_id tablet, service::session_id session, streaming::stream_blob_sink sink, rpc::source<int32_t> source) {
+    std::exception_ptr ex;
+    try {
+        auto holder = _async_gate.hold();
+        auto guard = service::topology_guard(session);
+        auto tm = get_token_metadata_ptr();
+        auto& tmap = tm->tablets().get_tablet_map(tablet.table);
+        auto& tinfo = tmap.get_tablet_info(tablet.tablet);
+        auto my_id = tm->get_my_id();
+        auto replica = std::ranges::find(tinfo.replicas, my_id, &locator::tablet_replica::host);
+        if (replica == tinfo.replicas.end()) {
+            throw std::runtime_error(fmt::format("Tablet {} has no replica on node {}", tablet, my_id));
+        }
+        auto shard = replica->shard;
+        auto range = tmap.get_token_range(tablet.tablet);
+        tm = nullptr;
+
+        auto files = co_await _db.invoke_on(shard, [tablet, range] (replica::database& db) -> future<std::optional<std::vector<streaming::stream_blob_file>>> {
+            auto& table = db.find_column_family(tablet.table);
+            auto op = table.stream_in_progress();
+            co_return co_await streaming::open_files_for_streaming(table, range);
+        });
+        guard.check();
+        rtlogger.debug("Sending {} files of tablet {}", files ? files->size() : 0, tablet);
+        co_await streaming::send_files(std::move(files), sink);
+
+        auto status = co_await source();
+        if (!status || std::get<0>(*status) != 0) {
+            throw std::runtime_error(fmt::format("Pending replica failed to receive files of tablet {}", tablet));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        try {
+            co_await sink(streaming::stream_blob_cmd::error, sstring(), temporary_buffer<char>());
+            co_await sink.flush();
+        } catch (...) {
+            // The pending replica may have gone away already.
+        }
+    }
+    co_await sink.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
 }
 
 // Streams data to the pending tablet replica of a given tablet on this node.
@@ -5809,25 +5891,46 @@ future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
                                                      tablet, leaving_replica->shard, trinfo->pending_replica->shard));
             }
             auto& table = _db.local().find_column_family(tablet.table);
-            std::vector<sstring> tables = {table.schema()->cf_name()};
-            auto my_id = tm->get_my_id();
-            auto streamer = make_lw_shared<dht::range_streamer>(_db, _stream_manager, std::move(tm),
-                                                                guard.get_abort_source(),
-                                                                my_id, _snitch.local()->get_location(),
-                                                                format("Tablet {}", trinfo->transition),
-                                                                reason,
-                                                                topo_guard,
-                                                                std::move(tables));
-            tm = nullptr;
-            streamer->add_source_filter(std::make_unique<dht::range_streamer::failure_detector_source_filter>(
-                    _gossiper.get_unreachable_members()));
-
-            std::unordered_map<inet_address, dht::token_range_vector> ranges_per_endpoint;
-            for (auto r: streaming_info.read_from) {
-                ranges_per_endpoint[host2ip(r.host)].emplace_back(range);
+            // Sstables of a migrating tablet are fully contained in it, so they can be shipped as files,
+            // without decoding and rewriting them. Streaming mutations is still needed when the data
+            // has to go through the view update path, or when a merge of several replicas is needed.
+            bool file_stream = trinfo->transition == locator::tablet_transition_kind::migration
+                    && streaming_info.read_from.size() == 1
+                    && _feature_service.file_stream
+                    && _db.local().get_config().enable_file_stream()
+                    && table.get_storage_options().is_local_type()
+                    && table.views().empty();
+            bool streamed = false;
+            if (file_stream) {
+                auto source = host2ip(streaming_info.read_from.begin()->host);
+                streamed = co_await stream_tablet_files(tablet, source, topo_guard, pending_replica->shard);
+                if (streamed) {
+                    rtlogger.info("Streamed tablet {} from {} as files", tablet, source);
+                } else {
+                    rtlogger.info("Tablet {} cannot be streamed as files from {}, streaming mutations", tablet, source);
+                }
+            }
+            if (!streamed) {
+                std::vector<sstring> tables = {table.schema()->cf_name()};
+                auto my_id = tm->get_my_id();
+                auto streamer = make_lw_shared<dht::range_streamer>(_db, _stream_manager, std::move(tm),
+                                                                    guard.get_abort_source(),
+                                                                    my_id, _snitch.local()->get_location(),
+                                                                    format("Tablet {}", trinfo->transition),
+                                                                    reason,
+                                                                    topo_guard,
+                                                                    std::move(tables));
+                tm = nullptr;
+                streamer->add_source_filter(std::make_unique<dht::range_streamer::failure_detector_source_filter>(
+                        _gossiper.get_unreachable_members()));
+
+                std::unordered_map<inet_address, dht::token_range_vector> ranges_per_endpoint;
+                for (auto r: streaming_info.read_from) {
+                    ranges_per_endpoint[host2ip(r.host)].emplace_back(range);
+                }
+                streamer->add_rx_ranges(table.schema()->ks_name(), std::move(ranges_per_endpoint));
+                co_await streamer->stream_async();
             }
-            streamer->add_rx_ranges(table.schema()->ks_name(), std::move(ranges_per_endpoint));
-            co_await streamer->stream_async();
         }
 
         // If new pending tablet replica needs splitting, streaming waits for it to complete.
@@ -6138,6 +6241,35 @@ future<locator::load_stats> storage_service::load_stats_for_tablet_based_tables(
     co_return std::move(load_stats);
 }
 
+future<std::unordered_map<table_id, double>> storage_service::ops_rates_for_tablet_based_tables() {
+    auto holder = _async_gate.hold();
+
+    if (this_shard_id() != 0) {
+        co_return co_await container().invoke_on(0, [&] (auto& ss) {
+            return ss.ops_rates_for_tablet_based_tables();
+        });
+    }
+
+    using rates_t = std::unordered_map<table_id, double>;
+    // The one-minute moving averages of reads and writes served by each shard, summed up.
+    co_return co_await _db.map_reduce0([] (replica::database& db) -> future<rates_t> {
+        rates_t rates;
+        co_await db.get_tables_metadata().for_each_table_gently([&rates] (table_id id, lw_shared_ptr<replica::table> table) {
+            if (table->uses_tablets()) {
+                auto& stats = table->get_stats();
+                rates.emplace(id, stats.reads.rate().rate.rates[0] + stats.writes.rate().rate.rates[0]);
+            }
+            return make_ready_future<>();
+        });
+        co_return std::move(rates);
+    }, rates_t{}, [] (rates_t a, const rates_t& b) {
+        for (auto& [id, rate] : b) {
+            a[id] += rate;
+        }
+        return a;
+    });
+}
+
 future<> storage_service::transit_tablet(table_id table, dht::token token, noncopyable_function<std::tuple<std::vector<canonical_mutation>, sstring>(const locator::tablet_map&, api::timestamp_type)> prepare_mutations) {
     while (true) {
         auto guard = co_await _group0->client().start_operation(&_group0_as, raft_timeout{});
@@ -6666,6 +6798,13 @@ void storage_service::init_messaging_service() {
             return ss.stream_tablet(tablet);
         });
     });
+    _messaging.local().register_stream_blob([this] (const rpc::client_info& cinfo, locator::global_tablet_id tablet, service::session_id session, rpc::source<int32_t> source) {
+        auto sink = _messaging.local().make_sink_for_stream_blob(source);
+        (void)send_tablet_files(tablet, session, sink, std::move(source)).handle_exception([tablet] (std::exception_ptr ep) {
+            rtlogger.warn("Failed to send files of tablet {}: {}", tablet, ep);
+        });
+        return make_ready_future<streaming::stream_blob_sink>(std::move(sink));
+    });
     ser::storage_service_rpc_verbs::register_tablet_cleanup(&_messaging.local(), [handle_raft_rpc] (raft::server_id dst_id, locator::global_tablet_id tablet) {
         return handle_raft_rpc(dst_id, [tablet] (auto& ss) {
             return ss.cleanup_tablet(tablet);
@@ -6676,6 +6815,11 @@ void storage_service::init_messaging_service() {
             return ss.load_stats_for_tablet_based_tables();
         });
     });
+    ser::storage_service_rpc_verbs::register_table_ops_rates(&_messaging.local(), [handle_raft_rpc] (raft::server_id dst_id) {
+        return handle_raft_rpc(dst_id, [] (auto& ss) mutable {
+            return ss.ops_rates_for_tablet_based_tables();
+        });
+    });
     ser::join_node_rpc_verbs::register_join_node_request(&_messaging.local(), [handle_raft_rpc] (raft::server_id dst_id, service::join_node_request_params params) {
         return handle_raft_rpc(dst_id, [params = std::move(params)] (auto& ss) mutable {
             return ss.join_node_request_handler(std::move(params));
@@ -6708,6 +6852,7 @@ void storage_service::init_messaging_service() {
 future<> storage_service::uninit_messaging_service() {
     return when_all_succeed(
         _messaging.local().unregister_node_ops_cmd(),
+        _messaging.local().unregister_stream_blob(),
         ser::storage_service_rpc_verbs::unregister(&_messaging.local()),
         ser::join_node_rpc_verbs::unregister(&_messaging.local())
     ).discard_result();
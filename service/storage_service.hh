@@ -31,6 +31,7 @@
 #include <seastar/core/gate.hh>
 #include "replica/database_fwd.hh"
 #include "streaming/stream_reason.hh"
+#include "streaming/stream_blob.hh"
 #include <seastar/core/distributed.hh>
 #include "service/migration_listener.hh"
 #include <seastar/core/metrics_registration.hh>
@@ -185,10 +186,19 @@ class storage_service : public service::migration_listener, public gms::i_endpoi
     // Clones storage of leaving tablet into pending one. Done in the context of intra-node migration,
     // when both of which sit on the same node. So all the movement is local.
     future<> clone_locally_tablet_storage(locator::global_tablet_id, locator::tablet_replica leaving, locator::tablet_replica pending);
+    // Pulls the sstables of the tablet from the source replica as files, and loads them into the pending replica.
+    // Returns false if the source cannot send the tablet as files, in which case nothing was loaded.
+    future<bool> stream_tablet_files(locator::global_tablet_id, inet_address source, service::session_id, shard_id pending_shard);
+    // Handler of STREAM_BLOB at the source replica of the tablet.
+    future<> send_tablet_files(locator::global_tablet_id, service::session_id, streaming::stream_blob_sink, rpc::source<int32_t>);
+    // Loads sstables, which reside in the table's directory, into the given shard.
+    future<> load_tablet_sstables(locator::global_tablet_id, shard_id, utils::chunked_vector<sstables::entry_descriptor>);
     future<> cleanup_tablet(locator::global_tablet_id);
     inet_address host2ip(locator::host_id) const;
     // Handler for table load stats RPC.
     future<locator::load_stats> load_stats_for_tablet_based_tables();
+    // Handler for table ops rates RPC.
+    future<std::unordered_map<table_id, double>> ops_rates_for_tablet_based_tables();
     future<> process_tablet_split_candidate(table_id);
     void register_tablet_split_candidate(table_id) noexcept;
     future<> run_tablet_split_monitor();
@@ -31,6 +31,7 @@ struct load_balancer_dc_stats {
     uint64_t migrations_produced = 0;
     uint64_t intranode_migrations_produced = 0;
     uint64_t migrations_skipped = 0;
+    uint64_t migration_bytes_produced = 0;
     uint64_t tablets_skipped_node = 0;
     uint64_t tablets_skipped_rack = 0;
     uint64_t stop_balance = 0;
@@ -71,6 +72,8 @@ class load_balancer_stats_manager {
                              stats.migrations_produced)(dc_lb),
             sm::make_counter("migrations_skipped", sm::description("number of migrations skipped by the load balancer due to load limits"),
                              stats.migrations_skipped)(dc_lb),
+            sm::make_counter("migration_bytes_produced", sm::description("estimated amount of data moved by migrations produced by the load balancer"),
+                             stats.migration_bytes_produced)(dc_lb),
         });
     }
 
@@ -254,6 +257,12 @@ class load_balancer {
         uint64_t tablet_count = 0;
         const locator::node* node; // never nullptr
 
+        // Estimated amount of data which is streamed from this node.
+        uint64_t streaming_read_bytes = 0;
+
+        // Estimated amount of data which is streamed to this node.
+        uint64_t streaming_write_bytes = 0;
+
         // The average shard load on this node.
         load_type avg_load = 0;
 
@@ -331,16 +340,35 @@ class load_balancer {
         return double(max_tablet_size / 2) * 0.5;
     }
 
+    // Tablets are also split when they are hot, so that the load of a table which is small but
+    // heavily accessed can be spread across more shards. The split threshold is the target ops
+    // rate of a tablet replica, and the merge threshold is a quarter of it, like for sizes. Merge
+    // requires tablets to be both small and cold, so that tablets which were split due to load
+    // aren't merged back because of their size. Load-based resizing is disabled if the target is 0.
+    uint64_t _target_tablet_ops = 0;
+
     struct table_size_desc {
         uint64_t target_max_tablet_size;
         uint64_t avg_tablet_size;
         locator::resize_decision resize_decision;
         size_t tablet_count;
         size_t shard_count;
+        uint64_t target_max_tablet_ops = 0;
+        double avg_tablet_ops = 0;
+        // Whether the table is allowed to grow its tablet count due to load. Splitting a table
+        // whose tablets already have a replica on every shard doesn't spread its load any further.
+        bool load_split_allowed = false;
 
         uint64_t target_min_tablet_size() const noexcept {
             return load_balancer::target_min_tablet_size(target_max_tablet_size);
         }
+
+        bool hot() const noexcept {
+            return target_max_tablet_ops && avg_tablet_ops > target_max_tablet_ops;
+        }
+        bool cold() const noexcept {
+            return !target_max_tablet_ops || avg_tablet_ops < target_max_tablet_ops / 4.0;
+        }
     };
 
     struct cluster_resize_load {
@@ -350,10 +378,10 @@ class load_balancer {
 
         static bool table_needs_merge(const table_size_desc& d) {
             // FIXME: ignore merge request if tablet_count == initial_tablets.
-            return d.tablet_count > 1 && d.avg_tablet_size < d.target_min_tablet_size();
+            return d.tablet_count > 1 && d.avg_tablet_size < d.target_min_tablet_size() && d.cold();
         }
         static bool table_needs_split(const table_size_desc& d) {
-            return d.avg_tablet_size > d.target_max_tablet_size;
+            return d.avg_tablet_size > d.target_max_tablet_size || (d.load_split_allowed && d.hot());
         }
 
         bool table_needs_resize(const table_size_desc& d) const {
@@ -364,13 +392,16 @@ class load_balancer {
         // We shouldn't rush into cancelling an ongoing resize. That will only happen if the
         // average size is past the point it would be if either split or merge had completed.
         // If we cancel a split, that's because average size dropped so much a merge would be
-        // required post completion, and vice-versa.
+        // required post completion, and vice-versa. The same goes for the ops rate, a split is
+        // only cancelled if both the size and the rate dropped.
         bool table_needs_resize_cancellation(const table_size_desc& d) const {
             auto& way = d.resize_decision.way;
             if (std::holds_alternative<locator::resize_decision::split>(way)) {
-                return d.avg_tablet_size < d.target_max_tablet_size / 2;
+                return d.avg_tablet_size < d.target_max_tablet_size / 2
+                    && (!d.target_max_tablet_ops || d.avg_tablet_ops < d.target_max_tablet_ops / 2.0);
             } else if (std::holds_alternative<locator::resize_decision::merge>(way)) {
-                return d.avg_tablet_size > d.target_min_tablet_size() * 2;
+                return d.avg_tablet_size > d.target_min_tablet_size() * 2
+                    || (d.target_max_tablet_ops && d.avg_tablet_ops > d.target_max_tablet_ops / 2.0);
             }
             return false;
         }
@@ -397,7 +428,11 @@ class load_balancer {
             return [] (const table_id_and_size_desc& a, const table_id_and_size_desc& b) {
                 auto urgency = [] (const table_size_desc& d) -> double {
                     // FIXME: only takes into account split today.
-                    return double(d.avg_tablet_size) / d.target_max_tablet_size;
+                    auto size_urgency = double(d.avg_tablet_size) / d.target_max_tablet_size;
+                    if (!d.target_max_tablet_ops) {
+                        return size_urgency;
+                    }
+                    return std::max(size_urgency, d.avg_tablet_ops / d.target_max_tablet_ops);
                 };
                 return urgency(a.second) < urgency(b.second);
             };
@@ -449,6 +484,18 @@ class load_balancer {
     const size_t max_write_streaming_load = 2;
     const size_t max_read_streaming_load = 4;
 
+    // The limits above bound the number of migrations, not the amount of data they move. Tablets are
+    // not always of the target size, e.g. those of a table which waits for a split can be twice as big,
+    // so the amount of data streamed to and from a node is also limited, to what the per-shard limits
+    // allow for tablets of the target size. A migration is always allowed on a node which doesn't
+    // stream anything, so that tablets bigger than the limit can still be moved.
+    uint64_t max_write_streaming_bytes(const node_load& node) const {
+        return node.shard_count * max_write_streaming_load * _target_tablet_size;
+    }
+    uint64_t max_read_streaming_bytes(const node_load& node) const {
+        return node.shard_count * max_read_streaming_load * _target_tablet_size;
+    }
+
     token_metadata_ptr _tm;
     locator::load_stats_ptr _table_load_stats;
     load_balancer_stats_manager& _stats;
@@ -520,6 +567,10 @@ class load_balancer {
         _use_table_aware_balancing = use_table_aware_balancing;
     }
 
+    void set_target_tablet_ops(uint64_t target_tablet_ops) {
+        _target_tablet_ops = target_tablet_ops;
+    }
+
     const locator::table_load_stats* load_stats_for_table(table_id id) const {
         if (!_table_load_stats) {
             return nullptr;
@@ -528,6 +579,18 @@ class load_balancer {
         return (it != _table_load_stats->tables.end()) ? &it->second : nullptr;
     }
 
+    // Estimated amount of data which a migration of a tablet of the table moves.
+    // It's the average size of tablets of the table, or the target size if load stats
+    // are not available for the table.
+    uint64_t tablet_size(table_id table) const {
+        const auto* table_stats = load_stats_for_table(table);
+        if (!table_stats) {
+            return _target_tablet_size;
+        }
+        auto& tmap = _tm->tablets().get_tablet_map(table);
+        return table_stats->size_in_bytes / std::max(tmap.tablet_count(), size_t(1));
+    }
+
     future<table_resize_plan> make_resize_plan() {
         table_resize_plan resize_plan;
 
@@ -537,8 +600,16 @@ class load_balancer {
 
         cluster_resize_load resize_load;
 
+        size_t total_shard_count = std::invoke([&topo = _tm->get_topology()] {
+            size_t shard_count = 0;
+            topo.for_each_node([&] (const locator::node* node_ptr) {
+                shard_count += node_ptr->get_shard_count();
+            });
+            return shard_count;
+        });
+
         for (auto&& [table, tmap_] : _tm->tablets().all_tables()) {
-            auto& tmap = tmap_;
+            auto& tmap = *tmap_;
 
             const auto* table_stats = load_stats_for_table(table);
             if (!table_stats) {
@@ -546,6 +617,7 @@ class load_balancer {
             }
 
             auto avg_tablet_size = table_stats->size_in_bytes / std::max(tmap.tablet_count(), size_t(1));
+            auto avg_tablet_ops = table_stats->ops_per_second / std::max(tmap.tablet_count(), size_t(1));
             // shard presence of a table across the cluster
             size_t shard_count = std::accumulate(tmap.tablets().begin(), tmap.tablets().end(), size_t(0),
                 [] (size_t shard_count, const locator::tablet_info& info) {
@@ -557,11 +629,15 @@ class load_balancer {
                 .avg_tablet_size = avg_tablet_size,
                 .resize_decision = tmap.resize_decision(),
                 .tablet_count = tmap.tablet_count(),
-                .shard_count = shard_count
+                .shard_count = shard_count,
+                .target_max_tablet_ops = _target_tablet_ops,
+                .avg_tablet_ops = avg_tablet_ops,
+                .load_split_allowed = shard_count < total_shard_count,
             };
 
             resize_load.update(table, std::move(size_desc));
-            lblogger.info("Table {} with tablet_count={} has an average tablet size of {}", table, tmap.tablet_count(), avg_tablet_size);
+            lblogger.info("Table {} with tablet_count={} has an average tablet size of {} and an average tablet ops rate of {}",
+                          table, tmap.tablet_count(), avg_tablet_size, avg_tablet_ops);
             co_await coroutine::maybe_yield();
         }
 
@@ -571,13 +647,6 @@ class load_balancer {
         // If tables still have a low tablet count, the concurrency must be high in order to saturate the cluster.
         // If a table covers the entire cluster, and needs split, concurrency will be reduced to 1.
 
-        size_t total_shard_count = std::invoke([&topo = _tm->get_topology()] {
-            size_t shard_count = 0;
-            topo.for_each_node([&] (const locator::node* node_ptr) {
-                shard_count += node_ptr->get_shard_count();
-            });
-            return shard_count;
-        });
         size_t resizing_shard_count = std::accumulate(resize_load.tables_being_resized.begin(), resize_load.tables_being_resized.end(), size_t(0),
              [] (size_t shard_count, const auto& table_desc) {
                  return shard_count + table_desc.second.shard_count;
@@ -596,8 +665,8 @@ class load_balancer {
             }
 
             auto resize_decision = cluster_resize_load::to_resize_decision(size_desc);
-            lblogger.info("Emitting resize decision of type {} for table {} due to avg tablet size of {}",
-                          resize_decision.type_name(), table, size_desc.avg_tablet_size);
+            lblogger.info("Emitting resize decision of type {} for table {} due to avg tablet size of {} and avg tablet ops rate of {}",
+                          resize_decision.type_name(), table, size_desc.avg_tablet_size, size_desc.avg_tablet_ops);
             resize_plan.resize[table] = std::move(resize_decision);
             _stats.for_cluster().resizes_emitted++;
 
@@ -614,7 +683,8 @@ class load_balancer {
             if (resize_load.table_needs_resize_cancellation(size_desc)) {
                 resize_plan.resize[table] = cluster_resize_load::revoke_resize_decision();
                 _stats.for_cluster().resizes_revoked++;
-                lblogger.info("Revoking resize decision for table {} due to avg tablet size of {}", table, size_desc.avg_tablet_size);
+                lblogger.info("Revoking resize decision for table {} due to avg tablet size of {} and avg tablet ops rate of {}",
+                              table, size_desc.avg_tablet_size, size_desc.avg_tablet_ops);
                 continue;
             }
 
@@ -638,7 +708,16 @@ class load_balancer {
         co_return std::move(resize_plan);
     }
 
-    void apply_load(node_load_map& nodes, const tablet_migration_streaming_info& info) {
+    static std::unordered_set<host_id> hosts_of(const std::unordered_set<tablet_replica>& replicas) {
+        std::unordered_set<host_id> hosts;
+        for (auto&& r : replicas) {
+            hosts.insert(r.host);
+        }
+        return hosts;
+    }
+
+    // size is the estimated amount of data moved by the migration, see tablet_size().
+    void apply_load(node_load_map& nodes, const tablet_migration_streaming_info& info, uint64_t size) {
         for (auto&& replica : info.read_from) {
             if (nodes.contains(replica.host)) {
                 nodes[replica.host].shards[replica.shard].streaming_read_load += 1;
@@ -649,9 +728,39 @@ class load_balancer {
                 nodes[replica.host].shards[replica.shard].streaming_write_load += 1;
             }
         }
+        for (auto&& host : hosts_of(info.read_from)) {
+            if (nodes.contains(host)) {
+                nodes[host].streaming_read_bytes += size;
+            }
+        }
+        for (auto&& host : hosts_of(info.written_to)) {
+            if (nodes.contains(host)) {
+                nodes[host].streaming_write_bytes += size;
+            }
+        }
     }
 
-    bool can_accept_load(node_load_map& nodes, const tablet_migration_streaming_info& info) {
+    bool can_accept_load(node_load_map& nodes, const tablet_migration_streaming_info& info, uint64_t size) {
+        for (auto&& host : hosts_of(info.read_from)) {
+            if (!nodes.contains(host)) {
+                continue;
+            }
+            auto& node = nodes[host];
+            if (node.streaming_read_bytes && node.streaming_read_bytes + size > max_read_streaming_bytes(node)) {
+                lblogger.debug("Migration skipped because of read data limit on {} ({} + {})", host, node.streaming_read_bytes, size);
+                return false;
+            }
+        }
+        for (auto&& host : hosts_of(info.written_to)) {
+            if (!nodes.contains(host)) {
+                continue;
+            }
+            auto& node = nodes[host];
+            if (node.streaming_write_bytes && node.streaming_write_bytes + size > max_write_streaming_bytes(node)) {
+                lblogger.debug("Migration skipped because of write data limit on {} ({} + {})", host, node.streaming_write_bytes, size);
+                return false;
+            }
+        }
         for (auto r : info.read_from) {
             if (!nodes.contains(r.host)) {
                 continue;
@@ -713,7 +822,11 @@ class load_balancer {
             return *shard_info.candidates[table].begin();
         }
 
-        return *shard_info.candidates_all_tables.begin();
+        // Tablets of different tables can differ in size a lot, and moving any of them
+        // changes the load equally, so prefer the one which is the cheapest to migrate.
+        return *std::ranges::min_element(shard_info.candidates_all_tables, std::less<>(), [this] (const global_tablet_id& t) {
+            return tablet_size(t.table);
+        });
     }
 
     void erase_candidate(shard_load& shard_info, global_tablet_id tablet) {
@@ -818,16 +931,18 @@ class load_balancer {
             auto& tmap = tmeta.get_tablet_map(tablet.table);
             auto& src_tinfo = tmap.get_tablet_info(tablet.tablet);
             auto mig_streaming_info = get_migration_streaming_info(_tm->get_topology(), src_tinfo, mig);
+            auto mig_size = tablet_size(tablet.table);
 
-            if (!can_accept_load(nodes, mig_streaming_info)) {
+            if (!can_accept_load(nodes, mig_streaming_info, mig_size)) {
                 _stats.for_dc(node_load.dc()).migrations_skipped++;
                 lblogger.debug("Unable to balance {}: load limit reached", host);
                 break;
             }
 
-            apply_load(nodes, mig_streaming_info);
-            lblogger.debug("Adding migration: {}", mig);
+            apply_load(nodes, mig_streaming_info, mig_size);
+            lblogger.debug("Adding migration: {} ({} bytes)", mig, mig_size);
             _stats.for_dc(node_load.dc()).migrations_produced++;
+            _stats.for_dc(node_load.dc()).migration_bytes_produced += mig_size;
             _stats.for_dc(node_load.dc()).intranode_migrations_produced++;
             plan.add(std::move(mig));
 
@@ -1119,11 +1234,13 @@ class load_balancer {
             auto mig = tablet_migration_info {kind, source_tablet, src, dst};
             auto& src_tinfo = tmap.get_tablet_info(source_tablet.tablet);
             auto mig_streaming_info = get_migration_streaming_info(topo, src_tinfo, mig);
+            auto mig_size = tablet_size(source_tablet.table);
 
-            if (can_accept_load(nodes, mig_streaming_info)) {
-                apply_load(nodes, mig_streaming_info);
-                lblogger.debug("Adding migration: {}", mig);
+            if (can_accept_load(nodes, mig_streaming_info, mig_size)) {
+                apply_load(nodes, mig_streaming_info, mig_size);
+                lblogger.debug("Adding migration: {} ({} bytes)", mig, mig_size);
                 _stats.for_dc(dc).migrations_produced++;
+                _stats.for_dc(dc).migration_bytes_produced += mig_size;
                 plan.add(std::move(mig));
             } else {
                 // Shards are overloaded with streaming. Do not include the migration in the plan, but
@@ -1246,7 +1363,7 @@ class load_balancer {
         // Compute tablet load on nodes.
 
         for (auto&& [table, tmap_] : _tm->tablets().all_tables()) {
-            auto& tmap = tmap_;
+            auto& tmap = *tmap_;
 
             co_await tmap.for_each_tablet([&, table = table] (tablet_id tid, const tablet_info& ti) -> future<> {
                 auto trinfo = tmap.get_tablet_transition_info(tid);
@@ -1346,12 +1463,12 @@ class load_balancer {
         // Compute per-shard load and candidate tablets.
 
         for (auto&& [table, tmap_] : _tm->tablets().all_tables()) {
-            auto& tmap = tmap_;
+            auto& tmap = *tmap_;
             co_await tmap.for_each_tablet([&, table = table] (tablet_id tid, const tablet_info& ti) -> future<> {
                 auto trinfo = tmap.get_tablet_transition_info(tid);
 
                 if (is_streaming(trinfo)) {
-                    apply_load(nodes, get_migration_streaming_info(topo, ti, *trinfo));
+                    apply_load(nodes, get_migration_streaming_info(topo, ti, *trinfo), tablet_size(table));
                 }
 
                 for (auto&& replica : get_replicas_for_tablet_load(ti, trinfo)) {
@@ -1426,6 +1543,7 @@ class tablet_allocator_impl : public tablet_allocator::impl
     future<migration_plan> balance_tablets(token_metadata_ptr tm, locator::load_stats_ptr table_load_stats, std::unordered_set<host_id> skiplist) {
         load_balancer lb(tm, std::move(table_load_stats), _load_balancer_stats, _db.get_config().target_tablet_size_in_bytes(), std::move(skiplist));
         lb.set_use_table_aware_balancing(_use_tablet_aware_balancing);
+        lb.set_target_tablet_ops(_db.get_config().target_tablet_ops_per_second());
         co_return co_await lb.make_plan();
     }
 
@@ -998,7 +998,8 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
                                                            locator::global_tablet_id,
                                                            const locator::tablet_transition_info&)> func) {
         auto tm = get_token_metadata_ptr();
-        for (auto&& [table, tmap] : tm->tablets().all_tables()) {
+        for (auto&& [table, tmap_] : tm->tablets().all_tables()) {
+            auto& tmap = *tmap_;
             co_await coroutine::maybe_yield();
             auto s = _db.find_schema(table);
             for (auto&& [tablet, trinfo]: tmap.transitions()) {
@@ -2507,6 +2508,18 @@ future<locator::load_stats> topology_coordinator::refresh_tablet_load_stats() {
                                                                                              as,
                                                                                              raft::server_id(dst.uuid()));
 
+            if (_db.features().table_ops_rates) {
+                auto rates = co_await ser::storage_service_rpc_verbs::send_table_ops_rates(&_messaging,
+                                                                                          netw::msg_addr(id2ip(dst)),
+                                                                                          as,
+                                                                                          raft::server_id(dst.uuid()));
+                for (auto& [table_id, rate] : rates) {
+                    if (auto it = node_stats.tables.find(table_id); it != node_stats.tables.end()) {
+                        it->second.ops_per_second = rate;
+                    }
+                }
+            }
+
             dc_stats += node_stats;
         });
 
@@ -2528,8 +2541,8 @@ future<locator::load_stats> topology_coordinator::refresh_tablet_load_stats() {
                 continue;
             }
             total_replicas[table_id] += rf_for_this_dc;
-            rtlogger.debug("raft topology: Refreshed table load stats for DC {}, table={}, RF={}, size_in_bytes={}, split_ready_seq_number={}",
-                          dc, table_id, rf_for_this_dc, table_stats.size_in_bytes, table_stats.split_ready_seq_number);
+            rtlogger.debug("raft topology: Refreshed table load stats for DC {}, table={}, RF={}, size_in_bytes={}, split_ready_seq_number={}, ops_per_second={}",
+                          dc, table_id, rf_for_this_dc, table_stats.size_in_bytes, table_stats.split_ready_seq_number, table_stats.ops_per_second);
         }
 
         stats += dc_stats;
@@ -2544,6 +2557,8 @@ future<locator::load_stats> topology_coordinator::refresh_tablet_load_stats() {
         // for a single table replica. This allows the load balancer to compute, in turn,
         // the average tablet size by dividing total size by tablet count.
         table_load_stats.size_in_bytes /= table_total_replicas;
+        // Likewise for the rate of requests served by a tablet replica.
+        table_load_stats.ops_per_second /= table_total_replicas;
     }
     rtlogger.debug("raft topology: Refreshed table load stats for all DC(s).");
 
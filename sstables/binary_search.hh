@@ -11,6 +11,7 @@
 
 #include "sstables/key.hh"
 #include "dht/i_partitioner.hh"
+#include "dht/ring_position.hh"
 
 namespace sstables {
 
@@ -72,4 +73,70 @@ int binary_search(const dht::i_partitioner& partitioner, const T& entries, const
     return binary_search(partitioner, entries, sk, partitioner.get_token(key_view(sk)));
 }
 
+/**
+ * Returns the index of the first entry in [first, last) which is not less than
+ * pos, like std::lower_bound() would. Entries must expose their token as
+ * raw_token, like summary_entry does.
+ *
+ * Murmur3 tokens are close to uniformly distributed, so the position of pos
+ * is first guessed by interpolating its token between the tokens at the ends
+ * of the range, which usually leaves a handful of candidates after one or two
+ * probes. If the guesses don't converge quickly (e.g. because the tokens are
+ * skewed), the rest of the range is binary searched, so the number of probes
+ * is never much worse than that of a plain binary search.
+ *
+ * The number of entries compared is added to probes.
+ */
+template <typename T, typename Less>
+size_t interpolation_lower_bound(const T& entries, size_t first, size_t last, dht::ring_position_view pos, Less less, uint64_t& probes) {
+    static constexpr int max_interpolation_rounds = 3;
+    // Below this size, binary search is as good as interpolation.
+    static constexpr size_t min_interpolation_range = 8;
+    const auto target = pos.token().raw();
+
+    for (int round = 0; round < max_interpolation_rounds && last - first >= min_interpolation_range; ++round) {
+        const auto lo = entries[first].raw_token;
+        const auto hi = entries[last - 1].raw_token;
+        if (target <= lo || target > hi) {
+            break;
+        }
+        // Compute in floating point, the difference of two tokens can overflow int64_t.
+        auto fraction = (double(target) - double(lo)) / (double(hi) - double(lo));
+        auto guess = first + std::min(size_t(fraction * (last - 1 - first)), last - 1 - first);
+        ++probes;
+        if (less(entries[guess], pos)) {
+            first = guess + 1;
+            // The answer is usually right after the guess, check the next entry
+            // too, so that a precise guess doesn't leave a long range behind.
+            if (first < last) {
+                ++probes;
+                if (!less(entries[first], pos)) {
+                    return first;
+                }
+                ++first;
+            }
+        } else {
+            last = guess + 1;
+            if (guess > first) {
+                ++probes;
+                if (less(entries[guess - 1], pos)) {
+                    return guess;
+                }
+                last = guess;
+            }
+        }
+    }
+
+    while (first < last) {
+        auto mid = first + (last - first) / 2;
+        ++probes;
+        if (less(entries[mid], pos)) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
 }
@@ -8,12 +8,15 @@
 
 #include <stdexcept>
 #include <cstdlib>
+#include <cmath>
+#include <random>
 
 #include <boost/range/algorithm/find_if.hpp>
 #include <seastar/core/align.hh>
 #include <seastar/core/bitops.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/coroutine.hh>
 
 #include "../compress.hh"
 #include "compress.hh"
@@ -252,23 +255,7 @@ local_compression::local_compression(compressor_ptr p)
 {}
 
 local_compression::local_compression(const compression& c)
-    : _compressor([&c] {
-        sstring n(c.name.value.begin(), c.name.value.end());
-        return compressor::create(n, [&c, &n](const sstring& key) -> compressor::opt_string {
-            if (key == compression_parameters::CHUNK_LENGTH_KB || key == compression_parameters::CHUNK_LENGTH_KB_ERR) {
-                return to_sstring(c.chunk_len / 1024);
-            }
-            if (key == compression_parameters::SSTABLE_COMPRESSION) {
-                return n;
-            }
-            for (auto& o : c.options.elements) {
-                if (key == sstring(o.key.value.begin(), o.key.value.end())) {
-                    return sstring(o.value.value.begin(), o.value.value.end());
-                }
-            }
-            return std::nullopt;
-        });
-    }())
+    : _compressor(c.get_compressor())
 {}
 
 size_t local_compression::uncompress(const char* input,
@@ -296,13 +283,57 @@ void compression::set_compressor(compressor_ptr c) {
         name.value = bytes(cn.begin(), cn.end());
         for (auto& [k, v] : c->options()) {
             if (k != compression_parameters::SSTABLE_COMPRESSION) {
-                options.elements.push_back({
-                    {bytes(k.begin(), k.end())},
-                    {bytes(v.begin(), v.end())}
-                });
+                auto key = bytes(k.begin(), k.end());
+                auto value = bytes(v.begin(), v.end());
+                auto it = std::ranges::find_if(options.elements, [&key] (const option& o) { return o.key.value == key; });
+                if (it != options.elements.end()) {
+                    it->value.value = std::move(value);
+                } else {
+                    options.elements.push_back({{std::move(key)}, {std::move(value)}});
+                }
             }
         }
     }
+    _compressor = std::move(c);
+}
+
+const compressor_ptr& compression::get_compressor() const {
+    if (!_compressor) {
+        sstring n(name.value.begin(), name.value.end());
+        _compressor = compressor::create(n, [this, &n](const sstring& key) -> compressor::opt_string {
+            if (key == compression_parameters::CHUNK_LENGTH_KB || key == compression_parameters::CHUNK_LENGTH_KB_ERR) {
+                return to_sstring(chunk_len / 1024);
+            }
+            if (key == compression_parameters::SSTABLE_COMPRESSION) {
+                return n;
+            }
+            for (auto& o : options.elements) {
+                if (key == sstring(o.key.value.begin(), o.key.value.end())) {
+                    return sstring(o.value.value.begin(), o.value.value.end());
+                }
+            }
+            return std::nullopt;
+        });
+    }
+    return _compressor;
+}
+
+uint32_t compression::max_compressed_chunk_length() const {
+    const auto key = bytes(compression_parameters::MIN_COMPRESS_RATIO.begin(), compression_parameters::MIN_COMPRESS_RATIO.end());
+    auto it = std::ranges::find_if(options.elements, [&key] (const option& o) { return o.key.value == key; });
+    if (it == options.elements.end()) {
+        return 0;
+    }
+    double ratio = 0;
+    try {
+        ratio = std::stod(sstring(it->value.value.begin(), it->value.value.end()));
+    } catch (...) {
+        throw sstables::malformed_sstable_exception(format("invalid {} in compression info", compression_parameters::MIN_COMPRESS_RATIO));
+    }
+    if (ratio < 1.0) {
+        return 0;
+    }
+    return std::ceil(chunk_len / ratio);
 }
 
 void compression::update(uint64_t compressed_file_length) {
@@ -344,13 +375,29 @@ class compressed_file_data_source_impl : public data_source_impl {
     uint64_t _pos;
     uint64_t _beg_pos;
     uint64_t _end_pos;
+    double _crc_check_chance;
+    // Whether some of the chunks may be stored uncompressed.
+    bool _may_have_raw_chunks;
+private:
+    // Verifying the checksum is a separate pass over the compressed chunk, which
+    // costs about as much as decompressing it, so like Cassandra we only verify
+    // a crc_check_chance fraction of the chunks we read.
+    bool should_verify_checksum() const {
+        if (_crc_check_chance >= 1.0) {
+            return true;
+        }
+        static thread_local std::default_random_engine random_engine{std::random_device{}()};
+        return std::uniform_real_distribution<double>(0.0, 1.0)(random_engine) < _crc_check_chance;
+    }
 public:
     compressed_file_data_source_impl(file f, sstables::compression* cm,
-                uint64_t pos, size_t len, file_input_stream_options options, reader_permit permit)
+                uint64_t pos, size_t len, file_input_stream_options options, reader_permit permit, double crc_check_chance)
             : _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_accessor())
             , _compression(*cm)
             , _permit(std::move(permit))
+            , _crc_check_chance(crc_check_chance)
+            , _may_have_raw_chunks(cm->max_compressed_chunk_length() != 0)
     {
         _beg_pos = pos;
         if (pos > _compression_metadata->uncompressed_file_length()) {
@@ -400,12 +447,12 @@ class compressed_file_data_source_impl : public data_source_impl {
                 // The last 4 bytes of the chunk are the adler32/crc32 checksum
                 // of the rest of the (compressed) chunk.
                 auto compressed_len = addr.chunk_len - 4;
-                // FIXME: Do not always calculate checksum - Cassandra has a
-                // probability (defaulting to 1.0, but still...)
-                auto expected_checksum = read_be<uint32_t>(buf.get() + compressed_len);
-                auto actual_checksum = ChecksumType::checksum(buf.get(), compressed_len);
-                if (expected_checksum != actual_checksum) {
-                    throw sstables::malformed_sstable_exception(format("compressed chunk of size {} at file offset {} failed checksum, expected={}, actual={}", addr.chunk_len, _underlying_pos, expected_checksum, actual_checksum));
+                if (should_verify_checksum()) {
+                    auto expected_checksum = read_be<uint32_t>(buf.get() + compressed_len);
+                    auto actual_checksum = ChecksumType::checksum(buf.get(), compressed_len);
+                    if (expected_checksum != actual_checksum) {
+                        throw sstables::malformed_sstable_exception(format("compressed chunk of size {} at file offset {} failed checksum, expected={}, actual={}", addr.chunk_len, _underlying_pos, expected_checksum, actual_checksum));
+                    }
                 }
 
                 // We know that the uncompressed data will take exactly
@@ -415,7 +462,16 @@ class compressed_file_data_source_impl : public data_source_impl {
                 // The compressed data is the whole chunk, minus the last 4
                 // bytes (which contain the checksum verified above).
 
-                auto len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+                size_t len;
+                const auto chunk_pos = _pos - addr.offset;
+                if (_may_have_raw_chunks
+                        && compressed_len == std::min<uint64_t>(_compression_metadata->uncompressed_chunk_length(), _compression_metadata->uncompressed_file_length() - chunk_pos)) {
+                    // Stored uncompressed
+                    std::copy_n(buf.get(), compressed_len, out.get_write());
+                    len = compressed_len;
+                } else {
+                    len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+                }
 
                 out.trim(len);
                 out.trim_front(addr.offset);
@@ -454,19 +510,19 @@ template <ChecksumUtils ChecksumType>
 class compressed_file_data_source : public data_source {
 public:
     compressed_file_data_source(file f, sstables::compression* cm,
-            uint64_t offset, size_t len, file_input_stream_options options, reader_permit permit)
+            uint64_t offset, size_t len, file_input_stream_options options, reader_permit permit, double crc_check_chance)
         : data_source(std::make_unique<compressed_file_data_source_impl<ChecksumType>>(
-                std::move(f), cm, offset, len, std::move(options), std::move(permit)))
+                std::move(f), cm, offset, len, std::move(options), std::move(permit), crc_check_chance))
         {}
 };
 
 template <ChecksumUtils ChecksumType>
 inline input_stream<char> make_compressed_file_input_stream(
         file f, sstables::compression *cm, uint64_t offset, size_t len,
-        file_input_stream_options options, reader_permit permit)
+        file_input_stream_options options, reader_permit permit, double crc_check_chance)
 {
     return input_stream<char>(compressed_file_data_source<ChecksumType>(
-            std::move(f), cm, offset, len, std::move(options), std::move(permit)));
+            std::move(f), cm, offset, len, std::move(options), std::move(permit), crc_check_chance));
 }
 
 // For SSTables 2.x (formats 'ka' and 'la'), the full checksum is a combination of checksums of compressed chunks.
@@ -489,26 +545,93 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     sstables::local_compression _compression;
     size_t _pos = 0;
     uint32_t _full_checksum;
+    // If the compressor wants a dictionary, the first chunks are held back
+    // until enough of them are collected to train one on, and only then
+    // compressed (with the dictionary) and written.
+    std::vector<temporary_buffer<char>> _samples;
+    size_t _samples_size = 0;
+    size_t _samples_target_size = 0;
+    // Chunks which compress to this size or more are stored uncompressed, 0 if none is.
+    uint32_t _max_compressed_len;
+    // After a run of incompressible chunks, the following chunks are stored
+    // uncompressed without trying to compress them first. The number of such
+    // chunks doubles with the length of the run, up to max_chunks_to_skip.
+    unsigned _incompressible_run = 0;
+    unsigned _chunks_to_skip = 0;
+    static constexpr unsigned max_chunks_to_skip = 63;
+
+    // zstd recommends training on ~100 times the size of the dictionary.
+    static constexpr size_t dictionary_samples_ratio = 100;
+
+    future<> train_dictionary_and_flush_samples() {
+        _samples_target_size = 0;
+        auto trained = co_await _compression.compressor()->with_trained_dictionary(_samples);
+        if (trained) {
+            _compression_metadata->set_compressor(trained);
+            _compression = sstables::local_compression(std::move(trained));
+        }
+        auto samples = std::exchange(_samples, {});
+        _samples_size = 0;
+        for (auto& sample : samples) {
+            co_await compress_and_write(std::move(sample));
+        }
+    }
 public:
-    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc, bool train_dictionary)
             : _out(std::move(out))
             , _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_writer())
             , _compression(lc)
             , _full_checksum(ChecksumType::init_checksum())
+            , _samples_target_size(train_dictionary && _compression.compressor() ? _compression.compressor()->dictionary_size() * dictionary_samples_ratio : 0)
+            , _max_compressed_len(_compression_metadata->max_compressed_chunk_length())
     {}
 
     virtual future<> put(net::packet data) override { abort(); }
     virtual future<> put(temporary_buffer<char> buf) override {
-        auto output_len = _compression.compress_max_size(buf.size());
+        if (_samples_target_size) {
+            _samples_size += buf.size();
+            _samples.push_back(std::move(buf));
+            if (_samples_size < _samples_target_size) {
+                return make_ready_future<>();
+            }
+            return train_dictionary_and_flush_samples();
+        }
+        return compress_and_write(std::move(buf));
+    }
+    temporary_buffer<char> make_raw_chunk(const temporary_buffer<char>& buf) {
+        // account space for checksum that goes after the data.
+        temporary_buffer<char> raw(buf.size() + 4);
+        std::copy_n(buf.get(), buf.size(), raw.get_write());
+        return raw;
+    }
+    future<> compress_and_write(temporary_buffer<char> buf) {
+        temporary_buffer<char> compressed;
+        size_t len;
+        if (_chunks_to_skip) {
+            --_chunks_to_skip;
+            compressed = make_raw_chunk(buf);
+            len = buf.size();
+        } else {
+            auto output_len = _compression.compress_max_size(buf.size());
 
-        // account space for checksum that goes after compressed data.
-        temporary_buffer<char> compressed(output_len + 4);
+            // account space for checksum that goes after compressed data.
+            compressed = temporary_buffer<char>(output_len + 4);
 
-        // compress flushed data.
-        auto len = _compression.compress(buf.get(), buf.size(), compressed.get_write(), output_len);
-        if (len > output_len) {
-            return make_exception_future(std::runtime_error("possible overflow during compression"));
+            // compress flushed data.
+            len = _compression.compress(buf.get(), buf.size(), compressed.get_write(), output_len);
+            if (len > output_len) {
+                return make_exception_future(std::runtime_error("possible overflow during compression"));
+            }
+            if (_max_compressed_len && (len >= _max_compressed_len || len >= buf.size())) {
+                // Not worth decompressing on every read, store it as is.
+                compressed = make_raw_chunk(buf);
+                len = buf.size();
+                _chunks_to_skip = std::min((1u << std::min(_incompressible_run, 6u)) - 1, max_chunks_to_skip);
+                ++_incompressible_run;
+            } else {
+                _incompressible_run = 0;
+            }
         }
 
         // total length of the uncompressed data.
@@ -540,7 +663,11 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         return f.then([compressed = std::move(compressed)] {});
     }
     virtual future<> close() override {
-        return _out.close();
+        if (_samples_target_size) {
+            // Less data than the sample size was written, train on all of it.
+            co_await train_dictionary_and_flush_samples();
+        }
+        co_await _out.close();
     }
 
     virtual size_t buffer_size() const noexcept override {
@@ -552,16 +679,17 @@ template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink : public data_sink {
 public:
-    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc, bool train_dictionary)
         : data_sink(std::make_unique<compressed_file_data_sink_impl<ChecksumType, mode>>(
-                std::move(out), cm, std::move(lc))) {}
+                std::move(out), cm, std::move(lc), train_dictionary)) {}
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 inline output_stream<char> make_compressed_file_output_stream(output_stream<char> out,
          sstables::compression* cm,
-         const compression_parameters& cp) {
+         const compression_parameters& cp,
+         sstables::compressed_output_stream_options opts) {
     // buffer of output stream is set to chunk length, because flush must
     // happen every time a chunk was filled up.
 
@@ -572,27 +700,33 @@ inline output_stream<char> make_compressed_file_output_stream(output_stream<char
     // probability to verify the checksum of a compressed chunk we read.
     // defaults to 1.0.
     cm->options.elements.push_back({{"crc_check_chance"}, {"1.0"}});
+    if (opts.raw_chunks && cp.min_compress_ratio() >= 1.0) {
+        auto ratio = to_sstring(cp.min_compress_ratio());
+        cm->options.elements.push_back({{bytes(compression_parameters::MIN_COMPRESS_RATIO.begin(), compression_parameters::MIN_COMPRESS_RATIO.end())},
+                {bytes(ratio.begin(), ratio.end())}});
+    }
 
-    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm, p));
+    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm, p, opts.train_dictionary));
 }
 
 input_stream<char> sstables::make_compressed_file_k_l_format_input_stream(file f,
         sstables::compression* cm, uint64_t offset, size_t len,
-        class file_input_stream_options options, reader_permit permit)
+        class file_input_stream_options options, reader_permit permit, double crc_check_chance)
 {
-    return make_compressed_file_input_stream<adler32_utils>(std::move(f), cm, offset, len, std::move(options), std::move(permit));
+    return make_compressed_file_input_stream<adler32_utils>(std::move(f), cm, offset, len, std::move(options), std::move(permit), crc_check_chance);
 }
 
 input_stream<char> sstables::make_compressed_file_m_format_input_stream(file f,
         sstables::compression *cm, uint64_t offset, size_t len,
-        class file_input_stream_options options, reader_permit permit) {
-    return make_compressed_file_input_stream<crc32_utils>(std::move(f), cm, offset, len, std::move(options), std::move(permit));
+        class file_input_stream_options options, reader_permit permit, double crc_check_chance) {
+    return make_compressed_file_input_stream<crc32_utils>(std::move(f), cm, offset, len, std::move(options), std::move(permit), crc_check_chance);
 }
 
 output_stream<char> sstables::make_compressed_file_m_format_output_stream(output_stream<char> out,
         sstables::compression* cm,
-        const compression_parameters& cp) {
+        const compression_parameters& cp,
+        compressed_output_stream_options opts) {
     return make_compressed_file_output_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(out), cm, cp);
+            std::move(out), cm, cp, opts);
 }
 
@@ -25,9 +25,12 @@
 // LZ4. Each compressor is an implementation of the "compressor" class.
 //
 // Each compressed chunk is followed by a 4-byte checksum of the compressed
-// data, using the Adler32 or CRC32 algorithm. In Cassandra, there is a parameter
+// data, using the Adler32 or CRC32 algorithm. With the min_compress_ratio
+// option, chunks which don't compress well enough are stored as they are
+// (followed by their checksum), see compression::max_compressed_chunk_length(). In Cassandra, there is a parameter
 // "crc_check_chance" (defaulting to 1.0) which determines the probability
-// of us verifying the checksum of each chunk we read.
+// of us verifying the checksum of each chunk we read. We honor the one in
+// the compression parameters of the table.
 //
 // This implementation does not cache the compressed disk blocks (which
 // are read using O_DIRECT), nor uncompressed data. We intend to cache high-
@@ -298,9 +301,16 @@ struct compression {
     // Variables *not* found in the "Compression Info" file (added by update()):
     uint64_t _compressed_file_length = 0;
     uint32_t _full_checksum = 0;
+    // Instantiated from name and options on first use and shared by all
+    // readers, since instantiating some compressors (e.g. ones digesting
+    // a dictionary) is expensive.
+    mutable compressor_ptr _compressor;
 public:
     // Set the compressor algorithm, please check the definition of enum compressor.
+    // May be called again with a compressor of the same algorithm, e.g. one which
+    // trained a dictionary, in which case its options replace the previous ones.
     void set_compressor(compressor_ptr c);
+    const compressor_ptr& get_compressor() const;
     // After changing _compression, update() must be called to update
     // additional variables depending on it.    
     void update(uint64_t compressed_file_length);
@@ -355,6 +365,13 @@ struct compression {
         _full_checksum = checksum;
     }
 
+    // Chunks whose compressed size would be at least max_compressed_chunk_length()
+    // are stored uncompressed, see compression_parameters::min_compress_ratio().
+    // A chunk is stored uncompressed iff its stored size (without the checksum)
+    // equals its uncompressed size: compressed chunks are always stored shorter.
+    // Returns 0 if all chunks are compressed.
+    uint32_t max_compressed_chunk_length() const;
+
     friend class sstable;
 };
 
@@ -366,17 +383,33 @@ compressor_ptr get_sstable_compressor(const compression&);
 // are open streams on it. This should happen naturally on a higher level -
 // as long as we have *sstables* work in progress, we need to keep the whole
 // sstable alive, and the compression metadata is only a part of it.
+//
+// crc_check_chance is the probability of verifying the checksum of a chunk.
 input_stream<char> make_compressed_file_k_l_format_input_stream(file f,
                 sstables::compression* cm, uint64_t offset, size_t len,
-                class file_input_stream_options options, reader_permit permit);
+                class file_input_stream_options options, reader_permit permit,
+                double crc_check_chance = 1.0);
 
 input_stream<char> make_compressed_file_m_format_input_stream(file f,
                 sstables::compression* cm, uint64_t offset, size_t len,
-                class file_input_stream_options options, reader_permit permit);
+                class file_input_stream_options options, reader_permit permit,
+                double crc_check_chance = 1.0);
+
+// Parts of the compressed format which older versions can't read, so they
+// have to be enabled explicitly.
+struct compressed_output_stream_options {
+    // If the compressor supports dictionaries, train one on the first chunks
+    // written and use it for all the chunks.
+    bool train_dictionary = false;
+    // Store the chunks which don't compress well enough uncompressed, see
+    // compression_parameters::min_compress_ratio().
+    bool raw_chunks = false;
+};
 
 output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
                 sstables::compression* cm,
-                const compression_parameters& cp);
+                const compression_parameters& cp,
+                compressed_output_stream_options opts = {});
 
 }
 
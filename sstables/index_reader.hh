@@ -12,6 +12,7 @@
 #include "downsampling.hh"
 #include "exceptions.hh"
 #include "sstables/partition_index_cache.hh"
+#include "sstables/binary_search.hh"
 #include <seastar/util/bool_class.hh>
 #include "tracing/traced_file.hh"
 #include "sstables/scanning_clustered_index_cursor.hh"
@@ -360,7 +361,8 @@ std::unique_ptr<clustered_index_cursor> promoted_index::make_cursor(shared_sstab
         return std::make_unique<mc::bsearch_clustered_cursor>(*sst->get_schema(),
             _promoted_index_start, _promoted_index_size,
             promoted_index_cache_metrics, permit,
-            *ck_values_fixed_lengths, cached_file_ptr, _num_blocks, trace_state);
+            *ck_values_fixed_lengths, cached_file_ptr, _num_blocks, trace_state,
+            caching ? sst->_promoted_index_block_cache.get() : nullptr);
     }
 
     auto file = make_tracked_index_file(*sst, permit, std::move(trace_state), caching);
@@ -662,8 +664,10 @@ class index_reader {
         }
 
         auto& summary = _sstable->get_summary();
-        bound.previous_summary_idx = std::distance(std::begin(summary.entries),
-            std::lower_bound(summary.entries.begin() + bound.previous_summary_idx, summary.entries.end(), pos, index_comparator(*_sstable->_schema)));
+        auto& stats = _sstable->manager().get_cache_tracker().get_partition_index_cache_stats();
+        ++stats.summary_lookups;
+        bound.previous_summary_idx = interpolation_lower_bound(summary.entries, bound.previous_summary_idx, summary.entries.size(),
+            pos, index_comparator(*_sstable->_schema), stats.summary_probes);
 
         if (bound.previous_summary_idx == 0) {
             sstlog.trace("index {}: first entry", fmt::ptr(this));
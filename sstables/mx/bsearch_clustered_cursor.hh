@@ -10,6 +10,7 @@
 
 #include "sstables/index_entry.hh"
 #include "sstables/column_translation.hh"
+#include "sstables/promoted_index_block_cache.hh"
 #include "parsers.hh"
 #include "schema/schema.hh"
 #include "utils/cached_file.hh"
@@ -144,6 +145,9 @@ class cached_promoted_index {
     //
     using block_set_type = std::set<promoted_index_block, block_comparator>;
     block_set_type _blocks;
+
+    // Block starts shared with other readers of the sstable, nullptr if caching is disabled.
+    promoted_index_block_cache* _shared_blocks;
 public:
     const schema& _s;
     uint64_t _promoted_index_start;
@@ -205,6 +209,7 @@ class cached_promoted_index {
             auto mem_before = block.memory_usage();
             block.start.emplace(_clustering_parser.get_and_reset());
             _metrics.used_bytes += block.memory_usage() - mem_before;
+            share_block_start(block);
         });
     }
 
@@ -221,9 +226,16 @@ class cached_promoted_index {
             block.data_file_offset = _block_parser.offset();
             block.width = _block_parser.width();
             _metrics.used_bytes += block.memory_usage() - mem_before;
+            share_block_start(block);
         });
     }
 
+    void share_block_start(const promoted_index_block& block) {
+        if (_shared_blocks) {
+            _shared_blocks->insert({_promoted_index_start, block.index}, block.offset, *block.start);
+        }
+    }
+
     /// \brief Returns a pointer to promoted_index_block entry which has at least offset and index fields valid.
     future<promoted_index_block*> get_block_only_offset(pi_index_type idx, tracing::trace_state_ptr trace_state) {
         auto i = _blocks.lower_bound(idx);
@@ -231,6 +243,17 @@ class cached_promoted_index {
             ++_metrics.hits_l0;
             return make_ready_future<promoted_index_block*>(const_cast<promoted_index_block*>(&*i));
         }
+        if (_shared_blocks) {
+            if (auto shared = _shared_blocks->get({_promoted_index_start, idx})) {
+                ++_metrics.hits_l0;
+                auto& block = const_cast<promoted_index_block&>(*_blocks.emplace_hint(i, idx, shared->offset));
+                block.start.emplace(std::move(shared->start));
+                _metrics.used_bytes += block.memory_usage();
+                ++_metrics.block_count;
+                ++_metrics.populations;
+                return make_ready_future<promoted_index_block*>(&block);
+            }
+        }
         ++_metrics.misses_l0;
         return read_block_offset(idx, trace_state).then([this, idx, hint = i] (pi_offset_type offset) {
             auto i = this->_blocks.emplace_hint(hint, idx, offset);
@@ -257,8 +280,10 @@ class cached_promoted_index {
             reader_permit permit,
             column_values_fixed_lengths cvfl,
             cached_file& f,
-            pi_index_type blocks_count)
+            pi_index_type blocks_count,
+            promoted_index_block_cache* shared_blocks = nullptr)
         : _blocks(block_comparator{s})
+        , _shared_blocks(shared_blocks)
         , _s(s)
         , _promoted_index_start(promoted_index_start)
         , _promoted_index_size(promoted_index_size)
@@ -444,7 +469,8 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
             column_values_fixed_lengths cvfl,
             seastar::shared_ptr<cached_file> f,
             pi_index_type blocks_count,
-            tracing::trace_state_ptr trace_state)
+            tracing::trace_state_ptr trace_state,
+            promoted_index_block_cache* shared_blocks = nullptr)
         : _s(s)
         , _blocks_count(blocks_count)
         , _cached_file(std::move(f))
@@ -455,7 +481,8 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
             std::move(permit),
             std::move(cvfl),
             *_cached_file,
-            blocks_count)
+            blocks_count,
+            shared_blocks)
         , _trace_state(std::move(trace_state))
     { }
 
@@ -57,6 +57,9 @@ class mp_row_consumer_m {
     schema_ptr _schema;
     const query::partition_slice& _slice;
     std::optional<mutation_fragment_filter> _mf_filter;
+    // The columns selected by the slice, when the values of the other ones
+    // can be dropped, see is_projected().
+    std::optional<column_set> _projection;
 
     bool _is_mutation_end = true;
     streamed_mutation::forwarding _fwd;
@@ -132,6 +135,10 @@ class mp_row_consumer_m {
         return on_range_tombstone_change(std::move(pos), right);
     }
 
+    bool is_projected(const column_definition& column_def) const {
+        return !_projection || _projection->test(column_def.ordinal_id);
+    }
+
     const column_definition& get_column_definition(std::optional<column_id> column_id) const {
         auto column_type = _inside_static_row ? column_kind::static_column : column_kind::regular_column;
         return _schema->column_at(column_type, *column_id);
@@ -219,6 +226,19 @@ class mp_row_consumer_m {
             && (!sst->has_scylla_component() || sst->features().is_enabled(sstable_feature::CorrectStaticCompact))) // See #4139
     {
         _cells.reserve(std::max(_schema->static_columns_count(), _schema->regular_columns_count()));
+        // The row cache is populated with what is read for the query, so it
+        // needs all the columns unless it is bypassed.
+        if (_slice.options.contains(query::partition_slice::option::skip_unselected_column_values)
+                && _slice.options.contains(query::partition_slice::option::bypass_cache)
+                && _slice.static_columns.size() + _slice.regular_columns.size() < _schema->static_columns_count() + _schema->regular_columns_count()) {
+            _projection.emplace(_schema->all_columns_count());
+            for (auto id : _slice.static_columns) {
+                _projection->set(_schema->static_column_at(id).ordinal_id);
+            }
+            for (auto id : _slice.regular_columns) {
+                _projection->set(_schema->regular_column_at(id).ordinal_id);
+            }
+        }
     }
 
     mp_row_consumer_m(mp_row_consumer_reader_mx* reader,
@@ -405,6 +425,11 @@ class mp_row_consumer_m {
             return data_consumer::proceed::yes;
         }
         check_schema_mismatch(column_info, column_def);
+        if (!is_projected(column_def)) {
+            // The cell is still needed for the liveness of the row, and to be
+            // reconciled with the cells of other sources, but its value is not.
+            value = fragmented_temporary_buffer::view();
+        }
         if (column_def.is_multi_cell()) {
             auto& value_type = visit(*column_def.type, make_visitor(
                 [] (const collection_type_impl& ctype) -> const abstract_type& { return *ctype.value_comparator(); },
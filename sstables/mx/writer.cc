@@ -599,8 +599,11 @@ class writer : public sstable_writer::writer_impl {
     large_data_stats_entry _row_size_entry;
     large_data_stats_entry _cell_size_entry;
     large_data_stats_entry _elements_in_collection_entry;
+    // Indexed by ordinal_column_id, see sstable_writer_config::column_value_ranges.
+    std::vector<std::optional<std::pair<bytes, bytes>>> _column_value_ranges;
 
     void init_file_writers();
+    void maybe_record_column_value(const column_definition& cdef, atomic_cell_view cell);
 
     // Returns the closed writer
     std::unique_ptr<file_writer> close_writer(std::unique_ptr<file_writer>& w);
@@ -803,10 +806,14 @@ class writer : public sstable_writer::writer_impl {
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format,
+                _cfg.blocked_bloom_filters ? _schema.bloom_filter_layout() : utils::filter_layout::classic);
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
+        if (_cfg.column_value_ranges) {
+            _column_value_ranges.resize(_schema.all_columns_count());
+        }
         prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
     }
 
@@ -882,7 +889,11 @@ void writer::maybe_add_pi_block() {
 }
 
 void writer::init_file_writers() {
-    auto out = _sst._storage->make_data_or_index_sink(_sst, component_type::Data).get();
+    std::optional<uint64_t> data_size_hint;
+    if (_cfg.max_sstable_size != std::numeric_limits<uint64_t>::max()) {
+        data_size_hint = _cfg.max_sstable_size;
+    }
+    auto out = _sst._storage->make_data_or_index_sink(_sst, component_type::Data, data_size_hint).get();
 
     if (!_compression_enabled) {
         _data_writer = std::make_unique<crc32_checksummed_file_writer>(std::move(out), _sst.sstable_buffer_size, _sst.filename(component_type::Data));
@@ -891,10 +902,14 @@ void writer::init_file_writers() {
             make_compressed_file_m_format_output_stream(
                 output_stream<char>(std::move(out)),
                 &_sst._components->compression,
-                _schema.get_compressor_params()), _sst.filename(component_type::Data));
+                _cfg.compression ? *_cfg.compression : _schema.get_compressor_params(),
+                compressed_output_stream_options{
+                    .train_dictionary = _cfg.compression_dictionaries,
+                    .raw_chunks = _cfg.raw_compressed_chunks,
+                }), _sst.filename(component_type::Data));
     }
 
-    out = _sst._storage->make_data_or_index_sink(_sst, component_type::Index).get();
+    out = _sst._storage->make_data_or_index_sink(_sst, component_type::Index, std::nullopt).get();
     _index_writer = std::make_unique<file_writer>(output_stream<char>(std::move(out)), _sst.filename(component_type::Index));
 }
 
@@ -1010,6 +1025,23 @@ void writer::maybe_record_large_cells(const sstables::sstable& sst, const sstabl
     };
 }
 
+// Only the values of fixed-size types are recorded, so that the
+// ranges don't grow with the size of the values.
+void writer::maybe_record_column_value(const column_definition& cdef, atomic_cell_view cell) {
+    if (cdef.is_counter() || !cdef.type->value_length_if_fixed()) {
+        return;
+    }
+    auto value = cell.value();
+    auto& range = _column_value_ranges[static_cast<column_count_type>(cdef.ordinal_id)];
+    if (!range) {
+        range.emplace(to_bytes(value), to_bytes(value));
+    } else if (cdef.type->compare(value, range->first) < 0) {
+        range->first = to_bytes(value);
+    } else if (cdef.type->compare(value, range->second) > 0) {
+        range->second = to_bytes(value);
+    }
+}
+
 void writer::write_cell(bytes_ostream& writer, const clustering_key_prefix* clustering_key, atomic_cell_view cell,
          const column_definition& cdef, const row_time_properties& properties, std::optional<bytes_view> cell_path) {
 
@@ -1077,6 +1109,9 @@ void writer::write_cell(bytes_ostream& writer, const clustering_key_prefix* clus
     if (cdef.is_atomic()) {
         uint64_t size = writer.size() - current_pos;
         maybe_record_large_cells(_sst, *_partition_key, clustering_key, cdef, size, 0);
+        if (has_value && !_column_value_ranges.empty()) {
+            maybe_record_column_value(cdef, cell);
+        }
     }
 
     _c_stats.update_timestamp(cell.timestamp());
@@ -1482,7 +1517,17 @@ void writer::consume_end_of_stream() {
             { large_data_type::elements_in_collection, std::move(_elements_in_collection_entry) },
         }
     });
-    _sst.write_scylla_metadata(_shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin);
+    std::optional<scylla_metadata::column_value_ranges> cv_ranges;
+    if (!_column_value_ranges.empty()) {
+        cv_ranges.emplace();
+        for (const auto& cdef : _schema.all_columns()) {
+            if (auto& range = _column_value_ranges[static_cast<column_count_type>(cdef.ordinal_id)]) {
+                cv_ranges->map.emplace(disk_string<uint32_t>{cdef.name()},
+                        column_value_range{disk_string<uint32_t>{std::move(range->first)}, disk_string<uint32_t>{std::move(range->second)}});
+            }
+        }
+    }
+    _sst.write_scylla_metadata(_shard, std::move(features), std::move(identifier), std::move(ld_stats), std::move(cv_ranges), _cfg.origin);
     _sst.seal_sstable(_cfg.backup).get();
 }
 
@@ -76,6 +76,10 @@ struct sstable_open_config {
     // filter, meaning that the SSTable will be opened on every single-partition
     // read.
     bool load_bloom_filter = true;
+    // Don't read the bloom filter of unshared SSTables while loading them,
+    // the sstables manager loads it in the background instead. Until then,
+    // the SSTable uses an always-present filter.
+    bool defer_bloom_filter_loading = false;
     // Mimics behavior when a SSTable is streamed to a given shard, where SSTable
     // writer considers the shard that created the SSTable as its owner.
     bool current_shard_as_sstable_owner = false;
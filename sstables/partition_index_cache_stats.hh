@@ -17,4 +17,15 @@ struct partition_index_cache_stats {
     uint64_t evictions = 0; // Number of times entry was evicted
     uint64_t populations = 0; // Number of times entry was inserted
     uint64_t used_bytes = 0; // Number of bytes entries occupy in memory
+    uint64_t summary_lookups = 0; // Number of lookups of a partition position in the summary
+    uint64_t summary_probes = 0; // Number of summary entries compared during those lookups
+};
+
+struct promoted_index_block_cache_stats {
+    uint64_t hits = 0; // Number of lookups which found the block start cached
+    uint64_t misses = 0; // Number of lookups which didn't find the block start cached
+    uint64_t evictions = 0; // Number of block starts which got evicted
+    uint64_t populations = 0; // Number of block starts which got inserted
+    uint64_t block_count = 0; // Number of block starts currently cached
+    uint64_t used_bytes = 0; // Number of bytes cached block starts occupy in memory
 };
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include "mutation/position_in_partition.hh"
+#include "utils/bptree.hh"
+#include "utils/lru.hh"
+#include "utils/logalloc.hh"
+#include "sstables/partition_index_cache_stats.hh"
+
+namespace sstables {
+
+// Cache of parsed starts of promoted index blocks of an sstable, shared by all readers.
+//
+// Binary search over the promoted index of a wide partition only needs the start
+// position of the probed blocks. cached_file keeps the pages of the index file around,
+// but each reader still has to look up the block offset and parse the clustering
+// prefix of every probed block, which dominates the cost of point reads
+// into wide partitions once the index is in memory. This cache keeps the result
+// of that work so that concurrent and subsequent readers of the same partition can
+// skip it.
+//
+// Entries are allocated in the LSA region of the cache tracker and are always linked
+// in its LRU, they can be evicted at any time. Lookups copy the entry out,
+// so no references to entries are handed out.
+//
+// The instance must be destroyed only after all lookups are done.
+class promoted_index_block_cache {
+public:
+    struct key_type {
+        uint64_t promoted_index_start; // Position of the promoted index in the index file, identifies the partition
+        uint32_t block; // Sequence number of the block in the promoted index
+
+        auto operator<=>(const key_type&) const = default;
+    };
+
+    struct key_less_comparator {
+        bool operator()(const key_type& lhs, const key_type& rhs) const noexcept {
+            return lhs < rhs;
+        }
+    };
+
+    struct block_start {
+        uint32_t offset; // Offset of the block relative to the start of the promoted index
+        position_in_partition start;
+    };
+private:
+    // Allocated inside LSA
+    class entry final : public index_evictable {
+    public:
+        promoted_index_block_cache* _parent;
+        key_type _key;
+        uint32_t _offset;
+        position_in_partition _start;
+        size_t _size_in_allocator = 0;
+    public:
+        entry(promoted_index_block_cache* parent, key_type key, uint32_t offset, position_in_partition_view start)
+                : _parent(parent)
+                , _key(key)
+                , _offset(offset)
+                , _start(start)
+                , _size_in_allocator(sizeof(entry) + _start.external_memory_usage())
+        { }
+
+        entry(entry&&) noexcept = default;
+
+        void on_evicted() noexcept override;
+
+        size_t size_in_allocator() const { return _size_in_allocator; }
+    };
+
+    using cache_type = bplus::tree<key_type, entry, key_less_comparator, 8, bplus::key_search::linear>;
+    cache_type _cache;
+    logalloc::region& _region;
+    logalloc::allocating_section _as;
+    lru& _lru;
+    promoted_index_block_cache_stats& _stats;
+private:
+    void on_evicted(entry& e) noexcept {
+        _stats.used_bytes -= e.size_in_allocator();
+        --_stats.block_count;
+        ++_stats.evictions;
+    }
+public:
+    promoted_index_block_cache(lru& lru_, logalloc::region& r, promoted_index_block_cache_stats& stats)
+            : _cache(key_less_comparator())
+            , _region(r)
+            , _lru(lru_)
+            , _stats(stats)
+    { }
+
+    ~promoted_index_block_cache() {
+        with_allocator(_region.allocator(), [&] {
+            _cache.clear_and_dispose([this] (entry* e) noexcept {
+                _lru.remove(*e);
+                on_evicted(*e);
+            });
+        });
+    }
+
+    promoted_index_block_cache(promoted_index_block_cache&&) = delete;
+    promoted_index_block_cache(const promoted_index_block_cache&) = delete;
+
+    // Returns a copy of the cached start of the block, allocated in the standard allocator.
+    std::optional<block_start> get(key_type key) {
+        return _as(_region, [&] () -> std::optional<block_start> {
+            auto i = _cache.lower_bound(key);
+            if (i == _cache.end() || i->_key != key) {
+                ++_stats.misses;
+                return std::nullopt;
+            }
+            ++_stats.hits;
+            _lru.touch(*i);
+            return block_start{i->_offset, i->_start};
+        });
+    }
+
+    // Caches the start of the block. Does nothing if it is already cached.
+    void insert(key_type key, uint32_t offset, position_in_partition_view start) {
+        _as(_region, [&] {
+            with_allocator(_region.allocator(), [&] {
+                auto [i, inserted] = _cache.emplace(key, this, key, offset, start);
+                if (inserted) {
+                    _lru.add(*i);
+                    _stats.used_bytes += i->size_in_allocator();
+                    ++_stats.block_count;
+                    ++_stats.populations;
+                }
+            });
+        });
+    }
+
+    // Evicts all entries.
+    future<> evict_gently() {
+        while (!_cache.empty()) {
+            with_allocator(_region.allocator(), [&] {
+                auto i = _cache.begin();
+                while (i != _cache.end()) {
+                    _lru.remove(*i);
+                    on_evicted(*i);
+                    i = i.erase(key_less_comparator());
+                    if (need_preempt()) {
+                        break;
+                    }
+                }
+            });
+            co_await coroutine::maybe_yield();
+        }
+    }
+};
+
+inline
+void promoted_index_block_cache::entry::on_evicted() noexcept {
+    _parent->on_evicted(*this);
+    cache_type::iterator it(this);
+    it.erase(key_less_comparator());
+}
+
+}
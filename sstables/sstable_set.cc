@@ -18,6 +18,7 @@
 #include "dht/ring_position.hh"
 #include "compaction/compaction_strategy_impl.hh"
 #include "compaction/leveled_compaction_strategy.hh"
+#include "compaction/incremental_compaction_strategy.hh"
 #include "compaction/time_window_compaction_strategy.hh"
 
 #include "sstable_set_impl.hh"
@@ -756,6 +757,12 @@ std::unique_ptr<sstable_set_impl> leveled_compaction_strategy::make_sstable_set(
     return std::make_unique<partitioned_sstable_set>(std::move(schema));
 }
 
+std::unique_ptr<sstable_set_impl> incremental_compaction_strategy::make_sstable_set(schema_ptr schema) const {
+    // Fragments of a run are disjoint, so all of them go to the interval map,
+    // no matter their level.
+    return std::make_unique<partitioned_sstable_set>(std::move(schema));
+}
+
 std::unique_ptr<sstable_set_impl> time_window_compaction_strategy::make_sstable_set(schema_ptr schema) const {
     return std::make_unique<time_series_sstable_set>(std::move(schema), _options.enable_optimized_twcs_queries);
 }
@@ -862,43 +869,64 @@ class incremental_reader_selector : public reader_selector {
 //
 // Assumes the given `pos` and `schema` are alive during the function's lifetime.
 static std::predicate<const sstable&> auto
-make_pk_filter(const dht::ring_position& pos, const schema& schema) {
-    return [&pos, key = utils::make_hashed_key(static_cast<bytes_view>(key::from_partition_key(schema, *pos.key()))), cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
+make_pk_filter(const dht::ring_position& pos, const schema& schema, utils::hashed_key key) {
+    return [&pos, key, cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
         return cmp(pos, sst.get_first_decorated_key()) >= 0 &&
                cmp(pos, sst.get_last_decorated_key()) <= 0 &&
                sst.filter_has_key(key);
     };
 }
 
+static std::predicate<const sstable&> auto
+make_pk_filter(const dht::ring_position& pos, const schema& schema) {
+    return make_pk_filter(pos, schema, sstable::make_hashed_key(schema, *pos.key()));
+}
+
 const sstable_predicate& default_sstable_predicate() {
     static const sstable_predicate predicate = [] (const sstable&) { return true; };
     return predicate;
 }
 
 static std::predicate<const sstable&> auto
-make_sstable_filter(const dht::ring_position& pos, const schema& schema, const sstable_predicate& predicate) {
-    return [pk_filter = make_pk_filter(pos, schema), &predicate] (const sstable& sst) {
+make_sstable_filter(const dht::ring_position& pos, const schema& schema, const sstable_predicate& predicate, utils::hashed_key key) {
+    return [pk_filter = make_pk_filter(pos, schema, key), &predicate] (const sstable& sst) {
         return predicate(sst) && pk_filter(sst);
     };
 }
 
+static std::predicate<const sstable&> auto
+make_sstable_filter(const dht::ring_position& pos, const schema& schema, const sstable_predicate& predicate) {
+    return make_sstable_filter(pos, schema, predicate, sstable::make_hashed_key(schema, *pos.key()));
+}
+
 // Filter out sstables for reader using bloom filter and supplied predicate
 static std::vector<shared_sstable>
 filter_sstable_for_reader(std::vector<shared_sstable>&& sstables, const schema& schema, const dht::ring_position& pos, const sstable_predicate& predicate) {
-    auto filter = [_filter = make_sstable_filter(pos, schema, predicate)] (const shared_sstable& sst) { return !_filter(*sst); };
+    auto key = sstable::make_hashed_key(schema, *pos.key());
+    // Each filter check is a few dependent cache misses. Start loading the
+    // relevant parts of all the filters before checking any of them, so
+    // that the misses of the different sstables overlap.
+    for (const auto& sst : sstables) {
+        sst->filter_prefetch(key);
+    }
+    auto filter = [_filter = make_sstable_filter(pos, schema, predicate, key)] (const shared_sstable& sst) { return !_filter(*sst); };
     sstables.erase(boost::remove_if(sstables, filter), sstables.end());
     return std::move(sstables);
 }
 
+// No clustering filtering is applied if schema defines no clustering key or
+// compaction strategy thinks it will not benefit from such an optimization,
+// or the partition_slice includes static columns.
+static bool use_clustering_key_filter(const replica::column_family& cf, const schema& schema, const query::partition_slice& slice) {
+    return schema.clustering_key_size() && cf.get_compaction_strategy().use_clustering_key_filter() && !slice.static_columns.size();
+}
+
 // Filter out sstables for reader using sstable metadata that keeps track
 // of a range for each clustering component.
 static std::vector<shared_sstable>
 filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica::column_family& cf, const schema_ptr& schema,
         const query::partition_slice& slice) {
-    // no clustering filtering is applied if schema defines no clustering key or
-    // compaction strategy thinks it will not benefit from such an optimization,
-    // or the partition_slice includes static columns.
-    if (!schema->clustering_key_size() || !cf.get_compaction_strategy().use_clustering_key_filter() || slice.static_columns.size()) {
+    if (!use_clustering_key_filter(cf, *schema, slice)) {
         return std::move(sstables);
     }
 
@@ -924,6 +952,33 @@ filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica:
     return std::move(sstables);
 }
 
+// Multi-partition counterpart of filter_sstable_for_reader_by_ck(). The filter
+// is applied lazily, as the sstables are selected for reading, so sstables which
+// cannot contain rows of the slice are never opened.
+// Returns std::nullopt if no clustering filtering applies.
+static std::optional<std::function<bool(const sstable&)>>
+make_clustering_key_filter(replica::column_family* cf, const schema& schema, const query::partition_slice& slice) {
+    // Reversed reads are not filtered, the ranges of their slices are relative
+    // to the reversed schema.
+    if (!cf || slice.is_reversed() || !use_clustering_key_filter(*cf, schema, slice)) {
+        return std::nullopt;
+    }
+    auto ranges = slice.get_all_ranges();
+    if (ranges.size() == 1 && ranges[0].is_full()) {
+        return std::nullopt;
+    }
+    replica::cf_stats* stats = cf->cf_stats();
+    stats->clustering_filter_count++;
+    return [stats, ranges = std::move(ranges)] (const sstable& sst) {
+        stats->sstables_checked_by_clustering_filter++;
+        if (!sst.may_contain_rows(ranges)) {
+            return false;
+        }
+        stats->surviving_sstables_after_clustering_filter++;
+        return true;
+    };
+}
+
 std::vector<frozen_sstable_run>
 sstable_set_impl::all_sstable_runs() const {
     throw_with_backtrace<std::bad_function_call>();
@@ -1364,12 +1419,14 @@ sstable_set::make_local_shard_sstable_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor_generator& monitor_generator,
-        const sstable_predicate& predicate) const
+        const sstable_predicate& predicate,
+        replica::column_family* cf) const
 {
-    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate]
+    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate,
+            ck_filter = make_clustering_key_filter(cf, *s, slice)]
             (shared_sstable& sst, const dht::partition_range& pr) mutable {
         assert(!sst->is_shared());
-        if (!predicate(*sst)) {
+        if (!predicate(*sst) || (ck_filter && !(*ck_filter)(*sst))) {
             return make_empty_flat_reader_v2(s, permit);
         }
         auto reader = sst->make_reader(s, permit, pr, slice, trace_state, fwd, fwd_mr, monitor_generator(sst));
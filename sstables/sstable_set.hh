@@ -230,6 +230,9 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         read_monitor_generator& rmg = default_read_monitor_generator()) const;
 
     // Filters out mutations that don't belong to the current shard.
+    // If the table is given, sstables which cannot contain rows in the clustering
+    // ranges of the slice are skipped, if the table's compaction strategy asks for
+    // clustering key filtering.
     flat_mutation_reader_v2 make_local_shard_sstable_reader(
         schema_ptr,
         reader_permit,
@@ -239,7 +242,8 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         streamed_mutation::forwarding,
         mutation_reader::forwarding,
         read_monitor_generator& rmg = default_read_monitor_generator(),
-        const sstable_predicate& p = default_sstable_predicate()) const;
+        const sstable_predicate& p = default_sstable_predicate(),
+        replica::column_family* cf = nullptr) const;
 
     flat_mutation_reader_v2 make_crawling_reader(
             schema_ptr,
@@ -63,6 +63,7 @@
 #include "checked-file-impl.hh"
 #include "db/extensions.hh"
 #include "sstables/partition_index_cache.hh"
+#include "sstables/promoted_index_block_cache.hh"
 #include "db/large_data_handler.hh"
 #include "db/config.hh"
 #include "sstables/random_access_reader.hh"
@@ -467,6 +468,9 @@ void write(sstable_version_types v, file_writer& out, const disk_set_of_tagged_u
     }
 }
 
+// Maximum number of bytes of summary entries read at once.
+static constexpr size_t summary_read_batch_size = 128 * 1024;
+
 future<> parse(const schema& schema, sstable_version_types v, random_access_reader& in, summary& s) {
     using pos_type = typename decltype(summary::positions)::value_type;
 
@@ -501,23 +505,35 @@ future<> parse(const schema& schema, sstable_version_types v, random_access_read
 
     s.entries.reserve(s.header.size);
 
-    int idx = 0;
-    while (s.entries.size() != s.header.size) {
-        auto pos = s.positions[idx++];
-        auto next = s.positions[idx];
+    // Entries are contiguous, so they are read in batches rather than one
+    // by one, which dominates the cost of opening sstables with big summaries.
+    size_t idx = 0;
+    while (idx != s.header.size) {
+        auto first = idx;
+        auto start = s.positions[first];
+        do {
+            if (s.positions[idx + 1] < s.positions[idx] + sizeof(uint64_t)) {
+                throw malformed_sstable_exception(seastar::format("Invalid summary entry {} at position {}, next entry at position {}",
+                        idx, s.positions[idx], s.positions[idx + 1]));
+            }
+            ++idx;
+        } while (idx != s.header.size && s.positions[idx + 1] - start <= summary_read_batch_size);
 
-        auto entrysize = next - pos;
-        auto buf = co_await in.read_exactly(entrysize);
-        check_buf_size(buf, entrysize);
+        auto len = s.positions[idx] - start;
+        auto buf = co_await in.read_exactly(len);
+        check_buf_size(buf, len);
 
-        auto keysize = entrysize - 8;
-        auto key_data = s.add_summary_data(bytes_view(reinterpret_cast<const int8_t*>(buf.get()), keysize));
-        buf.trim_front(keysize);
+        for (auto i = first; i != idx; ++i) {
+            auto entry = buf.get() + (s.positions[i] - start);
+            auto keysize = s.positions[i + 1] - s.positions[i] - sizeof(uint64_t);
+            auto key_data = s.add_summary_data(bytes_view(reinterpret_cast<const int8_t*>(entry), keysize));
 
-        // position is little-endian encoded
-        auto position = seastar::read_le<uint64_t>(buf.get());
-        auto token = schema.get_partitioner().get_token(key_view(key_data));
-        s.entries.push_back(summary_entry{ token, key_data, position });
+            // position is little-endian encoded
+            auto position = seastar::read_le<uint64_t>(entry + keysize);
+            auto token = schema.get_partitioner().get_token(key_view(key_data));
+            s.entries.push_back(summary_entry{ token, key_data, position });
+        }
+        co_await coroutine::maybe_yield();
     }
     // Delete last element which isn't part of the on-disk format.
     s.positions.pop_back();
@@ -1332,6 +1348,9 @@ future<> sstable::open_data(sstable_open_config cfg) noexcept {
 
     _total_reclaimable_memory.reset();
     _manager.increment_total_reclaimable_memory_and_maybe_reclaim(this);
+    if (_filter_load_deferred) {
+        _manager.defer_components_loading(this);
+    }
 }
 
 future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
@@ -1374,6 +1393,7 @@ future<> sstable::create_data() noexcept {
 future<> sstable::drop_caches() {
     co_await _cached_index_file->evict_gently();
     co_await _index_cache->evict_gently();
+    co_await _promoted_index_block_cache->evict_gently();
 }
 
 future<> sstable::read_filter(sstable_open_config cfg) {
@@ -1390,7 +1410,17 @@ future<> sstable::read_filter(sstable_open_config cfg) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        auto layout = _components->scylla_metadata ? _components->scylla_metadata->get_bloom_filter_layout() : bloom_filter_layout::classic;
+        switch (layout) {
+        case bloom_filter_layout::classic:
+            _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+            break;
+        case bloom_filter_layout::blocked:
+            _components->filter = utils::filter::create_blocked_filter(filter.hashes, std::move(bs), format);
+            break;
+        default:
+            throw malformed_sstable_exception(seastar::format("Unknown bloom filter layout {}", fmt::underlying(layout)), filename(component_type::Filter));
+        }
     });
 }
 
@@ -1399,7 +1429,7 @@ void sstable::write_filter() {
         return;
     }
 
-    auto f = static_cast<utils::filter::murmur3_bloom_filter *>(_components->filter.get());
+    auto f = static_cast<utils::filter::bloom_filter *>(_components->filter.get());
 
     auto&& bs = f->bits();
     auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
@@ -1451,8 +1481,13 @@ future<> sstable::reload_reclaimed_components() {
 
     co_await read_filter();
     _total_reclaimable_memory.reset();
-    _total_memory_reclaimed -= _components->filter->memory_size();
-    sstlog.info("Reloaded bloom filter of {}", get_filename());
+    // The bloom filter is the only reclaimable component
+    _total_memory_reclaimed = 0;
+    if (std::exchange(_filter_load_deferred, false)) {
+        sstlog.debug("Loaded deferred bloom filter of {}", get_filename());
+    } else {
+        sstlog.info("Reloaded bloom filter of {}", get_filename());
+    }
 }
 
 future<> sstable::load_metadata(sstable_open_config cfg, bool validate) noexcept {
@@ -1477,12 +1512,29 @@ future<> sstable::load_metadata(sstable_open_config cfg, bool validate) noexcept
 // This interface is only used during tests, snapshot loading and early initialization.
 // No need to set tunable priorities for it.
 future<> sstable::load(const dht::sharder& sharder, sstable_open_config cfg) noexcept {
-    co_await load_metadata(cfg, true);
+    auto metadata_cfg = cfg;
+    metadata_cfg.load_bloom_filter = cfg.load_bloom_filter && !cfg.defer_bloom_filter_loading;
+    co_await load_metadata(metadata_cfg, true);
+    const bool defer_filter = cfg.defer_bloom_filter_loading && cfg.load_bloom_filter && has_component(component_type::Filter);
     if (_shards.empty()) {
         set_first_and_last_keys();
         _shards = cfg.current_shard_as_sstable_owner ?
                 std::vector<unsigned>{this_shard_id()} : compute_shards_for_this_sstable(sharder);
     }
+    if (defer_filter) {
+        if (_shards.size() == 1) {
+            // The size of the filter on disk is a close estimate of its size in memory,
+            // the sstables manager uses it to decide when it can be loaded.
+            auto f = co_await open_file(component_type::Filter, open_flags::ro);
+            auto size = co_await f.size().finally([&f] { return f.close(); });
+            _total_memory_reclaimed = std::max<size_t>(size, 1);
+            _filter_load_deferred = true;
+        } else {
+            // Shared sstables hand their components over to other shards, load it now
+            metadata_cfg.load_bloom_filter = true;
+            co_await read_filter(metadata_cfg);
+        }
+    }
     co_await open_data(cfg);
 }
 
@@ -1717,7 +1769,7 @@ sstable::read_scylla_metadata() noexcept {
 
 void
 sstable::write_scylla_metadata(shard_id shard, sstable_enabled_features features, struct run_identifier identifier,
-        std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin) {
+        std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::column_value_ranges> cv_ranges, sstring origin) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
 
@@ -1739,6 +1791,9 @@ sstable::write_scylla_metadata(shard_id shard, sstable_enabled_features features
     if (ld_stats) {
         _components->scylla_metadata->data.set<scylla_metadata_type::LargeDataStats>(std::move(*ld_stats));
     }
+    if (cv_ranges) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::ColumnValueRanges>(std::move(*cv_ranges));
+    }
     if (!origin.empty()) {
         scylla_metadata::sstable_origin o;
         o.value = bytes(to_bytes_view(sstring_view(origin)));
@@ -1751,6 +1806,12 @@ sstable::write_scylla_metadata(shard_id shard, sstable_enabled_features features
     scylla_metadata::scylla_build_id build_id;
     build_id.value = bytes(to_bytes_view(sstring_view(get_build_id())));
     _components->scylla_metadata->data.set<scylla_metadata_type::ScyllaBuildId>(std::move(build_id));
+    if (has_component(component_type::Filter)) {
+        auto f = static_cast<const utils::filter::bloom_filter*>(_components->filter.get());
+        if (f->layout() == utils::filter_layout::blocked) {
+            _components->scylla_metadata->data.set<scylla_metadata_type::BloomFilterLayout>(bloom_filter_layout_metadata{bloom_filter_layout::blocked});
+        }
+    }
 
     write_simple<component_type::Scylla>(*_components->scylla_metadata);
 }
@@ -2139,8 +2200,8 @@ std::vector<std::pair<component_type, sstring>> sstable::all_components() const
     return all;
 }
 
-future<> sstable::snapshot(const sstring& dir) const {
-    return _storage->snapshot(*this, dir, storage::absolute_path::yes);
+future<> sstable::snapshot(const sstring& dir, storage::sync_dir sync) const {
+    return _storage->snapshot(*this, dir, storage::absolute_path::yes, {}, sync);
 }
 
 future<> sstable::change_state(sstable_state to, delayed_commit_changes* delay_commit) {
@@ -2327,12 +2388,13 @@ input_stream<char> sstable::data_stream(uint64_t pos, size_t len,
 
     input_stream<char> stream;
     if (_components->compression && raw == raw_stream::no) {
+        auto crc_check_chance = _schema->get_compressor_params().crc_check_chance();
         if (_version >= sstable_version_types::mc) {
              return make_compressed_file_m_format_input_stream(f, &_components->compression,
-                pos, len, std::move(options), permit);
+                pos, len, std::move(options), permit, crc_check_chance);
         } else {
             return make_compressed_file_k_l_format_input_stream(f, &_components->compression,
-                pos, len, std::move(options), permit);
+                pos, len, std::move(options), permit, crc_check_chance);
         }
     }
 
@@ -2634,6 +2696,32 @@ future<> sstable::mutate_sstable_level(uint32_t new_level) {
     });
 }
 
+future<> sstable::mutate_repaired_at(uint64_t repaired_at) {
+    if (!has_component(component_type::Statistics)) {
+        co_return;
+    }
+
+    auto entry = _components->statistics.contents.find(metadata_type::Stats);
+    if (entry == _components->statistics.contents.end()) {
+        co_return;
+    }
+
+    auto& p = entry->second;
+    if (!p) {
+        throw std::runtime_error("Statistics is malformed");
+    }
+    stats_metadata& s = *static_cast<stats_metadata *>(p.get());
+    if (s.repaired_at == repaired_at) {
+        co_return;
+    }
+
+    sstlog.debug("set repaired_at of {} from {} to {}", get_filename(), s.repaired_at, repaired_at);
+    s.repaired_at = repaired_at;
+    co_await seastar::async([this] {
+        rewrite_statistics();
+    });
+}
+
 int sstable::compare_by_max_timestamp(const sstable& other) const {
     auto ts1 = get_stats_metadata().max_timestamp;
     auto ts2 = other.get_stats_metadata().max_timestamp;
@@ -2851,6 +2939,14 @@ sstable::compute_shards_for_this_sstable(const dht::sharder& sharder_) const {
     return boost::copy_range<std::vector<unsigned>>(shards);
 }
 
+bool sstable::has_cached_index_page(dht::ring_position_view pos) const {
+    auto& summary = get_summary();
+    uint64_t probes = 0;
+    // Same lookup as index_reader::advance_to().
+    auto idx = interpolation_lower_bound(summary.entries, 0, summary.entries.size(), pos, index_comparator(*_schema), probes);
+    return _index_cache->contains(idx ? idx - 1 : 0);
+}
+
 future<bool> sstable::has_partition_key(const utils::hashed_key& hk, const dht::decorated_key& dk) {
     shared_sstable s = shared_from_this();
     if (!filter_has_key(hk)) {
@@ -2937,10 +3033,32 @@ void register_index_page_metrics(seastar::metrics::metric_groups& metrics, parti
             sm::description("Index pages which got populated into memory")),
         sm::make_gauge("index_page_used_bytes", [&m] { return m.used_bytes; },
             sm::description("Amount of bytes used by index pages in memory")),
+        sm::make_counter("summary_lookups", [&m] { return m.summary_lookups; },
+            sm::description("Lookups of partition positions in the summary")),
+        sm::make_counter("summary_probes", [&m] { return m.summary_probes; },
+            sm::description("Summary entries compared during summary lookups. Divided by summary_lookups, gives the average number of probes per lookup")),
 
     });
 }
 
+void register_promoted_index_block_cache_metrics(seastar::metrics::metric_groups& metrics, promoted_index_block_cache_stats& m) {
+    namespace sm = seastar::metrics;
+    metrics.add_group("sstables", {
+        sm::make_counter("pi_block_cache_hits", [&m] { return m.hits; },
+            sm::description("Promoted index block lookups which found the block start in the shared cache")),
+        sm::make_counter("pi_block_cache_misses", [&m] { return m.misses; },
+            sm::description("Promoted index block lookups which had to parse the block start from the index file")),
+        sm::make_counter("pi_block_cache_evictions", [&m] { return m.evictions; },
+            sm::description("Promoted index block starts which got evicted from the shared cache")),
+        sm::make_counter("pi_block_cache_populations", [&m] { return m.populations; },
+            sm::description("Promoted index block starts which got inserted into the shared cache")),
+        sm::make_gauge("pi_block_cache_block_count", [&m] { return m.block_count; },
+            sm::description("Number of promoted index block starts currently in the shared cache")),
+        sm::make_gauge("pi_block_cache_bytes", [&m] { return m.used_bytes; },
+            sm::description("Amount of bytes used by promoted index block starts in the shared cache")),
+    });
+}
+
 future<> init_metrics() {
   return seastar::smp::invoke_on_all([] {
     namespace sm = seastar::metrics;
@@ -3059,6 +3177,8 @@ sstable::sstable(schema_ptr schema,
     , _format(f)
     , _index_cache(std::make_unique<partition_index_cache>(
             manager.get_cache_tracker().get_lru(), manager.get_cache_tracker().region(), manager.get_cache_tracker().get_partition_index_cache_stats()))
+    , _promoted_index_block_cache(std::make_unique<promoted_index_block_cache>(
+            manager.get_cache_tracker().get_lru(), manager.get_cache_tracker().region(), manager.get_cache_tracker().get_promoted_index_block_cache_stats()))
     , _now(now)
     , _read_error_handler(error_handler_gen(sstable_read_error))
     , _write_error_handler(error_handler_gen(sstable_write_error))
@@ -3090,6 +3210,7 @@ future<> sstable::destroy() {
     }
 
     co_await _index_cache->evict_gently();
+    co_await _promoted_index_block_cache->evict_gently();
     if (_cached_index_file) {
         co_await _cached_index_file->evict_gently();
     }
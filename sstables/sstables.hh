@@ -96,6 +96,7 @@ class data_consume_context;
 
 class index_reader;
 class partition_index_cache;
+class promoted_index_block_cache;
 class sstables_manager;
 
 extern size_t summary_byte_cost(double summary_ratio);
@@ -108,6 +109,22 @@ struct sstable_writer_config {
     mutation_fragment_stream_validation_level validation_level;
     std::optional<db::replay_position> replay_position;
     std::optional<int> sstable_level;
+    std::optional<uint64_t> repaired_at;
+    // Whether to record the range of the values of fixed-size columns,
+    // see scylla_metadata::column_value_ranges.
+    bool column_value_ranges = false;
+    // Overrides the compression parameters of the schema for the data file.
+    // Must not change whether the data is compressed at all.
+    std::optional<compression_parameters> compression;
+    // Whether to train a compression dictionary for the data file, if the
+    // compressor supports it. Older nodes can't read such sstables.
+    bool compression_dictionaries = false;
+    // Whether the bloom filter may use the layout selected by the schema.
+    // If not, the classic layout is used, which older nodes can read.
+    bool blocked_bloom_filters = false;
+    // Whether chunks which don't compress to the schema's min_compress_ratio
+    // may be stored uncompressed. Older nodes can't read such sstables.
+    bool raw_compressed_chunks = false;
     write_monitor* monitor = &default_write_monitor();
     run_id run_identifier = run_id::create_random_id();
     size_t summary_byte_cost;
@@ -427,7 +444,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     std::vector<std::pair<component_type, sstring>> all_components() const;
 
-    future<> snapshot(const sstring& dir) const;
+    // Hard-links the sstable into dir. Caller may pass sync_dir::no for batching
+    // multiple sstables linked into the same directory, in which case it must
+    // create the directory before, and sync it after the last call.
+    future<> snapshot(const sstring& dir, storage::sync_dir sync = storage::sync_dir::yes) const;
 
     // Delete the sstable by unlinking all sstable files
     // Ignores all errors.
@@ -565,6 +585,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     filter_tracker _filter_tracker;
     std::unique_ptr<partition_index_cache> _index_cache;
+    std::unique_ptr<promoted_index_block_cache> _promoted_index_block_cache;
 
     enum class mark_for_deletion {
         implicit = -1,
@@ -602,6 +623,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     mutable std::optional<size_t> _total_reclaimable_memory{0};
     // Total memory reclaimed so far from this sstable
     size_t _total_memory_reclaimed{0};
+    // Set when the bloom filter wasn't loaded with the sstable, see sstable_open_config::defer_bloom_filter_loading.
+    // The filter is then accounted as reclaimed, with its size on disk, until loaded.
+    bool _filter_load_deferred = false;
 public:
     bool has_component(component_type f) const;
     sstables_manager& manager() { return _manager; }
@@ -648,6 +672,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
                                sstable_enabled_features features,
                                run_identifier identifier,
                                std::optional<scylla_metadata::large_data_stats> ld_stats,
+                               std::optional<scylla_metadata::column_value_ranges> cv_ranges,
                                sstring origin);
 
     future<> read_filter(sstable_open_config cfg = {});
@@ -829,10 +854,20 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _components->filter->is_present(key);
     }
 
+    // Starts loading the parts of the filter needed to check the key into
+    // cache, see utils::i_filter::prefetch().
+    void filter_prefetch(utils::hashed_key key) const {
+        _components->filter->prefetch(key);
+    }
+
     bool filter_has_key(const schema& s, partition_key_view key) const {
         return filter_has_key(key::from_partition_key(s, key));
     }
 
+    // Returns true if the partition index page which a lookup of pos would read
+    // is in the index cache, or is being loaded into it.
+    bool has_cached_index_page(dht::ring_position_view pos) const;
+
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
@@ -903,6 +938,17 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // This will change sstable level only in memory.
     void set_sstable_level(uint32_t);
 
+    // The time, in milliseconds since the epoch, of the repair which
+    // synchronized the data of the sstable with the other replicas.
+    // Zero if the sstable is not repaired.
+    uint64_t get_repaired_at() const {
+        return get_stats_metadata().repaired_at;
+    }
+
+    bool is_repaired() const {
+        return get_repaired_at() != 0;
+    }
+
     void generate_new_run_identifier() {
         _run_identifier = run_id::create_random_id();
     }
@@ -915,6 +961,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> mutate_sstable_level(uint32_t);
 
+    // Marks the sstable as repaired at the given time, see get_repaired_at().
+    future<> mutate_repaired_at(uint64_t);
+
     const summary& get_summary() const {
         return _components->summary;
     }
@@ -17,6 +17,7 @@
 #include "gms/feature.hh"
 #include "gms/feature_service.hh"
 #include "utils/s3/client.hh"
+#include "utils/s3/disk_cache.hh"
 #include "exceptions/exceptions.hh"
 
 namespace sstables {
@@ -52,16 +53,34 @@ sstables_manager::~sstables_manager() {
 storage_manager::storage_manager(const db::config& cfg, config stm_cfg)
     : _s3_clients_memory(stm_cfg.s3_clients_memory)
     , _config_updater(this_shard_id() == 0 ? std::make_unique<config_updater>(cfg, *this) : nullptr)
+    , _db_config(cfg)
 {
     for (auto [ep, ecfg] : cfg.object_storage_config()) {
         _s3_endpoints.emplace(std::make_pair(std::move(ep), make_lw_shared<s3::endpoint_config>(std::move(ecfg))));
     }
 }
 
+storage_manager::~storage_manager() = default;
+
+future<> storage_manager::start() {
+    auto size = _db_config.object_storage_cache_size_in_mb() << 20;
+    if (size == 0) {
+        co_return;
+    }
+    // Each shard caches the objects it reads in a directory of its own.
+    auto dir = std::filesystem::path(_db_config.object_storage_cache_directory()) / format("shard{}", this_shard_id());
+    auto cache = std::make_unique<s3::disk_cache>(std::move(dir), size / smp::count);
+    co_await cache->start();
+    _s3_disk_cache = std::move(cache);
+}
+
 future<> storage_manager::stop() {
     if (_config_updater) {
         co_await _config_updater->action.join();
     }
+    if (_s3_disk_cache) {
+        co_await _s3_disk_cache->stop();
+    }
 
     for (auto ep : _s3_endpoints) {
         if (ep.second.client != nullptr) {
@@ -144,6 +163,10 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.column_value_ranges = _db_config.sstable_column_value_ranges();
+    cfg.compression_dictionaries = bool(_features.zstd_compression_dictionaries);
+    cfg.blocked_bloom_filters = bool(_features.blocked_bloom_filters);
+    cfg.raw_compressed_chunks = bool(_features.min_compress_ratio);
 
     cfg.origin = std::move(origin);
 
@@ -172,9 +195,16 @@ void sstables_manager::increment_total_reclaimable_memory_and_maybe_reclaim(ssta
     smlogger.info("Reclaimed {} bytes of memory from SSTable components. Total memory reclaimed so far is {} bytes", memory_reclaimed, _total_memory_reclaimed);
 }
 
+void sstables_manager::defer_components_loading(sstable* sst) {
+    _total_memory_reclaimed += sst->total_memory_reclaimed();
+    _reclaimed.insert(*sst);
+    // Wake up the reloader
+    _sstable_deleted_event.signal();
+}
+
 size_t sstables_manager::get_memory_available_for_reclaimable_components() {
     size_t memory_reclaim_threshold = _available_memory * _db_config.components_memory_reclaim_threshold();
-    return memory_reclaim_threshold - _total_reclaimable_memory;
+    return memory_reclaim_threshold > _total_reclaimable_memory ? memory_reclaim_threshold - _total_reclaimable_memory : 0;
 }
 
 future<> sstables_manager::components_reloader_fiber() {
@@ -218,6 +248,8 @@ future<> sstables_manager::components_reloader_fiber() {
             }
 
             _total_memory_reclaimed -= reclaimed_memory;
+            // The memory of deferred filters is only estimated, account the real size
+            _total_reclaimable_memory = _total_reclaimable_memory - reclaimed_memory + sstable_ptr->total_reclaimable_memory_size();
             memory_available = get_memory_available_for_reclaimable_components();
         }
     }
@@ -31,7 +31,7 @@ class config;
 
 }   // namespace db
 
-namespace s3 { class client; }
+namespace s3 { class client; class disk_cache; }
 
 namespace gms { class feature_service; }
 
@@ -59,6 +59,9 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     semaphore _s3_clients_memory;
     std::unordered_map<sstring, s3_endpoint> _s3_endpoints;
     std::unique_ptr<config_updater> _config_updater;
+    const db::config& _db_config;
+    // Engaged by start() if object_storage_cache_size_in_mb is set.
+    std::unique_ptr<s3::disk_cache> _s3_disk_cache;
 
     void update_config(const db::config&);
 
@@ -68,8 +71,14 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     };
 
     storage_manager(const db::config&, config cfg);
+    ~storage_manager();
     shared_ptr<s3::client> get_endpoint_client(sstring endpoint);
     bool is_known_endpoint(sstring endpoint) const;
+    // Returns the local disk cache of objects, or nullptr if it's disabled.
+    s3::disk_cache* get_s3_disk_cache() const noexcept {
+        return _s3_disk_cache.get();
+    }
+    future<> start();
     future<> stop();
 };
 
@@ -149,6 +158,10 @@ class sstables_manager {
         return _storage->is_known_endpoint(std::move(endpoint));
     }
 
+    s3::disk_cache* get_s3_disk_cache() const noexcept {
+        return _storage ? _storage->get_s3_disk_cache() : nullptr;
+    }
+
     virtual sstable_writer_config configure_writer(sstring origin) const;
     bool uuid_sstable_identifiers() const;
     const db::config& config() const { return _db_config; }
@@ -205,6 +218,9 @@ class sstables_manager {
     // memory and if the total memory usage exceeds the pre-defined threshold,
     // reclaim it from the SSTable that has the most reclaimable memory.
     void increment_total_reclaimable_memory_and_maybe_reclaim(sstable* sst);
+    // Registers an sstable whose bloom filter wasn't loaded with it, to be
+    // loaded by the components reloader fiber.
+    void defer_components_loading(sstable* sst);
     // Fiber to reload reclaimed components back into memory when memory becomes available.
     future<> components_reloader_fiber();
     size_t get_memory_available_for_reclaimable_components();
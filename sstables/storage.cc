@@ -65,13 +65,13 @@ class filesystem_storage final : public sstables::storage {
     {}
 
     virtual future<> seal(const sstable& sst) override;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const override;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen, sync_dir sync) const override;
     virtual future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
     virtual future<> wipe(const sstable& sst, sync_dir) noexcept override;
     virtual future<file> open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) override;
-    virtual future<data_sink> make_data_or_index_sink(sstable& sst, component_type type) override;
+    virtual future<data_sink> make_data_or_index_sink(sstable& sst, component_type type, std::optional<uint64_t> size_hint) override;
     virtual future<data_sink> make_component_sink(sstable& sst, component_type type, open_flags oflags, file_output_stream_options options) override;
     virtual future<> destroy(const sstable& sst) override { return make_ready_future<>(); }
     virtual future<atomic_delete_context> atomic_delete_prepare(const std::vector<shared_sstable>&) const override;
@@ -81,7 +81,7 @@ class filesystem_storage final : public sstables::storage {
     virtual sstring prefix() const override { return _dir.native(); }
 };
 
-future<data_sink> filesystem_storage::make_data_or_index_sink(sstable& sst, component_type type) {
+future<data_sink> filesystem_storage::make_data_or_index_sink(sstable& sst, component_type type, std::optional<uint64_t>) {
     file_output_stream_options options;
     options.buffer_size = sst.sstable_buffer_size;
     options.write_behind = 10;
@@ -347,13 +347,24 @@ future<> filesystem_storage::create_links(const sstable& sst, const std::filesys
     return create_links_common(sst, dir.native(), sst._generation, mark_for_removal::no);
 }
 
-future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const {
+future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen, sync_dir sync) const {
     std::filesystem::path snapshot_dir;
     if (abs) {
         snapshot_dir = dir;
     } else {
         snapshot_dir = _dir / dir;
     }
+    if (!sync) {
+        // Nothing is loaded from the directory before the caller seals it, so there's no
+        // need for the TemporaryTOC protocol of create_links_common() and its syncs.
+        auto generation = gen.value_or(sst._generation);
+        co_await coroutine::parallel_for_each(sst.all_components(), [this, &sst, &snapshot_dir, generation] (auto p) {
+            auto src = sstable::filename(_dir.native(), sst._schema->ks_name(), sst._schema->cf_name(), sst._version, sst._generation, sst._format, p.second);
+            auto dst = sstable::filename(snapshot_dir.native(), sst._schema->ks_name(), sst._schema->cf_name(), sst._version, generation, sst._format, p.second);
+            return sst.sstable_write_io_check(idempotent_link_file, std::move(src), std::move(dst));
+        });
+        co_return;
+    }
     co_await sst.sstable_touch_directory_io_check(snapshot_dir);
     co_await create_links_common(sst, snapshot_dir, std::move(gen));
 }
@@ -519,13 +530,13 @@ class s3_storage : public sstables::storage {
     }
 
     virtual future<> seal(const sstable& sst) override;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type>) const override;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type>, sync_dir) const override;
     virtual future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
     virtual future<> wipe(const sstable& sst, sync_dir) noexcept override;
     virtual future<file> open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) override;
-    virtual future<data_sink> make_data_or_index_sink(sstable& sst, component_type type) override;
+    virtual future<data_sink> make_data_or_index_sink(sstable& sst, component_type type, std::optional<uint64_t> size_hint) override;
     virtual future<data_sink> make_component_sink(sstable& sst, component_type type, open_flags oflags, file_output_stream_options options) override;
     virtual future<> destroy(const sstable& sst) override {
         return make_ready_future<>();
@@ -562,12 +573,20 @@ void s3_storage::open(sstable& sst) {
 }
 
 future<file> s3_storage::open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) {
-    co_return _client->make_readable_file(make_s3_object_name(sst, type));
+    auto name = make_s3_object_name(sst, type);
+    auto f = _client->make_readable_file(name);
+    if (auto* cache = sst.manager().get_s3_disk_cache()) {
+        co_return cache->wrap(std::move(f), std::move(name));
+    }
+    co_return f;
 }
 
-future<data_sink> s3_storage::make_data_or_index_sink(sstable& sst, component_type type) {
+future<data_sink> s3_storage::make_data_or_index_sink(sstable& sst, component_type type, std::optional<uint64_t> size_hint) {
     assert(type == component_type::Data || type == component_type::Index);
-    // FIXME: if we have file size upper bound upfront, it's better to use make_upload_sink() instead
+    // The hint is not a hard limit, leave the sink some slack before it's out of parts
+    if (size_hint && *size_hint <= s3::client::upload_sink_max_object_size / 2) {
+        co_return _client->make_upload_sink(make_s3_object_name(sst, type), size_hint);
+    }
     co_return _client->make_upload_jumbo_sink(make_s3_object_name(sst, type));
 }
 
@@ -633,7 +652,7 @@ future<> s3_storage::remove_by_registry_entry(entry_descriptor desc) {
     co_await _client->delete_object(prefix + "/" + sstable_version_constants::TOC_SUFFIX);
 }
 
-future<> s3_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const {
+future<> s3_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen, sync_dir) const {
     co_await coroutine::return_exception(std::runtime_error("Snapshotting S3 objects not implemented"));
 }
 
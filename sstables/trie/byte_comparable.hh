@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "compound_compat.hh"
+#include "dht/decorated_key.hh"
+#include "schema/schema.hh"
+#include "types/byte_comparable.hh"
+
+// Byte-comparable encoding of the keys of trie indexes, see
+// types/byte_comparable.hh.
+//
+// A trie index can only be walked with keys whose order is the
+// lexicographical order of their bytes, compared as unsigned. The index
+// only leads to the data file, where the actual key is found and checked.
+// The encodings are prefix-free, so that no key of a trie ends at an inner
+// node of it.
+namespace sstables::trie {
+
+// The token is stored big-endian, with the sign bit flipped, so that
+// negative tokens sort before positive ones.
+inline void append(bytes_ostream& out, dht::token t) {
+    byte_comparable::append_signed(out, t.raw());
+}
+
+// Decorated keys are ordered by token, then by the legacy form of the
+// partition key, compared as unsigned bytes, see decorated_key::tri_compare().
+inline bytes encode(const schema& s, const dht::decorated_key& dk) {
+    bytes_ostream out;
+    append(out, dk.token());
+    byte_comparable::append_escaped(out, to_legacy(*s.partition_key_type(), dk.key().representation()));
+    return bytes(out.linearize());
+}
+
+// Each component of a clustering key is preceded by next_component, and the
+// key is terminated by end_of_key, which sorts before it. So a prefix sorts
+// before the keys it is a prefix of, without its encoding being a prefix of
+// theirs.
+constexpr uint8_t end_of_key = 0x20;
+constexpr uint8_t next_component = 0x40;
+
+// Clustering keys are ordered component by component, with the types of the
+// clustering columns.
+inline bytes encode(const schema& s, const clustering_key_prefix& ck) {
+    bytes_ostream out;
+    auto types = s.clustering_key_type()->types().begin();
+    for (auto c : ck.components(s)) {
+        byte_comparable::append_byte(out, next_component);
+        byte_comparable::append(out, **types++, c);
+    }
+    byte_comparable::append_byte(out, end_of_key);
+    return bytes(out.linearize());
+}
+
+} // namespace sstables::trie
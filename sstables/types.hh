@@ -532,6 +532,8 @@ enum class scylla_metadata_type : uint32_t {
     SSTableOrigin = 6,
     ScyllaBuildId = 7,
     ScyllaVersion = 8,
+    BloomFilterLayout = 9,
+    ColumnValueRanges = 10,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -545,6 +547,23 @@ struct run_identifier {
     auto describe_type(sstable_version_types v, Describer f) { return f(id); }
 };
 
+// Layout of the bloom filter stored in the Filter component.
+// Absent for the classic, Cassandra compatible, layout.
+//
+// Note: For extensibility, never reuse an identifier,
+// only add new ones, since these are stored on stable storage.
+enum class bloom_filter_layout : uint32_t {
+    classic = 0,
+    blocked = 1,
+};
+
+struct bloom_filter_layout_metadata {
+    bloom_filter_layout layout;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(layout); }
+};
+
 // Types of large data statistics.
 //
 // Note: For extensibility, never reuse an identifier,
@@ -566,12 +585,24 @@ struct large_data_stats_entry {
     auto describe_type(sstable_version_types v, Describer f) { return f(max_value, threshold, above_threshold); }
 };
 
+// The smallest and the largest live values of a column in the sstable,
+// serialized with the type of the column.
+struct column_value_range {
+    disk_string<uint32_t> min;
+    disk_string<uint32_t> max;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(min, max); }
+};
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
     using sstable_origin = disk_string<uint32_t>;
     using scylla_build_id = disk_string<uint32_t>;
     using scylla_version = disk_string<uint32_t>;
+    // Indexed by column name.
+    using column_value_ranges = disk_hash<uint32_t, disk_string<uint32_t>, column_value_range>;
 
     disk_set_of_tagged_union<scylla_metadata_type,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Sharding, sharding_metadata>,
@@ -581,7 +612,9 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataStats, large_data_stats>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableOrigin, sstable_origin>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaBuildId, scylla_build_id>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::BloomFilterLayout, bloom_filter_layout_metadata>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ColumnValueRanges, column_value_ranges>
             > data;
 
     sstable_enabled_features get_features() const {
@@ -605,6 +638,13 @@ struct scylla_metadata {
         }
         return *ext;
     }
+    bloom_filter_layout get_bloom_filter_layout() const {
+        auto* m = data.get<scylla_metadata_type::BloomFilterLayout, bloom_filter_layout_metadata>();
+        return m ? m->layout : bloom_filter_layout::classic;
+    }
+    const column_value_ranges* get_column_value_ranges() const {
+        return data.get<scylla_metadata_type::ColumnValueRanges, column_value_ranges>();
+    }
     std::optional<run_id> get_optional_run_identifier() const {
         auto* m = data.get<scylla_metadata_type::RunIdentifier, run_identifier>();
         return m ? std::make_optional(m->id) : std::nullopt;
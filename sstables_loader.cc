@@ -148,6 +148,9 @@ class sstable_streamer {
     inet_address_vector_replica_set get_endpoints(const dht::token& token, bool primary_replica_only) const;
 protected:
     virtual inet_address_vector_replica_set get_primary_endpoints(const dht::token& token) const;
+    // Returns the number of partitions each sstable written by the receiving node is expected to have,
+    // given the estimated number of partitions of the stream.
+    virtual uint64_t estimated_partitions_per_sstable(gms::inet_address node, uint64_t estimated_partitions) const;
     future<> stream_sstables(const dht::partition_range&, std::vector<sstables::shared_sstable>, bool primary_replica_only);
     future<> stream_sstable_mutations(const dht::partition_range&, std::vector<sstables::shared_sstable>, bool primary_replica_only);
 };
@@ -172,6 +175,10 @@ class tablet_sstable_streamer : public sstable_streamer {
 
     virtual future<> stream(bool primary_replica_only) override;
     virtual inet_address_vector_replica_set get_primary_endpoints(const dht::token& token) const override;
+    virtual uint64_t estimated_partitions_per_sstable(gms::inet_address node, uint64_t estimated_partitions) const override {
+        // The stream covers a single tablet, which is owned by a single shard of the receiver.
+        return estimated_partitions;
+    }
 private:
     future<> stream_fully_contained_sstables(const dht::partition_range& pr, std::vector<sstables::shared_sstable> sstables,
                                              bool primary_replica_only) {
@@ -202,6 +209,17 @@ inet_address_vector_replica_set tablet_sstable_streamer::get_primary_endpoints(c
     return to_replica_set(replicas);
 }
 
+uint64_t sstable_streamer::estimated_partitions_per_sstable(gms::inet_address node, uint64_t estimated_partitions) const {
+    // The receiver splits the stream by its shards, writing one sstable on each of them,
+    // so size the sstables (e.g. their bloom filters) for their share of the partitions.
+    auto n = _erm->get_topology().find_node(node);
+    auto shard_count = n ? n->get_shard_count() : 0;
+    if (!shard_count) {
+        return estimated_partitions;
+    }
+    return std::max(estimated_partitions / shard_count, uint64_t(1));
+}
+
 future<> sstable_streamer::stream(bool primary_replica_only) {
     const auto full_partition_range = dht::partition_range::make_open_ended_both_sides();
 
@@ -317,7 +335,7 @@ future<> sstable_streamer::stream_sstable_mutations(const dht::partition_range&
                     for (auto& node : current_targets) {
                         if (!metas.contains(node)) {
                             auto [sink, source] = co_await _ms.make_sink_and_source_for_stream_mutation_fragments(reader.schema()->version(),
-                                    ops_uuid, cf_id, estimated_partitions, reason, service::default_session_id, netw::messaging_service::msg_addr(node));
+                                    ops_uuid, cf_id, estimated_partitions_per_sstable(node, estimated_partitions), reason, service::default_session_id, netw::messaging_service::msg_addr(node));
                             llog.debug("load_and_stream: ops_uuid={}, make sink and source for node={}", ops_uuid, node);
                             metas.emplace(node, send_meta_data(node, std::move(sink), std::move(source)));
                             metas.at(node).receive();
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <filesystem>
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+
+#include "streaming/stream_blob.hh"
+#include "replica/database.hh"
+#include "sstables/sstables.hh"
+#include "log.hh"
+
+namespace streaming {
+
+extern logging::logger sslog;
+
+static constexpr size_t stream_blob_buffer_size = 128 * 1024;
+
+future<std::optional<std::vector<stream_blob_file>>> open_files_for_streaming(replica::table& t, dht::token_range range) {
+    if (!t.get_storage_options().is_local_type()) {
+        co_return std::nullopt;
+    }
+    auto snapshot = co_await t.take_storage_snapshot(range);
+    std::exception_ptr ex;
+    std::vector<stream_blob_file> ret;
+    bool eligible = true;
+    try {
+        for (auto& sst_files : snapshot) {
+            auto& sst = sst_files.sst;
+            if (!range.contains(sst->get_first_decorated_key().token(), dht::token_comparator()) ||
+                    !range.contains(sst->get_last_decorated_key().token(), dht::token_comparator())) {
+                sslog.debug("SSTable {} is not contained in range {}, it cannot be streamed as files", sst->get_filename(), range);
+                eligible = false;
+                break;
+            }
+            auto add_file = [&] (sstables::component_type c, file& f) -> future<> {
+                ret.push_back(stream_blob_file{
+                    .name = sst->component_basename(c),
+                    .handle = f.dup(),
+                    .size = co_await f.size(),
+                });
+            };
+            // The TOC goes last, as the destination seals the sstable once it receives the TOC.
+            for (auto& [c, f] : sst_files.files) {
+                if (c != sstables::component_type::TOC) {
+                    co_await add_file(c, f);
+                }
+            }
+            co_await add_file(sstables::component_type::TOC, sst_files.files.at(sstables::component_type::TOC));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    // The handles keep the files open.
+    for (auto& sst_files : snapshot) {
+        for (auto& [_, f] : sst_files.files) {
+            co_await f.close();
+        }
+    }
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    if (!eligible) {
+        co_return std::nullopt;
+    }
+    co_return std::move(ret);
+}
+
+static future<> send_file(const stream_blob_file& sf, stream_blob_sink& sink) {
+    auto in = make_file_input_stream(sf.handle.to_file(), 0, sf.size, file_input_stream_options{
+        .buffer_size = stream_blob_buffer_size,
+        .read_ahead = 4,
+    });
+    std::exception_ptr ex;
+    try {
+        for (;;) {
+            auto buf = co_await in.read();
+            if (buf.empty()) {
+                break;
+            }
+            co_await sink(stream_blob_cmd::data, sf.name, std::move(buf));
+        }
+        co_await sink(stream_blob_cmd::end_of_file, sf.name, temporary_buffer<char>());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+}
+
+future<> send_files(std::optional<std::vector<stream_blob_file>> files, stream_blob_sink& sink) {
+    if (!files) {
+        co_await sink(stream_blob_cmd::not_eligible, sstring(), temporary_buffer<char>());
+        co_return co_await sink.flush();
+    }
+    for (auto& sf : *files) {
+        co_await send_file(sf, sink);
+    }
+    co_await sink(stream_blob_cmd::end_of_stream, sstring(), temporary_buffer<char>());
+    co_await sink.flush();
+}
+
+namespace {
+
+// Writes the received component files of sstables into the directory of the table.
+class files_receiver {
+    replica::table& _table;
+    struct received_sstable {
+        sstables::entry_descriptor desc;
+        bool sealed = false;
+    };
+    // Indexed by the generation at the source.
+    std::unordered_map<sstables::generation_type, received_sstable> _sstables;
+    // In order of creation, so components are removed before the TOC on failure.
+    std::vector<sstring> _written;
+    std::optional<output_stream<char>> _out;
+    sstring _name;
+    sstables::component_type _component;
+    received_sstable* _sst = nullptr;
+private:
+    sstring filename(const received_sstable& sst, sstables::component_type c) const {
+        auto& s = *_table.schema();
+        return sstables::sstable::filename(_table.dir(), s.ks_name(), s.cf_name(), sst.desc.version, sst.desc.generation, sst.desc.format, c);
+    }
+
+    future<> open(const sstring& name) {
+        if (std::filesystem::path(name).has_parent_path()) {
+            throw std::runtime_error(format("Invalid sstable component name {}", name));
+        }
+        auto& s = *_table.schema();
+        auto desc = sstables::parse_path(std::filesystem::path(name), s.ks_name(), s.cf_name());
+        auto it = _sstables.find(desc.generation);
+        if (it == _sstables.end()) {
+            auto generation = _table.calculate_generation_for_new_table();
+            it = _sstables.emplace(desc.generation, received_sstable{
+                .desc = sstables::entry_descriptor(generation, desc.version, desc.format, sstables::component_type::TOC, sstables::sstable_state::normal),
+            }).first;
+        }
+        if (it->second.sealed) {
+            throw std::runtime_error(format("Received component {} of an already sealed sstable", name));
+        }
+        _sst = &it->second;
+        _name = name;
+        _component = desc.component;
+        // Until sealed, the sstable is incomplete, and removed on restart.
+        auto path = filename(*_sst, _component == sstables::component_type::TOC ? sstables::component_type::TemporaryTOC : _component);
+        _written.push_back(path);
+        auto f = co_await open_file_dma(path, open_flags::wo | open_flags::create | open_flags::exclusive);
+        _out = co_await make_file_output_stream(std::move(f), file_output_stream_options{
+            .buffer_size = stream_blob_buffer_size,
+            .write_behind = 4,
+        });
+    }
+
+    future<> close() {
+        co_await _out->close();
+        _out.reset();
+        if (_component == sstables::component_type::TOC) {
+            auto dir = _table.dir();
+            co_await sync_directory(dir);
+            auto toc = filename(*_sst, sstables::component_type::TOC);
+            co_await rename_file(_written.back(), toc);
+            _written.back() = toc;
+            co_await sync_directory(dir);
+            _sst->sealed = true;
+        }
+    }
+
+    future<> on_data(const sstring& name, temporary_buffer<char> data) {
+        if (!_out) {
+            co_await open(name);
+        } else if (name != _name) {
+            throw std::runtime_error(format("Received data of {} while writing {}", name, _name));
+        }
+        co_await _out->write(data.get(), data.size());
+    }
+
+    future<> on_end_of_file(const sstring& name) {
+        // Empty files have no data.
+        if (!_out) {
+            co_await open(name);
+        } else if (name != _name) {
+            throw std::runtime_error(format("Received end of {} while writing {}", name, _name));
+        }
+        co_await close();
+    }
+
+    future<> cleanup() noexcept {
+        if (_out) {
+            co_await _out->close().handle_exception([] (std::exception_ptr) {});
+            _out.reset();
+        }
+        for (auto& path : _written) {
+            co_await remove_file(path).handle_exception([&path] (std::exception_ptr ep) {
+                sslog.warn("Failed to remove {}: {}", path, ep);
+            });
+        }
+        co_await sync_directory(_table.dir()).handle_exception([] (std::exception_ptr) {});
+    }
+public:
+    explicit files_receiver(replica::table& t) : _table(t) {}
+
+    future<std::optional<utils::chunked_vector<sstables::entry_descriptor>>> receive(stream_blob_source& source) {
+        std::exception_ptr ex;
+        bool eligible = true;
+        try {
+            bool got_end_of_stream = false;
+            while (!got_end_of_stream) {
+                auto opt = co_await source();
+                if (!opt) {
+                    throw std::runtime_error("Sender did not send end_of_stream");
+                }
+                auto& [cmd, name, data] = *opt;
+                switch (cmd) {
+                case stream_blob_cmd::data:
+                    co_await on_data(name, std::move(data));
+                    break;
+                case stream_blob_cmd::end_of_file:
+                    co_await on_end_of_file(name);
+                    break;
+                case stream_blob_cmd::end_of_stream:
+                    got_end_of_stream = true;
+                    break;
+                case stream_blob_cmd::not_eligible:
+                    if (!_written.empty()) {
+                        throw std::runtime_error("Sender sent not_eligible after files");
+                    }
+                    eligible = false;
+                    got_end_of_stream = true;
+                    break;
+                case stream_blob_cmd::error:
+                    throw std::runtime_error("Sender failed");
+                default:
+                    throw std::runtime_error("Sender sent wrong cmd");
+                }
+            }
+            if (_out) {
+                throw std::runtime_error(format("Sender did not send end of {}", _name));
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            co_await cleanup();
+            std::rethrow_exception(ex);
+        }
+        if (!eligible) {
+            co_return std::nullopt;
+        }
+        utils::chunked_vector<sstables::entry_descriptor> ret;
+        for (auto& [_, sst] : _sstables) {
+            if (!sst.sealed) {
+                co_await cleanup();
+                throw std::runtime_error(format("Sender did not send the TOC of sstable {}", sst.desc.generation));
+            }
+            ret.push_back(sst.desc);
+        }
+        co_return std::move(ret);
+    }
+};
+
+}
+
+future<std::optional<utils::chunked_vector<sstables::entry_descriptor>>> receive_files(replica::table& t, stream_blob_source& source) {
+    files_receiver receiver(t);
+    co_return co_await receiver.receive(source);
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <seastar/core/file.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/rpc/rpc_types.hh>
+
+#include "seastarx.hh"
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/token.hh"
+#include "sstables/open_info.hh"
+#include "utils/chunked_vector.hh"
+
+namespace replica {
+class table;
+}
+
+namespace streaming {
+
+// Streaming of sstables as files, used to migrate tablets whose sstables are
+// fully contained in the tablet. The component files are sent as-is, so
+// neither the source nor the destination has to parse and rewrite the data.
+enum class stream_blob_cmd : uint8_t {
+    error,
+    data,
+    end_of_file,
+    end_of_stream,
+    // The source cannot send the tablet as files, the destination should
+    // fall back to streaming mutations.
+    not_eligible,
+};
+
+using stream_blob_sink = rpc::sink<stream_blob_cmd, sstring, temporary_buffer<char>>;
+using stream_blob_source = rpc::source<stream_blob_cmd, sstring, temporary_buffer<char>>;
+
+// A component file of an sstable, opened on the shard owning the sstable.
+// The handle can be moved to any shard, and keeps the data readable even if
+// the sstable is deleted meanwhile.
+struct stream_blob_file {
+    sstring name;
+    file_handle handle;
+    uint64_t size;
+};
+
+// Flushes the memtables of the range and opens the component files of all
+// sstables of the table's storage for it, the TOC of each sstable last.
+// Returns std::nullopt if the range cannot be sent as files, i.e. if some
+// sstable isn't fully contained in the range, or the storage is not local.
+future<std::optional<std::vector<stream_blob_file>>> open_files_for_streaming(replica::table& t, dht::token_range range);
+
+// Sends the given files, or stream_blob_cmd::not_eligible if they are disengaged.
+future<> send_files(std::optional<std::vector<stream_blob_file>> files, stream_blob_sink& sink);
+
+// Writes the files received from the source into the table's directory,
+// assigning new generations to the sstables. An sstable is sealed as soon
+// as its TOC has been received, until then its TOC is kept temporary.
+// Returns the descriptors of the received sstables, or std::nullopt if the
+// source cannot send the files. On failure, the files written so far are removed.
+future<std::optional<utils::chunked_vector<sstables::entry_descriptor>>> receive_files(replica::table& t, stream_blob_source& source);
+
+}
@@ -10,6 +10,7 @@
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/gate.hh>
+#include <boost/range/irange.hpp>
 
 #include "task_manager.hh"
 
@@ -46,12 +47,26 @@ future<> task_manager::task::children::mark_as_finished(task_id id, task_essenti
 future<task_manager::task::progress> task_manager::task::children::get_progress(const std::string& progress_units) const {
     rwlock::holder shared_holder = co_await _lock.hold_read_lock();
 
+    // Query the children living on the same shard with a single cross-shard call,
+    // so that the cost of polling progress does not grow with the number of children.
+    std::vector<std::vector<const foreign_task_ptr*>> children_by_shard(smp::count);
+    for (const auto& [_, child] : _children) {
+        children_by_shard[child.get_owner_shard()].push_back(&child);
+    }
+
     tasks::task_manager::task::progress progress{};
-    co_await coroutine::parallel_for_each(_children, [&] (const auto& child_entry) -> future<> {
-        const auto& child = child_entry.second;
-        auto local_progress = co_await smp::submit_to(child.get_owner_shard(), [&child, &progress_units] {
-            assert(child->get_status().progress_units == progress_units);
-            return child->get_progress();
+    co_await coroutine::parallel_for_each(boost::irange(0u, smp::count), [&] (unsigned shard) -> future<> {
+        const auto& children = children_by_shard[shard];
+        if (children.empty()) {
+            co_return;
+        }
+        auto local_progress = co_await smp::submit_to(shard, [&children, &progress_units] () -> future<tasks::task_manager::task::progress> {
+            tasks::task_manager::task::progress local_progress{};
+            co_await coroutine::parallel_for_each(children, [&] (const foreign_task_ptr* child) -> future<> {
+                assert((*child)->get_status().progress_units == progress_units);
+                local_progress += co_await (*child)->get_progress();
+            });
+            co_return local_progress;
         });
         progress += local_progress;
     });
@@ -739,7 +739,6 @@ def test_gsi_2_describe_table_schema(test_table_gsi_2):
 # "ProjectionType:: KEYS_ONLY" works. We note that it projects both
 # the index's key, *and* the base table's key. So items which had different
 # base-table keys cannot suddenly become the same item in the index.
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_projection_keys_only(dynamodb):
     with new_test_table(dynamodb,
         KeySchema=[ { 'AttributeName': 'p', 'KeyType': 'HASH' } ],
@@ -762,6 +761,8 @@ def test_gsi_projection_keys_only(dynamodb):
         wanted = ['p', 'x']
         expected_items = [{k: x[k] for k in wanted if k in x} for x in items]
         assert_index_scan(table, 'hello', expected_items)
+        gsi = table.meta.client.describe_table(TableName=table.name)['Table']['GlobalSecondaryIndexes'][0]
+        assert gsi['Projection'] == {'ProjectionType': 'KEYS_ONLY'}
 
 # Test for "ProjectionType: INCLUDE". The secondary table includes the
 # its own and the base's keys (as in KEYS_ONLY) plus the extra keys given
@@ -879,7 +880,6 @@ def test_gsi_projection_include_otherkey(dynamodb):
         assert_index_scan(table, 'indexx', expected_items)
 
 # With ProjectionType=INCLUDE, NonKeyAttributes must not be missing:
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_projection_error_missing_nonkeyattributes(dynamodb):
     with pytest.raises(ClientError, match='ValidationException.*NonKeyAttributes'):
         with new_test_table(dynamodb,
@@ -899,7 +899,6 @@ def test_gsi_projection_error_missing_nonkeyattributes(dynamodb):
             pass
 
 # With ProjectionType!=INCLUDE, NonKeyAttributes must not be present:
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_projection_error_superflous_nonkeyattributes(dynamodb):
     with pytest.raises(ClientError, match='ValidationException.*NonKeyAttributes'):
         with new_test_table(dynamodb,
@@ -920,7 +919,6 @@ def test_gsi_projection_error_superflous_nonkeyattributes(dynamodb):
             pass
 
 # Duplicate attribute names in NonKeyAttributes of INCLUDE are not allowed:
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_projection_error_duplicate(dynamodb):
     with pytest.raises(ClientError, match='ValidationException.*Duplicate'):
         with new_test_table(dynamodb,
@@ -943,7 +941,6 @@ def test_gsi_projection_error_duplicate(dynamodb):
 # NonKeyAttributes must be a list of strings. Non-strings in this list
 # result, for some reason, in SerializationException instead of the more
 # usual ValidationException.
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_projection_error_nonstring_nonkeyattributes(dynamodb):
     with pytest.raises(ClientError, match='SerializationException'):
         with new_test_table(dynamodb,
@@ -964,7 +961,6 @@ def test_gsi_projection_error_nonstring_nonkeyattributes(dynamodb):
             pass
 
 # An unsupported ProjectionType value should result in an error:
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_bad_projection_type(dynamodb):
     with pytest.raises(ClientError, match='ValidationException.*nonsense'):
         with new_test_table(dynamodb,
@@ -984,7 +980,6 @@ def test_gsi_bad_projection_type(dynamodb):
 # "Projection" is optional - and Boto3 allows it to be missing. But in
 # fact, it is not allowed to be missing: DynamoDB complains: "Unknown
 # ProjectionType: null".
-@pytest.mark.xfail(reason="GSI projection not supported - issue #5036")
 def test_gsi_missing_projection_type(dynamodb):
     with pytest.raises(ClientError, match='ValidationException.*ProjectionType'):
         with new_test_table(dynamodb,
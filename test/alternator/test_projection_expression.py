@@ -99,6 +99,24 @@ def test_projection_expression_query(test_table):
         expected_items = [{k: x[k] for k in wanted if k in x} for x in items]
         assert multiset(expected_items) == multiset(got_items)
 
+# When the projection and the filter only refer to key attributes, Scylla
+# doesn't read the other attributes at all. Check that items are still
+# returned, including one whose non-key attributes were all removed, and
+# that the filter and the count work.
+def test_projection_expression_query_key_only(test_table):
+    p = random_string()
+    items = [{'p': p, 'c': str(i), 'a': str(i*10)} for i in range(10)]
+    with test_table.batch_writer() as batch:
+        for item in items:
+            batch.put_item(item)
+    test_table.update_item(Key={'p': p, 'c': '3'}, AttributeUpdates={'a': {'Action': 'DELETE'}})
+    got_items = full_query(test_table, KeyConditionExpression='p=:p', FilterExpression='c<>:c',
+        ProjectionExpression='c', ExpressionAttributeValues={':p': p, ':c': '5'})
+    assert multiset([{'c': x['c']} for x in items if x['c'] != '5']) == multiset(got_items)
+    count = test_table.query(KeyConditionExpression='p=:p', Select='COUNT',
+        ExpressionAttributeValues={':p': p}, ConsistentRead=True)['Count']
+    assert count == len(items)
+
 # The previous tests all fetched only top-level attributes. They could all
 # be written using AttributesToGet instead of ProjectionExpression (and,
 # in fact, we do have similar tests with AttributesToGet in other files),
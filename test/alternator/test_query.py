@@ -626,3 +626,23 @@ def test_query_large_page_small_rows(test_table_sn):
         ConsistentRead=True)['Items']
     n = len(got_items)
     assert n == N
+
+# A Query response with enough data is streamed to the client item by item
+# instead of being built as a whole JSON document first. Check that such
+# a response is complete and correct, including the Count and ScannedCount
+# fields, and with a filter dropping some of the items.
+def test_query_large_response_filtered(test_table_sn):
+    p = random_string()
+    N = 200
+    items = [{'p': p, 'c': i, 'x': random_string(2000), 'even': i % 2 == 0} for i in range(N)]
+    with test_table_sn.batch_writer() as batch:
+        for item in items:
+            batch.put_item(item)
+    response = test_table_sn.query(KeyConditionExpression='p = :p',
+        FilterExpression='even = :t',
+        ExpressionAttributeValues={':p': p, ':t': True},
+        ConsistentRead=True)
+    assert response['ScannedCount'] == N
+    assert response['Count'] == N // 2
+    assert response['Items'] == [item for item in items if item['even']]
+    assert 'LastEvaluatedKey' not in response
@@ -14,6 +14,7 @@
 #include "utils/base64.hh"
 #include "utils/rjson.hh"
 #include "alternator/serialization.hh"
+#include "alternator/ttl.hh"
 
 static std::map<std::string, std::string> strings {
     {"", ""},
@@ -165,4 +166,36 @@ BOOST_AUTO_TEST_CASE(test_magnitude_and_precision) {
     BOOST_CHECK(res.magnitude > 1000);
     res = alternator::internal::get_magnitude_and_precision("1e-1000000000000");
     BOOST_CHECK(res.magnitude < -1000);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(test_expiration_index) {
+    using namespace std::chrono_literals;
+    alternator::expiration_index index;
+    auto table = table_id::create_random_id();
+    auto pk = [] (std::string_view v) {
+        return partition_key::from_exploded(std::vector<bytes>{to_bytes(v)});
+    };
+    auto t0 = gc_clock::time_point(1000s);
+
+    BOOST_REQUIRE(index.add(table, pk("a"), t0, 3));
+    BOOST_REQUIRE(index.add(table, pk("b"), t0 + 15s, 3));
+    BOOST_REQUIRE(index.add(table, pk("c"), t0 + 5s, 3));
+    // Full
+    BOOST_REQUIRE(!index.add(table, pk("d"), t0, 3));
+    BOOST_REQUIRE_EQUAL(index.size(), 3);
+
+    // Entries are due once their bucket ends
+    BOOST_REQUIRE(index.pop_due(t0).empty());
+    auto due = index.pop_due(t0 + 10s);
+    BOOST_REQUIRE_EQUAL(due.size(), 2);
+    BOOST_REQUIRE_EQUAL(index.size(), 1);
+    for (auto& e : due) {
+        BOOST_REQUIRE(e.table == table);
+        BOOST_REQUIRE(e.pk.representation() == pk("a").representation() || e.pk.representation() == pk("c").representation());
+    }
+
+    BOOST_REQUIRE(index.pop_due(t0 + 19s).empty());
+    due = index.pop_due(t0 + 1h);
+    BOOST_REQUIRE_EQUAL(due.size(), 1);
+    BOOST_REQUIRE(due[0].pk.representation() == pk("b").representation());
+    BOOST_REQUIRE_EQUAL(index.size(), 0);
+}
@@ -334,3 +334,19 @@ BOOST_AUTO_TEST_CASE(test_conversion_to_managed_bytes) {
     buf2.write(to_bytes(mb));
     assert_sequence(buf2, 1024);
 }
+
+BOOST_AUTO_TEST_CASE(test_deserialization_allocates_few_chunks) {
+    for (size_t size : {0, 16, 4000, 128 * 1024, 1'000'000}) {
+        testlog.info("Testing buffer size {}", size);
+        auto data = tests::random::get_bytes(size);
+
+        bytes_ostream out;
+        ser::serialize(out, bytes_view(data));
+        auto in = ser::as_input_stream(out);
+        auto buf = ser::deserialize(in, boost::type<bytes_ostream>());
+
+        BOOST_REQUIRE(bytes_ostream(buf).linearize() == bytes_view(data));
+        size_t fragments = std::distance(buf.begin(), buf.end());
+        BOOST_REQUIRE_LE(fragments, size / bytes_ostream::max_chunk_size() + 1);
+    }
+}
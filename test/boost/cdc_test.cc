@@ -1632,6 +1632,46 @@ SEASTAR_THREAD_TEST_CASE(test_batch_with_row_delete) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_batch_preimage_of_rows_with_different_columns) {
+    do_with_cql_env_thread([](cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE ks.tbl_batchcols (pk int, ck int, v1 int, v2 int, primary key (pk, ck)) WITH cdc = {'enabled':true,'preimage':true}");
+        cquery_nofail(e, "INSERT INTO ks.tbl_batchcols (pk, ck, v1, v2) VALUES (0, 0, 1, 2)");
+        cquery_nofail(e, "INSERT INTO ks.tbl_batchcols (pk, ck, v1, v2) VALUES (0, 1, 3, 4)");
+        // Both updates are coalesced into one mutation, whose rows touch different columns.
+        cquery_nofail(e,
+                "BEGIN UNLOGGED BATCH"
+                "   UPDATE ks.tbl_batchcols set v1 = 10 WHERE pk = 0 and ck = 0;"
+                "   UPDATE ks.tbl_batchcols set v2 = 40 WHERE pk = 0 and ck = 1;"
+                "APPLY BATCH;");
+
+        const sstring query = format("SELECT ck, v1, v2 FROM ks.{} WHERE \"{}\" = {} ALLOW FILTERING",
+                cdc::log_name("tbl_batchcols"), cdc::log_meta_column_name("operation"), std::underlying_type_t<cdc::operation>(cdc::operation::pre_image));
+        auto msg = e.execute_cql(query).get();
+        auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg);
+        BOOST_REQUIRE(rows);
+        auto results = to_bytes(*rows);
+
+        auto deser = [] (const bytes_opt& b) -> data_value {
+            if (!b) {
+                return data_value::make_null(int32_type);
+            }
+            return int32_type->deserialize(*b);
+        };
+        auto int_null = data_value::make_null(int32_type);
+
+        const std::vector<std::vector<data_value>> expected = {
+            {int32_t(0), int32_t(1), int_null},
+            {int32_t(1), int_null, int32_t(4)},
+        };
+        BOOST_REQUIRE_EQUAL(results.size(), expected.size());
+        for (size_t idx = 0; idx < expected.size(); ++idx) {
+            for (size_t col = 0; col < expected[idx].size(); ++col) {
+                BOOST_REQUIRE_EQUAL(deser(results[idx][col]), expected[idx][col]);
+            }
+        }
+    }).get();
+}
+
 struct image_set {
     using image_row = std::vector<data_value>;
     std::vector<image_row> preimage;
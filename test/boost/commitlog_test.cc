@@ -9,6 +9,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 
 #include <stdlib.h>
 #include <iostream>
@@ -26,6 +27,7 @@
 #include <seastar/core/scollectd_api.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/closeable.hh>
 
@@ -106,6 +108,49 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_batch){
         });
 }
 
+// check that concurrent batch writes share group commit windows
+SEASTAR_TEST_CASE(test_commitlog_batch_group_commit_window){
+    commitlog::config cfg;
+    cfg.mode = commitlog::sync_mode::BATCH;
+    cfg.commitlog_sync_batch_window_in_us = 10000;
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        constexpr size_t writes = 32;
+        auto id = make_table_id();
+        sstring tmp = "hej bubba cow";
+        co_await parallel_for_each(boost::irange<size_t>(0, writes), [&] (size_t) {
+            return log.add_mutation(id, tmp.size(), db::commitlog::force_sync::no, [&tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            }).then([](replay_position rp) {
+                BOOST_CHECK_NE(rp, db::replay_position());
+            });
+        });
+        BOOST_REQUIRE_EQUAL(log.get_num_batch_window_writes(), writes);
+        BOOST_REQUIRE_GT(log.get_num_batch_windows(), 0);
+        BOOST_REQUIRE_LT(log.get_num_batch_windows(), writes);
+        BOOST_REQUIRE_GT(log.get_flush_count(), 0);
+    });
+}
+
+// check that the reserve is filled up front when segments are preallocated
+SEASTAR_TEST_CASE(test_commitlog_preallocated_segments){
+    commitlog::config cfg;
+    cfg.preallocated_segments = 4;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.commitlog_total_space_in_mb = 8 * smp::count;
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        sstring tmp = "hej bubba cow";
+        auto rp = co_await log.add_mutation(make_table_id(), tmp.size(), db::commitlog::force_sync::no, [&tmp](db::commitlog::output& dst) {
+            dst.write(tmp.data(), tmp.size());
+        });
+        BOOST_CHECK_NE(rp, db::replay_position());
+        // one active segment plus the full reserve, without any further allocations
+        for (int i = 0; i < 100 && log.get_num_segments_created() < 5; ++i) {
+            co_await sleep(std::chrono::milliseconds(10));
+        }
+        BOOST_REQUIRE_GE(log.get_num_segments_created(), 5);
+    });
+}
+
 // check that an entry marked as sync is immediately flushed to a storage
 SEASTAR_TEST_CASE(test_commitlog_written_to_disk_sync){
     commitlog::config cfg;
@@ -255,6 +300,69 @@ SEASTAR_TEST_CASE(test_commitlog_discard_completed_segments){
         });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_segment_groups){
+    auto user_table = make_table_id();
+    auto system_table = make_table_id();
+    commitlog::config cfg;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.segment_groups = 2;
+    cfg.segment_group_of = [system_table] (const table_id& id) -> unsigned {
+        return id == system_table ? 1 : 0;
+    };
+    return cl_test(cfg, [user_table, system_table](commitlog& log) -> future<> {
+        sstring tmp = "hej bubba cow";
+        auto add = [&] (table_id id) {
+            return log.add_mutation(id, tmp.size(), db::commitlog::force_sync::no, [&tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            });
+        };
+        auto user_rp = co_await add(user_table);
+        auto system_rp = co_await add(system_table);
+
+        // Each group writes to its own active segment
+        BOOST_REQUIRE_NE(user_rp.rp().id, system_rp.rp().id);
+        BOOST_REQUIRE_EQUAL(log.get_num_active_segments(), 2);
+
+        co_await log.force_new_active_segment();
+        co_await log.sync_all_segments();
+        auto names = log.get_active_segment_names();
+
+        // The segment of the user table can be freed while the
+        // system table still holds on to its own one
+        db::rp_set rps;
+        rps.put(std::move(user_rp));
+        log.discard_completed_segments(user_table, rps);
+        BOOST_REQUIRE_EQUAL(segment_diff(log, names).size(), 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_commitlog_forget_table){
+    auto table = make_table_id();
+    auto lookups = make_lw_shared<unsigned>(0);
+    commitlog::config cfg;
+    cfg.segment_groups = 2;
+    cfg.segment_group_of = [lookups] (const table_id&) -> unsigned {
+        ++*lookups;
+        return 1;
+    };
+    return cl_test(cfg, [table, lookups](commitlog& log) -> future<> {
+        sstring tmp = "hej bubba cow";
+        auto add = [&] {
+            return log.add_mutation(table, tmp.size(), db::commitlog::force_sync::no, [&tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            });
+        };
+        co_await add();
+        co_await add();
+        // The group of a table is looked up on its first write only
+        BOOST_REQUIRE_EQUAL(*lookups, 1);
+
+        log.forget_table(table);
+        co_await add();
+        BOOST_REQUIRE_EQUAL(*lookups, 2);
+    });
+}
+
 SEASTAR_TEST_CASE(test_equal_record_limit){
     return cl_test([](commitlog& log) {
             auto size = log.max_record_size();
@@ -389,3 +389,40 @@ SEASTAR_THREAD_TEST_CASE(test_prefix_compound_validity) {
     BOOST_REQUIRE_THROW(validate({'\x00', '\x01', 0, '\x00', '\x02', 'a', 'b', '\x00', '\x01', 'a'}), marshal_exception); // to many components
     BOOST_REQUIRE_THROW(validate({'\x00', '\x02', 'a', 'b', '\x00', '\x01', 0}), marshal_exception); // wrong order of components
 }
+
+SEASTAR_THREAD_TEST_CASE(test_fixed_integer_prefix_equality_compare) {
+    const auto c = compound_type<allow_prefixes::yes>({int32_type, reversed_type_impl::get_instance(long_type),
+            timestamp_type, short_type, byte_type});
+
+    auto random_value = [] (const data_type& t) -> bytes {
+        if (tests::random::get_int(9) == 0) {
+            return bytes();
+        }
+        // Few distinct values per component, so that later components get compared too.
+        auto v = tests::random::get_int<int64_t>(-2, 2);
+        switch (t->without_reversed().get_kind()) {
+        case abstract_type::kind::int32: return t->decompose(int32_t(v));
+        case abstract_type::kind::long_kind: return t->decompose(v);
+        case abstract_type::kind::timestamp: return t->decompose(db_clock::time_point(db_clock::duration(v)));
+        case abstract_type::kind::short_kind: return t->decompose(int16_t(v));
+        default: return t->decompose(int8_t(v));
+        }
+    };
+    auto random_prefix = [&] {
+        std::vector<bytes> values;
+        auto len = tests::random::get_int<size_t>(c.types().size());
+        for (size_t i = 0; i < len; ++i) {
+            values.push_back(random_value(c.types()[i]));
+        }
+        return c.serialize_value(values);
+    };
+
+    for (int i = 0; i < 10000; ++i) {
+        auto k1 = random_prefix();
+        auto k2 = random_prefix();
+        auto expected = prefix_equality_tri_compare(c.types().begin(),
+            c.begin(k1), c.end(k1), c.begin(k2), c.end(k2), ::tri_compare);
+        BOOST_REQUIRE(c.prefix_equality_compare(k1, k2) == expected);
+        BOOST_REQUIRE(c.prefix_equality_compare(k2, k1) == 0 <=> expected);
+    }
+}
@@ -164,6 +164,31 @@ SEASTAR_THREAD_TEST_CASE(test_large_row_count_warning) {
     }, cfg).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_large_partitions_ranking) {
+    auto cfg = make_shared<db::config>();
+    cfg->compaction_rows_count_warning_threshold(10);
+    do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("create table tbl (a int, b text, primary key (a, b))").get();
+        for (int i = 0; i < 22; ++i) {
+            e.execute_cql(format("insert into tbl (a, b) values (42, 'foo{}');", i)).get();
+            e.execute_cql(format("insert into tbl (a, b) values (7, 'foo{}');", i % 11)).get();
+            if (i == 10) {
+                flush(e);
+            }
+        }
+        flush(e);
+
+        // Both partitions were written twice, 42 grew while 7 was only overwritten
+        auto msg = e.execute_cql("select rank, partition_key, writes, rows from system.large_partitions_ranking where keyspace_name = 'ks' and table_name = 'tbl';").get();
+        assert_that(msg)
+            .is_rows()
+            .with_rows({
+                { int32_type->decompose(1), utf8_type->decompose("42"), long_type->decompose(2L), long_type->decompose(11L) },
+                { int32_type->decompose(2), utf8_type->decompose("7"), long_type->decompose(2L), long_type->decompose(11L) },
+            });
+    }, cfg).get();
+}
+
 SEASTAR_TEST_CASE(test_insert_large_collection_values) {
     return do_with_cql_env([] (cql_test_env& e) {
         return seastar::async([&e] {
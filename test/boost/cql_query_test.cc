@@ -4972,6 +4972,55 @@ SEASTAR_TEST_CASE(test_clustering_filtering_3) {
             test_clustering_filtering_3_with_compaction_strategy);
 }
 
+// Range scans with clustering restrictions skip the sstables whose clustering
+// key metadata doesn't overlap the restriction, without changing the results.
+SEASTAR_TEST_CASE(test_clustering_filtering_range_scan) {
+    auto db_config = make_shared<db::config>();
+    db_config->sstable_format("me");
+
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE cf(pk int, ck int, v int, PRIMARY KEY(pk, ck)) WITH COMPACTION = {'class': 'TimeWindowCompactionStrategy'}");
+        e.db().invoke_on_all([] (replica::database& db) {
+            auto& table = db.find_column_family("ks", "cf");
+            return table.disable_auto_compaction();
+        }).get();
+        // One sstable per clustering window, every one of them with all partitions.
+        for (int window = 0; window < 4; ++window) {
+            for (int pk = 0; pk < 4; ++pk) {
+                cquery_nofail(e, format("INSERT INTO cf(pk, ck, v) VALUES ({}, {}, {})", pk, window * 10, window));
+            }
+            e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        }
+        // A partition tombstone has no clustering bounds, so its sstable cannot be skipped.
+        cquery_nofail(e, "DELETE FROM cf WHERE pk = 3");
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        e.db().invoke_on_all([] (replica::database& db) { db.row_cache_tracker().clear(); }).get();
+
+        auto checked = [&] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                return db.find_column_family("ks", "cf").cf_stats()->sstables_checked_by_clustering_filter;
+            }, uint64_t(0), std::plus<uint64_t>()).get();
+        };
+        auto surviving = [&] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                return db.find_column_family("ks", "cf").cf_stats()->surviving_sstables_after_clustering_filter;
+            }, uint64_t(0), std::plus<uint64_t>()).get();
+        };
+        auto checked_before = checked();
+        auto surviving_before = surviving();
+
+        auto msg = cquery_nofail(e, "SELECT pk, v FROM cf WHERE ck >= 20 AND ck < 30 ALLOW FILTERING");
+        assert_that(msg).is_rows().with_rows_ignore_order({
+            {I(0), I(2)},
+            {I(1), I(2)},
+            {I(2), I(2)},
+        });
+        BOOST_REQUIRE_GT(checked() - checked_before, surviving() - surviving_before);
+
+        require_rows(e, "SELECT v FROM cf WHERE pk = 0", {{I(0)}, {I(1)}, {I(2)}, {I(3)}});
+    }, cql_test_config(db_config));
+}
+
 SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         cquery_nofail(e, "CREATE TABLE t (pk int, ck int, PRIMARY KEY(pk, ck))");
@@ -5348,6 +5397,45 @@ SEASTAR_TEST_CASE(test_parallelized_select_counter_type) {
     });
 }
 
+SEASTAR_TEST_CASE(test_parallelized_select_count_with_filtering) {
+    return with_parallelized_aggregation_enabled_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        auto stat_parallelized = qp.get_cql_stats().select_parallelized;
+
+        e.execute_cql("CREATE TABLE tbl (k int, c int, v int, t text, PRIMARY KEY (k, c));").get();
+        for (int k = 0; k < 10; k++) {
+            for (int c = 0; c < 10; c++) {
+                e.execute_cql(format("INSERT INTO tbl (k, c, v, t) VALUES ({:d}, {:d}, {:d}, 'it''s {:d}');", k, c, k + c, c % 2)).get();
+            }
+        }
+
+        auto msg = e.execute_cql("SELECT COUNT(*) FROM tbl WHERE v = 9 ALLOW FILTERING;").get();
+        assert_that(msg).is_rows().with_rows({
+            {long_type->decompose(int64_t(10))}
+        });
+        msg = e.execute_cql("SELECT SUM(v) FROM tbl WHERE c < 5 AND t = 'it''s 1' ALLOW FILTERING;").get();
+        assert_that(msg).is_rows().with_rows({
+            {int32_type->decompose(int32_t(10 * (1 + 3) + 2 * 45))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 2, qp.get_cql_stats().select_parallelized);
+
+        // Bound values are sent inlined in the forwarded WHERE clause.
+        auto id = e.prepare("SELECT COUNT(*) FROM tbl WHERE v = ? ALLOW FILTERING;").get();
+        msg = e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(int32_t(0)))}).get();
+        assert_that(msg).is_rows().with_rows({
+            {long_type->decompose(int64_t(1))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 3, qp.get_cql_stats().select_parallelized);
+
+        // A null can't be inlined, the query is filtered on the coordinator.
+        msg = e.execute_prepared(id, {cql3::raw_value::make_null()}).get();
+        assert_that(msg).is_rows().with_rows({
+            {long_type->decompose(int64_t(0))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 3, qp.get_cql_stats().select_parallelized);
+    });
+}
+
 static future<> with_udf_and_parallel_aggregation_enabled_thread(std::function<void(cql_test_env&)>&& func) {
     auto db_cfg_ptr = make_shared<db::config>();
     auto& db_cfg = *db_cfg_ptr;
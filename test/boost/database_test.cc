@@ -20,6 +20,7 @@
 #include <fmt/std.h>
 
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/result_set_assertions.hh"
 #include "test/lib/log.hh"
 #include "test/lib/random_utils.hh"
@@ -44,6 +45,7 @@
 #include "compaction/compaction_manager.hh"
 #include "db/snapshot-ctl.hh"
 #include "replica/mutation_dump.hh"
+#include "replica/query_result_cache.hh"
 
 using namespace std::chrono_literals;
 using namespace sstables;
@@ -259,6 +261,183 @@ SEASTAR_TEST_CASE(test_querying_with_limits) {
     });
 }
 
+// Multi-partition queries prefetch the partition indexes of the sstables
+// in the background, which must not change what the query returns.
+SEASTAR_TEST_CASE(test_multi_partition_query_from_sstables) {
+    return do_with_cql_env_and_compaction_groups([](cql_test_env& e) {
+        e.execute_cql("create table ks.cf (k text, v int, primary key (k));").get();
+        auto& db = e.local_db();
+        auto s = db.find_schema("ks", "cf");
+        auto&& table = db.find_column_family(s);
+        auto uuid = s->id();
+        std::vector<size_t> keys_per_shard(smp::count);
+        std::vector<dht::partition_range_vector> pranges_per_shard(smp::count);
+        for (uint32_t i = 1; i <= 200; ++i) {
+            auto pkey = partition_key::from_single_value(*s, to_bytes(format("key{:d}", i)));
+            auto shard = table.shard_for_reads(dht::decorate_key(*s, pkey).token());
+            // Every third key is absent.
+            if (i % 3) {
+                mutation m(s, pkey);
+                m.set_clustered_cell(clustering_key_prefix::make_empty(), "v", int32_t(i), 1);
+                apply_mutation(e.db(), uuid, m).get();
+                keys_per_shard[shard]++;
+            }
+            pranges_per_shard[shard].emplace_back(dht::partition_range::make_singular(dht::decorate_key(*s, std::move(pkey))));
+            // Spreads the keys over several sstables.
+            if (i % 50 == 0) {
+                e.db().invoke_on_all([] (replica::database& db) {
+                    return db.find_column_family("ks", "cf").flush();
+                }).get();
+            }
+        }
+        for (auto& ranges : pranges_per_shard) {
+            std::sort(ranges.begin(), ranges.end(), [&] (const dht::partition_range& a, const dht::partition_range& b) {
+                return a.start()->value().token() < b.start()->value().token();
+            });
+        }
+
+        auto max_size = std::numeric_limits<size_t>::max();
+        auto cmd = query::read_command(s->id(), s->version(),
+                partition_slice_builder(*s).with_option<query::partition_slice::option::bypass_cache>().build(),
+                query::max_result_size(max_size), query::tombstone_limit::max, query::row_limit(query::max_rows));
+        e.db().invoke_on_all([&] (replica::database& db) -> future<> {
+            auto shard = this_shard_id();
+            auto s = db.find_schema(uuid);
+            auto result = std::get<0>(co_await db.query(s, cmd, query::result_options::only_result(), pranges_per_shard[shard], nullptr, db::no_timeout));
+            assert_that(query::result_set::from_raw_result(s, cmd.slice, *result)).has_size(keys_per_shard[shard]);
+        }).get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_query_inline_from_cache) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (pk int, ck int, v int, primary key (pk, ck));").get();
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (0, 0, 0);").get();
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (0, 1, 1);").get();
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "cf").flush();
+        }).get();
+
+        auto inline_queries = [&] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                return db.get_stats().inline_data_queries;
+            }, uint64_t(0), std::plus<uint64_t>()).get();
+        };
+        auto select = [&] {
+            return e.execute_cql("select ck, v from ks.cf where pk = 0;").get();
+        };
+
+        // Makes sure the partition is in cache, unless populated on flush already.
+        assert_that(select()).is_rows().with_rows({
+            {int32_type->decompose(0), int32_type->decompose(0)},
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+        auto n = inline_queries();
+
+        assert_that(select()).is_rows().with_rows({
+            {int32_type->decompose(0), int32_type->decompose(0)},
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+        BOOST_REQUIRE_EQUAL(inline_queries(), ++n);
+
+        // Partitions present in memtables are not read inline.
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (0, 2, 2);").get();
+        assert_that(select()).is_rows().with_size(3);
+        BOOST_REQUIRE_EQUAL(inline_queries(), n);
+
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "cf").flush();
+        }).get();
+        assert_that(select()).is_rows().with_rows({
+            {int32_type->decompose(0), int32_type->decompose(0)},
+            {int32_type->decompose(1), int32_type->decompose(1)},
+            {int32_type->decompose(2), int32_type->decompose(2)},
+        });
+        BOOST_REQUIRE_EQUAL(inline_queries(), ++n);
+
+        // Per-partition limits apply to inline reads too.
+        assert_that(e.execute_cql("select ck, v from ks.cf where pk = 0 per partition limit 1;").get()).is_rows().with_rows({
+            {int32_type->decompose(0), int32_type->decompose(0)},
+        });
+        BOOST_REQUIRE_EQUAL(inline_queries(), ++n);
+    });
+}
+
+SEASTAR_TEST_CASE(test_query_result_cache) {
+    cql_test_config cfg;
+    cfg.db_config->query_result_cache_memory_fraction(0.01, utils::config_file::config_source::CommandLine);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (pk int, ck int, v int, primary key (pk, ck));").get();
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (0, 0, 0);").get();
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (0, 1, 1);").get();
+
+        auto hits = [&] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                return db.get_query_result_cache().get_stats().hits;
+            }, uint64_t(0), std::plus<uint64_t>()).get();
+        };
+        auto select = [&] {
+            return e.execute_cql("select ck, v from ks.cf where pk = 0 order by ck desc limit 2;").get();
+        };
+
+        auto hits_before = hits();
+        for (int i = 0; i < 2; ++i) {
+            assert_that(select()).is_rows().with_rows({
+                {int32_type->decompose(1), int32_type->decompose(1)},
+                {int32_type->decompose(0), int32_type->decompose(0)},
+            });
+        }
+        BOOST_REQUIRE_GT(hits(), hits_before);
+
+        // Writes to the partition drop its cached results.
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (0, 2, 2);").get();
+        assert_that(select()).is_rows().with_rows({
+            {int32_type->decompose(2), int32_type->decompose(2)},
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+        assert_that(select()).is_rows().with_rows({
+            {int32_type->decompose(2), int32_type->decompose(2)},
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+
+        // So do changes of the sstables, like truncation.
+        e.execute_cql("truncate ks.cf;").get();
+        assert_that(select()).is_rows().is_empty();
+
+        // Results which may expire are not cached.
+        e.execute_cql("insert into ks.cf (pk, ck, v) values (1, 0, 0) using ttl 1000;").get();
+        hits_before = hits();
+        for (int i = 0; i < 2; ++i) {
+            assert_that(e.execute_cql("select ck, v from ks.cf where pk = 1;").get()).is_rows().with_size(1);
+        }
+        BOOST_REQUIRE_EQUAL(hits(), hits_before);
+    }, std::move(cfg));
+}
+
+SEASTAR_TEST_CASE(test_counter_write_combining) {
+    cql_test_config cfg;
+    cfg.db_config->counter_write_combining_window_in_ms(10, utils::config_file::config_source::CommandLine);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (pk int, ck int, c1 counter, c2 counter, primary key (pk, ck));").get();
+
+        // Concurrent updates of the partition are applied together.
+        std::vector<future<shared_ptr<cql_transport::messages::result_message>>> updates;
+        for (int i = 0; i < 100; ++i) {
+            updates.push_back(e.execute_cql(format("update ks.cf set c1 = c1 + 1, c2 = c2 + {} where pk = 0 and ck = {};", i, i % 2)));
+        }
+        updates.push_back(e.execute_cql("update ks.cf set c1 = c1 + 1 where pk = 1 and ck = 0;"));
+        for (auto& f : updates) {
+            f.get();
+        }
+
+        assert_that(e.execute_cql("select pk, ck, c1, c2 from ks.cf;").get()).is_rows().with_rows_ignore_order({
+            {int32_type->decompose(0), int32_type->decompose(0), long_type->decompose(int64_t(50)), long_type->decompose(int64_t(2450))},
+            {int32_type->decompose(0), int32_type->decompose(1), long_type->decompose(int64_t(50)), long_type->decompose(int64_t(2500))},
+            {int32_type->decompose(1), int32_type->decompose(0), long_type->decompose(int64_t(1)), std::nullopt},
+        });
+    }, std::move(cfg));
+}
+
 static void test_database(void (*run_tests)(populate_fn_ex, bool), unsigned cgs) {
     do_with_cql_env_and_compaction_groups_cgs(cgs, [run_tests] (cql_test_env& e) {
         run_tests([&] (schema_ptr s, const std::vector<mutation>& partitions, gc_clock::time_point) -> mutation_source {
@@ -809,7 +988,7 @@ SEASTAR_TEST_CASE(clear_nonexistent_snapshot) {
 SEASTAR_TEST_CASE(test_snapshot_ctl_details) {
     return do_with_some_data({"cf"}, [] (cql_test_env& e) {
         sharded<db::snapshot_ctl> sc;
-        sc.start(std::ref(e.db())).get();
+        sc.start(std::ref(e.db()), std::ref(e.get_task_manager()), std::ref(e.get_sstorage_manager())).get();
         auto stop_sc = deferred_stop(sc);
 
         auto& cf = e.local_db().find_column_family("ks", "cf");
@@ -859,7 +1038,7 @@ SEASTAR_TEST_CASE(test_snapshot_ctl_details) {
 SEASTAR_TEST_CASE(test_snapshot_ctl_true_snapshots_size) {
     return do_with_some_data({"cf"}, [] (cql_test_env& e) {
         sharded<db::snapshot_ctl> sc;
-        sc.start(std::ref(e.db())).get();
+        sc.start(std::ref(e.db()), std::ref(e.get_task_manager()), std::ref(e.get_sstorage_manager())).get();
         auto stop_sc = deferred_stop(sc);
 
         auto& cf = e.local_db().find_column_family("ks", "cf");
@@ -108,3 +108,35 @@ BOOST_AUTO_TEST_CASE(test_estimated_statistics) {
     hist *= 0.5;
     BOOST_CHECK_EQUAL(hist.get(1), 1);
 }
+
+BOOST_AUTO_TEST_CASE(test_windowed_histogram) {
+    using clock = std::chrono::steady_clock;
+    using namespace std::chrono_literals;
+    auto now = clock::now();
+    utils::windowed_histogram<utils::approx_exponential_histogram<128, 1024, 4>, clock> hist(1s, now);
+    BOOST_CHECK_EQUAL(hist.quantile(0.5, now), 0);
+    for (int i = 0; i < 10; i++) {
+        hist.add(160, now);
+    }
+    BOOST_CHECK_EQUAL(hist.count(now), 10);
+    BOOST_CHECK_EQUAL(hist.quantile(0.9, now), 160);
+
+    // The previous window is still part of the histogram.
+    now += 1s;
+    for (int i = 0; i < 10; i++) {
+        hist.add(512, now);
+    }
+    BOOST_CHECK_EQUAL(hist.count(now), 20);
+    BOOST_CHECK_EQUAL(hist.quantile(0.5, now), 160);
+    BOOST_CHECK_EQUAL(hist.quantile(0.9, now), 512);
+
+    // But not the one before it.
+    now += 1s;
+    BOOST_CHECK_EQUAL(hist.count(now), 10);
+    BOOST_CHECK_EQUAL(hist.quantile(0.5, now), 512);
+
+    // Nor anything, after two windows without values.
+    now += 2s;
+    BOOST_CHECK_EQUAL(hist.count(now), 0);
+    BOOST_CHECK_EQUAL(hist.quantile(0.5, now), 0);
+}
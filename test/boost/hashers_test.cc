@@ -31,6 +31,26 @@ BOOST_AUTO_TEST_CASE(xx_hasher_sanity_check) {
     BOOST_CHECK_EQUAL(hash, expected);
 }
 
+BOOST_AUTO_TEST_CASE(xx_hasher_split_input) {
+    // Covers small pieces gathered by the hasher as well as pieces bigger
+    // than its buffer.
+    sstring data(sstring::initialized_later(), 4096);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 7);
+    }
+    xx_hasher whole;
+    whole.update(data.data(), data.size());
+    auto expected = whole.finalize_uint64();
+
+    for (size_t piece : {1, 3, 8, 100, 255, 256, 257, 1000}) {
+        xx_hasher h;
+        for (size_t pos = 0; pos < data.size(); pos += piece) {
+            h.update(data.data() + pos, std::min(piece, data.size() - pos));
+        }
+        BOOST_CHECK_EQUAL(h.finalize_uint64(), expected);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(md5_hasher_sanity_check) {
     md5_hasher hasher;
     hasher.update(reinterpret_cast<const char*>(std::data(text_part1)), std::size(text_part1));
@@ -443,3 +443,27 @@ BOOST_AUTO_TEST_CASE(test_reset) {
     BOOST_TEST(matches(m, u8"alpha"));
     BOOST_TEST(!matches(m, u8"omega"));
 }
+
+BOOST_AUTO_TEST_CASE(test_literal_shapes) {
+    auto any = matcher(u8"%%");
+    BOOST_TEST(matches(any, u8""));
+    BOOST_TEST(matches(any, u8"a\nb"));
+
+    auto infix = matcher(u8"%Шb%");
+    BOOST_TEST(matches(infix, u8"Шb"));
+    BOOST_TEST(matches(infix, u8"a\nШbШ"));
+    BOOST_TEST(!matches(infix, u8"Ш"));
+    BOOST_TEST(!matches(infix, u8"bШ"));
+
+    auto suffix = matcher(u8"%\\_");
+    BOOST_TEST(matches(suffix, u8"a_"));
+    BOOST_TEST(!matches(suffix, u8"ab"));
+
+    auto m = matcher(u8"a%");
+    m.reset(bytes(reinterpret_cast<const char*>(u8"a_")));
+    BOOST_TEST(matches(m, u8"ab"));
+    BOOST_TEST(!matches(m, u8"abc"));
+    m.reset(bytes(reinterpret_cast<const char*>(u8"%c")));
+    BOOST_TEST(matches(m, u8"abc"));
+    BOOST_TEST(!matches(m, u8"ab"));
+}
@@ -767,6 +767,76 @@ SEASTAR_THREAD_TEST_CASE(background_reclaim) {
     }
 }
 
+#ifdef SEASTAR_DEFAULT_ALLOCATOR
+// With the standard allocator the segment pool is bounded, so once it is full
+// of sparse segments, new segments can only come from compaction. Check that the
+// background reclaimer compacts in advance to refill the configured reserve,
+// so that the following segment allocations don't have to compact.
+SEASTAR_THREAD_TEST_CASE(background_reserve_refill) {
+    region r;
+    std::vector<managed_bytes> allocs;
+
+    auto clean_up = defer([&] () noexcept {
+        with_allocator(r.allocator(), [&] {
+            allocs.clear();
+        });
+    });
+
+    size_t lsa_alloc_size = 1000;
+
+    while (true) {
+        try {
+            with_allocator(r.allocator(), [&] {
+                allocs.push_back(managed_bytes(managed_bytes::initialized_later(), lsa_alloc_size));
+            });
+        } catch (std::bad_alloc&) {
+            break;
+        }
+    }
+
+    // Leave every segment half-empty, so that none of them is freed.
+    with_allocator(r.allocator(), [&] {
+        for (size_t i = 0; i < allocs.size(); i += 2) {
+            allocs[i] = managed_bytes();
+        }
+    });
+
+    auto background_reclaim_scheduling_group = create_scheduling_group("background_reclaim", 100).get();
+    auto kill_sched_group = defer([&] () noexcept {
+        destroy_scheduling_group(background_reclaim_scheduling_group).get();
+    });
+
+    size_t reserve_segments = 16;
+    logalloc::tracker::config st_cfg;
+    st_cfg.defragment_on_idle = false;
+    st_cfg.abort_on_lsa_bad_alloc = false;
+    st_cfg.lsa_reclamation_step = 1;
+    st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
+    st_cfg.background_reserve_segments = reserve_segments;
+    logalloc::shard_tracker().configure(st_cfg);
+
+    auto stop_lsa_background_reclaim = defer([&] () noexcept {
+        logalloc::shard_tracker().stop().get();
+    });
+
+    auto deadline = lowres_clock::now() + 60s;
+    while (logalloc::shard_tracker().statistics().background_reserve_refills < reserve_segments / 2) {
+        BOOST_REQUIRE(lowres_clock::now() < deadline);
+        sleep(10ms).get();
+    }
+
+    auto stats_pre = logalloc::shard_tracker().statistics();
+    with_allocator(r.allocator(), [&] {
+        for (size_t i = 0; i < reserve_segments / 4 * segment_size / lsa_alloc_size; ++i) {
+            allocs.push_back(managed_bytes(managed_bytes::initialized_later(), lsa_alloc_size));
+        }
+    });
+    auto stats_post = logalloc::shard_tracker().statistics();
+    BOOST_REQUIRE_GT(stats_post.free_segment_hits, stats_pre.free_segment_hits);
+    BOOST_REQUIRE_EQUAL(stats_post.on_demand_reclaims, stats_pre.on_demand_reclaims);
+}
+#endif
+
 inline
 bool is_aligned(void* ptr, size_t alignment) {
     return uintptr_t(ptr) % alignment == 0;
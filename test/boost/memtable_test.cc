@@ -221,6 +221,19 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
                     .produces_partition_start(muts[3].decorated_key(), muts[3].partition().partition_tombstone())
                     .next_partition()
                     .produces_end_of_stream();
+
+                testlog.info("Read of disjoint ranges");
+                mt = make_memtable(mgr, table_shared_data, tbl_stats, muts);
+                const auto first_half = dht::partition_range::make_ending_with({dht::ring_position(muts[1].decorated_key()), true});
+                const auto second_half = dht::partition_range::make_starting_with({dht::ring_position(muts[1].decorated_key()), false});
+                assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit(), first_half))
+                    .produces_compacted(compacted_muts[0], now)
+                    .produces_compacted(compacted_muts[1], now)
+                    .produces_end_of_stream();
+                assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit(), second_half))
+                    .produces_compacted(compacted_muts[2], now)
+                    .produces_compacted(compacted_muts[3], now)
+                    .produces_end_of_stream();
             }
         };
 
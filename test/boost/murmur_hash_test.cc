@@ -9,6 +9,7 @@
 #define BOOST_TEST_MODULE core
 
 #include <boost/test/unit_test.hpp>
+#include <vector>
 
 #include "utils/murmur_hash.hh"
 #include "bytes.hh"
@@ -109,3 +110,23 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_batched_hash_output) {
+    // All prefixes at once, so that keys of different lengths, with different numbers
+    // of blocks shared with the other keys of their group, are hashed together.
+    // Rotating the start makes the grouping different in each round.
+    for (size_t start = 0; start < 4; ++start) {
+        std::vector<bytes_view> keys;
+        std::vector<size_t> lengths;
+        for (size_t i = 0; i < full_sequence.size(); ++i) {
+            auto len = (start + i * 7) % full_sequence.size();
+            keys.emplace_back(full_sequence.begin(), len);
+            lengths.push_back(len);
+        }
+        std::vector<std::array<uint64_t, 2>> dst(keys.size());
+        utils::murmur_hash::hash3_x64_128(keys, seed, dst);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            BOOST_REQUIRE(dst[i] == prefix_hashes[lengths[i]]);
+        }
+    }
+}
@@ -619,6 +619,58 @@ SEASTAR_TEST_CASE(test_snapshot_cursor_is_consistent_with_merging_for_nonevictab
     });
 }
 
+SEASTAR_TEST_CASE(test_version_chain_stats) {
+    return seastar::async([] {
+        logalloc::region r;
+        mutation_application_stats stats;
+        mutation_cleaner cleaner(r, no_cache_tracker, stats);
+        with_allocator(r.allocator(), [&] {
+            random_mutation_generator gen(random_mutation_generator::generate_counters::no);
+            auto s = gen.schema();
+
+            mutation m1 = gen();
+            mutation m2 = gen();
+            mutation m3 = gen();
+
+            m1.partition().make_fully_continuous();
+            m2.partition().make_fully_continuous();
+            m3.partition().make_fully_continuous();
+
+            auto e = partition_entry(*s, mutation_partition_v2(*s, m3.partition()));
+            partition_snapshot_ptr snap1, snap2, snap3;
+            {
+                mutation_application_stats app_stats;
+                logalloc::reclaim_lock rl(r);
+                snap1 = e.read(r, cleaner, no_cache_tracker);
+                e.apply(r, cleaner, *s, m2.partition(), *s, app_stats);
+                snap2 = e.read(r, cleaner, no_cache_tracker);
+                e.apply(r, cleaner, *s, m1.partition(), *s, app_stats);
+                snap3 = e.read(r, cleaner, no_cache_tracker);
+            }
+
+            const auto& h = stats.version_chain_lengths;
+            BOOST_REQUIRE_EQUAL(h.count, 3);
+            BOOST_REQUIRE_EQUAL(h.sum, 6);
+            BOOST_REQUIRE_EQUAL(h.counts[0], 1);
+            BOOST_REQUIRE_EQUAL(h.counts[1], 1);
+            BOOST_REQUIRE_EQUAL(h.counts[2], 1);
+            BOOST_REQUIRE_EQUAL(h.counts[3], 0);
+            BOOST_REQUIRE_EQUAL(stats.version_merges, 0);
+
+            auto expected = e.squashed(*s, is_evictable::no);
+
+            snap3 = {};
+            snap2 = {};
+            snap1 = {};
+            cleaner.drain().get();
+
+            // All versions are merged once no snapshot references them
+            BOOST_REQUIRE_EQUAL(stats.version_merges, 2);
+            assert_that(s, e.squashed(*s, is_evictable::no)).is_equal_to_compacted(expected);
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_continuity_merging_in_evictable) {
     // Tests that reading many versions using a cursor gives the logical mutation back.
     return seastar::async([] {
@@ -355,3 +355,58 @@ SEASTAR_TEST_CASE(test_select_full_scan_metrics) {
         BOOST_CHECK_EQUAL(stat_ps8, qp.get_cql_stats().select_partition_range_scan);
     });
 }
+
+SEASTAR_TEST_CASE(test_coalesced_reads) {
+    cql_test_config cfg;
+    cfg.db_config->coalesce_concurrent_reads.set(true);
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        cquery_nofail(e, "create table ks.cr (pk int, ck int, v int, PRIMARY KEY(pk, ck));");
+        cquery_nofail(e, "insert into ks.cr (pk, ck, v) values (1, 1, 1);");
+        cquery_nofail(e, "insert into ks.cr (pk, ck, v) values (1, 2, 2);");
+        cquery_nofail(e, "insert into ks.cr (pk, ck, v) values (2, 1, 3);");
+        auto id = e.prepare("select ck, v from ks.cr where pk = ?").get();
+
+        auto read = [&] (int pk) {
+            return e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(pk))});
+        };
+        auto stat = qp.get_cql_stats().select_coalesced_reads;
+        std::vector<future<::shared_ptr<cql_transport::messages::result_message>>> reads;
+        for (int i = 0; i < 10; ++i) {
+            reads.push_back(read(1));
+            reads.push_back(read(2));
+        }
+        for (size_t i = 0; i < reads.size(); ++i) {
+            auto msg = reads[i].get();
+            if (i % 2 == 0) {
+                assert_that(msg).is_rows().with_rows({
+                    {int32_type->decompose(1), int32_type->decompose(1)},
+                    {int32_type->decompose(2), int32_type->decompose(2)},
+                });
+            } else {
+                assert_that(msg).is_rows().with_rows({
+                    {int32_type->decompose(1), int32_type->decompose(3)},
+                });
+            }
+        }
+        // At least one read of each partition went to the replicas.
+        auto coalesced = qp.get_cql_stats().select_coalesced_reads - stat;
+        BOOST_CHECK_GT(coalesced, 0);
+        BOOST_CHECK_LE(coalesced, 18);
+
+        // A read started after the shared one finished reads again.
+        cquery_nofail(e, "insert into ks.cr (pk, ck, v) values (2, 2, 4);");
+        assert_that(read(2).get()).is_rows().with_size(2);
+        BOOST_CHECK_EQUAL(stat + coalesced, qp.get_cql_stats().select_coalesced_reads);
+
+        // Reads which must see all acknowledged writes are never coalesced.
+        reads.clear();
+        for (int i = 0; i < 10; ++i) {
+            reads.push_back(e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(2))}, db::consistency_level::QUORUM));
+        }
+        for (auto& f : reads) {
+            assert_that(f.get()).is_rows().with_size(2);
+        }
+        BOOST_CHECK_EQUAL(stat + coalesced, qp.get_cql_stats().select_coalesced_reads);
+    }, std::move(cfg));
+}
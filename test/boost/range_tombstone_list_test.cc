@@ -160,6 +160,27 @@ BOOST_AUTO_TEST_CASE(test_adjacent_ranges_with_differing_timestamps_are_not_merg
     BOOST_REQUIRE(it == l.end());
 }
 
+BOOST_AUTO_TEST_CASE(test_apply_monotonically_appended_list) {
+    range_tombstone_list l(*s);
+    l.apply(*s, rt(1, 5, 1));
+    l.apply(*s, rt(7, 10, 2));
+
+    range_tombstone_list other(*s);
+    other.apply(*s, rtee(10, 12, 2)); // adjacent to the last tombstone, merged into it
+    other.apply(*s, rt(14, 16, 3));
+    other.apply(*s, rt(18, 20, 1));
+
+    l.apply_monotonically(*s, std::move(other));
+    BOOST_REQUIRE(other.empty());
+
+    auto it = l.begin();
+    assert_rt(rt(1, 5, 1), *it++);
+    assert_rt(rtie(7, 12, 2), *it++);
+    assert_rt(rt(14, 16, 3), *it++);
+    assert_rt(rt(18, 20, 1), *it++);
+    BOOST_REQUIRE(it == l.end());
+}
+
 static bool no_overlap(const range_tombstone_list& l) {
     bound_view::tri_compare cmp(*s);
     std::optional<range_tombstone_entry> prev;
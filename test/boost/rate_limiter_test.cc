@@ -127,3 +127,29 @@ SEASTAR_TEST_CASE(test_rate_limiter_account_operation) {
     }
     BOOST_REQUIRE(encountered_rejection);
 }
+
+SEASTAR_TEST_CASE(test_rate_limiter_sketch_counting) {
+    using counting_mode = test_rate_limiter::counting_mode;
+    test_rate_limiter::label lbl;
+    test_rate_limiter limiter;
+
+    for (uint64_t i = 0; i < 16; i++) {
+        BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0, counting_mode::sketch), i + 1);
+    }
+
+    // A flood of operations on distinct partitions doesn't overflow the sketch,
+    // the hot partition is still accounted
+    for (uint64_t token = 1; token <= 1000000; token++) {
+        limiter.increase_and_get_counter(lbl, token, counting_mode::sketch);
+        if (token % 1000 == 0) {
+            co_await maybe_yield();
+        }
+    }
+    BOOST_REQUIRE_GE(limiter.increase_and_get_counter(lbl, 0, counting_mode::sketch), 17);
+
+    co_await step_seconds(20);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0, counting_mode::sketch), 1);
+
+    // See test_rate_limiter_halving_over_time
+    co_await seastar::sleep(std::chrono::seconds(1));
+}
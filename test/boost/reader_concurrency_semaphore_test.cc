@@ -30,6 +30,7 @@
 #include "readers/empty_v2.hh"
 #include "readers/from_mutations_v2.hh"
 #include "replica/database.hh" // new_reader_base_cost is there :(
+#include "replica/exceptions.hh"
 #include "db/config.hh"
 
 SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_clear_inactive_reads) {
@@ -1947,6 +1948,39 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_necessary_evicting) {
     }
 }
 
+// Check that when admission is blocked on memory, the inactive read holding the
+// most memory is evicted, instead of evicting the oldest ones until enough is freed.
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_memory_aware_evicting) {
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 4, 4 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+
+    simple_schema ss;
+    auto s = ss.schema();
+
+    auto permit1 = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+    auto permit2 = semaphore.obtain_permit(nullptr, get_name(), 2 * 1024, db::no_timeout, {}).get();
+    auto permit3 = semaphore.obtain_permit(nullptr, get_name(), 512, db::no_timeout, {}).get();
+
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources().count, 1);
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources().memory, 512);
+
+    auto handle1 = semaphore.register_inactive_read(make_empty_flat_reader_v2(s, permit1));
+    auto handle2 = semaphore.register_inactive_read(make_empty_flat_reader_v2(s, permit2));
+    auto handle3 = semaphore.register_inactive_read(make_empty_flat_reader_v2(s, permit3));
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().inactive_reads, 3);
+
+    auto new_permit = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+
+    BOOST_REQUIRE(handle1);
+    BOOST_REQUIRE(!handle2);
+    BOOST_REQUIRE(handle3);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().inactive_reads, 2);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().permit_based_evictions, 1);
+
+    BOOST_REQUIRE(semaphore.unregister_inactive_read(std::move(handle1)));
+    BOOST_REQUIRE(semaphore.unregister_inactive_read(std::move(handle3)));
+}
+
 // Check that a waiter permit which was queued due to the _ready_list not being
 // empty, will be executed right after the previous read in _ready_list is
 // executed, even if said read doesn't trigger admission checks via releasing
@@ -2009,3 +2043,67 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_live_update_count) {
 
     BOOST_REQUIRE_EQUAL(semaphore.initial_resources(), reader_resources(count(), initial_memory));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_cheap_reads_admitted_first) {
+    using cost_class = reader_concurrency_semaphore::cost_class;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 4 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+
+    reader_permit_opt permit = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+
+    std::vector<cost_class> order;
+    std::vector<future<>> futures;
+    auto enqueue = [&] (cost_class cost) {
+        futures.emplace_back(semaphore.with_permit(nullptr, get_name(), 1024, db::no_timeout, {}, [&order, cost] (reader_permit) {
+            order.push_back(cost);
+            return make_ready_future<>();
+        }, cost));
+    };
+
+    enqueue(cost_class::regular);
+    enqueue(cost_class::regular);
+    for (unsigned i = 0; i < reader_concurrency_semaphore::max_cheap_admissions_in_a_row + 2; ++i) {
+        enqueue(cost_class::cheap);
+    }
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, futures.size());
+
+    permit = {};
+    when_all_succeed(futures.begin(), futures.end()).get();
+
+    std::vector<cost_class> expected(reader_concurrency_semaphore::max_cheap_admissions_in_a_row, cost_class::cheap);
+    expected.push_back(cost_class::regular);
+    expected.push_back(cost_class::cheap);
+    expected.push_back(cost_class::cheap);
+    expected.push_back(cost_class::regular);
+    BOOST_REQUIRE(order == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_shed_reads_past_deadline) {
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 4 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+    semaphore.set_shed_reads_past_deadline(utils::updateable_value<bool>(true));
+
+    // Teach the semaphore that reads wait about 100ms for admission.
+    reader_permit_opt permit = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+    auto first_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {});
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 1);
+    seastar::sleep(std::chrono::milliseconds(100)).get();
+    permit = {};
+    permit = first_fut.get();
+
+    // The first queued read is never shed, whatever its timeout.
+    auto second_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::timeout_clock::now() + std::chrono::hours(1), {});
+    auto third_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::timeout_clock::now() + std::chrono::milliseconds(1), {});
+    BOOST_REQUIRE_THROW(third_fut.get(), replica::overloaded_exception);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_deadline, 1);
+
+    auto fourth_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::timeout_clock::now() + std::chrono::hours(1), {});
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 2);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_deadline, 1);
+
+    permit = {};
+    permit = second_fut.get();
+    permit = {};
+    permit = fourth_fut.get();
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().admission_waiters, 0);
+}
@@ -21,6 +21,8 @@
 #include "test/lib/scylla_test_case.hh"
 #include "test/lib/sstable_utils.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
+#include "db/config.hh"
+#include <seastar/core/later.hh>
 
 // Helper mutation_fragment_queue that stores the received stream of
 // mutation_fragments in a passed in deque of mutation_fragment_v2.
@@ -267,3 +269,31 @@ SEASTAR_TEST_CASE(repair_rows_size_considers_external_memory) {
         BOOST_REQUIRE_EQUAL(row_with_boundary.size(), fmf_size + boundary.pk.external_memory_usage() + boundary.position.external_memory_usage() + sizeof(repair_row));
     });
 }
+
+SEASTAR_TEST_CASE(test_tablet_repair_max_sessions_per_node) {
+    cql_test_config cfg;
+    cfg.db_config->tablet_repair_max_sessions_per_node.set(1);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto& rs = e.get_repair_service().local();
+        auto a = gms::inet_address("127.0.0.10");
+        auto b = gms::inet_address("127.0.0.11");
+        auto c = gms::inet_address("127.0.0.12");
+
+        rs.acquire_tablet_repair_sessions({a, b}).get();
+
+        // A repair with a peer which already takes part in a repair waits for it.
+        auto f = rs.acquire_tablet_repair_sessions({c, b});
+        // Repairs with other peers don't wait.
+        rs.acquire_tablet_repair_sessions({c}).get();
+        yield().get();
+        BOOST_REQUIRE(!f.available());
+
+        rs.release_tablet_repair_sessions({c});
+        yield().get();
+        BOOST_REQUIRE(!f.available());
+
+        rs.release_tablet_repair_sessions({a, b});
+        f.get();
+        rs.release_tablet_repair_sessions({c, b});
+    }, std::move(cfg));
+}
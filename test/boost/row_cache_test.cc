@@ -35,6 +35,7 @@
 #include "test/lib/random_utils.hh"
 #include "test/lib/sstable_utils.hh"
 #include "utils/throttle.hh"
+#include "db/cache_eviction_extension.hh"
 
 #include <fmt/ranges.h>
 #include <boost/range/algorithm/min_element.hpp>
@@ -142,6 +143,48 @@ SEASTAR_TEST_CASE(test_cache_delegates_to_underlying) {
     });
 }
 
+SEASTAR_TEST_CASE(test_cache_get_recent_partition_keys) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto mt = make_lw_shared<replica::memtable>(s);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+        std::vector<mutation> mutations;
+        for (int i = 0; i < 10; i++) {
+            mutations.push_back(make_new_mutation(s));
+            cache.populate(mutations.back());
+        }
+
+        auto check = [&] (size_t max_keys, std::vector<size_t> expected) {
+            auto keys = tracker.get_recent_partition_keys(max_keys).get();
+            BOOST_REQUIRE_EQUAL(keys.size(), 1);
+            auto& table_keys = keys.at(s->id());
+            BOOST_REQUIRE_EQUAL(table_keys.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                BOOST_REQUIRE(table_keys[i].equal(*s, mutations[expected[i]].decorated_key()));
+            }
+        };
+
+        // Most recently populated first.
+        check(100, {9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+        check(3, {9, 8, 7});
+
+        // Reads move the partitions to the front.
+        for (auto i : {2, 5}) {
+            assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(mutations[i].decorated_key())))
+                .produces(mutations[i])
+                .produces_end_of_stream();
+        }
+        check(4, {5, 2, 9, 8});
+
+        cache.evict();
+        BOOST_REQUIRE(tracker.get_recent_partition_keys(100).get().empty());
+    });
+}
+
 SEASTAR_TEST_CASE(test_cache_works_after_clearing) {
     return seastar::async([] {
         auto s = make_schema();
@@ -851,6 +894,256 @@ SEASTAR_TEST_CASE(test_eviction) {
 
 #ifndef SEASTAR_DEFAULT_ALLOCATOR // Depends on eviction, which is absent with the std allocator
 
+SEASTAR_TEST_CASE(test_admission_filter) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto mt = make_lw_shared<replica::memtable>(s);
+
+        auto hot = make_new_mutation(s);
+        auto cold = make_new_mutation(s);
+        mt->apply(hot);
+        mt->apply(cold);
+
+        cache_tracker tracker;
+        tracker.set_admission_filter(utils::updateable_value<bool>(true));
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+        auto read = [&] (const mutation& m) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+                .produces(m)
+                .produces_end_of_stream();
+        };
+
+        // Nothing was evicted yet, so everything is admitted.
+        for (int i = 0; i < 5; ++i) {
+            read(hot);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), 1);
+
+        while (tracker.partitions() > 0) {
+            logalloc::shard_tracker().reclaim(100);
+        }
+
+        // A partition read once is colder than the evicted one.
+        read(cold);
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_admission_rejections, 1);
+        BOOST_REQUIRE_EQUAL(cache.stats().admission_rejections.count(), 1);
+
+        read(hot);
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), 1);
+
+        // Once read often enough, the cold partition makes it in as well.
+        while (tracker.partitions() < 2) {
+            read(cold);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_admission_rejections, 5);
+    });
+}
+
+SEASTAR_TEST_CASE(test_weighted_eviction) {
+    return seastar::async([] {
+        auto s_plain = make_schema();
+        auto s_weighted = schema_builder("ks", "weighted")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("v", bytes_type, column_kind::regular_column)
+            .add_extension(db::cache_eviction_extension::NAME, ::make_shared<db::cache_eviction_extension>(8))
+            .build();
+        BOOST_REQUIRE_EQUAL(s_weighted->cache_eviction_weight(), 8);
+
+        cache_tracker tracker;
+        auto mt_plain = make_lw_shared<replica::memtable>(s_plain);
+        auto mt_weighted = make_lw_shared<replica::memtable>(s_weighted);
+        row_cache plain(s_plain, snapshot_source_from_snapshot(mt_plain->as_data_source()), tracker);
+        row_cache weighted(s_weighted, snapshot_source_from_snapshot(mt_weighted->as_data_source()), tracker);
+
+        std::vector<dht::decorated_key> plain_keys;
+        std::vector<dht::decorated_key> weighted_keys;
+        for (int i = 0; i < 1000; i++) {
+            auto m = make_new_mutation(s_plain);
+            plain_keys.emplace_back(m.decorated_key());
+            plain.populate(m);
+            m = make_new_mutation(s_weighted);
+            weighted_keys.emplace_back(m.decorated_key());
+            weighted.populate(m);
+        }
+
+        while (tracker.partitions() > 1000) {
+            logalloc::shard_tracker().reclaim(100);
+        }
+
+        auto cached = [] (row_cache& cache, const std::vector<dht::decorated_key>& keys) {
+            return std::count_if(keys.begin(), keys.end(), [&] (const dht::decorated_key& dk) {
+                try {
+                    cache.lookup(dk);
+                    return true;
+                } catch (const std::runtime_error&) {
+                    return false;
+                }
+            });
+        };
+        auto weighted_left = cached(weighted, weighted_keys);
+        auto plain_left = cached(plain, plain_keys);
+        testlog.info("weighted partitions left: {}, unweighted partitions left: {}", weighted_left, plain_left);
+        BOOST_REQUIRE_GT(weighted_left, 2 * plain_left);
+        BOOST_REQUIRE_GT(tracker.get_stats().row_evictions_spared, 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_hot_partition_pinning) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto mt = make_lw_shared<replica::memtable>(s);
+
+        cache_tracker tracker;
+        utils::updateable_value_source<uint32_t> limit(4);
+        tracker.set_hot_partitions(utils::updateable_value<uint32_t>(limit));
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+        std::vector<mutation> mutations;
+        for (int i = 0; i < 1000; i++) {
+            auto m = make_new_mutation(s);
+            mt->apply(m);
+            cache.populate(m);
+            mutations.push_back(std::move(m));
+        }
+        const auto& hot = mutations.front();
+
+        auto read = [&] (const mutation& m) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            cache.make_reader(s, semaphore.make_permit(), pr).close().get();
+        };
+
+        // Zipf-distributed reads: the n-th partition gets reads in proportion
+        // to 1/n^1.1. The first few partitions take several percent of the
+        // reads each, while the long tail takes about half of all reads.
+        std::vector<double> weights;
+        for (size_t i = 0; i < mutations.size(); ++i) {
+            weights.push_back(1.0 / std::pow(i + 1, 1.1));
+        }
+        std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+        auto& random = seastar::testing::local_random_engine;
+        while (tracker.hot_partitions().empty()) {
+            read(mutations[dist(random)]);
+        }
+        auto& hot_partitions = tracker.hot_partitions();
+        BOOST_REQUIRE_EQUAL(hot_partitions.size(), 4);
+        BOOST_REQUIRE(hot_partitions.front().key.equal(*s, hot.decorated_key()));
+        for (auto& hp : hot_partitions) {
+            BOOST_REQUIRE(hp.pinned);
+            BOOST_REQUIRE(std::any_of(mutations.begin(), mutations.begin() + 8, [&] (const mutation& m) {
+                return hp.key.equal(*s, m.decorated_key());
+            }));
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().pinned_hot_partitions, 4);
+
+        // The readers were not consumed, so the hot partition, which was
+        // populated first, is still the least recently used one.
+        while (tracker.partitions() > mutations.size() / 2) {
+            logalloc::shard_tracker().reclaim(100);
+        }
+        BOOST_REQUIRE_NO_THROW(cache.lookup(hot.decorated_key()));
+        BOOST_REQUIRE_GT(tracker.get_stats().row_evictions_spared, 0);
+
+        limit.set(0);
+        for (int i = 0; i < 16; ++i) {
+            read(hot);
+        }
+        BOOST_REQUIRE(tracker.hot_partitions().empty());
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().pinned_hot_partitions, 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_compressed_tier) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        memtable_snapshot_source underlying(s);
+
+        std::vector<mutation> mutations;
+        for (int i = 0; i < 10; i++) {
+            mutations.push_back(make_new_mutation(s));
+            underlying.apply(mutations.back());
+        }
+
+        cache_tracker tracker;
+        tracker.set_compressed_tier(utils::updateable_value<double>(0.1));
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+
+        auto read = [&] (const mutation& m) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+                .produces(m)
+                .produces_end_of_stream();
+        };
+        auto demote = [&] {
+            tracker.region().evict_some();
+            tracker.demote_cold_partitions();
+            testlog.info("partitions: {}, compressed: {}", tracker.partitions(), tracker.get_stats().compressed_partitions);
+        };
+
+        for (auto& m : mutations) {
+            read(m);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), mutations.size());
+
+        // Nothing is demoted while there is no eviction.
+        tracker.demote_cold_partitions();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_demotions, 0);
+
+        demote();
+        auto demoted = tracker.get_stats().compressed_demotions;
+        BOOST_REQUIRE_GT(demoted, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, demoted);
+        BOOST_REQUIRE_GT(tracker.get_stats().compressed_bytes, 0);
+        BOOST_REQUIRE_EQUAL(tracker.partitions() + demoted, mutations.size() - 1);
+
+        auto misses = tracker.get_stats().partition_misses;
+        for (auto& m : mutations) {
+            read(m);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_promotions, demoted);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_bytes, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, misses + 1);
+
+        // Writes remove the partitions from the compressed tier.
+        demote();
+        BOOST_REQUIRE_GT(tracker.get_stats().compressed_partitions, 0);
+        auto mt = make_lw_shared<replica::memtable>(s);
+        std::vector<mutation> writes;
+        for (auto& m : mutations) {
+            writes.push_back(make_new_mutation(s, m.key()));
+            mt->apply(writes.back());
+            m.apply(writes.back());
+        }
+        cache.update(row_cache::external_updater([&] {
+            for (auto& w : writes) {
+                underlying.apply(w);
+            }
+        }), *mt).get();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 0);
+        BOOST_REQUIRE_GT(tracker.get_stats().compressed_removals, 0);
+        for (auto& m : mutations) {
+            read(m);
+        }
+
+        // The tier is kept within its budget.
+        demote();
+        BOOST_REQUIRE_GT(tracker.get_stats().compressed_partitions, 0);
+        tracker.set_compressed_tier(utils::updateable_value<double>(0));
+        tracker.demote_cold_partitions();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 0);
+        BOOST_REQUIRE_GT(tracker.get_stats().compressed_evictions, 0);
+        for (auto& m : mutations) {
+            read(m);
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_eviction_from_invalidated) {
     return seastar::async([] {
         auto s = make_schema();
@@ -4648,7 +4941,8 @@ SEASTAR_TEST_CASE(test_compact_range_tombstones_on_read) {
             BOOST_REQUIRE(cp.find_row(*s.schema(), ck0) != nullptr);
             BOOST_REQUIRE(cp.find_row(*s.schema(), ck1) == nullptr);
             BOOST_REQUIRE(cp.find_row(*s.schema(), ck2) == nullptr);
-            BOOST_REQUIRE(cp.find_row(*s.schema(), ck3) != nullptr);
+            // ck3 is shadowed by the non-expired rt1, so it is collapsed into it
+            BOOST_REQUIRE(cp.find_row(*s.schema(), ck3) == nullptr);
         }
 
         {
@@ -4660,13 +4954,59 @@ SEASTAR_TEST_CASE(test_compact_range_tombstones_on_read) {
             BOOST_REQUIRE(cp.find_row(*s.schema(), ck0) != nullptr);
             BOOST_REQUIRE(cp.find_row(*s.schema(), ck1) == nullptr);
             BOOST_REQUIRE(cp.find_row(*s.schema(), ck2) == nullptr);
-            BOOST_REQUIRE(cp.find_row(*s.schema(), ck3) != nullptr);
+            BOOST_REQUIRE(cp.find_row(*s.schema(), ck3) == nullptr);
         }
 
         // check tracker stats
         auto &tracker_stats = tracker.get_stats();
         BOOST_REQUIRE(tracker_stats.rows_compacted == 2);
         BOOST_REQUIRE(tracker_stats.rows_compacted_away == 2);
+        BOOST_REQUIRE(tracker_stats.rows_collapsed == 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_cache_collapses_rows_shadowed_by_range_tombstone_on_read) {
+    return seastar::async([] {
+        simple_schema s;
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        auto cache_mt = make_lw_shared<replica::memtable>(s.schema());
+
+        cache_tracker tracker;
+        row_cache cache(s.schema(), snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+
+        auto pk = s.make_pkey(0);
+        auto pr = dht::partition_range::make_singular(pk);
+
+        mutation m(s.schema(), pk);
+        for (int i = 0; i < 10; ++i) {
+            s.add_row(m, s.make_ckey(i), "v");
+        }
+        // Queue-like deletion of the oldest entries, doesn't expire
+        auto rt = s.make_range_tombstone(s.make_ckey_range(0, 7), gc_clock::now());
+        m.partition().apply_delete(*s.schema(), rt);
+        // Written after the deletion, not shadowed
+        s.add_row(m, s.make_ckey(5), "v");
+        cache.populate(m);
+
+        cache_entry& entry = cache.lookup(pk);
+        auto& cp = entry.partition().version()->partition();
+
+        tombstone_gc_state gc_state(nullptr);
+        for (int read = 0; read < 2; ++read) {
+            auto rd = cache.make_reader(s.schema(), semaphore.make_permit(), pr, &gc_state);
+            auto close_rd = deferred_close(rd);
+            auto expected = m;
+            assert_that(std::move(rd)).produces_compacted(expected, gc_clock::now());
+        }
+
+        for (int i = 0; i < 10; ++i) {
+            // ck5 has data newer than the range tombstone, ck8 and ck9 are outside of it
+            bool expected_in_cache = i == 5 || i >= 8;
+            BOOST_REQUIRE_EQUAL(cp.find_row(*s.schema(), s.make_ckey(i)) != nullptr, expected_in_cache);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().rows_collapsed, 7);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().rows_compacted_away, 0);
     });
 }
 
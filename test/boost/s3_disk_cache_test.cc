@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <filesystem>
+
+#include <seastar/core/align.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+#include "test/lib/random_utils.hh"
+#include "test/lib/tmpdir.hh"
+#include "utils/s3/disk_cache.hh"
+
+using namespace std::chrono_literals;
+
+// Any file can stand for an object.
+static file make_object(const tmpdir& tmp, const sstring& data) {
+    auto path = (tmp.path() / "object").native();
+    auto f = open_file_dma(path, open_flags::rw | open_flags::create).get();
+    auto buf = temporary_buffer<char>::aligned(f.memory_dma_alignment(), align_up<size_t>(data.size(), 4096));
+    std::fill_n(buf.get_write(), buf.size(), 0);
+    std::copy_n(data.data(), data.size(), buf.get_write());
+    f.dma_write(0, buf.get(), buf.size()).get();
+    f.truncate(data.size()).get();
+    f.close().get();
+    return open_file_dma(path, open_flags::ro).get();
+}
+
+static sstring read(file& f, uint64_t pos, size_t len) {
+    auto buf = f.dma_read_bulk<char>(pos, len).get();
+    return sstring(buf.get(), buf.size());
+}
+
+static void wait_for_fills(const s3::disk_cache& cache, uint64_t n) {
+    while (cache.get_stats().fills + cache.get_stats().failed_fills < n) {
+        sleep(1ms).get();
+    }
+    BOOST_REQUIRE_EQUAL(cache.get_stats().failed_fills, 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_disk_cache_read_through) {
+    tmpdir tmp;
+    auto data = tests::random::get_sstring(3 * s3::disk_cache::block_size + 1000);
+    auto dir = tmp.path() / "cache";
+
+    {
+        s3::disk_cache cache(dir, 16 * s3::disk_cache::block_size);
+        cache.start().get();
+        auto stop = defer([&] { cache.stop().get(); });
+
+        auto f = cache.wrap(make_object(tmp, data), "/bucket/object");
+        auto close = defer([&] { f.close().get(); });
+
+        // Spans the first two blocks.
+        BOOST_REQUIRE_EQUAL(read(f, 1000, s3::disk_cache::block_size), data.substr(1000, s3::disk_cache::block_size));
+        BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 2);
+        wait_for_fills(cache, 2);
+
+        BOOST_REQUIRE_EQUAL(read(f, 1000, s3::disk_cache::block_size), data.substr(1000, s3::disk_cache::block_size));
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 2);
+
+        // Reads past the end of the object are short.
+        BOOST_REQUIRE_EQUAL(read(f, 3 * s3::disk_cache::block_size, 4096), data.substr(3 * s3::disk_cache::block_size));
+        wait_for_fills(cache, 3);
+        BOOST_REQUIRE_EQUAL(read(f, 3 * s3::disk_cache::block_size, 4096), data.substr(3 * s3::disk_cache::block_size));
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 3);
+        BOOST_REQUIRE_EQUAL(read(f, data.size(), 4096), "");
+    }
+
+    // The cache is kept across restarts.
+    s3::disk_cache cache(dir, 16 * s3::disk_cache::block_size);
+    cache.start().get();
+    auto stop = defer([&] { cache.stop().get(); });
+    BOOST_REQUIRE_EQUAL(cache.get_stats().blocks, 3);
+    // All blocks of the object are kept in one file.
+    BOOST_REQUIRE_EQUAL(cache.get_stats().objects, 1);
+    BOOST_REQUIRE_EQUAL(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 1);
+
+    auto f = cache.wrap(make_object(tmp, data), "/bucket/object");
+    auto close = defer([&] { f.close().get(); });
+    BOOST_REQUIRE_EQUAL(read(f, 0, 2 * s3::disk_cache::block_size), data.substr(0, 2 * s3::disk_cache::block_size));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 2);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 0);
+
+    // Blocks of other objects are not mixed up with those of the object.
+    auto g = cache.wrap(make_object(tmp, data), "/bucket/other");
+    auto close_g = defer([&] { g.close().get(); });
+    BOOST_REQUIRE_EQUAL(read(g, 0, 4096), data.substr(0, 4096));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_disk_cache_eviction) {
+    tmpdir tmp;
+    auto data = tests::random::get_sstring(8 * s3::disk_cache::block_size);
+
+    // The file of the object takes a page of header on top of the blocks.
+    auto dir = tmp.path() / "cache";
+    s3::disk_cache cache(dir, 4096 + 2 * s3::disk_cache::block_size);
+    cache.start().get();
+    auto stop = defer([&] { cache.stop().get(); });
+
+    auto f = cache.wrap(make_object(tmp, data), "/bucket/object");
+    auto close = defer([&] { f.close().get(); });
+    for (uint64_t i = 0; i < 8; ++i) {
+        auto pos = i * s3::disk_cache::block_size;
+        BOOST_REQUIRE_EQUAL(read(f, pos, 4096), data.substr(pos, 4096));
+        wait_for_fills(cache, i + 1);
+        BOOST_REQUIRE_LE(cache.get_stats().blocks, 2);
+    }
+    BOOST_REQUIRE_EQUAL(cache.get_stats().evictions, 6);
+
+    // The most recently read blocks stay.
+    auto pos = 7 * s3::disk_cache::block_size;
+    BOOST_REQUIRE_EQUAL(read(f, pos, 4096), data.substr(pos, 4096));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 1);
+
+    // Evicting all blocks of an object removes its file.
+    auto g = cache.wrap(make_object(tmp, data), "/bucket/other");
+    auto close_g = defer([&] { g.close().get(); });
+    BOOST_REQUIRE_EQUAL(read(g, 0, 4096), data.substr(0, 4096));
+    wait_for_fills(cache, 9);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().evictions, 8);
+    while (std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()) != 1) {
+        sleep(1ms).get();
+    }
+    BOOST_REQUIRE_EQUAL(cache.get_stats().objects, 1);
+}
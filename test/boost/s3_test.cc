@@ -104,8 +104,8 @@ static auto deferred_delete_object(shared_ptr<s3::client> client, sstring name)
     });
 }
 
-void do_test_client_multipart_upload(bool with_copy_upload) {
-    const sstring name(fmt::format("/{}/test{}object-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), with_copy_upload ? "jumbo" : "large", ::getpid()));
+void do_test_client_multipart_upload(bool with_copy_upload, std::optional<uint64_t> size_hint = {}) {
+    const sstring name(fmt::format("/{}/test{}object-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), with_copy_upload ? "jumbo" : (size_hint ? "hinted" : "large"), ::getpid()));
 
     testlog.info("Make client\n");
     semaphore mem(16<<20);
@@ -116,7 +116,7 @@ void do_test_client_multipart_upload(bool with_copy_upload) {
     auto out = output_stream<char>(
         // Make it 3 parts per piece, so that 128Mb buffer below
         // would be split into several 15Mb pieces
-        with_copy_upload ? cln->make_upload_jumbo_sink(name, 3) : cln->make_upload_sink(name)
+        with_copy_upload ? cln->make_upload_jumbo_sink(name, 3) : cln->make_upload_sink(name, size_hint)
     );
     auto close = seastar::deferred_close(out);
 
@@ -160,6 +160,10 @@ SEASTAR_THREAD_TEST_CASE(test_client_multipart_upload) {
     do_test_client_multipart_upload(false);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_client_multipart_upload_with_size_hint) {
+    do_test_client_multipart_upload(false, 128 * 1024 * 1000);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_client_multipart_copy_upload) {
     do_test_client_multipart_upload(true);
 }
@@ -258,6 +262,46 @@ SEASTAR_THREAD_TEST_CASE(test_client_readable_file_stream) {
     BOOST_REQUIRE_EQUAL(res, sample);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_client_readable_file_read_ahead) {
+    const sstring name(fmt::format("/{}/testreadaheadobject-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid()));
+
+    testlog.info("Make client\n");
+    semaphore mem(16<<20);
+    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_minio_config(), mem);
+    auto close_client = deferred_close(*cln);
+
+    testlog.info("Put object {}\n", name);
+    const size_t chunk = 64 << 10;
+    sstring sample = tests::random::get_sstring(32 * chunk + 123);
+    temporary_buffer<char> data(sample.c_str(), sample.size());
+    cln->put_object(name, std::move(data)).get();
+    auto delete_object = deferred_delete_object(cln, name);
+
+    auto f = cln->make_readable_file(name);
+    auto close_readable_file = deferred_close(f);
+
+    testlog.info("Check sequential reads\n");
+    for (size_t pos = 0; pos < sample.size(); pos += chunk) {
+        auto buf = f.dma_read_bulk<char>(pos, chunk).get();
+        BOOST_REQUIRE_EQUAL(to_sstring(std::move(buf)), sample.substr(pos, chunk));
+    }
+
+    testlog.info("Check reads breaking the sequence\n");
+    for (size_t pos : { 3 * chunk, 4 * chunk, 5 * chunk, 17 * chunk + 5, 4 * chunk, 5 * chunk, 6 * chunk }) {
+        auto buf = f.dma_read_bulk<char>(pos, chunk).get();
+        BOOST_REQUIRE_EQUAL(to_sstring(std::move(buf)), sample.substr(pos, chunk));
+    }
+
+    testlog.info("Check concurrent sequential reads\n");
+    file_input_stream_options opts;
+    opts.buffer_size = chunk;
+    opts.read_ahead = 4;
+    auto in = make_file_input_stream(f, opts);
+    auto close_stream = deferred_close(in);
+    auto res = seastar::util::read_entire_stream_contiguous(in).get();
+    BOOST_REQUIRE_EQUAL(res, sample);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_client_put_get_tagging) {
     const sstring name(fmt::format("/{}/testobject-{}",
                                    tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid()));
@@ -1984,3 +1984,61 @@ SEASTAR_TEST_CASE(test_returning_failure_from_ghost_rows_deletion) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_covering_index) {
+    return do_with_cql_env_thread([] (auto& e) {
+        cquery_nofail(e, "CREATE TABLE t (p int, c int, v int, a int, b int, PRIMARY KEY (p, c))");
+        cquery_nofail(e, "CREATE INDEX ON t(v) INCLUDE (a)");
+        cquery_nofail(e, "CREATE INDEX local_v ON t((p), v) INCLUDE (a)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (1, 1, 1, 10, 100)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (1, 2, 1, 20, 200)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (2, 1, 1, 30, 300)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (2, 2, 2, 40, 400)");
+        cquery_nofail(e, "UPDATE t SET a = 21 WHERE p = 1 AND c = 2");
+
+        eventually([&] {
+            // Answered from the index view only.
+            auto msg = cquery_nofail(e, "SELECT p, c, a FROM t WHERE v = 1");
+            assert_that(msg).is_rows().with_rows_ignore_order({
+                {int32_type->decompose(1), int32_type->decompose(1), int32_type->decompose(10)},
+                {int32_type->decompose(1), int32_type->decompose(2), int32_type->decompose(21)},
+                {int32_type->decompose(2), int32_type->decompose(1), int32_type->decompose(30)},
+            });
+            msg = cquery_nofail(e, "SELECT a FROM t WHERE v = 1 AND p = 1");
+            assert_that(msg).is_rows().with_rows_ignore_order({
+                {int32_type->decompose(10)},
+                {int32_type->decompose(21)},
+            });
+            // Needs the base table.
+            msg = cquery_nofail(e, "SELECT a, b FROM t WHERE v = 1 AND p = 2");
+            assert_that(msg).is_rows().with_rows({
+                {int32_type->decompose(30), int32_type->decompose(300)},
+            });
+        });
+
+        // Paging through the index view.
+        auto extract_paging_state = [] (::shared_ptr<cql_transport::messages::result_message> res) {
+            auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(res);
+            auto paging_state = rows->rs().get_metadata().paging_state();
+            assert(paging_state);
+            return make_lw_shared<service::pager::paging_state>(*paging_state);
+        };
+        auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                cql3::query_options::specific_options{1, nullptr, {}, api::new_timestamp()});
+        auto msg = e.execute_cql("SELECT a FROM t WHERE v = 1", std::move(qo)).get();
+        auto paging_state = extract_paging_state(msg);
+        assert_that(msg).is_rows().with_size(1);
+        qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                cql3::query_options::specific_options{2, paging_state, {}, api::new_timestamp()});
+        msg = e.execute_cql("SELECT a FROM t WHERE v = 1", std::move(qo)).get();
+        assert_that(msg).is_rows().with_size(2);
+
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE INDEX ON t(b) INCLUDE (p)").get(), exceptions::invalid_request_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE INDEX ON t(b) INCLUDE (b)").get(), exceptions::invalid_request_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE INDEX ON t(b) INCLUDE (a, a)").get(), exceptions::invalid_request_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE INDEX ON t(b) INCLUDE (x)").get(), exceptions::invalid_request_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE INDEX ON t(c) INCLUDE (a)").get(), exceptions::invalid_request_exception);
+        // Included columns are needed by the index view.
+        BOOST_REQUIRE_THROW(e.execute_cql("ALTER TABLE t DROP a").get(), exceptions::invalid_request_exception);
+    });
+}
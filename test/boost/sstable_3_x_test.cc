@@ -3749,6 +3749,60 @@ SEASTAR_TEST_CASE(test_write_many_partitions_zstd) {
             })});
 }
 
+SEASTAR_TEST_CASE(test_write_many_partitions_zstd_with_dictionary) {
+  return test_env::do_with_async([] (test_env& env) {
+    // CREATE TABLE many_partitions_zstd_with_dictionary (pk int, PRIMARY KEY (pk))
+    //     WITH compression = {'sstable_compression': 'ZstdCompressor', 'dictionary_size_in_kb': 4};
+    schema_builder builder("sst3", "many_partitions_zstd_with_dictionary");
+    builder.with_column("pk", int32_type, column_kind::partition_key);
+    builder.set_compressor_params(compression_parameters{compressor::create({
+        {"sstable_compression", "org.apache.cassandra.io.compress.ZstdCompressor"},
+        {"dictionary_size_in_kb", "4"}
+    })});
+    schema_ptr s = builder.build(schema_builder::compact_storage::no);
+
+    std::vector<mutation> muts;
+    for (auto i : boost::irange(0, 65536)) {
+        auto key = partition_key::from_deeply_exploded(*s, {i});
+        muts.emplace_back(s, key);
+    }
+    boost::sort(muts, mutation_decorated_key_less_comparator());
+
+    auto dictionary_of = [] (const shared_sstable& sst) {
+        auto opts = sst->get_compression().get_compressor()->options();
+        auto i = opts.find("dictionary");
+        return i == opts.end() ? sstring() : i->second;
+    };
+
+    for (auto version : test_sstable_versions) {
+        // Dictionaries are only trained once the whole cluster can read them.
+        auto sst = make_sstable_easy(env, make_memtable(s, muts), env.manager().configure_writer(), version, muts.size());
+        BOOST_REQUIRE(dictionary_of(sst).empty());
+        validate_read(env, sst, muts);
+
+        auto cfg = env.manager().configure_writer();
+        cfg.compression_dictionaries = true;
+        sst = make_sstable_easy(env, make_memtable(s, muts), std::move(cfg), version, muts.size());
+        BOOST_REQUIRE(!dictionary_of(sst).empty());
+
+        // The chunks can be decompressed only with the trained dictionary.
+        auto& c = sst->get_compression();
+        BOOST_REQUIRE_GE(c.offsets.size(), 2);
+        auto offset = c.offsets.get_accessor().at(0);
+        auto len = c.offsets.get_accessor().at(1) - offset - 4; // without the checksum
+        auto f = open_file_dma(sstables::test(sst).filename(component_type::Data).native(), open_flags::ro).get();
+        auto close_f = deferred_close(f);
+        auto chunk = f.dma_read_exactly<char>(offset, len).get();
+        std::vector<char> uncompressed(c.uncompressed_chunk_length());
+        auto plain_zstd = compressor::create({{"sstable_compression", "org.apache.cassandra.io.compress.ZstdCompressor"}});
+        BOOST_REQUIRE_THROW(plain_zstd->uncompress(chunk.get(), chunk.size(), uncompressed.data(), uncompressed.size()), std::runtime_error);
+        BOOST_REQUIRE_GT(c.get_compressor()->uncompress(chunk.get(), chunk.size(), uncompressed.data(), uncompressed.size()), 0);
+
+        validate_read(env, sst, muts);
+    }
+  });
+}
+
 SEASTAR_TEST_CASE(test_write_multiple_rows) {
   return test_env::do_with_async([] (test_env& env) {
     sstring table_name = "multiple_rows";
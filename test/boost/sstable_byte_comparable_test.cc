@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include "sstables/trie/byte_comparable.hh"
+#include "test/lib/simple_schema.hh"
+
+using namespace sstables::trie;
+
+SEASTAR_THREAD_TEST_CASE(test_decorated_key_order) {
+    simple_schema ss;
+    auto& s = *ss.schema();
+    auto keys = ss.make_pkeys(1000);
+    keys.push_back(ss.make_pkey(sstring("a\0b", 3)));
+    keys.push_back(ss.make_pkey(sstring("a", 1)));
+    keys.push_back(ss.make_pkey(sstring("")));
+    std::ranges::sort(keys, dht::decorated_key::less_comparator(ss.schema()));
+
+    for (size_t i = 1; i < keys.size(); ++i) {
+        auto lo = encode(s, keys[i - 1]);
+        auto hi = encode(s, keys[i]);
+        BOOST_REQUIRE(keys[i - 1].tri_compare(s, keys[i]) < 0);
+        BOOST_REQUIRE(compare_unsigned(lo, hi) < 0);
+        BOOST_REQUIRE(!bytes_view(hi).starts_with(bytes_view(lo)));
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_clustering_key_order) {
+    simple_schema ss;
+    auto& s = *ss.schema();
+    auto keys = ss.make_ckeys(1000);
+    keys.push_back(clustering_key::make_empty());
+    keys.push_back(ss.make_ckey(sstring("a\0b", 3)));
+    keys.push_back(ss.make_ckey(sstring("a", 1)));
+    std::ranges::sort(keys, clustering_key::less_compare(s));
+
+    for (size_t i = 1; i < keys.size(); ++i) {
+        auto lo = encode(s, keys[i - 1]);
+        auto hi = encode(s, keys[i]);
+        BOOST_REQUIRE(compare_unsigned(lo, hi) < 0);
+        BOOST_REQUIRE(!bytes_view(hi).starts_with(bytes_view(lo)));
+    }
+}
@@ -23,6 +23,7 @@
 #include <seastar/testing/thread_test_case.hh>
 #include "schema/schema.hh"
 #include "schema/schema_builder.hh"
+#include "cdc/cdc_partitioner.hh"
 #include "replica/database.hh"
 #include "compaction/leveled_manifest.hh"
 #include "sstables/metadata_collector.hh"
@@ -37,6 +38,7 @@
 #include "partition_slice_builder.hh"
 #include "compaction/time_window_compaction_strategy.hh"
 #include "compaction/leveled_compaction_strategy.hh"
+#include "compaction/incremental_compaction_strategy.hh"
 #include "test/lib/mutation_assertions.hh"
 #include "counters.hh"
 #include "test/lib/simple_schema.hh"
@@ -61,6 +63,7 @@
 #include <seastar/testing/test_case.hh>
 #include "test/lib/test_services.hh"
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
@@ -808,6 +811,53 @@ SEASTAR_TEST_CASE(leveled_07) {
   });
 }
 
+SEASTAR_TEST_CASE(leveled_claimed_spans) {
+    // Test that compactions into a level don't overlap the span a running compaction writes into
+  return test_env::do_with_async([] (test_env& env) {
+    auto cf = env.make_table_for_tests();
+    auto stop_cf = deferred_stop(cf);
+
+    auto max_sstable_size_in_mb = 1;
+    auto max_sstable_size_in_bytes = max_sstable_size_in_mb*1024*1024;
+    auto max_bytes_for_l1 = leveled_manifest::max_bytes_for_level(1, max_sstable_size_in_bytes);
+
+    // Two disjoint L1 sstables, which make L1 exceed its size
+    auto keys = tests::generate_partition_keys(2, cf.schema());
+    auto sst1 = add_sstable_for_leveled_test(env, cf, max_bytes_for_l1, /*level*/1, keys[0].key(), keys[0].key());
+    auto sst2 = add_sstable_for_leveled_test(env, cf, max_bytes_for_l1, /*level*/1, keys[1].key(), keys[1].key());
+
+    auto candidates = get_candidates_for_leveled_strategy(*cf);
+    sstables::size_tiered_compaction_strategy_options stcs_options;
+    std::vector<std::optional<dht::decorated_key>> last_compacted_keys(leveled_manifest::MAX_LEVELS);
+    std::vector<int> compaction_counter(leveled_manifest::MAX_LEVELS);
+
+    auto get_candidate = [&] (std::vector<leveled_manifest::claimed_span> spans) {
+        leveled_manifest manifest = leveled_manifest::create(cf.as_table_state(), candidates, max_sstable_size_in_mb, stcs_options);
+        manifest.set_claimed_spans(std::move(spans));
+        return manifest.get_compaction_candidates(last_compacted_keys, compaction_counter);
+    };
+
+    auto desc = get_candidate({});
+    BOOST_REQUIRE(desc.level == 2);
+    BOOST_REQUIRE(desc.sstables.size() == 1);
+    BOOST_REQUIRE(desc.sstables[0] == sst1);
+
+    // A compaction is writing the span of sst1 into L2, so sst2 is picked instead
+    desc = get_candidate({{2, keys[0].token(), keys[0].token()}});
+    BOOST_REQUIRE(desc.level == 2);
+    BOOST_REQUIRE(desc.sstables.size() == 1);
+    BOOST_REQUIRE(desc.sstables[0] == sst2);
+
+    // Spans claimed in other levels don't matter
+    desc = get_candidate({{1, keys[0].token(), keys[0].token()}, {3, keys[0].token(), keys[1].token()}});
+    BOOST_REQUIRE(desc.sstables.size() == 1);
+    BOOST_REQUIRE(desc.sstables[0] == sst1);
+
+    desc = get_candidate({{2, keys[0].token(), keys[1].token()}});
+    BOOST_REQUIRE(desc.sstables.empty());
+  });
+}
+
 SEASTAR_TEST_CASE(leveled_invariant_fix) {
   return test_env::do_with_async([] (test_env& env) {
     auto cf = env.make_table_for_tests();
@@ -1317,6 +1367,35 @@ SEASTAR_TEST_CASE(get_fully_expired_sstables_test) {
   });
 }
 
+SEASTAR_TEST_CASE(get_fully_expired_sstables_of_cdc_log_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto s = schema_builder("ks", "cf_scylla_cdc_log")
+            .with_partitioner(cdc::cdc_partitioner::classname)
+            .with_column("stream_id", bytes_type, column_kind::partition_key)
+            .with_column("v", int32_type)
+            .build();
+    auto key = partition_key::from_single_value(*s, bytes(16, int8_t(0)));
+
+    auto t0 = gc_clock::from_time_t(1).time_since_epoch().count();
+    auto t1 = gc_clock::from_time_t(10).time_since_epoch().count();
+    auto t3 = gc_clock::from_time_t(20).time_since_epoch().count();
+    auto t4 = gc_clock::from_time_t(30).time_since_epoch().count();
+
+    auto cf = env.make_table_for_tests(s);
+    auto close_cf = deferred_stop(cf);
+
+    // sst2 holds live data older than the expired sst1, which would prevent
+    // dropping sst1 in a regular table (see get_fully_expired_sstables_test).
+    auto sst1 = add_sstable_for_overlapping_test(env, cf, key, key, build_stats(t0, t1, t1));
+    auto sst2 = add_sstable_for_overlapping_test(env, cf, key, key, build_stats(t0, t1, std::numeric_limits<int32_t>::max()));
+    auto sst3 = add_sstable_for_overlapping_test(env, cf, key, key, build_stats(t3, t4, std::numeric_limits<int32_t>::max()));
+    std::vector<sstables::shared_sstable> compacting = { sst1, sst2 };
+    auto expired = get_fully_expired_sstables(cf.as_table_state(), compacting, /*gc before*/gc_clock::from_time_t(15) + cf->schema()->gc_grace_seconds());
+    BOOST_REQUIRE_EQUAL(expired.size(), 1);
+    BOOST_REQUIRE(*expired.begin() == sst1);
+  });
+}
+
 SEASTAR_TEST_CASE(compaction_with_fully_expired_table) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("la", "cf")
@@ -1674,6 +1753,96 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(incremental_compaction_strategy_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto builder = schema_builder("tests", "ics")
+            .with_column("p1", utf8_type, column_kind::partition_key)
+            .with_column("r1", int32_type);
+    builder.set_compaction_strategy(sstables::compaction_strategy_type::incremental);
+    builder.set_compaction_strategy_options({{ incremental_compaction_strategy::SSTABLE_SIZE_OPTION, "1" }});
+    auto s = builder.build();
+    auto cf = env.make_table_for_tests(s);
+    auto stop_cf = deferred_stop(cf);
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::incremental, s->compaction_strategy_options());
+
+    BOOST_REQUIRE_THROW(sstables::compaction_strategy_impl::validate_options_for_strategy_type(
+            {{ incremental_compaction_strategy::SSTABLE_SIZE_OPTION, "0" }}, sstables::compaction_strategy_type::incremental),
+            exceptions::configuration_exception);
+
+    // 4 runs of similar size, each made of 4 disjoint fragments.
+    const auto keys = tests::generate_partition_keys(8, s);
+    const unsigned runs = 4, fragments = keys.size() / 2;
+    for (unsigned r = 0; r < runs; r++) {
+        auto id = sstables::run_id::create_random_id();
+        for (unsigned f = 0; f < fragments; f++) {
+            auto sst = env.make_sstable(s);
+            sstables::test(sst).set_values(keys[f * 2].key(), keys[f * 2 + 1].key(), {});
+            sstables::test(sst).set_run_identifier(id);
+            column_family_test(cf).add_sstable(sst).get();
+        }
+    }
+    BOOST_REQUIRE_EQUAL(cf->get_sstables()->size(), runs * fragments);
+    BOOST_REQUIRE_EQUAL(cs.estimated_pending_compactions(cf.as_table_state()), 1);
+
+    auto control = make_strategy_control_for_test(false);
+    auto desc = cs.get_sstables_for_compaction(cf.as_table_state(), *control);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), runs * fragments);
+    BOOST_REQUIRE_EQUAL(desc.fan_in(), runs);
+    // Output is split into fragments, so exhausted input can be released early.
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, uint64_t(1024 * 1024));
+
+    auto major = cs.get_major_compaction_job(cf.as_table_state(), boost::copy_range<std::vector<shared_sstable>>(*cf->get_sstables()));
+    BOOST_REQUIRE_EQUAL(major.max_sstable_bytes, uint64_t(1024 * 1024));
+
+    auto cleanup_jobs = cs.get_cleanup_compaction_jobs(cf.as_table_state(), boost::copy_range<std::vector<shared_sstable>>(*cf->get_sstables()));
+    BOOST_REQUIRE_EQUAL(cleanup_jobs.size(), runs);
+    for (auto& job : cleanup_jobs) {
+        BOOST_REQUIRE_EQUAL(job.fan_in(), 1);
+        BOOST_REQUIRE_EQUAL(job.sstables.size(), fragments);
+    }
+  });
+}
+
+SEASTAR_TEST_CASE(incremental_compaction_strategy_tombstone_gc_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto builder = schema_builder("tests", "ics_gc")
+            .with_column("p1", utf8_type, column_kind::partition_key)
+            .with_column("r1", int32_type);
+    builder.set_compaction_strategy(sstables::compaction_strategy_type::incremental);
+    builder.set_compaction_strategy_options({{ compaction_strategy_impl::UNCHECKED_TOMBSTONE_COMPACTION_OPTION, "true" }});
+    auto s = builder.build();
+    auto cf = env.make_table_for_tests(s);
+    auto stop_cf = deferred_stop(cf);
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::incremental, s->compaction_strategy_options());
+
+    // A single run, of which only every other fragment is old enough for
+    // tombstone compaction.
+    const auto keys = tests::generate_partition_keys(8, s);
+    auto id = sstables::run_id::create_random_id();
+    std::unordered_set<shared_sstable> droppable;
+    for (unsigned f = 0; f < keys.size() / 2; f++) {
+        auto sst = env.make_sstable(s);
+        sstables::test(sst).set_values(keys[f * 2].key(), keys[f * 2 + 1].key(), {});
+        sstables::test(sst).set_run_identifier(id);
+        if (f % 2) {
+            sstables::test(sst).set_data_file_write_time(db_clock::now() - std::chrono::days(2));
+            droppable.insert(sst);
+        } else {
+            sstables::test(sst).set_data_file_write_time(db_clock::now());
+        }
+        column_family_test(cf).add_sstable(sst).get();
+    }
+
+    // Only the droppable fragments are rewritten, not the whole run.
+    auto control = make_strategy_control_for_test(false);
+    auto desc = cs.get_sstables_for_compaction(cf.as_table_state(), *control);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), droppable.size());
+    for (auto& sst : desc.sstables) {
+        BOOST_REQUIRE(droppable.contains(sst));
+    }
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto make_schema = [&] (std::string_view cf, sstables::compaction_strategy_type cst) {
@@ -1904,6 +2073,43 @@ SEASTAR_TEST_CASE(compaction_correctness_with_partitioned_sstable_set) {
     });
 }
 
+SEASTAR_TEST_CASE(subrange_major_compaction_test) {
+    auto cfg = make_shared<db::config>();
+    cfg->compaction_subrange_parallelism(4);
+    cfg->compaction_subrange_min_size_in_mb(0);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (pk int PRIMARY KEY, v int)").get();
+        const int partitions = 400;
+        for (int round = 0; round < 4; round++) {
+            for (int pk = 0; pk < partitions; pk++) {
+                e.execute_cql(format("INSERT INTO ks.t (pk, v) VALUES ({}, {})", pk, round)).get();
+            }
+            e.db().invoke_on_all([] (replica::database& db) {
+                return db.flush_all_memtables();
+            }).get();
+        }
+
+        auto results = e.db().map([] (replica::database& db) -> future<std::pair<size_t, size_t>> {
+            auto& t = db.find_column_family("ks", "t");
+            co_await db.get_compaction_manager().perform_major_compaction(t.try_get_table_state_with_static_sharding());
+            auto sstables = t.get_sstables();
+            auto run_ids = boost::copy_range<std::unordered_set<sstables::run_id>>(*sstables
+                    | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::run_identifier)));
+            co_return std::make_pair(sstables->size(), run_ids.size());
+        }).get();
+        // Sub-range compactions write disjoint fragments of a single run.
+        for (auto [sstable_count, run_count] : results) {
+            BOOST_REQUIRE_GT(sstable_count, 1);
+            BOOST_REQUIRE_EQUAL(run_count, 1);
+        }
+
+        auto msg = e.execute_cql("SELECT count(*) FROM ks.t WHERE v = 3 ALLOW FILTERING").get();
+        assert_that(msg).is_rows().with_rows({{ long_type->decompose(int64_t(partitions)) }});
+        msg = e.execute_cql("SELECT count(*) FROM ks.t").get();
+        assert_that(msg).is_rows().with_rows({{ long_type->decompose(int64_t(partitions)) }});
+    }, cfg);
+}
+
 SEASTAR_TEST_CASE(sstable_cleanup_correctness_test) {
     return do_with_cql_env([] (auto& e) {
         return test_env::do_with_async([&db = e.local_db()] (test_env& env) {
@@ -1967,6 +2173,43 @@ SEASTAR_TEST_CASE(sstable_cleanup_correctness_test) {
     });
 }
 
+SEASTAR_TEST_CASE(sstable_cleanup_of_disowned_sstable_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("ks", "cleanup_of_disowned_sstable_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto keys = tests::generate_partition_keys(4, s);
+        auto make_insert = [&] (const dht::decorated_key& key) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), api::timestamp_type(0));
+            return m;
+        };
+        auto disowned = make_sstable_containing(sst_gen, {make_insert(keys[0]), make_insert(keys[1])});
+        auto owned = make_sstable_containing(sst_gen, {make_insert(keys[2]), make_insert(keys[3])});
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        // Owns the tokens of the second sstable only
+        dht::token_range_vector ranges;
+        ranges.push_back(dht::token_range::make(keys[2].token(), keys[3].token()));
+        auto descriptor = sstables::compaction_descriptor({disowned, owned}, compaction_descriptor::default_level,
+                compaction_descriptor::default_max_sstable_bytes, sstables::run_id::create_random_id(),
+                compaction_type_options::make_cleanup(), compaction::make_owned_ranges_ptr(std::move(ranges)));
+        auto ret = compact_sstables(env, std::move(descriptor), cf, sst_gen).get();
+
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+        auto reader = ret.new_sstables[0]->as_mutation_source().make_reader_v2(s, env.make_reader_permit(), query::full_partition_range, s->full_slice());
+        assert_that(std::move(reader))
+                .produces(keys[2])
+                .produces(keys[3])
+                .produces_end_of_stream();
+    });
+}
+
 future<> foreach_table_state_with_thread(table_for_tests& table, std::function<void(compaction::table_state&)> action) {
     return table->parallel_foreach_table_state([action] (compaction::table_state& ts) {
         return seastar::async([action, &ts] {
@@ -2129,6 +2372,49 @@ SEASTAR_THREAD_TEST_CASE(sstable_scrub_validate_mode_test) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(sstable_scrub_validate_checksums_mode_test) {
+    scrub_test_framework test;
+
+    auto schema = test.schema();
+
+    auto muts = tests::generate_random_mutations(
+            test.random_schema(),
+            tests::uncompactible_timestamp_generator(test.seed()),
+            tests::no_expiry_expiry_generator(),
+            std::uniform_int_distribution<size_t>(10, 10)).get();
+    std::swap(*muts.begin(), *(muts.begin() + 1));
+
+    test.run(schema, muts, [] (table_for_tests& table, compaction::table_state& ts, std::vector<sstables::shared_sstable> sstables) {
+        BOOST_REQUIRE(sstables.size() == 1);
+        auto sst = sstables.front();
+
+        // The partitions are out of order, but the checksums are valid, and they are all that is checked.
+        sstables::compaction_type_options::scrub opts = {
+            .operation_mode = sstables::compaction_type_options::scrub::mode::validate,
+            .validate_checksums_only = sstables::compaction_type_options::scrub::checksums_only::yes,
+        };
+        table->get_compaction_manager().perform_sstable_scrub(ts, opts).get();
+
+        BOOST_REQUIRE(!sst->is_quarantined());
+        BOOST_REQUIRE_EQUAL(in_strategy_sstables(ts).size(), 1);
+        BOOST_REQUIRE_EQUAL(in_strategy_sstables(ts).front(), sst);
+
+        { // corrupt a chunk of the data file
+            auto sst_file = open_file_dma(sstables::test(sst).filename(sstables::component_type::Data).native(), open_flags::wo).get();
+            auto close_sst_file = deferred_close(sst_file);
+            const auto size = std::min(sst->ondisk_data_size() / 2, uint64_t(1024));
+            auto buf = temporary_buffer<char>::aligned(sst_file.disk_write_dma_alignment(), size);
+            std::fill(buf.get_write(), buf.get_write() + size, 0xba);
+            sst_file.dma_write(sst->ondisk_data_size() / 2, buf.begin(), buf.size()).get();
+        }
+
+        table->get_compaction_manager().perform_sstable_scrub(ts, opts).get();
+
+        BOOST_REQUIRE(sst->is_quarantined());
+        BOOST_REQUIRE(in_strategy_sstables(ts).empty());
+    });
+}
+
 SEASTAR_THREAD_TEST_CASE(sstable_scrub_validate_mode_test_valid_sstable) {
     scrub_test_framework test;
 
@@ -4472,6 +4758,46 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test_leveled) {
     return run_controller_test(sstables::compaction_strategy_type::leveled);
 }
 
+SEASTAR_THREAD_TEST_CASE(backlog_controller_feedback_test) {
+    using namespace std::chrono_literals;
+    auto sg = create_scheduling_group("backlog_controller_feedback_test", 100).get();
+    auto destroy_sg = defer([&] { destroy_scheduling_group(sg).get(); });
+
+    // The curve maps the target to 100 shares and the backlog to less than 150.
+    float backlog = 3;
+    compaction_controller curve(sg, 0, 1ms, [&] { return backlog; });
+
+    utils::updateable_value_source<float> target(1.5);
+    compaction_controller feedback(sg, 0, 1ms, [&] { return backlog; }, backlog_controller::feedback_config{
+        .target_backlog = utils::updateable_value<float>(target),
+    });
+    auto stop_controllers = defer([&] {
+        curve.shutdown().get();
+        feedback.shutdown().get();
+    });
+
+    sleep(50ms).get();
+    BOOST_REQUIRE_LT(curve.last_shares(), 150);
+    // Above the target, the loop pushes the shares above the curve, and keeps pushing while the error persists.
+    auto shares = feedback.last_shares();
+    BOOST_REQUIRE_GT(shares, 300);
+    BOOST_REQUIRE_GT(feedback.integral_error(), 0);
+    sleep(50ms).get();
+    BOOST_REQUIRE_GT(feedback.last_shares(), shares);
+    BOOST_REQUIRE_LE(feedback.last_shares(), 1000);
+
+    // Below the target, it backs off below the curve's output at the target.
+    backlog = 0.5;
+    sleep(50ms).get();
+    BOOST_REQUIRE_LT(feedback.last_shares(), 100);
+
+    // Disabling the loop live falls back to the curve.
+    target.set(0);
+    sleep(50ms).get();
+    BOOST_REQUIRE_EQUAL(feedback.last_shares(), curve.last_shares());
+    BOOST_REQUIRE_EQUAL(feedback.integral_error(), 0);
+}
+
 SEASTAR_TEST_CASE(test_compaction_strategy_cleanup_method) {
     return test_env::do_with_async([] (test_env& env) {
         constexpr size_t all_files = 64;
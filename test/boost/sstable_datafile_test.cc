@@ -38,6 +38,8 @@
 #include "dht/ring_position.hh"
 #include "partition_slice_builder.hh"
 #include "replica/memtable-sstable.hh"
+#include "utils/i_filter.hh"
+#include "db/bloom_filter_extension.hh"
 
 #include <stdio.h>
 #include <ftw.h>
@@ -3178,6 +3180,76 @@ SEASTAR_TEST_CASE(test_sstable_set_predicate) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_bloom_filter_batched_is_present) {
+    auto filter = utils::i_filter::get_filter(1000, 0.01, utils::filter_format::m_format);
+    std::vector<utils::hashed_key> keys;
+    for (int i = 0; i < 1000; ++i) {
+        auto key = to_bytes(format("key{}", i));
+        if (i % 2 == 0) {
+            filter->add(key);
+        }
+        keys.push_back(utils::make_hashed_key(key));
+    }
+
+    std::unique_ptr<bool[]> results(new bool[keys.size()]);
+    filter->is_present(keys, std::span<bool>(results.get(), keys.size()));
+    for (size_t i = 0; i < keys.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(results[i], filter->is_present(keys[i]));
+        if (i % 2 == 0) {
+            BOOST_REQUIRE(results[i]);
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_blocked_bloom_filter) {
+    auto filter = utils::i_filter::get_filter(10000, 0.01, utils::filter_format::m_format, utils::filter_layout::blocked);
+    for (int i = 0; i < 10000; ++i) {
+        filter->add(to_bytes(format("key{}", i)));
+    }
+    for (int i = 0; i < 10000; ++i) {
+        BOOST_REQUIRE(filter->is_present(to_bytes(format("key{}", i))));
+    }
+    int false_positives = 0;
+    for (int i = 10000; i < 20000; ++i) {
+        false_positives += filter->is_present(to_bytes(format("key{}", i)));
+    }
+    // Allow for some slack over the requested 1%.
+    BOOST_REQUIRE_LT(false_positives, 200);
+}
+
+SEASTAR_TEST_CASE(test_sstable_with_blocked_bloom_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("ks", "cf")
+                .with_column("pk", utf8_type, column_kind::partition_key)
+                .with_column("v", utf8_type)
+                .add_extension(db::bloom_filter_extension::NAME, ::make_shared<db::bloom_filter_extension>(utils::filter_layout::blocked))
+                .build();
+        BOOST_REQUIRE(s->bloom_filter_layout() == utils::filter_layout::blocked);
+
+        std::vector<mutation> muts;
+        for (int i = 0; i < 100; ++i) {
+            auto key = partition_key::from_single_value(*s, utf8_type->decompose(format("key{}", i)));
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), "v", data_value(format("value{}", i)), api::new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        // The classic layout is used until the whole cluster can read the blocked one.
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+        sst = env.reusable_sst(sst).get();
+        BOOST_REQUIRE(sst->get_scylla_metadata()->get_bloom_filter_layout() == sstables::bloom_filter_layout::classic);
+
+        auto cfg = env.manager().configure_writer();
+        cfg.blocked_bloom_filters = true;
+        sst = make_sstable_easy(env, make_memtable(s, muts), std::move(cfg), sstables::get_highest_sstable_version(), muts.size());
+        sst = env.reusable_sst(sst).get();
+
+        BOOST_REQUIRE(sst->get_scylla_metadata()->get_bloom_filter_layout() == sstables::bloom_filter_layout::blocked);
+        for (const auto& m : muts) {
+            BOOST_REQUIRE(sst->filter_has_key(*s, m.key()));
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_sstable_reclaim_memory_from_components_and_reload_reclaimed_components) {
     return test_env::do_with_async([] (test_env& env) {
         simple_schema ss;
@@ -3205,6 +3277,33 @@ SEASTAR_TEST_CASE(test_sstable_reclaim_memory_from_components_and_reload_reclaim
     });
 }
 
+SEASTAR_TEST_CASE(test_sstable_deferred_bloom_filter_loading) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        std::vector<mutation> muts;
+        for (int i = 0; i < 100; ++i) {
+            muts.push_back(ss.new_mutation(format("key{}", i)));
+            ss.add_row(muts.back(), ss.make_ckey(0), "v");
+        }
+        auto written = make_sstable_containing(env.make_sstable(s), muts);
+
+        auto sst = env.make_sstable(s, written->get_storage().prefix(), written->generation(), written->get_version());
+        sst->load(s->get_sharder(), sstable_open_config{ .defer_bloom_filter_loading = true }).get();
+
+        // The filter is loaded in the background, reads are correct meanwhile
+        for (const auto& m : muts) {
+            BOOST_REQUIRE(sst->filter_has_key(*s, m.key()));
+        }
+        REQUIRE_EVENTUALLY_EQUAL(sst->filter_memory_size() > 0, true);
+        BOOST_REQUIRE_EQUAL(env.manager().get_total_memory_reclaimed(), 0);
+        for (const auto& m : muts) {
+            BOOST_REQUIRE(sst->filter_has_key(*s, m.key()));
+        }
+    });
+}
+
 std::pair<shared_sstable, size_t> create_sstable_with_bloom_filter(test_env& env, test_env_sstables_manager& sst_mgr, schema_ptr sptr, uint64_t estimated_partitions) {
     auto sst = env.make_sstable(sptr);
     sstables::test(sst).create_bloom_filter(estimated_partitions);
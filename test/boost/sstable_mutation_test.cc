@@ -1624,3 +1624,97 @@ SEASTAR_TEST_CASE(writer_handles_subsequent_range_tombstone_changes_without_tomb
     });
 }
 
+
+SEASTAR_TEST_CASE(test_values_of_unselected_columns_are_dropped_when_bypassing_cache) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            auto s = schema_builder("ks", "test")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v1", int32_type)
+                .with_column("v2", utf8_type)
+                .build();
+            auto& v1 = *s->get_column_definition("v1");
+            auto& v2 = *s->get_column_definition("v2");
+
+            auto dk = dht::decorate_key(*s, partition_key::from_exploded(*s, {int32_type->decompose(1)}));
+            auto ck1 = clustering_key::from_exploded(*s, {int32_type->decompose(1)});
+            auto ck2 = clustering_key::from_exploded(*s, {int32_type->decompose(2)});
+            mutation m(s, dk);
+            // The first row has no marker, only the unselected column keeps it alive.
+            m.set_clustered_cell(ck1, v2, atomic_cell::make_live(*utf8_type, 1, utf8_type->decompose(sstring("a")), {}));
+            m.set_clustered_cell(ck2, v1, atomic_cell::make_live(*int32_type, 1, int32_type->decompose(2), {}));
+            m.set_clustered_cell(ck2, v2, atomic_cell::make_live(*utf8_type, 1, utf8_type->decompose(sstring("b")), {}));
+
+            auto ms = make_sstable_mutation_source(env, s, {m}, version);
+            auto pr = dht::partition_range::make_singular(dk);
+
+            auto slice = partition_slice_builder(*s).with_regular_column("v1").build();
+            assert_that(ms.make_reader_v2(s, env.make_reader_permit(), pr, slice))
+                .produces(m)
+                .produces_end_of_stream();
+
+            mutation projected(s, dk);
+            projected.set_clustered_cell(ck1, v2, atomic_cell::make_live(*utf8_type, 1, bytes(), {}));
+            projected.set_clustered_cell(ck2, v1, atomic_cell::make_live(*int32_type, 1, int32_type->decompose(2), {}));
+            projected.set_clustered_cell(ck2, v2, atomic_cell::make_live(*utf8_type, 1, bytes(), {}));
+
+            // Mutation reads, e.g. for read repair, get all the values.
+            slice = partition_slice_builder(*s).with_regular_column("v1")
+                .with_option<query::partition_slice::option::bypass_cache>()
+                .build();
+            assert_that(ms.make_reader_v2(s, env.make_reader_permit(), pr, slice))
+                .produces(m)
+                .produces_end_of_stream();
+
+            slice = partition_slice_builder(*s).with_regular_column("v1")
+                .with_option<query::partition_slice::option::bypass_cache>()
+                .with_option<query::partition_slice::option::skip_unselected_column_values>()
+                .build();
+            assert_that(ms.make_reader_v2(s, env.make_reader_permit(), pr, slice))
+                .produces(projected)
+                .produces_end_of_stream();
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_column_value_ranges) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            auto s = schema_builder("ks", "test")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v1", long_type)
+                .with_column("v2", utf8_type)
+                .with_column("v3", int32_type)
+                .build();
+            auto& v1 = *s->get_column_definition("v1");
+            auto& v2 = *s->get_column_definition("v2");
+            auto& v3 = *s->get_column_definition("v3");
+
+            auto dk = dht::decorate_key(*s, partition_key::from_exploded(*s, {int32_type->decompose(1)}));
+            mutation m(s, dk);
+            for (int64_t v : {5, -3, 17, 2}) {
+                auto ck = clustering_key::from_exploded(*s, {int32_type->decompose(int32_t(v))});
+                m.set_clustered_cell(ck, v1, atomic_cell::make_live(*long_type, 1, long_type->decompose(v), {}));
+                m.set_clustered_cell(ck, v2, atomic_cell::make_live(*utf8_type, 1, utf8_type->decompose(sstring("a")), {}));
+            }
+            // Dead cells have no value.
+            m.set_clustered_cell(clustering_key::from_exploded(*s, {int32_type->decompose(0)}), v1, atomic_cell::make_dead(1, gc_clock::now()));
+            m.set_clustered_cell(clustering_key::from_exploded(*s, {int32_type->decompose(0)}), v3, atomic_cell::make_dead(1, gc_clock::now()));
+
+            auto cfg = env.manager().configure_writer();
+            cfg.column_value_ranges = true;
+            auto sst = make_sstable_easy(env, make_memtable(s, {m}), cfg, version);
+            sst = env.reusable_sst(sst).get();
+
+            auto* ranges = sst->get_scylla_metadata()->get_column_value_ranges();
+            BOOST_REQUIRE(ranges);
+            // Variable-size columns, and columns without live cells, are not recorded.
+            BOOST_REQUIRE_EQUAL(ranges->map.size(), 1);
+            auto& range = ranges->map.at(sstables::disk_string<uint32_t>{v1.name()});
+            BOOST_REQUIRE(range.min.value == long_type->decompose(int64_t(-3)));
+            BOOST_REQUIRE(range.max.value == long_type->decompose(int64_t(17)));
+        }
+    });
+}
@@ -12,6 +12,7 @@
 #include <seastar/testing/thread_test_case.hh>
 
 #include "sstables/partition_index_cache.hh"
+#include "sstables/promoted_index_block_cache.hh"
 #include "test/lib/simple_schema.hh"
 
 using namespace sstables;
@@ -272,3 +273,52 @@ SEASTAR_THREAD_TEST_CASE(test_evict_gently) {
 
     cache.evict_gently().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_promoted_index_block_cache) {
+    ::lru lru;
+    simple_schema s;
+    logalloc::region r;
+    promoted_index_block_cache_stats stats;
+    promoted_index_block_cache cache(lru, r, stats);
+
+    auto start0 = position_in_partition::for_key(s.make_ckey(0));
+    auto start1 = position_in_partition::before_key(s.make_ckey(1));
+    position_in_partition::equal_compare eq(*s.schema());
+
+    BOOST_REQUIRE(!cache.get({100, 0}));
+    BOOST_REQUIRE_EQUAL(stats.misses, 1);
+
+    cache.insert({100, 0}, 8, start0);
+    cache.insert({100, 1}, 16, start1);
+    cache.insert({200, 0}, 8, start1);
+    cache.insert({100, 0}, 24, start1); // already cached
+    BOOST_REQUIRE_EQUAL(stats.populations, 3);
+    BOOST_REQUIRE_EQUAL(stats.block_count, 3);
+    BOOST_REQUIRE(stats.used_bytes > 0);
+
+    r.full_compaction();
+
+    auto b = cache.get({100, 0});
+    BOOST_REQUIRE(b);
+    BOOST_REQUIRE_EQUAL(b->offset, 8);
+    BOOST_REQUIRE(eq(b->start, start0));
+    b = cache.get({200, 0});
+    BOOST_REQUIRE(b);
+    BOOST_REQUIRE(eq(b->start, start1));
+    BOOST_REQUIRE_EQUAL(stats.hits, 2);
+    BOOST_REQUIRE(!cache.get({200, 1}));
+
+    // {100, 1} is the least recently used one.
+    with_allocator(r.allocator(), [&] {
+        lru.evict();
+    });
+    BOOST_REQUIRE_EQUAL(stats.evictions, 1);
+    BOOST_REQUIRE(!cache.get({100, 1}));
+    BOOST_REQUIRE(cache.get({100, 0}));
+
+    cache.evict_gently().get();
+    BOOST_REQUIRE_EQUAL(stats.evictions, 3);
+    BOOST_REQUIRE_EQUAL(stats.block_count, 0);
+    BOOST_REQUIRE_EQUAL(stats.used_bytes, 0);
+    BOOST_REQUIRE(!cache.get({100, 0}));
+}
@@ -24,6 +24,7 @@
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/scylla_test_case.hh"
 #include "test/lib/test_utils.hh"
+#include "test/lib/log.hh"
 #include "schema/schema.hh"
 #include "compress.hh"
 #include "replica/database.hh"
@@ -31,6 +32,7 @@
 #include "test/lib/tmpdir.hh"
 #include "partition_slice_builder.hh"
 #include "sstables/sstable_mutation_reader.hh"
+#include "sstables/index_reader.hh"
 
 #include <boost/range/combine.hpp>
 
@@ -382,6 +384,32 @@ SEASTAR_TEST_CASE(all_in_place) {
     });
 }
 
+SEASTAR_TEST_CASE(interpolation_summary_search) {
+    return test_using_reusable_sst(uncompressed_schema(), "test/resource/sstables/bigsummary", 76, [] (auto& env, auto sstp) {
+        auto& summary = sstables::test(sstp)._summary();
+        auto cmp = sstables::index_comparator(*sstp->get_schema());
+
+        auto check = [&] (dht::ring_position_view pos) {
+            uint64_t probes = 0;
+            auto expected = std::distance(summary.entries.begin(), std::lower_bound(summary.entries.begin(), summary.entries.end(), pos, cmp));
+            BOOST_REQUIRE_EQUAL(sstables::interpolation_lower_bound(summary.entries, 0, summary.entries.size(), pos, cmp, probes), expected);
+            BOOST_REQUIRE_GT(probes, 0);
+            return probes;
+        };
+
+        uint64_t probes = 0;
+        for (auto& e : summary.entries) {
+            auto token = e.get_token();
+            probes += check(dht::ring_position_view::starting_at(token));
+            probes += check(dht::ring_position_view::ending_at(token));
+        }
+        probes += check(dht::ring_position_view::min());
+        probes += check(dht::ring_position_view::max());
+        testlog.info("{} summary entries, {} probes per lookup on average", summary.entries.size(), double(probes) / (2 * summary.entries.size() + 2));
+        return make_ready_future<>();
+    });
+}
+
 SEASTAR_TEST_CASE(full_index_search) {
     return test_using_reusable_sst(uncompressed_schema(), uncompressed_dir(), 1, [] (auto& env, auto sstp) {
         return sstables::test(sstp).read_indexes(env.make_reader_permit()).then([sstp] (auto&& index_list) {
@@ -448,6 +476,13 @@ SEASTAR_TEST_CASE(statistics_rewrite) {
 
         sstp = env.reusable_sst(uncompressed_schema(), generation_dir).get();
         BOOST_REQUIRE(sstp->get_sstable_level() == 10);
+        BOOST_REQUIRE(!sstp->is_repaired());
+
+        sstp->mutate_repaired_at(1234).get();
+
+        sstp = env.reusable_sst(uncompressed_schema(), generation_dir).get();
+        BOOST_REQUIRE(sstp->get_repaired_at() == 1234);
+        BOOST_REQUIRE(sstp->get_sstable_level() == 10);
     });
 }
 
@@ -765,6 +800,53 @@ SEASTAR_TEST_CASE(test_skipping_in_compressed_stream) {
     });
 }
 
+SEASTAR_TEST_CASE(test_crc_check_chance_in_compressed_stream) {
+    return seastar::async([] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        tmpdir tmp;
+        auto file_path = (tmp.path() / "test").string();
+        file f = open_file_dma(file_path, open_flags::create | open_flags::wo).get();
+
+        compression_parameters cp({
+            { compression_parameters::SSTABLE_COMPRESSION, "LZ4Compressor" },
+        });
+
+        sstables::compression c;
+        auto os = make_file_output_stream(f, file_output_stream_options()).get();
+        auto out = make_compressed_file_m_format_output_stream(std::move(os), &c, cp);
+        temporary_buffer<char> buf(c.uncompressed_chunk_length());
+        std::fill_n(buf.get_write(), buf.size(), 'a');
+        out.write(buf.get(), buf.size()).get();
+        out.close().get();
+
+        auto compressed_size = seastar::file_size(file_path).get();
+        c.update(compressed_size);
+
+        // Corrupt the checksum of the only chunk, the last 4 bytes of the file.
+        f = open_file_dma(file_path, open_flags::rw).get();
+        auto data = f.dma_read_bulk<char>(0, compressed_size).get();
+        auto aligned = temporary_buffer<char>::aligned(f.memory_dma_alignment(), align_up<size_t>(compressed_size, f.disk_write_dma_alignment()));
+        std::fill_n(aligned.get_write(), aligned.size(), 0);
+        std::copy_n(data.get(), compressed_size, aligned.get_write());
+        aligned.get_write()[compressed_size - 1] ^= 1;
+        f.dma_write(0, aligned.get(), aligned.size()).get();
+        f.truncate(compressed_size).get();
+        f.close().get();
+
+        auto read_all = [&] (double crc_check_chance) {
+            auto f = open_file_dma(file_path, open_flags::ro).get();
+            auto in = make_compressed_file_m_format_input_stream(f, &c, 0, buf.size(), file_input_stream_options(), semaphore.make_permit(),
+                    crc_check_chance);
+            auto close_in = deferred_close(in);
+            return in.read_exactly(buf.size()).get();
+        };
+
+        BOOST_REQUIRE_THROW(read_all(1.0), sstables::malformed_sstable_exception);
+        BOOST_REQUIRE(read_all(0.0) == buf);
+    });
+}
+
 // Test that sstables::key_view::tri_compare(const schema& s, partition_key_view other)
 // should correctly compare empty keys. The fact we did this incorrectly was
 // noticed while fixing #9375, and a separate issue on it is #10178.
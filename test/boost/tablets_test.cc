@@ -763,6 +763,15 @@ SEASTAR_TEST_CASE(test_sharder) {
         BOOST_REQUIRE_EQUAL(sharder_h3.shard_for_writes(tm.get_last_token(tablet_ids[6])), dht::shard_replica_set{7});
         BOOST_REQUIRE_EQUAL(sharder_h3.shard_for_writes(tm.get_last_token(tablet_ids[7])), dht::shard_replica_set{7});
 
+        // Repeated lookups are served from the routing cache and must agree with the first ones
+        for (auto tid : tablet_ids) {
+            BOOST_REQUIRE_EQUAL(sharder.shard_for_reads(tm.get_first_token(tid)), sharder.shard_for_reads(tm.get_last_token(tid)));
+            BOOST_REQUIRE_EQUAL(sharder_h3.shard_for_reads(tm.get_first_token(tid)), sharder_h3.shard_for_reads(tm.get_last_token(tid)));
+        }
+        BOOST_REQUIRE_EQUAL(sharder.shard_for_reads(tm.get_last_token(tablet_ids[0])), 3);
+        BOOST_REQUIRE_EQUAL(sharder.shard_for_reads(tm.get_last_token(tablet_ids[1])), 0); // missing
+        BOOST_REQUIRE_EQUAL(sharder_h3.shard_for_reads(tm.get_last_token(tablet_ids[4])), 7);
+
         BOOST_REQUIRE_EQUAL(sharder.token_for_next_shard_for_reads(tm.get_last_token(tablet_ids[1]), 0), tm.get_first_token(tablet_ids[3]));
         BOOST_REQUIRE_EQUAL(sharder.token_for_next_shard_for_reads(tm.get_last_token(tablet_ids[1]), 1), tm.get_first_token(tablet_ids[2]));
         BOOST_REQUIRE_EQUAL(sharder.token_for_next_shard_for_reads(tm.get_last_token(tablet_ids[1]), 3), dht::maximum_token());
@@ -935,9 +944,10 @@ SEASTAR_THREAD_TEST_CASE(test_token_ownership_splitting) {
 static
 void apply_resize_plan(token_metadata& tm, const migration_plan& plan) {
     for (auto [table_id, resize_decision] : plan.resize_plan().resize) {
-        tablet_map& tmap = tm.tablets().get_tablet_map(table_id);
-        resize_decision.sequence_number = tmap.resize_decision().sequence_number + 1;
-        tmap.set_resize_decision(resize_decision);
+        tm.tablets().mutate_tablet_map(table_id, [&] (tablet_map& tmap) {
+            resize_decision.sequence_number = tmap.resize_decision().sequence_number + 1;
+            tmap.set_resize_decision(resize_decision);
+        });
     }
     for (auto table_id : plan.resize_plan().finalize_resize) {
         auto& old_tmap = tm.tablets().get_tablet_map(table_id);
@@ -951,10 +961,11 @@ void apply_resize_plan(token_metadata& tm, const migration_plan& plan) {
 static
 void apply_plan(token_metadata& tm, const migration_plan& plan) {
     for (auto&& mig : plan.migrations()) {
-        tablet_map& tmap = tm.tablets().get_tablet_map(mig.tablet.table);
-        auto tinfo = tmap.get_tablet_info(mig.tablet.tablet);
-        tinfo.replicas = replace_replica(tinfo.replicas, mig.src, mig.dst);
-        tmap.set_tablet(mig.tablet.tablet, tinfo);
+        tm.tablets().mutate_tablet_map(mig.tablet.table, [&] (tablet_map& tmap) {
+            auto tinfo = tmap.get_tablet_info(mig.tablet.tablet);
+            tinfo.replicas = replace_replica(tinfo.replicas, mig.src, mig.dst);
+            tmap.set_tablet(mig.tablet.tablet, tinfo);
+        });
     }
     apply_resize_plan(tm, plan);
 }
@@ -963,9 +974,10 @@ void apply_plan(token_metadata& tm, const migration_plan& plan) {
 static
 void apply_plan_as_in_progress(token_metadata& tm, const migration_plan& plan) {
     for (auto&& mig : plan.migrations()) {
-        tablet_map& tmap = tm.tablets().get_tablet_map(mig.tablet.table);
-        auto tinfo = tmap.get_tablet_info(mig.tablet.tablet);
-        tmap.set_tablet_transition_info(mig.tablet.tablet, migration_to_transition_info(tinfo, mig));
+        tm.tablets().mutate_tablet_map(mig.tablet.table, [&] (tablet_map& tmap) {
+            auto tinfo = tmap.get_tablet_info(mig.tablet.tablet);
+            tmap.set_tablet_transition_info(mig.tablet.tablet, migration_to_transition_info(tinfo, mig));
+        });
     }
     apply_resize_plan(tm, plan);
 }
@@ -974,7 +986,7 @@ static
 size_t get_tablet_count(const tablet_metadata& tm) {
     size_t count = 0;
     for (auto& [table, tmap] : tm.all_tables()) {
-        count += std::accumulate(tmap.tablets().begin(), tmap.tablets().end(), size_t(0),
+        count += std::accumulate(tmap->tablets().begin(), tmap->tablets().end(), size_t(0),
              [] (size_t accumulator, const locator::tablet_info& info) {
                  return accumulator + info.replicas.size();
              });
@@ -1019,14 +1031,19 @@ void rebalance_tablets_as_in_progress(tablet_allocator& talloc, shared_token_met
 static
 void execute_transitions(shared_token_metadata& stm) {
     stm.mutate_token_metadata([&] (token_metadata& tm) {
-        for (auto&& [tablet, tmap_] : tm.tablets().all_tables()) {
-            auto& tmap = tmap_;
-            for (auto&& [tablet, trinfo]: tmap.transitions()) {
-                auto ti = tmap.get_tablet_info(tablet);
-                ti.replicas = trinfo.next;
-                tmap.set_tablet(tablet, ti);
-            }
-            tmap.clear_transitions();
+        std::vector<table_id> tables;
+        for (auto&& [table, tmap] : tm.tablets().all_tables()) {
+            tables.push_back(table);
+        }
+        for (auto table : tables) {
+            tm.tablets().mutate_tablet_map(table, [] (tablet_map& tmap) {
+                for (auto&& [tablet, trinfo]: tmap.transitions()) {
+                    auto ti = tmap.get_tablet_info(tablet);
+                    ti.replicas = trinfo.next;
+                    tmap.set_tablet(tablet, ti);
+                }
+                tmap.clear_transitions();
+            });
         }
         return make_ready_future<>();
     }).get();
@@ -1841,6 +1858,82 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancer_disabling) {
   }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_balancer_limits_streamed_data) {
+    do_with_cql_env_thread([] (auto& e) {
+        inet_address ip1("192.168.0.1");
+        inet_address ip2("192.168.0.2");
+
+        auto host1 = host_id(next_uuid());
+        auto host2 = host_id(next_uuid());
+
+        auto table1 = table_id(next_uuid());
+
+        unsigned shard_count = 4;
+        size_t tablet_count = 16;
+
+        semaphore sem(1);
+        shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+            locator::topology::config{
+                .this_endpoint = ip1,
+                .local_dc_rack = locator::endpoint_dc_rack::default_location
+            }
+        });
+
+        // host1 is loaded and host2 is empty.
+        stm.mutate_token_metadata([&] (auto& tm) {
+            tm.update_host_id(host1, ip1);
+            tm.update_host_id(host2, ip2);
+            tm.update_topology(host1, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+            tm.update_topology(host2, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+
+            tablet_map tmap(tablet_count);
+            for (auto tid : tmap.tablet_ids()) {
+                tmap.set_tablet(tid, tablet_info {
+                    tablet_replica_set {
+                        tablet_replica {host1, shard_id(size_t(tid) % shard_count)},
+                    }
+                });
+            }
+            tablet_metadata tmeta;
+            tmeta.set_tablet_map(table1, std::move(tmap));
+            tm.set_tablets(std::move(tmeta));
+            return make_ready_future<>();
+        }).get();
+
+        // Without load stats, tablets are assumed to be of the target size and
+        // host2 receives one tablet per shard.
+        {
+            auto plan = e.get_tablet_allocator().local().balance_tablets(stm.get()).get();
+            BOOST_REQUIRE_EQUAL(plan.tablet_migration_count(), shard_count);
+        }
+
+        // Tablets of 4x the target size fill up the amount of data which
+        // host2 may receive at a time after two migrations.
+        {
+            const uint64_t target_tablet_size = e.db().local().get_config().target_tablet_size_in_bytes();
+            auto load_stats = make_lw_shared<locator::load_stats>();
+            load_stats->tables[table1] = table_load_stats{
+                .size_in_bytes = tablet_count * 4 * target_tablet_size,
+                .split_ready_seq_number = std::numeric_limits<locator::resize_decision::seq_number_t>::min(),
+            };
+            auto plan = e.get_tablet_allocator().local().balance_tablets(stm.get(), load_stats).get();
+            BOOST_REQUIRE_EQUAL(plan.tablet_migration_count(), 2);
+        }
+
+        // The limit doesn't prevent moving tablets which are bigger than it.
+        {
+            const uint64_t target_tablet_size = e.db().local().get_config().target_tablet_size_in_bytes();
+            auto load_stats = make_lw_shared<locator::load_stats>();
+            load_stats->tables[table1] = table_load_stats{
+                .size_in_bytes = tablet_count * 100 * target_tablet_size,
+                .split_ready_seq_number = std::numeric_limits<locator::resize_decision::seq_number_t>::min(),
+            };
+            auto plan = e.get_tablet_allocator().local().balance_tablets(stm.get(), load_stats).get();
+            BOOST_REQUIRE_EQUAL(plan.tablet_migration_count(), 1);
+        }
+  }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_drained_node_is_not_balanced_internally) {
     do_with_cql_env_thread([] (auto& e) {
         inet_address ip1("192.168.0.1");
@@ -1892,7 +1985,7 @@ SEASTAR_THREAD_TEST_CASE(test_drained_node_is_not_balanced_internally) {
 static
 void check_tablet_invariants(const tablet_metadata& tmeta) {
     for (auto&& [table, tmap] : tmeta.all_tables()) {
-        tmap.for_each_tablet([&](auto tid, const tablet_info& tinfo) -> future<> {
+        tmap->for_each_tablet([&](auto tid, const tablet_info& tinfo) -> future<> {
             std::unordered_set<host_id> hosts;
             // Uniqueness of hosts
             for (const auto& replica: tinfo.replicas) {
@@ -2200,6 +2293,78 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancing_resize_requests) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_based_resize_requests) {
+    cql_test_config cfg;
+    cfg.db_config->target_tablet_ops_per_second.set(1000);
+    do_with_cql_env_thread([] (auto& e) {
+        inet_address ip1("192.168.0.1");
+        inet_address ip2("192.168.0.2");
+
+        auto host1 = host_id(next_uuid());
+        auto host2 = host_id(next_uuid());
+
+        auto table1 = table_id(next_uuid());
+
+        unsigned shard_count = 2;
+        size_t tablet_count = 2;
+
+        semaphore sem(1);
+        shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+                locator::topology::config{
+                        .this_endpoint = ip1,
+                        .local_dc_rack = locator::endpoint_dc_rack::default_location
+                }
+        });
+
+        // A replica per tablet, so the table is present on half of the shards.
+        stm.mutate_token_metadata([&] (token_metadata& tm) {
+            tm.update_host_id(host1, ip1);
+            tm.update_host_id(host2, ip2);
+            tm.update_topology(host1, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+            tm.update_topology(host2, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+
+            tablet_map tmap(tablet_count);
+            auto tid = tmap.first_tablet();
+            tmap.set_tablet(tid, tablet_info {
+                    tablet_replica_set {
+                            tablet_replica {host1, 0},
+                    }
+            });
+            tid = *tmap.next_tablet(tid);
+            tmap.set_tablet(tid, tablet_info {
+                    tablet_replica_set {
+                            tablet_replica {host2, 0},
+                    }
+            });
+            tablet_metadata tmeta;
+            tmeta.set_tablet_map(table1, std::move(tmap));
+            tm.set_tablets(std::move(tmeta));
+            return make_ready_future<>();
+        }).get();
+
+        const uint64_t target_tablet_size = e.db().local().get_config().target_tablet_size_in_bytes();
+        auto resize_decision_for = [&] (uint64_t avg_tablet_size, double avg_tablet_ops) {
+            auto load_stats = make_lw_shared<locator::load_stats>();
+            load_stats->tables[table1] = table_load_stats{
+                .size_in_bytes = avg_tablet_size * tablet_count,
+                .split_ready_seq_number = std::numeric_limits<locator::resize_decision::seq_number_t>::min(),
+                .ops_per_second = avg_tablet_ops * tablet_count,
+            };
+            auto plan = e.get_tablet_allocator().local().balance_tablets(stm.get(), load_stats).get();
+            auto& resize = plan.resize_plan().resize;
+            return resize.contains(table1) ? resize.at(table1) : locator::resize_decision{};
+        };
+
+        // Hot tablets of the target size are split.
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::split>(resize_decision_for(target_tablet_size, 2000).way));
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision_for(target_tablet_size, 900).way));
+
+        // Small tablets are not merged unless they are also cold.
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision_for(0, 500).way));
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::merge>(resize_decision_for(0, 100).way));
+    }, std::move(cfg)).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_tablet_range_splitter) {
     simple_schema ss;
 
@@ -14,6 +14,7 @@
 #include <seastar/net/ip.hh>
 #include <boost/multiprecision/cpp_int.hpp>
 #include "types/types.hh"
+#include "types/byte_comparable.hh"
 #include "types/tuple.hh"
 #include "compound.hh"
 #include "db/marshal/type_parser.hh"
@@ -871,6 +872,22 @@ BOOST_AUTO_TEST_CASE(test_map_to_json) {
     BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize()), "{\"42\": \"abc\", \"42\": \"abc\"}");
 }
 
+BOOST_AUTO_TEST_CASE(test_write_json) {
+    auto k = data_value("k\"1");
+    auto v = data_value("a\\b\n\x01");
+    auto m = map_type_impl::get_instance(utf8_type, utf8_type, true);
+    using native_type = std::vector<std::pair<data_value, data_value>>;
+    auto map_v = data_value::make(m, std::make_unique<native_type>(native_type{std::pair(k, v)}));
+    auto expected = "{\"k\\\"1\": \"a\\\\b\\n\\u0001\"}";
+    BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize()), expected);
+
+    bytes_ostream out;
+    write_json(out, *m, map_v.serialize());
+    out.write(" ", 1);
+    write_json(out, *int32_type, bytes_opt());
+    BOOST_REQUIRE(bytes(out.linearize()) == to_bytes(format("{} null", expected)));
+}
+
 BOOST_AUTO_TEST_CASE(test_set_to_string) {
     auto m = set_type_impl::get_instance(int32_type, true);
     using native_type = std::vector<data_value>;
@@ -977,3 +994,69 @@ SEASTAR_TEST_CASE(test_list_type_serialization) {
     BOOST_REQUIRE_EQUAL(list, list_type->deserialize_value(managed_bytes_view(*ser)));
     return make_ready_future<>();
 }
+
+static void check_byte_comparable(const abstract_type& t, const std::vector<bytes>& values) {
+    for (auto& a : values) {
+        for (auto& b : values) {
+            auto ea = byte_comparable::encode(t, managed_bytes_view(a));
+            auto eb = byte_comparable::encode(t, managed_bytes_view(b));
+            BOOST_REQUIRE_MESSAGE(compare_unsigned(ea, eb) == t.compare(a, b),
+                    fmt::format("{}: {} <=> {}", t.name(), to_hex(a), to_hex(b)));
+        }
+    }
+}
+
+static void check_byte_comparable(const data_type& t, const std::vector<sstring>& values) {
+    std::vector<bytes> serialized;
+    for (auto& v : values) {
+        serialized.push_back(t->from_string(v));
+    }
+    serialized.push_back(bytes());
+    check_byte_comparable(*t, serialized);
+    check_byte_comparable(*reversed_type_impl::get_instance(t), serialized);
+
+    // The encodings are prefix-free, so they keep their order within a tuple.
+    auto tuple = tuple_type_impl::get_instance({t, int32_type});
+    std::vector<bytes> tuples;
+    for (auto& v : serialized) {
+        for (auto i : {-1, 1}) {
+            tuples.push_back(tuple->decompose(make_tuple_value(tuple, {t->deserialize(v), data_value(i)})));
+        }
+    }
+    check_byte_comparable(*tuple, tuples);
+}
+
+BOOST_AUTO_TEST_CASE(test_byte_comparable) {
+    check_byte_comparable(int32_type, {"-2147483648", "-1", "0", "1", "2147483647"});
+    check_byte_comparable(long_type, {"-9223372036854775808", "-300", "0", "300", "9223372036854775807"});
+    check_byte_comparable(short_type, {"-32768", "-1", "0", "256"});
+    check_byte_comparable(byte_type, {"-128", "-1", "0", "127"});
+    check_byte_comparable(boolean_type, {"false", "true"});
+    check_byte_comparable(timestamp_type, {"1960-01-01 00:00:00+0000", "2015-07-03 12:30:00+0000"});
+    check_byte_comparable(simple_date_type, {"1960-01-01", "1970-01-01", "2015-07-03"});
+    check_byte_comparable(time_type, {"00:00:00", "08:12:54.123456789", "23:59:59.999999999"});
+    check_byte_comparable(double_type, {"-Infinity", "-1.5", "-0.0", "0.0", "1e-300", "2.5", "Infinity", "NaN"});
+    check_byte_comparable(float_type, {"-Infinity", "-1.5", "-0.0", "0.0", "2.5", "Infinity", "NaN"});
+    check_byte_comparable(varint_type, {"-100000000000000000000", "-129", "-128", "-1", "0", "1", "127", "128", "100000000000000000000"});
+    check_byte_comparable(decimal_type, {"-1000", "-12.5", "-12.05", "-12", "-0.001", "0", "0.00", "0.001", "0.1", "0.10", "12", "12.05", "12.5", "1000", "1e100"});
+    check_byte_comparable(utf8_type, {"", sstring("\0", 1), sstring("a\0", 2), "a", "ab", "b"});
+    check_byte_comparable(bytes_type, {"", "00", "0000", "0001", "01", "0100", "ff"});
+    check_byte_comparable(inet_addr_type, {"127.0.0.1", "192.168.0.1", "::1"});
+    check_byte_comparable(uuid_type, {"00000000-0000-1000-0000-000000000000", "00000000-0000-1000-8000-000000000000",
+            "ffffffff-ffff-1fff-ffff-ffffffffffff", "00000000-0000-4000-8000-000000000000", "ffffffff-ffff-4fff-ffff-ffffffffffff"});
+    check_byte_comparable(timeuuid_type, {"00000000-0000-1000-0000-000000000000", "00000000-0000-1000-8000-000000000000",
+            "00000000-0000-1000-ffff-ffffffffffff", "ffffffff-ffff-1fff-ffff-ffffffffffff"});
+
+    auto list_type = list_type_impl::get_instance(int32_type, false);
+    auto list = [&] (std::vector<data_value> elems) {
+        return list_type->decompose(make_list_value(list_type, std::move(elems)));
+    };
+    check_byte_comparable(*list_type, {bytes(), list({}), list({data_value(-1)}), list({data_value(-1), data_value(0)}),
+            list({data_value(0)}), list({data_value::make_null(int32_type)}), list({data_value(1), data_value::make_null(int32_type)})});
+
+    auto map_type = map_type_impl::get_instance(int32_type, utf8_type, false);
+    auto map = [&] (std::vector<std::pair<data_value, data_value>> elems) {
+        return map_type->decompose(make_map_value(map_type, std::move(elems)));
+    };
+    check_byte_comparable(*map_type, {bytes(), map({}), map({{1, "a"}}), map({{1, "b"}}), map({{1, "b"}, {2, ""}}), map({{2, ""}})});
+}
@@ -1103,3 +1103,34 @@ SEASTAR_TEST_CASE(test_user_function_filtering) {
                                 std::runtime_error, message_contains("User function cannot be executed in this context"));
     });
 }
+
+SEASTAR_TEST_CASE(test_user_aggregate_many_rows) {
+    return with_udf_enabled([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE my_table (key int, ck int, val int, PRIMARY KEY (key, ck));").get();
+        // More rows than fit in a batch of the state function, with a null in the middle
+        int row_count = 300;
+        int64_t sum = 0;
+        for (int i = 0; i < row_count; i++) {
+            if (i == 200) {
+                e.execute_cql(format("INSERT INTO my_table (key, ck, val) VALUES (1, {}, null);", i)).get();
+                continue;
+            }
+            e.execute_cql(format("INSERT INTO my_table (key, ck, val) VALUES (1, {}, {});", i, i)).get();
+            sum += i;
+        }
+        e.execute_cql("CREATE FUNCTION sum_fct(acc bigint, val int) CALLED ON NULL INPUT RETURNS bigint LANGUAGE Lua "
+                "AS 'if val == nil then return acc end return acc + val';").get();
+        e.execute_cql("CREATE AGGREGATE my_sum(int) SFUNC sum_fct STYPE bigint INITCOND 0;").get();
+        auto res = e.execute_cql("SELECT my_sum(val) FROM my_table WHERE key = 1;").get();
+        assert_that(res).is_rows().with_rows({{long_type->decompose(sum)}});
+
+        // A null input makes the state of a function returning null on null input null for good
+        e.execute_cql("CREATE FUNCTION strict_sum_fct(acc bigint, val int) RETURNS NULL ON NULL INPUT RETURNS bigint LANGUAGE Lua "
+                "AS 'return acc + val';").get();
+        e.execute_cql("CREATE AGGREGATE my_strict_sum(int) SFUNC strict_sum_fct STYPE bigint INITCOND 0;").get();
+        res = e.execute_cql("SELECT my_strict_sum(val) FROM my_table WHERE key = 1;").get();
+        assert_that(res).is_rows().with_rows({{std::nullopt}});
+        res = e.execute_cql("SELECT my_strict_sum(val) FROM my_table WHERE key = 1 AND ck < 200;").get();
+        assert_that(res).is_rows().with_rows({{long_type->decompose(int64_t(199 * 200 / 2))}});
+    });
+}
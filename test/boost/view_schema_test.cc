@@ -3172,3 +3172,42 @@ SEASTAR_TEST_CASE(test_mv_allow_some_column_drops) {
         BOOST_REQUIRE_THROW(e.execute_cql("alter table cf2 drop d").get(), exceptions::invalid_request_exception);
     });
 }
+
+SEASTAR_TEST_CASE(test_coalesced_view_updates) {
+    cql_test_config cfg;
+    cfg.db_config->view_update_coalescing_window_in_us.set(100'000);
+    return do_with_cql_env_thread([] (auto& e) {
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+        e.execute_cql("create materialized view vcf as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, p, c)").get();
+
+        auto write_all = [&] (int offset) {
+            std::vector<sstring> queries;
+            for (int c = 0; c < 10; ++c) {
+                queries.push_back(format("update cf set v = {} where p = 0 and c = {}", c + offset, c));
+            }
+            std::vector<future<shared_ptr<cql_transport::messages::result_message>>> writes;
+            for (auto& q : queries) {
+                writes.push_back(e.execute_cql(q));
+            }
+            for (auto& f : writes) {
+                f.get();
+            }
+        };
+        // The concurrent writes to the partition are coalesced, and the
+        // second round has to delete the view rows of the first one.
+        write_all(0);
+        write_all(100);
+
+        eventually([&] {
+            auto msg = e.execute_cql("select v, c from vcf").get();
+            std::vector<std::vector<bytes_opt>> rows;
+            for (int c = 0; c < 10; ++c) {
+                rows.push_back({int32_type->decompose(c + 100), int32_type->decompose(c)});
+            }
+            assert_that(msg).is_rows().with_rows_ignore_order(std::move(rows));
+        });
+        BOOST_REQUIRE_GT(e.local_db().find_column_family("ks", "cf").get_view_stats().view_update_writes_coalesced, 0);
+    }, std::move(cfg));
+}
@@ -61,14 +61,6 @@ SEASTAR_THREAD_TEST_CASE(test_streaming_vt_as_mutation_source) {
 
     run_mutation_source_tests([&table] (schema_ptr s, const std::vector<mutation>& mutations, gc_clock::time_point) -> mutation_source {
         table = std::make_unique<streaming_test_vt>(s, mutations);
-        return mutation_source([ms = table->as_mutation_source()] (schema_ptr s,
-                reader_permit permit,
-                const dht::partition_range& pr,
-                const query::partition_slice& slice,
-                tracing::trace_state_ptr trace_state,
-                streamed_mutation::forwarding stream_fwd,
-                mutation_reader::forwarding) {
-            return ms.make_reader_v2(s, permit, pr, slice, trace_state, stream_fwd, mutation_reader::forwarding::no);
-        });
-    }, false /* with_partition_range_forwarding */);
+        return table->as_mutation_source();
+    });
 }
@@ -35,3 +35,23 @@ def test_sticky_stop_flag(cql, test_keyspace):
         res = list(cql.execute(statement))
 
         assert len(res) == 199
+
+# Test that paging through a query with a long IN list of partitions returns
+# all of them, in the same order as without paging, also when a page is filled
+# before the end of the list, or when the list is longer than the number of
+# partitions read at the same time (max_concurrent_partition_reads_per_query).
+def test_paging_long_in_list(cql, test_keyspace):
+    with new_test_table(cql, test_keyspace, 'pk int, ck int, v int, PRIMARY KEY (pk, ck)') as table:
+        insert = cql.prepare(f"INSERT INTO {table} (pk, ck, v) VALUES (?, ?, ?)")
+        for pk in range(200):
+            for ck in range(3):
+                cql.execute(insert, (pk, ck, pk * ck))
+        in_list = ', '.join(str(pk) for pk in range(0, 400, 2))
+        query = f"SELECT pk, ck FROM {table} WHERE pk IN ({in_list})"
+        unpaged = [(r.pk, r.ck) for r in cql.execute(SimpleStatement(query, fetch_size=None))]
+        assert sorted(unpaged) == [(pk, ck) for pk in range(0, 200, 2) for ck in range(3)]
+        for fetch_size in [1, 7, 100, 1000]:
+            statement = SimpleStatement(query, fetch_size=fetch_size)
+            assert [(r.pk, r.ck) for r in cql.execute(statement)] == unpaged
+        statement = SimpleStatement(f"{query} LIMIT 10", fetch_size=4)
+        assert [(r.pk, r.ck) for r in cql.execute(statement)] == unpaged[:10]
@@ -7,6 +7,7 @@
 # Tests for configuration of compressed sstables
 #############################################################################
 
+import os
 import pytest
 import nodetool
 from util import new_test_table
@@ -94,3 +95,47 @@ def test_huge_chunk_length(cql, test_keyspace, cassandra_bug):
     with new_test_table(cql, test_keyspace, "p int primary key, v int") as table:
         with pytest.raises(ConfigurationException, match='chunk_length_in_kb'):
             cql.execute("ALTER TABLE " + table + " with compression = { '" + sstable_compression + "': 'LZ4Compressor', 'chunk_length_in_kb': 1048576 }")
+
+# Scylla allows a second compressor for sstables written by compaction which
+# hold only data older than cold_after_hours. Its own options are prefixed
+# with "cold_". Check that the options are accepted, and kept in the schema.
+def test_cold_compression_options(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int primary key, v int", "with compression = { '" + sstable_compression + "': 'LZ4Compressor', 'cold_sstable_compression': 'ZstdCompressor', 'cold_compression_level': 9, 'cold_after_hours': 24 }") as table:
+        [ks, cf] = table.split('.')
+        opts = cql.execute(f"SELECT compression FROM system_schema.tables WHERE keyspace_name='{ks}' AND table_name='{cf}'").one().compression
+        assert opts['cold_sstable_compression'] == 'org.apache.cassandra.io.compress.ZstdCompressor'
+        assert opts['cold_compression_level'] == '9'
+        assert opts['cold_after_hours'] == '24'
+        # Old data compacted with the cold compressor must remain readable.
+        cql.execute(f'INSERT INTO {table} (p, v) VALUES (1, 2) USING TIMESTAMP 1000')
+        nodetool.flush(cql, table)
+        nodetool.compact(cql, table)
+        assert list(cql.execute(f'SELECT v FROM {table} WHERE p = 1')) == [(2,)]
+
+def test_cold_compression_invalid(cql, test_keyspace, scylla_only):
+    # The cold compressor and its age threshold go together
+    with pytest.raises(ConfigurationException, match='cold_after_hours'):
+        with new_test_table(cql, test_keyspace, "p int primary key, v int", "with compression = { '" + sstable_compression + "': 'LZ4Compressor', 'cold_sstable_compression': 'ZstdCompressor' }") as table:
+            pass
+    # Options of the cold compressor are checked against it
+    with pytest.raises(ConfigurationException, match='cold_compression_level'):
+        with new_test_table(cql, test_keyspace, "p int primary key, v int", "with compression = { '" + sstable_compression + "': 'LZ4Compressor', 'cold_sstable_compression': 'DeflateCompressor', 'cold_compression_level': 9, 'cold_after_hours': 24 }") as table:
+            pass
+
+# With min_compress_ratio, chunks which don't compress at least that much are
+# stored uncompressed. Check that such sstables, with a mix of compressible
+# and incompressible chunks, read back correctly.
+def test_min_compress_ratio(cql, test_keyspace):
+    with new_test_table(cql, test_keyspace, "p int primary key, v blob", "with compression = { '" + sstable_compression + "': 'LZ4Compressor', 'chunk_length_in_kb': 4, 'min_compress_ratio': 1.1 }") as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, v) VALUES (?, ?)')
+        rows = {p: (os.urandom(3000) if p % 2 else b'x' * 3000) for p in range(100)}
+        for p, v in rows.items():
+            cql.execute(stmt, [p, v])
+        nodetool.flush(cql, table)
+        for p, v in rows.items():
+            assert list(cql.execute(f'SELECT v FROM {table} WHERE p = {p}')) == [(v,)]
+
+def test_min_compress_ratio_invalid(cql, test_keyspace, scylla_only):
+    with pytest.raises(ConfigurationException, match='min_compress_ratio'):
+        with new_test_table(cql, test_keyspace, "p int primary key, v int", "with compression = { '" + sstable_compression + "': 'LZ4Compressor', 'min_compress_ratio': 0.5 }") as table:
+            pass
@@ -201,6 +201,24 @@ def test_scylla_sstable_dump_data(cql, test_keyspace, scylla_path, scylla_data_d
         assert json.loads(out)
 
 
+@pytest.mark.parametrize("merge", [True, False])
+def test_scylla_sstable_partition_stats(cql, test_keyspace, scylla_path, scylla_data_dir, merge):
+    with scylla_sstable(simple_clustering_table, cql, test_keyspace, scylla_data_dir) as (schema_file, sstables):
+        common_args = ["--schema-file", schema_file] + (["--merge"] if merge else [])
+        stats = json.loads(subprocess.check_output([scylla_path, "sstable", "partition-stats", "--top", "2"] + common_args + sstables))["sstables"]
+        dump = json.loads(subprocess.check_output([scylla_path, "sstable", "dump-data", "--output-format", "json"] + common_args + sstables))["sstables"]
+
+    assert stats.keys() == dump.keys()
+    for name, partitions in dump.items():
+        s = stats[name]
+        assert s["partitions"] == len(partitions)
+        assert sum(s["partition_size_histogram"]["counts"]) == len(partitions)
+        assert len(s["largest_partitions"]) == min(2, len(partitions))
+        sizes = [p["size"] for p in s["largest_partitions"]]
+        assert sizes == sorted(sizes, reverse=True)
+        assert 0 <= s["tombstone_density"] <= 1
+
+
 @pytest.mark.parametrize("table_factory", [
         simple_no_clustering_table,
         simple_clustering_table,
@@ -229,6 +247,45 @@ def test_scylla_sstable_write(cql, test_keyspace, scylla_path, scylla_data_dir,
             assert actual_json == original_json
 
 
+def test_scylla_sstable_import_csv(scylla_path):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        schema_file = os.path.join(tmp_dir, 'schema.cql')
+        with open(schema_file, 'w') as f:
+            f.write("CREATE TABLE ks.tbl (pk int, ck int, v int, PRIMARY KEY (pk, ck))")
+
+        input_file = os.path.join(tmp_dir, 'input.csv')
+        with open(input_file, 'w') as f:
+            f.write("ck,v,pk\n")
+            for pk in reversed(range(8)):
+                for ck in range(4):
+                    f.write(f"{ck},{pk * 10 + ck},{pk}\n")
+            # Same timestamp as the previous records: the larger value wins for ck=0, null doesn't delete for ck=1
+            f.write("0,1000,3\n")
+            f.write("1,,3\n")
+
+        generation = util.unique_key_int()
+        out = subprocess.check_output([scylla_path, "sstable", "import-csv", "--schema-file", schema_file, "--input-file", input_file,
+                                       "--output-dir", tmp_dir, "--generation", str(generation), "--shards", "2"])
+        outputs = json.loads(out)["sstables"]
+        shards = [shard for shard_list in outputs.values() for shard in shard_list]
+        assert len(shards) == len(outputs)
+        assert len(set(shards)) == len(shards)
+        assert all(0 <= shard < 2 for shard in shards)
+
+        dump = json.loads(subprocess.check_output([scylla_path, "sstable", "dump-data", "--schema-file", schema_file, "--output-format", "json", "--merge"] + list(outputs.keys())))
+        partitions = dump["sstables"]["anonymous"]
+
+    values = {}
+    for p in partitions:
+        pk = int(p["key"]["value"])
+        for row in p["clustering_elements"]:
+            values[(pk, int(row["key"]["value"]))] = int(row["columns"]["v"]["value"])
+
+    expected = {(pk, ck): pk * 10 + ck for pk in range(8) for ck in range(4)}
+    expected[(3, 0)] = 1000
+    assert values == expected
+
+
 def script_consume_test_table_factory(cql, keyspace):
     table = util.unique_name()
     schema = f"CREATE TABLE {keyspace}.{table} (pk int, ck int, v int, s int STATIC, PRIMARY KEY (pk, ck)) WITH compaction = {{'class': 'NullCompactionStrategy'}}"
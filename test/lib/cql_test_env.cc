@@ -101,6 +101,8 @@ cql_test_config::cql_test_config(shared_ptr<db::config> cfg)
     // if /tmp is not tmpfs.
     db_config->commitlog_use_o_dsync.set(false);
 
+    db_config->add_bloom_filter_extension();
+    db_config->add_cache_eviction_extension();
     db_config->add_cdc_extension();
     db_config->add_per_partition_rate_limit_extension();
     db_config->add_tags_extension();
@@ -389,6 +391,14 @@ class single_node_cql_env : public cql_test_env {
         return _sstm;
     }
 
+    virtual sharded<tasks::task_manager>& get_task_manager() override {
+        return _task_manager;
+    }
+
+    virtual sharded<repair_service>& get_repair_service() override {
+        return _repair;
+    }
+
     virtual future<> refresh_client_state() override {
         return _core_local.invoke_on_all([] (core_local_state& state) {
             return state.client_state.maybe_update_per_service_level_params();
@@ -561,6 +571,8 @@ class single_node_cql_env : public cql_test_env {
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .subrange_parallelism = cfg->compaction_subrange_parallelism,
+                    .subrange_min_size_in_mb = cfg->compaction_subrange_min_size_in_mb,
                 };
             });
             _cm.start(std::move(get_cm_cfg), std::ref(abort_sources), std::ref(_task_manager)).get();
@@ -873,7 +885,7 @@ class single_node_cql_env : public cql_test_env {
             });
 
             if (cfg_in.need_remote_proxy) {
-                _proxy.invoke_on_all(&service::storage_proxy::start_remote, std::ref(_ms), std::ref(_gossiper), std::ref(_mm), std::ref(_sys_ks)).get();
+                _proxy.invoke_on_all(&service::storage_proxy::start_remote, std::ref(_ms), std::ref(_gossiper), std::ref(_mm), std::ref(_sys_ks), std::ref(_fd)).get();
             }
             auto stop_proxy_remote = defer([this, need = cfg_in.need_remote_proxy] {
                 if (need) {
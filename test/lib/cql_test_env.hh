@@ -26,6 +26,12 @@
 #include "schema/schema.hh"
 #include "service/tablet_allocator.hh"
 
+namespace tasks {
+class task_manager;
+}
+
+class repair_service;
+
 namespace replica {
 class database;
 }
@@ -179,6 +185,10 @@ class cql_test_env {
 
     virtual sharded<sstables::storage_manager>& get_sstorage_manager() = 0;
 
+    virtual sharded<tasks::task_manager>& get_task_manager() = 0;
+
+    virtual sharded<repair_service>& get_repair_service() = 0;
+
     data_dictionary::database data_dictionary();
 };
 
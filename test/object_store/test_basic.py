@@ -254,6 +254,51 @@ async def test_memtable_flush_retries(manager: ManagerClient, tmpdir, s3_server)
     assert have_res == dict(rows), f'Unexpected table content: {have_res}'
 
 
+@pytest.mark.asyncio
+async def test_backup(manager: ManagerClient, s3_server):
+    '''verify snapshots are backed up and files already in the bucket are not uploaded again'''
+
+    def list_bucket(s3_server):
+        r = requests.get(f'http://{s3_server.address}:{s3_server.port}/{s3_server.bucket_name}')
+        bucket_list_res = ET.fromstring(r.content)
+        return [opt.text for elem in bucket_list_res if elem.tag.endswith('Contents')
+                         for opt in elem if opt.tag.endswith('Key')]
+
+    cfg = {'enable_user_defined_functions': False,
+           'object_storage_config_file': str(s3_server.config_file)}
+    server = await manager.server_add(config=cfg)
+
+    cql = manager.get_cql()
+    ks = 'test_backup_ks'
+    replication_opts = format_tuples({'class': 'NetworkTopologyStrategy',
+                                      'replication_factor': '1'})
+    cql.execute(f"CREATE KEYSPACE {ks} WITH REPLICATION = {replication_opts};")
+    cql.execute(f"CREATE TABLE {ks}.test_cf ( name text primary key, value text );")
+    for i in range(16):
+        cql.execute(f"INSERT INTO {ks}.test_cf ( name, value ) VALUES ('{i}', 'value-{i}');")
+
+    async def backup(tag):
+        await manager.api.client.post("/storage_service/snapshots", host=server.ip_addr, params={'tag': tag, 'kn': ks})
+        tid = await manager.api.client.post_json("/storage_service/backup", host=server.ip_addr,
+                                                 params={'endpoint': s3_server.address, 'bucket': s3_server.bucket_name,
+                                                         'prefix': 'backups', 'keyspace': ks, 'snapshot': tag})
+        status = await manager.api.client.get_json(f"/task_manager/wait_task/{tid}", host=server.ip_addr)
+        assert status['state'] == 'done', f'Backup failed: {status}'
+
+    print('Back up the first snapshot')
+    await backup('snap1')
+    objects = list_bucket(s3_server)
+    assert f'backups/manifests/{ks}/snap1.json' in objects
+    blobs = set(o for o in objects if o.startswith('backups/blobs/'))
+    assert blobs, 'No files were uploaded'
+
+    print('Back up the second snapshot of the same data')
+    await backup('snap2')
+    objects = list_bucket(s3_server)
+    assert f'backups/manifests/{ks}/snap2.json' in objects
+    assert set(o for o in objects if o.startswith('backups/blobs/')) == blobs, 'Unchanged files were uploaded again'
+
+
 def format_tuples(tuples=None, **kwargs):
     '''format a dict to structured values (tuples) in CQL'''
     if tuples is None:
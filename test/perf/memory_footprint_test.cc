@@ -75,6 +75,15 @@ class size_calculator {
         std::cout << "\n";
 
         std::cout << prefix() << "sizeof(atomic_cell_or_collection) = " << sizeof(atomic_cell_or_collection) << "\n";
+        {
+            nest n;
+            // Cells up to managed_bytes::max_inline_size are stored inline, larger ones pay for an external allocation.
+            auto cell_external_memory = [] (const abstract_type& t, bytes value) {
+                return atomic_cell_or_collection(atomic_cell::make_live(t, 1, value)).external_memory_usage(t);
+            };
+            std::cout << prefix() << "external memory of a live int cell = " << cell_external_memory(*int32_type, int32_type->decompose(int32_t(1))) << "\n";
+            std::cout << prefix() << "external memory of a live bigint cell = " << cell_external_memory(*long_type, long_type->decompose(int64_t(1))) << "\n";
+        }
         std::cout << prefix() << "btree::linear_node_size(1) = " << mutation_partition::rows_type::node::linear_node_size(1) << "\n";
         std::cout << prefix() << "btree::inner_node_size = " << mutation_partition::rows_type::node::inner_node_size << "\n";
         std::cout << prefix() << "btree::leaf_node_size = " << mutation_partition::rows_type::node::leaf_node_size << "\n";
@@ -54,10 +54,22 @@ auto fmt::formatter<scheduling_latency_measurer>::format(const scheduling_latenc
         to_ms(slm.max().count()));
 }
 
+latency_quantiles::latency_quantiles(const latency_histogram& h)
+    : p50(h.quantile(0.5) / 1e3)
+    , p90(h.quantile(0.9) / 1e3)
+    , p99(h.quantile(0.99) / 1e3)
+    , p999(h.quantile(0.999) / 1e3)
+    , max(h.max() / 1e3)
+{}
+
 auto fmt::formatter<perf_result>::format(const perf_result& result, fmt::format_context& ctx) const
         -> decltype(ctx.out()) {
-    return fmt::format_to(ctx.out(), "{:.2f} tps ({:5.1f} allocs/op, {:5.1f} logallocs/op, {:5.1f} tasks/op, {:7.0f} insns/op, {:7.0f} cycles/op, {:8} errors)",
+    auto out = fmt::format_to(ctx.out(), "{:.2f} tps ({:5.1f} allocs/op, {:5.1f} logallocs/op, {:5.1f} tasks/op, {:7.0f} insns/op, {:7.0f} cycles/op, {:8} errors)",
             result.throughput, result.mallocs_per_op, result.logallocs_per_op, result.tasks_per_op, result.instructions_per_op, result.cpu_cycles_per_op, result.errors);
+    if (auto& l = result.latencies) {
+        out = fmt::format_to(out, " latency [us]: p50 {:.0f}, p90 {:.0f}, p99 {:.0f}, p999 {:.0f}, max {:.0f}", l->p50, l->p90, l->p99, l->p999, l->max);
+    }
+    return out;
 }
 
 aggregated_perf_results::aggregated_perf_results(std::vector<perf_result>& results) {
@@ -12,7 +12,12 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/exception.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "seastarx.hh"
 #include "utils/extremum_tracking.hh"
 #include "utils/estimated_histogram.hh"
@@ -22,6 +27,7 @@
 
 #include <chrono>
 #include <iosfwd>
+#include <optional>
 #include <boost/range/irange.hpp>
 #include <vector>
 
@@ -48,6 +54,9 @@ void time_it(Func func, int iterations = 5, int iterations_between_clock_reading
     }
 }
 
+// Latencies in nanoseconds, from about 1us to about 68s, within about 1.5%.
+using latency_histogram = utils::approx_exponential_histogram<1024, (uint64_t(1) << 36), 64>;
+
 struct executor_shard_stats {
     uint64_t invocations = 0;
     uint64_t allocations = 0;
@@ -56,6 +65,7 @@ struct executor_shard_stats {
     uint64_t instructions_retired = 0;
     uint64_t cpu_cycles_retired = 0;
     uint64_t errors = 0;
+    latency_histogram latencies;
 };
 
 inline
@@ -68,6 +78,7 @@ operator+(executor_shard_stats a, executor_shard_stats b) {
     a.instructions_retired += b.instructions_retired;
     a.cpu_cycles_retired += b.cpu_cycles_retired;
     a.errors += b.errors;
+    a.latencies.merge(b.latencies);
     return a;
 }
 
@@ -81,6 +92,9 @@ operator-(executor_shard_stats a, executor_shard_stats b) {
     a.instructions_retired -= b.instructions_retired;
     a.cpu_cycles_retired -= b.cpu_cycles_retired;
     a.errors -= b.errors;
+    for (size_t i = 0; i < a.latencies.size(); ++i) {
+        a.latencies[i] -= b.latencies.get(i);
+    }
     return a;
 }
 
@@ -90,15 +104,25 @@ uint64_t perf_logallocs();
 
 // Drives concurrent and continuous execution of given asynchronous action
 // until a deadline. Counts invocations and collects statistics.
+//
+// With a rate, the action is instead started at that rate, whether or not
+// the earlier invocations completed (open loop), with at most n_workers
+// invocations in flight, and latencies are collected too. The latency of an
+// invocation is measured from when it was due to start, so the time it waited
+// for the earlier ones is not omitted (coordinated omission).
 template <typename Func>
 class executor {
+    using clk = std::chrono::steady_clock;
+
     const Func _func;
     const lowres_clock::time_point _end_at;
     const uint64_t _end_at_count;
     const unsigned _n_workers;
     const bool _stop_on_error;
+    const unsigned _rate;
     uint64_t _count;
     uint64_t _errors;
+    latency_histogram _latencies;
     linux_perf_event _instructions_retired_counter = linux_perf_event::user_instructions_retired();
     linux_perf_event _cpu_cycles_retired_counter = linux_perf_event::user_cpu_cycles_retired();
 private:
@@ -116,13 +140,48 @@ class executor {
             }
         }
     }
+    future<> run_at_rate() {
+        auto interval = std::chrono::duration_cast<clk::duration>(std::chrono::duration<double>(1.0 / _rate));
+        auto start = clk::now();
+        semaphore in_flight(_n_workers);
+        gate g;
+        std::exception_ptr ex;
+        for (uint64_t i = 0; !ex && (_end_at_count ? i < _end_at_count : lowres_clock::now() < _end_at); ++i) {
+            auto due = start + i * interval;
+            if (auto now = clk::now(); now < due) {
+                co_await seastar::sleep(due - now);
+            } else {
+                co_await coroutine::maybe_yield();
+            }
+            auto units = co_await get_units(in_flight, 1);
+            ++_count;
+            (void)with_gate(g, [this, due, &ex, units = std::move(units)] () mutable {
+                return futurize_invoke(_func).then_wrapped([this, due, &ex, units = std::move(units)] (future<> f) {
+                    _latencies.add(std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now() - due).count());
+                    if (f.failed()) {
+                        ++_errors;
+                        if (_stop_on_error && !ex) [[unlikely]] {
+                            ex = f.get_exception();
+                            return;
+                        }
+                        f.ignore_ready_future();
+                    }
+                });
+            });
+        }
+        co_await g.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+    }
 public:
-    executor(unsigned n_workers, Func func, lowres_clock::time_point end_at, uint64_t end_at_count = 0, bool stop_on_error = true)
+    executor(unsigned n_workers, Func func, lowres_clock::time_point end_at, uint64_t end_at_count = 0, bool stop_on_error = true, unsigned rate = 0)
             : _func(std::move(func))
             , _end_at(end_at)
             , _end_at_count(end_at_count)
             , _n_workers(n_workers)
             , _stop_on_error(stop_on_error)
+            , _rate(rate)
             , _count(0)
             , _errors(0)
     { }
@@ -133,9 +192,10 @@ class executor {
         _instructions_retired_counter.enable();
         _cpu_cycles_retired_counter.enable();
         auto idx = boost::irange(0, (int)_n_workers);
-        return parallel_for_each(idx.begin(), idx.end(), [this] (auto idx) mutable {
+        auto f = _rate ? run_at_rate() : parallel_for_each(idx.begin(), idx.end(), [this] (auto idx) mutable {
             return this->run_worker();
-        }).then([this, stats_start] {
+        });
+        return f.then([this, stats_start] {
             _instructions_retired_counter.disable();
             _cpu_cycles_retired_counter.disable();
             auto stats_end = executor_shard_stats_snapshot();
@@ -159,9 +219,21 @@ executor<Func>::executor_shard_stats_snapshot() {
         .instructions_retired = _instructions_retired_counter.read(),
         .cpu_cycles_retired = _cpu_cycles_retired_counter.read(),
         .errors = _errors,
+        .latencies = _latencies,
     };
 }
 
+// Latency quantiles, in microseconds
+struct latency_quantiles {
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+    double max;
+
+    explicit latency_quantiles(const latency_histogram& h);
+};
+
 struct perf_result {
     double throughput;
     double mallocs_per_op;
@@ -170,6 +242,8 @@ struct perf_result {
     double instructions_per_op;
     double cpu_cycles_per_op;
     uint64_t errors;
+    // Collected only when the action runs at a fixed rate
+    std::optional<latency_quantiles> latencies;
 };
 
 
@@ -210,12 +284,15 @@ template <> struct fmt::formatter<perf_result_with_aio_writes> : fmt::formatter<
  *
  * Runs many iterations. Prints partial total throughput after each iteration.
  *
+ * With a non-zero rate_per_core, the action is started at that rate instead,
+ * with at most concurrency_per_core executions in flight, see executor.
+ *
  * Returns a vector of throughputs achieved in each iteration.
  */
 template <typename Res, typename Func, typename UpdateFunc = void(*)(const Res&, const executor_shard_stats&)>
 requires (std::is_base_of_v<perf_result, Res> && std::is_invocable_v<UpdateFunc, Res&, const executor_shard_stats&>)
 static
-std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true, UpdateFunc uf = [](const auto&, const auto&) {}) {
+std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true, UpdateFunc uf = [](const auto&, const auto&) {}, unsigned rate_per_core = 0) {
     using clk = std::chrono::steady_clock;
     if (operations_per_shard) {
         iterations = 1;
@@ -226,7 +303,7 @@ std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int
         auto end_at = lowres_clock::now() + std::chrono::seconds(1);
         distributed<executor<Func>> exec;
         Res result;
-        exec.start(concurrency_per_core, func, std::move(end_at), operations_per_shard, stop_on_error).get();
+        exec.start(concurrency_per_core, func, std::move(end_at), operations_per_shard, stop_on_error, rate_per_core).get();
         auto stop_exec = defer([&exec] {
             exec.stop().get();
         });
@@ -242,6 +319,9 @@ std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int
         result.instructions_per_op = double(stats.instructions_retired) / stats.invocations;
         result.cpu_cycles_per_op = double(stats.cpu_cycles_retired) / stats.invocations;
         result.errors = stats.errors;
+        if (rate_per_core) {
+            result.latencies.emplace(stats.latencies);
+        }
 
         uf(result, stats);
 
@@ -253,8 +333,9 @@ std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int
 
 template <typename Func>
 static
-std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true) {
-    return time_parallel_ex<perf_result>(std::move(func), concurrency_per_core, iterations, operations_per_shard, stop_on_error);
+std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true, unsigned rate_per_core = 0) {
+    return time_parallel_ex<perf_result>(std::move(func), concurrency_per_core, iterations, operations_per_shard, stop_on_error,
+            [] (perf_result&, const executor_shard_stats&) {}, rate_per_core);
 }
 
 template<typename Func>
@@ -0,0 +1,408 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <boost/range/irange.hpp>
+#include "seastarx.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/log.hh"
+#include <seastar/core/app-template.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/thread.hh>
+#include "replica/database.hh"
+#include "db/config.hh"
+#include "db/commitlog/commitlog.hh"
+#include "utils/estimated_histogram.hh"
+#include "utils/logalloc.hh"
+
+/// Evaluates row cache behavior under skewed read workloads.
+///
+/// The table is populated with more data than fits in the cache, flushed and the cache
+/// is emptied. Reads are then issued according to the selected workload:
+///
+///   uniform  - every partition is equally likely
+///   zipf     - partition popularity follows Zipf's law (--zipf-exponent)
+///   hotset   - --hot-ratio of reads go to a hot set of --hot-fraction of partitions,
+///              which moves to different partitions every --shift-seconds
+///   trace    - keys are taken from --trace-file, see below
+///
+/// With --scan-ratio, that fraction of reads are token range scans of --scan-rows rows
+/// starting at a random token, which compete with point reads for the cache.
+///
+/// The trace file has one partition key (bigint) per line, optionally followed by
+/// a count. Lines which don't start with an integer are ignored, so the output of
+/// `nodetool toppartitions` for a bigint-keyed table can be used as is. When counts
+/// are present, keys are sampled with probability proportional to them, otherwise
+/// the keys are replayed in order, repeatedly. Keys are mapped to the populated
+/// partitions modulo --partitions.
+///
+/// Meant to be run on a single shard, with memory small enough for the data set
+/// not to fit in cache, e.g.:
+///
+///    $ build/release/test/perf/perf_cache_workloads -c1 -m1G --workload zipf --partitions 1000000
+///
+/// The cache policy can be changed with --admission-filter and --compressed-tier-fraction.
+
+static thread_local bool cancelled = false;
+
+using namespace std::chrono_literals;
+
+template<typename T>
+class monotonic_counter {
+    std::function<T()> _getter;
+    T _prev;
+public:
+    monotonic_counter(std::function<T()> getter)
+        : _getter(std::move(getter)) {
+        _prev = _getter();
+    }
+    // Return change in value since the last call to change() or rate().
+    auto change() {
+        auto now = _getter();
+        return now - std::exchange(_prev, now);
+    }
+};
+
+// Generates the partitions to read, as indexes in [0, partitions).
+class key_generator {
+public:
+    virtual ~key_generator() = default;
+    virtual int64_t next() = 0;
+};
+
+class uniform_key_generator : public key_generator {
+    std::mt19937_64& _rnd;
+    std::uniform_int_distribution<int64_t> _dist;
+public:
+    uniform_key_generator(std::mt19937_64& rnd, int64_t partitions)
+        : _rnd(rnd), _dist(0, partitions - 1) {}
+    int64_t next() override {
+        return _dist(_rnd);
+    }
+};
+
+class zipf_key_generator : public key_generator {
+    std::mt19937_64& _rnd;
+    std::vector<double> _cdf;
+    // Maps popularity ranks to keys, so that the popular partitions are spread over the ring
+    std::vector<int64_t> _keys;
+    std::uniform_real_distribution<double> _dist;
+public:
+    zipf_key_generator(std::mt19937_64& rnd, int64_t partitions, double exponent)
+        : _rnd(rnd)
+        , _cdf(partitions)
+        , _keys(partitions)
+        , _dist(0, 1)
+    {
+        double sum = 0;
+        for (int64_t i = 0; i < partitions; ++i) {
+            sum += 1 / std::pow(double(i + 1), exponent);
+            _cdf[i] = sum;
+        }
+        for (auto& p : _cdf) {
+            p /= sum;
+        }
+        std::iota(_keys.begin(), _keys.end(), 0);
+        std::shuffle(_keys.begin(), _keys.end(), _rnd);
+    }
+    int64_t next() override {
+        auto i = std::lower_bound(_cdf.begin(), _cdf.end(), _dist(_rnd));
+        return _keys[std::min<size_t>(std::distance(_cdf.begin(), i), _keys.size() - 1)];
+    }
+};
+
+class hot_set_key_generator : public key_generator {
+    std::mt19937_64& _rnd;
+    int64_t _partitions;
+    int64_t _hot_size;
+    int64_t _hot_start = 0;
+    double _hot_ratio;
+    std::uniform_real_distribution<double> _dist;
+public:
+    hot_set_key_generator(std::mt19937_64& rnd, int64_t partitions, double hot_fraction, double hot_ratio)
+        : _rnd(rnd)
+        , _partitions(partitions)
+        , _hot_size(std::clamp<int64_t>(partitions * hot_fraction, 1, partitions))
+        , _hot_ratio(hot_ratio)
+        , _dist(0, 1)
+    {}
+    // Moves the hot set to the partitions right after the current one
+    void shift() {
+        _hot_start = (_hot_start + _hot_size) % _partitions;
+    }
+    int64_t next() override {
+        if (_dist(_rnd) < _hot_ratio) {
+            auto offset = std::uniform_int_distribution<int64_t>(0, _hot_size - 1)(_rnd);
+            return (_hot_start + offset) % _partitions;
+        }
+        return std::uniform_int_distribution<int64_t>(0, _partitions - 1)(_rnd);
+    }
+};
+
+class trace_key_generator : public key_generator {
+    std::mt19937_64& _rnd;
+    std::vector<int64_t> _keys;
+    std::optional<std::discrete_distribution<size_t>> _weights;
+    size_t _pos = 0;
+public:
+    trace_key_generator(std::mt19937_64& rnd, int64_t partitions, const std::string& path)
+        : _rnd(rnd)
+    {
+        std::ifstream in(path);
+        if (!in) {
+            throw std::runtime_error(format("Cannot open trace file {}", path));
+        }
+        std::vector<double> counts;
+        bool weighted = true;
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream ls(line);
+            int64_t key;
+            if (!(ls >> key)) {
+                continue;
+            }
+            _keys.push_back((key % partitions + partitions) % partitions);
+            double count;
+            if (ls >> count) {
+                counts.push_back(count);
+            } else {
+                weighted = false;
+            }
+        }
+        if (_keys.empty()) {
+            throw std::runtime_error(format("No keys found in trace file {}", path));
+        }
+        if (weighted) {
+            _weights.emplace(counts.begin(), counts.end());
+        }
+        testlog.info("Loaded {} keys from {}, {}", _keys.size(), path, weighted ? "sampling by count" : "replaying in order");
+    }
+    int64_t next() override {
+        if (_weights) {
+            return _keys[(*_weights)(_rnd)];
+        }
+        return _keys[std::exchange(_pos, (_pos + 1) % _keys.size())];
+    }
+};
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("trace", "Enables trace-level logging for the test actions")
+        ("workload", bpo::value<std::string>()->default_value("zipf"), "Read workload: uniform, zipf, hotset or trace")
+        ("partitions", bpo::value<int64_t>()->default_value(100000), "Number of partitions in the table")
+        ("rows-per-partition", bpo::value<unsigned>()->default_value(4), "Number of rows in each partition")
+        ("row-size", bpo::value<unsigned>()->default_value(1024), "Size of the value of each row [bytes]")
+        ("zipf-exponent", bpo::value<double>()->default_value(0.99), "Exponent of the zipf workload")
+        ("hot-fraction", bpo::value<double>()->default_value(0.01), "Fraction of partitions in the hot set of the hotset workload")
+        ("hot-ratio", bpo::value<double>()->default_value(0.9), "Fraction of reads going to the hot set of the hotset workload")
+        ("shift-seconds", bpo::value<unsigned>()->default_value(10), "Period [s] after which the hot set of the hotset workload moves")
+        ("trace-file", bpo::value<std::string>(), "Trace of partition keys for the trace workload")
+        ("scan-ratio", bpo::value<double>()->default_value(0), "Fraction of reads which are range scans")
+        ("scan-rows", bpo::value<unsigned>()->default_value(1000), "Number of rows read by each range scan")
+        ("concurrency", bpo::value<unsigned>()->default_value(10), "Number of concurrent reads")
+        ("admission-filter", "Enable the cache admission filter")
+        ("compressed-tier-fraction", bpo::value<double>()->default_value(0), "Fraction of cache memory for the compressed tier")
+        ("seconds", bpo::value<unsigned>()->default_value(60), "Duration [s] of the read phase")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        if (app.configuration().contains("trace")) {
+            testlog.set_level(seastar::log_level::trace);
+        }
+
+        auto cfg_ptr = make_shared<db::config>();
+        auto& cfg = *cfg_ptr;
+        cfg.enable_commitlog(false);
+        cfg.enable_cache(true);
+        cfg.cache_admission_filter(app.configuration().contains("admission-filter"));
+        cfg.cache_compressed_tier_memory_fraction(app.configuration()["compressed-tier-fraction"].as<double>());
+
+        return do_with_cql_env_thread([&app] (cql_test_env& env) {
+            auto& opts = app.configuration();
+            auto workload = opts["workload"].as<std::string>();
+            auto partitions = opts["partitions"].as<int64_t>();
+            auto rows_per_partition = opts["rows-per-partition"].as<unsigned>();
+            auto scan_ratio = opts["scan-ratio"].as<double>();
+            auto scan_rows = opts["scan-rows"].as<unsigned>();
+            auto concurrency = opts["concurrency"].as<unsigned>();
+            auto seconds = opts["seconds"].as<unsigned>();
+
+            if (partitions <= 0) {
+                throw std::invalid_argument("--partitions must be positive");
+            }
+
+            std::mt19937_64 rnd(std::random_device{}());
+            std::unique_ptr<key_generator> keys;
+            hot_set_key_generator* hot_set = nullptr;
+            if (workload == "uniform") {
+                keys = std::make_unique<uniform_key_generator>(rnd, partitions);
+            } else if (workload == "zipf") {
+                keys = std::make_unique<zipf_key_generator>(rnd, partitions, opts["zipf-exponent"].as<double>());
+            } else if (workload == "hotset") {
+                auto g = std::make_unique<hot_set_key_generator>(rnd, partitions, opts["hot-fraction"].as<double>(), opts["hot-ratio"].as<double>());
+                hot_set = g.get();
+                keys = std::move(g);
+            } else if (workload == "trace") {
+                if (!opts.contains("trace-file")) {
+                    throw std::invalid_argument("The trace workload requires --trace-file");
+                }
+                keys = std::make_unique<trace_key_generator>(rnd, partitions, opts["trace-file"].as<std::string>());
+            } else {
+                throw std::invalid_argument(format("Unknown workload: {}", workload));
+            }
+
+            engine().at_exit([] {
+                cancelled = true;
+                return make_ready_future();
+            });
+
+            env.execute_cql("CREATE TABLE ks.cf (pk bigint, ck int, v blob, PRIMARY KEY (pk, ck))").get();
+            replica::database& db = env.local_db();
+            auto s = db.find_schema("ks", "cf");
+            replica::column_family& cf = db.find_column_family(s->id());
+            cf.set_compaction_strategy(sstables::compaction_strategy_type::null);
+
+            testlog.info("Populating {} partitions", partitions);
+            auto&& col = *s->get_column_definition(to_bytes("v"));
+            auto value = bytes(bytes::initialized_later(), opts["row-size"].as<unsigned>());
+            for (int64_t pk : boost::irange<int64_t>(0, partitions)) {
+                mutation m(s, partition_key::from_single_value(*s, serialized(pk)));
+                for (int32_t ck : boost::irange<int32_t>(0, rows_per_partition)) {
+                    m.set_clustered_cell(clustering_key::from_single_value(*s, serialized(ck)), col,
+                            atomic_cell::make_live(*col.type, api::new_timestamp(), value));
+                }
+                db.apply(s, freeze(m), tracing::trace_state_ptr(), db::commitlog::force_sync::no, db::no_timeout).get();
+            }
+            cf.flush().get();
+            cf.get_row_cache().evict();
+
+            auto& tracker = db.row_cache_tracker();
+            auto MB = 1024 * 1024;
+            testlog.info("Reading, cache: {:d}/{:d} [MB]", tracker.region().occupancy().used_space() / MB,
+                    tracker.region().occupancy().total_space() / MB);
+
+            uint64_t reads = 0;
+            uint64_t scans = 0;
+            utils::estimated_histogram reads_hist;
+            utils::estimated_histogram total_reads_hist;
+            auto start_stats = tracker.get_stats();
+            auto start_lsa_stats = logalloc::shard_tracker().statistics();
+
+            timer<> completion_timer;
+            completion_timer.set_callback([&] {
+                testlog.info("Test done.");
+                cancelled = true;
+            });
+            completion_timer.arm(std::chrono::seconds(seconds));
+
+            timer<> shift_timer;
+            if (hot_set) {
+                shift_timer.set_callback([&] {
+                    hot_set->shift();
+                });
+                shift_timer.arm_periodic(std::chrono::seconds(opts["shift-seconds"].as<unsigned>()));
+            }
+
+            auto hit_ratio = [] (uint64_t hits, uint64_t misses) {
+                return hits + misses ? double(hits) / (hits + misses) : 0.0;
+            };
+
+            timer<> stats_printer;
+            monotonic_counter<uint64_t> reads_ctr([&] { return reads; });
+            monotonic_counter<uint64_t> scans_ctr([&] { return scans; });
+            monotonic_counter<uint64_t> phits_ctr([&] { return tracker.get_stats().partition_hits; });
+            monotonic_counter<uint64_t> pmisses_ctr([&] { return tracker.get_stats().partition_misses; });
+            monotonic_counter<uint64_t> rhits_ctr([&] { return tracker.get_stats().row_hits; });
+            monotonic_counter<uint64_t> rmisses_ctr([&] { return tracker.get_stats().row_misses; });
+            monotonic_counter<uint64_t> peviction_ctr([&] { return tracker.get_stats().partition_evictions; });
+            monotonic_counter<uint64_t> reviction_ctr([&] { return tracker.get_stats().row_evictions; });
+            monotonic_counter<uint64_t> compacted_ctr([&] { return logalloc::shard_tracker().statistics().memory_compacted; });
+            monotonic_counter<uint64_t> evicted_ctr([&] { return logalloc::shard_tracker().statistics().memory_evicted; });
+            stats_printer.set_callback([&] {
+                auto phits = phits_ctr.change();
+                auto rhits = rhits_ctr.change();
+                std::cout << format("rd/s: {:d}, scan/s: {:d}, hit ratio: {:.3f} (rows: {:.3f}), pev/s: {:d}, rev/s: {:d}, LSA compacted: {:d} [MB/s], LSA evicted: {:d} [MB/s], cache: {:d}/{:d} [MB]",
+                    reads_ctr.change(),
+                    scans_ctr.change(),
+                    hit_ratio(phits, pmisses_ctr.change()),
+                    hit_ratio(rhits, rmisses_ctr.change()),
+                    peviction_ctr.change(),
+                    reviction_ctr.change(),
+                    compacted_ctr.change() / MB,
+                    evicted_ctr.change() / MB,
+                    tracker.region().occupancy().used_space() / MB,
+                    tracker.region().occupancy().total_space() / MB) << "\n";
+                std::cout << format("reads : 50%: {:-6d}, 99%: {:-6d}, max: {:-6d} [us]",
+                    reads_hist.percentile(0.5),
+                    reads_hist.percentile(0.99),
+                    reads_hist.percentile(1.0)) << "\n\n";
+                reads_hist.clear();
+            });
+            stats_printer.arm_periodic(1s);
+
+            auto point_read = env.prepare("SELECT * FROM ks.cf WHERE pk = ?").get();
+            auto range_scan = env.prepare(format("SELECT * FROM ks.cf WHERE token(pk) >= ? LIMIT {}", scan_rows)).get();
+
+            using clock = std::chrono::steady_clock;
+            std::uniform_real_distribution<double> scan_dist(0, 1);
+            std::uniform_int_distribution<int64_t> token_dist(std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::max());
+
+            parallel_for_each(boost::irange(0u, concurrency), [&] (unsigned) {
+                return seastar::async([&] {
+                    while (!cancelled) {
+                        auto t0 = clock::now();
+                        if (scan_ratio > 0 && scan_dist(rnd) < scan_ratio) {
+                            env.execute_prepared(range_scan, {cql3::raw_value::make_value(serialized(token_dist(rnd)))}).get();
+                            ++scans;
+                        } else {
+                            env.execute_prepared(point_read, {cql3::raw_value::make_value(serialized(keys->next()))}).get();
+                        }
+                        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - t0).count();
+                        reads_hist.add(latency);
+                        total_reads_hist.add(latency);
+                        ++reads;
+                    }
+                });
+            }).get();
+
+            stats_printer.cancel();
+            shift_timer.cancel();
+            completion_timer.cancel();
+
+            auto stats = tracker.get_stats();
+            auto lsa_stats = logalloc::shard_tracker().statistics() - start_lsa_stats;
+            std::cout << format("Total: reads: {:d}, scans: {:d}, hit ratio: {:.3f} (rows: {:.3f}), partition evictions: {:d}, row evictions: {:d}, admission rejections: {:d}",
+                reads,
+                scans,
+                hit_ratio(stats.partition_hits - start_stats.partition_hits, stats.partition_misses - start_stats.partition_misses),
+                hit_ratio(stats.row_hits - start_stats.row_hits, stats.row_misses - start_stats.row_misses),
+                stats.partition_evictions - start_stats.partition_evictions,
+                stats.row_evictions - start_stats.row_evictions,
+                stats.partition_admission_rejections - start_stats.partition_admission_rejections) << "\n";
+            std::cout << format("LSA: compacted: {:d} [MB], evicted: {:d} [MB], segments compacted: {:d}, on-demand reclaims: {:d}",
+                lsa_stats.memory_compacted / MB,
+                lsa_stats.memory_evicted / MB,
+                lsa_stats.segments_compacted,
+                lsa_stats.on_demand_reclaims) << "\n";
+            std::cout << format("reads : 50%: {:-6d}, 90%: {:-6d}, 99%: {:-6d}, 99.9%: {:-6d}, max: {:-6d} [us]",
+                total_reads_hist.percentile(0.5),
+                total_reads_hist.percentile(0.9),
+                total_reads_hist.percentile(0.99),
+                total_reads_hist.percentile(0.999),
+                total_reads_hist.percentile(1.0)) << "\n";
+        }, cfg_ptr);
+    });
+}
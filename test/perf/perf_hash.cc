@@ -35,5 +35,17 @@ int main(int argc, char* argv[]) {
         sink += dst[1];
     });
 
+    std::cout << "Timing batched hash of 4 keys...\n";
+
+    const std::array<bytes_view, 4> keys = {src, src, src, src};
+    time_it([&] {
+        std::array<std::array<uint64_t, 2>, 4> dst;
+        utils::murmur_hash::hash3_x64_128(keys, seed, dst);
+        for (auto& d : dst) {
+            sink += d[0];
+            sink += d[1];
+        }
+    });
+
     black_hole = sink;
 }
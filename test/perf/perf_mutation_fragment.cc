@@ -12,6 +12,7 @@
 #include "test/perf/perf.hh"
 
 #include "mutation/mutation_fragment.hh"
+#include "mutation/range_tombstone_change_generator.hh"
 
 namespace tests {
 
@@ -133,4 +134,116 @@ PERF_TEST_F(clustering_row, hash_1M)
     });
 }
 
+// Partitions of queue-like tables, which keep deleting the oldest entries
+class range_tombstones {
+public:
+    static constexpr uint32_t count = 10000;
+private:
+    mutable simple_schema _schema;
+    // Disjoint tombstones, in clustering order and with increasing timestamps
+    std::vector<range_tombstone> _disjoint;
+    // Tombstones with a common start and increasing ends, each covering the previous one
+    std::vector<range_tombstone> _prefixes;
+    range_tombstone_list _list;
+public:
+    range_tombstones()
+        : _list(*_schema.schema())
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            _disjoint.push_back(_schema.make_range_tombstone(_schema.make_ckey_range(2 * i, 2 * i + 1)));
+            _prefixes.push_back(_schema.make_range_tombstone(_schema.make_ckey_range(0, i)));
+        }
+        _list = make_list(_disjoint.begin(), _disjoint.end());
+    }
+
+    const schema& s() const { return *_schema.schema(); }
+    const std::vector<range_tombstone>& disjoint() const { return _disjoint; }
+    const std::vector<range_tombstone>& prefixes() const { return _prefixes; }
+    const range_tombstone_list& list() const { return _list; }
+    simple_schema& simple() const { return _schema; }
+
+    template <typename Iterator>
+    range_tombstone_list make_list(Iterator begin, Iterator end) const {
+        range_tombstone_list list(s());
+        for (auto it = begin; it != end; ++it) {
+            list.apply(s(), *it);
+        }
+        return list;
+    }
+};
+
+PERF_TEST_F(range_tombstones, apply_disjoint)
+{
+    auto list = make_list(disjoint().begin(), disjoint().end());
+    perf_tests::do_not_optimize(list);
+    return count;
+}
+
+PERF_TEST_F(range_tombstones, apply_prefixes)
+{
+    auto list = make_list(prefixes().begin(), prefixes().end());
+    perf_tests::do_not_optimize(list);
+    return count;
+}
+
+PERF_TEST_F(range_tombstones, merge_appended)
+{
+    // Merging a newer memtable into an older version of the partition
+    auto half = disjoint().begin() + count / 2;
+    auto older = make_list(disjoint().begin(), half);
+    auto newer = make_list(half, disjoint().end());
+    perf_tests::start_measuring_time();
+    older.apply_monotonically(s(), std::move(newer));
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(older);
+    return count / 2;
+}
+
+PERF_TEST_F(range_tombstones, merge_interleaved)
+{
+    auto odd = range_tombstone_list(s());
+    auto even = range_tombstone_list(s());
+    for (uint32_t i = 0; i < count; i++) {
+        (i % 2 ? odd : even).apply(s(), disjoint()[i]);
+    }
+    perf_tests::start_measuring_time();
+    even.apply_monotonically(s(), std::move(odd));
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(even);
+    return count / 2;
+}
+
+PERF_TEST_F(range_tombstones, slice)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        perf_tests::do_not_optimize(list().slice(s(), simple().make_ckey_range(2 * i + 1, 2 * i + 2)));
+    }
+    return count;
+}
+
+PERF_TEST_F(range_tombstones, search_covering)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        perf_tests::do_not_optimize(list().search_tombstone_covering(s(), simple().make_ckey(2 * i)));
+    }
+    return count;
+}
+
+PERF_TEST_F(range_tombstones, change_generator)
+{
+    range_tombstone_change_generator gen(s());
+    size_t changes = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        gen.consume(disjoint()[i]);
+        gen.flush(disjoint()[i].end_position(), [&] (range_tombstone_change rtc) {
+            ++changes;
+        });
+    }
+    gen.flush(position_in_partition::after_all_clustered_rows(), [&] (range_tombstone_change rtc) {
+        ++changes;
+    });
+    perf_tests::do_not_optimize(changes);
+    return count;
+}
+
 }
@@ -70,9 +70,11 @@ struct test_config {
     bool query_single_key;
     unsigned duration_in_seconds;
     bool counters;
+    bool lwt;
     bool flush_memtables;
     unsigned memtable_partitions = 0;
     unsigned operations_per_shard = 0;
+    unsigned rate_per_core = 0;
     bool stop_on_error;
     sstring timeout;
     bool bypass_cache;
@@ -99,10 +101,12 @@ std::ostream& operator<<(std::ostream& os, const test_config::frontend_type& f)
 std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
     return os << "{partitions=" << cfg.partitions
            << ", concurrency=" << cfg.concurrency
+           << ", rate=" << cfg.rate_per_core
            << ", mode=" << cfg.mode
            << ", frontend=" << cfg.frontend
            << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
            << ", counters=" << (cfg.counters ? "yes" : "no")
+           << ", lwt=" << (cfg.lwt ? "yes" : "no")
            << "}";
 }
 
@@ -148,10 +152,16 @@ static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
+    // Conditional updates only apply to existing rows
+    sstring condition;
+    if (cfg.lwt) {
+        create_partitions(env, cfg);
+        condition = " IF EXISTS";
+    }
     sstring usings;
     if (!cfg.timeout.empty()) {
         usings += "USING TIMEOUT " + cfg.timeout;
@@ -162,12 +172,12 @@ static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg)
             "\"C2\" = 0x583449ce81bfebc2e1a695eb59aad5fcc74d6d7311fc6197b10693e1a161ca2e1c64,"
             "\"C3\" = 0x62bcb1dbc0ff953abc703bcb63ea954f437064c0c45366799658bd6b91d0f92908d7,"
             "\"C4\" = 0x222fcbe31ffa1e689540e1499b87fa3f9c781065fccd10e4772b4c7039c2efd0fb27 "
-            "WHERE \"KEY\" = ?", usings);
+            "WHERE \"KEY\" = ?{}", usings, condition);
     auto id = env.prepare(query).get();
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg) {
@@ -181,7 +191,7 @@ static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg)
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static std::vector<perf_result> test_counter_update(cql_test_env& env, test_config& cfg) {
@@ -200,7 +210,7 @@ static std::vector<perf_result> test_counter_update(cql_test_env& env, test_conf
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static schema_ptr make_counter_schema(std::string_view ks_name) {
@@ -313,7 +323,7 @@ static std::vector<perf_result> test_alternator_read(service::client_state& stat
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.get_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static std::vector<perf_result> test_alternator_write(service::client_state& state, alternator::executor& executor, test_config& cfg) {
@@ -356,7 +366,7 @@ static std::vector<perf_result> test_alternator_write(service::client_state& sta
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.update_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static std::vector<perf_result> test_alternator_delete(service::client_state& state, noncopyable_function<void()> flush_memtables,
@@ -375,7 +385,7 @@ static std::vector<perf_result> test_alternator_delete(service::client_state& st
             }
         )";
         return executor.delete_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(json)).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate_per_core);
 }
 
 static std::vector<perf_result> do_alternator_test(std::string isolation_level,
@@ -467,6 +477,9 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     if (cfg.initial_tablets) {
         params["initial_tablets"] = cfg.initial_tablets.value();
     }
+    if (cfg.rate_per_core) {
+        params["rate"] = cfg.rate_per_core;
+    }
     results["parameters"] = std::move(params);
 
     Json::Value stats;
@@ -480,6 +493,13 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     stats["mad tps"] = agg.throughput.median_absolute_deviation;
     stats["max tps"] = agg.throughput.max;
     stats["min tps"] = agg.throughput.min;
+    if (auto& l = med.latencies) {
+        stats["p50 latency us"] = l->p50;
+        stats["p90 latency us"] = l->p90;
+        stats["p99 latency us"] = l->p99;
+        stats["p999 latency us"] = l->p999;
+        stats["max latency us"] = l->max;
+    }
     results["stats"] = std::move(stats);
 
     std::string test_type;
@@ -531,9 +551,11 @@ int scylla_simple_query_main(int argc, char** argv) {
         ("delete", "test delete path instead of read path")
         ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
         ("query-single-key", "test reading with a single key instead of random keys")
-        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core, or the maximum number of operations in flight per core with --rate")
+        ("rate", bpo::value<unsigned>(), "start operations at this rate per core and second, whether or not the earlier ones completed, and report their latencies")
         ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
         ("counters", "test counters")
+        ("lwt", "with --write, test conditional updates (lightweight transactions) of existing rows")
         ("tablets", "use tablets")
         ("initial-tablets", bpo::value<unsigned>()->default_value(128), "initial number of tablets")
         ("flush", "flush memtables before test")
@@ -574,6 +596,7 @@ int scylla_simple_query_main(int argc, char** argv) {
             cfg.concurrency = app.configuration()["concurrency"].as<unsigned>();
             cfg.query_single_key = app.configuration().contains("query-single-key");
             cfg.counters = app.configuration().contains("counters");
+            cfg.lwt = app.configuration().contains("lwt");
             cfg.flush_memtables = app.configuration().contains("flush");
             if (app.configuration().contains("tablets")) {
                 cfg.initial_tablets = app.configuration()["initial-tablets"].as<unsigned>();
@@ -593,6 +616,9 @@ int scylla_simple_query_main(int argc, char** argv) {
             if (app.configuration().contains("operations-per-shard")) {
                 cfg.operations_per_shard = app.configuration()["operations-per-shard"].as<unsigned>();
             }
+            if (app.configuration().contains("rate")) {
+                cfg.rate_per_core = app.configuration()["rate"].as<unsigned>();
+            }
             if (app.configuration().contains("memtable-partitions")) {
                 cfg.memtable_partitions = app.configuration()["memtable-partitions"].as<unsigned>();
             }
@@ -41,6 +41,14 @@ future<> test_compaction(distributed<perf_sstable_test_env>& dt) {
         }).then([&dt] {
             return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::compaction);
         }).get();
+        auto totals = dt.map_reduce0([] (const perf_sstable_test_env& t) { return t.get_compaction_totals(); },
+                perf_sstable_test_env::compaction_totals(), std::plus<perf_sstable_test_env::compaction_totals>()).get();
+        // The shards compact in parallel, so the sum of the bytes over the sum
+        // of the durations is the throughput of one shard.
+        std::cout << format("{:.2f} MB/s per shard, {:.3f} output bytes per input byte, {:.2f} CPU ns per input byte\n",
+                totals.input_bytes / totals.seconds / 1e6,
+                double(totals.output_bytes) / totals.input_bytes,
+                totals.cpu_seconds * 1e9 / totals.input_bytes);
     });
 }
 
@@ -60,6 +68,13 @@ enum class test_modes {
     compaction,
 };
 
+static std::unordered_map<sstring, compaction_workload> compaction_workloads = {
+    {"overwrite", compaction_workload::overwrite },
+    {"disjoint", compaction_workload::disjoint },
+    {"expired", compaction_workload::expired },
+    {"deleted", compaction_workload::deleted },
+};
+
 static std::unordered_map<sstring, test_modes> test_mode = {
     {"sequential_read", test_modes::sequential_read },
     {"index_read", test_modes::index_read },
@@ -86,7 +101,11 @@ int scylla_sstable_main(int argc, char** argv) {
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
-        ("timestamp-range", bpo::value<api::timestamp_type>()->default_value(0), "Timestamp values to use, chosen uniformly from: [-x, +x]");
+        ("timestamp-range", bpo::value<api::timestamp_type>()->default_value(0), "Timestamp values to use, chosen uniformly from: [-x, +x]")
+        ("rows-per-partition", bpo::value<unsigned>()->default_value(1), "number of rows per partition (valid only for compaction mode)")
+        ("workload", bpo::value<sstring>()->default_value("overwrite"), "data of the compacted sstables (valid only for compaction mode), one of: "
+             "overwrite (all sstables have the same partitions), disjoint (each sstable has partitions of its own), "
+             "expired (like overwrite, with expired cells), deleted (like overwrite, with every other sstable deleting the partitions)");
 
     return app.run_deprecated(argc, argv, [&app] {
         auto test = make_lw_shared<distributed<perf_sstable_test_env>>();
@@ -110,6 +129,12 @@ int scylla_sstable_main(int argc, char** argv) {
         }
         cfg.compaction_strategy = sstables::compaction_strategy::type(app.configuration()["compaction-strategy"].as<sstring>());
         cfg.timestamp_range = app.configuration()["timestamp-range"].as<api::timestamp_type>();
+        cfg.rows_per_partition = app.configuration()["rows-per-partition"].as<unsigned>();
+        auto workload = compaction_workloads.find(app.configuration()["workload"].as<sstring>());
+        if (workload == compaction_workloads.end()) {
+            throw std::invalid_argument("Invalid workload");
+        }
+        cfg.workload = workload->second;
         return test->start(std::move(cfg)).then([mode, dir, test] {
             engine().at_exit([test] { return test->stop(); });
             if ((mode == test_modes::index_read) ||
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <seastar/core/thread_cputime_clock.hh>
 #include <seastar/util/closeable.hh>
 
 #include "sstables/sstables.hh"
@@ -83,6 +84,18 @@ class test_setup {
     }
 };
 
+// The data of the sstables compacted in the compaction mode
+enum class compaction_workload {
+    // All sstables have the same partitions
+    overwrite,
+    // Every sstable has partitions of its own
+    disjoint,
+    // Like overwrite, with cells whose TTL expired
+    expired,
+    // Like overwrite, with every other sstable deleting the partitions
+    deleted,
+};
+
 class perf_sstable_test_env {
     test_env _env;
 
@@ -97,6 +110,19 @@ class perf_sstable_test_env {
         sstring dir;
         sstables::compaction_strategy_type compaction_strategy;
         api::timestamp_type timestamp_range;
+        unsigned rows_per_partition = 1;
+        compaction_workload workload = compaction_workload::overwrite;
+    };
+
+    struct compaction_totals {
+        uint64_t input_bytes = 0;
+        uint64_t output_bytes = 0;
+        double seconds = 0;
+        double cpu_seconds = 0;
+
+        compaction_totals operator+(const compaction_totals& o) const {
+            return {input_bytes + o.input_bytes, output_bytes + o.output_bytes, seconds + o.seconds, cpu_seconds + o.cpu_seconds};
+        }
     };
 
 private:
@@ -126,6 +152,8 @@ class perf_sstable_test_env {
     std::uniform_int_distribution<char> _distribution;
     lw_shared_ptr<replica::memtable> _mt;
     std::vector<shared_sstable> _sst;
+    std::vector<dht::decorated_key> _keys;
+    compaction_totals _compaction_totals;
 
     schema_ptr create_schema(sstables::compaction_strategy_type type) {
         std::vector<schema::column> columns;
@@ -134,11 +162,16 @@ class perf_sstable_test_env {
             columns.push_back(schema::column{ to_bytes(format("column{:04d}", i)), utf8_type });
         }
 
+        std::vector<schema::column> clustering_columns;
+        if (_cfg.rows_per_partition > 1) {
+            clustering_columns.push_back(schema::column{ "ck", int32_type });
+        }
+
         schema_builder builder(make_shared_schema(generate_legacy_id("ks", "perf-test"), "ks", "perf-test",
             // partition key
             {{"name", utf8_type}},
             // clustering key
-            {},
+            { clustering_columns },
             // regular columns
             { columns },
             // static columns
@@ -149,9 +182,33 @@ class perf_sstable_test_env {
             "Perf tests"
         ));
         builder.set_compaction_strategy(type);
+        // So that compaction can purge expired cells and tombstones
+        builder.set_gc_grace_seconds(0);
         return builder.build(schema_builder::compact_storage::no);
     }
 
+    mutation make_mutation(const dht::decorated_key& key, unsigned sstable) {
+        auto mut = mutation(s, key);
+        if (_cfg.workload == compaction_workload::deleted && sstable % 2) {
+            mut.partition().apply(tombstone(_cfg.timestamp_range + 1, gc_clock::now()));
+            return mut;
+        }
+        for (unsigned row = 0; row < std::max(_cfg.rows_per_partition, 1u); ++row) {
+            auto ck = s->clustering_key_size() ? clustering_key::from_singular(*s, int32_t(row)) : clustering_key::make_empty();
+            for (auto& cdef: s->regular_columns()) {
+                const auto ts = _cfg.timestamp_range ? tests::random::get_int<api::timestamp_type>(-_cfg.timestamp_range, _cfg.timestamp_range) : 0;
+                auto value = utf8_type->decompose(random_column());
+                if (_cfg.workload == compaction_workload::expired) {
+                    auto ttl = std::chrono::seconds(1);
+                    mut.set_clustered_cell(ck, cdef, atomic_cell::make_live(*utf8_type, ts, value, gc_clock::now() - ttl, ttl));
+                } else {
+                    mut.set_clustered_cell(ck, cdef, atomic_cell::make_live(*utf8_type, ts, value));
+                }
+            }
+        }
+        return mut;
+    }
+
 public:
     perf_sstable_test_env(conf cfg) : _cfg(std::move(cfg))
            , s(create_schema(cfg.compaction_strategy))
@@ -164,20 +221,25 @@ class perf_sstable_test_env {
         return _env.stop();
     }
 
-    future<> fill_memtable() {
-        auto idx = boost::irange(0, int(_cfg.partitions / _cfg.sstables));
-        auto local_keys = tests::generate_partition_keys(int(_cfg.partitions / _cfg.sstables), s, local_shard_only::yes, tests::key_size{_cfg.key_size, _cfg.key_size});
-        return do_for_each(idx.begin(), idx.end(), [this, local_keys = std::move(local_keys)] (auto iteration) {
-            auto mut = mutation(this->s, local_keys.at(iteration));
-            for (auto& cdef: this->s->regular_columns()) {
-                const auto ts = _cfg.timestamp_range ? tests::random::get_int<api::timestamp_type>(-_cfg.timestamp_range, _cfg.timestamp_range) : 0;
-                mut.set_clustered_cell(clustering_key::make_empty(), cdef, atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose(this->random_column())));
-            }
-            this->_mt->apply(std::move(mut));
+    // Fills the memtable with the data of the given sstable of the compaction mode
+    future<> fill_memtable(unsigned sstable = 0) {
+        auto partitions = _cfg.partitions / _cfg.sstables;
+        if (_keys.empty()) {
+            auto nr_keys = _cfg.workload == compaction_workload::disjoint ? partitions * _cfg.sstables : partitions;
+            _keys = tests::generate_partition_keys(nr_keys, s, local_shard_only::yes, tests::key_size{_cfg.key_size, _cfg.key_size});
+        }
+        auto first = _cfg.workload == compaction_workload::disjoint ? sstable * partitions : 0;
+        auto idx = boost::irange(first, first + partitions);
+        return do_for_each(idx.begin(), idx.end(), [this, sstable] (auto i) {
+            this->_mt->apply(make_mutation(_keys.at(i), sstable));
             return make_ready_future<>();
         });
     }
 
+    const compaction_totals& get_compaction_totals() const {
+        return _compaction_totals;
+    }
+
     future<> load_sstables(unsigned iterations) {
         _sst.push_back(_env.make_sstable(s, this->dir()));
         return _sst.back()->load(s->get_sharder());
@@ -217,6 +279,10 @@ class perf_sstable_test_env {
 
                 std::vector<shared_sstable> ssts;
                 for (auto i = 0u; i < _cfg.sstables; i++) {
+                    if (_cfg.workload != compaction_workload::overwrite) {
+                        _mt = make_lw_shared<replica::memtable>(s);
+                        fill_memtable(i).get();
+                    }
                     auto sst = sst_gen();
                     write_memtable_to_sstable(*_mt, sst).get();
                     sst->open_data().get();
@@ -231,6 +297,7 @@ class perf_sstable_test_env {
                 auto cf = make_lw_shared<replica::column_family>(s, env.make_table_config(), make_lw_shared<replica::storage_options>(), *cm, env.manager(), cl_stats, tracker, nullptr);
 
                 auto start = perf_sstable_test_env::now();
+                auto cpu_start = thread_cputime_clock::now();
 
                 auto descriptor = sstables::compaction_descriptor(std::move(ssts));
                 descriptor.enable_garbage_collection(cf->get_sstable_set());
@@ -242,17 +309,23 @@ class perf_sstable_test_env {
                 compaction_progress_monitor progress_monitor;
                 auto ret = sstables::compact_sstables(std::move(descriptor), cdata, cf->try_get_table_state_with_static_sharding(), progress_monitor).get();
                 auto end = perf_sstable_test_env::now();
+                auto cpu_end = thread_cputime_clock::now();
 
                 auto partitions_per_sstable = _cfg.partitions / _cfg.sstables;
-                if (_cfg.compaction_strategy != sstables::compaction_strategy_type::time_window) {
-                    assert(ret.new_sstables.size() == 1);
-                }
                 auto total_keys_written = std::accumulate(ret.new_sstables.begin(), ret.new_sstables.end(), uint64_t(0), [] (uint64_t n, const sstables::shared_sstable& sst) {
                     return n + sst->get_estimated_key_count();
                 });
-                assert(total_keys_written >= partitions_per_sstable);
+                // Expired and deleted data may be purged entirely
+                if (_cfg.workload == compaction_workload::overwrite || _cfg.workload == compaction_workload::disjoint) {
+                    if (_cfg.compaction_strategy != sstables::compaction_strategy_type::time_window) {
+                        assert(ret.new_sstables.size() == 1);
+                    }
+                    assert(total_keys_written >= partitions_per_sstable);
+                }
 
                 auto duration = std::chrono::duration<double>(end - start).count();
+                _compaction_totals = _compaction_totals + compaction_totals{ret.stats.start_size, ret.stats.end_size, duration,
+                        std::chrono::duration<double>(cpu_end - cpu_start).count()};
                 return total_keys_written / duration;
             });
         });
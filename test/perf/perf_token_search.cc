@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/test_runner.hh>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+
+#include "dht/token.hh"
+#include "utils/bptree.hh"
+
+// Lookups of partitions by token, the way memtable and row cache do them
+
+static_assert(bplus::SimpleLessCompare<int64_t, dht::raw_token_less_comparator>);
+
+template <bplus::key_search Search>
+using token_tree = bplus::tree<int64_t, uint64_t, dht::raw_token_less_comparator, 16, Search>;
+
+class token_search {
+public:
+    static constexpr size_t partitions = 1 << 20;
+    static constexpr size_t lookups = 1000;
+    static constexpr int node_size = 16;
+private:
+    token_tree<bplus::key_search::linear> _linear;
+    token_tree<bplus::key_search::binary> _binary;
+    std::vector<int64_t> _keys;
+    // A sorted node worth of keys, padded the way bptree pads its nodes
+    std::array<int64_t, node_size> _node;
+public:
+    token_search()
+        : _linear(dht::raw_token_less_comparator{})
+        , _binary(dht::raw_token_less_comparator{})
+    {
+        auto eng = seastar::testing::local_random_engine;
+        auto dist = std::uniform_int_distribution<int64_t>(std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::max());
+        for (size_t i = 0; i < partitions; i++) {
+            auto k = dist(eng);
+            _linear.emplace(k, i);
+            _binary.emplace(k, i);
+        }
+        _keys.resize(lookups);
+        std::generate(_keys.begin(), _keys.end(), [&] { return dist(eng); });
+
+        std::generate(_node.begin(), _node.end(), [&] { return dist(eng); });
+        std::sort(_node.begin(), _node.begin() + node_size * 3 / 4);
+        std::fill(_node.begin() + node_size * 3 / 4, _node.end(), utils::simple_key_unused_value);
+    }
+
+    ~token_search() {
+        _linear.clear();
+        _binary.clear();
+    }
+
+    template <bplus::key_search Search>
+    size_t lower_bound(const token_tree<Search>& t) const {
+        for (auto k : _keys) {
+            perf_tests::do_not_optimize(t.lower_bound(k));
+        }
+        return lookups;
+    }
+
+    size_t linear_lower_bound() const { return lower_bound(_linear); }
+    size_t binary_lower_bound() const { return lower_bound(_binary); }
+
+    size_t search_node() const {
+        for (auto k : _keys) {
+            perf_tests::do_not_optimize(utils::array_search_gt(k, _node.data(), node_size, node_size * 3 / 4));
+        }
+        return lookups;
+    }
+};
+
+PERF_TEST_F(token_search, tree_lower_bound_linear) {
+    return linear_lower_bound();
+}
+
+PERF_TEST_F(token_search, tree_lower_bound_binary) {
+    return binary_lower_bound();
+}
+
+PERF_TEST_F(token_search, node_array_search_gt) {
+    return search_node();
+}
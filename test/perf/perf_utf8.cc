@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#include "utils/utf8.hh"
+
+class utf8_text {
+public:
+    static constexpr size_t size = 4096;
+private:
+    bytes _ascii;
+    bytes _multi_byte;
+public:
+    utf8_text()
+        : _ascii(bytes::initialized_later{}, size)
+        , _multi_byte(bytes::initialized_later{}, size)
+    {
+        for (size_t i = 0; i < size; i++) {
+            _ascii[i] = 'a' + i % 26;
+        }
+        // "ł" (U+0142) interleaved with ASCII.
+        for (size_t i = 0; i + 3 <= size; i += 3) {
+            _multi_byte[i] = 'a';
+            _multi_byte[i + 1] = '\xc5';
+            _multi_byte[i + 2] = '\x82';
+        }
+        for (size_t i = size - size % 3; i < size; i++) {
+            _multi_byte[i] = 'a';
+        }
+    }
+
+    bytes_view ascii() const { return _ascii; }
+    bytes_view multi_byte() const { return _multi_byte; }
+};
+
+PERF_TEST_F(utf8_text, validate_ascii) {
+    perf_tests::do_not_optimize(utils::utf8::validate(ascii()));
+    return size;
+}
+
+PERF_TEST_F(utf8_text, validate_multi_byte) {
+    perf_tests::do_not_optimize(utils::utf8::validate(multi_byte()));
+    return size;
+}
+
+PERF_TEST_F(utf8_text, validate_short_ascii) {
+    // Like the typical value of a text column.
+    perf_tests::do_not_optimize(utils::utf8::validate(ascii().substr(0, 40)));
+    return 40;
+}
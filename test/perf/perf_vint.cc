@@ -19,10 +19,13 @@ class vint {
 private:
     std::vector<uint64_t> _integers;
     bytes _serialized;
+    // Vints which fit in a single byte, like most lengths and deltas in sstables.
+    bytes _serialized_small;
 public:
     vint()
         : _integers(count)
         , _serialized(bytes::initialized_later{}, count * max_vint_length)
+        , _serialized_small(bytes::initialized_later{}, count)
     {
         auto eng = seastar::testing::local_random_engine;
         auto dist = std::uniform_int_distribution<uint64_t>{};
@@ -33,10 +36,17 @@ class vint {
             auto len = unsigned_vint::serialize(v, dst);
             dst += len;
         }
+
+        auto small_dist = std::uniform_int_distribution<uint64_t>{0, 127};
+        dst = _serialized_small.data();
+        for (auto i = 0u; i < count; i++) {
+            dst += unsigned_vint::serialize(small_dist(eng), dst);
+        }
     }
 
     const std::vector<uint64_t>& integers() const { return _integers; }
     bytes_view serialized() const { return bytes_view(_serialized.data()); }
+    bytes_view serialized_small() const { return bytes_view(_serialized_small); }
 };
 
 PERF_TEST_F(vint, serialize) {
@@ -58,3 +68,13 @@ PERF_TEST_F(vint, deserialize) {
     }
     return count;
 }
+
+PERF_TEST_F(vint, deserialize_single_byte) {
+    auto src = serialized_small();
+    for (auto i = 0u; i < count; i++) {
+        auto len = unsigned_vint::serialized_size_from_first_byte(src.front());
+        perf_tests::do_not_optimize(unsigned_vint::deserialize(src));
+        src.remove_prefix(len);
+    }
+    return count;
+}
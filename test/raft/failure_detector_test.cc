@@ -270,3 +270,46 @@ SEASTAR_TEST_CASE(failure_detector_test) {
 
     co_await fd.stop();
 }
+
+SEASTAR_TEST_CASE(failure_detector_suspicion_test) {
+    test_pinger pinger;
+    test_clock clock;
+    sharded<direct_failure_detector::failure_detector> fd;
+    co_await fd.start(std::ref(pinger), std::ref(clock), 10, 30);
+
+    test_listener l;
+    auto sub = co_await fd.local().register_listener(l, 1000);
+
+    direct_failure_detector::pinger::endpoint_id ep1{0, 1};
+    direct_failure_detector::pinger::endpoint_id ep2{0, 2};
+
+    auto tick = [&clock] (size_t n) -> future<> {
+        for (size_t i = 0; i < n; ++i) {
+            co_await clock.tick();
+        }
+    };
+
+    pinger._responding.insert(ep1);
+    fd.local().add_endpoint(ep1);
+    co_await tick(10);
+    co_await l.wait_for(ep1, true);
+
+    // While the endpoint responds regularly, the elapsed time since its last response stays
+    // around the mean interval between responses (plus the publishing delay), so phi stays low.
+    co_await tick(50);
+    BOOST_REQUIRE_LT(fd.local().suspicion(ep1), 2);
+
+    // Endpoints which are not in the detected set are not suspected.
+    BOOST_REQUIRE_EQUAL(fd.local().suspicion(ep2), 0);
+
+    // Without responses phi grows linearly, well before the listener's threshold is crossed.
+    pinger._responding.erase(ep1);
+    co_await tick(100);
+    BOOST_REQUIRE_GT(fd.local().suspicion(ep1), 3);
+    BOOST_REQUIRE(l.is_alive(ep1));
+
+    std::optional<direct_failure_detector::subscription> sub_opt{std::move(sub)};
+    sub_opt.reset();
+
+    co_await fd.stop();
+}
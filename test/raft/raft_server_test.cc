@@ -1,6 +1,7 @@
 #include "replication.hh"
 #include "utils/error_injection.hh"
 #include <seastar/util/defer.hh>
+#include <deque>
 
 #ifdef SEASTAR_DEBUG
 // Increase tick time to allow debug to process messages
@@ -67,3 +68,55 @@ SEASTAR_THREAD_TEST_CASE(test_release_memory_if_add_entry_throws) {
     cluster.read(read_value{0, 1}).get();
 #endif
 }
+
+SEASTAR_THREAD_TEST_CASE(test_concurrent_read_barriers_on_follower) {
+    raft_cluster<std::chrono::steady_clock> cluster(
+            test_case { .nodes = 2 },
+            ::apply_changes,
+            0,
+            0,
+            0, false, tick_delay, rpc_config{});
+    cluster.start_all().get();
+    auto stop = defer([&cluster] { cluster.stop_all().get(); });
+    cluster.add_entries(1, 0).get();
+    cluster.wait_log(1).get();
+
+    // Every read_barrier request sent to the leader waits for its own promise.
+    std::deque<promise<>> requests;
+    before_read_barrier_on_leader = [&requests] {
+        requests.emplace_back();
+        return requests.back().get_future();
+    };
+    auto reset_hook = defer([] { before_read_barrier_on_leader = nullptr; });
+    auto wait_for_requests = [&requests] (size_t n) {
+        for (int i = 0; i < 1000 && requests.size() < n; ++i) {
+            seastar::sleep(1ms).get();
+        }
+        // Give the barriers a chance to send more requests than they should.
+        seastar::sleep(10ms).get();
+        BOOST_REQUIRE_EQUAL(requests.size(), n);
+    };
+
+    auto& follower = cluster.get_server(1);
+    auto b1 = follower.read_barrier(nullptr);
+    wait_for_requests(1);
+
+    // Barriers which arrive while a request is in flight don't join it,
+    // they wait for it and then share the next request.
+    auto b2 = follower.read_barrier(nullptr);
+    auto b3 = follower.read_barrier(nullptr);
+    wait_for_requests(1);
+    BOOST_REQUIRE(!b2.available());
+    BOOST_REQUIRE(!b3.available());
+
+    requests[0].set_value();
+    b1.get();
+    wait_for_requests(2);
+    BOOST_REQUIRE(!b2.available());
+    BOOST_REQUIRE(!b3.available());
+
+    // A failure of the shared request reaches every barrier waiting for it.
+    requests[1].set_exception(std::runtime_error("read barrier failure"));
+    BOOST_REQUIRE_THROW(b2.get(), std::runtime_error);
+    BOOST_REQUIRE_THROW(b3.get(), std::runtime_error);
+}
@@ -17,6 +17,9 @@ seastar::semaphore snapshot_sync(0);
 raft::snapshot_id delay_apply_snapshot{utils::UUID(0, 0xdeadbeaf)};
 // sending of a snapshot with that id will be delayed until snapshot_sync is signaled
 raft::snapshot_id delay_send_snapshot{utils::UUID(0xdeadbeaf, 0)};
+// if set, a read_barrier request to the leader is only sent once the returned future resolves,
+// and fails if it fails
+std::function<future<>()> before_read_barrier_on_leader;
 
 std::vector<raft::server_id> to_raft_id_vec(std::vector<node_id> nodes) noexcept {
     std::vector<raft::server_id> ret;
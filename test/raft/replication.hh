@@ -291,6 +291,9 @@ extern seastar::semaphore snapshot_sync;
 extern raft::snapshot_id delay_apply_snapshot;
 // sending of a snapshot with that id will be delayed until snapshot_sync is signaled
 extern raft::snapshot_id delay_send_snapshot;
+// if set, a read_barrier request to the leader is only sent once the returned future resolves,
+// and fails if it fails
+extern std::function<future<>()> before_read_barrier_on_leader;
 
 // Test connectivity configuration
 struct rpc_config {
@@ -749,6 +752,11 @@ class raft_cluster<Clock>::rpc : public raft::rpc {
         if (!(*_connected)(id, _id)) {
             return make_exception_future<raft::read_barrier_reply>(std::runtime_error("cannot send append since nodes are disconnected"));
         }
+        if (before_read_barrier_on_leader) {
+            return before_read_barrier_on_leader().then([this, id] {
+                return _net[id]->_client->execute_read_barrier(_id, nullptr);
+            });
+        }
         return _net[id]->_client->execute_read_barrier(_id, nullptr);
     }
     void check_known_and_connected(raft::server_id id) {
@@ -0,0 +1,35 @@
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_lpush_lrange(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    r.delete(key)
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("LPUSH testkey")
+    assert "wrong number of arguments for 'lpush' command" in str(excinfo.value)
+
+    assert r.lpush(key, "a") == 1
+    assert r.lpush(key, "b", "c") == 3
+    assert r.lrange(key, 0, -1) == ["c", "b", "a"]
+    assert r.lrange(key, 0, 0) == ["c"]
+    assert r.lrange(key, 1, 5) == ["b", "a"]
+    assert r.lrange(key, -2, -1) == ["b", "a"]
+    assert r.lrange(key, 2, 1) == []
+    assert r.delete(key) == 1
+    assert r.lrange(key, 0, -1) == []
+
+def test_lrange_non_existent_key(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    r.delete(key)
+    assert r.lrange(key, 0, -1) == []
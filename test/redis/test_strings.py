@@ -231,3 +231,37 @@ def test_strlen_wrongtype(redis_host, redis_port):
         r.strlen(key1)
     except redis.exceptions.ResponseError as ex:
         assert str(ex) == 'WRONGTYPE Operation against a key holding the wrong kind of value'
+
+def test_mset_mget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    keys = [random_string(10) for _ in range(5)]
+    vals = [random_string(10) for _ in range(5)]
+    missing = random_string(10)
+    r.delete(missing)
+
+    assert r.mset(dict(zip(keys, vals))) == True
+    assert r.mget(keys + [missing]) == vals + [None]
+    r.delete(*keys)
+
+def test_mset_wrong_number_of_arguments(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    with pytest.raises(redis.exceptions.ResponseError, match="wrong number of arguments for 'mset' command"):
+        r.execute_command("MSET", random_string(10))
+
+def test_pipeline_replies_in_order(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    # Every command of the pipeline acts on the same key, so each reply is
+    # determined by the commands preceding it in the pipeline.
+    p = r.pipeline(transaction=False)
+    for i in range(20):
+        p.set(key, str(i))
+        p.get(key)
+        p.strlen(key)
+        p.echo(str(i))
+    p.delete(key)
+    p.get(key)
+    replies = p.execute()
+    for i in range(20):
+        assert replies[4 * i:4 * i + 4] == [True, str(i), len(str(i)), str(i)]
+    assert replies[-2:] == [1, None]
@@ -166,6 +166,13 @@ def test_task_manager_recursive_status(rest_api):
                     check_field_correctness("id", tasks[2], { "id" : f"{task3}" })
                     check_field_correctness("id", tasks[3], { "id" : f"{task2}" })
 
+def test_commitlog_replay_module(rest_api):
+    assert "commitlog_replay" in list_modules(rest_api), "commitlog_replay module was not listed"
+    # The tasks of the replay done when the node started may be gone already.
+    for task in list_tasks(rest_api, "commitlog_replay"):
+        check_field_correctness("scope", task, { "scope": "node" })
+        check_field_correctness("type", task, { "type": "commitlog_replay" })
+
 def test_module_not_exists(rest_api):
     module_name = "module_that_does_not_exist"
     resp = rest_api.send("GET", f"task_manager/list_module_tasks/{module_name}", )
@@ -0,0 +1,73 @@
+#
+# Copyright (C) 2024-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import logging
+import time
+import pytest
+
+from cassandra.query import SimpleStatement # type: ignore
+from cassandra.cluster import ConsistencyLevel # type: ignore
+
+from test.pylib.manager_client import ManagerClient
+from test.pylib.util import wait_for_cql_and_get_hosts
+from test.topology.util import wait_for_token_ring_and_group0_consistency
+from test.topology.conftest import skip_mode
+
+
+logger = logging.getLogger(__name__)
+
+
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_hints_of_same_partition_are_merged_correctly(manager: ManagerClient) -> None:
+    """Hints of the same partition which are replayed together are merged into
+       a single mutation. Check that the replica which missed the writes ends
+       up with the same data as if the hints were replayed one by one."""
+    s1 = await manager.server_add(config={
+        'error_injections_at_startup': ['decrease_hints_flush_period']
+    })
+    s2 = await manager.server_add()
+    await wait_for_token_ring_and_group0_consistency(manager, time.time() + 30)
+
+    cql = manager.get_cql()
+    await cql.run_async("create keyspace ks with replication = {'class': 'SimpleStrategy', 'replication_factor': 2}")
+    await cql.run_async("create table ks.t (pk int, ck int, v int, w int, primary key (pk, ck))")
+
+    logger.info(f"Stop {s2}")
+    await manager.server_stop(s2.server_id)
+    [h1] = await wait_for_cql_and_get_hosts(cql, [s1], time.time() + 60)
+
+    # Overwrites, deletions and writes of different columns of a few
+    # partitions, so that every batch of hints has several of each.
+    for i in range(300):
+        pk = i % 3
+        ck = i % 7
+        if i % 11 == 0:
+            stmt = f"delete from ks.t where pk = {pk} and ck = {ck}"
+        elif i % 2 == 0:
+            stmt = f"update ks.t set v = {i} where pk = {pk} and ck = {ck}"
+        else:
+            stmt = f"update ks.t set w = {i} where pk = {pk} and ck = {ck}"
+        await cql.run_async(SimpleStatement(stmt, consistency_level=ConsistencyLevel.ONE), host=h1)
+
+    async def read_all(host):
+        rows = await cql.run_async(SimpleStatement("select * from ks.t", consistency_level=ConsistencyLevel.ONE), host=host)
+        return sorted((r.pk, r.ck, r.v, r.w) for r in rows)
+
+    expected = await read_all(h1)
+    assert expected
+
+    logger.info(f"Start {s2} and wait for the hints to be replayed")
+    await manager.server_start(s2.server_id)
+    sync_point = await manager.api.client.post_json("/hinted_handoff/sync_point", host=s1.ip_addr)
+    status = await manager.api.client.get_json("/hinted_handoff/sync_point", host=s1.ip_addr,
+                                               params={"id": sync_point, "timeout": "60"})
+    assert status == "DONE"
+
+    logger.info(f"Stop {s1}, so that the data is read from {s2} only")
+    await manager.server_stop_gracefully(s1.server_id)
+    [h2] = await wait_for_cql_and_get_hosts(cql, [s2], time.time() + 60)
+    assert await read_all(h2) == expected
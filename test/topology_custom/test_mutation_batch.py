@@ -0,0 +1,86 @@
+#
+# Copyright (C) 2024-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import logging
+import time
+import pytest
+
+from cassandra.query import SimpleStatement # type: ignore
+from cassandra.cluster import ConsistencyLevel # type: ignore
+
+from test.pylib.manager_client import ManagerClient
+from test.pylib.util import wait_for_cql_and_get_hosts
+from test.topology.util import wait_for_token_ring_and_group0_consistency
+
+
+logger = logging.getLogger(__name__)
+
+
+@pytest.mark.asyncio
+async def test_mutation_batch_matches_unbatched_writes(manager: ManagerClient) -> None:
+    """Mutations of an unlogged batch which go to the same replica are sent in
+       a single mutation_batch message. Check that the replicas end up with the
+       same data as when every mutation is sent in its own message."""
+    servers = [await manager.server_add(), await manager.server_add()]
+    await wait_for_token_ring_and_group0_consistency(manager, time.time() + 30)
+
+    cql = manager.get_cql()
+    hosts = await wait_for_cql_and_get_hosts(cql, servers, time.time() + 60)
+    coordinator, replica = servers
+    await cql.run_async("create keyspace ks with replication = {'class': 'SimpleStrategy', 'replication_factor': 2}")
+    for table in ["batched", "unbatched"]:
+        await cql.run_async(f"create table ks.{table} (pk int, ck int, v int, w int, primary key (pk, ck))")
+
+    async def get_metric(server, name):
+        metrics = await manager.metrics.query(server.ip_addr)
+        return metrics.get(name) or 0
+
+    async def write_batches(table):
+        # Inserts, updates and deletions of many partitions in every batch,
+        # with explicit timestamps, so that both tables get the same data.
+        for b in range(20):
+            stmts = []
+            for i in range(10):
+                pk = (b * 7 + i) % 30
+                ck = i % 4
+                ts = b * 10 + i + 1
+                if (b + i) % 5 == 0:
+                    stmts.append(f"delete from ks.{table} using timestamp {ts} where pk = {pk} and ck = {ck}")
+                elif i % 2 == 0:
+                    stmts.append(f"insert into ks.{table} (pk, ck, v) values ({pk}, {ck}, {ts}) using timestamp {ts}")
+                else:
+                    stmts.append(f"update ks.{table} using timestamp {ts} set w = {ts} where pk = {pk} and ck = {ck}")
+            batch = "begin unlogged batch " + "; ".join(stmts) + "; apply batch"
+            await cql.run_async(SimpleStatement(batch, consistency_level=ConsistencyLevel.ALL), host=hosts[0])
+
+    sent_before = await get_metric(coordinator, "scylla_storage_proxy_coordinator_sent_mutation_batches")
+    received_before = await get_metric(replica, "scylla_storage_proxy_replica_received_mutation_batches")
+    await write_batches("batched")
+    sent_batched = await get_metric(coordinator, "scylla_storage_proxy_coordinator_sent_mutation_batches")
+    received_batched = await get_metric(replica, "scylla_storage_proxy_replica_received_mutation_batches")
+    assert sent_batched > sent_before
+    assert received_batched > received_before
+
+    logger.info(f"Disable batching of mutations on {coordinator}")
+    await cql.run_async("update system.config set value = 'false' where name = 'batch_mutations_per_replica'", host=hosts[0])
+    await write_batches("unbatched")
+    assert await get_metric(coordinator, "scylla_storage_proxy_coordinator_sent_mutation_batches") == sent_batched
+    assert await get_metric(replica, "scylla_storage_proxy_replica_received_mutation_batches") == received_batched
+
+    async def read_all(table, host):
+        rows = await cql.run_async(SimpleStatement(f"select pk, ck, v, w, writetime(v) as wv, writetime(w) as ww from ks.{table}",
+                                                   consistency_level=ConsistencyLevel.ONE), host=host)
+        return sorted((r.pk, r.ck, r.v, r.w, r.wv, r.ww) for r in rows)
+
+    # The mutation_batch messages were received by the replica only. Read from
+    # it alone, so that a missing or different write isn't hidden by
+    # reconciliation with the coordinator's data.
+    logger.info(f"Stop {coordinator}, so that the data is read from {replica} only")
+    await manager.server_stop_gracefully(coordinator.server_id)
+    [host] = await wait_for_cql_and_get_hosts(cql, [replica], time.time() + 60)
+    batched = await read_all("batched", host)
+    assert batched
+    assert batched == await read_all("unbatched", host)
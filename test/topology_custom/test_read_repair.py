@@ -22,7 +22,7 @@ from cassandra.query import SimpleStatement  # type: ignore
 from cassandra.pool import Host  # type: ignore
 from cassandra.murmur3 import murmur3  # type: ignore
 
-from test.pylib.util import wait_for_cql_and_get_hosts
+from test.pylib.util import wait_for, wait_for_cql_and_get_hosts
 from test.pylib.internal_types import ServerInfo
 
 
@@ -325,3 +325,45 @@ async def test_incremental_read_repair(data_class, workdir, manager):
     logger.info("Check rows with CL=ONE after read-repair")
     check_rows(cql, host1, all_rows)
     check_rows(cql, host2, all_rows)
+
+
+@pytest.mark.asyncio
+async def test_read_repair_in_background(manager):
+    """With read_repair_in_background, a read which finds the replicas out of sync
+    returns without waiting for the repair, which is written in the background.
+    Check that the repairs are written, including those merged in the queue.
+    """
+    cmdline = ["--hinted-handoff-enabled", "0"]
+    config = {"read_repair_in_background": True}
+    node1 = await manager.server_add(cmdline=cmdline, config=config)
+    node2 = await manager.server_add(cmdline=cmdline, config=config)
+
+    cql = manager.get_cql()
+    await wait_for_cql_and_get_hosts(cql, [node1, node2], time.time() + 30)
+
+    await cql.run_async("CREATE KEYSPACE ks WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 2}")
+    await cql.run_async("CREATE TABLE ks.tbl (pk int PRIMARY KEY, v int) WITH speculative_retry = 'NONE'")
+
+    logger.info(f"Stop {node2} and write to {node1} only")
+    await manager.server_stop_gracefully(node2.server_id)
+    [host1] = await wait_for_cql_and_get_hosts(cql, [node1], time.time() + 60)
+    keys = range(100)
+    for pk in keys:
+        await cql.run_async(SimpleStatement(f"INSERT INTO ks.tbl (pk, v) VALUES ({pk}, {pk})", consistency_level=ConsistencyLevel.ONE), host=host1)
+
+    await manager.server_start(node2.server_id)
+    host1, host2 = await wait_for_cql_and_get_hosts(cql, [node1, node2], time.time() + 60)
+
+    logger.info("Run read-repair")
+    # Every partition is read twice, the second read may find its repair still in the queue.
+    for _ in range(2):
+        for pk in keys:
+            rows = await cql.run_async(SimpleStatement(f"SELECT v FROM ks.tbl WHERE pk = {pk}", consistency_level=ConsistencyLevel.ALL), host=host1)
+            assert [r.v for r in rows] == [pk]
+
+    async def repaired():
+        rows = await cql.run_async("SELECT pk FROM MUTATION_FRAGMENTS(ks.tbl)", host=host2)
+        return True if {r.pk for r in rows} == set(keys) else None
+
+    logger.info(f"Wait for the repairs to be written to {node2}")
+    await wait_for(repaired, time.time() + 60)
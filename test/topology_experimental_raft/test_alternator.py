@@ -180,3 +180,102 @@ async def test_alternator_ttl_scheduling_group(alternator3):
     assert ratio < 0.1
 
     table.delete()
+
+def get_alternator_streams(ip):
+    url = f"http://{ip}:{alternator_config['alternator_port']}"
+    return boto3.client('dynamodbstreams', endpoint_url=url,
+        region_name='us-east-1',
+        aws_access_key_id='alternator',
+        aws_secret_access_key='secret_pass',
+        config=botocore.client.Config(
+            retries={"max_attempts": 0},
+            read_timeout=300)
+    )
+
+async def test_alternator_get_records_wait(manager):
+    """With alternator_streams_get_records_max_wait_ms set, a GetRecords
+       request which finds no records waits for new ones, for no longer than
+       the configured time. A write to the stream wakes it, and shutting the
+       node down wakes it too, without waiting for the rest of the time.
+    """
+    config = alternator_config | {
+        'experimental_features': ['alternator-streams'],
+        'alternator_streams_time_window_s': 0,
+    }
+    server = await manager.server_add(config=config)
+    cql = manager.get_cql()
+    alternator = get_alternator(server.ip_addr)
+    streams = get_alternator_streams(server.ip_addr)
+    table = alternator.create_table(TableName=unique_table_name(),
+        BillingMode='PAY_PER_REQUEST',
+        Tags=[{'Key': 'experimental:initial_tablets', 'Value': 'none'}],
+        StreamSpecification={'StreamEnabled': True, 'StreamViewType': 'KEYS_ONLY'},
+        KeySchema=[
+            {'AttributeName': 'p', 'KeyType': 'HASH' },
+        ],
+        AttributeDefinitions=[
+            {'AttributeName': 'p', 'AttributeType': 'S' },
+        ])
+    arn = streams.list_streams(TableName=table.name)['Streams'][0]['StreamArn']
+
+    # Find the shard of the stream which gets the writes of the item, while
+    # requests don't wait yet.
+    iterators = []
+    desc = streams.describe_stream(StreamArn=arn)['StreamDescription']
+    while True:
+        for shard in desc['Shards']:
+            iterators.append(streams.get_shard_iterator(StreamArn=arn,
+                ShardId=shard['ShardId'], ShardIteratorType='LATEST')['ShardIterator'])
+        last_shard = desc.get('LastEvaluatedShardId')
+        if not last_shard:
+            break
+        desc = streams.describe_stream(StreamArn=arn, ExclusiveStartShardId=last_shard)['StreamDescription']
+    table.put_item(Item={'p': 'dog'})
+    iterator = None
+    timeout = time.time() + 60
+    while not iterator:
+        assert time.time() < timeout
+        next_iterators = []
+        for it in iterators:
+            response = streams.get_records(ShardIterator=it)
+            if response['Records']:
+                iterator = response['NextShardIterator']
+                break
+            next_iterators.append(response['NextShardIterator'])
+        iterators = next_iterators
+
+    max_wait_ms = 3000
+    await cql.run_async(f"UPDATE system.config SET value = '{max_wait_ms}' WHERE name = 'alternator_streams_get_records_max_wait_ms'")
+
+    logger.info("A request finding no records waits for max_wait, and no longer")
+    start = time.time()
+    response = streams.get_records(ShardIterator=iterator)
+    elapsed = time.time() - start
+    assert not response['Records']
+    assert max_wait_ms / 1000 * 0.9 <= elapsed < max_wait_ms / 1000 + 2
+    iterator = response['NextShardIterator']
+
+    logger.info("A write to the stream wakes a waiting request")
+    writer = asyncio.get_running_loop().run_in_executor(None, lambda: (time.sleep(0.5), table.put_item(Item={'p': 'dog'})))
+    start = time.time()
+    response = streams.get_records(ShardIterator=iterator)
+    elapsed = time.time() - start
+    await writer
+    assert len(response['Records']) == 1
+    assert elapsed < max_wait_ms / 1000
+    iterator = response['NextShardIterator']
+
+    logger.info("Shutting down wakes a waiting request")
+    max_wait_ms = 300000
+    await cql.run_async(f"UPDATE system.config SET value = '{max_wait_ms}' WHERE name = 'alternator_streams_get_records_max_wait_ms'")
+    def get_records():
+        try:
+            streams.get_records(ShardIterator=iterator)
+        except Exception as e:
+            logger.info(f"GetRecords failed on shutdown: {e}")
+    reader = asyncio.get_running_loop().run_in_executor(None, get_records)
+    await asyncio.sleep(1)
+    start = time.time()
+    await manager.server_stop_gracefully(server.server_id)
+    await reader
+    assert time.time() - start < 60
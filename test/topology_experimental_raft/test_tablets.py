@@ -1055,3 +1055,35 @@ async def test_tablet_storage_freeing(manager: ManagerClient):
     logger.info("Verify that the table's disk usage on first node shrunk by about half.")
     size_after = await manager.server_get_sstables_disk_usage(servers[0].server_id, "test", "test")
     assert size_before * 0.33 < size_after < size_before * 0.66
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("enable_file_stream", [True, False])
+async def test_tablet_file_streaming(manager: ManagerClient, enable_file_stream):
+    config = {'enable_file_stream': enable_file_stream}
+    servers = [await manager.server_add(config=config)]
+    await manager.api.disable_tablet_balancing(servers[0].ip_addr)
+    cql = manager.get_cql()
+    await wait_for_cql_and_get_hosts(cql, servers, time.time() + 60)
+
+    await cql.run_async("CREATE KEYSPACE test WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1} AND tablets = {'initial': 2};")
+    await cql.run_async("CREATE TABLE test.test (pk int PRIMARY KEY, c int);")
+
+    keys = range(256)
+    await asyncio.gather(*[cql.run_async(f"INSERT INTO test.test (pk, c) VALUES ({k}, {k});") for k in keys])
+    await manager.api.keyspace_flush(servers[0].ip_addr, "test")
+    # Leave the latest data in memtables, which are flushed before the files are sent.
+    await asyncio.gather(*[cql.run_async(f"UPDATE test.test SET c = {k + 1} WHERE pk = {k};") for k in keys])
+
+    servers.append(await manager.server_add(config=config))
+    s1_host_id = await manager.get_host_id(servers[1].server_id)
+    s1_log = await manager.server_open_log(servers[1].server_id)
+
+    logger.info("Migrate one of the two tablets from the first node to the second node.")
+    t = (await get_all_tablet_replicas(manager, servers[0], 'test', 'test'))[0]
+    await manager.api.move_tablet(servers[0].ip_addr, "test", "test", *t.replicas[0], *(s1_host_id, 0), t.last_token)
+
+    matches = await s1_log.grep(r"Streamed tablet .* as files")
+    assert bool(matches) == enable_file_stream
+
+    rows = await cql.run_async("SELECT pk, c FROM test.test;")
+    assert sorted((r.pk, r.c) for r in rows) == [(k, k + 1) for k in keys]
@@ -8,13 +8,17 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/range/irange.hpp>
+#include <bit>
 #include <filesystem>
 #include <set>
 #include <fmt/chrono.h>
 #include <fmt/ostream.h>
 #include <fmt/ranges.h>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/queue.hh>
+#include <seastar/core/thread.hh>
 #include <seastar/util/closeable.hh>
 #include <seastar/core/queue.hh>
 
@@ -38,6 +42,8 @@
 #include "tools/sstable_consumer.hh"
 #include "tools/utils.hh"
 #include "locator/host_id.hh"
+#include "mutation_writer/shard_based_splitting_writer.hh"
+#include "readers/from_mutations_v2.hh"
 
 using namespace seastar;
 using namespace sstables;
@@ -786,6 +792,155 @@ class writetime_histogram_collecting_consumer : public sstable_consumer {
     }
 };
 
+class partition_stats_collecting_consumer : public sstable_consumer {
+public:
+    struct partition_entry {
+        partition_key key;
+        dht::token token;
+        uint64_t value;
+    };
+
+    struct stats {
+        uint64_t partitions = 0;
+        uint64_t rows = 0;
+        uint64_t live_cells = 0;
+        uint64_t dead_cells = 0;
+        uint64_t partition_tombstones = 0;
+        uint64_t row_tombstones = 0;
+        uint64_t range_tombstone_changes = 0;
+        // Partition size -> partition count, sizes are rounded up to the next power of two.
+        std::map<uint64_t, uint64_t> size_histogram;
+        // Min-heaps, holding the top-N partitions.
+        std::vector<partition_entry> largest_partitions;
+        std::vector<partition_entry> most_tombstones;
+
+        uint64_t tombstones() const {
+            return partition_tombstones + row_tombstones + range_tombstone_changes + dead_cells;
+        }
+    };
+
+private:
+    schema_ptr _schema;
+    size_t _top_n;
+    stats _stats;
+    std::optional<dht::decorated_key> _key;
+    uint64_t _partition_size = 0;
+    uint64_t _partition_tombstones = 0;
+
+private:
+    static bool value_greater(const partition_entry& a, const partition_entry& b) {
+        return a.value > b.value;
+    }
+
+    void record_top(std::vector<partition_entry>& top, uint64_t value) {
+        if (!_top_n || !value) {
+            return;
+        }
+        if (top.size() < _top_n) {
+            top.push_back({_key->key(), _key->token(), value});
+            std::push_heap(top.begin(), top.end(), value_greater);
+        } else if (value > top.front().value) {
+            std::pop_heap(top.begin(), top.end(), value_greater);
+            top.back() = {_key->key(), _key->token(), value};
+            std::push_heap(top.begin(), top.end(), value_greater);
+        }
+    }
+
+    void collect_column(const atomic_cell_or_collection& cell, const column_definition& cdef) {
+        if (cdef.is_atomic()) {
+            if (cell.as_atomic_cell(cdef).is_live()) {
+                ++_stats.live_cells;
+            } else {
+                ++_stats.dead_cells;
+                ++_partition_tombstones;
+            }
+        } else {
+            cell.as_collection_mutation().with_deserialized(*cdef.type, [&, this] (collection_mutation_view_description mv) {
+                if (mv.tomb) {
+                    ++_stats.dead_cells;
+                    ++_partition_tombstones;
+                }
+                for (auto&& c : mv.cells) {
+                    if (c.second.is_live()) {
+                        ++_stats.live_cells;
+                    } else {
+                        ++_stats.dead_cells;
+                        ++_partition_tombstones;
+                    }
+                }
+            });
+        }
+    }
+
+    void collect_row(const row& r, column_kind kind) {
+        ++_stats.rows;
+        r.for_each_cell([this, kind] (column_id id, const atomic_cell_or_collection& cell) {
+            collect_column(cell, _schema->column_at(kind, id));
+        });
+    }
+
+public:
+    partition_stats_collecting_consumer(schema_ptr s, size_t top_n) : _schema(std::move(s)), _top_n(top_n) { }
+
+    stats release_stats() {
+        std::sort_heap(_stats.largest_partitions.begin(), _stats.largest_partitions.end(), value_greater);
+        std::sort_heap(_stats.most_tombstones.begin(), _stats.most_tombstones.end(), value_greater);
+        return std::exchange(_stats, {});
+    }
+
+    virtual future<> consume_stream_start() override {
+        return make_ready_future<>();
+    }
+    virtual future<stop_iteration> consume_sstable_start(const sstables::sstable* const sst) override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_start&& ps) override {
+        ++_stats.partitions;
+        _key = ps.key();
+        _partition_size = 0;
+        _partition_tombstones = 0;
+        if (ps.partition_tombstone()) {
+            ++_stats.partition_tombstones;
+            ++_partition_tombstones;
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(static_row&& sr) override {
+        _partition_size += sr.memory_usage(*_schema);
+        collect_row(sr.cells(), column_kind::static_column);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(clustering_row&& cr) override {
+        _partition_size += cr.memory_usage(*_schema);
+        if (cr.tomb() != row_tombstone{}) {
+            ++_stats.row_tombstones;
+            ++_partition_tombstones;
+        }
+        collect_row(cr.cells(), column_kind::regular_column);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(range_tombstone_change&& rtc) override {
+        _partition_size += rtc.memory_usage(*_schema);
+        if (rtc.tombstone()) {
+            ++_stats.range_tombstone_changes;
+            ++_partition_tombstones;
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_end&& pe) override {
+        ++_stats.size_histogram[_partition_size ? std::bit_ceil(_partition_size) : 0];
+        record_top(_stats.largest_partitions, _partition_size);
+        record_top(_stats.most_tombstones, _partition_tombstones);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume_sstable_end() override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<> consume_stream_end() override {
+        return make_ready_future<>();
+    }
+};
+
 stop_iteration consume_reader(flat_mutation_reader_v2 rd, sstable_consumer& consumer, sstables::sstable* sst, const partition_set& partitions, bool no_skips) {
     auto close_rd = deferred_close(rd);
     if (consumer.consume_sstable_start(sst).get() == stop_iteration::yes) {
@@ -1433,6 +1588,8 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::SSTableOrigin: return "sstable_origin";
         case sstables::scylla_metadata_type::ScyllaVersion: return "scylla_version";
         case sstables::scylla_metadata_type::ScyllaBuildId: return "scylla_build_id";
+        case sstables::scylla_metadata_type::BloomFilterLayout: return "bloom_filter_layout";
+        case sstables::scylla_metadata_type::ColumnValueRanges: return "column_value_ranges";
     }
     std::abort();
 }
@@ -1450,9 +1607,10 @@ const char* to_string(sstables::large_data_type t) {
 
 class scylla_metadata_visitor : public boost::static_visitor<> {
     json_writer& _writer;
+    const schema& _schema;
 
 public:
-    scylla_metadata_visitor(json_writer& writer) : _writer(writer) { }
+    scylla_metadata_visitor(json_writer& writer, const schema& s) : _writer(writer), _schema(s) { }
 
     void operator()(const sstables::sharding_metadata& val) const {
         _writer.StartArray();
@@ -1509,6 +1667,13 @@ class scylla_metadata_visitor : public boost::static_visitor<> {
         }
         _writer.EndObject();
     }
+    void operator()(const sstables::bloom_filter_layout_metadata& val) const {
+        switch (val.layout) {
+            case sstables::bloom_filter_layout::classic: _writer.String("classic"); return;
+            case sstables::bloom_filter_layout::blocked: _writer.String("blocked"); return;
+        }
+        _writer.Uint(static_cast<uint32_t>(val.layout));
+    }
     void operator()(const sstables::run_identifier& val) const {
         _writer.AsString(val.id.uuid());
     }
@@ -1527,6 +1692,22 @@ class scylla_metadata_visitor : public boost::static_visitor<> {
         }
         _writer.EndObject();
     }
+    void operator()(const sstables::scylla_metadata::column_value_ranges& val) const {
+        _writer.StartObject();
+        for (const auto& [name, range] : val.map) {
+            auto cdef = _schema.get_column_definition(name.value);
+            _writer.Key(cdef ? cdef->name_as_text() : to_hex(name.value));
+            // Without the column, the type of the values is unknown.
+            auto to_string = [cdef] (const bytes& v) { return cdef ? cdef->type->to_string(v) : to_hex(v); };
+            _writer.StartObject();
+            _writer.Key("min");
+            _writer.String(to_string(range.min.value));
+            _writer.Key("max");
+            _writer.String(to_string(range.max.value));
+            _writer.EndObject();
+        }
+        _writer.EndObject();
+    }
     template <typename Size>
     void operator()(const sstables::disk_string<Size>& val) const {
         _writer.String(disk_string_to_string(val));
@@ -1556,7 +1737,7 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
             continue;
         }
         for (const auto& [k, v] : m->data.data) {
-            boost::apply_visitor(scylla_metadata_visitor(writer), v);
+            boost::apply_visitor(scylla_metadata_visitor(writer, *schema), v);
         }
         writer.EndObject();
     }
@@ -2541,6 +2722,305 @@ void write_operation(schema_ptr schema, reader_permit permit, const std::vector<
     sst->write_components(std::move(reader), 1, schema, writer_cfg, encoding_stats{}).get();
 }
 
+// Reads records from a CSV (RFC 4180) stream.
+// Fields can be quoted with double quotes, quotes inside quoted fields are escaped
+// by doubling them. Empty unquoted fields are returned as disengaged optionals.
+class csv_reader {
+    input_stream<char> _in;
+    temporary_buffer<char> _buf;
+    bool _eof = false;
+    uint64_t _records = 0;
+
+private:
+    bool fill() {
+        while (_buf.empty() && !_eof) {
+            _buf = _in.read().get();
+            _eof = _buf.empty();
+        }
+        return !_buf.empty();
+    }
+    std::optional<char> peek() {
+        if (!fill()) {
+            return std::nullopt;
+        }
+        return _buf[0];
+    }
+    std::optional<char> next() {
+        auto c = peek();
+        if (c) {
+            _buf.trim_front(1);
+        }
+        return c;
+    }
+
+public:
+    explicit csv_reader(input_stream<char> in) : _in(std::move(in)) { }
+
+    uint64_t records() const {
+        return _records;
+    }
+
+    // Returns a disengaged optional at the end of the input.
+    std::optional<std::vector<std::optional<sstring>>> read_record() {
+        std::vector<std::optional<sstring>> record;
+        std::string field;
+        bool quoted = false;
+        bool in_quotes = false;
+        bool started = false;
+        auto finish_field = [&] {
+            if (field.empty() && !quoted) {
+                record.emplace_back(std::nullopt);
+            } else {
+                record.emplace_back(sstring(field));
+            }
+            field.clear();
+            quoted = false;
+        };
+        while (auto c = next()) {
+            started = true;
+            if (in_quotes) {
+                if (*c != '"') {
+                    field += *c;
+                } else if (peek() == '"') {
+                    field += *next();
+                } else {
+                    in_quotes = false;
+                }
+            } else if (*c == '"' && field.empty() && !quoted) {
+                in_quotes = quoted = true;
+            } else if (*c == ',') {
+                finish_field();
+            } else if (*c == '\n') {
+                finish_field();
+                ++_records;
+                return record;
+            } else if (*c != '\r' || peek() != '\n') {
+                field += *c;
+            }
+            thread::maybe_yield();
+        }
+        if (in_quotes) {
+            throw std::runtime_error(fmt::format("unterminated quoted field in record {}", _records + 1));
+        }
+        if (!started) {
+            return std::nullopt;
+        }
+        finish_field();
+        ++_records;
+        return record;
+    }
+
+    future<> close() {
+        return _in.close();
+    }
+};
+
+void import_csv_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& manager, const bpo::variables_map& vm) {
+    if (!sstables.empty()) {
+        throw std::invalid_argument("import-csv operation does not operate on input sstables");
+    }
+    if (!vm.count("input-file")) {
+        throw std::invalid_argument("missing required option '--input-file'");
+    }
+    if (!vm.count("generation")) {
+        throw std::invalid_argument("missing required option '--generation'");
+    }
+    if (schema->is_counter()) {
+        throw std::invalid_argument("import-csv doesn't support counter tables");
+    }
+    const auto input_file = vm["input-file"].as<std::string>();
+    const auto output_dir = std::filesystem::path(vm["output-dir"].as<std::string>());
+    const auto shards = vm["shards"].as<unsigned>();
+    const auto ignore_msb_bits = vm["ignore-msb-bits"].as<unsigned>();
+    const uint64_t memory_limit = uint64_t(vm["memory-limit-mb"].as<unsigned>()) << 20;
+    const auto timestamp = vm.count("timestamp") ? vm["timestamp"].as<api::timestamp_type>() : api::new_timestamp();
+    auto next_generation = vm["generation"].as<int64_t>();
+    if (!shards) {
+        throw std::invalid_argument("--shards has to be greater than 0");
+    }
+    const auto format = sstables::sstable_format_types::big;
+    const auto version = sstables::get_highest_sstable_version();
+    const auto writer_cfg = manager.configure_writer("scylla-sstable");
+    data_dictionary::storage_options local;
+
+    // The output sstables are split according to this sharder.
+    schema = schema_builder(schema).with_sharder(shards, ignore_msb_bits).build();
+
+    auto ifile = open_file_dma(input_file, open_flags::ro).get();
+    csv_reader reader(make_file_input_stream(std::move(ifile)));
+    auto close_reader = deferred_close(reader);
+
+    auto header = reader.read_record();
+    if (!header) {
+        throw std::invalid_argument("input-file is empty, expected a header with the column names");
+    }
+    std::vector<const column_definition*> columns;
+    for (const auto& name : *header) {
+        auto cdef = name ? schema->get_column_definition(to_bytes(*name)) : nullptr;
+        if (!cdef) {
+            throw std::invalid_argument(fmt::format("column {} in the header of input-file doesn't exist in the schema", name.value_or("")));
+        }
+        if (!cdef->is_atomic()) {
+            throw std::invalid_argument(fmt::format("column {} is not atomic, import-csv supports only atomic columns", cdef->name_as_text()));
+        }
+        columns.push_back(cdef);
+    }
+    for (const auto& cdef : schema->all_columns()) {
+        if (cdef.is_primary_key() && std::ranges::find(columns, &cdef) == columns.end()) {
+            throw std::invalid_argument(fmt::format("primary key column {} is missing from the header of input-file", cdef.name_as_text()));
+        }
+    }
+
+    // Records are collected into sorted runs in memory. Runs which don't fit into the memory limit
+    // are spilled into temporary sstables, which are merged when writing the output.
+    using run_type = std::map<dht::decorated_key, mutation, dht::decorated_key::less_comparator>;
+    run_type run{dht::decorated_key::less_comparator(schema)};
+    uint64_t run_memory = 0;
+    uint64_t partitions = 0;
+    const auto runs_dir = output_dir / fmt::format("import-csv-runs-{}", next_generation);
+    std::vector<sstables::shared_sstable> runs;
+    auto remove_runs = defer([&] () noexcept {
+        try {
+            for (auto& sst : runs) {
+                sst->unlink().get();
+            }
+            if (file_exists(runs_dir.native()).get()) {
+                remove_file(runs_dir.native()).get();
+            }
+        } catch (...) {
+            sst_log.warn("Failed to remove temporary sstables from {}: {}", runs_dir.native(), std::current_exception());
+        }
+    });
+
+    auto make_run_reader = [&] {
+        std::vector<mutation> muts;
+        muts.reserve(run.size());
+        partitions += run.size();
+        for (auto& [dk, m] : run) {
+            muts.emplace_back(std::move(m));
+        }
+        run.clear();
+        run_memory = 0;
+        return make_flat_mutation_reader_from_mutations_v2(schema, permit, std::move(muts));
+    };
+
+    auto spill_run = [&] {
+        if (runs.empty()) {
+            recursive_touch_directory(runs_dir.native()).get();
+        }
+        auto sst = manager.make_sstable(schema, runs_dir.native(), local, sstables::generation_type(runs.size() + 1), sstables::sstable_state::normal, version, format);
+        const auto estimated_partitions = run.size();
+        sst->write_components(make_run_reader(), estimated_partitions, schema, writer_cfg, encoding_stats{}).get();
+        sst->load(schema->get_sharder()).get();
+        sst_log.info("Spilled run {} with {} partitions to {}", runs.size() + 1, estimated_partitions, sst->get_filename());
+        runs.push_back(std::move(sst));
+    };
+
+    std::vector<bytes> pk_components(schema->partition_key_size());
+    std::vector<bytes> ck_components(schema->clustering_key_size());
+    while (auto record = reader.read_record()) {
+        if (record->size() == 1 && !record->front() && columns.size() > 1) {
+            continue; // empty line
+        }
+        if (record->size() != columns.size()) {
+            throw std::runtime_error(fmt::format("record {} has {} fields, expected {}", reader.records(), record->size(), columns.size()));
+        }
+        size_t record_size = 0;
+        std::vector<std::pair<const column_definition*, bytes>> cells;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            const auto& cdef = *columns[i];
+            const auto& field = (*record)[i];
+            if (!field) {
+                if (cdef.is_primary_key()) {
+                    throw std::runtime_error(fmt::format("record {}: primary key column {} is null", reader.records(), cdef.name_as_text()));
+                }
+                continue;
+            }
+            bytes value;
+            try {
+                value = cdef.type->from_string(*field);
+            } catch (...) {
+                throw std::runtime_error(fmt::format("record {}: failed to parse value of column {}: {}", reader.records(), cdef.name_as_text(), std::current_exception()));
+            }
+            record_size += value.size();
+            if (cdef.is_partition_key()) {
+                pk_components[cdef.id] = std::move(value);
+            } else if (cdef.is_clustering_key()) {
+                ck_components[cdef.id] = std::move(value);
+            } else {
+                cells.emplace_back(&cdef, std::move(value));
+            }
+        }
+
+        auto dk = dht::decorate_key(*schema, partition_key::from_exploded(*schema, pk_components));
+        auto it = run.find(dk);
+        if (it == run.end()) {
+            it = run.emplace(dk, mutation(schema, dk)).first;
+            record_size += dk.key().external_memory_usage() + sizeof(mutation);
+        }
+        auto& m = it->second;
+        auto ck = clustering_key::from_exploded(*schema, ck_components);
+        record_size += ck.external_memory_usage() + sizeof(rows_entry);
+        m.partition().clustered_row(*schema, ck).apply(row_marker(timestamp));
+        for (auto& [cdef, value] : cells) {
+            auto cell = atomic_cell::make_live(*cdef->type, timestamp, std::move(value));
+            if (cdef->is_static()) {
+                m.set_static_cell(*cdef, std::move(cell));
+            } else {
+                m.set_clustered_cell(ck, *cdef, std::move(cell));
+            }
+        }
+
+        run_memory += record_size;
+        if (run_memory >= memory_limit) {
+            spill_run();
+        }
+    }
+
+    // Merge the runs and split the result by shard.
+    std::vector<flat_mutation_reader_v2> readers;
+    readers.reserve(runs.size() + 1);
+    for (const auto& sst : runs) {
+        readers.emplace_back(sst->make_crawling_reader(schema, permit));
+    }
+    readers.emplace_back(make_run_reader());
+    auto merged_reader = make_combined_reader(schema, permit, std::move(readers));
+
+    std::map<unsigned, sstring> outputs;
+    const auto estimated_partitions = std::max(partitions / shards, uint64_t(1));
+    mutation_writer::segregate_by_shard(std::move(merged_reader), [&] (flat_mutation_reader_v2 rd) {
+        return seastar::async([&, rd = std::move(rd)] () mutable {
+            auto close_rd = deferred_close(rd);
+            auto mf = rd.peek().get();
+            if (!mf) {
+                return;
+            }
+            const auto shard = schema->get_sharder().shard_for_reads(mf->as_partition_start().key().token());
+            const auto generation = sstables::generation_type(next_generation++);
+            auto sst_name = sstables::sstable::filename(output_dir.native(), schema->ks_name(), schema->cf_name(), version, generation, format, component_type::Data);
+            if (file_exists(sst_name).get()) {
+                throw std::invalid_argument(fmt::format("cannot create output sstable {}, file already exists", sst_name));
+            }
+            auto sst = manager.make_sstable(schema, output_dir.native(), local, generation, sstables::sstable_state::normal, version, format);
+            sst->write_components(std::move(rd), estimated_partitions, schema, writer_cfg, encoding_stats{}).get();
+            outputs.emplace(shard, sst->get_filename());
+        });
+    }).get();
+
+    sst_log.info("Imported {} records, {} partitions, into {} sstable(s)", reader.records() - 1, partitions, outputs.size());
+
+    json_writer writer;
+    writer.StartStream();
+    for (const auto& [shard, name] : outputs) {
+        writer.Key(name);
+        writer.StartArray();
+        writer.Uint(shard);
+        writer.EndArray();
+    }
+    writer.EndStream();
+}
+
 void script_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
         sstables::sstables_manager& manager, const bpo::variables_map& vm) {
     if (sstables.empty()) {
@@ -2579,6 +3059,99 @@ void sstable_consumer_operation(schema_ptr schema, reader_permit permit, const s
     consumer->consume_stream_end().get();
 }
 
+void partition_stats_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::invalid_argument("no sstables specified on the command line");
+    }
+    const auto merge = vm.count("merge");
+    const auto top_n = vm["top"].as<unsigned>();
+    const auto concurrency = vm["concurrency"].as<unsigned>();
+    if (!concurrency) {
+        throw std::invalid_argument("--concurrency has to be greater than 0");
+    }
+    const auto partitions = partition_set(0, {}, decorated_key_equal(*schema));
+
+    std::vector<std::pair<sstring, partition_stats_collecting_consumer::stats>> results;
+    if (merge) {
+        partition_stats_collecting_consumer consumer(schema, top_n);
+        consume_sstables(schema, permit, sstables, true, true, [&] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
+            return consume_reader(std::move(rd), consumer, sst, partitions, false);
+        });
+        results.emplace_back("anonymous", consumer.release_stats());
+    } else {
+        // Each sstable is consumed in its own thread, so the reads of up to
+        // `concurrency` sstables are in flight at the same time.
+        results.resize(sstables.size());
+        max_concurrent_for_each(boost::irange(size_t(0), sstables.size()), concurrency, [&] (size_t i) {
+            return seastar::async([&, i] {
+                const auto& sst = sstables[i];
+                partition_stats_collecting_consumer consumer(schema, top_n);
+                consume_reader(sst->make_crawling_reader(schema, permit), consumer, sst.get(), partitions, false);
+                results[i] = {sst->get_filename(), consumer.release_stats()};
+            });
+        }).get();
+    }
+
+    auto write_top = [&] (json_writer& writer, const std::vector<partition_stats_collecting_consumer::partition_entry>& top, std::string_view value_name) {
+        writer.StartArray();
+        for (const auto& e : top) {
+            writer.StartObject();
+            writer.Key("key");
+            writer.DataKey(*schema, e.key, e.token);
+            writer.Key(value_name);
+            writer.Uint64(e.value);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    };
+
+    json_writer writer;
+    writer.StartStream();
+    for (const auto& [name, stats] : results) {
+        writer.Key(name);
+        writer.StartObject();
+        writer.Key("partitions");
+        writer.Uint64(stats.partitions);
+        writer.Key("rows");
+        writer.Uint64(stats.rows);
+        writer.Key("live_cells");
+        writer.Uint64(stats.live_cells);
+        writer.Key("dead_cells");
+        writer.Uint64(stats.dead_cells);
+        writer.Key("partition_tombstones");
+        writer.Uint64(stats.partition_tombstones);
+        writer.Key("row_tombstones");
+        writer.Uint64(stats.row_tombstones);
+        writer.Key("range_tombstone_changes");
+        writer.Uint64(stats.range_tombstone_changes);
+        writer.Key("tombstone_density");
+        const auto tombstones = stats.tombstones();
+        writer.Double(tombstones ? double(tombstones) / (tombstones + stats.live_cells) : 0.0);
+        writer.Key("partition_size_histogram");
+        writer.StartObject();
+        writer.Key("buckets");
+        writer.StartArray();
+        for (const auto& [bucket, count] : stats.size_histogram) {
+            writer.Uint64(bucket);
+        }
+        writer.EndArray();
+        writer.Key("counts");
+        writer.StartArray();
+        for (const auto& [bucket, count] : stats.size_histogram) {
+            writer.Uint64(count);
+        }
+        writer.EndArray();
+        writer.EndObject();
+        writer.Key("largest_partitions");
+        write_top(writer, stats.largest_partitions, "size");
+        writer.Key("most_tombstones");
+        write_top(writer, stats.most_tombstones, "tombstones");
+        writer.EndObject();
+    }
+    writer.EndStream();
+}
+
 void shard_of_operation(schema_ptr, reader_permit,
                         const std::vector<sstables::shared_sstable>& sstables,
                         sstables::sstables_manager& sstable_manager,
@@ -2766,6 +3339,33 @@ following example python script:
 )",
             {typed_option<std::string>("bucket", "months", "the unit of time to use as bucket, one of (years, months, weeks, days, hours)")}},
             sstable_consumer_operation<writetime_histogram_collecting_consumer>},
+/* partition-stats */
+    {{"partition-stats",
+            "Collect statistics about the partitions of the sstable(s)",
+R"(
+Crawl over all partitions of the sstable(s) and collect statistics about them,
+without converting the data to JSON:
+* partition, row, live cell and tombstone counts, and the tombstone density
+  (ratio of tombstones to the sum of tombstones and live cells);
+* histogram of partition sizes, the sizes are rounded up to the next power of 2;
+* the top-N largest partitions;
+* the top-N partitions with the most tombstones;
+
+The size of a partition is the memory its rows take after parsing, it is
+proportional to, but not the same as, the size in the data component.
+
+Sstables are processed concurrently, unless --merge is used, in which case the
+statistics are collected over the merged stream of all sstables.
+
+See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#partition-stats
+for more information on this operation, including the schema of the JSON output.
+)",
+            {
+                    typed_option<>("merge", "merge all sstables into a single mutation fragment stream (use a combining reader over all sstable readers)"),
+                    typed_option<unsigned>("top", 10u, "number of partitions to list in the top-N lists"),
+                    typed_option<unsigned>("concurrency", 4u, "number of sstables to process concurrently, ignored with --merge"),
+            }},
+            partition_stats_operation},
 /* validate */
     {{"validate",
             "Validate the sstable(s), same as scrub in validate mode",
@@ -2863,6 +3463,49 @@ for more information on this operation, including the schema of the JSON input.
                     typed_option<std::string>("validation-level", "clustering_key", "degree of validation on the output, one of (partition_region, token, partition_key, clustering_key)"),
             }},
             write_operation},
+/* import-csv */
+    {{"import-csv",
+            "Write sstable(s) from CSV input",
+R"(
+Write sstables from the records of a CSV file, for bulk loading data into a
+table. The first record of the input has to be a header, with the names of the
+columns of the subsequent records. All primary key columns have to be present.
+Values are parsed from their CQL literal representation, empty unquoted
+values are treated as null (no cell is written).
+
+Records don't have to be sorted. They are collected into sorted runs in memory,
+runs which exceed --memory-limit-mb are spilled to temporary sstables, which
+are merged when writing the output sstables. Records with the same primary key
+are merged. All data is written with the same timestamp (--timestamp), so
+conflicting cells are reconciled like in the database: the larger value wins.
+
+The output is split into one sstable per shard, according to --shards and
+--ignore-msb-bits, which should be those of the node the sstables will be loaded
+to. The mapping of output sstables to shards is printed in JSON, in the same
+format as the output of shard-of.
+
+Note that "import-csv" doesn't support counters and non-atomic (non-frozen
+collection or UDT) columns.
+
+The output sstables will use the BIG format, the highest supported sstable
+format and consecutive generations, starting from the specified generation
+(--generation). By default they are placed in the local directory, can be
+changed with --output-dir. If an output sstable clashes with an existing
+sstable, the write will fail.
+
+See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#import-csv
+for more information on this operation.
+)",
+            {
+                    typed_option<std::string>("input-file", "the file containing the input"),
+                    typed_option<std::string>("output-dir", ".", "directory to place the output sstable(s) to"),
+                    typed_option<sstables::generation_type::int_t>("generation", "generation of the first generated sstable"),
+                    typed_option<unsigned>("shards", 1u, "the number of shards to split the output to"),
+                    typed_option<unsigned>("ignore-msb-bits", 12u, "'murmur3_partitioner_ignore_msb_bits' set by scylla.yaml"),
+                    typed_option<unsigned>("memory-limit-mb", 256u, "approximate amount of memory to use for sorting, before spilling to disk"),
+                    typed_option<api::timestamp_type>("timestamp", "write timestamp of the data, the current time by default"),
+            }},
+            import_csv_operation},
 /* script */
     {{"script",
             "Run a script on content of an sstable",
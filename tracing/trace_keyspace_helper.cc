@@ -7,6 +7,8 @@
 /*
  * SPDX-License-Identifier: (AGPL-3.0-or-later and Apache-2.0)
  */
+#include <numeric>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/metrics.hh>
 #include "types/types.hh"
 #include "tracing/trace_keyspace_helper.hh"
@@ -218,11 +220,14 @@ gms::inet_address trace_keyspace_helper::my_address() const noexcept {
     return _qp_anchor->proxy().my_address();
 }
 
-void trace_keyspace_helper::write_one_session_records(lw_shared_ptr<one_session_records> records) {
+void trace_keyspace_helper::write_records_bulk(records_bulk& bulk) {
+    tlogger.trace("Writing {} sessions", bulk.size());
+    auto num_records = std::accumulate(bulk.begin(), bulk.end(), uint64_t(0), [] (uint64_t n, const records_bulk::value_type& records) {
+        return n + records->size();
+    });
     // Future is waited on indirectly in `stop()` (via `_pending_writes`).
-    (void)with_gate(_pending_writes, [this, records = std::move(records)] {
-        auto num_records = records->size();
-        return this->flush_one_session_mutations(std::move(records)).finally([this, num_records] { _local_tracing.write_complete(num_records); });
+    (void)with_gate(_pending_writes, [this, bulk = std::move(bulk), num_records] () mutable {
+        return this->flush_bulk_mutations(std::move(bulk)).finally([this, num_records] { _local_tracing.write_complete(num_records); });
     }).handle_exception([this] (auto ep) {
         try {
             ++_stats.tracing_errors;
@@ -241,13 +246,6 @@ void trace_keyspace_helper::write_one_session_records(lw_shared_ptr<one_session_
     }).discard_result();
 }
 
-void trace_keyspace_helper::write_records_bulk(records_bulk& bulk) {
-    tlogger.trace("Writing {} sessions", bulk.size());
-    std::for_each(bulk.begin(), bulk.end(), [this] (records_bulk::value_type& one_session_records_ptr) {
-        write_one_session_records(std::move(one_session_records_ptr));
-    });
-}
-
 cql3::query_options trace_keyspace_helper::make_session_mutation_data(gms::inet_address my_address, const one_session_records& session_records) {
     const session_record& record = session_records.session_rec;
     auto millis_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(record.started_at.time_since_epoch()).count();
@@ -388,33 +386,52 @@ std::vector<cql3::raw_value> trace_keyspace_helper::make_event_mutation_data(gms
     return values;
 }
 
-future<> trace_keyspace_helper::apply_events_mutation(cql3::query_processor& qp, service::migration_manager& mm, lw_shared_ptr<one_session_records> records, std::deque<event_record>& events_records) {
-    if (events_records.empty()) {
-        return now();
-    }
-
-    return _events.cache_table_info(qp, mm, _dummy_query_state).then([this, &qp, records, &events_records] {
-        tlogger.trace("{}: storing {} events records: parent_id {} span_id {}", records->session_id, events_records.size(), records->parent_id, records->my_span_id);
+future<> trace_keyspace_helper::apply_events_mutation(cql3::query_processor& qp, std::vector<cql3::raw_value_vector_with_unset> values) {
+    tlogger.trace("storing {} events records", values.size());
 
-        std::vector<cql3::statements::batch_statement::single_statement> modifications(events_records.size(), cql3::statements::batch_statement::single_statement(_events.insert_stmt(), false));
-        std::vector<cql3::raw_value_vector_with_unset> values;
+    std::vector<cql3::statements::batch_statement::single_statement> modifications(values.size(), cql3::statements::batch_statement::single_statement(_events.insert_stmt(), false));
+    return do_with(
+        cql3::query_options::make_batch_options(cql3::query_options(cql3::default_cql_config, db::consistency_level::ANY, std::nullopt, std::vector<cql3::raw_value>{}, false, cql3::query_options::specific_options::DEFAULT), std::move(values)),
+        cql3::statements::batch_statement(cql3::statements::batch_statement::type::UNLOGGED, std::move(modifications), cql3::attributes::none(), qp.get_cql_stats()),
+        [this, &qp] (auto& batch_options, auto& batch) {
+            return batch.execute(qp, _dummy_query_state, batch_options, std::nullopt).then([] (shared_ptr<cql_transport::messages::result_message> res) { return now(); });
+        }
+    );
+}
 
-        values.reserve(events_records.size());
-        std::for_each(events_records.begin(), events_records.end(), [&values, all_records = records, this] (event_record& one_event_record) { values.emplace_back(make_event_mutation_data(my_address(), *all_records, one_event_record)); });
+future<> trace_keyspace_helper::apply_session_mutations(cql3::query_processor& qp, service::migration_manager& mm, lw_shared_ptr<one_session_records> records) {
+    // if session is finished - store a session and a session time index entries
+    tlogger.trace("{}: going to store a session event", records->session_id);
+    return _sessions.insert(qp, mm, _dummy_query_state, make_session_mutation_data, my_address(), std::ref(*records)).then([this, &qp, &mm, records] {
+        tlogger.trace("{}: going to store a {} entry", records->session_id, _sessions_time_idx.name());
+        return _sessions_time_idx.insert(qp, mm, _dummy_query_state, make_session_time_idx_mutation_data, my_address(), std::ref(*records));
+    }).then([this, &qp, &mm, records] {
+        if (!records->do_log_slow_query) {
+            return now();
+        }
 
-        return do_with(
-            cql3::query_options::make_batch_options(cql3::query_options(cql3::default_cql_config, db::consistency_level::ANY, std::nullopt, std::vector<cql3::raw_value>{}, false, cql3::query_options::specific_options::DEFAULT), std::move(values)),
-            cql3::statements::batch_statement(cql3::statements::batch_statement::type::UNLOGGED, std::move(modifications), cql3::attributes::none(), qp.get_cql_stats()),
-            [this, &qp] (auto& batch_options, auto& batch) {
-                return batch.execute(qp, _dummy_query_state, batch_options, std::nullopt).then([] (shared_ptr<cql_transport::messages::result_message> res) { return now(); });
-            }
-        );
+        // if slow query log is requested - store a slow query log and a slow query log time index entries
+        auto start_time_id = utils::UUID_gen::get_time_UUID(table_helper::make_monotonic_UUID_tp(_slow_query_last_nanos, records->session_rec.started_at));
+        tlogger.trace("{}: going to store a slow query event", records->session_id);
+        return _slow_query_log.insert(qp, mm, _dummy_query_state, make_slow_query_mutation_data, my_address(), std::ref(*records), start_time_id).then([this, &qp, &mm, records, start_time_id] {
+            tlogger.trace("{}: going to store a {} entry", records->session_id, _slow_query_log_time_idx.name());
+            return _slow_query_log_time_idx.insert(qp, mm, _dummy_query_state, make_slow_query_time_idx_mutation_data, my_address(), std::ref(*records), start_time_id);
+        });
     });
 }
 
-future<> trace_keyspace_helper::flush_one_session_mutations(lw_shared_ptr<one_session_records> records) {
-    // grab events records available so far
-    return do_with(std::move(records->events_recs), [this, records] (std::deque<event_record>& events_records) {
+future<> trace_keyspace_helper::flush_bulk_mutations(records_bulk bulk) {
+    struct session_write {
+        lw_shared_ptr<one_session_records> records;
+        std::deque<event_record> events_records;
+        bool session_record_is_ready;
+    };
+
+    // grab records available so far
+    std::vector<session_write> writes;
+    writes.reserve(bulk.size());
+    for (auto& records : bulk) {
+        auto events_records = std::move(records->events_recs);
         records->events_recs.clear();
 
         // Check if a session's record is ready before handling events' records.
@@ -428,43 +445,50 @@ future<> trace_keyspace_helper::flush_one_session_mutations(lw_shared_ptr<one_se
         // From this point on - all new data will have to be handled in the next write event
         records->data_consumed();
 
-        // We want to serialize the creation of events mutations in order to ensure
-        // that mutations for events that were created first are going to be
-        // created first too.
-        auto backend_state_ptr = static_cast<trace_keyspace_backend_sesssion_state*>(records->backend_state_ptr.get());
-        semaphore& write_sem = backend_state_ptr->write_sem;
-        return with_semaphore(write_sem, 1, [this, records, session_record_is_ready, &events_records] {
-            // This code is inside the _pending_writes gate and the qp pointer
-            // is cleared on ::stop() after the gate is closed.
-            assert(_qp_anchor != nullptr && _mm_anchor != nullptr);
-            cql3::query_processor& qp = *_qp_anchor;
-            service::migration_manager& mm = *_mm_anchor;
-            return apply_events_mutation(qp, mm, records, events_records).then([this, &qp, &mm, session_record_is_ready, records] {
-                if (session_record_is_ready) {
-
-                    // if session is finished - store a session and a session time index entries
-                    tlogger.trace("{}: going to store a session event", records->session_id);
-                    return _sessions.insert(qp, mm, _dummy_query_state, make_session_mutation_data, my_address(), std::ref(*records)).then([this, &qp, &mm, records] {
-                        tlogger.trace("{}: going to store a {} entry", records->session_id, _sessions_time_idx.name());
-                        return _sessions_time_idx.insert(qp, mm, _dummy_query_state, make_session_time_idx_mutation_data, my_address(), std::ref(*records));
-                    }).then([this, &qp, &mm, records] {
-                        if (!records->do_log_slow_query) {
-                            return now();
-                        }
-
-                        // if slow query log is requested - store a slow query log and a slow query log time index entries
-                        auto start_time_id = utils::UUID_gen::get_time_UUID(table_helper::make_monotonic_UUID_tp(_slow_query_last_nanos, records->session_rec.started_at));
-                        tlogger.trace("{}: going to store a slow query event", records->session_id);
-                        return _slow_query_log.insert(qp, mm, _dummy_query_state, make_slow_query_mutation_data, my_address(), std::ref(*records), start_time_id).then([this, &qp, &mm, records, start_time_id] {
-                            tlogger.trace("{}: going to store a {} entry", records->session_id, _slow_query_log_time_idx.name());
-                            return _slow_query_log_time_idx.insert(qp, mm, _dummy_query_state, make_slow_query_time_idx_mutation_data, my_address(), std::ref(*records), start_time_id);
-                        });
-                    });
-                } else {
-                    return now();
+        writes.push_back(session_write{std::move(records), std::move(events_records), session_record_is_ready});
+    }
+
+    // We want to serialize the creation of events mutations of a session in order to
+    // ensure that mutations for events that were created first are going to be
+    // created first too. The semaphores are taken in the order of session ids so that
+    // concurrent bulks containing the same sessions don't deadlock.
+    std::ranges::sort(writes, std::less<>(), [] (const session_write& w) { return w.records->session_id; });
+    std::vector<semaphore_units<>> units;
+    units.reserve(writes.size());
+    for (auto& w : writes) {
+        auto backend_state_ptr = static_cast<trace_keyspace_backend_sesssion_state*>(w.records->backend_state_ptr.get());
+        units.push_back(co_await get_units(backend_state_ptr->write_sem, 1));
+    }
+
+    // This code is inside the _pending_writes gate and the qp pointer
+    // is cleared on ::stop() after the gate is closed.
+    assert(_qp_anchor != nullptr && _mm_anchor != nullptr);
+    cql3::query_processor& qp = *_qp_anchor;
+    service::migration_manager& mm = *_mm_anchor;
+
+    // Events of all the sessions are written together, in batches of bounded size.
+    // The batch statement turns the events of each session into a single mutation.
+    if (std::ranges::any_of(writes, [] (const session_write& w) { return !w.events_records.empty(); })) {
+        co_await _events.cache_table_info(qp, mm, _dummy_query_state);
+        std::vector<cql3::raw_value_vector_with_unset> values;
+        size_t batch_size = 0;
+        for (auto& w : writes) {
+            for (auto& one_event_record : w.events_records) {
+                batch_size += one_event_record.message.size() + event_record_overhead;
+                values.emplace_back(make_event_mutation_data(my_address(), *w.records, one_event_record));
+                if (batch_size >= max_events_batch_size) {
+                    co_await apply_events_mutation(qp, std::exchange(values, {}));
+                    batch_size = 0;
                 }
-            });
-        }).finally([records] {});
+            }
+        }
+        if (!values.empty()) {
+            co_await apply_events_mutation(qp, std::move(values));
+        }
+    }
+
+    co_await parallel_for_each(writes, [this, &qp, &mm] (session_write& w) {
+        return w.session_record_is_ready ? apply_session_mutations(qp, mm, w.records) : now();
     });
 }
 
@@ -29,6 +29,11 @@ class trace_keyspace_helper final : public i_tracing_backend_helper {
     static constexpr std::string_view NODE_SLOW_QUERY_LOG_TIME_IDX = "node_slow_log_time_idx";
 private:
     static constexpr int bad_column_family_message_period = 10000;
+    // Events records are written in batches of about that many bytes, below
+    // the default batch size warning threshold.
+    static constexpr size_t max_events_batch_size = 64 * 1024;
+    // Estimated size of the columns of an events record other than the message
+    static constexpr size_t event_record_overhead = 128;
 
     seastar::gate _pending_writes;
     int64_t _slow_query_last_nanos = 0;
@@ -76,39 +81,38 @@ class trace_keyspace_helper final : public i_tracing_backend_helper {
     gms::inet_address my_address() const noexcept;
 
     /**
-     * Write records of a single tracing session
-     *
-     * @param records records to write
-     */
-    void write_one_session_records(lw_shared_ptr<one_session_records> records);
-
-    /**
-     * Flush mutations of one particular tracing session. First "events"
-     * mutations and then, when they are complete, a "sessions" mutation.
+     * Flush mutations of a bulk of tracing sessions. First "events"
+     * mutations of all the sessions and then, when they are complete,
+     * "sessions" mutations of the finished sessions.
      *
      * @note This function guaranties that it'll handle exactly the same number
-     * of records @param records had when the function was invoked.
+     * of records the sessions in @param bulk had when the function was invoked.
      *
-     * @param records records describing the session's records
+     * @param bulk records of the sessions to write
      *
      * @return A future that resolves when applying of above mutations is
      *         complete.
      */
-    future<> flush_one_session_mutations(lw_shared_ptr<one_session_records> records);
+    future<> flush_bulk_mutations(records_bulk bulk);
 
     /**
-     * Apply events records mutations.
+     * Apply a batch of events records mutations.
      *
-     * @param records all session records
-     * @param events_records events recods to apply
-     * @param start_point a time point when this tracing session data writing has started
+     * @param values the mutation data of the events records, possibly of several sessions
      *
-     * @return a future that resolves when the mutation has been written.
+     * @return a future that resolves when the mutations have been written.
+     */
+    future<> apply_events_mutation(cql3::query_processor& qp, std::vector<cql3::raw_value_vector_with_unset> values);
+
+    /**
+     * Apply the mutations of a finished session: a session record, a session
+     * time index entry and, if requested, the slow query log entries.
+     *
+     * @param records all session records
      *
-     * @note A caller must ensure that @param events_records is alive till the
-     * returned future resolves.
+     * @return a future that resolves when the mutations have been written.
      */
-    future<> apply_events_mutation(cql3::query_processor& qp, service::migration_manager& mm, lw_shared_ptr<one_session_records> records, std::deque<event_record>& events_records);
+    future<> apply_session_mutations(cql3::query_processor& qp, service::migration_manager& mm, lw_shared_ptr<one_session_records> records);
 
     /**
      * Create a mutation data for a new session record
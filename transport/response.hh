@@ -82,6 +82,9 @@ class response {
     // Make a non-owning scattered_message of the response. Remains valid as long
     // as the response object is alive.
     scattered_message<char> make_message(uint8_t version, cql_compression compression);
+    // Same, but appends the response to the given message.
+    // If lz4_stream is given, lz4 compression continues the connection's stream.
+    void append_to_message(scattered_message<char>& msg, uint8_t version, cql_compression compression, lz4_stream_compressor* lz4_stream = nullptr);
 
     cql_binary_opcode opcode() const {
         return _opcode;
@@ -90,8 +93,9 @@ class response {
         return _body.size();
     }
 private:
-    void compress(cql_compression compression);
-    void compress_lz4();
+    void write_column_specs(const cql3::metadata& m, bool global_tables_spec);
+    void compress(cql_compression compression, lz4_stream_compressor* lz4_stream);
+    void compress_lz4(lz4_stream_compressor* lz4_stream);
     void compress_snappy();
 
     template <typename CqlFrameHeaderType>
@@ -63,6 +63,7 @@
 #include "utils/bit_cast.hh"
 #include "db/config.hh"
 #include "utils/reusable_buffer.hh"
+#include "utils/histogram_metrics_helper.hh"
 
 template<typename T = void>
 using coordinator_result = exceptions::coordinator_result<T>;
@@ -70,6 +71,7 @@ using coordinator_result = exceptions::coordinator_result<T>;
 namespace cql_transport {
 
 static logging::logger clogger("cql_server");
+static logging::logger slow_request_logger("cql_slow_request");
 
 /**
  * Skip registering CQL metrics for these SGs - these are internal scheduling groups that are not supposed to handle CQL
@@ -93,6 +95,56 @@ struct cql_frame_error : std::exception {
     }
 };
 
+// LZ4 compression state of a connection which negotiated the
+// SCYLLA_LZ4_STREAM_COMPRESSION extension. The compressed frames sent in
+// each direction form a single LZ4 stream, so every frame may refer to the
+// last 64KB of uncompressed data of the frames preceding it. Small frames,
+// which compress poorly on their own, then mostly compress to references
+// to the similar frames sent before them.
+// The frame format is the same as with plain lz4 compression.
+class lz4_stream_compressor {
+    static constexpr size_t window_size = 64 * 1024;
+    LZ4_stream_t _tx;
+    // The input of the compression is gone once a frame is compressed, so
+    // the window of both directions is kept in buffers of our own.
+    std::unique_ptr<char[]> _tx_window;
+    std::unique_ptr<char[]> _rx_window;
+    size_t _rx_window_size = 0;
+public:
+    lz4_stream_compressor()
+        : _tx_window(std::make_unique<char[]>(window_size))
+        , _rx_window(std::make_unique<char[]>(window_size))
+    {
+        LZ4_resetStream(&_tx);
+    }
+
+    // Compresses the next frame sent. Returns 0 on failure.
+    int compress(const char* in, int in_size, char* out, int out_size) {
+        auto ret = LZ4_compress_fast_continue(&_tx, in, out, in_size, out_size, 1);
+        LZ4_saveDict(&_tx, _tx_window.get(), window_size);
+        return ret;
+    }
+
+    // Decompresses the next frame received. Returns a negative value on failure.
+    int decompress(const char* in, int in_size, char* out, int out_size) {
+        auto ret = LZ4_decompress_safe_usingDict(in, out, in_size, out_size, _rx_window.get(), _rx_window_size);
+        if (ret < 0) {
+            return ret;
+        }
+        size_t len = ret;
+        if (len >= window_size) {
+            std::copy_n(out + len - window_size, window_size, _rx_window.get());
+            _rx_window_size = window_size;
+        } else {
+            auto keep = std::min(_rx_window_size, window_size - len);
+            std::copy_n(_rx_window.get() + _rx_window_size - keep, keep, _rx_window.get());
+            std::copy_n(out, len, _rx_window.get() + keep);
+            _rx_window_size = keep + len;
+        }
+        return ret;
+    }
+};
+
 inline int16_t consistency_to_wire(db::consistency_level c)
 {
     switch (c) {
@@ -241,6 +293,7 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
     , _config(std::move(config))
     , _max_request_size(_config.max_request_size)
     , _max_concurrent_requests(db_cfg.max_concurrent_requests_per_shard)
+    , _slow_request_threshold_ms(db_cfg.cql_slow_request_threshold_in_ms)
     , _memory_available(ml.get_semaphore())
     , _notifier(std::make_unique<event_notifier>(*this))
     , _auth_service(auth_service)
@@ -267,6 +320,13 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_gauge("requests_serving", _stats.requests_serving,
                         sm::description("Holds a number of requests that are being processed right now.")),
 
+        sm::make_counter("responses_written", _stats.responses_written,
+                        sm::description("Counts a number of responses written to clients.")),
+
+        sm::make_counter("response_batches", _stats.response_batches,
+                        sm::description("Counts a number of writes of responses to clients, each followed by a flush. "
+                                        "responses_written divided by response_batches is the average number of responses written per flush.")),
+
         sm::make_gauge("requests_blocked_memory_current", [this] { return _memory_available.waiters(); },
                         sm::description(
                             seastar::format("Holds the number of requests that are currently blocked due to reaching the memory quota limit ({}B). "
@@ -278,6 +338,8 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_counter("requests_shed", _stats.requests_shed,
                         sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component.")),
+        sm::make_counter("slow_requests", _stats.slow_requests,
+                        sm::description("Counts QUERY, EXECUTE and BATCH requests which took longer than cql_slow_request_threshold_in_ms.")),
         sm::make_gauge("requests_memory_available", [this] { return _memory_available.current(); },
                         sm::description(
                             seastar::format("Holds the amount of available memory for admitting new requests (max is {}B)."
@@ -301,6 +363,17 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         );
     }
 
+    sm::label workload_label("workload_type");
+    for (auto wt : {qos::service_level_options::workload_type::unspecified,
+                    qos::service_level_options::workload_type::batch,
+                    qos::service_level_options::workload_type::interactive}) {
+        transport_metrics.emplace_back(
+            sm::make_histogram("cql_request_latency", [this, wt] { return to_metrics_histogram(_stats.request_latency[static_cast<size_t>(wt)]); },
+                        sm::description("Histogram of the latency of QUERY, EXECUTE and BATCH requests, by the workload type of the service level of the client."),
+                        {workload_label(sstring(qos::service_level_options::to_string(wt)))}).set_skip_when_empty()
+        );
+    }
+
     _metrics.add_group("transport", std::move(transport_metrics));
 }
 
@@ -427,6 +500,7 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
     }
 
     cql_sg_stats::request_kind_stats& cql_stats = _server.get_cql_opcode_stats(cqlop);
+    const auto started_at = utils::time_estimated_histogram::clock::now();
     tracing::set_request_size(trace_state, fbuf.bytes_left());
     cql_stats.request_size += fbuf.bytes_left();
     ++cql_stats.count;
@@ -474,11 +548,16 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
         case cql_binary_opcode::REGISTER:      return wrap_in_foreign(process_register(stream, std::move(in), client_state, trace_state));
         default:                               throw exceptions::protocol_exception(format("Unknown opcode {:d}", int(cqlop)));
         }
-    }).then_wrapped([this, cqlop, &cql_stats, stream, &client_state, linearization_buffer = std::move(linearization_buffer), trace_state] (future<result_with_foreign_response_ptr> f) {
+    }).then_wrapped([this, cqlop, &cql_stats, stream, &client_state, linearization_buffer = std::move(linearization_buffer), trace_state, started_at] (future<result_with_foreign_response_ptr> f) {
         auto stop_trace = defer([&] {
             tracing::stop_foreground(trace_state);
         });
         --_server._stats.requests_serving;
+        if (cqlop == cql_binary_opcode::QUERY || cqlop == cql_binary_opcode::EXECUTE || cqlop == cql_binary_opcode::BATCH) {
+            auto wt = static_cast<size_t>(client_state.get_workload_type());
+            auto& latency = _server._stats.request_latency;
+            latency[wt < latency.size() ? wt : 0].add(utils::time_estimated_histogram::clock::now() - started_at);
+        }
 
         return utils::result_into_future<result_with_foreign_response_ptr>(utils::result_try([&] () -> result_with_foreign_response_ptr {
             result_with_foreign_response_ptr res = f.get();
@@ -717,6 +796,7 @@ future<> cql_server::connection::process_request() {
             });
         }
 
+        const auto received_at = utils::time_estimated_histogram::clock::now();
         const auto shedding_timeout = std::chrono::milliseconds(50);
         auto fut = allow_shedding
                 ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
@@ -740,14 +820,15 @@ future<> cql_server::connection::process_request() {
             ++_server._stats.requests_blocked_memory;
         }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
+        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested, received_at] (auto mem_permit_fut) {
           if (mem_permit_fut.failed()) {
               // Ignore semaphore errors - they are expected if load shedding took place
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
           semaphore_units<> mem_permit = mem_permit_fut.get();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, received_at, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+            const auto admitted_at = utils::time_estimated_histogram::clock::now();
 
             ++_server._stats.requests_served;
             ++_server._stats.requests_serving;
@@ -772,8 +853,9 @@ future<> cql_server::connection::process_request() {
                     _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit) :
                     process_request_one(istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit);
 
-            future<> request_response_future = request_process_future.then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave), stream] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
+            future<> request_response_future = request_process_future.then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave), stream, op, received_at, admitted_at] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
                 try {
+                    maybe_log_slow_request(op, buf.get_istream(), received_at, admitted_at);
                     if (response_f.failed()) {
                         const auto message = format("request processing failed, error [{}]", response_f.get_exception());
                         clogger.error("{}: {}", _client_state.get_remote_address(), message);
@@ -800,6 +882,77 @@ future<> cql_server::connection::process_request() {
     });
 }
 
+void cql_server::connection::maybe_log_slow_request(uint8_t op, fragmented_temporary_buffer::istream buf, utils::time_estimated_histogram::clock::time_point received_at,
+        utils::time_estimated_histogram::clock::time_point admitted_at) {
+    auto threshold = _server._slow_request_threshold_ms();
+    if (!threshold) {
+        return;
+    }
+    auto cqlop = static_cast<cql_binary_opcode>(op);
+    if (cqlop != cql_binary_opcode::QUERY && cqlop != cql_binary_opcode::EXECUTE && cqlop != cql_binary_opcode::BATCH) {
+        return;
+    }
+    auto now = utils::time_estimated_histogram::clock::now();
+    if (now - received_at < std::chrono::milliseconds(threshold)) {
+        return;
+    }
+    ++_server._stats.slow_requests;
+    static thread_local logger::rate_limit rate_limit(std::chrono::seconds(1));
+    auto us = [] (auto d) { return std::chrono::duration_cast<std::chrono::microseconds>(d).count(); };
+    // One line of key=value pairs per request, so that the log is easy to aggregate
+    slow_request_logger.log(log_level::warn, rate_limit, "op={} elapsed_us={} admission_us={} processing_us={} request_bytes={} keyspace={} user={} client={} statement=\"{}\"",
+            cqlop == cql_binary_opcode::QUERY ? "QUERY" : cqlop == cql_binary_opcode::EXECUTE ? "EXECUTE" : "BATCH",
+            us(now - received_at), us(admitted_at - received_at), us(now - admitted_at), buf.bytes_left(),
+            _client_state.get_raw_keyspace(), _client_state.user() ? fmt::to_string(*_client_state.user()) : "anonymous",
+            _client_state.get_client_address(), describe_statement(op, buf));
+}
+
+// Returns the text of the statement of the request, or of the first statement of a batch
+sstring cql_server::connection::describe_statement(uint8_t op, fragmented_temporary_buffer::istream buf) const {
+    // Longer statements are truncated, the start should be enough to recognize them
+    static constexpr size_t max_statement_length = 1024;
+    bytes_ostream linearization_buffer;
+    auto in = request_reader(std::move(buf), linearization_buffer);
+    auto describe_prepared = [this] (bytes id) -> sstring {
+        cql3::prepared_cache_key_type cache_key(std::move(id));
+        auto prepared = _server._query_processor.local().get_prepared(cache_key);
+        if (!prepared) {
+            return format("<unknown prepared statement {}>", to_hex(cql3::prepared_cache_key_type::cql_id(cache_key)));
+        }
+        return prepared->statement->raw_cql_statement;
+    };
+    try {
+        sstring statement;
+        switch (static_cast<cql_binary_opcode>(op)) {
+        case cql_binary_opcode::QUERY:
+            statement = sstring(in.read_long_string_view());
+            break;
+        case cql_binary_opcode::EXECUTE:
+            statement = describe_prepared(in.read_short_bytes());
+            break;
+        case cql_binary_opcode::BATCH: {
+            in.read_byte(); // type
+            auto n = in.read_short();
+            if (n == 0) {
+                return "BATCH of 0 statements";
+            }
+            auto kind = in.read_byte();
+            auto first = kind == 0 ? sstring(in.read_long_string_view()) : describe_prepared(in.read_short_bytes());
+            statement = format("BATCH of {} statements: {}", n, first);
+            break;
+        }
+        default:
+            break;
+        }
+        if (statement.size() > max_statement_length) {
+            statement.resize(max_statement_length);
+        }
+        return statement;
+    } catch (...) {
+        return format("<malformed request: {}>", std::current_exception());
+    }
+}
+
 // Contiguous buffers for use with compression primitives.
 // Be careful when dealing with them, because they are shared and
 // can be modified on preemption points.
@@ -822,7 +975,7 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
             if (length < 4) {
                 throw std::runtime_error(fmt::format("CQL frame truncated: expected to have at least 4 bytes, got {}", length));
             }
-            return _buffer_reader.read_exactly(_read_buf, length).then([] (fragmented_temporary_buffer buf) {
+            return _buffer_reader.read_exactly(_read_buf, length).then([this] (fragmented_temporary_buffer buf) {
                 auto input_buffer = input_buffer_guard();
                 auto output_buffer = output_buffer_guard();
                 auto v = fragmented_temporary_buffer::view(buf);
@@ -831,8 +984,10 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                     throw std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len));
                 }
                 auto in = input_buffer.get_linearized_view(v);
-                return output_buffer.make_fragmented_temporary_buffer(uncomp_len, [&in] (bytes_mutable_view out) {
-                    auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size());
+                return output_buffer.make_fragmented_temporary_buffer(uncomp_len, [this, &in] (bytes_mutable_view out) {
+                    auto ret = _lz4_stream
+                            ? _lz4_stream->decompress(reinterpret_cast<const char*>(in.data()), in.size(), reinterpret_cast<char*>(out.data()), out.size())
+                            : LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size());
                     if (ret < 0) {
                         throw std::runtime_error("CQL frame LZ4 uncompression failure");
                     }
@@ -899,6 +1054,9 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
         }
     }
     _client_state.set_protocol_extensions(std::move(cql_proto_exts));
+    if (_compression == cql_compression::lz4 && _client_state.is_protocol_extension_set(cql_protocol_extension::LZ4_STREAM_COMPRESSION)) {
+        _lz4_stream = std::make_unique<lz4_stream_compressor>();
+    }
     std::unique_ptr<cql_server::response> res;
     if (auto& a = client_state.get_auth_service()->underlying_authenticator(); a.require_authentication()) {
         _authenticating = true;
@@ -1058,20 +1216,16 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
     tracing::add_query(trace_state, query);
     tracing::begin(trace_state, "Preparing CQL3 query", client_state.get_client_address());
 
-    auto cpu_id = this_shard_id();
-    auto cpus = boost::irange(0u, smp::count);
-    return parallel_for_each(cpus.begin(), cpus.end(), [this, query, cpu_id, &client_state] (unsigned int c) mutable {
-        if (c != cpu_id) {
-            return smp::submit_to(c, [this, query, &client_state] () mutable {
-                return _server._query_processor.local().prepare(std::move(query), client_state).discard_result();
-            });
-        } else {
-            return make_ready_future<>();
-        }
-    }).then([this, query, stream, &client_state, trace_state] () mutable {
-        tracing::trace(trace_state, "Done preparing on remote shards");
-        return _server._query_processor.local().prepare(std::move(query), client_state).then([this, stream, trace_state] (auto msg) {
-            tracing::trace(trace_state, "Done preparing on a local shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
+    // Other shards prepare the statement from its home shard when they first execute it,
+    // see query_processor::prepare_from_home_shard().
+    return _server._query_processor.local().prepare(query, client_state).then([this, query, stream, &client_state, trace_state] (auto msg) mutable {
+        tracing::trace(trace_state, "Done preparing on a local shard");
+        auto home = cql3::query_processor::home_shard_of(cql3::prepared_cache_key_type(messages::result_message::prepared::cql::get_id(msg)));
+        auto f = home == this_shard_id() ? make_ready_future<>() : smp::submit_to(home, [this, query = std::move(query), &client_state] () mutable {
+            return _server._query_processor.local().prepare(std::move(query), client_state).discard_result();
+        });
+        return f.then([this, stream, trace_state, msg = std::move(msg)] {
+            tracing::trace(trace_state, "Done preparing on the home shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
                 return messages::result_message::prepared::cql::get_id(msg);
             }));
             return make_result(stream, *msg, trace_state, _version);
@@ -1083,6 +1237,7 @@ static future<process_fn_return_type>
 process_execute_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version,
         service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+    auto request_start = in;
     cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
     auto& id = cql3::prepared_cache_key_type::cql_id(cache_key);
     bool needs_authorization = false;
@@ -1096,7 +1251,14 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     }
 
     if (!prepared) {
-        throw exceptions::prepared_query_not_found_exception(id);
+        return qp.local().prepare_from_home_shard(cache_key, client_state).then([&client_state, &qp, request_start, stream, version,
+                permit = std::move(permit), trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls),
+                id = cql3::cql_prepared_id_type(id)] (auto local_prepared) mutable {
+            if (!local_prepared) {
+                throw exceptions::prepared_query_not_found_exception(id);
+            }
+            return process_execute_internal(client_state, qp, request_start, stream, version, std::move(permit), std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+        });
     }
 
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
@@ -1158,6 +1320,7 @@ static future<process_fn_return_type>
 process_batch_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version,
         service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+    auto request_start = in;
     const auto type = in.read_byte();
     const unsigned n = in.read_short();
 
@@ -1199,7 +1362,15 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
             if (!ps) {
                 ps = qp.local().get_prepared(cache_key);
                 if (!ps) {
-                    throw exceptions::prepared_query_not_found_exception(id);
+                    // Nothing was executed yet, so the batch is processed again once the statement is prepared locally.
+                    return qp.local().prepare_from_home_shard(cache_key, client_state).then([&client_state, &qp, request_start, stream, version,
+                            permit = std::move(permit), trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls),
+                            id = cql3::cql_prepared_id_type(id)] (auto local_prepared) mutable {
+                        if (!local_prepared) {
+                            throw exceptions::prepared_query_not_found_exception(id);
+                        }
+                        return process_batch_internal(client_state, qp, request_start, stream, version, std::move(permit), std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+                    });
                 }
                 // authorize a particular prepared statement only once
                 needs_authorization = pending_authorization_entries.emplace(std::move(cache_key), ps->checked_weak_from_this()).second;
@@ -1586,33 +1757,54 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
-    _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
-        auto message = response->make_message(_version, compression);
-        message.on_delete([response = std::move(response)] { });
-        return _write_buf.write(std::move(message)).then([this] {
-            return _write_buf.flush();
+    // Responses which become ready while the previous ones are being
+    // written are queued, and written together with a single write and
+    // flush, so pipelined small requests don't cost a write each.
+    bool write_scheduled = !_pending_responses.empty();
+    _pending_responses.push_back(pending_response{std::move(response), std::move(permit), compression});
+    if (!write_scheduled) {
+        _ready_to_respond = _ready_to_respond.then([this] {
+            return write_pending_responses();
         });
+    }
+}
+
+future<> cql_server::connection::write_pending_responses() {
+    auto responses = std::exchange(_pending_responses, {});
+    ++_server._stats.response_batches;
+    _server._stats.responses_written += responses.size();
+    scattered_message<char> message;
+    for (auto& r : responses) {
+        r.response->append_to_message(message, _version, r.compression, _lz4_stream.get());
+    }
+    message.on_delete([responses = std::move(responses)] { });
+    return _write_buf.write(std::move(message)).then([this] {
+        return _write_buf.flush();
     });
 }
 
 scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
+    scattered_message<char> msg;
+    append_to_message(msg, version, compression);
+    return msg;
+}
+
+void cql_server::response::append_to_message(scattered_message<char>& msg, uint8_t version, cql_compression compression, lz4_stream_compressor* lz4_stream) {
     if (compression != cql_compression::none) {
-        compress(compression);
+        compress(compression, lz4_stream);
     }
-    scattered_message<char> msg;
     auto frame = make_frame(version, _body.size());
     msg.append(std::move(frame));
     for (auto&& fragment : _body.fragments()) {
         msg.append_static(reinterpret_cast<const char*>(fragment.data()), fragment.size());
     }
-    return msg;
 }
 
-void cql_server::response::compress(cql_compression compression)
+void cql_server::response::compress(cql_compression compression, lz4_stream_compressor* lz4_stream)
 {
     switch (compression) {
     case cql_compression::lz4:
-        compress_lz4();
+        compress_lz4(lz4_stream);
         break;
     case cql_compression::snappy:
         compress_snappy();
@@ -1623,19 +1815,21 @@ void cql_server::response::compress(cql_compression compression)
     set_frame_flag(cql_frame_flags::compression);
 }
 
-void cql_server::response::compress_lz4()
+void cql_server::response::compress_lz4(lz4_stream_compressor* lz4_stream)
 {
     auto input_buffer = input_buffer_guard();
     auto output_buffer = output_buffer_guard();
 
     auto in = input_buffer.get_linearized_view(_body);
     size_t output_len = LZ4_COMPRESSBOUND(in.size()) + 4;
-    _body = output_buffer.make_bytes_ostream(output_len, [&in] (bytes_mutable_view out) {
+    _body = output_buffer.make_bytes_ostream(output_len, [&in, lz4_stream] (bytes_mutable_view out) {
         out.data()[0] = (in.size() >> 24) & 0xFF;
         out.data()[1] = (in.size() >> 16) & 0xFF;
         out.data()[2] = (in.size() >> 8) & 0xFF;
         out.data()[3] = in.size() & 0xFF;
-        auto ret = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data() + 4), in.size(), out.size() - 4);
+        auto ret = lz4_stream
+                ? lz4_stream->compress(reinterpret_cast<const char*>(in.data()), in.size(), reinterpret_cast<char*>(out.data() + 4), out.size() - 4)
+                : LZ4_compress_default(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data() + 4), in.size(), out.size() - 4);
         if (ret == 0) {
             throw std::runtime_error("CQL frame LZ4 compression failure");
         }
@@ -1973,6 +2167,16 @@ void cql_server::response::write(const cql3::metadata& m, bool no_metadata) {
         return;
     }
 
+    auto& specs = m.serialized_column_specs(global_tables_spec, [&] {
+        response specs_response(0, _opcode, tracing::trace_state_ptr());
+        specs_response.write_column_specs(m, global_tables_spec);
+        auto v = specs_response._body.linearize();
+        return bytes(v.data(), v.size());
+    });
+    _body.write(specs);
+}
+
+void cql_server::response::write_column_specs(const cql3::metadata& m, bool global_tables_spec) {
     auto names_i = m.get_names().begin();
 
     if (global_tables_spec) {
@@ -30,6 +30,7 @@
 #include "cql3/query_options.hh"
 #include "transport/messages/result_message.hh"
 #include "utils/chunked_vector.hh"
+#include "utils/estimated_histogram.hh"
 #include "exceptions/coordinator_result.hh"
 #include "db/operation_type.hh"
 #include "db/config.hh"
@@ -66,6 +67,7 @@ namespace cql_transport {
 
 class request_reader;
 class response;
+class lz4_stream_compressor;
 enum class cql_binary_opcode : uint8_t;
 
 enum class cql_compression {
@@ -142,8 +144,15 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving = 0;
         uint64_t requests_blocked_memory = 0;
         uint64_t requests_shed = 0;
+        uint64_t slow_requests = 0;
+        uint64_t responses_written = 0;
+        uint64_t response_batches = 0;
 
         std::unordered_map<exceptions::exception_code, uint64_t> errors;
+
+        // Latency of QUERY, EXECUTE and BATCH requests, by the workload type
+        // of the client's service level.
+        std::array<utils::time_estimated_histogram, 3> request_latency;
     };
 private:
     class event_notifier;
@@ -154,6 +163,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     cql_server_config _config;
     size_t _max_request_size;
     utils::updateable_value<uint32_t> _max_concurrent_requests;
+    utils::updateable_value<uint32_t> _slow_request_threshold_ms;
     semaphore& _memory_available;
     seastar::metrics::metric_groups _metrics;
     std::unique_ptr<event_notifier> _notifier;
@@ -194,6 +204,8 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         fragmented_temporary_buffer::reader _buffer_reader;
         cql_protocol_version_type _version = 0;
         cql_compression _compression = cql_compression::none;
+        // Set if the client negotiated SCYLLA_LZ4_STREAM_COMPRESSION along with lz4.
+        std::unique_ptr<lz4_stream_compressor> _lz4_stream;
         service::client_state _client_state;
         timer<lowres_clock> _shedding_timer;
         bool _shed_incoming_requests = false;
@@ -201,6 +213,14 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         bool _ready = false;
         bool _authenticating = false;
 
+        struct pending_response {
+            foreign_ptr<std::unique_ptr<cql_server::response>> response;
+            service_permit permit;
+            cql_compression compression;
+        };
+        // Responses waiting for the current write to complete, see write_response().
+        std::vector<pending_response> _pending_responses;
+
         enum class tracing_request_type : uint8_t {
             not_requested,
             no_write_on_close,
@@ -229,6 +249,10 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     private:
         friend class process_request_executor;
         future<foreign_ptr<std::unique_ptr<cql_server::response>>> process_request_one(fragmented_temporary_buffer::istream buf, uint8_t op, uint16_t stream, service::client_state& client_state, tracing_request_type tracing_request, service_permit permit);
+        // Logs the request if it took longer than cql_slow_request_threshold_in_ms
+        void maybe_log_slow_request(uint8_t op, fragmented_temporary_buffer::istream buf, utils::time_estimated_histogram::clock::time_point received_at,
+                utils::time_estimated_histogram::clock::time_point admitted_at);
+        sstring describe_statement(uint8_t op, fragmented_temporary_buffer::istream buf) const;
         unsigned frame_size() const;
         unsigned pick_request_cpu();
         cql_binary_frame_v3 parse_frame(temporary_buffer<char> buf) const;
@@ -273,6 +297,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
                 service_permit permit, tracing::trace_state_ptr trace_state, Process process_fn);
 
         void write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit = empty_service_permit(), cql_compression compression = cql_compression::none);
+        future<> write_pending_responses();
 
         friend event_notifier;
     };
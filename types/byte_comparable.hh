@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <ranges>
+
+#include "types/types.hh"
+#include "bytes_ostream.hh"
+
+// Byte-comparable encoding of values.
+//
+// The encoding of a value of a type compares, as unsigned bytes, the way
+// abstract_type::compare() compares the values: encodings of equal values
+// are equal, and the encoding of a smaller value is lexicographically
+// smaller. The encodings of the values of a type are also prefix-free, so
+// the encodings of the components of a compound value can be concatenated
+// and still compare like the compound value.
+//
+// The encoding is meant for structures which can only compare keys bytewise,
+// like tries, and is not meant to be decoded back.
+namespace byte_comparable {
+
+inline void append_byte(bytes_ostream& out, uint8_t b) {
+    out.write(bytes_view(reinterpret_cast<const int8_t*>(&b), 1));
+}
+
+// Appends the big-endian representation of the value.
+template <std::unsigned_integral T>
+void append_unsigned(bytes_ostream& out, T value) {
+    std::array<int8_t, sizeof(T)> buf;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        buf[i] = int8_t(value >> ((sizeof(T) - 1 - i) * 8));
+    }
+    out.write(bytes_view(buf.data(), buf.size()));
+}
+
+// Appends the big-endian representation of the value with the sign bit
+// flipped, so that negative values sort first.
+template <std::signed_integral T>
+void append_signed(bytes_ostream& out, T value) {
+    using U = std::make_unsigned_t<T>;
+    append_unsigned(out, U(U(value) ^ (U(1) << (sizeof(T) * 8 - 1))));
+}
+
+// The 0x00 and 0x01 bytes of the value are escaped as 0x01 0x01 and 0x01 0x02,
+// and the value is terminated by 0x00, which thus never occurs within it.
+// This makes a value sort before the values it is a prefix of.
+inline void append_escaped(bytes_ostream& out, bytes_view value) {
+    while (!value.empty()) {
+        auto it = std::ranges::find_if(value, [] (int8_t b) { return uint8_t(b) <= 1; });
+        out.write(bytes_view(value.begin(), it - value.begin()));
+        if (it == value.end()) {
+            break;
+        }
+        append_byte(out, 1);
+        append_byte(out, uint8_t(*it) + 1);
+        value.remove_prefix(it - value.begin() + 1);
+    }
+    append_byte(out, 0);
+}
+
+// Appends the encoding of the value of the given type.
+//
+// Throws marshal_exception if the value is not a valid serialized value
+// of the type.
+void append(bytes_ostream& out, const abstract_type& t, managed_bytes_view value);
+
+inline bytes encode(const abstract_type& t, managed_bytes_view value) {
+    bytes_ostream out;
+    append(out, t, value);
+    return bytes(out.linearize());
+}
+
+} // namespace byte_comparable
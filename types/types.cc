@@ -18,6 +18,7 @@
 #include <iterator>
 #include <seastar/core/print.hh>
 #include "types/types.hh"
+#include "types/byte_comparable.hh"
 #include "seastar/core/shared_ptr.hh"
 #include "utils/serialization.hh"
 #include "vint-serialization.hh"
@@ -2480,6 +2481,203 @@ std::strong_ordering abstract_type::compare(bytes_view v1, managed_bytes_view v2
     return compare(managed_bytes_view(v1), v2);
 }
 
+namespace {
+
+struct byte_comparable_visitor {
+    managed_bytes_view v;
+    bytes_ostream& out;
+
+    void push(uint8_t b) {
+        byte_comparable::append_byte(out, b);
+    }
+    void append_escaped() {
+        with_linearized(v, [&] (bytes_view bv) {
+            byte_comparable::append_escaped(out, bv);
+        });
+    }
+    // The empty value sorts before all the others.
+    template <std::invocable<> Func>
+    void with_empty_check(Func func) {
+        if (v.empty()) {
+            push(0);
+            return;
+        }
+        push(1);
+        func();
+    }
+
+    template <typename T> void operator()(const simple_type_impl<T>&) {
+      with_empty_check([&] {
+        T a = simple_type_traits<T>::read_nonempty(v);
+        if constexpr (std::same_as<T, bool>) {
+            push(a);
+        } else if constexpr (std::same_as<T, db_clock::time_point>) {
+            byte_comparable::append_signed(out, int64_t(a.time_since_epoch().count()));
+        } else if constexpr (std::signed_integral<T>) {
+            byte_comparable::append_signed(out, a);
+        } else {
+            byte_comparable::append_unsigned(out, a);
+        }
+      });
+    }
+    template <typename T> void operator()(const floating_type_impl<T>&) {
+      with_empty_check([&] {
+        using I = typename int_of_size<T>::itype;
+        using U = std::make_unsigned_t<I>;
+        T a = simple_type_traits<T>::read_nonempty(v);
+        // All NaNs are equal, and greater than anything else. Negative
+        // numbers, including -0, have all their bits inverted, so that
+        // -0 sorts before 0.
+        U u = std::isnan(a) ? U(std::bit_cast<I>(std::numeric_limits<T>::quiet_NaN())) : U(std::bit_cast<I>(a));
+        constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+        byte_comparable::append_unsigned(out, U((u & sign) ? ~u : (u | sign)));
+      });
+    }
+    void operator()(const string_type_impl&) { append_escaped(); }
+    void operator()(const bytes_type_impl&) { append_escaped(); }
+    void operator()(const duration_type_impl&) { append_escaped(); }
+    void operator()(const inet_addr_type_impl&) { append_escaped(); }
+    void operator()(const date_type_impl&) { append_escaped(); }
+    void operator()(const timeuuid_type_impl&) {
+      with_empty_check([&] {
+        with_linearized(v, [&] (bytes_view bv) {
+            byte_comparable::append_unsigned(out, utils::timeuuid_read_msb(bv.begin()));
+            // The least significant bits compare as signed bytes.
+            byte_comparable::append_unsigned(out, utils::uuid_read_lsb(bv.begin()) ^ 0x8080808080808080);
+        });
+      });
+    }
+    void operator()(const uuid_type_impl&) {
+        // Values shorter than a UUID are all equal, and smaller than the others.
+        if (v.size() < 16) {
+            push(0);
+            return;
+        }
+        push(1);
+        with_linearized(v, [&] (bytes_view bv) {
+            auto version = (bv[6] >> 4) & 0x0f;
+            push(version);
+            if (version == 1) {
+                byte_comparable::append_unsigned(out, utils::timeuuid_read_msb(bv.begin()));
+                byte_comparable::append_unsigned(out, utils::uuid_read_lsb(bv.begin()));
+            } else {
+                byte_comparable::append_escaped(out, bv);
+            }
+        });
+    }
+    void operator()(const empty_type_impl&) {}
+    void operator()(const counter_type_impl&) {
+        // untouched (empty) counter evaluates as 0
+        byte_comparable::append_signed(out, v.empty() ? int64_t(0) : simple_type_traits<int64_t>::read_nonempty(v));
+    }
+    // The minimal two's complement representation of the number, prefixed by
+    // its sign and length, so that numbers with more bytes have a larger
+    // magnitude.
+    void operator()(const varint_type_impl&) {
+      with_empty_check([&] {
+        with_linearized(v, [&] (bytes_view bv) {
+            while (bv.size() > 1 && ((bv[0] == 0 && bv[1] >= 0) || (bv[0] == -1 && bv[1] < 0))) {
+                bv.remove_prefix(1);
+            }
+            bool negative = bv[0] < 0;
+            push(negative ? 0x7f : 0x80);
+            byte_comparable::append_unsigned(out, negative ? ~uint32_t(bv.size()) : uint32_t(bv.size()));
+            out.write(bv);
+        });
+      });
+    }
+    // The number is normalized to its decimal digits, without the trailing
+    // zeroes, and the exponent of the first one. The bytes of the magnitude
+    // of negative numbers are inverted.
+    void operator()(const decimal_type_impl& d) {
+      with_empty_check([&] {
+        auto a = deserialize_value(d, v);
+        auto digits = a.unscaled_value().str();
+        bool negative = digits.starts_with('-');
+        if (negative) {
+            digits.erase(0, 1);
+        }
+        int64_t scale = a.scale();
+        while (digits.size() > 1 && digits.back() == '0') {
+            digits.pop_back();
+            --scale;
+        }
+        if (digits == "0") {
+            push(2);
+            return;
+        }
+        push(negative ? 1 : 3);
+        bytes_ostream magnitude;
+        byte_comparable::append_signed(magnitude, int64_t(digits.size()) - 1 - scale);
+        for (char c : digits) {
+            byte_comparable::append_byte(magnitude, c - '0' + 1);
+        }
+        byte_comparable::append_byte(magnitude, 0);
+        for (auto m : magnitude.linearize()) {
+            push(negative ? ~uint8_t(m) : uint8_t(m));
+        }
+      });
+    }
+    // Each element is prefixed with 0x01 if it is null, 0x02 otherwise, and
+    // the elements are terminated by 0x00.
+    void operator()(const listlike_collection_type_impl& l) {
+      with_empty_check([&] {
+        using llpdi = listlike_partial_deserializing_iterator;
+        for (auto i = llpdi::begin(v); i != llpdi::end(v); ++i) {
+            if (!*i) {
+                push(1);
+            } else {
+                push(2);
+                byte_comparable::append(out, *l.get_elements_type(), **i);
+            }
+        }
+        push(0);
+      });
+    }
+    void operator()(const map_type_impl& m) {
+      with_empty_check([&] {
+        auto in = v;
+        int size = read_collection_size(in);
+        for (int i = 0; i < size; ++i) {
+            push(2);
+            byte_comparable::append(out, *m.get_keys_type(), read_collection_key(in));
+            byte_comparable::append(out, *m.get_values_type(), read_collection_value_nonnull(in));
+        }
+        push(0);
+      });
+    }
+    // Like lists, except that trailing nulls are dropped, see compare_aux().
+    void operator()(const tuple_type_impl& t) {
+        auto types = t.all_types().begin();
+        auto end = out.size();
+        for (auto i = tuple_deserializing_iterator::start(v); i != tuple_deserializing_iterator::finish(v) && types != t.all_types().end(); ++i, ++types) {
+            if (!*i) {
+                push(1);
+            } else {
+                push(2);
+                byte_comparable::append(out, **types, **i);
+                end = out.size();
+            }
+        }
+        out.remove_suffix(out.size() - end);
+        push(0);
+    }
+    // Inverting the bytes of prefix-free encodings reverses their order.
+    void operator()(const reversed_type_impl& r) {
+        bytes_ostream underlying;
+        byte_comparable::append(underlying, *r.underlying_type(), v);
+        for (auto b : underlying.linearize()) {
+            push(~uint8_t(b));
+        }
+    }
+};
+
+}
+
+void byte_comparable::append(bytes_ostream& out, const abstract_type& t, managed_bytes_view value) {
+    visit(t, byte_comparable_visitor{value, out});
+}
+
 bool abstract_type::equal(bytes_view v1, bytes_view v2) const {
     return ::visit(*this, [&](const auto& t) {
         if (is_byte_order_equal_visitor{}(t)) {
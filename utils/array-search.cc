@@ -100,6 +100,30 @@ arch_target("avx2") int array_search_gt_impl(int64_t val, const int64_t* array,
     return size - cnt;
 }
 
+/*
+ * AVX-512 version of the above. It eats 8 keys in one go and has the
+ * compare-to-mask instruction, so there's no need in movemask/popcnt
+ * juggling. The capacity may not be a multiple of 8, in this case the
+ * tail is loaded and compared under the mask not to read past the array.
+ */
+
+arch_target("avx512f") int array_search_gt_impl(int64_t val, const int64_t* array, const int capacity, const int size) {
+    int cnt = 0;
+    int i;
+
+    __m512i k = _mm512_set1_epi64(val);
+    for (i = 0; i + 8 <= capacity; i += 8) {
+        cnt += __builtin_popcount(_mm512_cmpgt_epi64_mask(_mm512_loadu_si512(&array[i]), k));
+    }
+
+    if (i < capacity) {
+        __mmask8 tail = (1u << (capacity - i)) - 1;
+        cnt += __builtin_popcount(_mm512_mask_cmpgt_epi64_mask(tail, _mm512_maskz_loadu_epi64(tail, &array[i]), k));
+    }
+
+    return size - cnt;
+}
+
 /*
  * SSE4 version of searching in array for an exact match.
  */
@@ -25,7 +25,7 @@ static hmac_sha256_digest hmac_sha256(std::string_view key, std::string_view msg
     return digest;
 }
 
-static hmac_sha256_digest get_signature_key(std::string_view key, std::string_view date_stamp, std::string_view region_name, std::string_view service_name) {
+hmac_sha256_digest get_signing_key(std::string_view key, std::string_view date_stamp, std::string_view region_name, std::string_view service_name) {
     auto date = hmac_sha256("AWS4" + std::string(key), date_stamp);
     auto region = hmac_sha256(std::string_view(date.data(), date.size()), region_name);
     auto service = hmac_sha256(std::string_view(region.data(), region.size()), service_name);
@@ -74,10 +74,11 @@ void check_expiry(std::string_view signature_date) {
     }
 }
 
-std::string get_signature(std::string_view access_key_id, std::string_view secret_access_key,
-        std::string_view host, std::string_view canonical_uri, std::string_view method,
+template <typename SigningKeyFunc>
+static std::string do_get_signature(std::string_view host, std::string_view canonical_uri, std::string_view method,
         std::optional<std::string_view> orig_datestamp, std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
-        const std::vector<temporary_buffer<char>>* body_content, std::string_view region, std::string_view service, std::string_view query_string) {
+        const std::vector<temporary_buffer<char>>* body_content, std::string_view region, std::string_view service, std::string_view query_string,
+        SigningKeyFunc&& signing_key_for) {
     auto amz_date_it = signed_headers_map.find("x-amz-date");
     if (amz_date_it == signed_headers_map.end()) {
         throw std::runtime_error("X-Amz-Date header is mandatory for signature verification");
@@ -105,11 +106,33 @@ std::string get_signature(std::string_view access_key_id, std::string_view secre
     std::string credential_scope = fmt::format("{}/{}/{}/aws4_request", datestamp, region, service);
     std::string string_to_sign = fmt::format("{}\n{}\n{}\n{}", algorithm, amz_date, credential_scope,  apply_sha256(canonical_request));
 
-    hmac_sha256_digest signing_key = get_signature_key(secret_access_key, datestamp, region, service);
+    const hmac_sha256_digest& signing_key = signing_key_for(datestamp);
     hmac_sha256_digest signature = hmac_sha256(std::string_view(signing_key.data(), signing_key.size()), string_to_sign);
 
     return to_hex(bytes_view(reinterpret_cast<const int8_t*>(signature.data()), signature.size()));
 }
 
+std::string get_signature(std::string_view access_key_id, std::string_view secret_access_key,
+        std::string_view host, std::string_view canonical_uri, std::string_view method,
+        std::optional<std::string_view> orig_datestamp, std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
+        const std::vector<temporary_buffer<char>>* body_content, std::string_view region, std::string_view service, std::string_view query_string) {
+    hmac_sha256_digest signing_key;
+    return do_get_signature(host, canonical_uri, method, orig_datestamp, signed_headers_str, signed_headers_map, body_content, region, service, query_string,
+            [&] (std::string_view datestamp) -> const hmac_sha256_digest& {
+        signing_key = get_signing_key(secret_access_key, datestamp, region, service);
+        return signing_key;
+    });
+}
+
+std::string get_signature(const hmac_sha256_digest& signing_key, std::string_view datestamp,
+        std::string_view host, std::string_view canonical_uri, std::string_view method,
+        std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
+        const std::vector<temporary_buffer<char>>* body_content, std::string_view region, std::string_view service, std::string_view query_string) {
+    return do_get_signature(host, canonical_uri, method, datestamp, signed_headers_str, signed_headers_map, body_content, region, service, query_string,
+            [&] (std::string_view) -> const hmac_sha256_digest& {
+        return signing_key;
+    });
+}
+
 } // aws namespace
 } // utils namespace
@@ -36,6 +36,18 @@ std::string get_signature(std::string_view access_key_id, std::string_view secre
         std::optional<std::string_view> orig_datestamp, std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
         const std::vector<temporary_buffer<char>>* body_content, std::string_view region, std::string_view service, std::string_view query_string);
 
+// The signing key depends only on the secret, the date, the region and the
+// service, so it can be computed once with get_signing_key() and then used
+// to verify the signatures of all requests with the same credential scope.
+// The datestamp is that of the credential scope, and X-Amz-Date is checked
+// to match it (and not to be expired) as with an orig_datestamp above.
+hmac_sha256_digest get_signing_key(std::string_view secret_access_key, std::string_view datestamp, std::string_view region, std::string_view service);
+
+std::string get_signature(const hmac_sha256_digest& signing_key, std::string_view datestamp,
+        std::string_view host, std::string_view canonical_uri, std::string_view method,
+        std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
+        const std::vector<temporary_buffer<char>>* body_content, std::string_view region, std::string_view service, std::string_view query_string);
+
 // Convenience alias not to pass obscure nullptr argument to get_signature()
 static inline constexpr std::vector<temporary_buffer<char>>* unsigned_content = nullptr;
 // Same for datestamp checking
@@ -61,6 +61,30 @@ bool bloom_filter::is_present(hashed_key key) {
     return result;
 }
 
+void bloom_filter::prefetch(hashed_key key) {
+    for_each_index(key, _hash_count, _bitset.size(), _format, [this] (auto i) {
+        _bitset.prefetch(i);
+        return stop_iteration::no;
+    });
+}
+
+void bloom_filter::is_present(std::span<const hashed_key> keys, std::span<bool> results) {
+    // Checking a key is a chain of dependent cache misses, one per hash
+    // function, and is dominated by memory latency rather than by
+    // computation. Issue the loads for a group of keys up front, so that
+    // their misses are served in parallel, and only then test the bits.
+    static constexpr size_t group_size = 8;
+    for (size_t begin = 0; begin < keys.size(); begin += group_size) {
+        auto end = std::min(begin + group_size, keys.size());
+        for (size_t i = begin; i < end; ++i) {
+            prefetch(keys[i]);
+        }
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = is_present(keys[i]);
+        }
+    }
+}
+
 void bloom_filter::add(const bytes_view& key) {
     for_each_index(make_hashed_key(key), _hash_count, _bitset.size(), _format, [this] (auto i) {
         _bitset.set(i);
@@ -72,6 +96,56 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+// Maps the key to a block using one half of the hash, and to the bits
+// within the block using the other half, by double hashing.
+template<typename Func>
+void for_each_blocked_index(hashed_key hk, int count, int64_t max, filter_format format, Func&& func) {
+    auto h = hk.hash();
+    uint64_t block_hash = (format == filter_format::k_l_format) ? h[0] : h[1];
+    uint64_t bit_hash = (format == filter_format::k_l_format) ? h[1] : h[0];
+    uint64_t block_start = (block_hash % (max / blocked_bloom_filter::block_bits)) * blocked_bloom_filter::block_bits;
+    uint32_t base = bit_hash;
+    // Odd, so that the probes don't cycle through a subset of the block.
+    uint32_t inc = (bit_hash >> 32) | 1;
+    for (int i = 0; i < count; i++) {
+        if (func(block_start + (base % blocked_bloom_filter::block_bits)) == stop_iteration::yes) {
+            break;
+        }
+        base += inc;
+    }
+}
+
+bool blocked_bloom_filter::is_present(hashed_key key) {
+    bool result = true;
+    for_each_blocked_index(key, _hash_count, _bitset.size(), _format, [this, &result] (auto i) {
+        if (!_bitset.test(i)) {
+            result = false;
+            return stop_iteration::yes;
+        }
+        return stop_iteration::no;
+    });
+    return result;
+}
+
+void blocked_bloom_filter::prefetch(hashed_key key) {
+    // All the probes are in the same cache line.
+    for_each_blocked_index(key, 1, _bitset.size(), _format, [this] (auto i) {
+        _bitset.prefetch(i);
+        return stop_iteration::yes;
+    });
+}
+
+void blocked_bloom_filter::add(const bytes_view& key) {
+    for_each_blocked_index(make_hashed_key(key), _hash_count, _bitset.size(), _format, [this] (auto i) {
+        _bitset.set(i);
+        return stop_iteration::no;
+    });
+}
+
+bool blocked_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
@@ -82,5 +156,22 @@ filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter
     large_bitset bitset(num_bits);
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
+
+filter_ptr create_blocked_filter(int hash, large_bitset&& bitset, filter_format format) {
+    if (bitset.size() < blocked_bloom_filter::block_bits || bitset.size() % blocked_bloom_filter::block_bits) {
+        throw std::invalid_argument(seastar::format("Blocked bloom filter size {} is not a multiple of {} bits", bitset.size(), blocked_bloom_filter::block_bits));
+    }
+    return std::make_unique<blocked_bloom_filter>(hash, std::move(bitset), format);
+}
+
+filter_ptr create_blocked_filter(int hash, int64_t num_elements, int buckets_per, filter_format format) {
+    // Confining the probes to a block makes the fill rate of the blocks
+    // uneven, which raises the false positive rate. An extra bucket per
+    // element more than compensates for that.
+    int64_t num_bits = (num_elements * (buckets_per + 1)) + bloom_calculations::EXCESS;
+    num_bits = align_up<int64_t>(num_bits, blocked_bloom_filter::block_bits);
+    large_bitset bitset(num_bits);
+    return std::make_unique<blocked_bloom_filter>(hash, std::move(bitset), format);
+}
 }
 }
@@ -21,7 +21,7 @@ class bloom_filter: public i_filter {
 public:
     using bitmap = large_bitset;
 
-private:
+protected:
     bitmap _bitset;
     int _hash_count;
     filter_format _format;
@@ -34,6 +34,7 @@ class bloom_filter: public i_filter {
 public:
     int num_hashes() { return _hash_count; }
     bitmap& bits() { return _bitset; }
+    virtual filter_layout layout() const { return filter_layout::classic; }
 
     bloom_filter(int hashes, bitmap&& bs, filter_format format) noexcept;
     ~bloom_filter() noexcept;
@@ -44,6 +45,10 @@ class bloom_filter: public i_filter {
 
     virtual bool is_present(hashed_key key) override;
 
+    virtual void is_present(std::span<const hashed_key> keys, std::span<bool> results) override;
+
+    virtual void prefetch(hashed_key key) override;
+
     virtual void clear() override {
         _bitset.clear();
     }
@@ -66,6 +71,34 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// A bloom filter which maps all the probes of a key into a single block of
+// block_bits, sized to be a cache line, instead of over the whole bitset.
+// The bits are stored the same way as in the classic filter, only the
+// mapping of keys to bits differs, so the layout must be known when
+// loading the filter.
+class blocked_bloom_filter: public bloom_filter {
+public:
+    static constexpr size_t block_bits = 512;
+
+    blocked_bloom_filter(int hashes, bitmap&& bs, filter_format format) noexcept
+        : bloom_filter(hashes, std::move(bs), format)
+    {}
+
+    virtual filter_layout layout() const override { return filter_layout::blocked; }
+
+    virtual void add(const bytes_view& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void is_present(std::span<const hashed_key> keys, std::span<bool> results) override {
+        bloom_filter::is_present(keys, results);
+    }
+
+    virtual void prefetch(hashed_key key) override;
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -76,6 +109,10 @@ struct always_present_filter: public i_filter {
         return true;
     }
 
+    virtual void is_present(std::span<const hashed_key> keys, std::span<bool> results) override {
+        std::fill_n(results.begin(), keys.size(), true);
+    }
+
     virtual void add(const bytes_view& key) override { }
 
     virtual void clear() override { }
@@ -89,5 +126,7 @@ struct always_present_filter: public i_filter {
 
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+filter_ptr create_blocked_filter(int hash, large_bitset&& bitset, filter_format format);
+filter_ptr create_blocked_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
 }
 }
@@ -11,6 +11,7 @@
 #include <boost/intrusive/parent_from_member.hpp>
 #include <seastar/util/defer.hh>
 #include <cassert>
+#include <type_traits>
 #include <vector>
 #include "utils/allocation_strategy.hh"
 #include "utils/collection-concepts.hh"
@@ -964,11 +965,6 @@ class node final {
 
     using node_or_data = node_or_data_or_tree;
 
-    [[no_unique_address]] utils::neat_id<Debug == with_debug::yes> id;
-
-    unsigned short _num_keys;
-    unsigned short _flags;
-
     static const unsigned short NODE_ROOT       = 0x1;
     static const unsigned short NODE_LEAF       = 0x2;
     static const unsigned short NODE_LEFTMOST   = 0x4; // leaf with smallest keys in the tree
@@ -1002,7 +998,16 @@ class node final {
      * at index 0 for the non-leaf node.
      */
 
-    maybe_key<Key, Less> _keys[NodeSize];
+    /*
+     * The SIMD searcher scans the whole _keys array regardless of the
+     * number of keys in it, so the array is put at the very beginning
+     * of the node and the node is cache-line aligned. This way the 16
+     * int64 keys of a memtable or row cache node take exactly two lines.
+     */
+    static constexpr bool simd_search = std::is_same_v<Key, int64_t> && Search != key_search::binary && SimpleLessCompare<Key, Less>;
+    static constexpr size_t keys_alignment = simd_search ? 64 : alignof(maybe_key<Key, Less>);
+
+    alignas(keys_alignment) maybe_key<Key, Less> _keys[NodeSize];
     node_or_data _kids[NodeSize + 1];
 
     // Type-aliases for code-reading convenience
@@ -1032,6 +1037,11 @@ class node final {
         tree* _rightmost_tree;
     };
 
+    [[no_unique_address]] utils::neat_id<Debug == with_debug::yes> id;
+
+    unsigned short _num_keys;
+    unsigned short _flags;
+
     node* get_next() const noexcept {
         assert(is_leaf());
         return __next;
@@ -1781,7 +1791,7 @@ class node final {
     }
 
 public:
-    explicit node() noexcept : _num_keys(0) , _flags(0) , _parent(nullptr) { }
+    explicit node() noexcept : _parent(nullptr) , _num_keys(0) , _flags(0) { }
 
     ~node() {
         assert(_num_keys == 0);
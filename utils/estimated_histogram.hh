@@ -353,6 +353,84 @@ inline time_estimated_histogram time_estimated_histogram_merge(time_estimated_hi
     return a.merge(b);
 }
 
+/*!
+ * \brief a sliding window over an approx_exponential_histogram
+ *
+ * Values are added to the current window. Queries look at the current and
+ * the previous window, so they reflect between one and two windows worth of
+ * the most recent values, as opposed to a decayed all-time histogram which
+ * reacts slowly to a change in the distribution.
+ */
+template<typename Histogram, typename Clock>
+class windowed_histogram {
+public:
+    using duration = typename Clock::duration;
+    using time_point = typename Clock::time_point;
+private:
+    duration _window;
+    time_point _window_start;
+    Histogram _current;
+    Histogram _previous;
+private:
+    void maybe_rotate(time_point now) {
+        if (now - _window_start < _window) {
+            return;
+        }
+        if (now - _window_start < 2 * _window) {
+            _previous = _current;
+        } else {
+            _previous.clear();
+        }
+        _current.clear();
+        _window_start = now;
+    }
+public:
+    windowed_histogram(duration window, time_point now)
+        : _window(window)
+        , _window_start(now)
+    { }
+
+    void add(uint64_t n, time_point now) {
+        maybe_rotate(now);
+        _current.add(n);
+    }
+
+    /*!
+     * \brief returns the number of values in the window
+     */
+    uint64_t count(time_point now) {
+        maybe_rotate(now);
+        return _current.count() + _previous.count();
+    }
+
+    /*!
+     * \brief get a quantile of the values in the window
+     *
+     * Same as approx_exponential_histogram::quantile() of the union of
+     * the current and the previous window.
+     */
+    uint64_t quantile(float quantile, time_point now) {
+        if (quantile < 0 || quantile > 1.0) {
+            throw std::runtime_error("Invalid quantile value " + std::to_string(quantile) + ". Value should be between 0 and 1");
+        }
+        auto c = count(now);
+        if (!c) {
+            return 0;
+        }
+        auto pcount = uint64_t(std::floor(c * quantile));
+        uint64_t elements = 0;
+        for (size_t i = 0; i < _current.size() - 2; i++) {
+            if (auto n = _current.get(i) + _previous.get(i)) {
+                elements += n;
+                if (elements >= pcount) {
+                    return _current.get_bucket_lower_limit(i);
+                }
+            }
+        }
+        return _current.get_bucket_lower_limit(_current.size() - 1);
+    }
+};
+
 struct estimated_histogram {
     using clock = std::chrono::steady_clock;
     using duration = clock::duration;
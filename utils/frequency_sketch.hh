@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+// Approximate access frequency of keys (a count-min sketch), as used by
+// TinyLFU style cache admission.
+//
+// Each key maps to one counter in each of `depth` rows, and its estimate
+// is the smallest of them. Counters saturate at max_frequency. Once the
+// number of recorded accesses reaches ten times the width, all counters
+// are halved, so that estimates follow recent history rather than the
+// whole lifetime of the sketch.
+class frequency_sketch {
+public:
+    static constexpr unsigned depth = 4;
+    static constexpr uint8_t max_frequency = 15;
+private:
+    std::vector<uint8_t> _counters;
+    size_t _mask;
+    size_t _sample_size;
+    size_t _samples = 0;
+private:
+    size_t index(uint64_t hash, unsigned row) const noexcept {
+        static constexpr uint64_t seeds[depth] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL,
+        };
+        uint64_t h = (hash + seeds[row]) * 0x9e3779b97f4a7c15ULL;
+        h ^= h >> 32;
+        return row * (_mask + 1) + (h & _mask);
+    }
+    void age() noexcept {
+        for (auto& c : _counters) {
+            c >>= 1;
+        }
+        _samples /= 2;
+    }
+public:
+    // The width is rounded up to a power of two.
+    explicit frequency_sketch(size_t width)
+        : _counters(depth * std::bit_ceil(std::max<size_t>(width, 1)))
+        , _mask(std::bit_ceil(std::max<size_t>(width, 1)) - 1)
+        , _sample_size(10 * (_mask + 1))
+    { }
+
+    // Records an access to the key with the given hash.
+    // Returns true iff the counters were aged (halved) as a result.
+    bool record(uint64_t hash) noexcept {
+        bool added = false;
+        for (unsigned row = 0; row < depth; ++row) {
+            auto& c = _counters[index(hash, row)];
+            if (c < max_frequency) {
+                ++c;
+                added = true;
+            }
+        }
+        if (added && ++_samples >= _sample_size) {
+            age();
+            return true;
+        }
+        return false;
+    }
+
+    unsigned estimate(uint64_t hash) const noexcept {
+        unsigned f = max_frequency;
+        for (unsigned row = 0; row < depth; ++row) {
+            f = std::min<unsigned>(f, _counters[index(hash, row)]);
+        }
+        return f;
+    }
+};
+
+}
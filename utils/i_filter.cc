@@ -16,7 +16,7 @@
 namespace utils {
 static logging::logger filterlog("bloom_filter");
 
-filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat) {
+filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat, filter_layout layout) {
     assert(seastar::thread::running_in_thread());
 
     if (max_false_pos_probability > 1.0) {
@@ -29,6 +29,9 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
 
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
+    if (layout == filter_layout::blocked) {
+        return filter::create_blocked_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
+    }
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <span>
+
 #include "bytes.hh"
 
 namespace utils {
@@ -21,6 +23,16 @@ enum class filter_format {
     m_format,
 };
 
+enum class filter_layout {
+    // Cassandra compatible: the probes of a key are spread over the
+    // whole bitset, costing about one cache miss per hash function.
+    classic,
+    // All probes of a key fall into a single 512-bit block, so a
+    // check costs a single cache miss, at the price of a slightly
+    // higher false positive rate for the same number of bits.
+    blocked,
+};
+
 class hashed_key {
 private:
     std::array<uint64_t, 2> _hash;
@@ -39,6 +51,23 @@ struct i_filter {
     virtual void add(const bytes_view& key) = 0;
     virtual bool is_present(const bytes_view& key) = 0;
     virtual bool is_present(hashed_key) = 0;
+    /**
+     * Checks all given keys at once, setting results[i] to whether keys[i]
+     * may be present. The implementation is free to overlap the memory
+     * accesses of the individual checks, so this is cheaper than calling
+     * is_present() for each key when there are many keys to check.
+     */
+    virtual void is_present(std::span<const hashed_key> keys, std::span<bool> results) {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            results[i] = is_present(keys[i]);
+        }
+    }
+    /**
+     * Starts bringing the parts of the filter needed to check the given key
+     * into cache, so that checking several filters for the same key can
+     * overlap their cache misses instead of paying for them one by one.
+     */
+    virtual void prefetch(hashed_key) {}
     virtual void clear() = 0;
     virtual void close() = 0;
 
@@ -51,6 +80,7 @@ struct i_filter {
      *         Asserts that the given probability can be satisfied using this
      *         filter.
      */
-    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format);
+    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format,
+            filter_layout layout = filter_layout::classic);
 };
 }
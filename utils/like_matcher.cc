@@ -9,10 +9,12 @@
 
 
 #include "like_matcher.hh"
+#include "utils/utf8.hh"
 
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -75,33 +77,121 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// Shapes of patterns which are matched without the regex engine.
+enum class pattern_shape {
+    general, // Needs the regex.
+    exact,   // literal
+    prefix,  // literal%
+    suffix,  // %literal
+    infix,   // %literal%
+    any,     // %
+};
+
+/// Recognizes patterns which are a literal with optional '%' wildcards at its ends. Stores the
+/// unescaped literal in \c literal.
+///
+/// Wildcards and the escape character are ASCII, and bytes of multi-byte UTF-8 characters are never
+/// ASCII, so the pattern can be scanned byte by byte. For the same reason, the literal matches a part
+/// of a valid UTF-8 text exactly when its bytes do.
+pattern_shape shape_of(bytes_view pattern, bytes& literal) {
+    literal = bytes();
+    if (!utils::utf8::validate(pattern)) {
+        return pattern_shape::general; // Let the regex conversion report the error.
+    }
+    // Literal characters, and nullopt for an unescaped '%'.
+    std::vector<std::optional<int8_t>> tokens;
+    tokens.reserve(pattern.size());
+    bool escaping = false;
+    for (const int8_t c : pattern) {
+        if (escaping) {
+            tokens.emplace_back(c);
+            escaping = false;
+        } else if (c == '\\') {
+            escaping = true;
+        } else if (c == '_') {
+            return pattern_shape::general;
+        } else if (c == '%') {
+            tokens.emplace_back(std::nullopt);
+        } else {
+            tokens.emplace_back(c);
+        }
+    }
+    if (escaping) {
+        tokens.emplace_back('\\'); // A trailing backslash matches itself.
+    }
+    auto begin = tokens.begin();
+    auto end = tokens.end();
+    while (begin != end && !*begin) {
+        ++begin;
+    }
+    if (begin == end) {
+        return tokens.empty() ? pattern_shape::exact : pattern_shape::any;
+    }
+    const bool leading_wildcard = begin != tokens.begin();
+    while (!*(end - 1)) {
+        --end;
+    }
+    const bool trailing_wildcard = end != tokens.end();
+    literal = bytes(bytes::initialized_later(), end - begin);
+    auto out = literal.begin();
+    for (auto i = begin; i != end; ++i) {
+        if (!*i) {
+            return pattern_shape::general;
+        }
+        *out++ = **i;
+    }
+    if (leading_wildcard) {
+        return trailing_wildcard ? pattern_shape::infix : pattern_shape::suffix;
+    }
+    return trailing_wildcard ? pattern_shape::prefix : pattern_shape::exact;
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    pattern_shape _shape;
+    bytes _literal; // The literal part of the pattern, unless _shape is general.
+    boost::u32regex _re; // Performs pattern matching of general patterns.
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
   private:
-    void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+    void compile() {
+        _shape = shape_of(_pattern, _literal);
+        if (_shape == pattern_shape::general) {
+            _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        }
     }
 };
 
 like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
-    init_re();
+    compile();
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
+    switch (_shape) {
+    case pattern_shape::exact:
+        return text == bytes_view(_literal);
+    case pattern_shape::prefix:
+        return text.starts_with(bytes_view(_literal));
+    case pattern_shape::suffix:
+        return text.ends_with(bytes_view(_literal));
+    case pattern_shape::infix:
+        return text.find(bytes_view(_literal)) != bytes_view::npos;
+    case pattern_shape::any:
+        return true;
+    case pattern_shape::general:
+        break;
+    }
     return boost::u32regex_match(text.begin(), text.end(), _re);
 }
 
 void like_matcher::impl::reset(bytes_view pattern) {
     if (pattern != _pattern) {
         _pattern = bytes(pattern);
-        init_re();
+        compile();
     }
 }
 
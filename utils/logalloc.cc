@@ -36,6 +36,7 @@
 #include "utils/coarse_steady_clock.hh"
 
 #include <random>
+#include <cstring>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -398,23 +399,45 @@ static thread_local tracker& tracker_instance = get_tracker_instance();
 
 using clock = std::chrono::steady_clock;
 
+// Runs in the background reclaim scheduling group and does two jobs:
+//  - keeps free memory of the system allocator above free_memory_threshold,
+//    with shares proportional to the shortage,
+//  - while there is no such shortage, but segments can no longer be allocated
+//    from the system allocator, keeps the free segment reserve of the segment
+//    pool topped up at idle priority, so that allocating a segment doesn't
+//    have to compact synchronously.
+// With the seastar allocator, the first job keeps enough system memory free
+// for new segments, so the second one only matters when allocation outpaces
+// it, or when segments come from a bounded pool of the standard allocator.
 class background_reclaimer {
     scheduling_group _sg;
     noncopyable_function<void (size_t target)> _reclaim;
+    noncopyable_function<size_t ()> _reserve_deficit;
+    // Returns false if no progress was made.
+    noncopyable_function<bool ()> _refill_reserve;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
     future<> _done;
     bool _stopping = false;
+    // Set when refilling the reserve made no progress, so that the main loop
+    // doesn't spin on it. Cleared by the adjust_shares timer.
+    bool _refill_stalled = false;
     static constexpr size_t free_memory_threshold = 60'000'000;
 private:
-    bool have_work() const {
+    bool have_memory_work() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
         return memory::free_memory() < free_memory_threshold;
 #else
         return false;
 #endif
     }
+    bool have_reserve_work() const {
+        return !_refill_stalled && _reserve_deficit();
+    }
+    bool have_work() const {
+        return have_memory_work() || have_reserve_work();
+    }
     void main_loop_wake() {
         llogger.debug("background_reclaimer::main_loop_wake: waking {}", bool(_main_loop_wait));
         if (_main_loop_wait) {
@@ -436,14 +459,20 @@ class background_reclaimer {
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::free_memory());
+            if (have_memory_work()) {
+                _reclaim(free_memory_threshold - memory::free_memory());
+            } else if (!_refill_reserve()) {
+                _refill_stalled = true;
+            }
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
     }
     void adjust_shares() {
+        _refill_stalled = false;
         if (have_work()) {
-            auto shares = 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold;
+            // Refilling the reserve is only an optimization, so it runs at idle priority.
+            auto shares = have_memory_work() ? 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold : 1;
             _sg.set_shares(shares);
             llogger.trace("background_reclaimer::adjust_shares: {}", shares);
             if (_main_loop_wait) {
@@ -452,9 +481,12 @@ class background_reclaimer {
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim,
+            noncopyable_function<size_t ()> reserve_deficit, noncopyable_function<bool ()> refill_reserve)
             : _sg(sg)
             , _reclaim(std::move(reclaim))
+            , _reserve_deficit(std::move(reserve_deficit))
+            , _refill_reserve(std::move(refill_reserve))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
@@ -502,7 +534,9 @@ class tracker::impl {
     ~impl();
     future<> stop() {
         if (_background_reclaimer) {
-            return _background_reclaimer->stop();
+            return _background_reclaimer->stop().then([this] {
+                _background_reclaimer.reset();
+            });
         } else {
             return make_ready_future<>();
         }
@@ -527,6 +561,10 @@ class tracker::impl {
     // will be at least reserve_segments + div_ceil(bytes, segment::size).
     // Returns the amount by which segment_pool.total_memory_in_use() has decreased.
     size_t compact_and_evict(size_t reserve_segments, size_t bytes, is_preemptible p);
+    // Compacts, and evicts if needed, until the segment pool holds the background
+    // reserve of free segments, or until preempted.
+    // Returns true if the number of free segments has grown.
+    bool refill_background_reserve();
     void full_compaction();
     void reclaim_all_free_segments();
     occupancy_stats global_occupancy() const noexcept;
@@ -539,12 +577,7 @@ class tracker::impl {
     // Abort on allocation failure from LSA
     void enable_abort_on_bad_alloc() noexcept { _abort_on_bad_alloc = true; }
     bool should_abort_on_bad_alloc() const noexcept { return _abort_on_bad_alloc; }
-    void setup_background_reclaim(scheduling_group sg) {
-        assert(!_background_reclaimer);
-        _background_reclaimer.emplace(sg, [this] (size_t target) {
-            reclaim(target, is_preemptible::yes);
-        });
-    }
+    void setup_background_reclaim(scheduling_group sg);
     // const bool&, so interested parties can save a reference and see updates.
     const bool& sanitizer_report_backtrace() const { return _sanitizer_report_backtrace; }
     void set_sanitizer_report_backtrace(bool rb) { _sanitizer_report_backtrace = rb; }
@@ -648,6 +681,7 @@ struct alignas(segment_size) segment {
 };
 
 static constexpr size_t max_managed_object_size = segment_size * 0.1;
+static constexpr size_t huge_page_size = 2 * 1024 * 1024;
 static constexpr auto max_used_space_ratio_for_compaction = 0.85;
 static constexpr size_t max_used_space_for_compaction = segment_size * max_used_space_ratio_for_compaction;
 static constexpr size_t min_free_space_for_compaction = segment_size - max_used_space_for_compaction;
@@ -749,6 +783,20 @@ class segment_store_backend {
     virtual void* alloc_segment_memory() noexcept = 0;
     virtual void free_segment_memory(void* seg) noexcept = 0;
     virtual size_t free_memory() const noexcept = 0;
+    // Asks the kernel to back the segment area with transparent huge pages.
+    // Returns the number of bytes advised, 0 on failure.
+    size_t advise_huge_pages() const noexcept {
+        auto start = align_up(_segments_base, huge_page_size);
+        auto end = align_down(_layout.end, huge_page_size);
+        if (start >= end) {
+            return 0;
+        }
+        if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE)) {
+            llogger.warn("Failed to advise huge pages for LSA segments: {}", std::strerror(errno));
+            return 0;
+        }
+        return end - start;
+    }
     bool can_allocate_more_segments(size_t non_lsa_reserve) const noexcept {
         if (_freed_segment_increases_general_memory_availability) {
             return free_memory() >= non_lsa_reserve + segment::size;
@@ -888,6 +936,9 @@ class contiguous_memory_segment_store {
     bool can_allocate_more_segments() const noexcept {
         return _backend->can_allocate_more_segments(non_lsa_reserve);
     }
+    size_t advise_huge_pages() const noexcept {
+        return _backend->advise_huge_pages();
+    }
 };
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
 using segment_store = contiguous_memory_segment_store;
@@ -990,6 +1041,13 @@ class segment_store {
         auto i = find_empty();
         return i != _segments.end();
     }
+    size_t advise_huge_pages() const noexcept {
+        if (_delegate_store) {
+            return _delegate_store->advise_huge_pages();
+        }
+        // Segments are scattered over the standard allocator's memory.
+        return 0;
+    }
 };
 #endif
 
@@ -1009,6 +1067,8 @@ class segment_pool {
     size_t _free_segments = 0;
     size_t _current_emergency_reserve_goal = 1;
     size_t _emergency_reserve_max = 30;
+    size_t _background_reserve_goal = 0;
+    size_t _huge_page_advised_bytes = 0;
     bool _allocation_failure_flag = false;
     bool _allocation_enabled = true;
 
@@ -1061,6 +1121,7 @@ class segment_pool {
         return _allocation_enabled && _store.can_allocate_more_segments();
     }
     bool compact_segment(segment* seg);
+    bool reclaim_on_demand(size_t reserve);
 public:
     explicit segment_pool(logalloc::tracker::impl& tracker);
     logalloc::tracker::impl& tracker() { return _tracker; }
@@ -1085,6 +1146,25 @@ class segment_pool {
     void set_emergency_reserve_max(size_t new_size) noexcept { _emergency_reserve_max = new_size; }
     size_t emergency_reserve_max() const noexcept { return _emergency_reserve_max; }
     void set_current_emergency_reserve_goal(size_t goal) noexcept { _current_emergency_reserve_goal = goal; }
+    void set_background_reserve_goal(size_t goal) noexcept { _background_reserve_goal = goal; }
+    void advise_huge_pages() noexcept;
+    size_t huge_page_advised_bytes() const noexcept { return _huge_page_advised_bytes; }
+    // Number of huge pages holding at least one segment owned by LSA, a measure
+    // of how many TLB entries are needed to cover LSA memory.
+    size_t huge_pages_spanned() const noexcept;
+    // Free segments the background reclaimer is expected to add to the pool.
+    // While new segments can be allocated from the system allocator, there is
+    // nothing to gain from compacting in advance.
+    size_t background_reserve_deficit() const noexcept {
+        if (!_background_reserve_goal || can_allocate_more_segments()) {
+            return 0;
+        }
+        auto goal = _current_emergency_reserve_goal + _background_reserve_goal;
+        return goal - std::min(goal, _free_segments);
+    }
+    size_t background_reserve_goal() const noexcept {
+        return _current_emergency_reserve_goal + _background_reserve_goal;
+    }
     void clear_allocation_failure_flag() noexcept { _allocation_failure_flag = false; }
     bool allocation_failure_flag() const noexcept { return _allocation_failure_flag; }
     void refill_emergency_reserve();
@@ -1124,6 +1204,7 @@ class segment_pool {
     inline void on_memory_allocation(size_t size) noexcept;
     inline void on_memory_deallocation(size_t size) noexcept;
     inline void on_memory_eviction(size_t size) noexcept;
+    void on_background_reserve_refill(size_t segments) noexcept { _stats.background_reserve_refills += segments; }
     size_t unreserved_free_segments() const noexcept { return _free_segments - std::min(_free_segments, _emergency_reserve_max); }
     size_t free_segments() const noexcept { return _free_segments; }
 };
@@ -1307,6 +1388,7 @@ segment* segment_pool::allocate_segment(size_t reserve)
             _lsa_free_segments_bitmap.clear(free_idx);
             auto seg = segment_from_idx(free_idx);
             --_free_segments;
+            ++_stats.free_segment_hits;
             return seg;
         }
         if (can_allocate_more_segments()) {
@@ -1318,10 +1400,15 @@ segment* segment_pool::allocate_segment(size_t reserve)
             _lsa_owned_segments_bitmap.set(idx);
             return seg;
         }
-    } while (_tracker.compact_and_evict(reserve, _tracker.reclamation_step() * segment::size, is_preemptible::no));
+    } while (reclaim_on_demand(reserve));
     return nullptr;
 }
 
+bool segment_pool::reclaim_on_demand(size_t reserve) {
+    ++_stats.on_demand_reclaims;
+    return _tracker.compact_and_evict(reserve, _tracker.reclamation_step() * segment::size, is_preemptible::no);
+}
+
 void segment_pool::deallocate_segment(segment* seg) noexcept
 {
     assert(_lsa_owned_segments_bitmap.test(idx_from_segment(seg)));
@@ -1424,6 +1511,26 @@ void segment_pool::prime(size_t available_memory, size_t min_free_memory) {
     reclaim_segments(_store.non_lsa_reserve / segment::size, is_preemptible::no);
 }
 
+void segment_pool::advise_huge_pages() noexcept {
+    _huge_page_advised_bytes = _store.advise_huge_pages();
+    llogger.info("Advised {} MiB of LSA segment memory to be backed by huge pages", _huge_page_advised_bytes >> 20);
+}
+
+size_t segment_pool::huge_pages_spanned() const noexcept {
+    // Owned segments are found in address order, so pages are visited in order too.
+    size_t pages = 0;
+    auto last_page = std::numeric_limits<uintptr_t>::max();
+    for (auto idx = _lsa_owned_segments_bitmap.find_first_set(); idx != utils::dynamic_bitset::npos;
+            idx = _lsa_owned_segments_bitmap.find_next_set(idx)) {
+        auto page = reinterpret_cast<uintptr_t>(segment_from_idx(idx)) / huge_page_size;
+        if (page != last_page) {
+            ++pages;
+            last_page = page;
+        }
+    }
+    return pages;
+}
+
 void segment_pool::use_standard_allocator_segment_pool_backend(size_t available_memory) {
     if (_segments_in_use) {
         throw std::runtime_error("cannot change segment store backend after segments are in use");
@@ -2365,6 +2472,10 @@ void tracker::configure(const config& cfg) {
     }
 
     _impl->set_reclamation_step(cfg.lsa_reclamation_step);
+    _impl->segment_pool().set_background_reserve_goal(cfg.background_reserve_segments);
+    if (cfg.transparent_huge_pages) {
+        _impl->segment_pool().advise_huge_pages();
+    }
     if (cfg.abort_on_lsa_bad_alloc) {
         _impl->enable_abort_on_bad_alloc();
     }
@@ -2676,6 +2787,33 @@ size_t tracker::impl::compact_and_evict(size_t reserve_segments, size_t memory_t
     return compact_and_evict_locked(reserve_segments, memory_to_release, preempt);
 }
 
+void tracker::impl::setup_background_reclaim(scheduling_group sg) {
+    assert(!_background_reclaimer);
+    _background_reclaimer.emplace(sg, [this] (size_t target) {
+        reclaim(target, is_preemptible::yes);
+    }, [this] {
+        return _segment_pool->background_reserve_deficit();
+    }, [this] {
+        return refill_background_reserve();
+    });
+}
+
+bool tracker::impl::refill_background_reserve() {
+    if (_reclaiming_disabled_depth) {
+        return false;
+    }
+    reclaiming_lock rl(*this);
+    auto before = _segment_pool->free_segments();
+    // compact_and_evict_locked() leaves the released segments in the pool.
+    compact_and_evict_locked(_segment_pool->background_reserve_goal(), 0, is_preemptible::yes);
+    auto after = _segment_pool->free_segments();
+    if (after <= before) {
+        return false;
+    }
+    _segment_pool->on_background_reserve_refill(after - before);
+    return true;
+}
+
 size_t tracker::impl::compact_and_evict_locked(size_t reserve_segments, size_t memory_to_release, is_preemptible preempt) {
     llogger.debug("compact_and_evict_locked({}, {}, {})", reserve_segments, memory_to_release, int(bool(preempt)));
     //
@@ -2857,6 +2995,21 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
 
         sm::make_counter("memory_freed", [this] { return _segment_pool->statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_gauge("huge_page_advised_bytes", [this] { return _segment_pool->huge_page_advised_bytes(); },
+                       sm::description("Holds the amount of LSA segment memory advised to be backed by transparent huge pages.")),
+
+        sm::make_gauge("huge_pages_spanned", [this] { return _segment_pool->huge_pages_spanned(); },
+                       sm::description("Holds the number of 2 MiB pages holding at least one LSA segment.")),
+
+        sm::make_counter("free_segment_hits", [this] { return _segment_pool->statistics().free_segment_hits; },
+                        sm::description("Counts segment allocations served from the free segments of the segment pool.")),
+
+        sm::make_counter("on_demand_reclaims", [this] { return _segment_pool->statistics().on_demand_reclaims; },
+                        sm::description("Counts synchronous compactions and evictions needed to allocate a segment.")),
+
+        sm::make_counter("background_reserve_refills", [this] { return _segment_pool->statistics().background_reserve_refills; },
+                        sm::description("Counts free segments added to the segment pool in advance by the background reclaimer.")),
     });
 }
 
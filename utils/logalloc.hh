@@ -64,6 +64,14 @@ class tracker {
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
         scheduling_group background_reclaim_sched_group;
+        // Number of free segments, above the emergency reserve, which the background
+        // reclaimer keeps in the segment pool by compacting in advance, so that segment
+        // allocation doesn't have to compact once system memory runs out. 0 disables.
+        size_t background_reserve_segments = 0;
+        // Advise the kernel to back segment memory with transparent huge pages.
+        // With the seastar allocator segments share the shard's memory area, so
+        // this applies to the whole area.
+        bool transparent_huge_pages = false;
     };
 
     struct stats {
@@ -74,6 +82,9 @@ class tracker {
         uint64_t memory_compacted;
         uint64_t memory_evicted;
         uint64_t num_allocations;
+        uint64_t free_segment_hits;
+        uint64_t on_demand_reclaims;
+        uint64_t background_reserve_refills;
 
         friend stats operator+(const stats& s1, const stats& s2) {
             stats result(s1);
@@ -93,6 +104,9 @@ class tracker {
             memory_compacted += other.memory_compacted;
             memory_evicted += other.memory_evicted;
             num_allocations += other.num_allocations;
+            free_segment_hits += other.free_segment_hits;
+            on_demand_reclaims += other.on_demand_reclaims;
+            background_reserve_refills += other.background_reserve_refills;
             return *this;
         }
         stats& operator-=(const stats& other) {
@@ -103,6 +117,9 @@ class tracker {
             memory_compacted -= other.memory_compacted;
             memory_evicted -= other.memory_evicted;
             num_allocations -= other.num_allocations;
+            free_segment_hits -= other.free_segment_hits;
+            on_demand_reclaims -= other.on_demand_reclaims;
+            background_reserve_refills -= other.background_reserve_refills;
             return *this;
         }
     };
@@ -124,6 +124,22 @@ class lru {
         add(e);
     }
 
+    // Returns the element which would be evicted next, or nullptr if there is none.
+    evictable* least_recently_used() noexcept {
+        return _list.empty() ? nullptr : &_list.front();
+    }
+
+    // Returns the element which was used last, or nullptr if there is none.
+    evictable* most_recently_used() noexcept {
+        return _list.empty() ? nullptr : &_list.back();
+    }
+
+    // Returns the element used right before e, or nullptr if e is the least recently used one.
+    evictable* less_recently_used(evictable& e) noexcept {
+        auto i = _list.iterator_to(e);
+        return i == _list.begin() ? nullptr : &*std::prev(i);
+    }
+
     // Evicts a single element from the LRU
     template <bool Shallow = false>
     reclaiming_result do_evict(bool should_evict_index) noexcept {
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <array>
+#include <span>
 
 #include "bytes.hh"
 
@@ -153,6 +154,13 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Computes hash3_x64_128() of each of `keys` into the corresponding element of `results`.
+//
+// Hashing a key is a long chain of dependent multiplications, which leaves most of
+// the execution units idle. Hashing several keys in lock-step interleaves their
+// chains, so it is cheaper than hashing the keys one by one.
+void hash3_x64_128(std::span<const bytes_view> keys, uint64_t seed, std::span<std::array<uint64_t, 2>> results);
+
 } // namespace murmur_hash
 
 } // namespace utils
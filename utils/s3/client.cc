@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <deque>
 #include <initializer_list>
 #include <memory>
 #include <stdexcept>
@@ -17,6 +18,7 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <seastar/core/align.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
@@ -172,7 +174,7 @@ client::group_client& client::find_or_create_client() {
         // Limit the maximum number of connections this group's http client
         // may have proportional to its shares. Shares are typically in the
         // range of 100...1000, thus resulting in 1..10 connections
-        auto max_connections = std::max((unsigned)(sg.get_shares() / 100), 1u);
+        auto max_connections = _cfg->max_connections.value_or(std::max((unsigned)(sg.get_shares() / 100), 1u));
         it = _https.emplace(std::piecewise_construct,
             std::forward_as_tuple(sg),
             std::forward_as_tuple(std::move(factory), max_connections)
@@ -463,6 +465,9 @@ class client::upload_sink_base : public data_sink_impl {
     utils::chunked_vector<sstring> _part_etags;
     gate _bg_flushes;
     std::optional<tag> _tag;
+    // Upload rate of a single part, averaged over the recently uploaded parts,
+    // 0 until the first part completes
+    double _part_throughput = 0;
 
     future<> start_upload();
     future<> finalize_upload();
@@ -644,7 +649,10 @@ future<> client::upload_sink_base::upload_part(memory_data_sink_buffers bufs) {
         auto etag = rep.get_header("ETag");
         s3l.trace("uploaded {} part data -> etag = {} (upload id {})", part_number, etag, _upload_id);
         _part_etags[part_number] = std::move(etag);
-        gc.write_stats.update(size, s3_clock::now() - start);
+        auto lat = std::chrono::duration<double>(s3_clock::now() - start);
+        gc.write_stats.update(size, lat);
+        auto throughput = size / std::max(lat.count(), 0.001);
+        _part_throughput = _part_throughput == 0 ? throughput : (_part_throughput * 3 + throughput) / 4;
         return make_ready_future<>();
     }).handle_exception([this, part_number] (auto ex) {
         // ... the exact exception only remains in logs
@@ -698,21 +706,37 @@ future<> client::upload_sink_base::close() {
     }
 }
 
+// Parts start at minimum_part_size and grow up to the size that takes about
+// target_part_duration to upload at the rate observed so far, so that fast
+// links don't pay the per-request overhead for every few megabytes. Parts are
+// limited to a quarter of the free client memory so that several of them can
+// be in flight at once, and, when the size of the object is known, to the
+// size that still splits the object into min_parallel_parts of them.
 class client::upload_sink final : public client::upload_sink_base {
-    // "Each part must be at least 5 MB in size, except the last part."
-    // https://docs.aws.amazon.com/AmazonS3/latest/API/API_UploadPart.html
-    static constexpr size_t minimum_part_size = 5 << 20;
+    static constexpr size_t maximum_part_size = 64 << 20;
+    static constexpr size_t part_size_alignment = 1 << 20;
+    static constexpr std::chrono::duration<double> target_part_duration = std::chrono::seconds(1);
+    static constexpr unsigned min_parallel_parts = 8;
 
+    const size_t _max_part_size;
     memory_data_sink_buffers _bufs;
+
+    size_t part_size() const noexcept {
+        auto size = std::min<size_t>(_part_throughput * target_part_duration.count(), _max_part_size);
+        size = std::min<size_t>(size, std::max<ssize_t>(_client->_memory.available_units(), 0) / 4);
+        return std::max(align_up(size, part_size_alignment), minimum_part_size);
+    }
+
     future<> maybe_flush() {
-        if (_bufs.size() >= minimum_part_size) {
+        if (_bufs.size() >= part_size()) {
             co_await upload_part(std::move(_bufs));
         }
     }
 
 public:
-    upload_sink(shared_ptr<client> cln, sstring object_name, std::optional<tag> tag = {})
+    upload_sink(shared_ptr<client> cln, sstring object_name, std::optional<tag> tag = {}, std::optional<uint64_t> size_hint = {})
         : upload_sink_base(std::move(cln), std::move(object_name), std::move(tag))
+        , _max_part_size(size_hint ? std::clamp<uint64_t>(*size_hint / min_parallel_parts, minimum_part_size, maximum_part_size) : maximum_part_size)
     {}
 
     virtual future<> put(temporary_buffer<char> buf) override {
@@ -795,9 +819,6 @@ future<> client::upload_sink_base::upload_part(std::unique_ptr<upload_sink> piec
 }
 
 class client::upload_jumbo_sink final : public upload_sink_base {
-    // "Part numbers can be any number from 1 to 10,000, inclusive."
-    // https://docs.aws.amazon.com/AmazonS3/latest/API/API_UploadPart.html
-    static constexpr unsigned aws_maximum_parts_in_piece = 10000;
     static constexpr tag piece_tag = { .key = "kind", .value = "piece" };
 
     const unsigned _maximum_parts_in_piece;
@@ -846,19 +867,37 @@ class client::upload_jumbo_sink final : public upload_sink_base {
     }
 };
 
-data_sink client::make_upload_sink(sstring object_name) {
-    return data_sink(std::make_unique<upload_sink>(shared_from_this(), std::move(object_name)));
+data_sink client::make_upload_sink(sstring object_name, std::optional<uint64_t> size_hint) {
+    return data_sink(std::make_unique<upload_sink>(shared_from_this(), std::move(object_name), std::nullopt, size_hint));
 }
 
 data_sink client::make_upload_jumbo_sink(sstring object_name, std::optional<unsigned> max_parts_per_piece) {
     return data_sink(std::make_unique<upload_jumbo_sink>(shared_from_this(), std::move(object_name), max_parts_per_piece));
 }
 
+// Sequential reads of the file are served from ranged GETs issued ahead
+// of the reader, up to max_read_ahead of them in flight at a time. Each
+// read-ahead range is as long as the read that triggered it and claims its
+// memory from the client's pool for as long as it is queued. When the pool
+// is short on memory no read-ahead is issued, readers never wait for it.
 class client::readable_file : public file_impl {
+    static constexpr unsigned max_read_ahead = 8;
+
     shared_ptr<client> _client;
     sstring _object_name;
     std::optional<stats> _stats;
 
+    struct read_ahead_range {
+        uint64_t off;
+        size_t len;
+        future<temporary_buffer<char>> data;
+        semaphore_units<> units;
+    };
+    std::deque<read_ahead_range> _read_ahead;
+    uint64_t _next_pos = std::numeric_limits<uint64_t>::max();
+    unsigned _sequential_reads = 0;
+    gate _read_ahead_gate;
+
     [[noreturn]] void unsupported() {
         throw_with_backtrace<std::logic_error>("unsupported operation on s3 readable file");
     }
@@ -874,6 +913,63 @@ class client::readable_file : public file_impl {
         });
     }
 
+    future<temporary_buffer<char>> fetch(uint64_t off, size_t len, gate::holder) {
+        co_return co_await _client->get_object_contiguous(_object_name, range{ off, len });
+    }
+
+    void drop_read_ahead() noexcept {
+        for (auto& ra : _read_ahead) {
+            // The fetch keeps the gate held, close() waits for it
+            (void)std::move(ra.data).then_wrapped([units = std::move(ra.units)] (auto f) {
+                f.ignore_ready_future();
+            });
+        }
+        _read_ahead.clear();
+    }
+
+    void maybe_read_ahead(size_t len) {
+        auto depth = std::min(_sequential_reads, max_read_ahead);
+        auto end = _read_ahead.empty() ? _next_pos : _read_ahead.back().off + _read_ahead.back().len;
+        while (_read_ahead.size() < depth && end < _stats->size) {
+            auto ra_len = std::min<uint64_t>(len, _stats->size - end);
+            auto units = try_get_units(_client->_memory, ra_len);
+            if (!units) {
+                break;
+            }
+            s3l.trace("Read ahead {} bytes at {} of {}", ra_len, end, _object_name);
+            auto data = fetch(end, ra_len, _read_ahead_gate.hold());
+            _read_ahead.push_back(read_ahead_range{ end, ra_len, std::move(data), std::move(*units) });
+            end += ra_len;
+        }
+    }
+
+    future<temporary_buffer<char>> read(uint64_t pos, size_t len) {
+        co_await maybe_update_stats();
+        if (pos >= _stats->size) {
+            co_return temporary_buffer<char>();
+        }
+
+        len = std::min<uint64_t>(len, _stats->size - pos);
+        _sequential_reads = pos == _next_pos ? _sequential_reads + 1 : 0;
+        _next_pos = pos + len;
+
+        std::optional<read_ahead_range> ra;
+        if (!_read_ahead.empty() && _read_ahead.front().off == pos && _read_ahead.front().len == len) {
+            ra.emplace(std::move(_read_ahead.front()));
+            _read_ahead.pop_front();
+        } else {
+            drop_read_ahead();
+        }
+        if (_sequential_reads > 0) {
+            maybe_read_ahead(len);
+        }
+
+        if (ra) {
+            co_return co_await std::move(ra->data);
+        }
+        co_return co_await _client->get_object_contiguous(_object_name, range{ pos, len });
+    }
+
 public:
     readable_file(shared_ptr<client> cln, sstring object_name)
         : _client(std::move(cln))
@@ -932,23 +1028,13 @@ class client::readable_file : public file_impl {
     }
 
     virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent*) override {
-        co_await maybe_update_stats();
-        if (pos >= _stats->size) {
-            co_return 0;
-        }
-
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ pos, len });
+        auto buf = co_await read(pos, len);
         std::copy_n(buf.get(), buf.size(), reinterpret_cast<uint8_t*>(buffer));
         co_return buf.size();
     }
 
     virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override {
-        co_await maybe_update_stats();
-        if (pos >= _stats->size) {
-            co_return 0;
-        }
-
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ pos, utils::iovec_len(iov) });
+        auto buf = co_await read(pos, utils::iovec_len(iov));
         uint64_t off = 0;
         for (auto& v : iov) {
             auto sz = std::min(v.iov_len, buf.size() - off);
@@ -962,17 +1048,13 @@ class client::readable_file : public file_impl {
     }
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent*) override {
-        co_await maybe_update_stats();
-        if (offset >= _stats->size) {
-            co_return temporary_buffer<uint8_t>();
-        }
-
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ offset, range_size });
+        auto buf = co_await read(offset, range_size);
         co_return temporary_buffer<uint8_t>(reinterpret_cast<uint8_t*>(buf.get_write()), buf.size(), buf.release());
     }
 
     virtual future<> close() override {
-        return make_ready_future<>();
+        drop_read_ahead();
+        return _read_ahead_gate.close();
     }
 };
 
@@ -72,6 +72,12 @@ class client : public enable_shared_from_this<client> {
 
     struct private_tag {};
 
+    // "Each part must be at least 5 MB in size, except the last part."
+    // "Part numbers can be any number from 1 to 10,000, inclusive."
+    // https://docs.aws.amazon.com/AmazonS3/latest/API/API_UploadPart.html
+    static constexpr size_t minimum_part_size = 5 << 20;
+    static constexpr unsigned aws_maximum_parts_in_piece = 10000;
+
     future<semaphore_units<>> claim_memory(size_t mem);
 
     void authorize(http::request&);
@@ -95,8 +101,14 @@ class client : public enable_shared_from_this<client> {
     future<> put_object(sstring object_name, ::memory_data_sink_buffers bufs);
     future<> delete_object(sstring object_name);
 
+    // Objects up to that size are guaranteed to fit into the upload of make_upload_sink(),
+    // bigger ones need make_upload_jumbo_sink()
+    static constexpr uint64_t upload_sink_max_object_size = uint64_t(aws_maximum_parts_in_piece) * minimum_part_size;
+
     file make_readable_file(sstring object_name);
-    data_sink make_upload_sink(sstring object_name);
+    // The size_hint is the expected size of the object, if known. It's only used
+    // to pick the size of the parts
+    data_sink make_upload_sink(sstring object_name, std::optional<uint64_t> size_hint = {});
     data_sink make_upload_jumbo_sink(sstring object_name, std::optional<unsigned> max_parts_per_piece = {});
 
     void update_config(endpoint_config_ptr);
@@ -31,6 +31,10 @@ struct endpoint_config {
 
     std::optional<aws_config> aws;
 
+    // the maximum number of connections to the endpoint per scheduling group,
+    // by default it's proportional to the group's shares
+    std::optional<unsigned> max_connections;
+
     std::strong_ordering operator<=> (const endpoint_config& o) const = default;
 };
 
@@ -0,0 +1,567 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/align.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "utils/s3/disk_cache.hh"
+#include "utils/lister.hh"
+#include "utils/xx_hasher.hh"
+#include "log.hh"
+
+namespace s3 {
+
+static logging::logger dcl("s3_disk_cache");
+
+// The layout of an object file: the header, the object name and the bitmap
+// of the blocks which are present, padded to the dma alignment, then the
+// blocks at their offsets in the object. Blocks which are not present are
+// holes.
+struct object_header {
+    uint64_t magic;
+    uint64_t object_size;
+    uint32_t header_size;
+    uint32_t name_size;
+};
+
+static constexpr uint64_t object_magic = 0x314a424f33535343; // "CSS3OBJ1"
+static constexpr size_t dma_alignment = 4096;
+static constexpr size_t max_concurrent_fills = 16;
+static constexpr size_t max_concurrent_loads = 16;
+
+static uint64_t block_count(uint64_t object_size) noexcept {
+    return (object_size + disk_cache::block_size - 1) / disk_cache::block_size;
+}
+
+static size_t bitmap_offset(size_t name_size) noexcept {
+    return sizeof(object_header) + name_size;
+}
+
+sstring disk_cache::file_name(std::string_view object_name) {
+    xx_hasher h;
+    h.update(object_name.data(), object_name.size());
+    return format("{:016x}.obj", h.finalize_uint64());
+}
+
+disk_cache::object::object(sstring name_, sstring file_name_, uint64_t size_)
+    : name(std::move(name_))
+    , file_name(std::move(file_name_))
+    , size(size_)
+{
+    auto header_size = align_up(bitmap_offset(name.size()) + (block_count(size) + 7) / 8, dma_alignment);
+    header = temporary_buffer<char>::aligned(dma_alignment, header_size);
+    std::memset(header.get_write(), 0, header_size);
+    object_header h{
+        .magic = object_magic,
+        .object_size = size,
+        .header_size = uint32_t(header_size),
+        .name_size = uint32_t(name.size()),
+    };
+    std::memcpy(header.get_write(), &h, sizeof(h));
+    std::memcpy(header.get_write() + sizeof(h), name.data(), name.size());
+}
+
+disk_cache::disk_cache(std::filesystem::path dir, uint64_t capacity)
+    : _dir(std::move(dir))
+    , _capacity(capacity)
+    , _fill_sem(max_concurrent_fills)
+{
+    register_metrics();
+}
+
+void disk_cache::register_metrics() {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("s3_disk_cache", {
+        sm::make_counter("hits", [this] { return _stats.hits; },
+                sm::description("Total number of reads of object blocks served from the local disk cache")),
+        sm::make_counter("misses", [this] { return _stats.misses; },
+                sm::description("Total number of reads of object blocks not found in the local disk cache")),
+        sm::make_counter("read_bytes", [this] { return _stats.read_bytes; },
+                sm::description("Total number of bytes read from the local disk cache")),
+        sm::make_counter("fills", [this] { return _stats.fills; },
+                sm::description("Total number of object blocks written to the local disk cache")),
+        sm::make_counter("failed_fills", [this] { return _stats.failed_fills; },
+                sm::description("Total number of object blocks which failed to be written to the local disk cache")),
+        sm::make_counter("evictions", [this] { return _stats.evictions; },
+                sm::description("Total number of object blocks evicted from the local disk cache")),
+        sm::make_gauge("objects", [this] { return _stats.objects; },
+                sm::description("Number of objects with blocks in the local disk cache")),
+        sm::make_gauge("blocks", [this] { return _stats.blocks; },
+                sm::description("Number of object blocks in the local disk cache")),
+        sm::make_gauge("used_bytes", [this] { return _stats.used_bytes; },
+                sm::description("Disk space used by the local disk cache")),
+    });
+}
+
+lw_shared_ptr<disk_cache::object> disk_cache::find(const sstring& object_name) const {
+    auto it = _objects.find(file_name(object_name));
+    if (it == _objects.end() || it->second->name != object_name) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void disk_cache::add_object(lw_shared_ptr<object> obj) {
+    _stats.used_bytes += obj->header_size();
+    ++_stats.objects;
+    auto name = obj->file_name;
+    _objects.emplace(std::move(name), std::move(obj));
+}
+
+void disk_cache::add_block(object& obj, uint64_t index) {
+    auto b = std::make_unique<block>(block{
+        .obj = obj,
+        .index = index,
+        .disk_size = align_up<uint64_t>(obj.block_data_size(index), dma_alignment),
+    });
+    _lru.push_back(*b);
+    _stats.used_bytes += b->disk_size;
+    ++_stats.blocks;
+    obj.blocks.emplace(index, std::move(b));
+    evict();
+}
+
+void disk_cache::remove_block(block& b) noexcept {
+    auto& obj = b.obj;
+    auto index = b.index;
+    _lru.erase(_lru.iterator_to(b));
+    _stats.used_bytes -= b.disk_size;
+    --_stats.blocks;
+    obj.blocks.erase(index);
+    if (_gate.is_closed()) {
+        // The block stays on disk and is found again after a restart.
+        return;
+    }
+    // The data is discarded in the background. Until then, the block can't
+    // be filled again.
+    obj.busy.insert(index);
+    (void)with_gate(_gate, [this, obj = obj.shared_from_this(), index] () mutable {
+        return discard_block(std::move(obj), index);
+    });
+}
+
+future<> disk_cache::write_header_bit(object& obj, uint64_t index, bool present) {
+    auto units = co_await get_units(obj.header_sem, 1);
+    auto pos = bitmap_offset(obj.name.size()) + index / 8;
+    auto mask = char(1 << (index % 8));
+    if (present) {
+        obj.header.get_write()[pos] |= mask;
+    } else {
+        obj.header.get_write()[pos] &= ~mask;
+    }
+    // Only the page holding the bit is written.
+    auto page = align_down(pos, dma_alignment);
+    auto written = co_await obj.f->dma_write(page, obj.header.get() + page, dma_alignment);
+    if (written != dma_alignment) {
+        throw std::runtime_error("short write");
+    }
+}
+
+future<> disk_cache::discard_block(lw_shared_ptr<object> obj, uint64_t index) {
+    auto holder = obj->ops.hold();
+    try {
+        // The block is marked as absent before its data is dropped, so that
+        // a crash in between doesn't leave a hole marked as data.
+        co_await write_header_bit(*obj, index, false);
+        co_await obj->f->discard(obj->data_offset(index), align_up<uint64_t>(obj->block_data_size(index), dma_alignment));
+    } catch (...) {
+        dcl.warn("Failed to discard block {} of {} from {}: {}", index, obj->name, path(obj->file_name), std::current_exception());
+    }
+    obj->busy.erase(index);
+    maybe_drop(*obj);
+}
+
+void disk_cache::maybe_drop(object& obj) noexcept {
+    if (_gate.is_closed() || obj.dropped || obj.loading || !obj.blocks.empty() || !obj.busy.empty()) {
+        return;
+    }
+    auto ptr = obj.shared_from_this();
+    ptr->dropped = true;
+    _stats.used_bytes -= ptr->header_size();
+    --_stats.objects;
+    _objects.erase(ptr->file_name);
+    // The file name can't be reused until the file is removed.
+    _busy.insert(ptr->file_name);
+    (void)with_gate(_gate, [this, ptr = std::move(ptr)] () mutable {
+        return drop(std::move(ptr));
+    });
+}
+
+future<> disk_cache::drop(lw_shared_ptr<object> obj) {
+    co_await obj->ops.close();
+    if (obj->f) {
+        try {
+            co_await obj->f->close();
+            co_await remove_file(path(obj->file_name).native());
+        } catch (...) {
+            dcl.warn("Failed to remove {}: {}", path(obj->file_name), std::current_exception());
+        }
+    }
+    _busy.erase(obj->file_name);
+}
+
+void disk_cache::evict() noexcept {
+    auto it = _lru.begin();
+    while (it != _lru.end() && _stats.used_bytes > _capacity) {
+        auto& b = *it++;
+        if (b.readers) {
+            continue;
+        }
+        remove_block(b);
+        ++_stats.evictions;
+    }
+}
+
+future<> disk_cache::load(sstring name) {
+    auto p = path(name);
+    if (!name.ends_with(".obj")) {
+        // A leftover of an older layout of the cache.
+        co_return co_await remove_file(p.native());
+    }
+    auto f = co_await open_file_dma(p.native(), open_flags::rw);
+    lw_shared_ptr<object> obj;
+    std::exception_ptr ex;
+    try {
+        auto buf = co_await f.dma_read_bulk<char>(0, dma_alignment);
+        object_header h;
+        if (buf.size() < sizeof(h)) {
+            throw std::runtime_error("truncated header");
+        }
+        std::memcpy(&h, buf.get(), sizeof(h));
+        if (h.magic != object_magic || bitmap_offset(h.name_size) > h.header_size) {
+            throw std::runtime_error("invalid header");
+        }
+        if (h.header_size > buf.size()) {
+            buf = co_await f.dma_read_bulk<char>(0, h.header_size);
+            if (buf.size() < h.header_size) {
+                throw std::runtime_error("truncated header");
+            }
+        }
+        auto object_name = sstring(buf.get() + sizeof(h), h.name_size);
+        if (file_name(object_name) != name) {
+            throw std::runtime_error("file name doesn't match the header");
+        }
+        obj = make_lw_shared<object>(std::move(object_name), name, h.object_size);
+        if (obj->header_size() != h.header_size) {
+            throw std::runtime_error("invalid header");
+        }
+        std::memcpy(obj->header.get_write(), buf.get(), h.header_size);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        co_await f.close();
+        dcl.warn("Removing invalid cache file {}: {}", p, ex);
+        co_return co_await remove_file(p.native());
+    }
+    obj->f = std::move(f);
+    add_object(obj);
+    obj->loading = true;
+    auto bitmap = obj->header.get() + bitmap_offset(obj->name.size());
+    for (uint64_t i = 0; i < block_count(obj->size); ++i) {
+        if (bitmap[i / 8] & (1 << (i % 8))) {
+            add_block(*obj, i);
+        }
+        co_await coroutine::maybe_yield();
+    }
+    obj->loading = false;
+    maybe_drop(*obj);
+}
+
+future<> disk_cache::start() {
+    co_await recursive_touch_directory(_dir.native());
+    std::vector<sstring> names;
+    co_await lister::scan_dir(_dir, lister::dir_entry_types::of<directory_entry_type::regular>(), [&names] (fs::path, directory_entry de) {
+        names.push_back(std::move(de.name));
+        return make_ready_future<>();
+    });
+    co_await max_concurrent_for_each(names, max_concurrent_loads, [this] (sstring& name) {
+        return load(std::move(name)).handle_exception([] (std::exception_ptr ep) {
+            dcl.warn("Failed to load cached object: {}", ep);
+        });
+    });
+    dcl.info("Loaded {} cached blocks of {} objects ({} bytes) from {}", _stats.blocks, _stats.objects, _stats.used_bytes, _dir);
+}
+
+future<> disk_cache::stop() {
+    co_await _gate.close();
+    for (auto& [name, obj] : _objects) {
+        if (obj->f) {
+            co_await obj->f->close();
+        }
+    }
+    _metrics.clear();
+}
+
+future<std::optional<temporary_buffer<char>>> disk_cache::read(const sstring& object_name, uint64_t index, size_t offset, size_t len) {
+    auto obj = find(object_name);
+    block* bp = nullptr;
+    if (obj && !_gate.is_closed()) {
+        if (auto it = obj->blocks.find(index); it != obj->blocks.end()) {
+            bp = it->second.get();
+        }
+    }
+    if (!bp) {
+        ++_stats.misses;
+        co_return std::nullopt;
+    }
+    auto& b = *bp;
+    _lru.erase(_lru.iterator_to(b));
+    _lru.push_back(b);
+    auto size = obj->block_data_size(index);
+    if (offset >= size) {
+        ++_stats.hits;
+        co_return temporary_buffer<char>();
+    }
+    len = std::min(len, size - offset);
+
+    auto holder = _gate.hold();
+    ++b.readers;
+    std::optional<temporary_buffer<char>> ret;
+    try {
+        auto start = obj->data_offset(index) + offset;
+        auto aligned_start = align_down(start, dma_alignment);
+        auto aligned_end = align_up(start + len, dma_alignment);
+        auto buf = co_await obj->f->dma_read_bulk<char>(aligned_start, aligned_end - aligned_start);
+        if (buf.size() < start + len - aligned_start) {
+            throw std::runtime_error("short read");
+        }
+        buf.trim_front(start - aligned_start);
+        buf.trim(len);
+        ret = std::move(buf);
+    } catch (...) {
+        dcl.warn("Failed to read cached block {} of {} from {}: {}", index, object_name, path(obj->file_name), std::current_exception());
+    }
+    --b.readers;
+    if (!ret) {
+        // Served from the object store instead.
+        if (!b.readers) {
+            remove_block(b);
+        }
+        ++_stats.misses;
+        co_return std::nullopt;
+    }
+    ++_stats.hits;
+    _stats.read_bytes += ret->size();
+    co_return ret;
+}
+
+future<> disk_cache::create(object& obj) {
+    auto p = path(obj.file_name);
+    auto f = co_await open_file_dma(p.native(), open_flags::rw | open_flags::create | open_flags::truncate);
+    std::exception_ptr ex;
+    try {
+        auto written = co_await f.dma_write(0, obj.header.get(), obj.header_size());
+        if (written != obj.header_size()) {
+            throw std::runtime_error("short write");
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        co_await f.close();
+        co_await remove_file(p.native());
+        std::rethrow_exception(ex);
+    }
+    obj.f = std::move(f);
+}
+
+future<> disk_cache::fill(lw_shared_ptr<object> obj, uint64_t index, temporary_buffer<char> data, semaphore_units<> units) {
+    auto holder = obj->ops.hold();
+    bool filled = false;
+    try {
+        if (!obj->f) {
+            co_await create(*obj);
+        }
+        auto disk_size = align_up(data.size(), dma_alignment);
+        auto buf = temporary_buffer<char>::aligned(dma_alignment, disk_size);
+        std::copy_n(data.get(), data.size(), buf.get_write());
+        std::memset(buf.get_write() + data.size(), 0, disk_size - data.size());
+        auto written = co_await obj->f->dma_write(obj->data_offset(index), buf.get(), disk_size);
+        if (written != disk_size) {
+            throw std::runtime_error("short write");
+        }
+        // The data is written before the block is marked as present, so that
+        // a crash in between doesn't leave a hole marked as data.
+        co_await write_header_bit(*obj, index, true);
+        filled = true;
+    } catch (...) {
+        ++_stats.failed_fills;
+        dcl.warn("Failed to cache block {} of {}: {}", index, obj->name, std::current_exception());
+    }
+    obj->busy.erase(index);
+    if (filled) {
+        ++_stats.fills;
+        add_block(*obj, index);
+    } else {
+        maybe_drop(*obj);
+    }
+}
+
+void disk_cache::insert(const sstring& object_name, uint64_t object_size, uint64_t index, temporary_buffer<char> data) {
+    if (_gate.is_closed() || index >= block_count(object_size)
+            || data.size() != std::min<uint64_t>(block_size, object_size - index * block_size)) {
+        return;
+    }
+    auto name = file_name(object_name);
+    lw_shared_ptr<object> obj;
+    if (auto it = _objects.find(name); it != _objects.end()) {
+        obj = it->second;
+        // Objects hashing to the file name of another one are not cached,
+        // and neither are other blocks of an object whose file is being created.
+        if (obj->name != object_name || obj->size != object_size || !obj->f
+                || obj->blocks.contains(index) || obj->busy.contains(index)) {
+            return;
+        }
+    } else if (_busy.contains(name)) {
+        return;
+    }
+    // Fills are best effort, if the disk can't keep up, blocks are not cached.
+    auto units = try_get_units(_fill_sem, 1);
+    if (!units) {
+        return;
+    }
+    if (!obj) {
+        obj = make_lw_shared<object>(object_name, std::move(name), object_size);
+        if (obj->header_size() + block_size > _capacity) {
+            return;
+        }
+        add_object(obj);
+    }
+    obj->busy.insert(index);
+    (void)with_gate(_gate, [this, obj = std::move(obj), index, data = std::move(data), units = std::move(*units)] () mutable {
+        return fill(std::move(obj), index, std::move(data), std::move(units));
+    });
+}
+
+class disk_cached_file_impl : public file_impl {
+    file _f;
+    disk_cache& _cache;
+    sstring _object_name;
+    std::optional<uint64_t> _size;
+
+    future<uint64_t> object_size() {
+        if (!_size) {
+            _size = co_await _f.size();
+        }
+        co_return *_size;
+    }
+
+    // Reads [pos, pos + len) block by block, each from the cache if it's
+    // there, otherwise the whole block from the object store.
+    future<temporary_buffer<char>> read_range(uint64_t pos, size_t len) {
+        auto size = co_await object_size();
+        if (pos >= size) {
+            co_return temporary_buffer<char>();
+        }
+        len = std::min<uint64_t>(len, size - pos);
+        auto ret = temporary_buffer<char>::aligned(_memory_dma_alignment, len);
+        size_t done = 0;
+        while (done < len) {
+            auto index = (pos + done) / disk_cache::block_size;
+            auto offset = (pos + done) % disk_cache::block_size;
+            auto n = std::min(len - done, disk_cache::block_size - offset);
+            auto cached = co_await _cache.read(_object_name, index, offset, n);
+            if (!cached) {
+                auto block_start = index * disk_cache::block_size;
+                auto block = co_await _f.dma_read_bulk<char>(block_start, std::min<uint64_t>(disk_cache::block_size, size - block_start));
+                auto data = block.share(std::min(offset, block.size()), std::min(n, block.size() - std::min(offset, block.size())));
+                _cache.insert(_object_name, size, index, std::move(block));
+                cached = std::move(data);
+            }
+            if (cached->empty()) {
+                break;
+            }
+            std::copy_n(cached->get(), cached->size(), ret.get_write() + done);
+            done += cached->size();
+            if (cached->size() < n) {
+                break;
+            }
+        }
+        ret.trim(done);
+        co_return ret;
+    }
+
+    [[noreturn]] void unsupported() {
+        throw_with_backtrace<std::logic_error>("unsupported operation on cached s3 file");
+    }
+public:
+    disk_cached_file_impl(file f, disk_cache& cache, sstring object_name)
+        : file_impl(*get_file_impl(f))
+        , _f(std::move(f))
+        , _cache(cache)
+        , _object_name(std::move(object_name))
+    {
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent*) override { unsupported(); }
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override { unsupported(); }
+    virtual future<> truncate(uint64_t length) override { unsupported(); }
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override { unsupported(); }
+
+    virtual future<> flush(void) override { return make_ready_future<>(); }
+    virtual future<> allocate(uint64_t position, uint64_t length) override { return make_ready_future<>(); }
+    virtual future<> discard(uint64_t offset, uint64_t length) override { return make_ready_future<>(); }
+
+    // The handle is used to open the object on other shards, with the
+    // cache of their own.
+    virtual std::unique_ptr<file_handle_impl> dup() override {
+        return get_file_impl(_f)->dup();
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return object_size();
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return _f.stat();
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent*) override {
+        auto buf = co_await read_range(pos, len);
+        std::copy_n(buf.get(), buf.size(), reinterpret_cast<char*>(buffer));
+        co_return buf.size();
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override {
+        size_t len = 0;
+        for (auto& v : iov) {
+            len += v.iov_len;
+        }
+        auto buf = co_await read_range(pos, len);
+        size_t off = 0;
+        for (auto& v : iov) {
+            auto sz = std::min(v.iov_len, buf.size() - off);
+            if (sz == 0) {
+                break;
+            }
+            std::copy_n(buf.get() + off, sz, reinterpret_cast<char*>(v.iov_base));
+            off += sz;
+        }
+        co_return off;
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent*) override {
+        auto buf = co_await read_range(offset, range_size);
+        co_return temporary_buffer<uint8_t>(reinterpret_cast<uint8_t*>(buf.get_write()), buf.size(), buf.release());
+    }
+
+    virtual future<> close() override {
+        return _f.close();
+    }
+};
+
+file disk_cache::wrap(file f, sstring object_name) {
+    return file(make_shared<disk_cached_file_impl>(std::move(f), *this, std::move(object_name)));
+}
+
+} // s3 namespace
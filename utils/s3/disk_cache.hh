@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/intrusive/list.hpp>
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include "seastarx.hh"
+
+namespace s3 {
+
+// A persistent cache of blocks of objects on local disk, placed in front
+// of client::readable_file, so that reads of hot parts of objects don't
+// turn into ranged GETs.
+//
+// Objects are split into blocks of block_size bytes. All cached blocks of
+// an object are kept in one sparse file, in the directory of the shard, at
+// the offset of the block in the object. The file starts with a header
+// naming the object and a bitmap of the blocks which are present, so the
+// cache survives restarts: start() rebuilds the index from the headers of
+// the files in the directory. Objects are immutable, so cached blocks never
+// need to be invalidated, those of deleted objects just age out.
+//
+// The total size of the cached blocks and headers is capped, least recently
+// used blocks are evicted first, by punching a hole in the file of their
+// object. The file is removed with the last block. Blocks are filled in the
+// background, after a miss was served from the object store.
+class disk_cache {
+public:
+    static constexpr size_t block_size = 128 * 1024;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t read_bytes = 0;
+        uint64_t fills = 0;
+        uint64_t failed_fills = 0;
+        uint64_t evictions = 0;
+        uint64_t objects = 0;
+        uint64_t blocks = 0;
+        uint64_t used_bytes = 0;
+    };
+private:
+    struct object;
+    struct block {
+        object& obj;
+        uint64_t index;
+        uint64_t disk_size;
+        // Blocks being read are not evicted, so that their data isn't
+        // discarded under the read.
+        unsigned readers = 0;
+        boost::intrusive::list_member_hook<> lru_link;
+    };
+    using lru_type = boost::intrusive::list<block,
+        boost::intrusive::member_hook<block, boost::intrusive::list_member_hook<>, &block::lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+
+    struct object : public enable_lw_shared_from_this<object> {
+        sstring name;
+        sstring file_name;
+        uint64_t size;
+        // Disengaged until the file is created.
+        std::optional<file> f;
+        // The header of the file, as on disk, including the bitmap of the
+        // blocks which are present.
+        temporary_buffer<char> header;
+        std::unordered_map<uint64_t, std::unique_ptr<block>> blocks;
+        // Blocks being filled or evicted.
+        std::unordered_set<uint64_t> busy;
+        // Serializes writes of the header, so that an older state of the
+        // bitmap never overwrites a newer one.
+        semaphore header_sem{1};
+        // Fills and evictions of the blocks of the object.
+        gate ops;
+        bool dropped = false;
+        // Set while load() adds the blocks found on disk.
+        bool loading = false;
+
+        object(sstring name, sstring file_name, uint64_t size);
+        uint64_t header_size() const noexcept {
+            return header.size();
+        }
+        uint64_t data_offset(uint64_t index) const noexcept {
+            return header_size() + index * block_size;
+        }
+        size_t block_data_size(uint64_t index) const noexcept {
+            return std::min<uint64_t>(block_size, size - index * block_size);
+        }
+    };
+
+    std::filesystem::path _dir;
+    uint64_t _capacity;
+    // Indexed by file name.
+    std::unordered_map<sstring, lw_shared_ptr<object>> _objects;
+    // Least recently used first.
+    lru_type _lru;
+    // Files being removed.
+    std::unordered_set<sstring> _busy;
+    semaphore _fill_sem;
+    gate _gate;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    static sstring file_name(std::string_view object_name);
+    std::filesystem::path path(const sstring& file_name) const {
+        return _dir / std::string_view(file_name);
+    }
+    lw_shared_ptr<object> find(const sstring& object_name) const;
+    void add_object(lw_shared_ptr<object> obj);
+    void add_block(object& obj, uint64_t index);
+    void remove_block(block& b) noexcept;
+    void maybe_drop(object& obj) noexcept;
+    void evict() noexcept;
+    future<> write_header_bit(object& obj, uint64_t index, bool present);
+    future<> discard_block(lw_shared_ptr<object> obj, uint64_t index);
+    future<> drop(lw_shared_ptr<object> obj);
+    future<> load(sstring file_name);
+    future<> create(object& obj);
+    future<> fill(lw_shared_ptr<object> obj, uint64_t index, temporary_buffer<char> data, semaphore_units<> units);
+    void register_metrics();
+public:
+    // Caches up to capacity bytes in dir.
+    disk_cache(std::filesystem::path dir, uint64_t capacity);
+
+    future<> start();
+    future<> stop();
+
+    // Returns the bytes [offset, offset + len) of the block if it is cached.
+    // The result is shorter if the block ends before.
+    future<std::optional<temporary_buffer<char>>> read(const sstring& object_name, uint64_t index, size_t offset, size_t len);
+
+    // Caches the data of the block of the object of the given size in the background.
+    void insert(const sstring& object_name, uint64_t object_size, uint64_t index, temporary_buffer<char> data);
+
+    // Returns a file reading the object through the cache.
+    file wrap(file f, sstring object_name);
+
+    const stats& get_stats() const {
+        return _stats;
+    }
+};
+
+} // s3 namespace
@@ -37,6 +37,8 @@
  * +--------------------+------------+-------------+------------+-------------+
  */
 
+#include <cstring>
+
 #include "utf8.hh"
 
 namespace utils {
@@ -143,6 +145,23 @@ validate_partial_naive(const uint8_t *data, size_t len) {
     return partial_validation_results{};
 }
 
+// Returns the length of the prefix of the data made of ASCII characters only,
+// in whole blocks. Text is mostly ASCII, and checking blocks for bytes with
+// the high bit set is much cheaper than the full validation.
+static inline size_t ascii_prefix_length(const uint8_t* data, size_t len) {
+    constexpr size_t block_size = 4 * sizeof(uint64_t);
+    constexpr uint64_t high_bits = 0x8080808080808080;
+    size_t pos = 0;
+    for (; pos + block_size <= len; pos += block_size) {
+        uint64_t block[4];
+        std::memcpy(block, data + pos, block_size);
+        if ((block[0] | block[1] | block[2] | block[3]) & high_bits) {
+            break;
+        }
+    }
+    return pos;
+}
+
 } // namespace utf8
 
 } // namespace utils
@@ -226,8 +245,9 @@ alignas(16) static const uint8_t s_range_adjust_tbl[] = {
 };
 
 // 2x ~ 4x faster than naive method
+static
 partial_validation_results
-internal::validate_partial(const uint8_t *data, size_t len) {
+validate_partial_vectorized(const uint8_t *data, size_t len) {
     if (len >= 16) {
         uint8x16_t prev_input = vdupq_n_u8(0);
         uint8x16_t prev_first_len = vdupq_n_u8(0);
@@ -413,8 +433,9 @@ alignas(16) static const int8_t s_ef_fe_tbl[] = {
 };
 
 // 5x faster than naive method
+static
 partial_validation_results
-internal::validate_partial(const uint8_t *data, size_t len) {
+validate_partial_vectorized(const uint8_t *data, size_t len) {
     if (len >= 16) {
         __m128i prev_input = _mm_set1_epi8(0);
         __m128i prev_first_len = _mm_set1_epi8(0);
@@ -550,16 +571,13 @@ namespace utils {
 
 namespace utf8 {
 
-namespace internal {
-
 // No SIMD implementation for this arch, fallback to naive method
+static
 partial_validation_results
-validate_partial(const uint8_t *data, size_t len) {
+validate_partial_vectorized(const uint8_t *data, size_t len) {
     return validate_partial_naive(data, len);
 }
 
-}
-
 } // namespace utf8
 
 } // namespace utils
@@ -570,6 +588,13 @@ namespace utils {
 
 namespace utf8 {
 
+partial_validation_results
+internal::validate_partial(const uint8_t *data, size_t len) {
+    // ASCII characters are complete code points, so the rest can be validated on its own.
+    auto ascii_len = ascii_prefix_length(data, len);
+    return validate_partial_vectorized(data + ascii_len, len - ascii_len);
+}
+
 bool validate(const uint8_t* data, size_t len) {
     auto pvr = validate_partial(data, len);
     return !pvr.error && !pvr.unvalidated_tail;
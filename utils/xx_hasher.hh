@@ -16,19 +16,41 @@
 #include <xxhash.h>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <array>
 
 class xx_hasher {
     static constexpr size_t digest_size = 16;
+    // Hashed objects, e.g. rows, are mostly fed as many small fields.
+    // They are gathered here and fed to xxhash in bulk, which is much
+    // cheaper than a call per field. The digest doesn't depend on how
+    // the input is split, so it stays the same.
+    static constexpr size_t buffer_size = 256;
     XXH64_state_t _state;
+    size_t _buffered = 0;
+    std::array<char, buffer_size> _buffer;
 
+    void flush() noexcept {
+        if (_buffered) {
+            XXH64_update(&_state, _buffer.data(), _buffered);
+            _buffered = 0;
+        }
+    }
 public:
     explicit xx_hasher(uint64_t seed = 0) noexcept {
         XXH64_reset(&_state, seed);
     }
 
     void update(const char* ptr, size_t length) noexcept {
-        XXH64_update(&_state, ptr, length);
+        if (length > buffer_size - _buffered) {
+            flush();
+            if (length >= buffer_size) {
+                XXH64_update(&_state, ptr, length);
+                return;
+            }
+        }
+        std::copy_n(ptr, length, _buffer.data() + _buffered);
+        _buffered += length;
     }
 
     bytes finalize() {
@@ -44,6 +66,7 @@ class xx_hasher {
     }
 
     uint64_t finalize_uint64() {
+        flush();
         return XXH64_digest(&_state);
     }
 
@@ -32,10 +32,6 @@ static constexpr uint64_t encode_zigzag(int64_t n) noexcept {
     return (static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63);
 }
 
-static constexpr int64_t decode_zigzag(uint64_t n) noexcept {
-    return static_cast<int64_t>((n >> 1) ^ -(n & 1));
-}
-
 // Mask for extracting from the first byte the part that is not used for indicating the total number of bytes.
 static uint64_t first_byte_value_mask(vint_size_type extra_bytes_size) {
     // Include the sentinel zero bit in the mask.
@@ -50,15 +46,6 @@ vint_size_type signed_vint::serialized_size(int64_t value) noexcept {
     return unsigned_vint::serialized_size(encode_zigzag(value));
 }
 
-int64_t signed_vint::deserialize(bytes_view v) {
-    const auto un = unsigned_vint::deserialize(v);
-    return decode_zigzag(un);
-}
-
-vint_size_type signed_vint::serialized_size_from_first_byte(bytes::value_type first_byte) {
-    return unsigned_vint::serialized_size_from_first_byte(first_byte);
-}
-
 // The number of additional bytes that we need to read.
 static vint_size_type count_extra_bytes(int8_t first_byte) {
     // Sign extension.
@@ -103,16 +90,11 @@ vint_size_type unsigned_vint::serialized_size(uint64_t value) noexcept {
     return vint_size_type(9) - vint_size_type((magnitude - 1) / 7);
 }
 
-uint64_t unsigned_vint::deserialize(bytes_view v) {
+uint64_t unsigned_vint::deserialize_multi_byte(bytes_view v) {
     auto src = v.data();
     auto len = v.size();
     const int8_t first_byte = *src;
 
-    // No additional bytes, since the most significant bit is not set.
-    if (first_byte >= 0) {
-        return uint64_t(first_byte);
-    }
-
     const auto extra_bytes_size = count_extra_bytes(first_byte);
 
     // Extract the bits not used for counting bytes.
@@ -139,8 +121,3 @@ uint64_t unsigned_vint::deserialize(bytes_view v) {
 #endif
     return result;
 }
-
-vint_size_type unsigned_vint::serialized_size_from_first_byte(bytes::value_type first_byte) {
-    int8_t first_byte_casted = first_byte;
-    return 1 + (first_byte_casted >= 0 ? 0 : count_extra_bytes(first_byte_casted));
-}
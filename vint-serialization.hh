@@ -34,6 +34,7 @@
 
 #include "bytes.hh"
 
+#include <bit>
 #include <cstdint>
 
 using vint_size_type = bytes::size_type;
@@ -47,9 +48,20 @@ struct unsigned_vint final {
 
     static vint_size_type serialize(value_type, bytes::iterator out);
 
-    static value_type deserialize(bytes_view v);
-
-    static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
+    static value_type deserialize(bytes_view v) {
+        // Most vints, e.g. lengths and timestamp deltas in sstables, fit in a single byte.
+        if (static_cast<int8_t>(v.front()) >= 0) [[likely]] {
+            return static_cast<uint8_t>(v.front());
+        }
+        return deserialize_multi_byte(v);
+    }
+
+    static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte) noexcept {
+        // The number of extra bytes is encoded as leading 1 bits.
+        return 1 + std::countl_one(static_cast<uint8_t>(first_byte));
+    }
+private:
+    static value_type deserialize_multi_byte(bytes_view v);
 };
 
 struct signed_vint final {
@@ -59,7 +71,13 @@ struct signed_vint final {
 
     static vint_size_type serialize(value_type, bytes::iterator out);
 
-    static value_type deserialize(bytes_view v);
+    static value_type deserialize(bytes_view v) {
+        const auto n = unsigned_vint::deserialize(v);
+        // Zig-zag decoding.
+        return static_cast<int64_t>((n >> 1) ^ -(n & 1));
+    }
 
-    static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
+    static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte) noexcept {
+        return unsigned_vint::serialized_size_from_first_byte(first_byte);
+    }
 };
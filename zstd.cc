@@ -7,11 +7,17 @@
  */
 
 #include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/alien.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/reactor.hh>
+#include <csignal>
+#include <thread>
 
 // We need to use experimental features of the zstd library (to allocate compression/decompression context),
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "zdict.h"
 
 #include "compress.hh"
 #include "exceptions/exceptions.hh"
@@ -19,13 +25,56 @@
 #include "utils/reusable_buffer.hh"
 #include <concepts>
 
+// Runs func on a new thread, so that it doesn't stall the reactor, and returns
+// its result on the calling shard. func must only touch memory owned by the caller,
+// which must be kept alive until the returned future resolves.
+template <std::invocable Func>
+requires std::is_nothrow_invocable_v<Func>
+static future<std::invoke_result_t<Func>> run_on_background_thread(Func func) {
+    using result_type = std::invoke_result_t<Func>;
+    promise<result_type> pr;
+    auto f = pr.get_future();
+    std::thread([func = std::move(func), &pr, &alien = engine().alien(), shard = this_shard_id()] () mutable {
+        // Signals are for the reactor threads to handle.
+        sigset_t mask;
+        sigfillset(&mask);
+        ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+        auto result = func();
+        alien::run_on(alien, shard, [&pr, result = std::move(result)] () mutable noexcept {
+            pr.set_value(std::move(result));
+        });
+    }).detach();
+    co_return co_await std::move(f);
+}
+
 static const sstring COMPRESSION_LEVEL = "compression_level";
+static const sstring DICTIONARY_SIZE_IN_KB = "dictionary_size_in_kb";
+// Not a user-settable option: the trained dictionary itself, persisted
+// in CompressionInfo along with the other options of the compressor.
+static const sstring DICTIONARY = "dictionary";
+// CompressionInfo stores option values as strings with a 16-bit length.
+static constexpr size_t MAX_DICTIONARY_SIZE_IN_KB = 63;
 static const sstring COMPRESSOR_NAME = compressor::namespace_prefix + "ZstdCompressor";
 static const size_t DCTX_SIZE = ZSTD_estimateDCtxSize();
 
 class zstd_processor : public compressor {
+    struct cdict_deleter {
+        void operator()(ZSTD_CDict* d) const noexcept { ZSTD_freeCDict(d); }
+    };
+    struct ddict_deleter {
+        void operator()(ZSTD_DDict* d) const noexcept { ZSTD_freeDDict(d); }
+    };
+
     int _compression_level = 3;
+    size_t _chunk_len;
+    size_t _dictionary_size = 0;
+    ZSTD_compressionParameters _cparams;
     size_t _cctx_size;
+    sstring _dictionary;
+    // Digested forms of _dictionary, built on first use, since readers
+    // only ever need the decompression one and writers the compression one.
+    mutable std::unique_ptr<ZSTD_CDict, cdict_deleter> _cdict;
+    mutable std::unique_ptr<ZSTD_DDict, ddict_deleter> _ddict;
 
     static auto with_dctx(std::invocable<ZSTD_DCtx*> auto f) {
         // The decompression context has a fixed size of ~128 KiB,
@@ -72,6 +121,8 @@ class zstd_processor : public compressor {
         return f(reinterpret_cast<ZSTD_CCtx*>(view.data()));
     }
 
+    const ZSTD_CDict* cdict() const;
+    const ZSTD_DDict* ddict() const;
 public:
     zstd_processor(const opt_getter&);
 
@@ -81,6 +132,9 @@ class zstd_processor : public compressor {
                     size_t output_len) const override;
     size_t compress_max_size(size_t input_len) const override;
 
+    size_t dictionary_size() const override;
+    future<ptr_type> with_trained_dictionary(const std::vector<temporary_buffer<char>>& samples) const override;
+
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
 };
@@ -108,19 +162,66 @@ zstd_processor::zstd_processor(const opt_getter& opts)
     if (!chunk_len_kb) {
         chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB_ERR);
     }
-    auto chunk_len = chunk_len_kb
+    _chunk_len = chunk_len_kb
        // This parameter has already been validated.
        ? std::stoi(*chunk_len_kb) * 1024
        : compression_parameters::DEFAULT_CHUNK_LENGTH;
 
+    auto dictionary_size_kb = opts(DICTIONARY_SIZE_IN_KB);
+    if (dictionary_size_kb) {
+        size_t size_kb;
+        try {
+            size_kb = std::stoul(*dictionary_size_kb);
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(
+                format("Invalid integer value {} for {}", *dictionary_size_kb, DICTIONARY_SIZE_IN_KB));
+        }
+        if (size_kb > MAX_DICTIONARY_SIZE_IN_KB) {
+            throw exceptions::configuration_exception(
+                format("{} must be between 0 and {}, got {}", DICTIONARY_SIZE_IN_KB, MAX_DICTIONARY_SIZE_IN_KB, size_kb));
+        }
+        _dictionary_size = size_kb * 1024;
+    }
+
+    auto dictionary = opts(DICTIONARY);
+    if (dictionary) {
+        _dictionary = std::move(*dictionary);
+    }
+
     // We assume that the uncompressed input length is always <= chunk_len.
-    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, 0);
-    _cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
+    // The same parameters are used for the digested dictionary, so that
+    // a context of _cctx_size is big enough for compressing with it.
+    _cparams = ZSTD_getCParams(_compression_level, _chunk_len, _dictionary.size());
+    _cctx_size = ZSTD_estimateCCtxSize_usingCParams(_cparams);
 
 }
 
+const ZSTD_CDict* zstd_processor::cdict() const {
+    if (!_cdict) {
+        _cdict.reset(ZSTD_createCDict_advanced(_dictionary.data(), _dictionary.size(),
+                ZSTD_dlm_byCopy, ZSTD_dct_auto, _cparams, ZSTD_defaultCMem));
+        if (!_cdict) {
+            throw std::runtime_error("Unable to create ZSTD compression dictionary");
+        }
+    }
+    return _cdict.get();
+}
+
+const ZSTD_DDict* zstd_processor::ddict() const {
+    if (!_ddict) {
+        _ddict.reset(ZSTD_createDDict(_dictionary.data(), _dictionary.size()));
+        if (!_ddict) {
+            throw std::runtime_error("Unable to create ZSTD decompression dictionary");
+        }
+    }
+    return _ddict.get();
+}
+
 size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output, size_t output_len) const {
     auto ret = with_dctx([&] (ZSTD_DCtx* dctx) {
+        if (!_dictionary.empty()) {
+            return ZSTD_decompress_usingDDict(dctx, output, output_len, input, input_len, ddict());
+        }
         return ZSTD_decompressDCtx(dctx, output, output_len, input, input_len);
     });
     if (ZSTD_isError(ret)) {
@@ -132,6 +233,9 @@ size_t zstd_processor::uncompress(const char* input, size_t input_len, char* out
 
 size_t zstd_processor::compress(const char* input, size_t input_len, char* output, size_t output_len) const {
     auto ret = with_cctx(_cctx_size, [&] (ZSTD_CCtx* cctx) {
+        if (!_dictionary.empty()) {
+            return ZSTD_compress_usingCDict(cctx, output, output_len, input, input_len, cdict());
+        }
         return ZSTD_compressCCtx(cctx, output, output_len, input, input_len, _compression_level);
     });
     if (ZSTD_isError(ret)) {
@@ -144,12 +248,59 @@ size_t zstd_processor::compress_max_size(size_t input_len) const {
     return ZSTD_compressBound(input_len);
 }
 
+size_t zstd_processor::dictionary_size() const {
+    // A compressor which already has a dictionary doesn't want another one.
+    return _dictionary.empty() ? _dictionary_size : 0;
+}
+
+future<compressor::ptr_type> zstd_processor::with_trained_dictionary(const std::vector<temporary_buffer<char>>& samples) const {
+    if (!dictionary_size() || samples.empty()) {
+        co_return nullptr;
+    }
+    std::vector<char> samples_buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (auto& sample : samples) {
+        samples_buffer.insert(samples_buffer.end(), sample.begin(), sample.end());
+        sample_sizes.push_back(sample.size());
+    }
+    auto dictionary = uninitialized_string(_dictionary_size);
+    // Training takes long and can't be preempted, so it runs off the reactor.
+    auto ret = co_await run_on_background_thread([&] () noexcept {
+        return ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+                samples_buffer.data(), sample_sizes.data(), sample_sizes.size());
+    });
+    if (ZDICT_isError(ret)) {
+        // Typically there was not enough data to train on. The
+        // data will simply be compressed without a dictionary.
+        co_return nullptr;
+    }
+    dictionary.resize(ret);
+    auto opts = options();
+    opts.emplace(DICTIONARY, std::move(dictionary));
+    opts.emplace(compression_parameters::CHUNK_LENGTH_KB, std::to_string(_chunk_len / 1024));
+    co_return ::make_shared<zstd_processor>([&opts] (const sstring& key) -> opt_string {
+        auto i = opts.find(key);
+        if (i == opts.end()) {
+            return std::nullopt;
+        }
+        return i->second;
+    });
+}
+
 std::set<sstring> zstd_processor::option_names() const {
-    return {COMPRESSION_LEVEL};
+    return {COMPRESSION_LEVEL, DICTIONARY_SIZE_IN_KB};
 }
 
 std::map<sstring, sstring> zstd_processor::options() const {
-    return {{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    std::map<sstring, sstring> opts{{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    if (_dictionary_size) {
+        opts.emplace(DICTIONARY_SIZE_IN_KB, std::to_string(_dictionary_size / 1024));
+    }
+    if (!_dictionary.empty()) {
+        opts.emplace(DICTIONARY, _dictionary);
+    }
+    return opts;
 }
 
 static const class_registrator<compressor, zstd_processor, const compressor::opt_getter&>